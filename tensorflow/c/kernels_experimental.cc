@@ -62,6 +62,9 @@ tensorflow::Status EnsureSparseVariableAccess(
     return Status::OK();
   }
   mutex_lock ml(*var->mu());
+  // A published read snapshot would hold a reference to the buffer; drop it
+  // before looking at the reference count.
+  var->InvalidateSnapshot();
   // Once copy-on-read mode is True the refcount is guaranteed to be 1. This can
   // also happen if there are no concurrent reads of the variable and
   // copy-on-read mode is false.
@@ -175,6 +178,9 @@ void TF_AssignVariable(TF_OpKernelContext* ctx, int input_index,
                                return tensorflow::Status::OK();
                              }));
   tensorflow::mutex_lock ml(*variable->mu());
+  // Send concurrent lock-free reads back under the mutex so they observe
+  // the new value.
+  variable->InvalidateSnapshot();
 
   if (validate_shape) {
     OP_REQUIRES(cc_ctx,
@@ -256,6 +262,9 @@ void TF_AssignUpdateVariable(TF_OpKernelContext* ctx, int input_index,
   }
   const Tensor& value = context->input(value_index);
   mutex_lock ml(*variable->mu());
+  // Send concurrent lock-free reads back under the mutex so they observe
+  // the updated value.
+  variable->InvalidateSnapshot();
   Tensor* var_tensor = variable->tensor();
   OP_REQUIRES(
       context, var_tensor->shape().IsSameSize(value.shape()),
@@ -354,6 +363,9 @@ void TF_GetInputTensorFromVariable(TF_OpKernelContext* ctx, int input,
       ::tensorflow::Set_TF_Status_from_Status(status, s);
       return;
     }
+    // Our caller holds the variable's mutex; drop any published read snapshot
+    // so PrepareToUpdateVariable() only counts genuine aliases.
+    var->InvalidateSnapshot();
     OP_REQUIRES_OK(cc_ctx, PrepareToUpdateVariable(
                                ctx, var->tensor(),
                                var->copy_on_read_mode.load(), false, copyFunc));
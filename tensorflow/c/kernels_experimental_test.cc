@@ -0,0 +1,180 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/c/kernels_experimental.h"
+
+#include <memory>
+
+#include "tensorflow/c/tf_status.h"
+#include "tensorflow/c/tf_tensor.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/resource_mgr.h"
+#include "tensorflow/core/framework/resource_var.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/refcount.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+void NoOpCopyFunc(TF_OpKernelContext* ctx, TF_Tensor* source,
+                  TF_Tensor* dest) {}
+
+void AddUpdateFunc(TF_OpKernelContext* ctx, TF_Tensor* tensor,
+                   TF_Tensor* value, int Op) {
+  *static_cast<float*>(TF_TensorData(tensor)) +=
+      *static_cast<float*>(TF_TensorData(value));
+}
+
+// Exercises the variable-writing entry points of the C kernel API against
+// the snapshot protocol used by the dense-read fast path: every write must
+// drop the variable's published snapshot, otherwise lock-free reads keep
+// serving the old value.
+class VariableSnapshotTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = DeviceFactory::NewDevice("CPU", {},
+                                       "/job:localhost/replica:0/task:0");
+    NodeDef def;
+    TF_ASSERT_OK(
+        NodeDefBuilder("variable_snapshot_test", "NoOp").Finalize(&def));
+    Status status;
+    kernel_ = CreateOpKernel(DEVICE_CPU, device_.get(), cpu_allocator(), def,
+                             TF_GRAPH_DEF_VERSION, &status);
+    TF_ASSERT_OK(status);
+  }
+
+  // Holds one OpKernelContext whose inputs are the variable handle and a
+  // scalar value, mirroring an assign kernel invocation.
+  struct AssignContext {
+    AssignContext(VariableSnapshotTest* test, const ResourceHandle& handle,
+                  float value)
+        : handle_tensor(DT_RESOURCE, TensorShape({})),
+          value_tensor(DT_FLOAT, TensorShape({})) {
+      handle_tensor.scalar<ResourceHandle>()() = handle;
+      value_tensor.scalar<float>()() = value;
+      inputs.push_back(TensorValue(&handle_tensor));
+      inputs.push_back(TensorValue(&value_tensor));
+      params.device = test->device_.get();
+      params.op_kernel = test->kernel_.get();
+      params.resource_manager = test->device_->resource_manager();
+      params.inputs = &inputs;
+      context.reset(new OpKernelContext(&params));
+    }
+
+    TF_OpKernelContext* c_context() {
+      return reinterpret_cast<TF_OpKernelContext*>(context.get());
+    }
+
+    Tensor handle_tensor;
+    Tensor value_tensor;
+    gtl::InlinedVector<TensorValue, 4> inputs;
+    OpKernelContext::Params params;
+    std::unique_ptr<OpKernelContext> context;
+  };
+
+  ResourceHandle MakeVarHandle(const string& name) {
+    return MakeResourceHandle(device_->resource_manager()->default_container(),
+                              name, *device_, TypeIndex::Make<Var>());
+  }
+
+  void Assign(const ResourceHandle& handle, float value) {
+    AssignContext assign(this, handle, value);
+    TF_Status* status = TF_NewStatus();
+    TF_AssignVariable(assign.c_context(), /*input_index=*/0,
+                      /*value_index=*/1, /*validate_shape=*/true, NoOpCopyFunc,
+                      status);
+    EXPECT_EQ(TF_OK, TF_GetCode(status));
+    TF_DeleteStatus(status);
+    TF_ASSERT_OK(assign.context->status());
+  }
+
+  core::RefCountPtr<Var> LookupVar(const ResourceHandle& handle) {
+    Var* var = nullptr;
+    TF_CHECK_OK(device_->resource_manager()->Lookup(handle.container(),
+                                                    handle.name(), &var));
+    return core::RefCountPtr<Var>(var);
+  }
+
+  // Publishes a read snapshot the way the dense-read fast path does.
+  static void PublishSnapshot(Var* var) {
+    tf_shared_lock ml(*var->mu());
+    var->PublishSnapshot();
+  }
+
+  std::unique_ptr<Device> device_;
+  std::unique_ptr<OpKernel> kernel_;
+};
+
+TEST_F(VariableSnapshotTest, AssignVariableInvalidatesSnapshot) {
+  const ResourceHandle handle = MakeVarHandle("var0");
+  Assign(handle, 1.0f);
+
+  core::RefCountPtr<Var> var = LookupVar(handle);
+  PublishSnapshot(var.get());
+  std::shared_ptr<const Tensor> snapshot = var->SnapshotForRead();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_EQ(1.0f, snapshot->scalar<float>()());
+  snapshot.reset();
+
+  // Overwriting through the C API must drop the stale snapshot so the next
+  // dense read goes back under the mutex and observes the new value.
+  Assign(handle, 2.0f);
+  EXPECT_EQ(nullptr, var->SnapshotForRead());
+  {
+    tf_shared_lock ml(*var->mu());
+    EXPECT_EQ(2.0f, var->tensor()->scalar<float>()());
+  }
+}
+
+TEST_F(VariableSnapshotTest, AssignUpdateVariableInvalidatesSnapshot) {
+  const ResourceHandle handle = MakeVarHandle("var1");
+  Assign(handle, 1.0f);
+
+  core::RefCountPtr<Var> var = LookupVar(handle);
+  PublishSnapshot(var.get());
+  ASSERT_NE(nullptr, var->SnapshotForRead());
+
+  // The in-place += below is only legal because the update drops the
+  // snapshot's buffer reference before checking for aliases.
+  AssignContext update(this, handle, 2.0f);
+  TF_Status* status = TF_NewStatus();
+  TF_AssignUpdateVariable(update.c_context(), /*input_index=*/0,
+                          /*value_index=*/1, /*Op=*/0, /*isVariantType=*/0,
+                          NoOpCopyFunc, AddUpdateFunc, status);
+  EXPECT_EQ(TF_OK, TF_GetCode(status));
+  TF_DeleteStatus(status);
+  TF_ASSERT_OK(update.context->status());
+
+  EXPECT_EQ(nullptr, var->SnapshotForRead());
+  {
+    tf_shared_lock ml(*var->mu());
+    EXPECT_EQ(3.0f, var->tensor()->scalar<float>()());
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -477,6 +477,76 @@ Status LoadSavedModel(const SessionOptions& session_options,
   return OkStatus();
 }
 
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      LazySavedModelBundle* const bundle) {
+  metrics::SavedModelReadApi(kCCLoadLabel).IncrementBy(1);
+  bundle->session_options_ = session_options;
+  bundle->run_options_ = run_options;
+  bundle->export_dir_ = export_dir;
+  TF_RETURN_IF_ERROR(ReadMetaGraphDefFromSavedModel(export_dir, tags,
+                                                    &bundle->meta_graph_def_));
+  TF_RETURN_IF_ERROR(
+      ReadSavedModelDebugInfoIfPresent(export_dir, &bundle->debug_info_));
+  LOG(INFO) << "SavedModel metadata load for tags { "
+            << absl::StrJoin(tags, " ") << " } from " << export_dir
+            << "; session initialization deferred to first use.";
+  return OkStatus();
+}
+
+LazySavedModelBundle::~LazySavedModelBundle() {
+  mutex_lock l(mu_);
+  if (session_) {
+    session_->Close().IgnoreError();
+  }
+}
+
+Status LazySavedModelBundle::EnsureSessionInitialized() const {
+  mutex_lock l(mu_);
+  if (initialized_) {
+    return init_status_;
+  }
+  initialized_ = true;
+  const uint64 start_microseconds = Env::Default()->NowMicros();
+  std::unique_ptr<Session> session;
+  auto initialize = [&, this]() -> Status {
+    TF_RETURN_IF_ERROR(
+        LoadMetagraphIntoSession(session_options_, meta_graph_def_, &session));
+    return RestoreSession(run_options_, meta_graph_def_, export_dir_,
+                          &session);
+  };
+  init_status_ = initialize();
+  session_ = std::move(session);
+  if (init_status_.ok()) {
+    LOG(INFO) << "Deferred SavedModel initialization for " << export_dir_
+              << " took " << GetLatencyMicroseconds(start_microseconds)
+              << " microseconds.";
+    load_attempt_count->GetCell(export_dir_, kLoadAttemptSuccess)
+        ->IncrementBy(1);
+    load_latency->GetCell(export_dir_)
+        ->IncrementBy(GetLatencyMicroseconds(start_microseconds));
+  } else {
+    load_attempt_count->GetCell(export_dir_, kLoadAttemptFail)->IncrementBy(1);
+    if (session_) {
+      session_->Close().IgnoreError();
+      session_.reset();
+    }
+  }
+  return init_status_;
+}
+
+Session* LazySavedModelBundle::GetSession() const {
+  const Status status = EnsureSessionInitialized();
+  if (!status.ok()) {
+    LOG(ERROR) << "Deferred SavedModel initialization for " << export_dir_
+               << " failed: " << status;
+    return nullptr;
+  }
+  mutex_lock l(mu_);
+  return session_.get();
+}
+
 bool MaybeSavedModelDirectory(const string& export_dir) {
   const string saved_model_pb_path =
       io::JoinPath(export_dir, kSavedModelFilenamePb);
@@ -22,9 +22,11 @@ limitations under the License.
 #include <unordered_set>
 
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/protobuf/graph_debug_info.pb.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 #include "tensorflow/core/public/session.h"
+#include "tensorflow/core/public/session_options.h"
 
 namespace tensorflow {
 
@@ -97,6 +99,55 @@ class SavedModelBundleLite : public SavedModelBundleInterface {
   protobuf::Map<string, SignatureDef> signatures_;
 };
 
+/// A SavedModel whose expensive loading stages run on first use.
+///
+/// Loading a LazySavedModelBundle only reads the SavedModel metadata, so
+/// signatures are available immediately and registering many rarely-used
+/// models stays cheap. Session creation, variable restore and the init op are
+/// deferred to the first GetSession() / EnsureSessionInitialized() call; the
+/// result (success or failure) is cached. Safe for concurrent use once loaded.
+class LazySavedModelBundle : public SavedModelBundleInterface {
+ public:
+  LazySavedModelBundle() = default;
+
+  /// Closes the session, if deferred initialization ever created one.
+  ~LazySavedModelBundle() override;
+
+  /// Runs the deferred loading stages if they have not run yet. Prefer calling
+  /// this over GetSession() when first using the model, so failures surface as
+  /// a Status rather than a null session.
+  Status EnsureSessionInitialized() const;
+
+  /// Returns the session, triggering deferred initialization on first call.
+  /// Returns nullptr if initialization failed; see EnsureSessionInitialized()
+  /// for the error.
+  Session* GetSession() const override;
+
+  const protobuf::Map<string, SignatureDef>& GetSignatures() const override {
+    return meta_graph_def_.signature_def();
+  }
+
+  const MetaGraphDef& meta_graph_def() const { return meta_graph_def_; }
+
+ private:
+  friend Status LoadSavedModel(const SessionOptions& session_options,
+                               const RunOptions& run_options,
+                               const string& export_dir,
+                               const std::unordered_set<string>& tags,
+                               LazySavedModelBundle* const bundle);
+
+  SessionOptions session_options_;
+  RunOptions run_options_;
+  string export_dir_;
+  MetaGraphDef meta_graph_def_;
+  std::unique_ptr<GraphDebugInfo> debug_info_;
+
+  mutable mutex mu_;
+  mutable bool initialized_ TF_GUARDED_BY(mu_) = false;
+  mutable Status init_status_ TF_GUARDED_BY(mu_);
+  mutable std::unique_ptr<Session> session_ TF_GUARDED_BY(mu_);
+};
+
 // Restore variable and resources in the SavedModel export dir for the
 // indicated metagraph.
 // The recommended way to load a saved model is to call LoadSavedModel,
@@ -135,6 +186,15 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const std::unordered_set<string>& tags,
                       SavedModelBundleLite* const bundle);
 
+/// Loads only the metadata of a SavedModel from the specified export
+/// directory and records what is needed to finish loading later. Signatures
+/// are available on *bundle immediately; the session is created and variables
+/// are restored on first use. See LazySavedModelBundle.
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      LazySavedModelBundle* const bundle);
+
 /// Checks whether the provided directory could contain a SavedModel. Note that
 /// the method does not load any data by itself. If the method returns `false`,
 /// the export directory definitely does not contain a SavedModel. If the method
@@ -174,6 +174,50 @@ TEST_F(LoaderTest, RestoreSession) {
   CheckSavedModelBundle(export_dir, actual_bundle);
 }
 
+TEST_F(LoaderTest, LazyBundle) {
+  LazySavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, &bundle));
+
+  // Signatures are available before the session has been initialized.
+  const auto& signature_def = bundle.GetSignatures().at("regress_x_to_y");
+  const string input_name = signature_def.inputs().at(kRegressInputs).name();
+  const string output_name = signature_def.outputs().at(kRegressOutputs).name();
+
+  // The first GetSession() call runs the deferred initialization.
+  TF_ASSERT_OK(bundle.EnsureSessionInitialized());
+  Session* session = bundle.GetSession();
+  ASSERT_NE(session, nullptr);
+
+  std::vector<tstring> serialized_examples;
+  for (float x : {0, 1, 2, 3}) {
+    serialized_examples.push_back(MakeSerializedExample(x));
+  }
+  Tensor input = test::AsTensor<tstring>(serialized_examples, TensorShape({4}));
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(session->Run({{input_name, input}}, {output_name}, {}, &outputs));
+  ASSERT_EQ(outputs.size(), 1);
+  test::ExpectTensorEqual<float>(
+      outputs[0], test::AsTensor<float>({2, 2.5, 3, 3.5}, TensorShape({4, 1})));
+}
+
+TEST_F(LoaderTest, LazyBundleInvalidExportPath) {
+  LazySavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), "missing-path");
+  Status st = LoadSavedModel(session_options, run_options, export_dir,
+                             {kSavedModelTagServe}, &bundle);
+  EXPECT_FALSE(st.ok());
+}
+
 TEST_F(LoaderTest, NoTagMatch) {
   SavedModelBundle bundle;
   RunOptions run_options;
@@ -149,7 +149,20 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
       Flag("tf_xla_persistent_cache_prefix",
            &mark_for_compilation_flags->tf_xla_persistent_cache_prefix,
            "Specifies the persistance cache prefix. Default is "
-           "\"xla_compile_cache\"")};
+           "\"xla_compile_cache\""),
+      Flag("tf_xla_persistent_cache_size_limit_bytes",
+           &mark_for_compilation_flags
+                ->tf_xla_persistent_cache_size_limit_bytes,
+           "If positive, bounds the total size in bytes of the persistent "
+           "cache directory; the least recently modified entries are evicted "
+           "when a save pushes the directory over the limit. 0 (the default) "
+           "means unbounded."),
+      Flag("tf_xla_compile_time_budget_ratio",
+           &mark_for_compilation_flags->tf_xla_compile_time_budget_ratio,
+           "If positive, candidate clusters whose estimated XLA compile cost "
+           "exceeds this multiple of their predicted per-run savings are not "
+           "auto-clustered. Clusters explicitly marked with _XlaCompile=true "
+           "are exempt. 0 (the default) disables the budget check.")};
   flag_list->insert(flag_list->end(), new_flags.begin(), new_flags.end());
 }
 
@@ -200,6 +213,8 @@ void AllocateAndParseFlags() {
   mark_for_compilation_flags->tf_xla_disable_strict_signature_checks = false;
   mark_for_compilation_flags->tf_xla_persistent_cache_prefix =
       "xla_compile_cache";
+  mark_for_compilation_flags->tf_xla_persistent_cache_size_limit_bytes = 0;
+  mark_for_compilation_flags->tf_xla_compile_time_budget_ratio = 0;
 
   device_flags = new XlaDeviceFlags;
   device_flags->tf_xla_compile_on_demand = false;
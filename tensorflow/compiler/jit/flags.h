@@ -97,6 +97,17 @@ struct MarkForCompilationPassFlags {
 
   // Specifies the persistance cache prefix. Default is "xla_compile_cache"
   string tf_xla_persistent_cache_prefix;
+
+  // If positive, bounds the total size in bytes of the persistent cache
+  // directory; the least recently modified entries are evicted when a save
+  // pushes the directory over the limit. 0 (the default) means unbounded.
+  int64_t tf_xla_persistent_cache_size_limit_bytes;
+
+  // If positive, candidate clusters whose estimated XLA compile cost exceeds
+  // this multiple of their predicted per-run savings are not auto-clustered.
+  // Clusters explicitly marked with _XlaCompile=true are exempt. 0 (the
+  // default) disables the budget check.
+  float tf_xla_compile_time_budget_ratio;
 };
 
 // Flags associated with the XLA bridge's xla_device module.
@@ -261,6 +261,13 @@ static Status CompileToLocalExecutable(
   compile_options.always_return_tuple = false;
   compile_options.alias_resource_update = !has_ref_vars &&
                                           may_alias_resource_update;
+  // Regular cluster inputs may be consumed by the computation when nothing
+  // else references their buffer at launch time. As with passthrough
+  // parameters, this is only safe when the graph has no reference variables,
+  // which may share buffers with cluster inputs.
+  compile_options.alias_compatible_inputs = !has_ref_vars &&
+                                            may_alias_resource_update &&
+                                            !platform_info.is_on_xla_device();
 
   StatusOr<std::vector<XlaCompiler::Argument>> args =
       XlaComputationLaunchContext::BuildXlaCompilerArguments(
@@ -104,6 +104,12 @@ class MarkForCompilationPassImpl {
     int max_cluster_size;
     int min_cluster_size;
 
+    // If positive, candidate clusters whose estimated XLA compile cost
+    // exceeds this multiple of their predicted per-run savings are not
+    // auto-clustered. Clusters explicitly marked with _XlaCompile=true are
+    // exempt. 0 disables the budget check.
+    float compile_time_budget_ratio;
+
     // Compiler fuel for the auto-clustering algorithm.
     //
     // We decrement this value by one on every time we choose a compilation
@@ -318,6 +324,12 @@ class MarkForCompilationPassImpl {
   // Populates `clusters_`.
   Status BuildInitialClusterSet();
 
+  // Returns true if the estimated XLA compile cost of `cluster`, whose member
+  // nodes are `nodes`, is out of proportion with its predicted runtime
+  // savings according to `debug_options_.compile_time_budget_ratio`.
+  bool ExceedsCompileTimeBudget(const Cluster& cluster,
+                                absl::Span<Node* const> nodes);
+
   StatusOr<bool> ShouldCompileClusterImpl(const Cluster& cluster);
 
   StatusOr<bool> ShouldCompileCluster(const Cluster& cluster);
@@ -931,6 +943,62 @@ int64_t GetNextClusterSequenceNumber(uint64 fingerprint) {
   return ClusterSequenceNumberGenerator::Global().GetNext(fingerprint);
 }
 
+// Returns a rough estimate, in abstract cost units, of how expensive `node` is
+// for XLA to compile. Ops that trigger algorithm selection and autotuning
+// (convolutions, matrix products) or that compile nested computations
+// (functional control flow and function calls) dominate compile time in
+// practice, so they are weighted much more heavily than simple elementwise
+// ops.
+int64_t EstimateNodeCompileCostUnits(
+    const Node& node, const FunctionLibraryDefinition& flib_def) {
+  static const auto* const kAutotunedOps = new absl::flat_hash_set<string>{
+      "Conv2D", "Conv2DBackpropInput", "Conv2DBackpropFilter", "Conv3D",
+      "Conv3DBackpropInputV2", "Conv3DBackpropFilterV2",
+      "DepthwiseConv2dNative", "DepthwiseConv2dNativeBackpropInput",
+      "DepthwiseConv2dNativeBackpropFilter", "MatMul", "BatchMatMul",
+      "BatchMatMulV2", "BatchMatMulV3", "Einsum", "XlaEinsum", "XlaDot",
+      "XlaConv"};
+  if (node.IsIfNode() || node.IsWhileNode() || node.IsCaseNode() ||
+      flib_def.Contains(node.type_string())) {
+    return 50;
+  }
+  if (kAutotunedOps->contains(node.type_string())) {
+    return 20;
+  }
+  return 1;
+}
+
+bool MarkForCompilationPassImpl::ExceedsCompileTimeBudget(
+    const Cluster& cluster, absl::Span<Node* const> nodes) {
+  // The weighted size of the cluster approximates how much work XLA has to do
+  // to compile it, with an additional superlinear term because several XLA
+  // passes do not scale linearly in the computation size. Predicted savings,
+  // in contrast, grow roughly linearly with the number of non-trivial ops
+  // that end up fused together. The constants are rough fits; they only need
+  // to be accurate enough to separate ordinary clusters from pathological
+  // ones.
+  constexpr double kSuperlinearSizeThreshold = 500.0;
+  double compile_cost_units = 0.0;
+  for (const Node* n : nodes) {
+    compile_cost_units += EstimateNodeCompileCostUnits(*n, *flib_def_);
+  }
+  compile_cost_units *= 1.0 + compile_cost_units / kSuperlinearSizeThreshold;
+
+  const double predicted_savings_units =
+      std::max(1, cluster.effective_cluster_size());
+  bool exceeds =
+      compile_cost_units >
+      debug_options_.compile_time_budget_ratio * predicted_savings_units;
+  if (exceeds) {
+    VLOG(1) << "Not clustering " << cluster.DebugString(*graph_)
+            << ": estimated compile cost of " << compile_cost_units
+            << " units exceeds budget ("
+            << debug_options_.compile_time_budget_ratio << " x "
+            << predicted_savings_units << " predicted savings units)";
+  }
+  return exceeds;
+}
+
 Status MarkForCompilationPassImpl::CreateClusters() {
   TF_RET_CHECK(initialized_ && edges_contracted_ && !clusters_created_);
   clusters_created_ = true;
@@ -942,6 +1010,28 @@ Status MarkForCompilationPassImpl::CreateClusters() {
     DumpGraphToFile("before_mark_for_compilation", *graph_, flib_def_);
   }
 
+  // When a compile time budget is configured, collect each candidate
+  // cluster's member nodes so the budget model can inspect its op mix, and
+  // drop the clusters whose estimated compile cost is out of proportion with
+  // their predicted savings.
+  absl::flat_hash_set<Cluster*> over_budget_clusters;
+  if (debug_options_.compile_time_budget_ratio > 0) {
+    absl::flat_hash_map<Cluster*, std::vector<Node*>> cluster_nodes;
+    for (Node* n : compilation_candidates_) {
+      cluster_nodes[GetClusterForNode(n)].push_back(n);
+    }
+    for (const auto& cluster_and_nodes : cluster_nodes) {
+      Cluster* cluster = cluster_and_nodes.first;
+      // Explicit compilation requests are always honored.
+      if (cluster->is_xla_compile_attr_true()) {
+        continue;
+      }
+      if (ExceedsCompileTimeBudget(*cluster, cluster_and_nodes.second)) {
+        over_budget_clusters.insert(cluster);
+      }
+    }
+  }
+
   // Mark clusters for compilation that:
   // * are placed on a device that requires compilation (an XlaDevice),
   // * are explicitly marked for compilation (_XlaCompile=true), or
@@ -952,7 +1042,8 @@ Status MarkForCompilationPassImpl::CreateClusters() {
     Cluster* cluster = GetClusterForNode(n);
     TF_ASSIGN_OR_RETURN(bool should_compile_cluster,
                         ShouldCompileCluster(*cluster));
-    if (!should_compile_cluster || declustered_nodes_.contains(n)) {
+    if (!should_compile_cluster || declustered_nodes_.contains(n) ||
+        over_budget_clusters.contains(cluster)) {
       continue;
     }
 
@@ -1850,6 +1941,8 @@ Status MarkForCompilationPass::Run(
       flags->tf_xla_deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.compile_time_budget_ratio =
+      flags->tf_xla_compile_time_budget_ratio;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
@@ -1869,6 +1962,8 @@ Status MarkForCompilationPass::RunForTest(
   debug_options.deterministic_cluster_names = deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.compile_time_budget_ratio =
+      flags->tf_xla_compile_time_budget_ratio;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
@@ -33,6 +33,7 @@ limitations under the License.
 #include "tensorflow/cc/ops/sendrecv_ops.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/compiler/jit/defs.h"
+#include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/mark_for_compilation_pass_test_helper.h"
 #include "tensorflow/compiler/jit/node_matchers.h"
 #include "tensorflow/compiler/jit/xla_cluster_util.h"
@@ -136,6 +137,37 @@ TEST(XlaCompilationTest, Chains) {
   EXPECT_TRUE(clusters.find("D") == clusters.cend());
 }
 
+TEST(XlaCompilationTest, CompileTimeBudget) {
+  auto make_graph = [](std::unique_ptr<Graph>* graph) {
+    graph->reset(new Graph(OpRegistry::Global()));
+    GraphDefBuilder builder(GraphDefBuilder::kFailImmediately);
+    Node* a =
+        ops::SourceOp("UncompilableNullary", builder.opts().WithName("A"));
+    Node* b = ops::UnaryOp("Relu", a, builder.opts().WithName("B"));
+    ops::UnaryOp("Relu", b, builder.opts().WithName("C"));
+    TF_EXPECT_OK(GraphDefBuilderToGraph(builder, graph->get()));
+  };
+  MarkForCompilationPassFlags* flags = GetMarkForCompilationPassFlags();
+
+  // With a generous budget the cluster is kept.
+  std::unique_ptr<Graph> graph;
+  make_graph(&graph);
+  flags->tf_xla_compile_time_budget_ratio = 1000.0;
+  Status status = MarkForCompilationPassTestHelper::MarkForCompilation(&graph);
+  flags->tf_xla_compile_time_budget_ratio = 0;
+  TF_ASSERT_OK(status);
+  auto clusters = GetClusters(*graph);
+  EXPECT_EQ(2, clusters.size());
+
+  // With a budget that no cluster can meet, nothing is clustered.
+  make_graph(&graph);
+  flags->tf_xla_compile_time_budget_ratio = 0.001;
+  status = MarkForCompilationPassTestHelper::MarkForCompilation(&graph);
+  flags->tf_xla_compile_time_budget_ratio = 0;
+  TF_ASSERT_OK(status);
+  EXPECT_TRUE(GetClusters(*graph).empty());
+}
+
 TEST(XlaCompilationTest, UncompilableCycles) {
   std::unique_ptr<Graph> graph(new Graph(OpRegistry::Global()));
   {
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/compiler/jit/xla_compilation_cache.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -24,6 +25,7 @@ limitations under the License.
 #include "tensorflow/compiler/mlir/mlir_bridge_rollout_policy.h"
 #include "absl/base/call_once.h"
 #include "absl/status/status.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/types/variant.h"
@@ -71,6 +73,7 @@ limitations under the License.
 #include "tensorflow/core/tpu/tpu_defs.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/stream_executor/device_description.h"
 
 namespace tensorflow {
 namespace {
@@ -140,12 +143,43 @@ std::string XlaSerializedCacheKeyToString(const XlaSerializedCacheKey& key) {
       key.prefix(), key.prefix().empty() ? "" : kXlaSerializedCacheKeySeparator,
       key.signature_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.cluster_fingerprint(), kXlaSerializedCacheKeySeparator,
-      key.device_type());
+      key.device_type(),
+      key.compute_capability().empty()
+          ? ""
+          : absl::StrCat(kXlaSerializedCacheKeySeparator,
+                         key.compute_capability()),
+      kXlaSerializedCacheKeySeparator, key.tf_version());
+}
+
+// Returns a string identifying the compute capability of the device the
+// client compiles for (e.g. "8.0" for CUDA or "gfx90a" for ROCm), so that
+// persisted executables are not shared across incompatible hardware
+// generations. Returns an empty string when the platform has no notion of
+// compute capability.
+std::string GetDeviceComputeCapability(xla::LocalClient* client) {
+  if (client->device_count() < 1) {
+    return "";
+  }
+  const se::DeviceDescription& device_description =
+      client->backend().default_stream_executor()->GetDeviceDescription();
+  se::CudaComputeCapability cuda_compute_capability =
+      device_description.cuda_compute_capability();
+  if (cuda_compute_capability.major >= 0) {
+    return cuda_compute_capability.ToString();
+  }
+  se::RocmComputeCapability rocm_compute_capability =
+      device_description.rocm_compute_capability();
+  if (rocm_compute_capability.gfx_version() != "gfx000") {
+    return rocm_compute_capability.gfx_version();
+  }
+  return "";
 }
 
 }  // namespace
 
 constexpr int64_t XlaCompilationCache::kDefaultCompilationThreshold;
+constexpr int64_t XlaCompilationCache::kCompileTimeBudgetPerRequestUs;
+constexpr int64_t XlaCompilationCache::kAsyncCompileTimeThresholdUs;
 constexpr int64_t
     XlaCompilationCache::AsyncCompilationState::kNumCompilerThreads;
 constexpr int64_t
@@ -158,7 +192,9 @@ XlaCompilationCache::XlaCompilationCache(Config config,
       device_type_(std::move(device_type)),
       disable_strict_signature_checks_(config.disable_strict_signature_checks),
       persistance_prefix_(config.persistance_prefix),
-      persistent_cache_directory_(config.persistent_cache_directory) {}
+      persistent_cache_directory_(config.persistent_cache_directory),
+      persistent_cache_size_limit_bytes_(
+          config.persistent_cache_size_limit_bytes) {}
 
 XlaCompilationCache::~XlaCompilationCache() {
   // Ensure any use of our programs have completed by waiting for all stream
@@ -644,23 +680,33 @@ Status XlaCompilationCache::CompileAsynchronous(
   return OkStatus();
 }
 
-bool XlaCompilationCache::ShouldCompileCluster(CompileMode compile_mode,
-                                               bool is_megamorphic,
-                                               bool is_first_execution,
-                                               int64_t current_request_count,
-                                               const NameAttrList& function) {
-  absl::optional<int64_t> compile_threshold;
-  if (compile_mode == CompileMode::kLazy) {
-    compile_threshold = kDefaultCompilationThreshold;
-  } else if (compile_mode == CompileMode::kAsync) {
-    compile_threshold = 0;  // for now, always compile right away.
-  }
+bool XlaCompilationCache::AsyncCompilationCapacityAvailable() {
+  mutex_lock lock(async_compilation_state_.async_compilation_state_mu);
+  return async_compilation_state_.num_ongoing_compilations <
+         async_compilation_state_.kMaxNumOngoingCompilations;
+}
 
+bool XlaCompilationCache::ShouldCompileCluster(
+    CompileMode compile_mode, bool is_megamorphic, bool is_first_execution,
+    int64_t current_request_count, absl::optional<int64_t> avg_compile_time_us,
+    const NameAttrList& function) {
   if (compile_mode == CompileMode::kStrict) {
     // Lazy compilation is disabled.
     return true;
   }
 
+  // Adapt the request threshold to the measured compile cost of the cluster:
+  // each request earns kCompileTimeBudgetPerRequestUs of compile time, and a
+  // signature is only compiled once its requests cover the estimated cost.
+  // Clusters that have not been compiled yet (no measurement) and cheap
+  // clusters use the default threshold.
+  int64_t compile_threshold = kDefaultCompilationThreshold;
+  if (avg_compile_time_us.has_value()) {
+    compile_threshold =
+        std::max(compile_threshold,
+                 *avg_compile_time_us / kCompileTimeBudgetPerRequestUs);
+  }
+
   if (is_megamorphic) {
     BroadcastOptimizationRemark(XlaOptimizationRemark::MEGAMORPHIC_FUNCTION,
                                 function.name())
@@ -676,20 +722,18 @@ bool XlaCompilationCache::ShouldCompileCluster(CompileMode compile_mode,
 
   if (compile_mode == CompileMode::kAsync) {
     // Asynchronous compilation is enabled.
-    mutex_lock lock(async_compilation_state_.async_compilation_state_mu);
-    if (async_compilation_state_.num_ongoing_compilations >=
-        async_compilation_state_.kMaxNumOngoingCompilations) {
+    if (!AsyncCompilationCapacityAvailable()) {
       VLOG(2) << "Not asynchronously compiling cluster " << function.name()
               << " because of too many ongoing compilations.";
       return false;
     }
   }
 
-  bool reached_compile_threshold = current_request_count >= *compile_threshold;
+  bool reached_compile_threshold = current_request_count >= compile_threshold;
   if (!reached_compile_threshold) {
     VLOG(2) << "Not compiling cluster " << function.name()
             << " because it has not reached compile threshold; threshold is "
-            << *compile_threshold << " execution count "
+            << compile_threshold << " execution count "
             << current_request_count << ".";
   }
   return reached_compile_threshold;
@@ -737,6 +781,10 @@ Status XlaCompilationCache::CompileImpl(
   // excessive amount of shape dynamism.
   bool is_megamorphic;
 
+  // Estimated compile time for this cluster, averaged over its previous
+  // compilations. Unset until the cluster has been compiled at least once.
+  absl::optional<int64_t> avg_compile_time_us;
+
   {
     mutex_lock lock(cluster_compile_stats_mu_);
     auto it =
@@ -756,6 +804,10 @@ Status XlaCompilationCache::CompileImpl(
     }
 
     is_megamorphic = it->second.is_megamorphic;
+    if (it->second.compile_count > 0) {
+      avg_compile_time_us =
+          it->second.cumulative_compile_time_us / it->second.compile_count;
+    }
   }
 
   string human_signature;
@@ -797,10 +849,21 @@ Status XlaCompilationCache::CompileImpl(
   if (state == CompileState::kUncompiled) {
     XLA_SCOPED_LOGGING_TIMER("Compilation of XLA executable");
     if (!ShouldCompileCluster(compile_mode, is_megamorphic, is_first_execution,
-                              current_request_count, function)) {
+                              current_request_count, avg_compile_time_us,
+                              function)) {
       VLOG(2) << "Not compiling for signature: " << human_signature;
       return OkStatus();
-    } else if (compile_mode == CompileMode::kAsync) {
+    }
+    // Under lazy compilation, new signatures of clusters that are known to be
+    // expensive to compile are compiled in the background when capacity
+    // allows, so the triggering call takes the fallback path instead of
+    // blocking on the compile.
+    bool compile_asynchronously =
+        compile_mode == CompileMode::kAsync ||
+        (compile_mode == CompileMode::kLazy && !is_first_execution &&
+         avg_compile_time_us.value_or(0) >= kAsyncCompileTimeThresholdUs &&
+         AsyncCompilationCapacityAvailable());
+    if (compile_asynchronously) {
       VLOG(2) << "Queueing asynchronous compilation for signature: "
               << human_signature;
       TF_RETURN_IF_ERROR(CompileAsynchronous(signature, entry, compile_options,
@@ -834,6 +897,9 @@ XlaSerializedCacheKey XlaCompilationCache::BuildSerializedCacheKey(
       DeterministicProtoHash64(hlo_module));
   serialized_cache_key.set_device_type(device_type_.type_string());
   serialized_cache_key.set_prefix(persistance_prefix_);
+  serialized_cache_key.set_compute_capability(
+      GetDeviceComputeCapability(client_));
+  serialized_cache_key.set_tf_version(TF_VERSION_STRING);
   return serialized_cache_key;
 }
 
@@ -916,7 +982,83 @@ Status XlaCompilationCache::SaveSerializedEntry(
   TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(persistent_cache_directory_));
   const std::string file_path =
       GetFilePath(entry.key(), persistent_cache_directory_);
-  return WriteBinaryProto(env, file_path, entry);
+
+  // Write to a unique temporary file and atomically rename it into place so
+  // other processes sharing `persistent_cache_directory_` never observe a
+  // partially written entry. If several processes compile the same key
+  // concurrently the last rename wins, which is fine since the contents are
+  // equivalent.
+  std::string temp_path = absl::StrCat(file_path, ".tmp");
+  if (!env->CreateUniqueFileName(&temp_path, ".pb")) {
+    return errors::Internal("Could not create a unique file name for entry: ",
+                            file_path);
+  }
+  TF_RETURN_IF_ERROR(WriteBinaryProto(env, temp_path, entry));
+  Status rename_status = env->RenameFile(temp_path, file_path);
+  if (!rename_status.ok()) {
+    env->DeleteFile(temp_path).IgnoreError();
+    return rename_status;
+  }
+
+  return EvictPersistentCacheEntriesIfNeeded();
+}
+
+Status XlaCompilationCache::EvictPersistentCacheEntriesIfNeeded() {
+  if (persistent_cache_size_limit_bytes_ <= 0) {
+    return OkStatus();
+  }
+  Env* env = Env::Default();
+
+  std::vector<std::string> children;
+  TF_RETURN_IF_ERROR(env->GetChildren(persistent_cache_directory_, &children));
+
+  struct PersistedEntry {
+    std::string file_path;
+    int64_t size_bytes;
+    int64_t mtime_nsec;
+  };
+  std::vector<PersistedEntry> entries;
+  entries.reserve(children.size());
+  int64_t total_size_bytes = 0;
+  for (const std::string& child : children) {
+    if (!absl::EndsWith(child, ".pb")) {
+      continue;
+    }
+    const std::string child_path =
+        io::JoinPath(persistent_cache_directory_, child);
+    FileStatistics stat;
+    // Entries may be deleted by concurrent processes between listing and
+    // stat'ing; skip them.
+    if (!env->Stat(child_path, &stat).ok()) {
+      continue;
+    }
+    entries.push_back({child_path, stat.length, stat.mtime_nsec});
+    total_size_bytes += stat.length;
+  }
+  if (total_size_bytes <= persistent_cache_size_limit_bytes_) {
+    return OkStatus();
+  }
+
+  // Evict the least recently modified entries first.
+  std::sort(entries.begin(), entries.end(),
+            [](const PersistedEntry& a, const PersistedEntry& b) {
+              return a.mtime_nsec < b.mtime_nsec;
+            });
+  for (const PersistedEntry& entry : entries) {
+    if (total_size_bytes <= persistent_cache_size_limit_bytes_) {
+      break;
+    }
+    VLOG(1) << "Evicting persisted compilation cache entry: "
+            << entry.file_path;
+    // A concurrent process may have evicted the entry already.
+    Status delete_status = env->DeleteFile(entry.file_path);
+    if (delete_status.ok() || errors::IsNotFound(delete_status)) {
+      total_size_bytes -= entry.size_bytes;
+    } else {
+      return delete_status;
+    }
+  }
+  return OkStatus();
 }
 
 StatusOr<absl::optional<XlaSerializedCacheEntry>>
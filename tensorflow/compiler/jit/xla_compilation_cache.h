@@ -56,10 +56,13 @@ class XlaCompilationCache : public ResourceBase {
     Config() {}
     explicit Config(absl::string_view persistent_cache_directory,
                     bool disable_strict_signature_checks,
-                    absl::string_view persistance_prefix)
+                    absl::string_view persistance_prefix,
+                    int64_t persistent_cache_size_limit_bytes = 0)
         : persistent_cache_directory(persistent_cache_directory),
           disable_strict_signature_checks(disable_strict_signature_checks),
-          persistance_prefix(persistance_prefix) {}
+          persistance_prefix(persistance_prefix),
+          persistent_cache_size_limit_bytes(
+              persistent_cache_size_limit_bytes) {}
 
     // If non-empty, JIT-compiled executables are saved to and loaded from the
     // specified file system directory path.
@@ -71,6 +74,11 @@ class XlaCompilationCache : public ResourceBase {
 
     // The cache persistence prefix to use if serializing/deserialzing entries.
     std::string persistance_prefix;
+
+    // If positive, bounds the total size in bytes of the persistent cache
+    // directory; the least recently modified entries are evicted when a save
+    // pushes the directory over the limit. 0 means unbounded.
+    int64_t persistent_cache_size_limit_bytes = 0;
   };
   XlaCompilationCache(Config config, xla::LocalClient* client,
                       DeviceType device_type);
@@ -194,8 +202,13 @@ class XlaCompilationCache : public ResourceBase {
   bool ShouldCompileCluster(CompileMode compile_mode, bool is_megamorphic,
                             bool is_first_execution,
                             int64_t current_request_count,
+                            absl::optional<int64_t> avg_compile_time_us,
                             const NameAttrList& function);
 
+  // Returns true if another asynchronous compilation may be started without
+  // exceeding the limit on concurrent compilations.
+  bool AsyncCompilationCapacityAvailable();
+
   xla::LocalClient* const client_;
   const DeviceType device_type_;
   bool disable_strict_signature_checks_;
@@ -252,9 +265,18 @@ class XlaCompilationCache : public ResourceBase {
                              CompileScope scope);
 
   // Saves the cache entry in the file directory supplied during the
-  // construction of this class. Overwrites existing entries.
+  // construction of this class. Overwrites existing entries. The entry is
+  // written to a temporary file which is then atomically renamed into place,
+  // so concurrent processes sharing the directory never observe partially
+  // written entries.
   Status SaveSerializedEntry(const XlaSerializedCacheEntry& entry);
 
+  // If a positive size limit was supplied during the construction of this
+  // class, deletes the least recently modified entries in the persistent cache
+  // directory until the directory fits in the limit. Entries deleted by
+  // concurrent processes are skipped.
+  Status EvictPersistentCacheEntriesIfNeeded();
+
   // Tries to load a cache entry given a `key` by searching the file directory
   // supplied during the construction of this class. Returns absl::nullopt if no
   // cache entry is found.
@@ -315,10 +337,28 @@ class XlaCompilationCache : public ResourceBase {
   // signature before  we attempt to compile it.
   static constexpr int64_t kDefaultCompilationThreshold = 2;
 
+  // Per-request compile-time budget used to adapt the lazy compilation
+  // threshold: a signature is only compiled once enough requests have been
+  // seen that the cluster's measured compile time is covered at this rate.
+  // Cheap clusters stay at kDefaultCompilationThreshold while signatures of
+  // expensive clusters must prove they recur often enough to amortize the
+  // compile.
+  static constexpr int64_t kCompileTimeBudgetPerRequestUs = 100 * 1000;
+
+  // Under lazy compilation, clusters whose measured compile time exceeds this
+  // bound are compiled in the background when capacity allows, so the
+  // triggering call takes the fallback path instead of blocking on an
+  // expensive compile.
+  static constexpr int64_t kAsyncCompileTimeThresholdUs = 500 * 1000;
+
   // If non-empty, JIT-compiled executables are saved to and loaded from the
   // specified file system directory path.
   std::string persistent_cache_directory_;
 
+  // If positive, bounds the total size in bytes of
+  // `persistent_cache_directory_`.
+  int64_t persistent_cache_size_limit_bytes_;
+
   TF_DISALLOW_COPY_AND_ASSIGN(XlaCompilationCache);
 };
 
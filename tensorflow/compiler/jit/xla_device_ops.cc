@@ -67,6 +67,9 @@ void XlaAssignVariableOp::Compute(OpKernelContext* context) {
           DataTypeString(variable->tensor()->dtype()), " got ",
           DataTypeString(dtype_)));
   variable->is_initialized = true;
+  // Send concurrent lock-free reads back under the mutex so they observe the
+  // new value.
+  variable->InvalidateSnapshot();
   *variable->tensor() = value;
 }
 
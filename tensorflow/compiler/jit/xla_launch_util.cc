@@ -276,8 +276,14 @@ XlaComputationLaunchContext::PopulateInputs(
                           ? resource_vars.at(arg_num)
                           : &(ctx->input(arg_num - missing_ctx_input_prefix));
     CHECK(t);
+    // A regular input tensor whose buffer is not referenced anywhere else may
+    // be donated to the computation when the compiled executable declared an
+    // alias for the parameter. Resource variables additionally require that
+    // the computation writes the variable, since an unmodified variable keeps
+    // its buffer live in the resource manager.
     bool donate_buffer =
-        t->RefCountIsOne() && is_updated_resource_variable &&
+        t->RefCountIsOne() &&
+        (!is_resource_variable || is_updated_resource_variable) &&
         input_output_alias.ParameterHasAlias(i, xla::ShapeIndex{});
     VLOG(3) << "Processing input: " << i
             << "; is_resource_variable=" << is_resource_variable
@@ -601,6 +607,7 @@ Status XlaComputationLaunchContext::PopulateOutputs(
                                    allocator, allocate_xla_tensors_, stream,
                                    use_multiple_streams_, definition_event));
     var->is_initialized |= write.modified;
+    var->InvalidateSnapshot();
     *var->tensor() = output_tensor;
     ++output_num;
   }
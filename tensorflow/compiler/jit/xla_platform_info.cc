@@ -49,7 +49,9 @@ Status BuildXlaCompilationCache(DeviceBase* device, FunctionLibraryRuntime* flr,
   XlaCompilationCache::Config cache_config(
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_directory,
       GetMarkForCompilationPassFlags()->tf_xla_disable_strict_signature_checks,
-      GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_prefix);
+      GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_prefix,
+      GetMarkForCompilationPassFlags()
+          ->tf_xla_persistent_cache_size_limit_bytes);
 
   if (platform_info.xla_device_metadata()) {
     *cache = new XlaCompilationCache(
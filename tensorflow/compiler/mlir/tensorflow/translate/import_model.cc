@@ -62,6 +62,7 @@ limitations under the License.
 #include "mlir/IR/Location.h"  // from @llvm-project
 #include "mlir/IR/MLIRContext.h"  // from @llvm-project
 #include "mlir/IR/OpDefinition.h"  // from @llvm-project
+#include "mlir/IR/Threading.h"  // from @llvm-project
 #include "mlir/IR/Types.h"  // from @llvm-project
 #include "mlir/IR/Verifier.h"  // from @llvm-project
 #include "mlir/Pass/PassManager.h"  // from @llvm-project
@@ -595,72 +596,118 @@ std::string GetUniqueNodeName(
 }
 
 Status ImporterBase::ConvertDeferredFunctions() {
-  while (!deferred_functions_.empty()) {
-    auto conversion_metadata = deferred_functions_.front();
-    deferred_functions_.pop();
-
-    const FunctionDef* func_def =
-        graph_flib_.Find(conversion_metadata.function_name);
-    // Converts the graph to an MLIR function and adds it to the module.
-    // We populate the NodeSpec so that all the _Arg ops get their shape
-    // added correctly.
+  // Per-function conversion state. The function body instantiation and the
+  // graph clone serialization only touch TensorFlow data structures owned by
+  // the item, so they can run on the context's thread pool; the MLIR
+  // conversion itself stays serial as it mutates the shared module.
+  struct ConversionItem {
+    DeferredConversionMetaData metadata;
     GraphImportConfig specs;
-    specs.enable_shape_inference = specs_.enable_shape_inference;
-    specs.unconditionally_use_set_output_shapes =
-        specs_.unconditionally_use_set_output_shapes;
-    for (const auto& name_and_value : func_def->attr()) {
-      if (name_and_value.first == "_input_shapes") {
-        auto& list = name_and_value.second.list();
-        auto& signature = func_def->signature();
-        // Some models have "_input_shapes" attribute, but with its value empty
-        if (list.shape_size() > 0 &&
-            list.shape_size() != signature.input_arg_size()) {
-          return errors::FailedPrecondition(
-              "Number of input arguments must be equal to the length of "
-              "_input_shapes attribute in function '",
-              StringRefToView(conversion_metadata.function_name), "'.");
-        }
-        for (int i = 0, e = signature.input_arg_size(); i < e; i++) {
-          auto& input_arg = signature.input_arg(i);
-          auto& array_info = specs.inputs[input_arg.name()];
-          array_info.imported_dtype = input_arg.type();
-          // set to unranked for empty "_input_shapes" attribute
-          if (list.shape_size() > 0)
-            array_info.shape = list.shape(i);
-          else
-            array_info.shape.set_unknown_rank(true);
+    const FunctionDef* func_def = nullptr;
+    std::unique_ptr<FunctionBody> fbody;
+    std::unique_ptr<GraphDef> graph_def;
+    Status prepare_status;
+
+    explicit ConversionItem(DeferredConversionMetaData metadata)
+        : metadata(std::move(metadata)) {}
+  };
+
+  while (!deferred_functions_.empty()) {
+    // Dequeue the functions discovered so far; converting them may discover
+    // additional functions, which are picked up by the next round of the
+    // outer loop.
+    std::vector<ConversionItem> items;
+    while (!deferred_functions_.empty()) {
+      items.emplace_back(std::move(deferred_functions_.front()));
+      deferred_functions_.pop();
+    }
+
+    for (ConversionItem& item : items) {
+      item.func_def = graph_flib_.Find(item.metadata.function_name);
+      // Converts the graph to an MLIR function and adds it to the module.
+      // We populate the NodeSpec so that all the _Arg ops get their shape
+      // added correctly.
+      GraphImportConfig& specs = item.specs;
+      specs.enable_shape_inference = specs_.enable_shape_inference;
+      specs.unconditionally_use_set_output_shapes =
+          specs_.unconditionally_use_set_output_shapes;
+      for (const auto& name_and_value : item.func_def->attr()) {
+        if (name_and_value.first == "_input_shapes") {
+          auto& list = name_and_value.second.list();
+          auto& signature = item.func_def->signature();
+          // Some models have "_input_shapes" attribute, but with its value
+          // empty
+          if (list.shape_size() > 0 &&
+              list.shape_size() != signature.input_arg_size()) {
+            return errors::FailedPrecondition(
+                "Number of input arguments must be equal to the length of "
+                "_input_shapes attribute in function '",
+                StringRefToView(item.metadata.function_name), "'.");
+          }
+          for (int i = 0, e = signature.input_arg_size(); i < e; i++) {
+            auto& input_arg = signature.input_arg(i);
+            auto& array_info = specs.inputs[input_arg.name()];
+            array_info.imported_dtype = input_arg.type();
+            // set to unranked for empty "_input_shapes" attribute
+            if (list.shape_size() > 0)
+              array_info.shape = list.shape(i);
+            else
+              array_info.shape.set_unknown_rank(true);
+          }
         }
       }
     }
 
-    ImporterBase importer(graph_flib_, debug_info_, specs, module_,
-                          tf_name_to_mlir_name_, function_name_uniquifier_,
-                          conversion_metadata.function_name);
+    // Instantiate the function bodies in parallel, along with the GraphDef
+    // roundtrip PrepareConvert uses to clone the graph. This performs no MLIR
+    // work, so it does not need the context to be in multi-threaded execution
+    // mode.
+    if (mlir::failed(mlir::failableParallelForEach(
+            context_, items, [this](ConversionItem& item) {
+              item.prepare_status = FunctionDefToBodyHelper(
+                  *item.func_def, AttrSlice(), &graph_flib_, &item.fbody);
+              if (item.prepare_status.ok()) {
+                item.graph_def = std::make_unique<GraphDef>();
+                item.fbody->graph->ToGraphDef(item.graph_def.get());
+              }
+              return mlir::success(item.prepare_status.ok());
+            }))) {
+      Status result;
+      for (const ConversionItem& item : items) {
+        result.Update(item.prepare_status);
+      }
+      return result;
+    }
 
-    std::unique_ptr<FunctionBody> fbody;
-    TF_RETURN_IF_ERROR(
-        FunctionDefToBodyHelper(*func_def, AttrSlice(), &graph_flib_, &fbody));
-    TF_RETURN_IF_ERROR(importer.PrepareConvert(*fbody->graph));
-
-    TF_ASSIGN_OR_RETURN(auto func_type, importer.InferLibFunctionType(*fbody));
-
-    absl::InlinedVector<OutputTensor, 4> arg_nodes;
-    absl::InlinedVector<OutputTensor, 4> ret_nodes;
-    absl::InlinedVector<Node*, 4> control_ret_nodes;
-    importer.GetArgsAndRetsFromFunctionBody(*fbody, &arg_nodes, &ret_nodes,
-                                            &control_ret_nodes);
-    const std::string& mlir_func_name =
-        (*tf_name_to_mlir_name_)[conversion_metadata.function_name];
-
-    TF_RETURN_IF_ERROR(importer.Convert(mlir_func_name, func_type, arg_nodes,
-                                        ret_nodes, control_ret_nodes,
-                                        conversion_metadata.attributes));
-
-    // Additional function bodies could be discovered during the deferred
-    // loading of the current function. Add them to the working queue.
-    while (!importer.deferred_functions_.empty()) {
-      deferred_functions_.push(importer.deferred_functions_.front());
-      importer.deferred_functions_.pop();
+    for (ConversionItem& item : items) {
+      ImporterBase importer(graph_flib_, debug_info_, item.specs, module_,
+                            tf_name_to_mlir_name_, function_name_uniquifier_,
+                            item.metadata.function_name);
+
+      TF_RETURN_IF_ERROR(importer.PrepareConvert(*item.fbody->graph,
+                                                 std::move(item.graph_def)));
+
+      TF_ASSIGN_OR_RETURN(auto func_type,
+                          importer.InferLibFunctionType(*item.fbody));
+
+      absl::InlinedVector<OutputTensor, 4> arg_nodes;
+      absl::InlinedVector<OutputTensor, 4> ret_nodes;
+      absl::InlinedVector<Node*, 4> control_ret_nodes;
+      importer.GetArgsAndRetsFromFunctionBody(*item.fbody, &arg_nodes,
+                                              &ret_nodes, &control_ret_nodes);
+      const std::string& mlir_func_name =
+          (*tf_name_to_mlir_name_)[item.metadata.function_name];
+
+      TF_RETURN_IF_ERROR(importer.Convert(mlir_func_name, func_type, arg_nodes,
+                                          ret_nodes, control_ret_nodes,
+                                          item.metadata.attributes));
+
+      // Additional function bodies could be discovered during the deferred
+      // loading of the current function. Add them to the working queue.
+      while (!importer.deferred_functions_.empty()) {
+        deferred_functions_.push(importer.deferred_functions_.front());
+        importer.deferred_functions_.pop();
+      }
     }
   }
 
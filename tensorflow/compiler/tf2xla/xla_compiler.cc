@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "tensorflow/compiler/mlir/mlir_bridge_rollout_policy.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/memory/memory.h"
 #include "absl/types/variant.h"
 #include "tensorflow/compiler/jit/defs.h"
@@ -173,7 +174,8 @@ Status BuildComputation(
     const XlaShapeLayoutHelpers::ShapeDeterminationFns& shape_determination_fns,
     bool is_entry_computation, bool return_updated_values_for_all_resources,
     bool always_return_tuple, bool use_tuple_arg, bool alias_resource_update,
-    xla::XlaBuilder* builder, xla::XlaComputation* computation,
+    bool alias_compatible_inputs, xla::XlaBuilder* builder,
+    xla::XlaComputation* computation,
     int* num_computation_outputs, int* num_nonconst_outputs,
     std::vector<XlaCompiler::OutputDescription>* outputs,
     std::vector<XlaCompiler::ResourceUpdate>* resource_updates,
@@ -200,6 +202,11 @@ Status BuildComputation(
   std::vector<xla::XlaOp> elems;
   elems.reserve(retvals.size());
 
+  // Return values eligible for input/output aliasing, as pairs of (retval
+  // index, output tuple index). Only plain (non-constant, non-resource,
+  // non-tensor-list) return values may alias an argument buffer.
+  std::vector<std::pair<int, int64_t>> aliasable_outputs;
+
   // Keeps track of sharding of each retval. If a retval is not in this list,
   // replicate sharding is used. The first element is the output index, second
   // element is the sharding.
@@ -246,6 +253,7 @@ Status BuildComputation(
           value = identity_op(value, sharding);
         }
 
+        aliasable_outputs.push_back({i, static_cast<int64_t>(elems.size())});
         elems.push_back(value);
         break;
       }
@@ -351,6 +359,41 @@ Status BuildComputation(
     }
   }
 
+  // When requested, mark the remaining return values as possibly sharing a
+  // buffer with a type- and shape-compatible argument. These are may-alias
+  // pairs: the launch code only donates an argument buffer when nothing else
+  // references it, and XLA inserts copies where reusing the buffer in place
+  // would not be legal.
+  if (is_entry_computation && alias_compatible_inputs) {
+    absl::flat_hash_set<int> aliased_args;
+    for (const auto& output_and_index : aliasable_outputs) {
+      const XlaCompiler::OutputDescription& output =
+          (*outputs)[output_and_index.first];
+      for (int arg_num = 0, end = args.size(); arg_num < end; ++arg_num) {
+        const XlaCompiler::Argument& arg = args[arg_num];
+        int param_num = use_tuple_arg ? 0 : arg_num;
+        if (arg.kind != XlaCompiler::Argument::kParameter ||
+            arg.type != output.type ||
+            !absl::holds_alternative<TensorShape>(arg.shape) ||
+            absl::get<TensorShape>(arg.shape) != output.shape ||
+            aliased_args.contains(arg_num) ||
+            !argument_to_xla_arg.count(param_num)) {
+          continue;
+        }
+        aliased_args.insert(arg_num);
+        xla::ShapeIndex param_index =
+            use_tuple_arg ? xla::ShapeIndex({arg_num}) : xla::ShapeIndex{};
+        int xla_param_num = argument_to_xla_arg[param_num];
+        xla::ShapeIndex output_index =
+            xla::ShapeIndex({output_and_index.second});
+        VLOG(3) << "Storing alias: " << output_index.ToString() << ": ("
+                << xla_param_num << ", " << param_index.ToString() << ")";
+        aliases.push_back({output_index, xla_param_num, param_index});
+        break;
+      }
+    }
+  }
+
   // If we have token output, append it as the last one.
   if (token_output) {
     elems.push_back(*token_output);
@@ -1426,7 +1469,8 @@ Status XlaCompiler::CompileGraph(
       options.is_entry_computation,
       options.return_updated_values_for_all_resources,
       options.always_return_tuple, options.use_tuple_arg,
-      options.alias_resource_update, &builder, result->computation.get(),
+      options.alias_resource_update, options.alias_compatible_inputs, &builder,
+      result->computation.get(),
       &num_computation_outputs, &num_nonconst_outputs, &result->outputs,
       &result->resource_updates, &result->xla_output_shape,
       result->input_mapping));
@@ -132,6 +132,14 @@ class XlaCompiler {
     // Resource updates are converted into input / output of xla. The two
     // buffers are aliased with other if this option is true.
     bool alias_resource_update = false;
+
+    // If 'alias_compatible_inputs' is true, non-resource outputs of an entry
+    // computation are marked as possibly sharing a buffer with an argument of
+    // the same type and shape. The aliases are may-alias: at run time the
+    // launch code only donates an argument buffer when it holds the last
+    // reference to it, which lets computations such as optimizer updates run
+    // in place instead of copying at the cluster boundary.
+    bool alias_compatible_inputs = false;
   };
 
   using OutputDescription = ::tensorflow::XlaOutputDescription;
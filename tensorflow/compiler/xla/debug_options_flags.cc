@@ -747,6 +747,12 @@ static void AllocateFlags() {
       bool_setter_for(&DebugOptions::set_xla_gpu_simplify_all_fp_conversions),
       flag_values->xla_gpu_simplify_all_fp_conversions(),
       "Allows any chain of floating-point conversions to be simplified."));
+  flag_objects->push_back(tensorflow::Flag(
+      "xla_hlo_pass_fingerprint_skip",
+      bool_setter_for(&DebugOptions::set_xla_hlo_pass_fingerprint_skip),
+      flag_values->xla_hlo_pass_fingerprint_skip(),
+      "Skip an HLO pass when the module is bit-identical to what the same "
+      "pass last ran against without making changes."));
 
   ParseFlagsFromEnvAndDieIfUnknown("XLA_FLAGS", *flag_objects);
 }  // NOLINT(readability/fn_size)
@@ -798,7 +798,13 @@ GpuConvAlgorithmPicker::PickBestAlgorithmNoCacheRocm(
   const auto device_ordinal = stream_exec_->device_ordinal();
   std::vector<se::DeviceMemoryBase> operand_buffers;
 
-  ScratchAllocator input_output_allocator(device_ordinal, allocator);
+  // Sub-allocate all autotuning buffers from one arena so that trying each
+  // algorithm below does not round-trip through the device allocator. The
+  // arena releases the underlying slabs when it goes out of scope, after the
+  // ScratchAllocators below have been destroyed.
+  se::ArenaDeviceMemoryAllocator arena_allocator(allocator, device_ordinal);
+
+  ScratchAllocator input_output_allocator(device_ordinal, &arena_allocator);
   const auto initialize_buffer = [stream](DeviceMemoryBase buffer) {
     // Although we don't have evidence this matters, zero out the buffers
     // before autotuning.  It's conceivable that using uninitialized memory as
@@ -824,7 +830,7 @@ GpuConvAlgorithmPicker::PickBestAlgorithmNoCacheRocm(
           ShapeUtil::ByteSizeOf(instr->shape().tuple_shapes(0))));
   initialize_buffer(result_buffer);
 
-  ScratchAllocator scratch_allocator(device_ordinal, allocator);
+  ScratchAllocator scratch_allocator(device_ordinal, &arena_allocator);
 
   TF_ASSIGN_OR_RETURN(
       std::vector<std::unique_ptr<const se::dnn::ConvRunner>> runners,
@@ -22,6 +22,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
 #include "tensorflow/compiler/xla/service/dump.h"
 #include "tensorflow/compiler/xla/service/hlo_graph_dumper.h"
 #include "tensorflow/compiler/xla/service/hlo_proto_util.h"
@@ -166,6 +167,14 @@ StatusOr<bool> HloPassPipeline::RunPassesInternal(
   RecordPassEndMetadata(*hlo, std::string(kPipelineStart),
                         /*module_changed=*/false);
 
+  // When fingerprint-based skipping is enabled, remember the fingerprint each
+  // pass last ran against without making changes. A pass whose input is
+  // bit-identical to what it previously left unchanged will leave it
+  // unchanged again, so repeated pipeline entries of the same pass can be
+  // skipped for as long as no intervening pass modifies the module.
+  const bool fingerprint_skip = debug_options.xla_hlo_pass_fingerprint_skip();
+  absl::flat_hash_map<std::string, size_t> unchanged_fingerprints;
+
   bool changed = false;
   for (int i = 0; i < passes.size(); i++) {
     HloPassInterface* pass = passes[i];
@@ -173,11 +182,29 @@ StatusOr<bool> HloPassPipeline::RunPassesInternal(
     std::string pass_name = std::string(pass->name());
     VLOG(1) << "  HLO pass " << pass_name;
     VLOG(2) << "  Module hash " << absl::HashOf(*hlo);
+    absl::optional<size_t> fingerprint;
+    if (fingerprint_skip) {
+      fingerprint = absl::HashOf(*hlo);
+      auto it = unchanged_fingerprints.find(pass_name);
+      if (it != unchanged_fingerprints.end() && it->second == *fingerprint) {
+        VLOG(1) << "  Skipping HLO pass " << pass_name
+                << ": fingerprint unchanged since the pass last ran without "
+                   "making changes";
+        continue;
+      }
+    }
     if (!pass->IsPassPipeline()) {
       compilation_stats_->StartPass(pass_name);
     }
     RecordPassStartMetadata(*hlo, pass_name, pipeline_name);
     TF_ASSIGN_OR_RETURN(bool pass_changed, RunHelper(pass, hlo));
+    if (fingerprint_skip) {
+      if (pass_changed) {
+        unchanged_fingerprints.erase(pass_name);
+      } else {
+        unchanged_fingerprints[pass_name] = *fingerprint;
+      }
+    }
     SetInstructionMetadata(*hlo);
     if (!dump_regex.empty() && (pass_changed || dump_regex != ".*")) {
       MaybeDumpHloAndSaveFilenames(*hlo,
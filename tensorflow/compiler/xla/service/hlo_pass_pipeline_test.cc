@@ -82,6 +82,22 @@ class BazToQuxModuleGroupPass : public HloModuleGroupPass {
   }
 };
 
+// A module pass which makes no changes and counts how often it ran.
+class CountingUnchangedPass : public HloModulePass {
+ public:
+  explicit CountingUnchangedPass(int* run_count) : run_count_(run_count) {}
+
+  absl::string_view name() const override { return "counting-unchanged"; }
+
+  StatusOr<bool> Run(HloModule* module) override {
+    ++*run_count_;
+    return false;
+  }
+
+ private:
+  int* run_count_;
+};
+
 // An invariant checker pass which returns an error if there exists an
 // instruction named 'bar'.
 class BarBlowerUpper : public HloModulePass {
@@ -142,6 +158,49 @@ ENTRY main {
   EXPECT_FALSE(changed);
 }
 
+TEST_F(HloPassPipelineTest, FingerprintSkipUnchangedPass) {
+  // With fingerprint-based skipping enabled, a pass is skipped when the
+  // module is bit-identical to what the same pass last left unchanged.
+  const std::string module_str = R"(
+HloModule FingerprintSkipUnchangedPass
+
+ENTRY main {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT blahblah = f32[] multiply(a, b)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(module_str));
+
+  {
+    // Without the debug option both pipeline entries run.
+    int run_count = 0;
+    HloPassPipeline pipeline(TestName());
+    pipeline.AddPass<CountingUnchangedPass>(&run_count);
+    pipeline.AddPass<CountingUnchangedPass>(&run_count);
+    TF_ASSERT_OK_AND_ASSIGN(bool changed, pipeline.Run(module.get()));
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(run_count, 2);
+  }
+
+  DebugOptions debug_options = module->config().debug_options();
+  debug_options.set_xla_hlo_pass_fingerprint_skip(true);
+  module->config().set_debug_options(debug_options);
+
+  {
+    // With the debug option the second entry is skipped because the first
+    // entry left an identical module unchanged.
+    int run_count = 0;
+    HloPassPipeline pipeline(TestName());
+    pipeline.AddPass<CountingUnchangedPass>(&run_count);
+    pipeline.AddPass<CountingUnchangedPass>(&run_count);
+    TF_ASSERT_OK_AND_ASSIGN(bool changed, pipeline.Run(module.get()));
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(run_count, 1);
+  }
+}
+
 TEST_F(HloPassPipelineTest, MixedPipeline) {
   // Test a pipeline with both a module pass and a module group pass.
   const std::string module_0_str = R"(
@@ -83,6 +83,22 @@ BFCAllocator::BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator,
 }
 
 BFCAllocator::~BFCAllocator() {
+  // Reclaim chunks parked in per-thread caches and orphan the caches so that
+  // their owning threads no longer touch this allocator. As with the rest of
+  // the destructor, this assumes no allocations or deallocations are
+  // concurrently in flight.
+  {
+    mutex_lock l(thread_cache_registry_mu_);
+    for (ThreadCache* cache : thread_caches_) {
+      for (const auto& entry : cache->entries_) {
+        DeallocateRawInternal(entry.second);
+      }
+      cache->entries_.clear();
+      cache->Orphan();
+    }
+    thread_caches_.clear();
+  }
+
   // Return memory back.
   VLOG(2) << "Number of regions allocated: "
           << region_manager_.regions().size();
@@ -255,9 +271,115 @@ void* BFCAllocator::AllocateRawInternalWithRetry(
   }
 }
 
+BFCAllocator::ThreadCache::ThreadCache(BFCAllocator* allocator)
+    : allocator_(allocator) {
+  entries_.reserve(kMaxEntries);
+  mutex_lock l(allocator_->thread_cache_registry_mu_);
+  allocator_->thread_caches_.push_back(this);
+}
+
+BFCAllocator::ThreadCache::~ThreadCache() {
+  if (orphaned()) return;
+  // Hold the registry lock across the flush so that the allocator cannot be
+  // destroyed between unregistration and the return of the cached chunks.
+  mutex_lock l(allocator_->thread_cache_registry_mu_);
+  auto& caches = allocator_->thread_caches_;
+  caches.erase(std::remove(caches.begin(), caches.end(), this), caches.end());
+  Flush();
+}
+
+void* BFCAllocator::ThreadCache::PopExact(size_t rounded_bytes) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->first == rounded_bytes) {
+      void* ptr = it->second;
+      *it = entries_.back();
+      entries_.pop_back();
+      return ptr;
+    }
+  }
+  return nullptr;
+}
+
+bool BFCAllocator::ThreadCache::Push(size_t rounded_bytes, void* ptr) {
+  if (entries_.size() >= kMaxEntries) return false;
+  entries_.push_back({rounded_bytes, ptr});
+  return true;
+}
+
+void BFCAllocator::ThreadCache::Flush() {
+  for (const auto& entry : entries_) {
+    allocator_->DeallocateRawInternal(entry.second);
+  }
+  entries_.clear();
+}
+
+BFCAllocator::ThreadCache* BFCAllocator::GetThreadCache() {
+  // One cache per (thread, allocator) pair. A cache is replaced if it was
+  // orphaned by the destruction of a previous allocator that happened to live
+  // at the same address (only plausible in tests).
+  static thread_local std::unordered_map<const BFCAllocator*,
+                                         std::unique_ptr<ThreadCache>>
+      caches;
+  std::unique_ptr<ThreadCache>& slot = caches[this];
+  if (slot == nullptr || slot->orphaned()) {
+    slot.reset(new ThreadCache(this));
+  }
+  return slot.get();
+}
+
+bool BFCAllocator::TryCacheDeallocation(void* ptr)
+    TF_NO_THREAD_SAFETY_ANALYSIS {
+  size_t chunk_size;
+  {
+    // A shared lock suffices here: the chunk is in use, so no other thread
+    // can free, split or merge it, and writers of the region map hold the
+    // lock exclusively.
+    tf_shared_lock l(lock_);
+    BFCAllocator::ChunkHandle h = region_manager_.get_handle(ptr);
+    CHECK(h != kInvalidChunkHandle);
+    const Chunk* c = ChunkFromHandle(h);
+    if (c->size > kMaxThreadCacheSize) return false;
+    chunk_size = c->size;
+  }
+  ThreadCache* cache = GetThreadCache();
+  if (!cache->Push(chunk_size, ptr)) {
+    // Cache overflow: return everything to the bins in one batch, then park
+    // the chunk in the now-empty cache.
+    cache->Flush();
+    cache->Push(chunk_size, ptr);
+  }
+  return true;
+}
+
+void* BFCAllocator::TryCachedAllocation(size_t num_bytes)
+    TF_NO_THREAD_SAFETY_ANALYSIS {
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  void* cached = GetThreadCache()->PopExact(rounded_bytes);
+  if (cached == nullptr) return nullptr;
+  // The chunk stayed "in use" while parked in the cache, so no
+  // allocator-level stats need updating; only the per-chunk bookkeeping is
+  // refreshed. A shared lock suffices because only the owner of an in-use
+  // chunk touches these fields.
+  tf_shared_lock l(lock_);
+  BFCAllocator::ChunkHandle h = region_manager_.get_handle(cached);
+  Chunk* chunk = ChunkFromHandle(h);
+  chunk->requested_size = num_bytes;
+  chunk->allocation_id = next_allocation_id_++;
+  return cached;
+}
+
 void* BFCAllocator::AllocateRaw(size_t unused_alignment, size_t num_bytes,
                                 const AllocationAttributes& allocation_attr) {
   VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes;
+  if (ThreadCachingActive() && num_bytes > 0 &&
+      num_bytes <= kMaxThreadCacheSize) {
+    void* cached = TryCachedAllocation(num_bytes);
+    if (cached != nullptr) {
+      VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes << " " << cached
+              << " (thread cache)";
+      return cached;
+    }
+  }
   void* result = [&] {
     if (!opts_.allow_retry_on_failure || !allocation_attr.retry_on_failure) {
       // If we have globally disabled retry-on-failure and fail to allocate an
@@ -678,6 +800,10 @@ void BFCAllocator::SplitChunk(BFCAllocator::ChunkHandle h, size_t num_bytes) {
 void BFCAllocator::DeallocateRaw(void* ptr) {
   VLOG(3) << "DeallocateRaw " << Name() << " "
           << (ptr ? RequestedSize(ptr) : 0);
+  if (ThreadCachingActive() && ptr != nullptr && TryCacheDeallocation(ptr)) {
+    retry_helper_.NotifyDealloc();
+    return;
+  }
   DeallocateRawInternal(ptr);
   retry_helper_.NotifyDealloc();
 }
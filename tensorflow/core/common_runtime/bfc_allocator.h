@@ -17,10 +17,12 @@ limitations under the License.
 #define TENSORFLOW_CORE_COMMON_RUNTIME_BFC_ALLOCATOR_H_
 
 #include <array>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
@@ -66,6 +68,15 @@ class BFCAllocator : public Allocator {
     // Controls when a chunk should be split, if its size exceeds the requested
     // allocation size.
     double fragmentation_fraction = 0;
+
+    // If true, recently freed small chunks are parked in per-thread caches
+    // and handed back out without taking the allocator lock when an
+    // allocation of the same rounded size arrives on the same thread. Cached
+    // chunks remain "in use" from the allocator's point of view (they are
+    // counted in bytes_in_use) until the cache overflows or the thread
+    // exits. Ignored when a timing counter is set, since cached reuse would
+    // bypass the safe-frontier machinery.
+    bool enable_thread_caching = false;
   };
   BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator, size_t total_memory,
                const string& name, const Options& opts);
@@ -118,6 +129,60 @@ class BFCAllocator : public Allocator {
 
   void DeallocateRawInternal(void* ptr);
 
+  // A small per-thread cache of recently freed chunks, enabled via
+  // Options::enable_thread_caching. The cache is only ever touched by its
+  // owning thread, so Push/PopExact need no locking.
+  class ThreadCache {
+   public:
+    explicit ThreadCache(BFCAllocator* allocator);
+    ~ThreadCache();
+
+    // Removes and returns a cached pointer whose chunk size is exactly
+    // `rounded_bytes`, or nullptr if there is none.
+    void* PopExact(size_t rounded_bytes);
+
+    // Caches `ptr`. Returns false if the cache is full.
+    bool Push(size_t rounded_bytes, void* ptr);
+
+    // Returns all cached pointers to the allocator's bins.
+    void Flush();
+
+    // Called by the allocator's destructor after reclaiming the cached
+    // pointers; the cache must not touch the allocator afterwards.
+    void Orphan() { allocator_ = nullptr; }
+    bool orphaned() const { return allocator_ == nullptr; }
+
+   private:
+    friend class BFCAllocator;
+
+    static constexpr int kMaxEntries = 64;
+
+    BFCAllocator* allocator_;
+    // (chunk size, pointer) pairs; small enough that linear scans are cheap.
+    std::vector<std::pair<size_t, void*>> entries_;
+  };
+
+  // Returns the calling thread's cache for this allocator, creating it if
+  // necessary.
+  ThreadCache* GetThreadCache();
+
+  // Attempts to park `ptr` in the calling thread's cache instead of
+  // returning it to the bins. Returns false if the chunk is not eligible for
+  // caching.
+  bool TryCacheDeallocation(void* ptr);
+
+  // Attempts to serve an allocation of `num_bytes` from the calling thread's
+  // cache. Returns nullptr on a cache miss.
+  void* TryCachedAllocation(size_t num_bytes);
+
+  // Returns true if the thread-caching fast path is active.
+  bool ThreadCachingActive() const {
+    return opts_.enable_thread_caching && timing_counter_ == nullptr;
+  }
+
+  // Largest chunk size eligible for thread caching.
+  static constexpr size_t kMaxThreadCacheSize = 64 * 1024;
+
   // Chunks whose freed_at_count is later than the safe frontier value are kept
   // on a special list and not subject to merging immediately upon being freed.
   //
@@ -606,8 +671,15 @@ class BFCAllocator : public Allocator {
   ChunkHandle free_chunks_list_ TF_GUARDED_BY(lock_);
 
   // Counter containing the next unique identifier to assign to a
-  // newly-created chunk.
-  int64_t next_allocation_id_ TF_GUARDED_BY(lock_);
+  // newly-created chunk. Atomic so that the thread-caching fast path can
+  // assign ids while holding `lock_` only in shared mode.
+  std::atomic<int64_t> next_allocation_id_;
+
+  // Registry of live per-thread caches, used by the destructor to reclaim
+  // cached chunks. Lock ordering: `thread_cache_registry_mu_` before `lock_`.
+  mutex thread_cache_registry_mu_;
+  std::vector<ThreadCache*> thread_caches_
+      TF_GUARDED_BY(thread_cache_registry_mu_);
 
   // Stats.
   AllocatorStats stats_ TF_GUARDED_BY(lock_);
@@ -54,6 +54,13 @@ CollectiveParamResolverLocal::CollectiveParamResolverLocal(
       gpu_ring_order_(
           config.gpu_options().experimental().collective_ring_order()) {}
 
+CollectiveParamResolverLocal::~CollectiveParamResolverLocal() {
+  mutex_lock l(param_cache_mu_);
+  for (auto& iter : param_cache_) {
+    iter.second->Unref();
+  }
+}
+
 void CollectiveParamResolverLocal::CompleteGroupAsync(
     const DeviceAttributes& device, CollGroupParams* group_params,
     CancellationManager* cancel_mgr, const StatusCallback& done) {
@@ -67,7 +74,11 @@ const char* GetCollectiveName(const CollectiveParams* cp, bool nccl) {
       return nccl ? "NcclBroadcast" : "HierarchicalTreeBroadcast";
 
     case REDUCTION_COLLECTIVE:
-      return nccl ? "NcclReduce" : "RingReduce";
+      if (nccl) return "NcclReduce";
+      // When the group spans tasks, reduce within each task first so that
+      // the cross-task links carry one tensor per task instead of one per
+      // device.
+      return cp->group.num_tasks > 1 ? "HierarchicalTreeReduce" : "RingReduce";
 
     case GATHER_COLLECTIVE:
       return nccl ? "NcclGather" : "RingGather";
@@ -641,28 +652,95 @@ Status CollectiveParamResolverLocal::LookupGroup(int32_t group_key,
   return OkStatus();
 }
 
+string CollectiveParamResolverLocal::ParamCacheKey(const string& device,
+                                                   const CollectiveParams* cp) {
+  return strings::StrCat(cp->group.group_key, ";", cp->instance.instance_key,
+                         ";", device, ";",
+                         cp->instance.shape.DebugString());
+}
+
+bool CollectiveParamResolverLocal::LookupCachedParams(const string& device,
+                                                      CollectiveParams* cp) {
+  {
+    mutex_lock l(status_mu_);
+    if (!status_.ok()) return false;
+  }
+  const CollectiveParams* cached = nullptr;
+  {
+    tf_shared_lock l(param_cache_mu_);
+    auto it = param_cache_.find(ParamCacheKey(device, cp));
+    if (it == param_cache_.end()) return false;
+    cached = it->second;
+  }
+  // The same consistency check as in CompleteInstanceLocal; a mismatch must
+  // take the uncached path so it surfaces the usual error.
+  if (cached->instance.type != cp->instance.type ||
+      cached->instance.data_type != cp->instance.data_type) {
+    return false;
+  }
+  // cached entries are immutable once published, so reading them outside the
+  // lock is safe; the custom operator= does a deep copy.
+  cp->group = cached->group;
+  cp->instance = cached->instance;
+  cp->default_rank = cached->default_rank;
+  cp->source_rank = cached->source_rank;
+  cp->subdiv_rank = cached->subdiv_rank;
+  return true;
+}
+
+void CollectiveParamResolverLocal::CacheResolvedParams(
+    const string& device, const CollectiveParams* cp) {
+  string key = ParamCacheKey(device, cp);
+  CollectiveParams* copy = new CollectiveParams();
+  copy->group = cp->group;
+  copy->instance = cp->instance;
+  copy->default_rank = cp->default_rank;
+  copy->source_rank = cp->source_rank;
+  copy->subdiv_rank = cp->subdiv_rank;
+  mutex_lock l(param_cache_mu_);
+  if (!param_cache_.insert({std::move(key), copy}).second) {
+    // Another resolution for the same key won the race.
+    copy->Unref();
+  }
+}
+
 void CollectiveParamResolverLocal::CompleteParamsAsync(
     const DeviceAttributes& device, CollectiveParams* cp,
     CancellationManager* cancel_mgr, const StatusCallback& done) {
   VLOG(1) << "CompleteParams local " << device.name() << " for " << cp << ": "
           << cp->ToString();
+  if (LookupCachedParams(device.name(), cp)) {
+    VLOG(1) << "CompleteParams local " << device.name()
+            << " served from cache for instance "
+            << cp->instance.instance_key;
+    done(OkStatus());
+    return;
+  }
+  StatusCallback done_and_cache = [this, device_name = device.name(), cp,
+                                   done](const Status& s) {
+    if (s.ok()) {
+      CacheResolvedParams(device_name, cp);
+    }
+    done(s);
+  };
   if (cp->run_group_initialization) {
-    CompleteGroupLocal(device, &cp->group, cancel_mgr,
-                       [this, device, cp, done](const Status& s) {
-                         if (s.ok()) {
-                           CompleteInstanceLocal(device.name(), cp, done);
-                         } else {
-                           done(s);
-                         }
-                       });
+    CompleteGroupLocal(
+        device, &cp->group, cancel_mgr,
+        [this, device, cp, done_and_cache](const Status& s) {
+          if (s.ok()) {
+            CompleteInstanceLocal(device.name(), cp, done_and_cache);
+          } else {
+            done_and_cache(s);
+          }
+        });
   } else {
     // For Collective V3 ops, group is already initialized. Fetch attributes
     // for the already initialized group to pass to Insitance initialization.
     const auto s = LookupGroup(cp->group.group_key, &cp->group);
     if (s.ok()) {
-      CompleteInstanceLocal(device.name(), cp, done);
+      CompleteInstanceLocal(device.name(), cp, done_and_cache);
     } else {
-      done(s);
+      done_and_cache(s);
     }
   }
 }
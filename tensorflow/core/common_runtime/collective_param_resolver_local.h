@@ -46,7 +46,7 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
                                NcclCommunicatorInterface* nccl_communicator,
                                const string& task_name);
 
-  ~CollectiveParamResolverLocal() override {}
+  ~CollectiveParamResolverLocal() override;
 
   void CompleteParamsAsync(const DeviceAttributes& device, CollectiveParams* cp,
                            CancellationManager* cancel_mgr,
@@ -185,6 +185,21 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
   void StartAbortLocal(const Status& s)
       TF_LOCKS_EXCLUDED(status_mu_, group_mu_, instance_mu_);
 
+  // Cache key identifying one fully resolved set of params: the same group,
+  // instance, device and shape always resolve to the same result while the
+  // cluster topology is unchanged.
+  static string ParamCacheKey(const string& device, const CollectiveParams* cp);
+
+  // If params for cp have been resolved before on this device and shape,
+  // copies the resolved fields into *cp and returns true. Takes only a shared
+  // lock, so steady-state lookups do not serialize against each other.
+  bool LookupCachedParams(const string& device, CollectiveParams* cp)
+      TF_LOCKS_EXCLUDED(param_cache_mu_, status_mu_);
+
+  // Records fully resolved *cp so later steps can skip resolution.
+  void CacheResolvedParams(const string& device, const CollectiveParams* cp)
+      TF_LOCKS_EXCLUDED(param_cache_mu_);
+
   const bool nccl_;
   const DeviceMgr* dev_mgr_;
   DeviceResolverInterface* dev_resolver_;  // Not owned.
@@ -199,6 +214,11 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
       instance_table_ TF_GUARDED_BY(instance_mu_);
   mutex status_mu_;
   Status status_ TF_GUARDED_BY(status_mu_);
+  // Memoized results of previous resolutions, keyed by ParamCacheKey().
+  // Values are owned (Ref held) and Unref'd in the destructor.
+  mutable mutex param_cache_mu_;
+  gtl::FlatMap<string, CollectiveParams*> param_cache_
+      TF_GUARDED_BY(param_cache_mu_);
 };
 
 }  // namespace tensorflow
@@ -482,6 +482,25 @@ Graph* GetConstantGraph(
   return constant_graph;
 }
 
+// Returns an estimate of the size in bytes of the constant that would replace
+// 'tensor', based on the shapes inferred in 'opts.shape_map'. Tensors whose
+// shape is not fully known are assumed to be as large as the per-constant
+// size cap, since anything larger is discarded after evaluation anyway.
+int64_t EstimatedConstantSize(const ConstantFoldingOptions& opts,
+                              NodeAndOutput tensor) {
+  if (opts.shape_map != nullptr) {
+    auto it = opts.shape_map->find(tensor.first->name());
+    if (it != opts.shape_map->end() && tensor.second < it->second.size()) {
+      const PartialTensorShape& shape = it->second[tensor.second];
+      if (shape.IsFullyDefined()) {
+        return shape.num_elements() *
+               DataTypeSize(tensor.first->output_type(tensor.second));
+      }
+    }
+  }
+  return opts.max_constant_size_in_bytes;
+}
+
 // Replaces the identified Tensor in 'graph' by a 'Const' node with
 // the value supplied in 'constant'. 'partition_device', if non-null
 // is the device where the graph executes. Returns true if the
@@ -658,26 +677,54 @@ Status ConstantFold(const ConstantFoldingOptions& opts,
     graph_runner.reset(nullptr);
   });
 
-  Status s =
-      graph_runner->Run(constant_graph.get(), function_library, {} /* inputs*/,
-                        tensors_to_fetch_names, &outputs);
-  if (!s.ok()) {
-    VLOG(1) << "Could not fetch constants: " << s;
-    *was_mutated = false;
-    return s;
-  }
-
-  // Fetch the constant tensors and replace the corresponding tensors in the
-  // original graph with those constants.
+  // Evaluate all the fetches in a single run when their estimated total size
+  // fits under max_total_constant_size_in_bytes; otherwise stream them in
+  // several size-bounded batches, replacing the tensors of each batch in the
+  // original graph before materializing the next one.
   int32_t num_nodes_replaced = 0;
-  for (size_t c = 0; c < outputs.size(); ++c) {
-    const gtl::FlatSet<Node*>& control_deps =
-        constant_control_deps[tensors_to_replace[c].first];
-    if (ReplaceTensorWithConstant(
-            graph, partition_device, tensors_to_replace[c], outputs[c],
-            control_deps, opts.max_constant_size_in_bytes, generate_new_name)) {
-      ++num_nodes_replaced;
+  size_t batch_begin = 0;
+  while (batch_begin < tensors_to_fetch_names.size()) {
+    size_t batch_end = batch_begin;
+    int64_t batch_size_estimate = 0;
+    while (batch_end < tensors_to_fetch_names.size()) {
+      const int64_t size_estimate =
+          EstimatedConstantSize(opts, tensors_to_replace[batch_end]);
+      if (batch_end > batch_begin &&
+          batch_size_estimate + size_estimate >
+              opts.max_total_constant_size_in_bytes) {
+        break;
+      }
+      batch_size_estimate += size_estimate;
+      ++batch_end;
+    }
+
+    std::vector<string> batch_fetch_names(
+        tensors_to_fetch_names.begin() + batch_begin,
+        tensors_to_fetch_names.begin() + batch_end);
+    Status s =
+        graph_runner->Run(constant_graph.get(), function_library,
+                          {} /* inputs*/, batch_fetch_names, &outputs);
+    if (!s.ok()) {
+      VLOG(1) << "Could not fetch constants: " << s;
+      *was_mutated = (num_nodes_replaced > 0);
+      return s;
     }
+
+    // Fetch the constant tensors and replace the corresponding tensors in the
+    // original graph with those constants.
+    for (size_t c = 0; c < outputs.size(); ++c) {
+      const gtl::FlatSet<Node*>& control_deps =
+          constant_control_deps[tensors_to_replace[batch_begin + c].first];
+      if (ReplaceTensorWithConstant(graph, partition_device,
+                                    tensors_to_replace[batch_begin + c],
+                                    outputs[c], control_deps,
+                                    opts.max_constant_size_in_bytes,
+                                    generate_new_name)) {
+        ++num_nodes_replaced;
+      }
+    }
+    outputs.clear();
+    batch_begin = batch_end;
   }
 
   DumpGraph("After", graph);
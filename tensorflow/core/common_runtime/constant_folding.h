@@ -45,6 +45,12 @@ struct ConstantFoldingOptions {
   // optimization.
   int64_t max_constant_size_in_bytes = 10 * 1024 * 1024;
 
+  // The maximum estimated total size of the constants materialized at once
+  // while folding. When the estimate for all foldable tensors exceeds this
+  // limit, they are evaluated in several smaller batches instead of a single
+  // one, bounding the transient memory used by constant folding.
+  int64_t max_total_constant_size_in_bytes = 256 * 1024 * 1024;
+
   // A generator for the name suffix of constant folded nodes. A
   // default id generator that monotonically increases is used if nullptr is
   // passed.
@@ -134,6 +134,32 @@ TEST_F(ConstantFoldingTest, Basic) {
                          {2, 2});
 }
 
+TEST_F(ConstantFoldingTest, StreamedEvaluation) {
+  Scope s = Scope::NewRootScope();
+  BuildSimpleGraph(&s);
+  Graph g(OpRegistry::Global());
+  TF_ASSERT_OK(s.ToGraph(&g));
+
+  // Force the two foldable tensors to be evaluated in separate batches.
+  ConstantFoldingOptions opts;
+  opts.max_total_constant_size_in_bytes = 4 * sizeof(float);
+  bool was_mutated;
+  TF_ASSERT_OK(
+      ConstantFold(opts, nullptr, Env::Default(), nullptr, &g, &was_mutated));
+  EXPECT_TRUE(was_mutated);
+
+  std::unordered_map<string, Node*> index = g.BuildNodeNameIndex();
+  Node* s1 = index.at("s1");
+  Node* s2 = index.at("s2");
+  // Nodes s1 and s2 now should now have a constant input
+  EXPECT_EQ(1, s1->num_inputs());
+  ExpectNodeClose<float>(*(s1->in_nodes().begin()), {1.0, 2.0, 3.0, 4.0},
+                         {2, 2});
+  EXPECT_EQ(1, s2->num_inputs());
+  ExpectNodeClose<float>(*(s2->in_nodes().begin()), {2.0, 1.0, 4.0, 3.0},
+                         {2, 2});
+}
+
 // Tests that different node creation ordering creates same graph after constant
 // folding.
 TEST_F(ConstantFoldingTest, DeterministicFolding) {
@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/common_runtime/scoped_allocator_mgr.h"
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -63,6 +64,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/core/threadpool_options.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/numbers.h"
@@ -645,6 +647,18 @@ Status DirectSession::RunInternal(
 
   // Start parallel Executors.
 
+  // If configured, serve unconstrained CPU allocations for this step from an
+  // arena that is released wholesale when the step completes. The arena
+  // deletes itself once the step is done and all outstanding allocations
+  // (including fetched outputs) have been returned.
+  StepArenaAllocator* step_arena = nullptr;
+  if (options_.config.experimental().use_per_step_arena_allocator()) {
+    step_arena = new StepArenaAllocator(cpu_allocator());
+  }
+  auto step_arena_cleanup = gtl::MakeCleanup([step_arena] {
+    if (step_arena != nullptr) step_arena->MarkStepDone();
+  });
+
   // We can execute this step synchronously on the calling thread whenever
   // there is a single device and the timeout mechanism is not used.
   //
@@ -667,6 +681,12 @@ Status DirectSession::RunInternal(
   args.sync_on_finish = sync_on_finish_;
   args.user_intra_op_threadpool = threadpool_options.intra_op_threadpool;
   args.run_all_kernels_inline = pool == nullptr;
+  args.use_work_stealing =
+      pool != nullptr &&
+      options_.config.experimental().use_work_stealing_executor();
+  args.use_measured_cost_scheduling =
+      pool != nullptr &&
+      options_.config.experimental().use_measured_cost_scheduling();
   args.start_time_usecs = start_time_usecs;
   args.deadline = deadline;
 
@@ -707,8 +727,12 @@ Status DirectSession::RunInternal(
   Status run_status;
 
   auto set_threadpool_args_for_item =
-      [&default_runner, &handler](const PerPartitionExecutorsAndLib& item,
-                                  Executor::Args* args) {
+      [&default_runner, &handler,
+       step_arena](const PerPartitionExecutorsAndLib& item,
+                   Executor::Args* args) {
+        // The arena is backed by host memory, so only CPU partitions use it.
+        args->step_allocator =
+            (item.device->device_type() == DEVICE_CPU) ? step_arena : nullptr;
         // TODO(azaks): support partial run.
         // TODO(azaks): if the device picks its own threadpool, we need to
         // assign
@@ -1504,12 +1528,19 @@ Status DirectSession::GetOrCreateExecutors(
         strings::StrCat(key, ";", handle_name_counter_value);
   }
 
+  // Lock-free fast path for hot signatures.
+  if (ExecutorsAndKeys* cached = LookupSignatureCache(key)) {
+    *executors_and_keys = cached;
+    return OkStatus();
+  }
+
   // See if we already have the executors for this run.
   {
     mutex_lock l(executor_lock_);  // could use reader lock
     auto it = executors_.find(key);
     if (it != executors_.end()) {
       *executors_and_keys = it->second.get();
+      InsertSignatureCache(key, it->second.get());
       return OkStatus();
     }
   }
@@ -1543,6 +1574,9 @@ Status DirectSession::GetOrCreateExecutors(
     auto it = executors_.find(sorted_key);
     if (it != executors_.end()) {
       *executors_and_keys = it->second.get();
+      // Cache under the unsorted key so that future lookups with the same
+      // ordering take the lock-free path.
+      InsertSignatureCache(key, it->second.get());
       return OkStatus();
     }
   }
@@ -1588,10 +1622,50 @@ Status DirectSession::GetOrCreateExecutors(
   // if the user uses the same order of inputs, outputs, and targets again.
   executors_.emplace(key, insert_result.first->second);
   *executors_and_keys = insert_result.first->second.get();
+  InsertSignatureCache(key, insert_result.first->second.get());
 
   return OkStatus();
 }
 
+DirectSession::ExecutorsAndKeys* DirectSession::LookupSignatureCache(
+    const string& key) const {
+  const int n = signature_cache_size_.load(std::memory_order_acquire);
+  for (int i = 0; i < n; ++i) {
+    // Slots below `n` were fully written before the release store to
+    // `signature_cache_size_` and are immutable afterwards.
+    const SignatureCacheSlot& slot = signature_cache_[i];
+    if (slot.key == key) return slot.value;
+  }
+  return nullptr;
+}
+
+void DirectSession::InsertSignatureCache(const string& key,
+                                         ExecutorsAndKeys* value) {
+  const int n = signature_cache_size_.load(std::memory_order_relaxed);
+  if (n >= kSignatureCacheSize) return;
+  for (int i = 0; i < n; ++i) {
+    if (signature_cache_[i].key == key) return;
+  }
+  SignatureCacheSlot& slot = signature_cache_[n];
+  slot.key = key;
+  slot.value = value;
+  // Publish the slot contents before making them visible to readers.
+  signature_cache_size_.store(n + 1, std::memory_order_release);
+}
+
+Status DirectSession::PreWarmExecutors(const std::vector<string>& inputs,
+                                       const std::vector<string>& outputs,
+                                       const std::vector<string>& target_nodes) {
+  TF_RETURN_IF_ERROR(CheckNotClosed());
+  TF_RETURN_IF_ERROR(CheckGraphCreated("PreWarmExecutors()"));
+
+  DebugOptions debug_options;
+  RunStateArgs run_state_args(debug_options);
+  ExecutorsAndKeys* executors_and_keys;
+  return GetOrCreateExecutors(inputs, outputs, target_nodes,
+                              &executors_and_keys, &run_state_args);
+}
+
 Status DirectSession::CreateGraphs(
     const BuildGraphOptions& subgraph_options,
     std::unordered_map<string, std::unique_ptr<Graph>>* outputs,
@@ -1866,6 +1940,57 @@ Status DirectSession::MakeCallable(const CallableOptions& callable_options,
   RunStateArgs run_state_args(callable_options.run_options().debug_options());
   TF_RETURN_IF_ERROR(
       CreateExecutors(callable_options, &ek, &func_info, &run_state_args));
+
+  // Pre-bind the call-invariant executor arguments so that steady-state
+  // RunCallable() calls skip thread-pool selection, runner construction and
+  // option validation. Restricted to callables the synchronous
+  // single-executor path in RunInternal() handles with no per-step
+  // observers; everything else keeps using RunInternal().
+  const RunOptions& run_options = callable_options.run_options();
+  if (ek->items.size() == 1 &&
+      run_options.trace_level() == RunOptions::NO_TRACE &&
+      run_options.timeout_in_ms() == 0 && operation_timeout_in_ms_ == 0 &&
+      run_options.debug_options().debug_tensor_watch_opts().empty() &&
+      !run_options.experimental().use_run_handler_pool() &&
+      !run_options.output_partition_graphs() &&
+      ek->collective_graph_key == BuildGraphOptions::kNoCollectiveGraphKey &&
+      options_.config.graph_options().build_cost_model() == 0 &&
+      !options_.config.experimental().use_per_step_arena_allocator() &&
+      run_options.inter_op_thread_pool() >= -1 &&
+      run_options.inter_op_thread_pool() <
+          static_cast<int32>(thread_pools_.size())) {
+    thread::ThreadPool* pool = nullptr;
+    if (!run_in_caller_thread_ && run_options.inter_op_thread_pool() != -1) {
+      pool = thread_pools_[run_options.inter_op_thread_pool()].first;
+    }
+    Executor::Args& args = ek->prebound.args;
+    if (pool == nullptr) {
+      args.runner = [](const Executor::Args::Closure& c) { c(); };
+    } else {
+      args.runner = [pool](Executor::Args::Closure c) {
+        pool->Schedule(std::move(c));
+      };
+    }
+    thread::ThreadPool* device_thread_pool =
+        ek->items[0].device->tensorflow_device_thread_pool();
+    if (device_thread_pool != nullptr) {
+      args.runner = [device_thread_pool](Executor::Args::Closure c) {
+        device_thread_pool->Schedule(std::move(c));
+      };
+    }
+    args.session_state = &session_state_;
+    args.session_handle = session_handle_;
+    args.sync_on_finish = sync_on_finish_;
+    args.run_all_kernels_inline = pool == nullptr;
+    args.use_work_stealing =
+        pool != nullptr &&
+        options_.config.experimental().use_work_stealing_executor();
+    args.use_measured_cost_scheduling =
+        pool != nullptr &&
+        options_.config.experimental().use_measured_cost_scheduling();
+    ek->prebound.valid = true;
+  }
+
   {
     mutex_lock l(callables_lock_);
     *out_handle = next_callable_handle_++;
@@ -1923,6 +2048,70 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
                      thread::ThreadPoolOptions());
 }
 
+Status DirectSession::RunCallablePrebound(
+    int64_t step_id, CallFrameInterface* call_frame,
+    ExecutorsAndKeys* executors_and_keys) {
+  const uint64 start_time_usecs = options_.env->NowMicros();
+  executors_and_keys->step_count.fetch_add(1);
+  RunState run_state(step_id, &devices_);
+
+  profiler::TraceMeProducer activity(
+      // To TraceMeConsumers in ExecutorState::Process/Finish.
+      [&] {
+        if (options_.config.experimental().has_session_metadata()) {
+          const auto& model_metadata =
+              options_.config.experimental().session_metadata();
+          string model_id = strings::StrCat(model_metadata.name(), ":",
+                                            model_metadata.version());
+          return profiler::TraceMeEncode("SessionRun",
+                                         {{"id", step_id},
+                                          {"_r", 1} /*root_event*/,
+                                          {"model_id", model_id}});
+        } else {
+          return profiler::TraceMeEncode(
+              "SessionRun", {{"id", step_id}, {"_r", 1} /*root_event*/});
+        }
+      },
+      profiler::ContextType::kTfExecutor, step_id,
+      profiler::TraceMeLevel::kInfo);
+
+  // Register this step with session's cancellation manager, so that
+  // `Session::Close()` will cancel the step.
+  CancellationManager step_cancellation_manager(cancellation_manager_);
+  if (step_cancellation_manager.IsCancelled()) {
+    return errors::Cancelled("Run call was cancelled");
+  }
+
+  Executor::Args args = executors_and_keys->prebound.args;
+  args.step_id = step_id;
+  args.call_frame = call_frame;
+  args.tensor_store = &run_state.tensor_store;
+  args.step_container = &run_state.step_container;
+  args.cancellation_manager = &step_cancellation_manager;
+  args.start_time_usecs = start_time_usecs;
+
+  PrivateIntraProcessRendezvous rendezvous(device_mgr_.get());
+  args.rendezvous = &rendezvous;
+
+  Status run_status = executors_and_keys->items[0].executor->Run(args);
+
+  if (step_cancellation_manager.IsCancelled()) {
+    run_status.Update(errors::Cancelled("Run call was cancelled"));
+  }
+  TF_RETURN_IF_ERROR(run_status);
+
+  // Save the output tensors of this run we choose to keep.
+  if (!run_state.tensor_store.empty()) {
+    TF_RETURN_IF_ERROR(run_state.tensor_store.SaveTensors(
+        {executors_and_keys->callable_options.fetch().begin(),
+         executors_and_keys->callable_options.fetch().end()},
+        &session_state_));
+  }
+
+  metrics::UpdateGraphExecTime(options_.env->NowMicros() - start_time_usecs);
+  return OkStatus();
+}
+
 ::tensorflow::Status DirectSession::RunCallable(
     CallableHandle handle, const std::vector<Tensor>& feed_tensors,
     std::vector<Tensor>* fetch_tensors, RunMetadata* run_metadata,
@@ -2005,9 +2194,21 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
     LogMemory::RecordStep(step_id, run_state_args.handle);
   }
 
-  TF_RETURN_IF_ERROR(RunInternal(
-      step_id, executors_and_keys->callable_options.run_options(), &call_frame,
-      executors_and_keys.get(), run_metadata, threadpool_options));
+  // Steady-state fast path: when the call-invariant executor arguments were
+  // bound in MakeCallable() and the caller supplies no per-call observers or
+  // thread pools, run the executor directly with stack-allocated per-step
+  // state instead of going through RunInternal().
+  if (executors_and_keys->prebound.valid && run_metadata == nullptr &&
+      threadpool_options.inter_op_threadpool == nullptr &&
+      threadpool_options.intra_op_threadpool == nullptr) {
+    TF_RETURN_IF_ERROR(
+        RunCallablePrebound(step_id, &call_frame, executors_and_keys.get()));
+  } else {
+    TF_RETURN_IF_ERROR(RunInternal(
+        step_id, executors_and_keys->callable_options.run_options(),
+        &call_frame, executors_and_keys.get(), run_metadata,
+        threadpool_options));
+  }
 
   if (fetch_tensors != nullptr) {
     size_t output_size = 0;
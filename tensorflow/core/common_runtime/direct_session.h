@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_DIRECT_SESSION_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_DIRECT_SESSION_H_
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -135,6 +136,15 @@ class DirectSession : public Session {
 
   ::tensorflow::Status Finalize() override;
 
+  // Builds and caches the executors for the given feed/fetch/target
+  // signature without running a step, so that the first Run call with this
+  // signature does not pay graph pruning and partitioning cost. The
+  // signature is also installed in the lock-free signature cache.
+  // NOTE: Experimental and subject to change.
+  ::tensorflow::Status PreWarmExecutors(
+      const std::vector<string>& inputs, const std::vector<string>& outputs,
+      const std::vector<string>& target_nodes);
+
   const SessionOptions& options() const { return options_; }
 
  private:
@@ -176,6 +186,19 @@ class DirectSession : public Session {
     CallableOptions callable_options;
 
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+
+    // Call-invariant `Executor::Args` fields, bound once in MakeCallable().
+    // Only populated when the callable runs a single executor synchronously
+    // with no per-step observers (no debugging, tracing, timeouts, cost
+    // model, run-handler pool or collectives). RunCallable() then copies
+    // these args and fills in only the per-step fields, so steady-state
+    // calls skip thread-pool selection, runner construction and option
+    // validation.
+    struct PreboundArgs {
+      bool valid = false;
+      Executor::Args args;
+    };
+    PreboundArgs prebound;
   };
 
   // A FunctionInfo object is created for every unique set of feeds/fetches.
@@ -269,6 +292,14 @@ class DirectSession : public Session {
       RunMetadata* run_metadata,
       const thread::ThreadPoolOptions& threadpool_options);
 
+  // Steady-state fast path for RunCallable() on a pre-bound callable: runs
+  // the single executor synchronously with stack-allocated per-step state,
+  // using the `Executor::Args` bound in MakeCallable().
+  // REQUIRES: `executors_and_keys->prebound.valid` is true.
+  ::tensorflow::Status RunCallablePrebound(
+      int64_t step_id, CallFrameInterface* call_frame,
+      ExecutorsAndKeys* executors_and_keys);
+
   // Returns whether inter-op execution uses a global pool or the input
   // `run_options` requests being run on inter_op_thread_pool = 0 in case
   // multiple pools are configured.
@@ -367,6 +398,27 @@ class DirectSession : public Session {
   std::unordered_map<string, std::shared_ptr<ExecutorsAndKeys>> executors_
       TF_GUARDED_BY(executor_lock_);
 
+  // Lock-free fast path over `executors_` for hot signatures. Slots are
+  // written at most once, under `executor_lock_`, and published by the
+  // release store to `signature_cache_size_`; thereafter they are only read.
+  // The raw pointers are backed by `executors_`, which never erases entries.
+  // Once all slots are taken, new signatures simply fall back to the locked
+  // map.
+  struct SignatureCacheSlot {
+    string key;
+    ExecutorsAndKeys* value = nullptr;
+  };
+  static constexpr int kSignatureCacheSize = 16;
+  std::array<SignatureCacheSlot, kSignatureCacheSize> signature_cache_;
+  std::atomic<int> signature_cache_size_{0};
+
+  // Returns the cached ExecutorsAndKeys for `key`, or nullptr. Lock-free.
+  ExecutorsAndKeys* LookupSignatureCache(const string& key) const;
+
+  // Installs `key` in the signature cache if there is a free slot.
+  void InsertSignatureCache(const string& key, ExecutorsAndKeys* value)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(executor_lock_);
+
   class RunCallableCallFrame;
   struct Callable {
     std::shared_ptr<ExecutorsAndKeys> executors_and_keys;
@@ -153,6 +153,30 @@ TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork) {
   EXPECT_FLOAT_EQ(5.0, mat(0, 0));
 }
 
+TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork_PreWarmExecutors) {
+  Initialize({3, 2, -1, 0});
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def_));
+
+  std::vector<string> output_names = {y_ + ":0"};
+  std::vector<string> target_nodes = {y_neg_};
+  auto* direct_session = static_cast<DirectSession*>(session.get());
+  TF_ASSERT_OK(
+      direct_session->PreWarmExecutors({}, output_names, target_nodes));
+
+  // A pre-warmed signature must run and produce the same results as a cold
+  // one.
+  for (int i = 0; i < 2; ++i) {
+    std::vector<Tensor> outputs;
+    TF_ASSERT_OK(session->Run({}, output_names, target_nodes, &outputs));
+    ASSERT_EQ(1, outputs.size());
+    auto mat = outputs[0].matrix<float>();
+    ASSERT_TRUE(outputs[0].IsInitialized());
+    EXPECT_FLOAT_EQ(5.0, mat(0, 0));
+  }
+}
+
 TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork_Callable) {
   Initialize({3, 2, -1, 0});
   auto session = CreateSession();
@@ -996,6 +1020,61 @@ TEST(DirectSessionTest, MultipleFeedTest_Callable) {
   EXPECT_TRUE(absl::StrContains(s.error_message(), "fed more than once"));
 }
 
+TEST(DirectSessionTest, PreboundCallableSteadyStateDoesNotAllocate) {
+  EnableCPUAllocatorStats();
+
+  GraphDef def;
+  Graph g(OpRegistry::Global());
+
+  Tensor initial_value(DT_FLOAT, TensorShape({2}));
+  initial_value.vec<float>()(0) = 1.0;
+  initial_value.vec<float>()(1) = 2.0;
+  Node* x = test::graph::Constant(&g, initial_value);
+  Node* y = test::graph::Identity(&g, x);
+  g.ToGraphDef(&def);
+
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+
+  Session::CallableHandle handle;
+  TF_ASSERT_OK(session->MakeCallable(
+      MakeCallableOptions({x->name()}, {y->name() + ":0"}, {}), &handle));
+
+  Tensor feed(DT_FLOAT, TensorShape({2}));
+  feed.vec<float>()(0) = 5.0;
+  feed.vec<float>()(1) = 6.0;
+  std::vector<Tensor> inputs = {feed};
+  std::vector<Tensor> outputs;
+
+  // Warm up the callable so that one-time allocations are done.
+  for (int i = 0; i < 2; ++i) {
+    TF_ASSERT_OK(session->RunCallable(handle, inputs, &outputs, nullptr));
+  }
+
+  const DeviceMgr* device_mgr = nullptr;
+  TF_ASSERT_OK(session->LocalDeviceManager(&device_mgr));
+  Allocator* allocator = device_mgr->ListDevices()[0]->GetAllocator({});
+  absl::optional<AllocatorStats> before = allocator->GetStats();
+  ASSERT_TRUE(before.has_value());
+
+  for (int i = 0; i < 10; ++i) {
+    TF_ASSERT_OK(session->RunCallable(handle, inputs, &outputs, nullptr));
+  }
+
+  // The identity forwards the fed tensor and the fetch is returned through
+  // the call frame, so steady-state calls on the pre-bound fast path must
+  // not allocate any tensors.
+  absl::optional<AllocatorStats> after = allocator->GetStats();
+  ASSERT_TRUE(after.has_value());
+  EXPECT_EQ(before->num_allocs, after->num_allocs);
+
+  ASSERT_EQ(1, outputs.size());
+  EXPECT_EQ(5.0, outputs[0].vec<float>()(0));
+  EXPECT_EQ(6.0, outputs[0].vec<float>()(1));
+  TF_ASSERT_OK(session->ReleaseCallable(handle));
+}
+
 TEST(DirectSessionTest, TestTensorConnectionUseTwice) {
   Graph graph(OpRegistry::Global());
 
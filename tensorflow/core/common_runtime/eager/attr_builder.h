@@ -103,7 +103,9 @@ class AttrBuilder : public AbstractOpAttrs {
   void Reset(const char* op) {
     op_name_ = op;
     num_inputs_ = 0;
-    encoded_attrs_.clear();
+    // Keep the bucket array so that a recycled builder does not rehash from
+    // scratch for every op.
+    encoded_attrs_.clear_no_resize();
     node_def_initialized_ = false;
     node_def_finalized_ = false;
     cached_cache_key_ = absl::nullopt;
@@ -485,7 +485,10 @@ void EagerContext::ClearCachesAndDefaultExecutor() {
   // as well.
   mutex_lock ml(cache_mu_);
   default_executor_.WaitForAllPendingNodes().IgnoreError();
-  kernel_cache_.clear();
+  for (KernelCacheShard& shard : kernel_cache_shards_) {
+    mutex_lock sl(shard.mu);
+    shard.map.clear();
+  }
   for (auto& entry : registered_functions_) {
     entry.second->cached_kernel_keys->clear();
   }
@@ -493,6 +496,13 @@ void EagerContext::ClearCachesAndDefaultExecutor() {
     mutex_lock dl(device_cache_mu_);
     device_cache_.clear();
   }
+  {
+    mutex_lock cl(constant_cache_mu_);
+    for (auto& entry : constant_cache_) {
+      entry.second->Unref();
+    }
+    constant_cache_.clear();
+  }
   {
     mutex_lock ml(metadata_mu_);
     step_container_.reset(new ScopedStepContainer(
@@ -991,7 +1001,9 @@ Status EagerContext::RemoveFunction(const string& func) {
   bool is_last_ref = registered_function->RefCountIsOne();
   if (is_last_ref) {
     for (auto& key : *registered_function->cached_kernel_keys) {
-      kernel_cache_.erase(key);
+      KernelCacheShard& shard = kernel_cache_shard(key);
+      mutex_lock sl(shard.mu);
+      shard.map.erase(key);
     }
     registered_functions_.erase(func);
   }
@@ -1059,9 +1071,10 @@ Status EagerContext::SyncExecutors() {
 
 core::RefCountPtr<KernelAndDevice> EagerContext::GetCachedKernel(
     Fprint128 cache_key) {
-  tf_shared_lock l(cache_mu_);
-  auto iter = kernel_cache_.find(cache_key);
-  if (iter == kernel_cache_.end()) {
+  KernelCacheShard& shard = kernel_cache_shard(cache_key);
+  tf_shared_lock l(shard.mu);
+  auto iter = shard.map.find(cache_key);
+  if (iter == shard.map.end()) {
     return nullptr;
   }
   core::RefCountPtr<KernelAndDevice> new_ref(iter->second.get());
@@ -1081,7 +1094,11 @@ void EagerContext::AddKernelToCache(Fprint128 cache_key,
   mutex_lock ml(cache_mu_);
   core::RefCountPtr<KernelAndDevice> new_ref(kernel);
   new_ref->Ref();
-  kernel_cache_[cache_key] = std::move(new_ref);
+  {
+    KernelCacheShard& shard = kernel_cache_shard(cache_key);
+    mutex_lock sl(shard.mu);
+    shard.map[cache_key] = std::move(new_ref);
+  }
   auto* registered_function =
       gtl::FindPtrOrNull(registered_functions_, kernel->name());
   // The kernel name can be either a primitive op or a function.
@@ -1096,6 +1113,36 @@ void EagerContext::AddDeviceToCache(Fprint128 device_cache_key,
   device_cache_[device_cache_key] = device;
 }
 
+ImmediateExecutionTensorHandle* EagerContext::GetCachedConstant(
+    Fprint128 constant_cache_key) {
+  mutex_lock l(constant_cache_mu_);
+  auto iter = constant_cache_.find(constant_cache_key);
+  if (iter == constant_cache_.end()) {
+    return nullptr;
+  }
+  iter->second->Ref();
+  return iter->second;
+}
+
+void EagerContext::AddConstantToCache(Fprint128 constant_cache_key,
+                                      ImmediateExecutionTensorHandle* handle) {
+  // The number of distinct small constants is bounded in practice, but cap
+  // the cache so a pathological workload cannot pin arbitrary amounts of
+  // device memory.
+  static constexpr int kConstantCacheMaxEntries = 4096;
+  mutex_lock l(constant_cache_mu_);
+  if (constant_cache_.size() >= kConstantCacheMaxEntries) {
+    return;
+  }
+  auto& entry = constant_cache_[constant_cache_key];
+  if (entry != nullptr) {
+    // Another thread interned an equivalent constant first; keep its entry.
+    return;
+  }
+  handle->Ref();
+  entry = handle;
+}
+
 bool EagerContext::ShouldStoreGraphs() { return should_store_graphs_.load(); }
 
 void EagerContext::SetShouldStoreGraphs(bool value) {
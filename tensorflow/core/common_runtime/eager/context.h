@@ -265,6 +265,17 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
   void AddKernelToCache(Fprint128 cache_key, KernelAndDevice* kernel);
   void AddDeviceToCache(Fprint128 device_cache_key, Device* device);
 
+  // Returns the interned device-resident copy of a small host constant, or
+  // nullptr if nothing has been cached under `constant_cache_key`. The caller
+  // becomes an owner of a reference on the returned handle.
+  ImmediateExecutionTensorHandle* GetCachedConstant(
+      Fprint128 constant_cache_key);
+  // Interns `handle`, which carries a copy of a small host constant on a
+  // non-host device, under `constant_cache_key`. Takes a new reference on
+  // `handle`.
+  void AddConstantToCache(Fprint128 constant_cache_key,
+                          ImmediateExecutionTensorHandle* handle);
+
   bool LogDevicePlacement() const { return log_device_placement_; }
   void SetLogDevicePlacement(bool enable) override {
     log_device_placement_ = enable;
@@ -714,13 +725,34 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
 
     std::unique_ptr<std::vector<Fprint128>> cached_kernel_keys;
   };
-  std::unordered_map<Fprint128, core::RefCountPtr<KernelAndDevice>,
-                     Fprint128Hasher>
-      kernel_cache_ TF_GUARDED_BY(cache_mu_);
+  // The kernel cache is sharded by fingerprint so concurrent dispatch threads
+  // probe different mutexes.  Lookups only take the shard lock; insertions and
+  // removals take cache_mu_ first (then the shard lock) so they stay atomic
+  // with the registered_functions_ bookkeeping below.
+  static constexpr int kKernelCacheShards = 16;
+  struct KernelCacheShard {
+    mutable mutex mu;
+    std::unordered_map<Fprint128, core::RefCountPtr<KernelAndDevice>,
+                       Fprint128Hasher>
+        map TF_GUARDED_BY(mu);
+  };
+  KernelCacheShard kernel_cache_shards_[kKernelCacheShards];
+  KernelCacheShard& kernel_cache_shard(const Fprint128& cache_key) {
+    return kernel_cache_shards_[cache_key.low64 % kKernelCacheShards];
+  }
   std::unordered_map<string, RegisteredFunction*> registered_functions_
       TF_GUARDED_BY(cache_mu_);
   absl::flat_hash_map<Fprint128, Device*, Fprint128Hasher> device_cache_
       TF_GUARDED_BY(device_cache_mu_);
+  // Interned device-resident copies of small host constants, keyed over the
+  // destination device, dtype, shape and value bytes (see
+  // CopyInputToExpectedDevice in execute.cc). The cache holds a reference on
+  // each entry, so a cached handle never sees a reference count of one during
+  // op execution and its device buffer is never released for forwarding.
+  mutex constant_cache_mu_;
+  absl::flat_hash_map<Fprint128, ImmediateExecutionTensorHandle*,
+                      Fprint128Hasher>
+      constant_cache_ TF_GUARDED_BY(constant_cache_mu_);
 
   // Whether we should compute RunMetadata.
   std::atomic<bool> should_store_graphs_{false};
@@ -54,6 +54,18 @@ bool CustomDeviceOpHandler::FindCustomDeviceFromName(
 Status CustomDeviceOpHandler::Execute(ImmediateExecutionOperation* op,
                                       ImmediateExecutionTensorHandle** retvals,
                                       int* num_retvals) {
+  // Fast path for the common case: with no custom devices registered and no
+  // custom-device inputs the op can only land on a physical device, so skip
+  // the pinning logic (which hashes the op's requested device name against
+  // the registry on every call).
+  if (custom_devices_.empty() && !op->HasCustomDeviceInput()) {
+    return op->Execute(
+        absl::MakeSpan(
+            reinterpret_cast<tensorflow::AbstractTensorHandle**>(retvals),
+            *num_retvals),
+        num_retvals);
+  }
+
   tensorflow::CustomDevice* custom_device = nullptr;
 
   TF_RETURN_IF_ERROR(MaybePinToCustomDevice(&custom_device, *op));
@@ -102,6 +114,10 @@ ImmediateExecutionTensorHandle* CustomDeviceOpHandler::CopyTensorHandleToDevice(
   ImmediateExecutionTensorHandle* result = nullptr;
   tensorflow::CustomDevice* dev;
 
+  if (custom_devices_.empty()) {
+    return context->CopyTensorHandleToDevice(handle, device_name, status);
+  }
+
   if (FindCustomDeviceFromName(device_name, &dev)) {
     *status = dev->CopyTensorToDevice(handle, &result);
     if (status->ok()) {
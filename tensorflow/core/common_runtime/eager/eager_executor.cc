@@ -116,8 +116,13 @@ Status EagerExecutor::SyncExecute(EagerNode* node) {
 
   // Inline execution in sync mode.
   s = node->Run();
-  tensorflow::mutex_lock l(node_queue_mutex_);
-  NotifyWaiters(id);
+  // In sync mode both node_queue_ and unfinished_nodes_ are always empty, so
+  // WaitForAllPendingNodes returns without registering a waiter; skip the
+  // lock and wakeup in the common case where the waiter map is empty.
+  if (num_waiters_.load(std::memory_order_acquire) > 0) {
+    tensorflow::mutex_lock l(node_queue_mutex_);
+    NotifyWaiters(id);
+  }
   return s;
 }
 
@@ -151,10 +156,12 @@ Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
       status = status_;
       if (status.ok()) {
         node_queue_.push(std::move(item));
-        // If there were no previous nodes pending, wake the run thread to
-        // start processing requests again.
-        if (node_queue_.size() == 1) {
-          nodes_pending_.notify_all();
+        // If there were no previous nodes pending and the run thread is
+        // parked, wake it to start processing requests again.  When the
+        // thread is busy draining the queue it will pick this node up on its
+        // next iteration, so the wakeup (a futex call per op) can be skipped.
+        if (node_queue_.size() == 1 && thread_waiting_) {
+          nodes_pending_.notify_one();
         }
 
         return OkStatus();
@@ -186,6 +193,7 @@ tensorflow::Status EagerExecutor::WaitForAllPendingNodesLocked(
   auto last_id = next_node_id_ - 1;
   DVLOG(3) << "Wait for Node: [id " << last_id << "] ";
   node_done_notifications_.insert(std::make_pair(last_id, &cond));
+  num_waiters_.fetch_add(1, std::memory_order_release);
   cond.wait(*lock);
   // Note that we could be woken up if an error occurs, even though the node has
   // not actually executed.
@@ -310,10 +318,13 @@ void EagerExecutor::NotifyWaiters(uint64 id) {
                         node_done_notifications_.upper_bound(upperbound_id))
             : make_pair(node_done_notifications_.begin(),
                         node_done_notifications_.end());
+    int64_t num_notified = 0;
     for (auto it = range.first; it != range.second; ++it) {
       it->second->notify_all();
+      ++num_notified;
     }
     node_done_notifications_.erase(range.first, range.second);
+    num_waiters_.fetch_sub(num_notified, std::memory_order_release);
   }
 }
 
@@ -326,7 +337,9 @@ void EagerExecutor::Run() {
       tensorflow::mutex_lock l(node_queue_mutex_);
       while (node_queue_.empty() || !status_.ok()) {
         if (state_ == ExecutorState::kShutDown) return;
+        thread_waiting_ = true;
         nodes_pending_.wait(l);
+        thread_waiting_ = false;
       }
       // Obtain raw pointer since we don't want to remove from the queue until
       // the node has been run. Otherwise, WaitForAllPendingNodes can return
@@ -222,6 +222,10 @@ class EagerExecutor {
   // Used to signal that some EagerNodes are pending execution.
   condition_variable nodes_pending_ TF_GUARDED_BY(node_queue_mutex_);
 
+  // True while the executor thread is parked in nodes_pending_.wait().  Lets
+  // enqueuers skip the wakeup when the thread is busy draining the queue.
+  bool thread_waiting_ TF_GUARDED_BY(node_queue_mutex_) = false;
+
   // Queue of pending NodeItems. Ordered by NodeItem::id.
   std::queue<core::RefCountPtr<NodeItem>> node_queue_
       TF_GUARDED_BY(node_queue_mutex_);
@@ -242,6 +246,11 @@ class EagerExecutor {
   std::multimap<uint64, condition_variable*, std::less<uint64>>
       node_done_notifications_ TF_GUARDED_BY(node_queue_mutex_);
 
+  // Number of entries in node_done_notifications_.  Only mutated while
+  // holding node_queue_mutex_; read without the lock by completion paths to
+  // skip the lock and wakeup entirely when nobody is waiting.
+  std::atomic<int64_t> num_waiters_{0};
+
   // thread_exited_notification_ is notified by the `thread_` right before it
   // exits.
   Notification thread_exited_notification_;
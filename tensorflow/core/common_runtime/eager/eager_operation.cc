@@ -35,7 +35,10 @@ void EagerOperation::Clear() {
   for (ImmediateExecutionTensorHandle* h : inputs_) {
     h->Unref();
   }
-  inputs_.clear();
+  // Use resize(0) instead of clear() so that an op that grew past the inline
+  // capacity keeps its heap storage; recycled ops then add inputs without
+  // reallocating in steady state.
+  inputs_.resize(0);
   custom_device_tensor_handles_count_ = 0;
   ClearInferenceState();
 }
@@ -77,5 +77,51 @@ TEST(EagerOperationTest, EagerFunctionParamsAndStepId) {
   ctx->Unref();
 }
 
+TEST(EagerOperationTest, ClearPreservesInputStorage) {
+  StaticDeviceMgr device_mgr(DeviceFactory::NewDevice(
+      "CPU", {}, "/job:localhost/replica:0/task:0/device:CPU:0"));
+  auto ctx = new EagerContext(
+      SessionOptions(),
+      tensorflow::ContextDevicePlacementPolicy::DEVICE_PLACEMENT_SILENT, false,
+      &device_mgr, false, nullptr, nullptr);
+
+  tensorflow::FunctionDef function_def;
+  CHECK(tensorflow::protobuf::TextFormat::ParseFromString(
+      "    signature {"
+      "      name: 'DummyFunction'"
+      "    }",
+      &function_def));
+  TF_ASSERT_OK(ctx->AddFunctionDef(function_def));
+
+  auto op = new EagerOperation(ctx);
+  string device_name = "/job:localhost/replica:0/task:0/device:CPU:0";
+  TF_ASSERT_OK(op->Reset("DummyFunction", device_name.c_str()));
+
+  TensorHandle* h = TensorHandle::CreateLocalHandle(
+      Tensor(DT_FLOAT, TensorShape({0})), nullptr, nullptr, ctx);
+  // Grow past the inline capacity so that the inputs spill to the heap.
+  constexpr int kNumInputs = 8;
+  for (int i = 0; i < kNumInputs; ++i) {
+    TF_ASSERT_OK(op->AddInput(h));
+  }
+  const size_t capacity = op->Inputs().capacity();
+  ASSERT_GE(capacity, kNumInputs);
+
+  // A cleared op keeps the grown storage, so re-adding the same number of
+  // inputs does not reallocate.
+  op->Clear();
+  EXPECT_EQ(capacity, op->Inputs().capacity());
+  TF_ASSERT_OK(op->Reset("DummyFunction", device_name.c_str()));
+  for (int i = 0; i < kNumInputs; ++i) {
+    TF_ASSERT_OK(op->AddInput(h));
+  }
+  EXPECT_EQ(capacity, op->Inputs().capacity());
+
+  op->Clear();
+  h->Unref();
+  delete op;
+  ctx->Unref();
+}
+
 }  // namespace
 }  // namespace tensorflow
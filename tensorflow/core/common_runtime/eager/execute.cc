@@ -63,6 +63,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 #if !defined(IS_MOBILE_PLATFORM)
 #include "tensorflow/core/distributed_runtime/eager/eager_client.h"
 #include "tensorflow/core/distributed_runtime/eager/remote_copy_node.h"
@@ -96,6 +97,21 @@ const string& DeviceNameOrUnspecified(Device* device) {
   return (device == nullptr) ? *unspecified_string : device->name();
 }
 
+// Upper bound on the size of host constants eligible for the device-resident
+// constant cache. The cache exists to absorb axis arguments, shape vectors
+// and scalar hyperparameters, not real data.
+constexpr int64_t kConstantCacheMaxBytes = 1024;
+
+bool SmallConstantCacheEnabled() {
+  static bool enabled = [] {
+    bool result;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_EAGER_SMALL_CONSTANT_CACHE",
+                                   /*default_val=*/true, &result));
+    return result;
+  }();
+  return enabled;
+}
+
 // Returns whether a kernel should be cached.
 bool KernelCacheEnabled(const OpDef& op_def) {
   if (data::DatasetOpKernel::IsDatasetOp(op_def)) {
@@ -175,6 +191,47 @@ Status CopyInputToExpectedDevice(EagerContext* ctx, EagerOperation* op,
   }
   // We are only here if the policy is warn or silent copies, so we should
   // trigger a copy.
+  //
+  // Small ready host constants (axis arguments, shape vectors, scalar
+  // hyperparameters) tend to be copied to the same device over and over in
+  // eager loops, each use paying for a tiny transfer that serializes on the
+  // copy stream. Intern their device copies in the context so repeated uses
+  // of an identical constant reuse the existing device buffer. The key covers
+  // the destination device, dtype, shape and value bytes, and the cache holds
+  // a reference on each interned handle so its reference count never drops to
+  // one and its buffer is never unprotected for forwarding (see
+  // ExecuteNode::Run).
+  Fprint128 constant_cache_key;
+  bool cache_constant = false;
+  if (SmallConstantCacheEnabled() && handle->Type() == TensorHandle::LOCAL &&
+      handle_device == ctx->HostCPU() && handle->IsReady() &&
+      DataTypeCanUseMemcpy(handle->dtype)) {
+    const tensorflow::Tensor* src = nullptr;
+    Status lookup_status = handle->Tensor(&src);
+    if (lookup_status.ok() && src->TotalBytes() > 0 &&
+        src->TotalBytes() <= kConstantCacheMaxBytes) {
+      constant_cache_key = Fingerprint128(expected_input_device->name());
+      constant_cache_key =
+          FingerprintCat128(constant_cache_key, src->dtype());
+      constant_cache_key = FingerprintCat128(constant_cache_key, src->dims());
+      for (int d = 0; d < src->dims(); ++d) {
+        constant_cache_key =
+            FingerprintCat128(constant_cache_key, src->dim_size(d));
+      }
+      constant_cache_key = FingerprintCat128(
+          constant_cache_key, Fingerprint128(src->tensor_data()));
+      ImmediateExecutionTensorHandle* cached =
+          ctx->GetCachedConstant(constant_cache_key);
+      if (cached != nullptr) {
+        *result = TensorHandleFromInterface(cached);
+        return OkStatus();
+      }
+      // Only populate the cache when executing synchronously: an async copy is
+      // still pending when the handle would be interned, and if it later
+      // aborts the poisoned mirror would be served to every subsequent user.
+      cache_constant = !op->Executor().Async();
+    }
+  }
   TensorHandle* result_handle = nullptr;
   profiler::TraceMe activity(
       [&] {
@@ -194,6 +251,10 @@ Status CopyInputToExpectedDevice(EagerContext* ctx, EagerOperation* op,
                      op->Name(), ": ", status.error_message()));
   }
 
+  if (cache_constant) {
+    ctx->AddConstantToCache(constant_cache_key, result_handle);
+  }
+
   *result = result_handle;
 
   return OkStatus();
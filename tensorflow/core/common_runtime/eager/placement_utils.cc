@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/eager/placement_utils.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/c/eager/immediate_execution_tensor_handle.h"
 #include "tensorflow/core/common_runtime/eager/attr_builder.h"
 #include "tensorflow/core/common_runtime/eager/custom_device.h"
@@ -23,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op_def.pb.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 
 namespace tensorflow {
 namespace eager {
@@ -77,12 +79,33 @@ bool IsFunction(StringPiece op_name) {
   return false;
 }
 
+// Returns whether `op_name` passes the op-name based checks in
+// MaybePinSmallOpsToCpu. The verdict depends only on process-wide registries
+// that are populated during static initialization, so it is memoized here:
+// re-deriving it costs an op-registry lock and several string constructions
+// on every dispatch otherwise.
+static bool IsSmallOpPinCandidate(StringPiece op_name) {
+  static mutex* mu = new mutex;
+  static auto* cache = new absl::flat_hash_map<string, bool>;
+  {
+    tf_shared_lock l(*mu);
+    auto iter = cache->find(op_name);
+    if (iter != cache->end()) {
+      return iter->second;
+    }
+  }
+  const bool candidate = !IsFunction(op_name) && !IsColocationExempt(op_name) &&
+                         IsPinnableOp(op_name);
+  mutex_lock l(*mu);
+  cache->emplace(string(op_name), candidate);
+  return candidate;
+}
+
 Status MaybePinSmallOpsToCpu(
     bool* result, StringPiece op_name,
     absl::Span<ImmediateExecutionTensorHandle* const> args,
     StringPiece cpu_device_name) {
-  if (IsFunction(op_name) || IsColocationExempt(op_name) ||
-      !IsPinnableOp(op_name)) {
+  if (!IsSmallOpPinCandidate(op_name)) {
     *result = false;
     return OkStatus();
   }
@@ -44,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 
@@ -313,16 +314,36 @@ Status TensorHandle::CreatePackedHandle(std::vector<TensorHandle*>&& handles,
     TF_RETURN_IF_ERROR(
         handles.at(0)->GetResourceHandleDtypesAndShapes(&dtypes_and_shapes));
   }
-  std::vector<string> devices;
-  devices.reserve(handles.size());
+  // SPMD-style eager workloads pack the same set of devices on every op, and
+  // building the device-name vector plus joining it into the composite-device
+  // lookup key costs O(devices) string allocations per pack. Probe the
+  // context's device cache with a fingerprint over the component device
+  // pointers first; devices are owned by the context, so cached pointers stay
+  // valid as long as the cache does.
+  CompositeDevice* composite_device = nullptr;
+  Fprint128 device_cache_key = Fingerprint128("composite_device");
   for (auto* handle : handles) {
-    devices.push_back(handle->op_device() ? handle->op_device()->name()
-                                          : ctx->HostCPU()->name());
+    const Device* d = handle->op_device() ? handle->op_device()
+                                          : ctx->HostCPU();
+    device_cache_key = FingerprintCat128(
+        device_cache_key, static_cast<uint64>(reinterpret_cast<uintptr_t>(d)));
+  }
+  device_cache_key =
+      FingerprintCat128(device_cache_key, Fingerprint128(device_name));
+  Device* cached_device = ctx->GetCachedDevice(device_cache_key);
+  if (cached_device != nullptr) {
+    composite_device = static_cast<CompositeDevice*>(cached_device);
+  } else {
+    std::vector<string> devices;
+    devices.reserve(handles.size());
+    for (auto* handle : handles) {
+      devices.push_back(handle->op_device() ? handle->op_device()->name()
+                                            : ctx->HostCPU()->name());
+    }
+    TF_RETURN_IF_ERROR(ctx->FindOrCreateCompositeDevice(devices, device_name,
+                                                        &composite_device));
+    ctx->AddDeviceToCache(device_cache_key, composite_device);
   }
-
-  CompositeDevice* composite_device = nullptr;
-  TF_RETURN_IF_ERROR(ctx->FindOrCreateCompositeDevice(devices, device_name,
-                                                      &composite_device));
   *packed_handle =
       new TensorHandle(std::move(handles), composite_device, dtype, shape, ctx);
   (*packed_handle)
@@ -590,6 +611,11 @@ void TensorHandle::SetInferenceShape(
   DCHECK(s.ok());
 }
 
+bool TensorHandle::InferredShapeIfFullyDefined(TensorShape* shape) const {
+  if (IsReady() || !inference_shape_.IsFullyDefined()) return false;
+  return inference_shape_.AsTensorShape(shape);
+}
+
 Status TensorHandle::CopyInferenceShape(TensorHandle* other) {
   if (IsReady()) {
     TF_RETURN_IF_ERROR(is_poisoned_);
@@ -141,6 +141,11 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
     return dtype == DT_VARIANT || dtype == DT_RESOURCE;
   }
 
+  // Returns true once the underlying data is ready, i.e. once accessors such
+  // as Tensor() and Shape() no longer block. A non-ready handle becomes ready
+  // with a call to SetTensor, SetRemoteShape or Poison. Never blocks.
+  bool IsReady() const;
+
   // Return the Tensor from the default device.
   Status Tensor(const tensorflow::Tensor** t) const;
   // Return the Tensor from the specified device which could be either the
@@ -243,6 +248,10 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
       const shape_inference::ShapeHandle& shape_handle);
   Status CopyInferenceShape(TensorHandle* other);
 
+  // Returns true and fills *shape iff the handle is not yet ready but shape
+  // inference determined a fully defined shape for it.  Never blocks.
+  bool InferredShapeIfFullyDefined(TensorShape* shape) const;
+
   // dtype for the handle. It must be the same as t.dtype() once the handle is
   // ready.
   const tensorflow::DataType dtype;
@@ -284,7 +293,6 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
   // Further, it can be in a non-ready state. It would become ready with a call
   // to either SetTensor or SetRemoteShape which replaces the underlying data
   // with a ready version of the tensor handle data.
-  bool IsReady() const;
   Status WaitReady(const char* caller) const;
 
   tensorflow::Device* device_;
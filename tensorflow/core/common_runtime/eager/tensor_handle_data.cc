@@ -103,33 +103,44 @@ string LocalTensorHandleData::DebugString() const {
 }
 
 void LocalTensorHandleData::BlockingControl::SetReady() {
-  mutex_lock l(mu_);
-  is_ready_ = true;
+  {
+    mutex_lock l(mu_);
+    is_ready_ = true;
+  }
+  ready_flag_.store(true, std::memory_order_release);
 }
 
-Status LocalTensorHandleData::BlockingControl::WaitReady(
-    const char* caller) const {
-  tf_shared_lock l(mu_);
-  if (!is_ready_) {
-    profiler::TraceMe activity(
-        [caller] { return absl::StrCat(caller, " WaitReady"); },
-
-        profiler::TraceMeLevel::kInfo);
-    DVLOG(3) << "WaitReady: " << caller << " " << this;
-    mu_.Await(Condition(&is_ready_));
+Status LocalTensorHandleData::BlockingControl::WaitReady(const char* caller)
+    const TF_NO_THREAD_SAFETY_ANALYSIS {
+  // Fast path: after the one-time ready transition is published neither
+  // is_ready_ nor is_poisoned_ is mutated again, so the acquire load lets us
+  // read is_poisoned_ without taking the lock.
+  if (!ready_flag_.load(std::memory_order_acquire)) {
+    tf_shared_lock l(mu_);
+    if (!is_ready_) {
+      profiler::TraceMe activity(
+          [caller] { return absl::StrCat(caller, " WaitReady"); },
+
+          profiler::TraceMeLevel::kInfo);
+      DVLOG(3) << "WaitReady: " << caller << " " << this;
+      mu_.Await(Condition(&is_ready_));
+    }
   }
 
   return is_poisoned_;
 }
 
 void LocalTensorHandleData::BlockingControl::Poison(Status status) {
-  mutex_lock l(mu_);
-  if (is_ready_) {
-    LOG(ERROR) << "Poison can only be called on non-ready handle: " << this;
-    return;
+  {
+    mutex_lock l(mu_);
+    if (is_ready_) {
+      LOG(ERROR) << "Poison can only be called on non-ready handle: " << this;
+      return;
+    }
+    is_poisoned_ = status;
+    is_ready_ = true;
   }
-  is_poisoned_ = status;
-  is_ready_ = true;
+  ready_flag_.store(true, std::memory_order_release);
 }
 
 }  // namespace tensorflow
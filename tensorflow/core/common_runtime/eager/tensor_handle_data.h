@@ -15,6 +15,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_TENSOR_HANDLE_DATA_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_TENSOR_HANDLE_DATA_H_
 
+#include <atomic>
+
 #include "absl/types/variant.h"
 #include "tensorflow/core/common_runtime/eager/context.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -85,13 +87,18 @@ class LocalTensorHandleData {
   class BlockingControl {
    public:
     bool IsReady() const {
-      tf_shared_lock l(mu_);
-      return is_ready_;
+      // The handle transitions to ready exactly once; after the release
+      // store in SetReady/Poison nothing guarded by mu_ is mutated again, so
+      // an acquire load is sufficient and no lock is needed.
+      return ready_flag_.load(std::memory_order_acquire);
     }
     void SetReady();
     Status WaitReady(const char* caller) const;
     void Poison(Status status);
-    Status IsPoisoned() const {
+    Status IsPoisoned() const TF_NO_THREAD_SAFETY_ANALYSIS {
+      if (ready_flag_.load(std::memory_order_acquire)) {
+        return is_poisoned_;
+      }
       tf_shared_lock l(mu_);
       return is_poisoned_;
     }
@@ -100,6 +107,10 @@ class LocalTensorHandleData {
     mutable mutex mu_;
     bool is_ready_ TF_GUARDED_BY(mu_);
     Status is_poisoned_ TF_GUARDED_BY(mu_);
+    // Publishes the one-time ready (or poisoned) transition so readers can
+    // skip mu_ once the handle has been resolved.  Stored with release order
+    // after is_ready_/is_poisoned_ are final.
+    std::atomic<bool> ready_flag_{false};
   };
 
   absl::variant<NonBlockingControl, BlockingControl> ctrl_;
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/executor.h"
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -58,6 +60,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/context.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
@@ -164,11 +167,15 @@ class ExecutorImpl : public Executor {
       is_expensive_.resize(gview.num_nodes());
       cost_estimates_ =
           absl::make_unique<std::atomic_uint_fast64_t[]>(gview.num_nodes());
+      cp_estimates_ =
+          absl::make_unique<std::atomic_uint_fast64_t[]>(gview.num_nodes());
       for (int32_t i = 0; i < gview.num_nodes(); ++i) {
+        cp_estimates_[i] = 0;
         if (gview.node(i)) {
           is_expensive_[i] =
               gview.node(i)->kernel && gview.node(i)->kernel->IsExpensive();
           cost_estimates_[i] = kInitialCostEstimateCycles;
+          cp_estimates_[i] = kInitialCostEstimateCycles;
         }
       }
     }
@@ -182,11 +189,40 @@ class ExecutorImpl : public Executor {
               kOpIsExpensiveThresholdCycles);
     }
 
+    // Like IsExpensive(), but ignores the kernel's static IsExpensive()
+    // marker and relies purely on the measured cost estimate.  Used when
+    // measured-cost scheduling is enabled, in which case all synchronous
+    // kernels are timed and every node's estimate converges to its actual
+    // runtime.
+    bool IsExpensiveMeasured(const NodeItem& node) const {
+      return cost_estimates_[node.node_id].load(std::memory_order_relaxed) >
+             kOpIsExpensiveThresholdCycles;
+    }
+
     // Returns the value of kernel->IsExpensive().
     bool HasExpensiveMarker(const NodeItem& node) const {
       return is_expensive_[node.node_id];
     }
 
+    // Returns the estimated cost (in CPU cycles) of the longest downstream
+    // path starting at `node`, including the node itself, as of the last
+    // call to RefreshCriticalPathEstimates.  Nodes on long critical paths
+    // should be dispatched ahead of their peers.
+    uint64 CriticalPathCycles(const NodeItem& node) const {
+      return cp_estimates_[node.node_id].load(std::memory_order_relaxed);
+    }
+
+    // Called at the beginning of a step when measured-cost scheduling is
+    // enabled.  Periodically folds the per-node cost estimates measured in
+    // earlier steps back into the per-node critical path estimates.
+    void MaybeRefreshCriticalPathEstimates(const GraphView& gview) {
+      if (step_count_.fetch_add(1, std::memory_order_relaxed) %
+              kCriticalPathRefreshIntervalSteps ==
+          0) {
+        RefreshCriticalPathEstimates(gview);
+      }
+    }
+
     // Updates the dynamic cost estimate, which is used to determine whether the
     // given node is expensive. The new cost estimate is a weighted average of
     // the old cost estimate and the latest cost. We only update cost estimates
@@ -205,16 +241,87 @@ class ExecutorImpl : public Executor {
     }
 
    private:
+    // Recomputes cp_estimates_ from cost_estimates_: each node's critical
+    // path estimate is its own cost estimate plus the largest critical path
+    // estimate among its successors.  Back edges introduced by control flow
+    // (e.g. NextIteration) contribute nothing, so loop bodies are costed as
+    // a single iteration.
+    void RefreshCriticalPathEstimates(const GraphView& gview) {
+      mutex_lock l(cp_refresh_mu_);
+      const int num_nodes = gview.num_nodes();
+      // Iterative depth-first traversal over the output edges, computing
+      // critical path estimates in post-order.  0 = unvisited, 1 = on the
+      // stack, 2 = done.
+      std::vector<uint8> state(num_nodes, 0);
+      std::vector<uint64> cp(num_nodes, 0);
+      struct StackEntry {
+        int id;
+        bool leave;
+      };
+      std::vector<StackEntry> stack;
+      for (int root = 0; root < num_nodes; ++root) {
+        if (state[root] != 0) continue;
+        stack.push_back({root, false});
+        while (!stack.empty()) {
+          const StackEntry entry = stack.back();
+          stack.pop_back();
+          const NodeItem* item = gview.node(entry.id);
+          if (item == nullptr) {
+            state[entry.id] = 2;
+            continue;
+          }
+          if (entry.leave) {
+            uint64 max_successor = 0;
+            for (const EdgeInfo& e : item->output_edges()) {
+              if (state[e.dst_id] == 2) {
+                max_successor = std::max(max_successor, cp[e.dst_id]);
+              }
+            }
+            for (const ControlEdgeInfo& e : item->output_control_edges()) {
+              if (state[e.dst_id] == 2) {
+                max_successor = std::max(max_successor, cp[e.dst_id]);
+              }
+            }
+            cp[entry.id] =
+                cost_estimates_[entry.id].load(std::memory_order_relaxed) +
+                max_successor;
+            state[entry.id] = 2;
+            continue;
+          }
+          if (state[entry.id] != 0) continue;
+          state[entry.id] = 1;
+          stack.push_back({entry.id, true});
+          for (const EdgeInfo& e : item->output_edges()) {
+            if (state[e.dst_id] == 0) stack.push_back({e.dst_id, false});
+          }
+          for (const ControlEdgeInfo& e : item->output_control_edges()) {
+            if (state[e.dst_id] == 0) stack.push_back({e.dst_id, false});
+          }
+        }
+      }
+      for (int i = 0; i < num_nodes; ++i) {
+        cp_estimates_[i].store(cp[i], std::memory_order_relaxed);
+      }
+    }
+
     // Initial time (in CPU cycles) we expect an operation to take.  Used to
     // determine whether an operation should be place in a threadpool.
     // Operations start out "expensive".
     static constexpr uint64 kInitialCostEstimateCycles = 100 * 1000 * 1000;
     static constexpr uint64 kOpIsExpensiveThresholdCycles = 8000;
     static constexpr uint64 kCostDecay = 10;
+    // Number of steps between refreshes of the critical path estimates.
+    static constexpr int64_t kCriticalPathRefreshIntervalSteps = 16;
 
     std::vector<bool> is_expensive_;
     // std::unique_ptr<std::atomic<bool>[]> is_expensive_;
     std::unique_ptr<std::atomic_uint_fast64_t[]> cost_estimates_;
+    // Per-node critical path estimates, refreshed periodically from
+    // cost_estimates_ when measured-cost scheduling is enabled.
+    std::unique_ptr<std::atomic_uint_fast64_t[]> cp_estimates_;
+    std::atomic<int64_t> step_count_{0};
+    // Serializes RefreshCriticalPathEstimates across concurrent steps.
+    mutex cp_refresh_mu_;
   };
 
   ImmutableExecutorState immutable_state_;
@@ -329,12 +436,47 @@ class ExecutorState {
   // REQUIRES: `!ready->empty()`.
   void ScheduleReady(TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready);
 
+  // Returns true if `item` should be dispatched to the threadpool rather
+  // than run inline.  With measured-cost scheduling the decision is based
+  // purely on runtimes measured in earlier steps; otherwise the kernel's
+  // static IsExpensive() marker gates the measured estimate.
+  bool NodeIsExpensive(const NodeItem& item) const {
+    return use_measured_cost_scheduling_
+               ? kernel_stats_->IsExpensiveMeasured(item)
+               : kernel_stats_->IsExpensive(item);
+  }
+
   // A wrapper for runner_ to keep track of the pending queue length. Op
   // execution should dispatch work using this function instead of using runner_
   // directly.
   template <typename Closure>
   void RunTask(Closure&& c);
 
+  // Work-stealing scheduling mode (`use_work_stealing_`): instead of
+  // dispatching one closure per ready node to `runner_`, ready nodes are
+  // pushed onto a fixed set of sharded deques that are drained by a bounded
+  // number of long-lived worker closures. A worker pops from its own shard
+  // and steals from the other shards only when its own shard runs dry.
+
+  // Pushes `node` onto one of the ready-node shards.
+  void PushReadyNode(const TaggedNode& node);
+
+  // Pops a node for the worker assigned to `slot`, stealing from other shards
+  // if the worker's own shard is empty. Returns nullopt if no work is
+  // available.
+  absl::optional<TaggedNode> PopOrStealReadyNode(int slot);
+
+  // Returns true if any ready-node shard is non-empty.
+  bool HaveReadyNodes();
+
+  // Dispatches up to `num_hint` additional workers, subject to
+  // `max_stealing_workers_`.
+  void EnsureStealingWorkers(int num_hint, int64_t scheduled_nsec);
+
+  // Body of a work-stealing worker: processes popped nodes until no work can
+  // be found, then retires.
+  void StealingWorkerLoop(int64_t scheduled_nsec);
+
   // Clean up when this executor is done.
   void Finish();
   void ScheduleFinish();
@@ -380,6 +522,24 @@ class ExecutorState {
   Executor::Args::Runner runner_;
   bool sync_on_finish_;
   const bool run_all_kernels_inline_;
+  const bool use_work_stealing_;
+  const bool use_measured_cost_scheduling_;
+  // Step-scoped allocator, or nullptr. Not owned.
+  Allocator* const step_allocator_;
+
+  // State for the work-stealing scheduling mode. `ready_shards_` is only
+  // allocated when `use_work_stealing_` is set. Each live worker holds one
+  // slot in `num_outstanding_ops_` so that the executor cannot finish (and
+  // delete itself) while a worker is still scanning the shards.
+  struct ReadyNodeShard {
+    mutex mu;
+    std::deque<TaggedNode> nodes TF_GUARDED_BY(mu);
+  };
+  static constexpr int kNumReadyNodeShards = 64;
+  std::unique_ptr<ReadyNodeShard[]> ready_shards_;
+  std::atomic<int> num_stealing_workers_{0};
+  std::atomic<uint64> next_ready_shard_{0};
+  int max_stealing_workers_ = 0;
 
   PropagatorStateType propagator_;
 
@@ -428,8 +588,17 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       runner_(args.runner),
       sync_on_finish_(args.sync_on_finish),
       run_all_kernels_inline_(args.run_all_kernels_inline),
+      use_work_stealing_(args.use_work_stealing &&
+                         !args.run_all_kernels_inline),
+      use_measured_cost_scheduling_(args.use_measured_cost_scheduling &&
+                                    !args.run_all_kernels_inline),
+      step_allocator_(args.step_allocator),
       propagator_(immutable_state, step_id_, vlog_),
       num_outstanding_ops_(0) {
+  if (use_work_stealing_) {
+    ready_shards_.reset(new ReadyNodeShard[kNumReadyNodeShards]);
+    max_stealing_workers_ = port::MaxParallelism();
+  }
   if (args.user_intra_op_threadpool != nullptr) {
     Device* device = immutable_state_.params().device;
     user_device_ = RenamedDevice::NewRenamedDevice(
@@ -469,6 +638,106 @@ void ExecutorState<PropagatorStateType>::RunTask(Closure&& c) {
   });
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::PushReadyNode(const TaggedNode& node) {
+  const int slot = next_ready_shard_.fetch_add(1, std::memory_order_relaxed) %
+                   kNumReadyNodeShards;
+  mutex_lock l(ready_shards_[slot].mu);
+  ready_shards_[slot].nodes.push_back(node);
+}
+
+template <class PropagatorStateType>
+absl::optional<typename ExecutorState<PropagatorStateType>::TaggedNode>
+ExecutorState<PropagatorStateType>::PopOrStealReadyNode(int slot) {
+  // Pop from the worker's own shard in FIFO order to preserve the rough
+  // topological order in which nodes became ready.
+  {
+    ReadyNodeShard& own = ready_shards_[slot];
+    mutex_lock l(own.mu);
+    if (!own.nodes.empty()) {
+      TaggedNode node = own.nodes.front();
+      own.nodes.pop_front();
+      return node;
+    }
+  }
+  // Steal from the back of the other shards, which keeps the thieves away
+  // from the end that the shard's own worker pops from.
+  for (int i = 1; i < kNumReadyNodeShards; ++i) {
+    ReadyNodeShard& shard = ready_shards_[(slot + i) % kNumReadyNodeShards];
+    mutex_lock l(shard.mu);
+    if (!shard.nodes.empty()) {
+      TaggedNode node = shard.nodes.back();
+      shard.nodes.pop_back();
+      return node;
+    }
+  }
+  return absl::nullopt;
+}
+
+template <class PropagatorStateType>
+bool ExecutorState<PropagatorStateType>::HaveReadyNodes() {
+  for (int i = 0; i < kNumReadyNodeShards; ++i) {
+    mutex_lock l(ready_shards_[i].mu);
+    if (!ready_shards_[i].nodes.empty()) return true;
+  }
+  return false;
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::EnsureStealingWorkers(
+    int num_hint, int64_t scheduled_nsec) {
+  for (int i = 0; i < num_hint; ++i) {
+    int workers = num_stealing_workers_.load();
+    bool spawned = false;
+    while (workers < max_stealing_workers_) {
+      if (num_stealing_workers_.compare_exchange_weak(workers, workers + 1)) {
+        spawned = true;
+        break;
+      }
+    }
+    if (!spawned) return;
+    // The worker's slot in `num_outstanding_ops_` keeps the executor alive
+    // until the worker retires; see StealingWorkerLoop.
+    num_outstanding_ops_.fetch_add(1, std::memory_order_relaxed);
+    RunTask([this, scheduled_nsec]() { StealingWorkerLoop(scheduled_nsec); });
+  }
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::StealingWorkerLoop(
+    int64_t scheduled_nsec) {
+  const int slot = next_ready_shard_.fetch_add(1, std::memory_order_relaxed) %
+                   kNumReadyNodeShards;
+  while (true) {
+    absl::optional<TaggedNode> node = PopOrStealReadyNode(slot);
+    if (node.has_value()) {
+      Process(*node, scheduled_nsec);
+      continue;
+    }
+    // No work found: unregister, then re-scan the shards. A producer that
+    // observed the old worker count may have declined to spawn a replacement
+    // for a node pushed concurrently with the scan above; either that
+    // producer sees the decremented count and spawns a worker, or this
+    // re-scan sees the node.
+    num_stealing_workers_.fetch_sub(1);
+    if (!HaveReadyNodes()) break;
+    int workers = num_stealing_workers_.load();
+    bool rearmed = false;
+    while (workers < max_stealing_workers_) {
+      if (num_stealing_workers_.compare_exchange_weak(workers, workers + 1)) {
+        rearmed = true;
+        break;
+      }
+    }
+    // If the worker limit has been reached again, one of the registered
+    // workers is responsible for the remaining nodes.
+    if (!rearmed) break;
+  }
+  // Release the worker's slot in `num_outstanding_ops_`. This mirrors the
+  // bookkeeping in NodeDone: the last decrement triggers Finish.
+  if (num_outstanding_ops_.fetch_sub(1) == 1) ScheduleFinish();
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::RunAsync(Executor::DoneCallback done) {
   TaggedNodeSeq ready;
@@ -570,7 +839,7 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
 
   OpKernel* op_kernel = item.kernel;
   Device* device = immutable_state_.params().device;
-  const bool is_expensive = kernel_stats_->IsExpensive(item);
+  const bool is_expensive = NodeIsExpensive(item);
 
   if (TF_PREDICT_FALSE(MightTrace(event_collector_, is_expensive))) {
     tracing::ScopedRegion region(tracing::EventCategory::kCompute,
@@ -582,7 +851,8 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
         },
         profiler::GetTFTraceMeLevel(is_expensive));
     device->Compute(op_kernel, &ctx);
-  } else if (kernel_stats_->HasExpensiveMarker(item)) {
+  } else if (kernel_stats_->HasExpensiveMarker(item) ||
+             use_measured_cost_scheduling_) {
     KernelTimer timer;
     device->Compute(op_kernel, &ctx);
     // For expensive kernels, always update the cost estimate. For inexpensive
@@ -651,7 +921,7 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
           return async_kernel->TraceString(
               state->ctx, /*verbose=*/profiler::TfOpDetailsEnabled());
         },
-        profiler::GetTFTraceMeLevel(kernel_stats_->IsExpensive(item)));
+        profiler::GetTFTraceMeLevel(NodeIsExpensive(item)));
     immutable_state_.params().device->ComputeAsync(async_kernel, &state->ctx,
                                                    std::move(done));
   }
@@ -725,6 +995,7 @@ void ExecutorState<PropagatorStateType>::Process(TaggedNode tagged_node,
   params.function_library = immutable_state_.params().function_library;
   params.resource_manager = device->resource_manager();
   params.step_container = step_container_;
+  params.step_allocator = step_allocator_;
   params.slice_reader_cache = slice_reader_cache_;
   params.inputs = &inputs;
   params.input_alloc_attrs = &input_alloc_attrs;
@@ -1189,6 +1460,85 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
         inline_ready->push_back(tagged_node);
       }
     }
+  } else if (use_work_stealing_) {
+    int num_pushed = 0;
+    if (inline_ready == nullptr) {
+      for (auto& tagged_node : *ready) {
+        PushReadyNode(tagged_node);
+        ++num_pushed;
+      }
+    } else {
+      // As in the default mode below, inexpensive nodes are kept on the
+      // current thread, and one expensive node is retained if there is
+      // nothing to inline. The other expensive nodes go to the shards, where
+      // they are preferentially drained by this thread's shard-mates and only
+      // stolen when another worker runs dry.
+      const TaggedNode* curr_expensive_node = nullptr;
+      for (auto& tagged_node : *ready) {
+        const NodeItem& item = *tagged_node.node_item;
+        if (tagged_node.get_is_dead() || !NodeIsExpensive(item)) {
+          inline_ready->push_back(tagged_node);
+        } else {
+          if (curr_expensive_node) {
+            PushReadyNode(*curr_expensive_node);
+            ++num_pushed;
+          }
+          curr_expensive_node = &tagged_node;
+        }
+      }
+      if (curr_expensive_node) {
+        if (inline_ready->empty()) {
+          inline_ready->push_back(*curr_expensive_node);
+        } else {
+          PushReadyNode(*curr_expensive_node);
+          ++num_pushed;
+        }
+      }
+    }
+    if (num_pushed > 0) {
+      EnsureStealingWorkers(num_pushed, scheduled_nsec);
+    }
+  } else if (use_measured_cost_scheduling_) {
+    // Dispatch in decreasing order of measured critical path length, so that
+    // the nodes gating the rest of the step reach a worker thread first.
+    auto longer_critical_path = [this](const TaggedNode& a,
+                                       const TaggedNode& b) {
+      return kernel_stats_->CriticalPathCycles(*a.node_item) >
+             kernel_stats_->CriticalPathCycles(*b.node_item);
+    };
+    if (inline_ready == nullptr) {
+      std::sort(ready->begin(), ready->end(), longer_critical_path);
+      for (auto& tagged_node : *ready) {
+        RunTask([=]() { Process(tagged_node, scheduled_nsec); });
+      }
+    } else {
+      // Nodes that measured as cheap stay on this thread; the rest go to
+      // the threadpool, longest critical path first.  If this thread would
+      // otherwise go idle it keeps the head of the critical path for
+      // itself, which avoids one dispatch latency on the longest path.
+      gtl::InlinedVector<TaggedNode, 8> expensive_nodes;
+      for (auto& tagged_node : *ready) {
+        const NodeItem& item = *tagged_node.node_item;
+        if (tagged_node.get_is_dead() || !NodeIsExpensive(item)) {
+          inline_ready->push_back(tagged_node);
+        } else {
+          expensive_nodes.push_back(tagged_node);
+        }
+      }
+      if (!expensive_nodes.empty()) {
+        std::sort(expensive_nodes.begin(), expensive_nodes.end(),
+                  longer_critical_path);
+        size_t first_to_dispatch = 0;
+        if (inline_ready->empty()) {
+          inline_ready->push_back(expensive_nodes.front());
+          first_to_dispatch = 1;
+        }
+        for (size_t i = first_to_dispatch; i < expensive_nodes.size(); ++i) {
+          TaggedNode tagged_node = expensive_nodes[i];
+          RunTask([=]() { Process(tagged_node, scheduled_nsec); });
+        }
+      }
+    }
   } else {
     const TaggedNode* curr_expensive_node = nullptr;
     if (inline_ready == nullptr) {
@@ -1363,6 +1713,10 @@ void ExecutorState<PropagatorStateType>::Finish() {
 }
 
 void ExecutorImpl::RunAsync(const Args& args, DoneCallback done) {
+  if (args.use_measured_cost_scheduling) {
+    kernel_stats_.MaybeRefreshCriticalPathEstimates(
+        immutable_state_.graph_view());
+  }
   if (OpOrderDeterminismRequired()) {
     (new ExecutorState<OrderedPropagatorState>(args, immutable_state_,
                                                &kernel_stats_))
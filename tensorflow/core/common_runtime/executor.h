@@ -118,6 +118,24 @@ class Executor {
     // If true, all kernels will be treated as "inexpensive", and hence executed
     // on the scheduling thread.
     bool run_all_kernels_inline = false;
+
+    // If true, ready nodes are scheduled through per-worker work-stealing
+    // deques instead of dispatching one closure per node to "runner". Ignored
+    // when `run_all_kernels_inline` is set.
+    bool use_work_stealing = false;
+
+    // If true, kernel runtimes measured in earlier steps drive scheduling:
+    // nodes are classified as expensive or inexpensive purely by measured
+    // cost, and expensive nodes are dispatched to the threadpool in
+    // decreasing order of estimated critical path length. Ignored when
+    // `run_all_kernels_inline` or `use_work_stealing` is set.
+    bool use_measured_cost_scheduling = false;
+
+    // If non-null, a step-scoped allocator (see
+    // common_runtime/step_arena_allocator.h) made available to kernels via
+    // `OpKernelContext::Params::step_allocator`. Owned by the caller, which
+    // must keep it alive for the duration of the step.
+    Allocator* step_allocator = nullptr;
   };
   typedef std::function<void(const Status&)> DoneCallback;
   virtual void RunAsync(const Args& args, DoneCallback done) = 0;
@@ -86,11 +86,12 @@ class ExecutorTest : public ::testing::Test {
     runner_ = [this](std::function<void()> fn) { thread_pool_->Schedule(fn); };
   }
 
-  Status Run(Rendezvous* rendez) {
+  Status Run(Rendezvous* rendez, bool use_measured_cost_scheduling = false) {
     Executor::Args args;
     args.rendezvous = rendez;
     args.stats_collector = &step_stats_collector_;
     args.runner = runner_;
+    args.use_measured_cost_scheduling = use_measured_cost_scheduling;
     return exec_->Run(args);
   }
 
@@ -175,6 +176,28 @@ TEST_F(ExecutorTest, SimpleAdd) {
   EXPECT_EQ(2.0, V(out));  // out = 1.0 + 1.0 = 2.0
 }
 
+TEST_F(ExecutorTest, MeasuredCostScheduling) {
+  // b = a + a, scheduled by measured kernel costs.  Running the same
+  // executor repeatedly lets the cost and critical path estimates converge
+  // and exercises the periodic critical path refresh.
+  auto g = absl::make_unique<Graph>(OpRegistry::Global());
+  auto a = test::graph::Constant(g.get(), V(1.0));
+  auto tmp = test::graph::Add(g.get(), a, a);
+  test::graph::Send(g.get(), tmp, "b", BOB, 1, ALICE);
+  Create(std::move(g));
+  for (int step = 0; step < 40; ++step) {
+    Rendezvous* rendez = NewLocalRendezvous();
+    TF_ASSERT_OK(Run(rendez, /*use_measured_cost_scheduling=*/true));
+    Rendezvous::Args args;
+    Tensor out = V(-1);
+    bool is_dead = false;
+    TF_ASSERT_OK(rendez->Recv(Key(BOB, kIncarnation, ALICE, "b"), args, &out,
+                              &is_dead));
+    EXPECT_EQ(2.0, V(out));
+    rendez->Unref();
+  }
+}
+
 TEST_F(ExecutorTest, SelfAdd) {
   // v0 <- a
   // v1 = v0 + v0
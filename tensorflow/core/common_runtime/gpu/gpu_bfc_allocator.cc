@@ -55,6 +55,28 @@ bool GetAllowGrowthValue(bool orig_value) {
   return orig_value;
 }
 
+bool GetThreadCachingValue() {
+  const char* enable_thread_caching =
+      std::getenv("TF_GPU_BFC_THREAD_CACHING");
+  if (enable_thread_caching == nullptr) {
+    // Off by default: cached chunks are invisible to coalescing, which can
+    // increase fragmentation for workloads with large allocations.
+    return false;
+  }
+  if (strcmp("false", enable_thread_caching) == 0) {
+    return false;
+  } else if (strcmp("true", enable_thread_caching) == 0) {
+    return true;
+  }
+
+  LOG(ERROR)
+      << "The TF_GPU_BFC_THREAD_CACHING environment variable is set but"
+      << " could not be parsed: \"" << enable_thread_caching << "\"."
+      << " Valid values are \"true\" or \"false\"."
+      << " Using the default value \"false\".";
+  return false;
+}
+
 bool GetGarbageCollectionValue() {
   const char* enable_gpu_garbage_collection =
       std::getenv("TF_ENABLE_GPU_GARBAGE_COLLECTION");
@@ -90,6 +112,7 @@ GPUBFCAllocator::GPUBFCAllocator(std::unique_ptr<SubAllocator> sub_allocator,
           o.garbage_collection = GetGarbageCollectionValue();
         }
         o.fragmentation_fraction = opts.fragmentation_fraction;
+        o.enable_thread_caching = GetThreadCachingValue();
         return o;
       }()) {}
 
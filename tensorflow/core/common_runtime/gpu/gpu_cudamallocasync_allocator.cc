@@ -372,6 +372,20 @@ size_t GpuCudaMallocAsyncAllocator::AllocatedSize(const void* ptr) const {
 absl::optional<AllocatorStats> GpuCudaMallocAsyncAllocator::GetStats() {
   if (!stats_) return absl::nullopt;
   mutex_lock l(lock_);
+#if TF_CUDA_MALLOC_ASYNC_SUPPORTED && CUDA_VERSION >= 11030
+  // Mirror the pool's reservation counters into the reserved-bytes stats so
+  // that tooling relying on the BFC allocator's stats sees equivalent data.
+  cuuint64_t mem_reserved_current = 0;
+  cuuint64_t mem_reserved_high = 0;
+  if (pool_ != nullptr &&
+      cuMemPoolGetAttribute(pool_, CU_MEMPOOL_ATTR_RESERVED_MEM_CURRENT,
+                            &mem_reserved_current) == CUDA_SUCCESS &&
+      cuMemPoolGetAttribute(pool_, CU_MEMPOOL_ATTR_RESERVED_MEM_HIGH,
+                            &mem_reserved_high) == CUDA_SUCCESS) {
+    stats_->bytes_reserved = static_cast<int64_t>(mem_reserved_current);
+    stats_->peak_bytes_reserved = static_cast<int64_t>(mem_reserved_high);
+  }
+#endif  // TF_CUDA_MALLOC_ASYNC_SUPPORTED && CUDA_VERSION >= 11030
   return *stats_;
 }
 
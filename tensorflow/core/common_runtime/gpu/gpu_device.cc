@@ -74,6 +74,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
 #include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/autotune_maps/autotune_persistence.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/stream_executor_util.h"
@@ -406,15 +407,17 @@ BaseGPUDevice::BaseGPUDevice(const SessionOptions& options, const string& name,
 
 BaseGPUDevice::~BaseGPUDevice() {
   delete accelerator_device_info_;
-  if (scratch_) gpu_allocator_->DeallocateRaw(scratch_);
-  device_context_->Unref();
+  for (char* scratch : scratch_) gpu_allocator_->DeallocateRaw(scratch);
+  for (GPUDeviceContext* dc : device_contexts_) dc->Unref();
 }
 
 // This should be idempotent if already initialized.
 Status BaseGPUDevice::InitScratchBuffers() {
   mutex_lock l(scratch_init_mutex_);
-  if (!scratch_) {
-    DCHECK(stream_);
+  // One buffer per compute stream group: the Eigen scratchpad embeds a
+  // semaphore that must not be shared between streams.
+  while (scratch_.size() < stream_groups_.size()) {
+    DCHECK(stream_groups_[scratch_.size()]);
     size_t scratch_buffer_size = Eigen::kGpuScratchSize + sizeof(unsigned int);
     profiler::ScopedMemoryDebugAnnotation op_annotation("ScratchBuffer");
     void* scratch_buffer = gpu_allocator_->AllocateRaw(
@@ -428,7 +431,7 @@ Status BaseGPUDevice::InitScratchBuffers() {
         se::DeviceMemoryBase(scratch_buffer, scratch_buffer_size));
     TF_RETURN_IF_ERROR(executor_->SynchronousMemZero(
         &mem, Eigen::kGpuScratchSize + sizeof(unsigned int)));
-    scratch_ = static_cast<char*>(scratch_buffer);
+    scratch_.push_back(static_cast<char*>(scratch_buffer));
   }
   return OkStatus();
 }
@@ -443,8 +446,26 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
 
   executor_ = executor_status.ValueOrDie();
 
-  stream_ = StreamGroupFactory::Global().GetOrCreate(
-      tf_device_id_, 0, executor_, options.config.gpu_options());
+  const auto& experimental = options.config.gpu_options().experimental();
+  int num_compute_streams = experimental.num_compute_streams();
+  if (num_compute_streams < 1) num_compute_streams = 1;
+  if (num_compute_streams > 1 &&
+      (experimental.timestamped_allocator() ||
+       experimental.kernel_tracker_max_interval() > 0 ||
+       experimental.kernel_tracker_max_bytes() > 0 ||
+       experimental.kernel_tracker_max_pending() > 0)) {
+    // The kernel tracker and the timestamped allocator assume that all
+    // kernels are enqueued on a single compute stream.
+    LOG(WARNING) << "GPUOptions.experimental.num_compute_streams > 1 is "
+                    "incompatible with timestamped_allocator and the kernel "
+                    "tracker; using a single compute stream.";
+    num_compute_streams = 1;
+  }
+  for (int i = 0; i < num_compute_streams; ++i) {
+    stream_groups_.push_back(StreamGroupFactory::Global().GetOrCreate(
+        tf_device_id_, i, executor_, options.config.gpu_options()));
+  }
+  stream_ = stream_groups_[0];
 
   // Get an allocator that allocates pinned memory on host.
   AllocatorAttributes attr;
@@ -452,13 +473,17 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
   attr.set_gpu_compatible(true);
   Allocator* host_memory_allocator = GetAllocator(attr);
 
-  device_context_ =
-      new GPUDeviceContext(0, stream_->compute,
+  for (int i = 0; i < num_compute_streams; ++i) {
+    StreamGroup* group = stream_groups_[i];
+    device_contexts_.push_back(
+        new GPUDeviceContext(i, group->compute,
 #if TENSORFLOW_USE_ROCM
-                           stream_->nccl,
+                             group->nccl,
 #endif
-                           stream_->host_to_device, stream_->device_to_host,
-                           stream_->device_to_device, host_memory_allocator);
+                             group->host_to_device, group->device_to_host,
+                             group->device_to_device, host_memory_allocator));
+  }
+  device_context_ = device_contexts_[0];
 
   em_ = EventMgrFactory::Singleton()->GetEventMgr(executor_,
                                                   options.config.gpu_options());
@@ -727,15 +752,34 @@ void BaseGPUDevice::Compute(OpKernel* op_kernel, OpKernelContext* context) {
 }
 
 Status BaseGPUDevice::Sync() {
-  DCHECK_NE(stream_, nullptr);
+  DCHECK(!stream_groups_.empty());
 
   // Device::Sync is supposed to block until all operations queued on the device
   // at the time of the call have completed.  On GPUs, only operations enqueued
-  // on the compute stream can remain pending after the (Async)OpKernel that
+  // on the compute streams can remain pending after the (Async)OpKernel that
   // enqueued the operation has completed.  We do use other streams for copies
   // and collectives, but in those cases the (Async)OpKernels themselves block
   // until the queued operation has finished.
-  return stream_->compute->BlockHostUntilDone();
+  for (StreamGroup* group : stream_groups_) {
+    TF_RETURN_IF_ERROR(group->compute->BlockHostUntilDone());
+  }
+  return OkStatus();
+}
+
+Status BaseGPUDevice::TryGetDeviceContext(DeviceContext** out_context) {
+  // With multiple compute streams, spread executor invocations (steps, graph
+  // partitions and function calls) over the stream groups round-robin.  All
+  // ops dispatched by one invocation share that invocation's compute stream,
+  // which preserves their program order; only work from independent
+  // invocations overlaps on the device.
+  GPUDeviceContext* dc = device_context_;
+  if (device_contexts_.size() > 1) {
+    const uint64 index = next_context_.fetch_add(1, std::memory_order_relaxed);
+    dc = device_contexts_[index % device_contexts_.size()];
+  }
+  dc->Ref();
+  *out_context = dc;
+  return OkStatus();
 }
 
 void BaseGPUDevice::ComputeAsync(AsyncOpKernel* op_kernel,
@@ -1136,11 +1180,13 @@ void BaseGPUDevice::ReinitializeDevice(OpKernelContext* context,
   ConcretePerOpGpuDevice* concrete_device =
       static_cast<ConcretePerOpGpuDevice*>(device);
   DCHECK(concrete_device);
-  DCHECK_EQ(stream_id, 0);
+  DCHECK_GE(stream_id, 0);
+  DCHECK_LT(stream_id, static_cast<int>(stream_groups_.size()));
   const gpuStream_t* gpu_stream = reinterpret_cast<const gpuStream_t*>(
-      stream_->compute->implementation()->GpuStreamMemberHack());
+      stream_groups_[stream_id]->compute->implementation()
+          ->GpuStreamMemberHack());
   concrete_device->Reinitialize(context, gpu_stream, tf_device_id_, allocator,
-                                scratch_);
+                                scratch_[stream_id]);
 }
 
 PerOpGpuDevice* BaseGPUDevice::MakeGpuDevice() {
@@ -1157,7 +1203,7 @@ Status BaseGPUDevice::ReinitializeGpuDevice(OpKernelContext* context,
     const int stream_id = gpu_dc->stream_id();
     VLOG(1) << "  eigen_gpu_device(" << dc << ") => stream[" << stream_id
             << "]";
-    CHECK_EQ(stream_id, 0);
+    CHECK_LT(stream_id, static_cast<int>(stream_groups_.size()));
     ReinitializeDevice(context, device, stream_id, allocator);
   } else {
     ReinitializeDevice(context, device, 0, allocator);
@@ -1470,6 +1516,15 @@ Status BaseGPUDeviceFactory::CreateDevices(
                                        bytes, it->second, num_tf_gpus,
                                        devices));
   }
+
+  // When TF_AUTOTUNE_CACHE_DIR is set, reuse autotune results saved by
+  // earlier processes and persist newly discovered ones. Failures here only
+  // cost warmup time, so they must not fail device creation.
+  Status persistence_status = MaybeEnableAutotunePersistence();
+  if (!persistence_status.ok()) {
+    LOG(WARNING) << "Failed to enable autotune persistence: "
+                 << persistence_status;
+  }
   return OkStatus();
 }
 
@@ -108,6 +108,11 @@ class BaseGPUDevice : public LocalDevice {
                                DeviceContext* dc,
                                Allocator* allocator) override;
 
+  // Returns a device context for the next executor invocation, distributing
+  // invocations round-robin over the compute stream groups when more than one
+  // has been configured via GPUOptions::experimental::num_compute_streams.
+  Status TryGetDeviceContext(DeviceContext** out_context) override;
+
   // Returns the platform GPU id of this device within the native driver system;
   // e.g., for CUDA and ROCm this is the ordinal of the GPU within the system.
   int gpu_id() const {
@@ -171,8 +176,16 @@ class BaseGPUDevice : public LocalDevice {
 
   StreamGroup* stream_;
   mutex scratch_init_mutex_;
-  char* scratch_ = nullptr;
+  // One scratch buffer per compute stream group: the Eigen scratchpad embeds
+  // a semaphore that must not be shared between streams.
+  std::vector<char*> scratch_;
   GPUDeviceContext* device_context_;
+  // All stream groups and device contexts for this device.  stream_ and
+  // device_context_ alias entry 0, which is also the default handed to ops
+  // when multi-stream mode is off.
+  std::vector<StreamGroup*> stream_groups_;
+  std::vector<GPUDeviceContext*> device_contexts_;
+  std::atomic<uint64> next_context_{0};
   DeviceBase::AcceleratorDeviceInfo* accelerator_device_info_ = nullptr;
   mutex trace_mu_;
   TfDeviceId tf_device_id_;
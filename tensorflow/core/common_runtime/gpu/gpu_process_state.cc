@@ -226,8 +226,22 @@ Allocator* GPUProcessState::GetGPUAllocator(
       // compute-sanitizer.
       // TODO: **WARNING** probably will not work in a multi-gpu scenario
       gpu_bfc_allocator.reset();
-      gpu_allocator =
-          new GpuCudaMallocAsyncAllocator(platform_device_id, total_bytes);
+      // The release threshold bounds how much memory the CUDA pool retains
+      // once freed; below it, frees are recycled without driver round trips.
+      // By default retain up to the device memory limit, like BFC does with
+      // its reserved region; a lower threshold lets the pool coexist with
+      // BFC-managed reservations (e.g. other virtual devices or processes)
+      // by returning the excess to the driver at synchronization points.
+      size_t pool_size = total_bytes;
+      if (options.experimental().cuda_malloc_async_release_threshold() > 0) {
+        pool_size =
+            options.experimental().cuda_malloc_async_release_threshold();
+      }
+      // Match the BFC allocator's default of reserving its memory up front
+      // unless the user asked for on-demand growth.
+      gpu_allocator = new GpuCudaMallocAsyncAllocator(
+          platform_device_id, pool_size,
+          /*reserve_memory=*/!options.allow_growth());
     }
 
     Allocator* recording_allocator = nullptr;
@@ -365,6 +379,31 @@ Allocator* GPUProcessState::GetGpuHostAllocator(int numa_node) {
       // at the cost of performance.
       allocator = new TrackingAllocator(allocator, true);
     }
+
+    // Optionally prime the pool with one up-front region. The pool grows on
+    // demand, and every growth pins pages with cudaHostAlloc; preallocating
+    // the working set (typically sized from the observed transfer-size
+    // distribution of the input pipeline) lets steady-state H2D/D2H staging
+    // run entirely from recycled bins.
+    int64_t gpu_host_mem_prealloc_in_mb = 0;
+    status = ReadInt64FromEnvVar("TF_GPU_HOST_MEM_PREALLOC_IN_MB", 0,
+                                 &gpu_host_mem_prealloc_in_mb);
+    if (!status.ok()) {
+      LOG(ERROR) << "GetGpuHostAllocator: " << status.error_message();
+    }
+    if (gpu_host_mem_prealloc_in_mb > 0) {
+      void* warmup = allocator->AllocateRaw(
+          Allocator::kAllocatorAlignment, gpu_host_mem_prealloc_in_mb << 20);
+      if (warmup == nullptr) {
+        LOG(WARNING) << "Failed to preallocate " << gpu_host_mem_prealloc_in_mb
+                     << "MB of pinned host memory for GPU transfer staging.";
+      } else {
+        allocator->DeallocateRaw(warmup);
+        // Do not let the warmup allocation show up as the high-water mark.
+        allocator->ClearStats();
+      }
+    }
+
     gpu_host_allocators_.push_back({std::unique_ptr<Allocator>(allocator),
                                     std::unique_ptr<SharedCounter>(nullptr),
                                     nullptr, sub_allocator,
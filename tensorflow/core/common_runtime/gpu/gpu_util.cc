@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stream_executor.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 // IMPLEMENTATION NOTE:
@@ -183,6 +184,29 @@ void GPUUtil::SetProtoFromGPU(const Tensor& tensor, Device* dev,
       });
 }
 
+namespace {
+
+// Minimum bytes per chunk when striping a large device-to-device copy over
+// several copy streams. 0 (the default) keeps the single monolithic memcpy.
+// Striping lets one large transfer engage multiple copy engines or
+// interconnect links, at the cost of sharing the copy streams that concurrent
+// transfers would otherwise have to themselves.
+int64_t DeviceToDeviceCopyChunkBytes() {
+  static const int64_t chunk_bytes = [] {
+    int64_t value;
+    Status status =
+        ReadInt64FromEnvVar("TF_GPU_D2D_COPY_CHUNK_BYTES", 0, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << status.error_message();
+      return int64_t{0};
+    }
+    return value;
+  }();
+  return chunk_bytes;
+}
+
+}  // namespace
+
 // static
 void GPUUtil::DeviceToDeviceCopy(
     DeviceContext* send_dev_context, DeviceContext* recv_dev_context,
@@ -228,8 +252,45 @@ void GPUUtil::DeviceToDeviceCopy(
     send_device_to_device_stream->ThenWaitFor(recv_stream);
 
     VLOG(2) << "src_ptr " << src_ptr << " dst_ptr " << dst_ptr;
-    send_device_to_device_stream->ThenMemcpy(&gpu_dst_ptr, gpu_src_ptr,
-                                             total_bytes);
+    const auto* send_gpu_context =
+        static_cast<const GPUDeviceContext*>(send_dev_context);
+    const int64_t chunk_bytes = DeviceToDeviceCopyChunkBytes();
+    int64_t num_chunks = 1;
+    if (chunk_bytes > 0) {
+      num_chunks = std::min<int64_t>(
+          send_gpu_context->num_device_to_device_streams(),
+          total_bytes / chunk_bytes);
+      if (num_chunks < 1) num_chunks = 1;
+    }
+    if (num_chunks > 1) {
+      // Stripe the transfer over the available copy streams, one chunk each.
+      // Every chunk stream synchronizes against the same producers as the
+      // primary one, and the primary stream then waits for each chunk, so
+      // completion is still observed by waiting on
+      // send_device_to_device_stream alone.
+      const int64_t bytes_per_chunk = total_bytes / num_chunks;
+      DeviceMemoryBase gpu_src_chunk(src_ptr, bytes_per_chunk);
+      DeviceMemoryBase gpu_dst_chunk(dst_ptr, bytes_per_chunk);
+      send_device_to_device_stream->ThenMemcpy(&gpu_dst_chunk, gpu_src_chunk,
+                                               bytes_per_chunk);
+      int64_t offset = bytes_per_chunk;
+      for (int64_t i = 1; i < num_chunks; ++i) {
+        const int64_t size =
+            i + 1 == num_chunks ? total_bytes - offset : bytes_per_chunk;
+        se::Stream* chunk_stream = send_gpu_context->device_to_device_stream(
+            dev_to_dev_stream_index + i);
+        chunk_stream->ThenWaitFor(send_stream);
+        chunk_stream->ThenWaitFor(recv_stream);
+        DeviceMemoryBase src_chunk(static_cast<char*>(src_ptr) + offset, size);
+        DeviceMemoryBase dst_chunk(static_cast<char*>(dst_ptr) + offset, size);
+        chunk_stream->ThenMemcpy(&dst_chunk, src_chunk, size);
+        send_device_to_device_stream->ThenWaitFor(chunk_stream);
+        offset += size;
+      }
+    } else {
+      send_device_to_device_stream->ThenMemcpy(&gpu_dst_ptr, gpu_src_ptr,
+                                               total_bytes);
+    }
   }
 
   // Use of input may outlive stack scope, so keep a ref.
@@ -328,6 +328,18 @@ class GraphConstructor {
   };
   absl::flat_hash_map<std::string, NodeInfo> gdef_nodes_;
 
+  // Pointers into gdef_nodes_, indexed by position within node_defs_. Valid
+  // after BuildNodeIndex() since gdef_nodes_ is not mutated afterwards. Lets
+  // Convert() look up entries by index without re-hashing the node name.
+  std::vector<NodeInfo*> node_info_by_index_;
+
+  // Mapping between index within node_defs_ and, for each of the node's
+  // inputs, the index within node_defs_ of the input's source node. Only
+  // populated by InitFromEdges() when neither opts_.input_map nor
+  // opts_.control_dependencies can rewrite a node's inputs, in which case
+  // Convert() reuses this resolution instead of looking inputs up again.
+  std::vector<gtl::InlinedVector<int, 4>> input_src_indices_;
+
   // Prefixes already used in the GraphDef being imported.
   absl::flat_hash_set<StringPiece> gdef_prefixes_;
 
@@ -641,6 +653,7 @@ Status GraphConstructor::ValidateInputMapAndControlDependencies() {
 
 Status GraphConstructor::BuildNodeIndex() {
   // Validate the node names and add them to gdef_nodes_ and gdef_prefixes_.
+  gdef_nodes_.reserve(node_def_count());
   for (int n = 0; n < node_def_count(); ++n) {
     const NodeDef& node_def = get_node_def(n);
     if (!IsValidNodeName(node_def.name(), opts_.allow_internal_ops)) {
@@ -680,6 +693,13 @@ Status GraphConstructor::BuildNodeIndex() {
     // Update gdef_prefixes_.
     AddPrefixes(node_def.name(), &gdef_prefixes_);
   }
+  // All nodes are now in gdef_nodes_ and no further insertions take place, so
+  // pointers into the map stay valid; index the entries by their position
+  // within node_defs_.
+  node_info_by_index_.resize(node_def_count());
+  for (auto& entry : gdef_nodes_) {
+    node_info_by_index_[entry.second.gdef_index] = &entry.second;
+  }
   return OkStatus();
 }
 
@@ -687,6 +707,13 @@ Status GraphConstructor::InitFromEdges() {
   const int num_nodes = node_def_count();
   pending_count_.reserve(num_nodes);
   outputs_.resize(num_nodes);
+  // When no option can rewrite a node's inputs, record each input's resolved
+  // source index here so Convert() doesn't have to look the inputs up again.
+  const bool cache_input_sources =
+      opts_.input_map.empty() && opts_.control_dependencies.empty();
+  if (cache_input_sources) {
+    input_src_indices_.resize(num_nodes);
+  }
   gtl::FlatSet<string> next_iteration_nodes;
   for (int n = 0; n < node_def_count(); ++n) {
     const NodeDef& node_def = get_node_def(n);
@@ -735,6 +762,9 @@ Status GraphConstructor::InitFromEdges() {
                                          node_def.input(i), "'");
         }
         outputs_[iter->second.gdef_index].push_back(n);
+        if (cache_input_sources) {
+          input_src_indices_[n].push_back(iter->second.gdef_index);
+        }
       } else {
         // This input is mapped to an existing edge. Therefore this input is
         // as good as being already processed.
@@ -1148,8 +1178,6 @@ Status GraphConstructor::Convert() {
     input_already_exists.clear();
     input_already_exists.resize(node_def.input_size(), false);
 
-    std::string node_name = node_def.name();
-
     if (opts_.importing) {
       if (opts_.skip_mapped_nodes) {
         bool is_node_mapped = false;
@@ -1182,10 +1210,16 @@ Status GraphConstructor::Convert() {
       int src_index;
 
       if (!input_already_exists[i]) {
-        // Locate input in newly-imported nodes
-        auto iter = gdef_nodes_.find(tensor_id.node());
-        DCHECK(iter != gdef_nodes_.end()) << tensor_id.node();
-        src_node = iter->second.node;
+        // Locate input in newly-imported nodes. When InitFromEdges() resolved
+        // the input sources already, reuse that resolution rather than
+        // re-hashing the input name.
+        if (!input_src_indices_.empty()) {
+          src_node = node_info_by_index_[input_src_indices_[o][i]]->node;
+        } else {
+          auto iter = gdef_nodes_.find(tensor_id.node());
+          DCHECK(iter != gdef_nodes_.end()) << tensor_id.node();
+          src_node = iter->second.node;
+        }
         src_index = tensor_id.index();
         if (src_node == nullptr) has_data_back_edge = true;
       } else {
@@ -1249,7 +1283,7 @@ Status GraphConstructor::Convert() {
 
     TF_RETURN_IF_ERROR(MakeNode(std::move(node_def), &node));
 
-    gdef_nodes_[node_name].node = node;
+    node_info_by_index_[o]->node = node;
 
     // Remove duplicate control inputs before adding edges to the graph. It
     // will allow us to skip expensive duplicates check in 'AddControlEdge'.
@@ -0,0 +1,409 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// End-to-end benchmarks for the executor pipeline on production-shaped
+// graphs. Unlike the kernel microbenchmarks, these replay whole graphs -- a
+// transformer block, a mixture-of-experts layer, and a feature-preprocessing
+// DAG -- through DirectSession and through the eager per-op dispatch path
+// (KernelAndDeviceOp), reporting step-latency percentiles and CPU allocator
+// deltas as benchmark counters. Counters are included in the benchmark
+// report, so running with --benchmark_format=json produces machine-readable
+// output that can be diffed across releases.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include "tensorflow/cc/framework/scope.h"
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/eager/kernel_and_device.h"
+#include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/common_runtime/process_function_library_runtime.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+// A benchmark workload: a graph together with its single feed and fetch.
+struct BenchmarkGraph {
+  GraphDef graph_def;
+  string feed;
+  Tensor feed_value;
+  string fetch;
+};
+
+Output RandomWeights(const Scope& scope, const string& name,
+                     std::initializer_list<int64_t> dims) {
+  Tensor weights(DT_FLOAT, TensorShape(dims));
+  weights.flat<float>().setRandom();
+  return ops::Const(scope.WithOpName(name), Input::Initializer(weights));
+}
+
+Tensor RandomInput(std::initializer_list<int64_t> dims) {
+  Tensor input(DT_FLOAT, TensorShape(dims));
+  input.flat<float>().setRandom();
+  return input;
+}
+
+// A single-head transformer block: attention with a residual connection and
+// layer normalization, followed by a position-wise feed-forward network with
+// a second residual connection. The sequence and batch dimensions are folded
+// into `num_tokens`.
+BenchmarkGraph TransformerBlockGraph(int num_tokens, int d_model, int d_ff) {
+  Scope scope = Scope::NewRootScope();
+  auto tokens = ops::Placeholder(scope.WithOpName("tokens"), DT_FLOAT,
+                                 ops::Placeholder::Shape({num_tokens, d_model}));
+  auto wq = RandomWeights(scope, "wq", {d_model, d_model});
+  auto wk = RandomWeights(scope, "wk", {d_model, d_model});
+  auto wv = RandomWeights(scope, "wv", {d_model, d_model});
+  auto q = ops::MatMul(scope, tokens, wq);
+  auto k = ops::MatMul(scope, tokens, wk);
+  auto v = ops::MatMul(scope, tokens, wv);
+  auto scale =
+      ops::Const(scope, 1.0f / std::sqrt(static_cast<float>(d_model)));
+  auto scores = ops::Mul(
+      scope, ops::MatMul(scope, q, k, ops::MatMul::TransposeB(true)), scale);
+  auto probs = ops::Softmax(scope, scores);
+  auto context = ops::MatMul(scope, probs, v);
+  auto wo = RandomWeights(scope, "wo", {d_model, d_model});
+  auto attention = ops::AddV2(scope, tokens, ops::MatMul(scope, context, wo));
+
+  // Layer normalization over the feature dimension.
+  auto axes = ops::Const(scope, {1});
+  auto mean = ops::Mean(scope, attention, axes, ops::Mean::KeepDims(true));
+  auto variance =
+      ops::Mean(scope, ops::SquaredDifference(scope, attention, mean), axes,
+                ops::Mean::KeepDims(true));
+  auto epsilon = ops::Const(scope, 1e-6f);
+  auto normed = ops::Mul(
+      scope, ops::Sub(scope, attention, mean),
+      ops::Rsqrt(scope, ops::AddV2(scope, variance, epsilon)));
+
+  auto w1 = RandomWeights(scope, "ffn_w1", {d_model, d_ff});
+  auto b1 = RandomWeights(scope, "ffn_b1", {d_ff});
+  auto w2 = RandomWeights(scope, "ffn_w2", {d_ff, d_model});
+  auto b2 = RandomWeights(scope, "ffn_b2", {d_model});
+  auto hidden =
+      ops::Relu(scope, ops::AddV2(scope, ops::MatMul(scope, normed, w1), b1));
+  auto block = ops::AddV2(scope.WithOpName("block_out"), normed,
+                          ops::AddV2(scope, ops::MatMul(scope, hidden, w2), b2));
+  TF_CHECK_OK(scope.status());
+
+  BenchmarkGraph result;
+  TF_CHECK_OK(scope.ToGraphDef(&result.graph_def));
+  result.feed = tokens.node()->name();
+  result.feed_value = RandomInput({num_tokens, d_model});
+  result.fetch = block.node()->name();
+  return result;
+}
+
+// A dense mixture-of-experts layer: a softmax router followed by `num_experts`
+// two-layer expert networks whose outputs are blended by the router weights.
+// Every expert runs on every token, which matches the shape of a serving-time
+// MoE layer with small expert counts.
+BenchmarkGraph MoELayerGraph(int num_tokens, int d_model, int num_experts,
+                             int d_hidden) {
+  Scope scope = Scope::NewRootScope();
+  auto tokens = ops::Placeholder(scope.WithOpName("tokens"), DT_FLOAT,
+                                 ops::Placeholder::Shape({num_tokens, d_model}));
+  auto router_w = RandomWeights(scope, "router_w", {d_model, num_experts});
+  auto gates = ops::Softmax(scope, ops::MatMul(scope, tokens, router_w));
+
+  Output combined;
+  for (int e = 0; e < num_experts; ++e) {
+    auto w1 = RandomWeights(scope, strings::StrCat("expert_", e, "_w1"),
+                            {d_model, d_hidden});
+    auto w2 = RandomWeights(scope, strings::StrCat("expert_", e, "_w2"),
+                            {d_hidden, d_model});
+    auto hidden = ops::Relu(scope, ops::MatMul(scope, tokens, w1));
+    auto expert = ops::MatMul(scope, hidden, w2);
+    auto gate = ops::Slice(scope, gates, ops::Const(scope, {0, e}),
+                           ops::Const(scope, {num_tokens, 1}));
+    auto contribution = ops::Mul(scope, expert, gate);
+    combined = (e == 0) ? Output(contribution)
+                        : Output(ops::AddV2(scope, combined, contribution));
+  }
+  auto moe_out = ops::Identity(scope.WithOpName("moe_out"), combined);
+  TF_CHECK_OK(scope.status());
+
+  BenchmarkGraph result;
+  TF_CHECK_OK(scope.ToGraphDef(&result.graph_def));
+  result.feed = tokens.node()->name();
+  result.feed_value = RandomInput({num_tokens, d_model});
+  result.fetch = moe_out.node()->name();
+  return result;
+}
+
+// A feature-preprocessing DAG: per-feature normalization and clipping on many
+// small independent branches, pairwise feature crosses, and a concat feeding
+// a projection. This is wide and shallow where the model graphs are narrow
+// and deep, and stresses executor scheduling overhead per op.
+BenchmarkGraph FeaturePreprocessingGraph(int batch, int num_features) {
+  Scope scope = Scope::NewRootScope();
+  auto features = ops::Placeholder(scope.WithOpName("features"), DT_FLOAT,
+                                   ops::Placeholder::Shape({batch, num_features}));
+  auto lower = ops::Const(scope, -3.0f);
+  auto upper = ops::Const(scope, 3.0f);
+  std::vector<Output> processed;
+  for (int i = 0; i < num_features; ++i) {
+    auto column = ops::Slice(scope, features, ops::Const(scope, {0, i}),
+                             ops::Const(scope, {batch, 1}));
+    auto mean = ops::Const(scope, 0.05f * i);
+    auto inv_std = ops::Const(scope, 1.0f / (1.0f + 0.01f * i));
+    auto normalized = ops::Mul(scope, ops::Sub(scope, column, mean), inv_std);
+    auto clipped =
+        ops::Minimum(scope, ops::Maximum(scope, normalized, lower), upper);
+    processed.push_back(clipped);
+  }
+  // Pairwise crosses of neighboring features.
+  const int num_base_features = processed.size();
+  for (int i = 0; i + 1 < num_base_features; i += 2) {
+    processed.push_back(ops::Mul(scope, processed[i], processed[i + 1]));
+  }
+  auto concatenated =
+      ops::Concat(scope, InputList(processed), ops::Const(scope, 1));
+  auto projection = RandomWeights(scope, "projection",
+                                  {static_cast<int64_t>(processed.size()), 64});
+  auto embedded = ops::Relu(scope.WithOpName("embedded"),
+                            ops::MatMul(scope, concatenated, projection));
+  TF_CHECK_OK(scope.status());
+
+  BenchmarkGraph result;
+  TF_CHECK_OK(scope.ToGraphDef(&result.graph_def));
+  result.feed = features.node()->name();
+  result.feed_value = RandomInput({batch, num_features});
+  result.fetch = embedded.node()->name();
+  return result;
+}
+
+double Percentile(const std::vector<double>& sorted_values, double percentile) {
+  if (sorted_values.empty()) return 0.0;
+  const int index =
+      std::min<int>(sorted_values.size() - 1,
+                    static_cast<int>(percentile * sorted_values.size()));
+  return sorted_values[index];
+}
+
+// Runs `step` under the benchmark loop and attaches step-latency percentiles
+// and CPU allocator deltas to the reported counters.
+void ReplayAndReport(::testing::benchmark::State& state,
+                     const std::function<void()>& step) {
+  Allocator* allocator = cpu_allocator();
+  const absl::optional<AllocatorStats> before = allocator->GetStats();
+  Env* env = Env::Default();
+  std::vector<double> step_micros;
+  for (auto s : state) {
+    const uint64 start_nanos = env->NowNanos();
+    step();
+    step_micros.push_back((env->NowNanos() - start_nanos) / 1000.0);
+  }
+  const absl::optional<AllocatorStats> after = allocator->GetStats();
+
+  std::sort(step_micros.begin(), step_micros.end());
+  state.counters["p50_step_micros"] = Percentile(step_micros, 0.5);
+  state.counters["p90_step_micros"] = Percentile(step_micros, 0.9);
+  state.counters["p99_step_micros"] = Percentile(step_micros, 0.99);
+  if (before.has_value() && after.has_value() && !step_micros.empty()) {
+    state.counters["allocs_per_step"] =
+        (after->num_allocs - before->num_allocs) /
+        static_cast<double>(step_micros.size());
+    state.counters["peak_bytes_in_use"] =
+        static_cast<double>(after->peak_bytes_in_use);
+  }
+}
+
+// Replays `graph` through DirectSession::Run.
+void RunSessionBenchmark(::testing::benchmark::State& state,
+                         const BenchmarkGraph& graph) {
+  SessionOptions options;
+  std::unique_ptr<Session> session(NewSession(options));
+  TF_CHECK_OK(session->Create(graph.graph_def));
+  const std::vector<std::pair<string, Tensor>> inputs = {
+      {graph.feed, graph.feed_value}};
+  const std::vector<string> fetches = {graph.fetch};
+  std::vector<Tensor> outputs;
+  // The first Run pays the partitioning/pruning overhead; exclude it so the
+  // percentiles describe steady-state steps.
+  TF_CHECK_OK(session->Run(inputs, fetches, {}, &outputs));
+  ReplayAndReport(state, [&]() {
+    std::vector<Tensor> output_values;
+    TF_CHECK_OK(session->Run(inputs, fetches, {}, &output_values));
+  });
+}
+
+// A CPU-only function library runtime for dispatching kernels the way eager
+// execution does, mirroring TestEnv in eager/kernel_and_device_test.cc.
+class EagerReplayEnv {
+ public:
+  EagerReplayEnv() : flib_def_(OpRegistry::Global(), {}) {
+    std::vector<std::unique_ptr<Device>> devices;
+    devices.push_back(
+        DeviceFactory::NewDevice("CPU", {}, "/job:a/replica:0/task:0"));
+    cpu_device_ = devices.back().get();
+    device_mgr_ = absl::make_unique<StaticDeviceMgr>(std::move(devices));
+    OptimizerOptions opts;
+    pflr_ = absl::make_unique<ProcessFunctionLibraryRuntime>(
+        device_mgr_.get(), Env::Default(), /*config=*/nullptr,
+        TF_GRAPH_DEF_VERSION, &flib_def_, opts,
+        /*default_thread_pool=*/nullptr);
+    flr_ = pflr_->GetFLR("/job:a/replica:0/task:0/device:CPU:0");
+    CHECK(flr_ != nullptr);
+  }
+
+  FunctionLibraryRuntime* function_library_runtime() const { return flr_; }
+  Device* cpu_device() { return cpu_device_; }
+
+ private:
+  FunctionLibraryDefinition flib_def_;
+  std::unique_ptr<DeviceMgr> device_mgr_;
+  FunctionLibraryRuntime* flr_;
+  std::unique_ptr<ProcessFunctionLibraryRuntime> pflr_;
+  Device* cpu_device_;
+};
+
+// Replays `bench_graph` through the eager per-op dispatch path: one
+// KernelAndDeviceOp per node, executed in topological order with materialized
+// intermediate tensors. Kernels are instantiated up front, matching the
+// kernel cache eager execution builds after the first call.
+void RunEagerBenchmark(::testing::benchmark::State& state,
+                       const BenchmarkGraph& bench_graph) {
+  EagerReplayEnv env;
+  Graph graph(OpRegistry::Global());
+  GraphConstructorOptions opts;
+  TF_CHECK_OK(ConvertGraphDefToGraph(opts, bench_graph.graph_def, &graph));
+  std::vector<Node*> order;
+  GetReversePostOrder(graph, &order);
+
+  const Node* feed_node = nullptr;
+  std::unordered_map<const Node*, std::unique_ptr<KernelAndDeviceOp>> kernels;
+  std::unordered_map<const Node*, std::vector<std::pair<const Node*, int>>>
+      input_sources;
+  for (Node* node : order) {
+    if (!node->IsOp()) continue;
+    if (node->name() == bench_graph.feed) {
+      feed_node = node;
+      continue;
+    }
+    auto kernel = absl::make_unique<KernelAndDeviceOp>(
+        /*rendezvous=*/nullptr, /*log_memory=*/false,
+        env.function_library_runtime(), /*runner=*/nullptr,
+        /*collective_executor=*/nullptr, env.cpu_device());
+    TF_CHECK_OK(kernel->Init({}, node->def(), /*graph_collector=*/nullptr));
+    kernels.emplace(node, std::move(kernel));
+    std::vector<const Edge*> in_edges;
+    TF_CHECK_OK(node->input_edges(&in_edges));
+    std::vector<std::pair<const Node*, int>>& sources = input_sources[node];
+    for (const Edge* edge : in_edges) {
+      sources.emplace_back(edge->src(), edge->src_output());
+    }
+  }
+  CHECK(feed_node != nullptr);
+
+  auto step = [&]() {
+    std::unordered_map<const Node*, std::vector<Tensor>> results;
+    results[feed_node] = {bench_graph.feed_value};
+    for (Node* node : order) {
+      if (!node->IsOp() || node == feed_node) continue;
+      gtl::InlinedVector<TensorValue, 4> inputs;
+      for (const auto& source : input_sources[node]) {
+        inputs.push_back(TensorValue(&results[source.first][source.second]));
+      }
+      std::vector<EagerKernelRet> rets;
+      TF_CHECK_OK(kernels[node]->Run(
+          /*step_container=*/nullptr, EagerKernelArgs(std::move(inputs)),
+          &rets, /*cancellation_manager=*/nullptr,
+          /*remote_func_params=*/absl::nullopt,
+          /*stack_trace=*/absl::nullopt,
+          /*coordination_service_agent=*/nullptr));
+      std::vector<Tensor>& outputs = results[node];
+      outputs.reserve(rets.size());
+      for (EagerKernelRet& ret : rets) {
+        outputs.push_back(absl::get<Tensor>(std::move(ret)));
+      }
+    }
+  };
+  // Warm up once so per-step timings exclude one-time lazy initialization.
+  step();
+  ReplayAndReport(state, step);
+}
+
+void BM_SessionTransformerBlock(::testing::benchmark::State& state) {
+  RunSessionBenchmark(state, TransformerBlockGraph(/*num_tokens=*/state.range(0),
+                                                   /*d_model=*/256,
+                                                   /*d_ff=*/1024));
+}
+BENCHMARK(BM_SessionTransformerBlock)->UseRealTime()->Arg(32)->Arg(128);
+
+void BM_SessionMoELayer(::testing::benchmark::State& state) {
+  RunSessionBenchmark(state, MoELayerGraph(/*num_tokens=*/state.range(0),
+                                           /*d_model=*/256, /*num_experts=*/8,
+                                           /*d_hidden=*/512));
+}
+BENCHMARK(BM_SessionMoELayer)->UseRealTime()->Arg(32)->Arg(128);
+
+void BM_SessionFeaturePreprocessing(::testing::benchmark::State& state) {
+  RunSessionBenchmark(state,
+                      FeaturePreprocessingGraph(/*batch=*/state.range(0),
+                                                /*num_features=*/64));
+}
+BENCHMARK(BM_SessionFeaturePreprocessing)->UseRealTime()->Arg(256)->Arg(1024);
+
+void BM_EagerTransformerBlock(::testing::benchmark::State& state) {
+  RunEagerBenchmark(state, TransformerBlockGraph(/*num_tokens=*/state.range(0),
+                                                 /*d_model=*/256,
+                                                 /*d_ff=*/1024));
+}
+BENCHMARK(BM_EagerTransformerBlock)->UseRealTime()->Arg(32)->Arg(128);
+
+void BM_EagerMoELayer(::testing::benchmark::State& state) {
+  RunEagerBenchmark(state, MoELayerGraph(/*num_tokens=*/state.range(0),
+                                         /*d_model=*/256, /*num_experts=*/8,
+                                         /*d_hidden=*/512));
+}
+BENCHMARK(BM_EagerMoELayer)->UseRealTime()->Arg(32)->Arg(128);
+
+void BM_EagerFeaturePreprocessing(::testing::benchmark::State& state) {
+  RunEagerBenchmark(state,
+                    FeaturePreprocessingGraph(/*batch=*/state.range(0),
+                                              /*num_features=*/64));
+}
+BENCHMARK(BM_EagerFeaturePreprocessing)->UseRealTime()->Arg(256)->Arg(1024);
+
+}  // namespace
+}  // namespace tensorflow
@@ -29,16 +29,19 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/single_threaded_cpu_device.h"
 #include "tensorflow/core/framework/log_memory.h"
 #include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/graph/subgraph.h"
+#include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/tensor_slice_reader_cache.h"
 
 namespace tensorflow {
 
@@ -91,6 +94,197 @@ class SimpleRendezvous : public RendezvousInterface {
   Table table_ TF_GUARDED_BY(mu_);
 };
 
+// Key identifying a produced (or fed) tensor: the node id in the high bits
+// and the output slot in the low bits.
+int64_t TensorKey(int node_id, int slot) {
+  return (static_cast<int64_t>(node_id) << 32) | static_cast<uint32>(slot);
+}
+
+// Attempts to evaluate `output_names` by walking `graph` in topological order
+// and invoking each kernel synchronously, without constructing an executor or
+// routing tensors through a rendezvous. This is substantially cheaper than
+// the executor path for the small constant subgraphs evaluated during shape
+// inference and constant folding.
+//
+// Returns OkStatus with *evaluated == false when the graph needs the full
+// executor path (non-CPU placement, control flow, stateful, async or
+// ref-producing kernels); no kernel has been run in that case. Any non-OK
+// status is a genuine evaluation failure.
+Status TryRunDirectly(Device* device, FunctionLibraryRuntime* function_library,
+                      const Graph& graph,
+                      const GraphRunner::NamedTensorList& inputs,
+                      const std::vector<string>& output_names,
+                      std::vector<Tensor>* outputs, bool* evaluated) {
+  *evaluated = false;
+  if (device->device_type() != DEVICE_CPU) {
+    return OkStatus();
+  }
+
+  std::unordered_map<string, Node*> nodes_by_name;
+  for (Node* n : graph.op_nodes()) {
+    nodes_by_name[n->name()] = n;
+  }
+
+  // Prime the tensor table with the feeds. Fed tensors cut the edges from
+  // their producers, so the producers are not visited below unless another
+  // (unfed) output of theirs is needed.
+  std::unordered_map<int64_t, Tensor> tensors;
+  std::unordered_map<TensorId, Tensor, TensorId::Hasher> feeds;
+  for (const auto& in : inputs) {
+    TensorId id = ParseTensorName(in.first);
+    feeds[id] = in.second;
+    auto it = nodes_by_name.find(string(id.first));
+    if (it != nodes_by_name.end()) {
+      tensors[TensorKey(it->second->id(), id.second)] = in.second;
+    }
+  }
+
+  std::vector<Node*> start_nodes;
+  for (const string& name : output_names) {
+    TensorId id = ParseTensorName(name);
+    if (feeds.count(id) > 0) {
+      continue;
+    }
+    auto it = nodes_by_name.find(string(id.first));
+    if (it == nodes_by_name.end() || id.second < 0 ||
+        id.second >= it->second->num_outputs()) {
+      // Let the executor path produce its canonical error message.
+      return OkStatus();
+    }
+    if (tensors.count(TensorKey(it->second->id(), id.second)) == 0) {
+      start_nodes.push_back(it->second);
+    }
+  }
+
+  // Collect the nodes to run, producers before consumers. The `leave`
+  // callback of a reverse DFS fires after all of a node's (unfed, non-control)
+  // inputs have been visited. Control edges are not followed: only stateless
+  // kernels are run below, so a pure control dependency cannot affect the
+  // computed values.
+  std::vector<Node*> order;
+  ReverseDFSFrom(
+      graph, start_nodes, /*enter=*/nullptr,
+      /*leave=*/[&order](Node* n) { order.push_back(n); },
+      /*stable_comparator=*/{},
+      /*edge_filter=*/[&tensors](const Edge& e) {
+        return !e.IsControlEdge() &&
+               tensors.count(TensorKey(e.src()->id(), e.src_output())) == 0;
+      });
+
+  // Plan phase: check that every node can be run synchronously and create
+  // the kernels. No kernel has been invoked yet, so bailing out here is
+  // side-effect free.
+  const int producer = graph.versions().producer();
+  std::vector<std::unique_ptr<OpKernel>> kernels;
+  kernels.reserve(order.size());
+  for (Node* n : order) {
+    if (n->IsControlFlow() || n->IsSend() || n->IsRecv() || n->IsCollective() ||
+        n->op_def().is_stateful()) {
+      return OkStatus();
+    }
+    for (int i = 0; i < n->num_outputs(); ++i) {
+      if (IsRefType(n->output_type(i))) {
+        return OkStatus();
+      }
+    }
+    OpKernel* kernel = nullptr;
+    Status s = CreateNonCachedKernel(device, function_library, n->properties(),
+                                     producer, &kernel);
+    if (!s.ok()) {
+      // The kernel may simply not be registered for this device; let the
+      // executor path report the error (or handle it) instead.
+      return OkStatus();
+    }
+    kernels.emplace_back(kernel);
+    if (kernel->AsAsync() != nullptr) {
+      return OkStatus();
+    }
+  }
+
+  // Execution phase.
+  std::function<void(std::function<void()>)> runner =
+      [](std::function<void()> c) { c(); };
+  CancellationManager cancellation_manager;
+  checkpoint::TensorSliceReaderCacheWrapper slice_reader_cache;
+  ScopedStepContainer step_container(
+      LogMemory::CONSTANT_FOLDING_STEP_ID, [device](const string& name) {
+        device->resource_manager()->Cleanup(name).IgnoreError();
+      });
+
+  for (size_t node_idx = 0; node_idx < order.size(); ++node_idx) {
+    Node* n = order[node_idx];
+    OpKernel* kernel = kernels[node_idx].get();
+
+    gtl::InlinedVector<TensorValue, 4> node_inputs(n->num_inputs());
+    gtl::InlinedVector<AllocatorAttributes, 4> input_alloc_attrs(
+        n->num_inputs());
+    for (const Edge* e : n->in_edges()) {
+      if (e->IsControlEdge()) continue;
+      auto it = tensors.find(TensorKey(e->src()->id(), e->src_output()));
+      if (it == tensors.end()) {
+        return errors::Internal("Missing input ", e->src()->name(), ":",
+                                e->src_output(), " for node ", n->name());
+      }
+      node_inputs[e->dst_input()] = TensorValue(&it->second);
+    }
+
+    std::vector<AllocatorAttributes> output_attrs(n->num_outputs());
+    OpKernelContext::Params params;
+    params.step_id = LogMemory::CONSTANT_FOLDING_STEP_ID;
+    params.op_kernel = kernel;
+    params.device = device;
+    params.output_attr_array = output_attrs.data();
+    params.resource_manager = device->resource_manager();
+    params.step_container = &step_container;
+    params.cancellation_manager = &cancellation_manager;
+    params.inputs = &node_inputs;
+    params.input_alloc_attrs = &input_alloc_attrs;
+    params.frame_iter = FrameAndIter(0, 0);
+    params.function_library = function_library;
+    params.runner = &runner;
+    params.slice_reader_cache = &slice_reader_cache;
+    params.log_memory = LogMemory::IsEnabled();
+
+    OpKernelContext ctx(&params, n->num_outputs());
+    device->Compute(kernel, &ctx);
+    TF_RETURN_IF_ERROR(ctx.status());
+
+    for (int i = 0; i < n->num_outputs(); ++i) {
+      const Tensor* out = ctx.mutable_output(i);
+      if (out != nullptr) {
+        // Insert only if absent: a fed output of this node takes precedence
+        // over the recomputed value.
+        tensors.emplace(TensorKey(n->id(), i), *out);
+      }
+    }
+  }
+
+  // Fetch phase.
+  outputs->resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    TensorId id = ParseTensorName(output_names[i]);
+    const Tensor* result = nullptr;
+    auto feed_it = feeds.find(id);
+    if (feed_it != feeds.end()) {
+      result = &feed_it->second;
+    } else {
+      Node* n = nodes_by_name[string(id.first)];
+      auto it = tensors.find(TensorKey(n->id(), id.second));
+      if (it == tensors.end()) {
+        return errors::Internal("Output ", output_names[i],
+                                " was not computed");
+      }
+      result = &it->second;
+    }
+    // Does a deep copy so that the output's lifetime isn't tied to the
+    // allocator of `device`, matching the executor path below.
+    (*outputs)[i] = tensor::DeepCopy(*result);
+  }
+
+  *evaluated = true;
+  return OkStatus();
+}
+
 }  // namespace
 
 GraphRunner::GraphRunner(Env* env)
@@ -120,6 +314,16 @@ Status GraphRunner::Run(Graph* graph, FunctionLibraryRuntime* function_library,
     function_library = nullptr;
   }
 
+  // Fast path: interpret the graph directly, one kernel at a time, skipping
+  // graph rewriting, executor construction and the rendezvous. Falls through
+  // to the executor below for graphs it cannot handle.
+  bool evaluated = false;
+  TF_RETURN_IF_ERROR(TryRunDirectly(device_, function_library, *graph, inputs,
+                                    output_names, outputs, &evaluated));
+  if (evaluated) {
+    return OkStatus();
+  }
+
   // TODO(vrv): Instead of copying the entire graph, consider modifying
   // the existing graph, and then removing those removed edges.
   // prior to returning.
@@ -112,5 +112,19 @@ TEST(GraphRunnerTest, FeedAndFetch) {
   test::ExpectEqual(test::AsScalar(3.0f), outputs[0]);
 }
 
+// Stateful ops cannot be run by the direct-interpretation fast path and must
+// fall back to the executor.
+TEST(GraphRunnerTest, StatefulOpFallsBackToExecutor) {
+  Scope root = Scope::NewRootScope();
+  auto shape = ops::Const(root.WithOpName("shape"), {2, 2});
+  auto rand =
+      ops::RandomUniform(root.WithOpName("rand"), shape, DT_FLOAT);
+  GraphRunner graph_runner(Env::Default());
+  std::vector<Tensor> outputs;
+  Status s = graph_runner.Run(root.graph(), nullptr, {}, {"rand:0"}, &outputs);
+  TF_ASSERT_OK(s);
+  EXPECT_EQ(outputs[0].shape(), TensorShape({2, 2}));
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -0,0 +1,432 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_tree_reducer.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tensorflow/core/common_runtime/collective_rma_local.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+
+namespace tensorflow {
+
+namespace {
+// Key to be used for BufRendezvous by HierarchicalTreeReducer.
+string ReduceBufKey(const string& exec_key, int subdiv, int src_rank,
+                    int dst_rank) {
+  // TODO(b/78352018): Try a denser format, e.g. a 64 or 128 bit hash.
+  return strings::StrCat(exec_key, ":r:", subdiv, ":", src_rank, ":",
+                         dst_rank);
+}
+}  // namespace
+
+HierarchicalTreeReducer::HierarchicalTreeReducer()
+    : col_ctx_(nullptr), col_params_(nullptr), done_(nullptr) {}
+
+Status HierarchicalTreeReducer::InitializeCollectiveParams(
+    CollectiveParams* col_params) {
+  CHECK_EQ(col_params->instance.type, REDUCTION_COLLECTIVE);
+  CHECK_EQ(col_params->instance.impl_details.collective_name,
+           "HierarchicalTreeReduce");
+  const string& device_name =
+      col_params->group.members[col_params->default_rank].device.name();
+  // Start by counting the devices in each task.
+  // Precondition: device_names must be sorted so that all devices in
+  // the same task are adjacent.
+  std::vector<int> dev_per_task;
+  const string* prior_task_name = &col_params->group.members[0].task;
+  int dev_count = 1;
+  for (int di = 1; di < col_params->group.group_size; ++di) {
+    if (col_params->group.members[di].task != *prior_task_name) {
+      dev_per_task.push_back(dev_count);
+      dev_count = 1;
+      prior_task_name = &col_params->group.members[di].task;
+    } else {
+      ++dev_count;
+    }
+  }
+  dev_per_task.push_back(dev_count);
+  CHECK_EQ(col_params->group.num_tasks, dev_per_task.size());
+
+  if (VLOG_IS_ON(2)) {
+    string dpt_buf;
+    for (int dpt : dev_per_task) strings::StrAppend(&dpt_buf, dpt, ";");
+    VLOG(2) << "HierarchicalTreeReducer::InitializeCollectiveParams device="
+            << device_name << " dev_per_task=" << dpt_buf;
+  }
+  int num_tasks = col_params->group.num_tasks;
+  // If there is just 1 task, the entire reduction is intra-task and there is
+  // a single subdiv.  Otherwise, the first subdiv is the inter-task exchange
+  // between per-task leaders, and then there are N more subdivs, where N is
+  // #task.
+  int num_subdivs = num_tasks + (num_tasks > 1 ? 1 : 0);
+
+  col_params->instance.impl_details.subdiv_permutations.resize(num_subdivs);
+  col_params->subdiv_rank.reserve(num_subdivs);
+  col_params->instance.impl_details.subdiv_source_rank.reserve(num_subdivs);
+
+  // Inter-task subdiv.  The leader (first) device of each task participates.
+  // If a device does not participate in the subdiv, set subdiv_rank to -1.
+  if (num_tasks > 1) {
+    const int sdi = 0;
+    std::vector<int>& perm =
+        col_params->instance.impl_details.subdiv_permutations[sdi];
+    CHECK_EQ(perm.size(), 0);
+    int device_count = 0;
+    for (int ti = 0; ti < col_params->group.num_tasks; ti++) {
+      perm.push_back(device_count);
+      if (col_params->group.members[device_count].device.name() ==
+          device_name) {
+        col_params->subdiv_rank.push_back(ti);
+      }
+      device_count += dev_per_task[ti];
+    }
+    if (col_params->subdiv_rank.empty()) col_params->subdiv_rank.push_back(-1);
+    // The fully reduced value is assembled on the leader of task 0.
+    col_params->instance.impl_details.subdiv_source_rank.push_back(0);
+  }
+
+  // Intra-task subdivs.  Pick all devices in task ti for subdiv sdi, with the
+  // task leader at rank 0.  If a device does not participate in the subdiv,
+  // set subdiv_rank to -1.
+  int abs_di = 0;
+  for (int ti = 0; ti < col_params->group.num_tasks; ti++) {
+    const int sdi = ti + (num_tasks > 1 ? 1 : 0);
+    std::vector<int>& perm =
+        col_params->instance.impl_details.subdiv_permutations[sdi];
+    CHECK_EQ(perm.size(), 0);
+    bool participate = false;
+    for (int di = 0; di < dev_per_task[ti]; di++) {
+      perm.push_back(abs_di);
+      if (col_params->group.members[abs_di].device.name() == device_name) {
+        participate = true;
+        col_params->subdiv_rank.push_back(di);
+      }
+      abs_di++;
+    }
+    if (!participate) col_params->subdiv_rank.push_back(-1);
+    col_params->instance.impl_details.subdiv_source_rank.push_back(0);
+  }
+
+  VLOG(2) << collective_util::SubdivPermDebugString(*col_params);
+  return OkStatus();
+}
+
+Status HierarchicalTreeReducer::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  CHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+void HierarchicalTreeReducer::Run(StatusCallback done) {
+  CHECK(col_ctx_);
+  CHECK(col_params_);
+  // Since `HierarchicalTreeReducer` doesn't require non-overlapping
+  // collectives, unblock any collective that is blocked on this instance.
+  col_ctx_->col_exec->UnblockDependencies(*col_params_);
+
+  done_ = std::move(done);
+
+  // Start by copying input to output if they're not already the same, i.e. if
+  // we're not computing in-place on the input tensor.
+  if ((col_ctx_->input != col_ctx_->output) &&
+      (DMAHelper::base(col_ctx_->input) != DMAHelper::base(col_ctx_->output))) {
+    // We are running in a blockable thread and the callback can't block so
+    // just wait here on the copy.
+    Notification note;
+    Status status;
+    profiler::TraceMe activity("MemCpyAsync", profiler::TraceMeLevel::kInfo);
+    CollectiveRemoteAccessLocal::MemCpyAsync(
+        col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->op_device_context(), col_ctx_->device,
+        col_ctx_->device, col_ctx_->op_ctx->input_alloc_attr(0),
+        col_ctx_->op_ctx->output_alloc_attr(0), col_ctx_->input,
+        col_ctx_->output, 0 /*dev_to_dev_stream_index*/,
+        [&note, &status](const Status& s) {
+          status.Update(s);
+          note.Notify();
+        });
+    note.WaitForNotification();
+    if (!status.ok()) {
+      done_(status);
+      return;
+    }
+  }
+  RunTree();
+}
+
+// Executes the hierarchical reduce in three phases, all against the reduced
+// value accumulating in the output tensor:
+//  1. Intra-task reduce: each non-leader device sends its value to its task
+//     leader, which merges the values with merge_op.
+//  2. Inter-task exchange: each non-root leader sends its per-task partial
+//     reduction to the root leader, which merges them, applies final_op, and
+//     returns the result; the cross-task links carry one tensor per task in
+//     each direction.
+//  3. Intra-task broadcast: each leader forwards the final value to the other
+//     devices of its task.
+void HierarchicalTreeReducer::RunTree() {
+  const int num_tasks = col_params_->group.num_tasks;
+  const bool multi_task = num_tasks > 1;
+  // Locate this device's intra-task subdiv and its rank within it.
+  int intra_subdiv = -1;
+  int intra_rank = -1;
+  for (int si = multi_task ? 1 : 0;
+       si < static_cast<int>(col_params_->subdiv_rank.size()); ++si) {
+    if (col_params_->subdiv_rank[si] >= 0) {
+      intra_subdiv = si;
+      intra_rank = col_params_->subdiv_rank[si];
+      break;
+    }
+  }
+  CHECK_GE(intra_subdiv, 0);
+  const int intra_size = static_cast<int>(
+      col_params_->instance.impl_details.subdiv_permutations[intra_subdiv]
+          .size());
+  const bool is_leader = intra_rank == 0;
+  const int inter_rank = multi_task ? col_params_->subdiv_rank[0] : -1;
+  const bool is_root = multi_task ? (inter_rank == 0) : is_leader;
+  VLOG(1) << "Running HierarchicalTreeReduce device=" << col_ctx_->device_name
+          << " intra_subdiv=" << intra_subdiv << " intra_rank=" << intra_rank
+          << " inter_rank=" << inter_rank;
+
+  // Phase 1: intra-task reduce to the task leader.
+  if (status_.ok()) {
+    profiler::TraceMe activity("IntraTaskReduce",
+                               profiler::TraceMeLevel::kInfo);
+    if (is_leader) {
+      status_.Update(ReduceFromRanks(intra_subdiv, intra_size));
+    } else {
+      status_.Update(SendToRank(intra_subdiv, 0, intra_rank, col_ctx_->output));
+    }
+  }
+
+  // Phase 2: inter-task exchange between leaders, with final_op applied once
+  // on the fully reduced value at the root.
+  if (status_.ok() && is_leader) {
+    profiler::TraceMe activity("InterTaskExchange",
+                               profiler::TraceMeLevel::kInfo);
+    if (!multi_task) {
+      status_.Update(ApplyFinalOp());
+    } else if (is_root) {
+      status_.Update(ReduceFromRanks(0, num_tasks));
+      if (status_.ok()) status_.Update(ApplyFinalOp());
+      if (status_.ok()) {
+        std::vector<int> leader_ranks;
+        leader_ranks.reserve(num_tasks - 1);
+        for (int ti = 1; ti < num_tasks; ++ti) leader_ranks.push_back(ti);
+        status_.Update(SendToRanks(0, leader_ranks, 0, col_ctx_->output));
+      }
+    } else {
+      status_.Update(SendToRank(0, 0, inter_rank, col_ctx_->output));
+      if (status_.ok()) {
+        status_.Update(RecvFromRank(0, 0, inter_rank, col_ctx_->output));
+      }
+    }
+  }
+
+  // Phase 3: intra-task broadcast of the final value from the leader.
+  if (status_.ok()) {
+    profiler::TraceMe activity("IntraTaskBroadcast",
+                               profiler::TraceMeLevel::kInfo);
+    if (is_leader) {
+      std::vector<int> local_ranks;
+      local_ranks.reserve(intra_size - 1);
+      for (int di = 1; di < intra_size; ++di) local_ranks.push_back(di);
+      status_.Update(
+          SendToRanks(intra_subdiv, local_ranks, 0, col_ctx_->output));
+    } else {
+      status_.Update(
+          RecvFromRank(intra_subdiv, 0, intra_rank, col_ctx_->output));
+    }
+  }
+
+  VLOG(2) << "device=" << col_ctx_->device_name << " return status " << status_;
+  done_(status_);
+}
+
+Status HierarchicalTreeReducer::SendToRank(int subdiv, int dst_rank,
+                                           int src_rank,
+                                           const Tensor* src_tensor) {
+  Notification note;
+  Status status;
+  DispatchSend(subdiv, dst_rank, src_rank, src_tensor,
+               [&note, &status](const Status& s) {
+                 status.Update(s);
+                 note.Notify();
+               });
+  note.WaitForNotification();
+  return status;
+}
+
+Status HierarchicalTreeReducer::SendToRanks(int subdiv,
+                                            const std::vector<int>& dst_ranks,
+                                            int src_rank,
+                                            const Tensor* src_tensor) {
+  mutex mu;  // also guards status while callbacks are pending
+  Status status;
+  int pending_count = 0;  // TF_GUARDED_BY(mu)
+  condition_variable all_done;
+  for (int dst_rank : dst_ranks) {
+    {
+      mutex_lock l(mu);
+      ++pending_count;
+    }
+    DispatchSend(subdiv, dst_rank, src_rank, src_tensor,
+                 [&mu, &status, &pending_count, &all_done](const Status& s) {
+                   mutex_lock l(mu);
+                   status.Update(s);
+                   --pending_count;
+                   if (pending_count == 0) {
+                     all_done.notify_all();
+                   }
+                 });
+  }
+  {
+    mutex_lock l(mu);
+    if (pending_count > 0) {
+      all_done.wait(l);
+    }
+  }
+  return status;
+}
+
+Status HierarchicalTreeReducer::RecvFromRank(int subdiv, int src_rank,
+                                             int dst_rank, Tensor* dst_tensor) {
+  Notification note;
+  Status status;
+  DispatchRecv(subdiv, src_rank, dst_rank, dst_tensor,
+               [&note, &status](const Status& s) {
+                 status.Update(s);
+                 note.Notify();
+               });
+  note.WaitForNotification();
+  return status;
+}
+
+Status HierarchicalTreeReducer::ReduceFromRanks(int subdiv, int num_ranks) {
+  if (num_ranks <= 1) return OkStatus();
+  Tensor tmp(col_ctx_->device->GetAllocator(
+                 col_ctx_->op_ctx->output_alloc_attr(0)),
+             col_ctx_->output->dtype(), col_ctx_->output->shape());
+  for (int src_rank = 1; src_rank < num_ranks; ++src_rank) {
+    TF_RETURN_IF_ERROR(RecvFromRank(subdiv, src_rank, 0, &tmp));
+    TF_RETURN_IF_ERROR(collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->merge_op, col_ctx_->output, &tmp));
+  }
+  return OkStatus();
+}
+
+Status HierarchicalTreeReducer::ApplyFinalOp() {
+  if (!col_params_->final_op) return OkStatus();
+  // Create an on-device scalar value from the group size, then combine it
+  // into the reduced value, e.g. dividing a summed tensor to form a mean.
+  std::unique_ptr<CollectiveAdapter> ca(MakeCollectiveAdapter(
+      col_ctx_->output, 1,
+      col_ctx_->device->GetAllocator(col_ctx_->op_ctx->output_alloc_attr(0))));
+  Tensor group_size_val = ca->Scalar(col_params_->group.group_size);
+  Tensor group_size_tensor = group_size_val;
+  if (col_params_->group.device_type != "CPU") {
+    group_size_tensor = ca->Scalar(
+        col_ctx_->device->GetAllocator(col_ctx_->op_ctx->input_alloc_attr(0)),
+        AllocationAttributes());
+    Notification note;
+    Status status;
+    DeviceContext* op_dev_ctx = col_ctx_->op_ctx->op_device_context();
+    op_dev_ctx->CopyCPUTensorToDevice(&group_size_val, col_ctx_->device,
+                                      &group_size_tensor,
+                                      [&note, &status](const Status& s) {
+                                        status.Update(s);
+                                        note.Notify();
+                                      });
+    note.WaitForNotification();
+    TF_RETURN_IF_ERROR(status);
+  }
+  return collective_util::ComputeBinOp(
+      col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+      col_params_->final_op, col_ctx_->output, &group_size_tensor);
+}
+
+void HierarchicalTreeReducer::DispatchSend(int subdiv, int dst_rank,
+                                           int src_rank,
+                                           const Tensor* src_tensor,
+                                           const StatusCallback& done) {
+  profiler::ScopedMemoryDebugAnnotation op_annotation(
+      col_params_->name.data(), col_ctx_->step_id, "dynamic",
+      src_tensor->dtype(),
+      [src_tensor]() { return src_tensor->shape().DebugString(); });
+  string send_buf_key =
+      ReduceBufKey(col_ctx_->exec_key, subdiv, src_rank, dst_rank);
+  int dst_idx =
+      col_params_->instance.impl_details.subdiv_permutations[subdiv][dst_rank];
+  VLOG(3) << "DispatchSend " << send_buf_key << " from_device "
+          << col_ctx_->device_name << " to_device "
+          << col_params_->group.members[dst_idx].device.name()
+          << " subdiv=" << subdiv << " dst_rank=" << dst_rank
+          << " dst_idx=" << dst_idx;
+  col_ctx_->col_exec->remote_access()->PostToPeer(
+      col_params_->group.members[dst_idx].device.name(),
+      col_params_->group.members[dst_idx].task, send_buf_key, col_ctx_->device,
+      col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), src_tensor,
+      col_ctx_->device_locality, col_ctx_->op_ctx->cancellation_manager(),
+      done);
+}
+
+void HierarchicalTreeReducer::DispatchRecv(int subdiv, int src_rank,
+                                           int dst_rank, Tensor* dst_tensor,
+                                           const StatusCallback& done) {
+  string recv_buf_key =
+      ReduceBufKey(col_ctx_->exec_key, subdiv, src_rank, dst_rank);
+  int src_idx =
+      col_params_->instance.impl_details.subdiv_permutations[subdiv][src_rank];
+  VLOG(3) << "DispatchRecv " << recv_buf_key << " from_device "
+          << col_params_->group.members[src_idx].device.name() << " to_device "
+          << col_ctx_->device_name << " subdiv=" << subdiv
+          << " src_rank=" << src_rank << " src_idx=" << src_idx;
+  col_ctx_->col_exec->remote_access()->RecvFromPeer(
+      col_params_->group.members[src_idx].device.name(),
+      col_params_->group.members[src_idx].task,
+      col_params_->group.members[src_idx].is_local, recv_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), dst_tensor,
+      col_ctx_->device_locality, 0 /*stream_index*/,
+      col_ctx_->op_ctx->cancellation_manager(), done);
+}
+
+namespace {
+REGISTER_COLLECTIVE(HierarchicalTreeReduce, HierarchicalTreeReducer);
+}  // namespace
+
+}  // namespace tensorflow
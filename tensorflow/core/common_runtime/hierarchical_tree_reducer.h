@@ -0,0 +1,105 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TREE_REDUCER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TREE_REDUCER_H_
+
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+
+namespace tensorflow {
+
+// Two-level implementation of collective all-reduce.
+//
+// A flat ring spanning tasks moves every device's data over the cross-task
+// links.  This implementation instead reduces within each task first, over
+// the fast local interconnect, so that each cross-task link carries exactly
+// one tensor per task: local devices reduce to a per-task leader, the leaders
+// exchange and reduce their partial results, and the final value is broadcast
+// back out through the leaders.
+class HierarchicalTreeReducer : public CollectiveImplementationInterface {
+ public:
+  HierarchicalTreeReducer();
+  ~HierarchicalTreeReducer() override = default;
+
+  // Establishes the subdiv permutations needed for a hierarchical reduce.
+  // If all devices are local, establishes a single subdiv comprising all
+  // devices.  If any devices are on a different task, establishes n+1 subdivs
+  // for n tasks.  The first subdiv comprises the leader (first) device of
+  // each task; subdiv i+1 comprises all devices of task i with the leader at
+  // rank 0.
+  Status InitializeCollectiveParams(CollectiveParams* col_params) override;
+
+  // Initializes members of CollectiveContext not yet initialized, i.e. device
+  // and device_locality.  Also saves the CollectiveContext in this object.
+  Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+  // Begins async execution of the hierarchical reduce.
+  // Must be called in a blockable thread.
+  // TODO(b/80529858): remove the previous warning when we have a dedicated
+  // collective threadpool.
+  void Run(StatusCallback done) override;
+
+ private:
+  // Sends `src_tensor` from this device to the device at `dst_rank` in
+  // `subdiv` and blocks until the peer has consumed it.
+  Status SendToRank(int subdiv, int dst_rank, int src_rank,
+                    const Tensor* src_tensor);
+
+  // Sends `src_tensor` to every device in `dst_ranks`, dispatching the sends
+  // concurrently and blocking until all have completed.
+  Status SendToRanks(int subdiv, const std::vector<int>& dst_ranks,
+                     int src_rank, const Tensor* src_tensor);
+
+  // Receives a tensor into `dst_tensor` at this device from the device at
+  // `src_rank` in `subdiv`, blocking until the transfer completes.
+  Status RecvFromRank(int subdiv, int src_rank, int dst_rank,
+                      Tensor* dst_tensor);
+
+  // Receives one tensor from each of ranks [1, num_ranks) of `subdiv` into a
+  // temporary buffer and merges it into the output with merge_op.
+  Status ReduceFromRanks(int subdiv, int num_ranks);
+
+  // Applies final_op (e.g. division by group size) to the fully reduced
+  // output.  Only called on the device holding the complete reduction.
+  Status ApplyFinalOp();
+
+  // Sends `src_tensor` asynchronously from this device to device at `dst_rank`
+  // in `subdiv`.  Calls `done` upon completion.
+  void DispatchSend(int subdiv, int dst_rank, int src_rank,
+                    const Tensor* src_tensor, const StatusCallback& done);
+
+  // Receives a tensor into the memory buffer owned by `dst_tensor` at this
+  // device from device at `src_rank` in `subdiv`.  Calls `done` upon
+  // completion.
+  void DispatchRecv(int subdiv, int src_rank, int dst_rank, Tensor* dst_tensor,
+                    const StatusCallback& done);
+
+  // Executes the hierarchical reduce defined by this op.
+  void RunTree();
+
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+  StatusCallback done_;
+  Status status_;
+
+  friend class HierarchicalTreeReducerTest;
+  friend class HierarchicalTreeReducerInitParamsTest;
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TREE_REDUCER_H_
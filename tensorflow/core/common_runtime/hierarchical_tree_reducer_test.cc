@@ -0,0 +1,317 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_tree_reducer.h"
+
+#include <algorithm>
+
+#include "absl/memory/memory.h"
+#include "tensorflow/core/common_runtime/collective_test_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/refcount.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+std::unique_ptr<OpKernel> GetKernel(const NodeDef& node,
+                                    const DeviceType& device_type,
+                                    DeviceBase* device) {
+  Status status;
+  std::unique_ptr<OpKernel> k = CreateOpKernel(
+      device_type, device, device->GetAllocator(AllocatorAttributes()), node,
+      TF_GRAPH_DEF_VERSION, &status);
+  if (!status.ok()) {
+    LOG(FATAL) << status;
+  }
+  return k;
+}
+
+std::unique_ptr<OpKernel> GetAdd(DataType dtype, const DeviceType& device_type,
+                                 DeviceBase* device) {
+  NodeDef node_def;
+  NodeDefBuilder builder("add_node", "Add");
+  TF_CHECK_OK(builder.Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  return GetKernel(node_def, device_type, device);
+}
+
+std::unique_ptr<OpKernel> GetDiv(DataType dtype, const DeviceType& device_type,
+                                 DeviceBase* device) {
+  NodeDef node_def;
+  NodeDefBuilder builder("div_node", "Div");
+  TF_CHECK_OK(builder.Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  return GetKernel(node_def, device_type, device);
+}
+
+}  // namespace
+
+class HierarchicalTreeReducerTest : public ::testing::Test {
+ protected:
+  void Init(int num_workers, int num_devices, DataType dtype,
+            const TensorShape& shape, const DeviceType& device_type,
+            int fail_after) {
+    test_env_ = CreateCollectiveTestEnv(num_workers, num_devices, device_type);
+    test_env_->remote_access->set_fail_after(fail_after);
+    for (int wi = 0; wi < num_workers; ++wi) {
+      for (int di = 0; di < num_devices; ++di) {
+        int rank = wi * num_devices + di;
+        instances_.push_back(absl::make_unique<DeviceInstance>(
+            rank, dtype, shape, test_env_.get()));
+      }
+    }
+  }
+
+  void Reduce(int fail_after) {
+    std::atomic<int> done(0);
+    for (auto& di : instances_) {
+      SchedClosure([&di, &done] {
+        di->DoReduce();
+        ++done;
+      });
+      if (fail_after > 0) {
+        // Stagger the op execution starts.
+        Env::Default()->SleepForMicroseconds(100);
+      }
+    }
+    while (done < static_cast<int>(instances_.size())) {
+      Env::Default()->SleepForMicroseconds(1000);
+    }
+  }
+
+  template <typename T>
+  void RunTest(DataType dtype, const DeviceType& device_type, int num_workers,
+               int num_devices, int tensor_len, int fail_after) {
+    Init(num_workers, num_devices, dtype, TensorShape({tensor_len}),
+         device_type, fail_after);
+    std::vector<T> expected(tensor_len);
+    for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+      instances_[di]->InitTensor([&expected, dtype, di](Tensor* t) {
+        for (size_t i = 0; i < t->NumElements(); ++i) {
+          // The cast is necessary to prevent clang-tidy from insisting
+          // that a faster non-open source function be substituted.
+          float value = pow(10, static_cast<double>(di)) * i;
+          if (dtype == DT_INT32 || dtype == DT_INT64) {
+            value = di * 10 + i;
+          }
+          t->flat<T>()(i) = static_cast<T>(value);
+          expected[i] += static_cast<T>(value);
+        }
+      });
+    }
+    Reduce(fail_after);
+    if (fail_after > 0) {
+      // Confirm that at least one device terminated with the expected error
+      // status; devices that had already completed their part of the exchange
+      // may have succeeded.
+      int failure_count = 0;
+      for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+        if (instances_[di]->status_.error_message().find(
+                "Deliberate failure") != string::npos) {
+          ++failure_count;
+        }
+      }
+      EXPECT_GT(failure_count, 0);
+    } else {
+      // Confirm that every device computed the same correct reduction value.
+      for (int i = 0; i < tensor_len; ++i) {
+        expected[i] /= static_cast<T>(num_workers * num_devices);
+      }
+      for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+        TF_EXPECT_OK(instances_[di]->status_);
+        test::ExpectTensorEqual<T>(test::AsTensor<T>(expected),
+                                   instances_[di]->tensor());
+      }
+    }
+  }
+
+  class DeviceInstance {
+   public:
+    DeviceInstance(int rank, DataType dtype, const TensorShape& shape,
+                   CollectiveTestEnv* test_env)
+        : test_env_(test_env), tensor_(dtype, shape) {
+      col_params_ =
+          CreateCollectiveParams(*test_env_, rank, "HierarchicalTreeReduce",
+                                 REDUCTION_COLLECTIVE, dtype, shape);
+      string dev_name = col_params_->group.members[rank].device.name();
+      TF_CHECK_OK(test_env_->device_mgr->LookupDevice(dev_name, &device_))
+          << "Couldn't find device " << dev_name
+          << " existing devices: " << test_env_->device_mgr->DebugString();
+      merge_op_ = GetAdd(col_params_->instance.data_type,
+                         test_env_->device_type, device_);
+      final_op_ = GetDiv(col_params_->instance.data_type,
+                         test_env_->device_type, device_);
+      col_params_->merge_op = merge_op_.get();
+      col_params_->final_op = final_op_.get();
+    }
+
+    void InitTensor(const std::function<void(Tensor*)>& init_f) {
+      init_f(&tensor_);
+    }
+
+    void DoReduce() {
+      status_ = RunCollective(test_env_, col_params_.get(), device_, &tensor_,
+                              &tensor_);
+    }
+
+    const Tensor& tensor() { return tensor_; }
+
+    CollectiveTestEnv* test_env_;
+    Tensor tensor_;
+    Device* device_;
+    core::RefCountPtr<CollectiveParams> col_params_;
+    std::unique_ptr<OpKernel> merge_op_;
+    std::unique_ptr<OpKernel> final_op_;
+    Status status_;
+  };
+
+  std::unique_ptr<CollectiveTestEnv> test_env_;
+  std::vector<std::unique_ptr<DeviceInstance>> instances_;
+};
+
+TEST_F(HierarchicalTreeReducerTest, CpuFloat1Worker2Devices) {
+  RunTest<float>(DT_FLOAT, DEVICE_CPU, /*num_workers=*/1, /*num_devices=*/2,
+                 /*tensor_len=*/16, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuFloat1Worker8Devices) {
+  RunTest<float>(DT_FLOAT, DEVICE_CPU, /*num_workers=*/1, /*num_devices=*/8,
+                 /*tensor_len=*/1001, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuFloat2Workers1Device) {
+  RunTest<float>(DT_FLOAT, DEVICE_CPU, /*num_workers=*/2, /*num_devices=*/1,
+                 /*tensor_len=*/16, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuFloat2Workers4Devices) {
+  RunTest<float>(DT_FLOAT, DEVICE_CPU, /*num_workers=*/2, /*num_devices=*/4,
+                 /*tensor_len=*/128, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuFloat4Workers2Devices) {
+  RunTest<float>(DT_FLOAT, DEVICE_CPU, /*num_workers=*/4, /*num_devices=*/2,
+                 /*tensor_len=*/1001, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuDouble2Workers2Devices) {
+  RunTest<double>(DT_DOUBLE, DEVICE_CPU, /*num_workers=*/2, /*num_devices=*/2,
+                  /*tensor_len=*/128, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuInt322Workers2Devices) {
+  RunTest<int32>(DT_INT32, DEVICE_CPU, /*num_workers=*/2, /*num_devices=*/2,
+                 /*tensor_len=*/128, /*fail_after=*/0);
+}
+
+TEST_F(HierarchicalTreeReducerTest, CpuFloat2Workers4DevicesFail) {
+  RunTest<float>(DT_FLOAT, DEVICE_CPU, /*num_workers=*/2, /*num_devices=*/4,
+                 /*tensor_len=*/128, /*fail_after=*/1);
+}
+
+class HierarchicalTreeReducerInitParamsTest : public ::testing::Test {
+ protected:
+  void RunSubdivPermsTest(
+      CollectiveParams* cp,
+      const std::vector<std::vector<int>>& expected_subdiv_perms,
+      const std::vector<int>& expected_subdiv_rank) {
+    cp->instance.impl_details.subdiv_permutations.clear();
+    cp->subdiv_rank.clear();
+    cp->instance.impl_details.subdiv_source_rank.clear();
+    // Create a stub reducer only for testing param initialization.
+    HierarchicalTreeReducer* reducer = new HierarchicalTreeReducer;
+    core::ScopedUnref unref(reducer);
+    TF_CHECK_OK(reducer->InitializeCollectiveParams(cp));
+    EXPECT_EQ(expected_subdiv_perms,
+              cp->instance.impl_details.subdiv_permutations);
+    EXPECT_EQ(expected_subdiv_rank, cp->subdiv_rank);
+  }
+};
+
+TEST_F(HierarchicalTreeReducerInitParamsTest, InitializeParams1Task8Device) {
+  const int kNumDevsPerWorker = 8;
+  const int kNumWorkers = 1;
+  auto test_env =
+      CreateCollectiveTestEnv(kNumWorkers, kNumDevsPerWorker, DEVICE_CPU);
+  auto cp =
+      CreateCollectiveParams(*test_env, /*rank=*/0, "HierarchicalTreeReduce",
+                             REDUCTION_COLLECTIVE, DT_FLOAT, TensorShape({1}));
+
+  cp->default_rank = 0;
+  RunSubdivPermsTest(cp.get(), {{0, 1, 2, 3, 4, 5, 6, 7}}, {0});
+
+  cp->default_rank = 3;
+  RunSubdivPermsTest(cp.get(), {{0, 1, 2, 3, 4, 5, 6, 7}}, {3});
+}
+
+TEST_F(HierarchicalTreeReducerInitParamsTest, InitializeParams4Tasks8Device) {
+  const int kNumDevsPerWorker = 8;
+  const int kNumWorkers = 4;
+  auto test_env =
+      CreateCollectiveTestEnv(kNumWorkers, kNumDevsPerWorker, DEVICE_CPU);
+  auto cp =
+      CreateCollectiveParams(*test_env, /*rank=*/0, "HierarchicalTreeReduce",
+                             REDUCTION_COLLECTIVE, DT_FLOAT, TensorShape({1}));
+
+  // The leader (first) device of each task participates in the inter-task
+  // subdiv.
+  cp->default_rank = 0;
+  RunSubdivPermsTest(cp.get(),
+                     {{0, 8, 16, 24},
+                      {0, 1, 2, 3, 4, 5, 6, 7},
+                      {8, 9, 10, 11, 12, 13, 14, 15},
+                      {16, 17, 18, 19, 20, 21, 22, 23},
+                      {24, 25, 26, 27, 28, 29, 30, 31}},
+                     {0, 0, -1, -1, -1});
+
+  // A non-leader device gets rank -1 in the inter-task subdiv.
+  cp->default_rank = 13;
+  RunSubdivPermsTest(cp.get(),
+                     {{0, 8, 16, 24},
+                      {0, 1, 2, 3, 4, 5, 6, 7},
+                      {8, 9, 10, 11, 12, 13, 14, 15},
+                      {16, 17, 18, 19, 20, 21, 22, 23},
+                      {24, 25, 26, 27, 28, 29, 30, 31}},
+                     {-1, -1, 5, -1, -1});
+
+  // The leader of a task other than task 0 gets that task's index as its
+  // inter-task rank.
+  cp->default_rank = 16;
+  RunSubdivPermsTest(cp.get(),
+                     {{0, 8, 16, 24},
+                      {0, 1, 2, 3, 4, 5, 6, 7},
+                      {8, 9, 10, 11, 12, 13, 14, 15},
+                      {16, 17, 18, 19, 20, 21, 22, 23},
+                      {24, 25, 26, 27, 28, 29, 30, 31}},
+                     {2, -1, -1, 0, -1});
+}
+
+}  // namespace tensorflow
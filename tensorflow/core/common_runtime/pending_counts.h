@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/util/port.h"
 
 namespace tensorflow {
@@ -80,24 +81,25 @@ class PendingCounts {
 
   // Create a new PendingCounts object that can hold the state of
   // all the Handles allocated from "final_allocator".
+  //
+  // The backing storage is cache-line aligned so that the cache-line
+  // relative placement chosen by the Layout (see CreateHandle) is
+  // preserved at runtime.
   explicit PendingCounts(Layout layout)
-      : num_bytes_(layout.next_offset_), bytes_(new char[num_bytes_]) {
-    if (num_bytes_ >= sizeof(LargeCounts)) {
-      CHECK_EQ(uintptr_t(bytes_) % alignof(LargeCounts), 0);
-    }
-  }
+      : num_bytes_(layout.next_offset_),
+        bytes_(static_cast<char*>(
+            port::AlignedMalloc(num_bytes_, kCacheLineBytes))) {}
 
   // Create a new PendingCounts object with the same layout and counts
   // as "other".
   explicit PendingCounts(const PendingCounts& other)
-      : num_bytes_(other.num_bytes_), bytes_(new char[num_bytes_]) {
-    if (num_bytes_ >= sizeof(LargeCounts)) {
-      CHECK_EQ(uintptr_t(bytes_) % alignof(LargeCounts), 0);
-    }
+      : num_bytes_(other.num_bytes_),
+        bytes_(static_cast<char*>(
+            port::AlignedMalloc(num_bytes_, kCacheLineBytes))) {
     memcpy(bytes_, other.bytes_, other.num_bytes_);
   }
 
-  ~PendingCounts() { delete[] bytes_; }
+  ~PendingCounts() { port::AlignedFree(bytes_); }
 
   void set_initial_count(Handle h, size_t pending_count) {
     if (h.is_large_) {
@@ -274,6 +276,35 @@ class PendingCounts {
     }
   }
 
+  // Batched equivalent of calling adjust_for_activation() once per edge for
+  // "num_edges" edges into the node corresponding to "h", of which "num_dead"
+  // carry a dead input. Performs a single read-modify-write on the counters,
+  // so a source node with several edges into the same destination pays for
+  // one counter update instead of one per edge.
+  AdjustResult adjust_for_activation_many(Handle h, int num_dead,
+                                          int num_edges) {
+    DCHECK_GE(pending(h), num_edges);
+    if (h.is_large_) {
+      return adjust_for_activation_shared_many(Large(h), num_dead, num_edges);
+    } else {
+      return adjust_for_activation_shared_many(Packed(h), num_dead, num_edges);
+    }
+  }
+
+  // The same as the above, but performs the operation atomically. This
+  // is thread-safe to run concurrently with other threads.
+  AdjustResult adjust_for_activation_many_atomic(Handle h, int num_dead,
+                                                 int num_edges) {
+    DCHECK_GE(pending(h), num_edges);
+    if (h.is_large_) {
+      return adjust_for_activation_shared_many_atomic(Large(h), num_dead,
+                                                      num_edges);
+    } else {
+      return adjust_for_activation_shared_many_atomic(Packed(h), num_dead,
+                                                      num_edges);
+    }
+  }
+
   class Handle {
    public:
     Handle() : byte_offset_(0), is_large_(0) {}
@@ -313,6 +344,39 @@ class PendingCounts {
     }
   }
 
+  // The batched adjustments are equivalent to their per-edge counterparts
+  // because the pending count cannot reach zero before the last of the
+  // "num_edges" decrements: the initial pending count includes every edge
+  // from the completing source node.
+  template <typename T>
+  inline AdjustResult adjust_for_activation_shared_many(std::atomic<T>* c,
+                                                        int num_dead,
+                                                        int num_edges) {
+    T val = c->load(std::memory_order_relaxed);
+    if (num_dead > 0 && PENDING_NOTREADY == NodeStateForStruct(val)) {
+      val.dead_count += num_dead;
+    }
+    val.pending -= num_edges;
+    c->store(val, std::memory_order_relaxed);
+    return AdjustResult(val.dead_count, val.pending);
+  }
+
+  template <typename T>
+  inline AdjustResult adjust_for_activation_shared_many_atomic(
+      std::atomic<T>* c, int num_dead, int num_edges) {
+    T old_val = c->load(std::memory_order_relaxed);
+    while (true) {
+      T new_val = old_val;
+      if (num_dead > 0 && PENDING_NOTREADY == NodeStateForStruct(new_val)) {
+        new_val.dead_count += num_dead;
+      }
+      new_val.pending -= num_edges;
+      AdjustResult ret(new_val.dead_count, new_val.pending);
+      if (TF_PREDICT_TRUE(c->compare_exchange_weak(old_val, new_val)))
+        return ret;
+    }
+  }
+
   // We keep track of the pending count and dead input count for each
   // graph node.  The representation used here is designed to be cache
   // efficient for graphs with large numbers of nodes, where most
@@ -326,6 +390,14 @@ class PendingCounts {
   // We use 3 bits each for dead_count and pending.
   static constexpr int kMaxCountForPackedCounts = 7;
 
+  // Nodes whose counts do not fit in PackedCounts are exactly the high
+  // fan-in nodes, and their counters are the ones that are concurrently
+  // updated when several source nodes complete at once. Each such node is
+  // given its own cache line so that those updates do not falsely share a
+  // line with neighboring nodes. Large counts are rare (see the note above),
+  // so the memory overhead is negligible.
+  static constexpr int kCacheLineBytes = 64;
+
   // Most counts are small, so we pack a pending count and a dead
   // count into 3 bits each, use 1 bit to indicate that the node has
   // started computing.
@@ -377,11 +449,12 @@ inline PendingCounts::Handle PendingCounts::Layout::CreateHandle(
   Handle result;
   if ((max_pending_count > kMaxCountForPackedCounts) ||
       (max_dead_count > kMaxCountForPackedCounts)) {
-    constexpr int B = sizeof(std::atomic<LargeCounts>);
-    // Round byte offset to proper alignment
-    static_assert(
-        sizeof(std::atomic<LargeCounts>) >= alignof(std::atomic<LargeCounts>),
-        "std::atomic<LargeCounts> must be packed");
+    constexpr int B = kCacheLineBytes;
+    static_assert(kCacheLineBytes >= sizeof(std::atomic<LargeCounts>) &&
+                      kCacheLineBytes % alignof(std::atomic<LargeCounts>) == 0,
+                  "LargeCounts must fit in an aligned cache line");
+    // Place each LargeCounts on its own cache line; see the comment on
+    // kCacheLineBytes.
     int64_t offset = ((static_cast<int64_t>(next_offset_) + B - 1) / B) * B;
     result.byte_offset_ = offset;
     result.is_large_ = true;
@@ -170,6 +170,42 @@ TEST(PendingCounts, AdjustForActivation) {
   }
 }
 
+TEST(PendingCounts, AdjustForActivationMany) {
+  PendingCounts::Layout layout;
+  PendingCounts::Handle handles[2];
+  handles[0] = layout.CreateHandle(6, 4);
+  handles[1] = layout.CreateHandle(15, 4);
+  for (int id = 0; id < 2; id++) {
+    PendingCounts::Handle h = handles[id];
+    // Test for both packed and large.
+    int count = (id == 0) ? 6 : 15;
+
+    PendingCounts c(layout);
+    c.set_initial_count(h, count);
+    EXPECT_EQ(c.pending(h), count);
+
+    // Three edges, none of them dead.
+    PendingCounts::AdjustResult result =
+        c.adjust_for_activation_many(h, /*num_dead=*/0, /*num_edges=*/3);
+    EXPECT_EQ(c.pending(h), count - 3);
+    EXPECT_TRUE(result.any_pending);
+    EXPECT_EQ(c.dead_count(h), 0);
+    EXPECT_FALSE(result.any_dead);
+
+    // Two edges, both dead.
+    result = c.adjust_for_activation_many(h, /*num_dead=*/2, /*num_edges=*/2);
+    EXPECT_EQ(c.pending(h), count - 5);
+    EXPECT_EQ(c.dead_count(h), 2);
+    EXPECT_TRUE(result.any_dead);
+
+    // Equivalent atomic variant for the remaining edges.
+    result =
+        c.adjust_for_activation_many_atomic(h, /*num_dead=*/0, count - 5);
+    EXPECT_EQ(c.pending(h), 0);
+    EXPECT_FALSE(result.any_pending);
+  }
+}
+
 TEST(PendingCounts, AdjustForActivationAtomic) {
   PendingCounts::Layout layout;
   PendingCounts::Handle handles[2];
@@ -1146,6 +1146,33 @@ Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
   }
   TF_RETURN_IF_ERROR(group.as_summary_status());
 
+  // Select the single-device fast path at instantiation time: a function with
+  // exactly one component placed on a local device, identity arg/ret mappings
+  // and no nodes that could touch the step rendezvous can be dispatched
+  // straight to the component's FunctionLibraryRuntime at Run() time. The
+  // async_attributes summary is only meaningful when small function
+  // optimizations were requested, since it is not computed otherwise.
+  if (options.allow_small_function_optimizations && data->glue_.size() == 1 &&
+      !data->is_cross_process_) {
+    const auto& pair = *data->glue_.begin();
+    const ComponentFunctionData& comp_data = pair.second;
+    bool identity_mapping = comp_data.ret_indices.size() == data->num_outputs_;
+    for (int i = 0; i < comp_data.arg_indices.size(); ++i) {
+      if (comp_data.arg_indices[i].index != i ||
+          comp_data.arg_indices[i].sub_index >= 0) {
+        identity_mapping = false;
+      }
+    }
+    for (int i = 0; i < comp_data.ret_indices.size(); ++i) {
+      if (comp_data.ret_indices[i] != i) {
+        identity_mapping = false;
+      }
+    }
+    data->enable_single_device_run =
+        identity_mapping && GetFLR(pair.first) != nullptr &&
+        comp_data.async_attributes.summary() == AsyncAttributes::kSafeForSync;
+  }
+
   *handle = AddMultiDeviceHandle(std::move(data), function_key);
   VLOG(2) << "Instantiated MultiDevice function \"" << function_name
           << "\" with handle " << *handle;
@@ -1711,11 +1738,56 @@ Status ProcessFunctionLibraryRuntime::GetComponentArgs(
 }
 #endif  // IS_MOBILE_PLATFORM
 
+FunctionLibraryRuntime* ProcessFunctionLibraryRuntime::PrepareSingleDeviceRun(
+    const MultiDeviceFunctionData& data, FunctionLibraryRuntime::Options* opts,
+    FunctionLibraryRuntime::Handle* component_handle) const {
+  const auto& pair = *data.glue_.begin();
+  const ComponentFunctionData& comp_data = pair.second;
+  FunctionLibraryRuntime* flr = GetFLR(pair.first);
+  if (flr == nullptr) {
+    return nullptr;
+  }
+
+  opts->args_alloc_attrs = comp_data.arg_alloc_attrs;
+  opts->rets_alloc_attrs = comp_data.ret_alloc_attrs;
+  opts->remote_execution = false;
+  // When target device has private thread pool, use the target device runner.
+  thread::ThreadPool* pool = flr->device()->tensorflow_device_thread_pool();
+  if (pool != nullptr) {
+    opts->runner = flr->runner();
+  }
+  *component_handle = comp_data.handle;
+  return flr;
+}
+
 void ProcessFunctionLibraryRuntime::Run(
     const FunctionLibraryRuntime::Options& opts,
     FunctionLibraryRuntime::Handle handle, gtl::ArraySlice<Tensor> args,
     std::vector<Tensor>* rets,
     FunctionLibraryRuntime::DoneCallback done) const {
+  const MultiDeviceFunctionData* multi_device_data = IsMultiDevice(handle);
+  // Single local component with identity mappings: invoke the component
+  // function directly with the caller's arg span and ret vector, with no
+  // rendezvous, cleanup items or FunctionRet marshalling. The arg count check
+  // guards against a component whose pruned signature no longer matches the
+  // caller's.
+  if (multi_device_data != nullptr &&
+      multi_device_data->enable_single_device_run &&
+      args.size() ==
+          multi_device_data->glue_.begin()->second.arg_indices.size()) {
+    FunctionLibraryRuntime::Options opts_copy = opts;
+    FunctionLibraryRuntime::Handle component_handle;
+    FunctionLibraryRuntime* flr = PrepareSingleDeviceRun(
+        *multi_device_data, &opts_copy, &component_handle);
+    if (flr != nullptr) {
+      VLOG(1) << "Running single-device function "
+              << multi_device_data->function_name_ << " with component handle "
+              << component_handle;
+      flr->Run(opts_copy, component_handle, args, rets, std::move(done));
+      return;
+    }
+  }
+
   FunctionLibraryRuntime::Options new_opts = opts;
   Rendezvous* created_rendezvous = nullptr;
   if (!opts.rendezvous) {
@@ -1738,7 +1810,7 @@ void ProcessFunctionLibraryRuntime::Run(
     delete function_rets;
     done(status);
   };
-  bool multi_device = HasMultiDeviceHandle(handle);
+  bool multi_device = multi_device_data != nullptr;
   if (multi_device) {
     auto get_component_args = [&args](const ComponentFunctionData& comp_data,
                                       InternalArgs* comp_args) -> Status {
@@ -1901,6 +1973,18 @@ Status ProcessFunctionLibraryRuntime::RunSync(
     FunctionLibraryRuntime::Handle handle, gtl::ArraySlice<Tensor> args,
     std::vector<Tensor>* rets) const {
   MultiDeviceFunctionData* multi_device_data = IsMultiDevice(handle);
+  if (multi_device_data && multi_device_data->enable_single_device_run &&
+      args.size() ==
+          multi_device_data->glue_.begin()->second.arg_indices.size()) {
+    FunctionLibraryRuntime::Options new_opts = orig_opts;
+    FunctionLibraryRuntime::Handle component_handle;
+    FunctionLibraryRuntime* flr = PrepareSingleDeviceRun(
+        *multi_device_data, &new_opts, &component_handle);
+    if (flr != nullptr) {
+      metrics::IncrementTestCounter("pflr_runsync", "single_device");
+      return flr->RunSync(new_opts, component_handle, args, rets);
+    }
+  }
   if (multi_device_data && multi_device_data->enable_sync_execution) {
     metrics::IncrementTestCounter("pflr_runsync", "sync");
     FunctionLibraryRuntime::Options new_opts = orig_opts;
@@ -327,6 +327,13 @@ class ProcessFunctionLibraryRuntime {
     //  Indicates if running this function synchronously is both allowed + safe.
     bool enable_sync_execution;
 
+    // Indicates that the function consists of exactly one component placed on
+    // a local device, with identity arg/ret mappings and no nodes that touch
+    // the step rendezvous. Such handles skip the multi-device fan-out and are
+    // dispatched straight to the component's FunctionLibraryRuntime; see
+    // PrepareSingleDeviceRun.
+    bool enable_single_device_run = false;
+
     // Maps the device name to the information about the component function
     // be run on this device.
     std::unordered_map<string, ComponentFunctionData> glue_;
@@ -445,6 +452,16 @@ class ProcessFunctionLibraryRuntime {
                            InternalArgs* args)>
           get_component_args) const;
 
+  // Prepares a direct invocation of the lone local component function of
+  // `data`, which must have been instantiated with enable_single_device_run:
+  // looks up the component's FunctionLibraryRuntime and rewrites `opts` the
+  // same way the multi-device fan-out would, without creating a rendezvous or
+  // cleanup state. Returns the runtime to invoke and fills in the component's
+  // handle, or returns nullptr if the component's device has no local runtime.
+  FunctionLibraryRuntime* PrepareSingleDeviceRun(
+      const MultiDeviceFunctionData& data, FunctionLibraryRuntime::Options* opts,
+      FunctionLibraryRuntime::Handle* component_handle) const;
+
   void RunMultiDeviceAsync(
       const FunctionLibraryRuntime::Options& opts,
       FunctionLibraryRuntime::Handle handle, std::vector<FunctionRet>* rets,
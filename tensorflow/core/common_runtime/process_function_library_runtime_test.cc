@@ -1297,6 +1297,19 @@ TEST_F(ProcessFunctionLibraryRuntimeTest, SimpleGraphAllowsSync) {
   EXPECT_GT(async_safe.Get(), 0);
 }
 
+TEST_F(ProcessFunctionLibraryRuntimeTest, SingleDeviceFastPath) {
+  Init({test::function::XTimesTwo()});
+  FunctionLibraryRuntime::InstantiateOptions inst_opts =
+      MakeOptions("CPU:0", {"CPU:0"}, {"CPU:0"});
+  inst_opts.allow_small_function_optimizations = true;
+  FunctionLibraryRuntime::Options opts;
+  auto x = test::AsTensor<float>({1, 2, 3, 4});
+  Tensor y;
+  TF_CHECK_OK(
+      Run("XTimesTwo", opts, {{"T", DT_FLOAT}}, inst_opts, {x}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6, 8}));
+}
+
 TEST_F(ProcessFunctionLibraryRuntimeTest, UnsafeOpRequiresAsync) {
   auto async_safe =
       metrics::TestDelta("subgraph_async_summary", "safe_for_sync");
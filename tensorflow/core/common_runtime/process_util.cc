@@ -26,6 +26,8 @@ limitations under the License.
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/numa.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/tracing.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/util.h"
@@ -157,8 +159,27 @@ thread::ThreadPool* NewThreadPoolFromSessionOptions(
     const SessionOptions& options) {
   const int32_t num_threads = NumInterOpThreadsFromSessionOptions(options);
   VLOG(1) << "Session inter op parallelism threads: " << num_threads;
+  ThreadOptions thread_opts;
+  string name = "Compute";
+  const int32_t session_numa_node =
+      options.config.experimental().session_numa_node();
+  if (session_numa_node > 0) {
+    const int numa_node = session_numa_node - 1;
+    if (port::NUMAEnabled() && numa_node < port::NUMANumNodes()) {
+      // Pin the pool to the requested node so that the session's executors,
+      // and the first-touch pages they allocate, stay on that node.
+      thread_opts.numa_node = numa_node;
+      name = strings::StrCat("Compute_numa", numa_node);
+      VLOG(1) << "Pinning session inter op threadpool to NUMA node "
+              << numa_node;
+    } else {
+      LOG(WARNING) << "session_numa_node was set to " << session_numa_node
+                   << " but NUMA node " << numa_node
+                   << " is unavailable; creating an unpinned threadpool.";
+    }
+  }
   return new thread::ThreadPool(
-      options.env, ThreadOptions(), "Compute", num_threads,
+      options.env, thread_opts, name, num_threads,
       !options.config.experimental().disable_thread_spinning(),
       /*allocator=*/nullptr);
 }
@@ -411,25 +411,39 @@ int PropagatorState::FrameState::ActivateNodesFastPathInternal(
   } while (0);
 
   Entry* input_tensors = iter_state->input_tensors;
-  for (const EdgeInfo& e : item->output_edges()) {
-    const int dst_id = e.dst_id;
+  const gtl::ArraySlice<EdgeInfo> out_edges = item->output_edges();
+  const size_t num_out_edges = out_edges.size();
+  for (size_t i = 0; i < num_out_edges;) {
+    const int dst_id = out_edges[i].dst_id;
     const PendingCounts::Handle dst_pending_id =
         immutable_state.pending_ids()[dst_id];
-    const int src_slot = e.output_slot;
 
-    const bool increment_dead =
-        (is_dead || ((*outputs)[src_slot].state == Entry::State::NO_VALUE));
-    const int dst_loc = e.input_slot;
-    if (e.is_last) {
-      input_tensors[dst_loc] = std::move((*outputs)[src_slot]);
-    } else {
-      input_tensors[dst_loc] = (*outputs)[src_slot];
-    }
+    // Consecutive edges into the same destination (a multi-output node
+    // feeding several inputs of one consumer) are folded into a single
+    // batched counter adjustment.
+    int num_edges = 0;
+    int num_dead = 0;
+    do {
+      const EdgeInfo& e = out_edges[i];
+      const int src_slot = e.output_slot;
+      if (is_dead || ((*outputs)[src_slot].state == Entry::State::NO_VALUE)) {
+        num_dead++;
+      }
+      const int dst_loc = e.input_slot;
+      if (e.is_last) {
+        input_tensors[dst_loc] = std::move((*outputs)[src_slot]);
+      } else {
+        input_tensors[dst_loc] = (*outputs)[src_slot];
+      }
+      num_edges++;
+      i++;
+    } while (i < num_out_edges && out_edges[i].dst_id == dst_id);
+
     const PendingCounts::AdjustResult adjust_result =
-        atomic
-            ? iter_state->adjust_for_activation_atomic(dst_pending_id,
-                                                       increment_dead)
-            : iter_state->adjust_for_activation(dst_pending_id, increment_dead);
+        atomic ? iter_state->adjust_for_activation_many_atomic(
+                     dst_pending_id, num_dead, num_edges)
+               : iter_state->adjust_for_activation_many(dst_pending_id,
+                                                        num_dead, num_edges);
     MAYBE_ADD_TO_READY(dst_id, adjust_result);
   }
 
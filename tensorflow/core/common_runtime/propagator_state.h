@@ -177,6 +177,14 @@ class PropagatorState {
         PendingCounts::Handle h, bool increment_dead) {
       return counts.adjust_for_activation_atomic(h, increment_dead);
     }
+    PendingCounts::AdjustResult adjust_for_activation_many(
+        PendingCounts::Handle h, int num_dead, int num_edges) {
+      return counts.adjust_for_activation_many(h, num_dead, num_edges);
+    }
+    PendingCounts::AdjustResult adjust_for_activation_many_atomic(
+        PendingCounts::Handle h, int num_dead, int num_edges) {
+      return counts.adjust_for_activation_many_atomic(h, num_dead, num_edges);
+    }
 
     ~IterationState() { delete[] input_tensors; }
 
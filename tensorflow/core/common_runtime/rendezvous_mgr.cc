@@ -132,6 +132,22 @@ void IntraProcessRecvAsyncImpl(const DeviceMgr* device_mgr,
           const Status& status, const Rendezvous::Args& send_args,
           const Rendezvous::Args& recv_args, const Tensor& in,
           bool is_dead) mutable {
+        if (status.ok() && in.IsInitialized()) {
+          // Same-host fast path: when both endpoints are in host memory the
+          // buffer is handed to the receiver directly.  The sender's queued
+          // reference is dropped as soon as this callback returns, so
+          // ownership effectively moves to the receiver with no copy, no
+          // heap-allocated trampoline and no trip through CopyTensor.
+          const bool src_host =
+              (send_args.alloc_attrs.on_host() || parsed.src.type == "CPU");
+          const bool dst_host =
+              (recv_args.alloc_attrs.on_host() || parsed.dst.type == "CPU");
+          if (src_host && dst_host) {
+            done(status, send_args, recv_args, in, is_dead);
+            return;
+          }
+        }
+
         // If "in" is an uninitialized tensor, do copy-construction to
         // preserve the uninitialized state, along with data type and shape
         // info, which is useful for debugger purposes.
@@ -39,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 // Set true for greater intelligibility of debug mode log messages.
 #define READABLE_KEYS false
@@ -46,7 +47,9 @@ limitations under the License.
 // depends on the number of subdivisions specified in the algorithm.  If the
 // user does not specify the number of subdivisions we may infer the number
 // dynamically so that the resulting chunk size does not exceed
-// kMaxChunkSizeBytes, empirically set at 4 MiB.
+// kMaxChunkSizeBytes, empirically set at 4 MiB.  The default can be overridden
+// with the TF_COLLECTIVE_MAX_CHUNK_BYTES environment variable; smaller chunks
+// deepen the ring pipeline at the cost of more per-chunk overhead.
 constexpr size_t kMaxChunkSizeBytes = (4 * 1024 * 1024);
 // kMaxSubdivsPerDeviceDefault is used to give an upper bound on the number of
 // subdivisions dynamically generated when user does not provide the parameter
@@ -137,6 +140,12 @@ Status GenerateSubdivsInCollectiveParams(CollectiveParams* col_params) {
   // as many offsets as needed so that the size of tensor chunks <=
   // kMaxChunkSizeBytes.  Empirically, chunks that are too small or too large
   // lead to worse performance.
+  static const size_t max_chunk_size_bytes = []() {
+    int64_t b;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_COLLECTIVE_MAX_CHUNK_BYTES",
+                                    kMaxChunkSizeBytes, &b));
+    return b > 0 ? static_cast<size_t>(b) : kMaxChunkSizeBytes;
+  }();
   int num_subdivs = 0;
   const size_t tensor_size = col_params->instance.shape.num_elements() *
                              DataTypeSize(col_params->instance.data_type);
@@ -147,7 +156,7 @@ Status GenerateSubdivsInCollectiveParams(CollectiveParams* col_params) {
     chunk_size = tensor_size / num_chunks;
     VLOG(2) << "num_subdivs " << num_subdivs << " num_chunks " << num_chunks
             << " chunk_size " << chunk_size;
-  } while (chunk_size > kMaxChunkSizeBytes && num_subdivs < kMaxNumSubdivs);
+  } while (chunk_size > max_chunk_size_bytes && num_subdivs < kMaxNumSubdivs);
   if (num_subdivs <= 0) {
     return errors::Internal("Unexpected num_subdivs ", num_subdivs, " in ",
                             col_params->instance.impl_details.collective_name);
@@ -40,8 +40,25 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
+namespace {
+
+// When enabled, the reduction of a received chunk runs on the collective
+// executor's threadpool instead of the orchestration thread, so that chunk k
+// is reduced while transfers for chunk k+1 are being dispatched.
+bool AsyncReductionEnabled() {
+  static const bool enabled = []() {
+    bool b;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_RING_REDUCE_ASYNC_REDUCTION",
+                                   /*default_val=*/true, &b));
+    return b;
+  }();
+  return enabled;
+}
+
+}  // namespace
 
 RingReducer::~RingReducer() { group_size_tensor_ready_.WaitForNotification(); }
 
@@ -212,6 +229,7 @@ bool RingReducer::RunAsyncParts() {
   int field_done_count = 0;
   int send_pending_count = 0;
   int recv_pending_count = 0;
+  int reduce_pending_count = 0;
   std::atomic<bool> aborted(false);
 
   {
@@ -254,18 +272,43 @@ bool RingReducer::RunAsyncParts() {
             --recv_pending_count;
             if (!rf->second_pass) {
               rf->action = RF_REDUCE;
-              Status s = collective_util::ComputeBinOp(
-                  col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
-                  col_params_->merge_op, &rf->chunk, &rf->tmp_chunk);
-              if (!s.ok()) {
-                aborted = true;
-                StartAbort(s);
+              if (AsyncReductionEnabled()) {
+                // Run the reduction on the collective executor's threadpool
+                // so this thread can keep dispatching transfers for other
+                // chunks while the math runs.  ComputeBinOp builds a private
+                // SubContext per call, so concurrent reductions of distinct
+                // chunks are safe.
+                auto reduce_complete = [this, rf, &ready_queue, &aborted]() {
+                  Status s = collective_util::ComputeBinOp(
+                      col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+                      col_params_->merge_op, &rf->chunk, &rf->tmp_chunk);
+                  if (!s.ok()) {
+                    aborted = true;
+                    StartAbort(s);
+                  }
+                  ready_queue.Enqueue(rf);
+                };
+                col_ctx_->col_exec->RunClosure(std::move(reduce_complete));
+                dispatched = true;
+                ++reduce_pending_count;
+              } else {
+                Status s = collective_util::ComputeBinOp(
+                    col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+                    col_params_->merge_op, &rf->chunk, &rf->tmp_chunk);
+                if (!s.ok()) {
+                  aborted = true;
+                  StartAbort(s);
+                }
               }
             } else {
               rf->action = RF_SEND_READY;
             }
             break;
           case RF_REDUCE:
+            if (AsyncReductionEnabled()) {
+              CHECK_GT(reduce_pending_count, 0);
+              --reduce_pending_count;
+            }
             if (!rf->second_pass && col_params_->final_op && rf->is_final) {
               rf->action = RF_FINALIZE;
               group_size_tensor_ready_.WaitForNotification();
@@ -324,12 +367,18 @@ bool RingReducer::RunAsyncParts() {
     if (aborted) {
       // All of the pending data actions should be aborted; field the
       // callbacks and clear the queue before quitting.
-      while ((send_pending_count > 0) || (recv_pending_count > 0)) {
+      while ((send_pending_count > 0) || (recv_pending_count > 0) ||
+             (reduce_pending_count > 0)) {
         RingField* rf = ready_queue.Dequeue();
         switch (rf->action) {
           case RF_RECV:
             --recv_pending_count;
             break;
+          case RF_REDUCE:
+            // A field aborted between inline actions can be requeued with
+            // action RF_REDUCE without a pending async reduction.
+            if (reduce_pending_count > 0) --reduce_pending_count;
+            break;
           case RF_SEND:
             --send_pending_count;
             break;
@@ -342,6 +391,7 @@ bool RingReducer::RunAsyncParts() {
 
   CHECK_EQ(send_pending_count, 0);
   CHECK_EQ(recv_pending_count, 0);
+  CHECK_EQ(reduce_pending_count, 0);
 
   VLOG(2) << this << " device=" << col_ctx_->device_name << " finish;"
           << " final value " << TensorDebugString(ca_->Value());
@@ -408,6 +408,42 @@ Status ShapeRefiner::UpdateNode(const Node* node, bool relax, bool* refined) {
   return RunShapeFn(node, op_reg_data, node_ext_context);
 }
 
+Status ShapeRefiner::UpdateDependentNodes(const Node* node) {
+  // Breadth-first propagation: a consumer is re-enqueued only while its
+  // re-inferred input shapes keep changing. Merging input shapes is monotone,
+  // so propagation terminates on acyclic graphs; the per-node update cap
+  // guards against non-converging cycles.
+  constexpr int kMaxUpdatesPerNode = 5;
+  std::unordered_map<const Node*, int> update_counts;
+  std::deque<const Node*> worklist;
+  std::unordered_set<const Node*> in_worklist;
+
+  auto enqueue_consumers = [&](const Node* n) {
+    for (const Edge* e : n->out_edges()) {
+      if (e->IsControlEdge()) continue;
+      const Node* dst = e->dst();
+      // A consumer that was never added to the refiner picks up the new
+      // shapes when it is added.
+      if (node_to_context_.find(dst) == node_to_context_.end()) continue;
+      if (in_worklist.insert(dst).second) worklist.push_back(dst);
+    }
+  };
+  enqueue_consumers(node);
+
+  while (!worklist.empty()) {
+    const Node* n = worklist.front();
+    worklist.pop_front();
+    in_worklist.erase(n);
+    int& count = update_counts[n];
+    if (count >= kMaxUpdatesPerNode) continue;
+    ++count;
+    bool refined = false;
+    TF_RETURN_IF_ERROR(UpdateNode(n, /*relax=*/false, &refined));
+    if (refined) enqueue_consumers(n);
+  }
+  return OkStatus();
+}
+
 Status ShapeRefiner::EvaluateConstantTensorForEdge(
     const Node* node, int dst_idx, bool* evaluated, Tensor* result,
     InferenceContext* outer_context) {
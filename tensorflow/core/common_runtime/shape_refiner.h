@@ -109,6 +109,15 @@ class ShapeRefiner {
   // if <*refined> is set to false.
   Status UpdateNode(const Node* node, bool relax, bool* refined);
 
+  // Re-runs shape inference over the downstream cone of 'node', visiting a
+  // consumer only while its input shapes keep changing. Call this after
+  // mutating 'node' (or after SetShape()) to bring dependent shapes up to
+  // date without re-running inference for the whole graph: nodes whose
+  // re-inferred input shapes are unchanged stop the propagation. Consumers
+  // that have not been added to the refiner are skipped; they pick up the
+  // new shapes when they are added.
+  Status UpdateDependentNodes(const Node* node);
+
   // Returns the InferenceContext for 'node', if present.
   shape_inference::InferenceContext* GetContext(const Node* node) const {
     auto it = node_to_context_.find(node);
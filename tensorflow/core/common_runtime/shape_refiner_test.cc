@@ -200,6 +200,43 @@ TEST_F(ShapeRefinerTest, SetShape) {
   ASSERT_FALSE(m.SetShape(a.node(), 0, h).ok());
 }
 
+TEST_F(ShapeRefinerTest, UpdateDependentNodes) {
+  ShapeRefiner m(TF_GRAPH_DEF_VERSION, OpRegistry::Global());
+
+  Scope root = Scope::NewRootScope();
+  auto a = ops::Placeholder(root, DT_FLOAT);
+  auto b = ops::Placeholder(root, DT_FLOAT);
+  auto mm = ops::MatMul(root, a, b);
+  auto id = ops::Identity(root, mm);
+
+  TF_ASSERT_OK(m.AddNode(a.node()));
+  TF_ASSERT_OK(m.AddNode(b.node()));
+  TF_ASSERT_OK(m.AddNode(mm.node()));
+  TF_ASSERT_OK(m.AddNode(id.node()));
+  EXPECT_SHAPE("[?,?]", m, mm, 0);
+  EXPECT_SHAPE("[?,?]", m, id, 0);
+
+  // Refine the placeholder shapes and propagate through the cone.
+  auto ic = m.GetContext(a.node());
+  ASSERT_NE(nullptr, ic);
+  TF_ASSERT_OK(m.SetShape(a.node(), 0, ic->MakeShape({2, 3})));
+  TF_ASSERT_OK(m.UpdateDependentNodes(a.node()));
+  EXPECT_SHAPE("[2,?]", m, mm, 0);
+  EXPECT_SHAPE("[2,?]", m, id, 0);
+
+  ic = m.GetContext(b.node());
+  ASSERT_NE(nullptr, ic);
+  TF_ASSERT_OK(m.SetShape(b.node(), 0, ic->MakeShape({3, 4})));
+  TF_ASSERT_OK(m.UpdateDependentNodes(b.node()));
+  EXPECT_SHAPE("[2,4]", m, mm, 0);
+  EXPECT_SHAPE("[2,4]", m, id, 0);
+
+  // A consumer added after the update picks up the refined shapes on AddNode.
+  auto id2 = ops::Identity(root, id);
+  TF_ASSERT_OK(m.AddNode(id2.node()));
+  EXPECT_SHAPE("[2,4]", m, id2, 0);
+}
+
 namespace {
 
 // An op with no shape function.
@@ -0,0 +1,113 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
+
+#include <algorithm>
+
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+StepArenaAllocator::StepArenaAllocator(Allocator* underlying)
+    : AllocatorWrapper(underlying) {}
+
+StepArenaAllocator::~StepArenaAllocator() {
+  for (const Block& block : blocks_) {
+    wrapped()->DeallocateRaw(block.start);
+  }
+}
+
+std::string StepArenaAllocator::Name() {
+  return strings::StrCat("step_arena_", wrapped()->Name());
+}
+
+void* StepArenaAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  return AllocateRaw(alignment, num_bytes, AllocationAttributes());
+}
+
+void* StepArenaAllocator::AllocateRaw(
+    size_t alignment, size_t num_bytes,
+    const AllocationAttributes& allocation_attr) {
+  if (num_bytes > kMaxArenaAllocation ||
+      alignment > Allocator::kAllocatorAlignment) {
+    // Too large (or too strictly aligned) for the arena: forward to the
+    // underlying allocator, but still pin the arena's lifetime so that
+    // DeallocateRaw on this pointer remains valid after the step completes.
+    void* ptr = wrapped()->AllocateRaw(alignment, num_bytes, allocation_attr);
+    if (ptr != nullptr) {
+      mutex_lock l(mu_);
+      ++outstanding_;
+    }
+    return ptr;
+  }
+
+  // Round up so that the next bump allocation stays aligned.
+  const size_t rounded = (std::max<size_t>(num_bytes, 1) +
+                          Allocator::kAllocatorAlignment - 1) &
+                         ~(Allocator::kAllocatorAlignment - 1);
+  mutex_lock l(mu_);
+  if (rounded > remaining_) {
+    char* block = static_cast<char*>(
+        wrapped()->AllocateRaw(Allocator::kAllocatorAlignment, kBlockSize));
+    if (block == nullptr) return nullptr;
+    blocks_.push_back({block, kBlockSize});
+    cur_ = block;
+    remaining_ = kBlockSize;
+  }
+  void* ptr = cur_;
+  cur_ += rounded;
+  remaining_ -= rounded;
+  ++outstanding_;
+  return ptr;
+}
+
+void StepArenaAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  bool delete_self = false;
+  {
+    mutex_lock l(mu_);
+    if (!OwnsPointer(ptr)) {
+      wrapped()->DeallocateRaw(ptr);
+    }
+    --outstanding_;
+    DCHECK_GE(outstanding_, 0);
+    delete_self = step_done_ && outstanding_ == 0;
+  }
+  // The mutex serializes the state transitions, so exactly one caller can
+  // observe the arena becoming both quiescent and step-done.
+  if (delete_self) delete this;
+}
+
+void StepArenaAllocator::MarkStepDone() {
+  bool delete_self = false;
+  {
+    mutex_lock l(mu_);
+    DCHECK(!step_done_);
+    step_done_ = true;
+    delete_self = outstanding_ == 0;
+  }
+  if (delete_self) delete this;
+}
+
+bool StepArenaAllocator::OwnsPointer(const void* ptr) const {
+  const char* p = static_cast<const char*>(ptr);
+  for (const Block& block : blocks_) {
+    if (p >= block.start && p < block.start + block.size) return true;
+  }
+  return false;
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,94 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
+
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// An allocator that bump-allocates small requests out of large blocks obtained
+// from an underlying allocator, intended to serve the temporary and output
+// tensors of a single executor step. Individual deallocations only decrement a
+// counter; the blocks are returned to the underlying allocator wholesale once
+// the step has completed and every allocation has been released. This trades a
+// modest amount of memory slack for taking the process-wide allocator (and its
+// lock) off the hot path of small-op graphs.
+//
+// The arena is self-owning: the creator of the arena must call MarkStepDone()
+// exactly once when the step that uses it completes, after which the arena
+// deletes itself as soon as the last outstanding allocation is returned.
+// Allocations that exceed the arena threshold are forwarded to the underlying
+// allocator but still pin the arena's lifetime, so buffers that escape the
+// step (e.g. fetched outputs) remain valid for as long as they are alive.
+//
+// This class is thread-safe.
+class StepArenaAllocator : public AllocatorWrapper {
+ public:
+  explicit StepArenaAllocator(Allocator* underlying);
+
+  std::string Name() override;
+
+  // Both overloads must route through the arena: tensor buffers allocate via
+  // the attribute-taking overload (see TypedAllocator::Allocate), and a call
+  // that bypassed the arena would still be paired with a DeallocateRaw that
+  // reaches the arena's accounting.
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const AllocationAttributes& allocation_attr) override;
+  void DeallocateRaw(void* ptr) override;
+
+  // The underlying allocator may track sizes, but arena allocations are not
+  // individually tracked, so size-tracking queries must not be forwarded.
+  bool TracksAllocationSizes() const override { return false; }
+
+  // Signals that the step owning this arena has completed. Must be called
+  // exactly once; the arena deletes itself once all outstanding allocations
+  // have been returned.
+  void MarkStepDone();
+
+ private:
+  ~StepArenaAllocator() override;
+
+  // Allocations larger than this are forwarded to the underlying allocator.
+  static constexpr size_t kMaxArenaAllocation = 32 * 1024;
+  // Granularity at which backing blocks are obtained from the underlying
+  // allocator.
+  static constexpr size_t kBlockSize = 256 * 1024;
+
+  struct Block {
+    char* start;
+    size_t size;
+  };
+
+  // Returns true if `ptr` lies within an arena-owned block.
+  bool OwnsPointer(const void* ptr) const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  mutable mutex mu_;
+  std::vector<Block> blocks_ TF_GUARDED_BY(mu_);
+  char* cur_ TF_GUARDED_BY(mu_) = nullptr;
+  size_t remaining_ TF_GUARDED_BY(mu_) = 0;
+  int64_t outstanding_ TF_GUARDED_BY(mu_) = 0;
+  bool step_done_ TF_GUARDED_BY(mu_) = false;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
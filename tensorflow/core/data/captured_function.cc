@@ -47,6 +47,11 @@ namespace {
 constexpr char kAllowSmallFunctionOptimizations[] =
     "allow_small_function_optimizations";
 
+// Bound on the number of instantiations memoized per captured function. One
+// entry per live function handle cache suffices; the bound keeps memory in
+// check when instantiations go through many short-lived caches.
+constexpr size_t kMaxInstantiationMemos = 8;
+
 // Simplistic implementation of the `StepStatsCollectorInterface` that only
 // cares about collecting the CPU time needed to execute a captured function.
 class SimpleStepStatsCollector : public StepStatsCollectorInterface {
@@ -538,6 +543,21 @@ Status CapturedFunction::Instantiate(
         instantiated_captured_function) {
   // The context's runtime will be used for all subsequent calls.
   FunctionLibraryRuntime* lib = params.flr;
+  if (params.function_handle_cache) {
+    // If this function was previously instantiated through the same handle
+    // cache, reuse the handle without rebuilding the instantiation options.
+    tf_shared_lock l(mu_);
+    for (const InstantiationMemo& memo : instantiations_) {
+      if (memo.lib == lib && memo.cache == params.function_handle_cache &&
+          memo.cache_id == params.function_handle_cache->id()) {
+        *instantiated_captured_function =
+            absl::WrapUnique(new InstantiatedCapturedFunction(
+                lib, memo.handle, memo.ret_types, *params.runner, this,
+                memo.is_multi_device));
+        return OkStatus();
+      }
+    }
+  }
   FunctionLibraryRuntime::InstantiateOptions inst_opts;
   inst_opts.lib_def = metadata_->lib_def();
   inst_opts.create_kernels_eagerly = true;
@@ -673,6 +693,17 @@ Status CapturedFunction::Instantiate(
 
   bool is_multi_device;
   TF_RETURN_IF_ERROR(IsMultiDevice(lib, &is_multi_device));
+  if (params.function_handle_cache) {
+    // The cache owns the handle, so it is safe to hand it out again for as
+    // long as the cache is alive.
+    mutex_lock l(mu_);
+    if (instantiations_.size() >= kMaxInstantiationMemos) {
+      instantiations_.erase(instantiations_.begin());
+    }
+    instantiations_.push_back({lib, params.function_handle_cache,
+                               params.function_handle_cache->id(), f_handle,
+                               ret_types, is_multi_device});
+  }
   *instantiated_captured_function = absl::WrapUnique(
       new InstantiatedCapturedFunction(lib, f_handle, std::move(ret_types),
                                        *params.runner, this, is_multi_device));
@@ -28,6 +28,8 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 
 namespace tensorflow {
 
@@ -217,8 +219,30 @@ class CapturedFunction {
   Status IsMultiDevice(FunctionLibraryRuntime* flr,
                        bool* is_multi_device) const;
 
+  // A memoized result of `Instantiate` for a particular function handle
+  // cache. Building `InstantiateOptions` (including per-input device
+  // inference and the Grappler rewrite callback for multi-device functions)
+  // dominates the cost of re-instantiation even when the handle cache hits,
+  // so instantiations that went through a `FunctionHandleCache` are memoized
+  // here and reinstantiation through the same cache skips straight to the
+  // cached handle. The cache owns the handle, so a memoized entry is valid
+  // for as long as its cache is alive; `cache_id` guards against a different
+  // cache being allocated at the same address.
+  struct InstantiationMemo {
+    FunctionLibraryRuntime* lib;
+    FunctionHandleCache* cache;
+    uint64 cache_id;
+    FunctionLibraryRuntime::Handle handle;
+    DataTypeVector ret_types;
+    bool is_multi_device;
+  };
+
   const std::shared_ptr<const FunctionMetadata> metadata_;
   const std::vector<Tensor> captured_inputs_;
+  mutable mutex mu_;
+  // Bounded collection of memoized instantiations, most recent last.
+  // Instantiations through short-lived caches eventually age out.
+  std::vector<InstantiationMemo> instantiations_ TF_GUARDED_BY(mu_);
 
   TF_DISALLOW_COPY_AND_ASSIGN(CapturedFunction);
 };
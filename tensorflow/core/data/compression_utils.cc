@@ -14,17 +14,113 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/data/compression_utils.h"
 
+#include <zlib.h>
+
 #include <limits>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
+namespace {
+
+// The zlib compression level used by `DefaultCompressionCodec()`-based
+// compression. Configured with the TF_DATA_COMPRESSION_LEVEL environment
+// variable; -1 selects the zlib default.
+int DefaultCompressionLevel() {
+  static const int level = [] {
+    int64_t level = Z_DEFAULT_COMPRESSION;
+    Status s = ReadInt64FromEnvVar("TF_DATA_COMPRESSION_LEVEL",
+                                   Z_DEFAULT_COMPRESSION, &level);
+    if (!s.ok() || level < -1 || level > Z_BEST_COMPRESSION) {
+      LOG(WARNING) << "Invalid TF_DATA_COMPRESSION_LEVEL; using the codec "
+                   << "default.";
+      level = Z_DEFAULT_COMPRESSION;
+    }
+    return static_cast<int>(level);
+  }();
+  return level;
+}
+
+Status ZlibCompress(const char* data, size_t size, int level,
+                    std::string* out) {
+  uLongf compressed_size = compressBound(size);
+  out->resize(compressed_size);
+  int ret = compress2(reinterpret_cast<Bytef*>(&(*out)[0]), &compressed_size,
+                      reinterpret_cast<const Bytef*>(data), size, level);
+  if (ret != Z_OK) {
+    return errors::Internal("Failed to compress using zlib: ", ret);
+  }
+  out->resize(compressed_size);
+  return OkStatus();
+}
+
+// Uncompresses zlib-compressed `compressed` into the iovec. Unlike snappy,
+// zlib cannot decompress directly into an iovec, so the data is decompressed
+// into a scratch buffer and then scattered to the iovec entries.
+Status ZlibUncompressToIOVec(const std::string& compressed,
+                             const std::vector<struct iovec>& iov,
+                             size_t total_size) {
+  tstring scratch;
+  scratch.resize_uninitialized(total_size);
+  uLongf uncompressed_size = total_size;
+  int ret = uncompress(reinterpret_cast<Bytef*>(scratch.mdata()),
+                       &uncompressed_size,
+                       reinterpret_cast<const Bytef*>(compressed.data()),
+                       compressed.size());
+  if (ret != Z_OK) {
+    return errors::Internal("Failed to perform zlib decompression: ", ret);
+  }
+  if (uncompressed_size != total_size) {
+    return errors::Internal("Uncompressed size mismatch. Zlib produced ",
+                            uncompressed_size,
+                            " whereas the tensor metadata suggests ",
+                            total_size);
+  }
+  const char* position = scratch.data();
+  for (const auto& entry : iov) {
+    memcpy(entry.iov_base, position, entry.iov_len);
+    position += entry.iov_len;
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+CompressionCodec DefaultCompressionCodec() {
+  static const CompressionCodec codec = [] {
+    string name;
+    Status s = ReadStringFromEnvVar("TF_DATA_COMPRESSION_CODEC", "snappy",
+                                    &name);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to read TF_DATA_COMPRESSION_CODEC: "
+                   << s.error_message();
+      return COMPRESSION_CODEC_SNAPPY;
+    }
+    if (name == "zlib") {
+      return COMPRESSION_CODEC_ZLIB;
+    }
+    if (name != "snappy") {
+      LOG(WARNING) << "Unknown tf.data compression codec \"" << name
+                   << "\"; using snappy.";
+    }
+    return COMPRESSION_CODEC_SNAPPY;
+  }();
+  return codec;
+}
+
+Status CompressElement(const std::vector<Tensor>& element,
+                       CompressedElement* out) {
+  return CompressElement(element, DefaultCompressionCodec(),
+                         DefaultCompressionLevel(), out);
+}
 
 Status CompressElement(const std::vector<Tensor>& element,
+                       CompressionCodec codec, int level,
                        CompressedElement* out) {
   // Step 1: Determine the total uncompressed size. This requires serializing
   // non-memcopyable tensors, which we save to use again later.
@@ -74,9 +170,23 @@ Status CompressElement(const std::vector<Tensor>& element,
   }
   DCHECK_EQ(position, uncompressed.mdata() + total_size);
 
-  if (!port::Snappy_Compress(uncompressed.mdata(), total_size,
-                             out->mutable_data())) {
-    return errors::Internal("Failed to compress using snappy.");
+  switch (codec) {
+    case COMPRESSION_CODEC_ZLIB:
+      TF_RETURN_IF_ERROR(ZlibCompress(uncompressed.mdata(), total_size, level,
+                                      out->mutable_data()));
+      out->set_codec(COMPRESSION_CODEC_ZLIB);
+      break;
+    case COMPRESSION_CODEC_SNAPPY:
+      if (!port::Snappy_Compress(uncompressed.mdata(), total_size,
+                                 out->mutable_data())) {
+        return errors::Internal("Failed to compress using snappy.");
+      }
+      // `codec` is left at its default (Snappy) value, which readers predating
+      // the field interpret correctly.
+      break;
+    default:
+      return errors::InvalidArgument("Unsupported tf.data compression codec: ",
+                                     codec);
   }
   VLOG(3) << "Compressed element from " << total_size << " bytes to "
           << out->data().size() << " bytes";
@@ -126,22 +236,35 @@ Status UncompressElement(const CompressedElement& compressed,
 
   // Step 2: Uncompress into the iovec.
   const std::string& compressed_data = compressed.data();
-  size_t uncompressed_size;
-  if (!port::Snappy_GetUncompressedLength(
-          compressed_data.data(), compressed_data.size(), &uncompressed_size)) {
-    return errors::Internal(
-        "Could not get snappy uncompressed length. Compressed data size: ",
-        compressed_data.size());
-  }
-  if (uncompressed_size != static_cast<size_t>(total_size)) {
-    return errors::Internal(
-        "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
-        " whereas the tensor metadata suggests ", total_size);
-  }
-  if (!port::Snappy_UncompressToIOVec(compressed_data.data(),
-                                      compressed_data.size(), iov.data(),
-                                      num_components)) {
-    return errors::Internal("Failed to perform snappy decompression.");
+  switch (compressed.codec()) {
+    case COMPRESSION_CODEC_ZLIB:
+      TF_RETURN_IF_ERROR(ZlibUncompressToIOVec(
+          compressed_data, iov, static_cast<size_t>(total_size)));
+      break;
+    case COMPRESSION_CODEC_SNAPPY: {
+      size_t uncompressed_size;
+      if (!port::Snappy_GetUncompressedLength(compressed_data.data(),
+                                              compressed_data.size(),
+                                              &uncompressed_size)) {
+        return errors::Internal(
+            "Could not get snappy uncompressed length. Compressed data size: ",
+            compressed_data.size());
+      }
+      if (uncompressed_size != static_cast<size_t>(total_size)) {
+        return errors::Internal(
+            "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
+            " whereas the tensor metadata suggests ", total_size);
+      }
+      if (!port::Snappy_UncompressToIOVec(compressed_data.data(),
+                                          compressed_data.size(), iov.data(),
+                                          num_components)) {
+        return errors::Internal("Failed to perform snappy decompression.");
+      }
+      break;
+    }
+    default:
+      return errors::Unimplemented("Unsupported tf.data compression codec: ",
+                                   compressed.codec());
   }
 
   // Step 3: Deserialize tensor proto strings to tensors.
@@ -22,13 +22,26 @@ limitations under the License.
 namespace tensorflow {
 namespace data {
 
+// Returns the codec used to compress dataset elements when the caller does
+// not specify one. Configured with the TF_DATA_COMPRESSION_CODEC environment
+// variable ("snappy" or "zlib"); defaults to Snappy.
+CompressionCodec DefaultCompressionCodec();
+
 // Compresses the components of `element` into the `CompressedElement` proto.
 //
 // In addition to writing the actual compressed bytes, `Compress` fills
 // out the per-component metadata for the `CompressedElement`.
 //
-// Returns an error if the uncompressed size of the element exceeds 4GB.
+// Uses `DefaultCompressionCodec()`. Returns an error if the uncompressed size
+// of the element exceeds 4GB.
+Status CompressElement(const std::vector<Tensor>& element,
+                       CompressedElement* out);
+
+// Like the above, but compresses with `codec`. `level` is the codec-specific
+// compression level; it is only meaningful for zlib, where -1 selects the
+// zlib default.
 Status CompressElement(const std::vector<Tensor>& element,
+                       CompressionCodec codec, int level,
                        CompressedElement* out);
 
 // Uncompresses a `CompressedElement` into a vector of tensor components.
@@ -15,21 +15,29 @@ limitations under the License.
 
 #include "tensorflow/core/data/serialization_utils.h"
 
+#include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/graph_constructor.h"
 #include "tensorflow/core/common_runtime/graph_runner.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/graph/graph_def_builder.h"
+#include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 
 namespace tensorflow {
 namespace data {
 namespace {
 
 constexpr char kDelimiter[] = "@@";
+constexpr char kIteratorTypeName[] = "tensorflow::Iterator";
+constexpr char kIteratorDeltaTypeName[] = "tensorflow::IteratorDelta";
 constexpr char kComponent[] = "component";
 constexpr char kNumComponents[] = "num_components";
 constexpr char kNumElements[] = "num_elements";
@@ -100,6 +108,38 @@ Status FindStatefulOps(const GraphDef& graph_def,
   return OkStatus();
 }
 
+// Splits the metadata of a checkpoint entry into the iterator name and the
+// remaining `@@`-delimited fields. For full checkpoints the fields are the
+// entry's keys, one per tensor; for delta checkpoints they alternate between
+// a key and the source of its value (see `ComputeCheckpointDelta`).
+Status ParseCheckpointMetadata(const VariantTensorData& data, string* name,
+                               std::vector<string>* fields) {
+  string metadata;
+  data.get_metadata(&metadata);
+  std::vector<string> split =
+      str_util::Split(metadata, kDelimiter, str_util::SkipEmpty());
+  if (split.empty()) {
+    return errors::InvalidArgument("Checkpoint metadata is empty.");
+  }
+  *name = split[0];
+  fields->assign(split.begin() + 1, split.end());
+  return OkStatus();
+}
+
+// Returns true if `a` and `b` hold the same value. Comparison is by
+// serialized content so that it is well-defined for all element types,
+// including strings and variants.
+bool SameTensorValue(const Tensor& a, const Tensor& b) {
+  if (a.dtype() != b.dtype() || a.shape() != b.shape()) {
+    return false;
+  }
+  TensorProto a_proto;
+  TensorProto b_proto;
+  a.AsProtoTensorContent(&a_proto);
+  b.AsProtoTensorContent(&b_proto);
+  return a_proto.SerializeAsString() == b_proto.SerializeAsString();
+}
+
 }  // namespace
 
 Status ReadElementsFromCheckpoint(IteratorContext* ctx,
@@ -147,6 +187,135 @@ Status WriteElementsToCheckpoint(
   return OkStatus();
 }
 
+Status ComputeCheckpointDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const std::vector<const VariantTensorData*>& current,
+    std::vector<std::unique_ptr<VariantTensorData>>* delta) {
+  // Index the base checkpoint by iterator name and key.
+  std::map<string, const VariantTensorData*> base_data;
+  std::map<string, std::map<string, size_t>> base_keys;
+  for (const VariantTensorData* data : base) {
+    string name;
+    std::vector<string> keys;
+    TF_RETURN_IF_ERROR(ParseCheckpointMetadata(*data, &name, &keys));
+    if (static_cast<int>(keys.size()) != data->tensors_size()) {
+      return errors::InvalidArgument(
+          "Checkpoint entry for ", name, " has ", keys.size(), " keys but ",
+          data->tensors_size(), " tensors; not a full checkpoint.");
+    }
+    base_data[name] = data;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      base_keys[name][keys[i]] = i;
+    }
+  }
+  // Record every key of `current`, carrying a tensor only for values that
+  // differ from the base. The metadata alternates between a key and the
+  // source of its value: "b<i>" refers to tensor `i` of the entry with the
+  // same name in the base checkpoint, and "d<i>" to tensor `i` of this delta
+  // entry. Entries for unchanged iterators carry no tensors at all, so that
+  // applying the delta reconstructs the full checkpoint without consulting
+  // anything other than the base.
+  for (const VariantTensorData* data : current) {
+    string name;
+    std::vector<string> keys;
+    TF_RETURN_IF_ERROR(ParseCheckpointMetadata(*data, &name, &keys));
+    if (static_cast<int>(keys.size()) != data->tensors_size()) {
+      return errors::InvalidArgument(
+          "Checkpoint entry for ", name, " has ", keys.size(), " keys but ",
+          data->tensors_size(), " tensors; not a full checkpoint.");
+    }
+    auto delta_entry = absl::make_unique<VariantTensorData>();
+    delta_entry->set_type_name(kIteratorDeltaTypeName);
+    string metadata = name;
+    auto keys_it = base_keys.find(name);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const Tensor& tensor = data->tensors(i);
+      int64_t base_index = -1;
+      if (keys_it != base_keys.end()) {
+        auto key_it = keys_it->second.find(keys[i]);
+        if (key_it != keys_it->second.end() &&
+            SameTensorValue(base_data[name]->tensors(key_it->second),
+                            tensor)) {
+          base_index = key_it->second;
+        }
+      }
+      if (base_index >= 0) {
+        strings::StrAppend(&metadata, kDelimiter, keys[i], kDelimiter, "b",
+                           base_index);
+      } else {
+        strings::StrAppend(&metadata, kDelimiter, keys[i], kDelimiter, "d",
+                           delta_entry->tensors_size());
+        *delta_entry->add_tensors() = tensor;
+      }
+    }
+    delta_entry->set_metadata(metadata);
+    delta->push_back(std::move(delta_entry));
+  }
+  return OkStatus();
+}
+
+Status ApplyCheckpointDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const std::vector<const VariantTensorData*>& delta,
+    std::vector<std::unique_ptr<VariantTensorData>>* result) {
+  std::map<string, const VariantTensorData*> base_data;
+  for (const VariantTensorData* data : base) {
+    string name;
+    std::vector<string> keys;
+    TF_RETURN_IF_ERROR(ParseCheckpointMetadata(*data, &name, &keys));
+    base_data[name] = data;
+  }
+  for (const VariantTensorData* data : delta) {
+    string name;
+    std::vector<string> fields;
+    TF_RETURN_IF_ERROR(ParseCheckpointMetadata(*data, &name, &fields));
+    if (fields.size() % 2 != 0) {
+      return errors::InvalidArgument("Delta checkpoint entry for ", name,
+                                     " is malformed.");
+    }
+    auto result_entry = absl::make_unique<VariantTensorData>();
+    result_entry->set_type_name(kIteratorTypeName);
+    string metadata = name;
+    for (size_t i = 0; i < fields.size(); i += 2) {
+      const string& key = fields[i];
+      const string& source = fields[i + 1];
+      int64_t index;
+      if (source.size() < 2 ||
+          !strings::safe_strto64(source.substr(1), &index)) {
+        return errors::InvalidArgument("Delta checkpoint entry for ", name,
+                                       " has malformed source ", source,
+                                       " for key ", key, ".");
+      }
+      const VariantTensorData* source_data;
+      if (source[0] == 'd') {
+        source_data = data;
+      } else if (source[0] == 'b') {
+        auto it = base_data.find(name);
+        if (it == base_data.end()) {
+          return errors::InvalidArgument(
+              "Delta checkpoint references iterator ", name,
+              " which is missing from the base checkpoint.");
+        }
+        source_data = it->second;
+      } else {
+        return errors::InvalidArgument("Delta checkpoint entry for ", name,
+                                       " has malformed source ", source,
+                                       " for key ", key, ".");
+      }
+      if (index < 0 || index >= source_data->tensors_size()) {
+        return errors::InvalidArgument("Delta checkpoint entry for ", name,
+                                       " references out-of-range tensor ",
+                                       index, " for key ", key, ".");
+      }
+      strings::StrAppend(&metadata, kDelimiter, key);
+      *result_entry->add_tensors() = source_data->tensors(index);
+    }
+    result_entry->set_metadata(metadata);
+    result->push_back(std::move(result_entry));
+  }
+  return OkStatus();
+}
+
 VariantTensorDataReader::VariantTensorDataReader(
     const std::vector<const tensorflow::VariantTensorData*>& data) {
   for (const auto& d : data) {
@@ -390,7 +559,7 @@ Status VariantTensorDataWriter::WriteTensorInternal(StringPiece n,
   keys_[name].push_back(string(key));
   if (data_.count(name) == 0) {
     data_[name] = absl::make_unique<VariantTensorData>();
-    data_[name]->set_type_name("tensorflow::Iterator");
+    data_[name]->set_type_name(kIteratorTypeName);
   }
   *(data_[name]->add_tensors()) = val;
   return OkStatus();
@@ -16,7 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DATA_SERIALIZATION_UTILS_H_
 #define TENSORFLOW_CORE_DATA_SERIALIZATION_UTILS_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -120,6 +122,29 @@ class VariantTensorDataWriter : public IteratorStateWriter {
   std::map<string, std::vector<string>> keys_;
 };
 
+// Computes a delta checkpoint capturing only the iterator state that changed
+// between `base` and `current`, both of which are checkpoints produced by
+// `VariantTensorDataWriter`. The delta records every key of `current`, but
+// carries tensors only for keys whose value differs from (or does not exist
+// in) `base`; unchanged values are represented as references into `base`.
+// For steady-state pipelines with large, slowly-mutating state (e.g. shuffle
+// buffers), the delta is a small fraction of the full checkpoint size. The
+// full checkpoint can be reconstructed with `ApplyCheckpointDelta`, given the
+// same `base`.
+Status ComputeCheckpointDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const std::vector<const VariantTensorData*>& current,
+    std::vector<std::unique_ptr<VariantTensorData>>* delta);
+
+// Reconstructs a full checkpoint from a `base` checkpoint and a `delta`
+// produced by `ComputeCheckpointDelta` against that base. The result is
+// equivalent to the `current` checkpoint the delta was computed from and can
+// be read with `VariantTensorDataReader`.
+Status ApplyCheckpointDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const std::vector<const VariantTensorData*>& delta,
+    std::vector<std::unique_ptr<VariantTensorData>>* result);
+
 // Returns a GraphDef representation of the given dataset.
 Status AsGraphDef(const DatasetBase* dataset,
                   SerializationContext&& serialization_ctx,
@@ -201,6 +201,74 @@ TEST(SerializationUtilsTest, VariantTensorDataNonExistentKeyIteratorName) {
       reader.ReadTensor("Iterator", "NonExistentKey", &val_tensor).code());
 }
 
+std::vector<const VariantTensorData*> GetPointers(
+    const std::vector<std::unique_ptr<VariantTensorData>>& data) {
+  std::vector<const VariantTensorData*> result;
+  result.reserve(data.size());
+  for (const auto& d : data) {
+    result.push_back(d.get());
+  }
+  return result;
+}
+
+TEST(SerializationUtilsTest, CheckpointDeltaRoundTrip) {
+  VariantTensorDataWriter base_writer;
+  TF_ASSERT_OK(base_writer.WriteScalar("Iterator", "Unchanged", 1));
+  TF_ASSERT_OK(base_writer.WriteScalar("Iterator", "Changed", 2));
+  TF_ASSERT_OK(base_writer.WriteScalar("Iterator", "Removed", 3));
+  std::vector<std::unique_ptr<VariantTensorData>> base;
+  base_writer.ReleaseData(&base);
+
+  VariantTensorDataWriter current_writer;
+  TF_ASSERT_OK(current_writer.WriteScalar("Iterator", "Unchanged", 1));
+  TF_ASSERT_OK(current_writer.WriteScalar("Iterator", "Changed", 4));
+  TF_ASSERT_OK(current_writer.WriteScalar("Iterator", "Added", 5));
+  std::vector<std::unique_ptr<VariantTensorData>> current;
+  current_writer.ReleaseData(&current);
+
+  std::vector<std::unique_ptr<VariantTensorData>> delta;
+  TF_ASSERT_OK(
+      ComputeCheckpointDelta(GetPointers(base), GetPointers(current), &delta));
+  ASSERT_EQ(delta.size(), 1);
+  // Only the changed and added values should carry tensors.
+  EXPECT_EQ(delta[0]->tensors_size(), 2);
+
+  std::vector<std::unique_ptr<VariantTensorData>> restored;
+  TF_ASSERT_OK(
+      ApplyCheckpointDelta(GetPointers(base), GetPointers(delta), &restored));
+  VariantTensorDataReader reader(GetPointers(restored));
+  int64_t val;
+  TF_ASSERT_OK(reader.ReadScalar("Iterator", "Unchanged", &val));
+  EXPECT_EQ(val, 1);
+  TF_ASSERT_OK(reader.ReadScalar("Iterator", "Changed", &val));
+  EXPECT_EQ(val, 4);
+  TF_ASSERT_OK(reader.ReadScalar("Iterator", "Added", &val));
+  EXPECT_EQ(val, 5);
+  EXPECT_FALSE(reader.Contains("Iterator", "Removed"));
+}
+
+TEST(SerializationUtilsTest, CheckpointDeltaMissingBaseIterator) {
+  VariantTensorDataWriter current_writer;
+  TF_ASSERT_OK(current_writer.WriteScalar("Iterator", "Key", 1));
+  std::vector<std::unique_ptr<VariantTensorData>> current;
+  current_writer.ReleaseData(&current);
+
+  // With an empty base, the delta carries the full state.
+  std::vector<std::unique_ptr<VariantTensorData>> delta;
+  TF_ASSERT_OK(ComputeCheckpointDelta(/*base=*/{}, GetPointers(current),
+                                      &delta));
+  ASSERT_EQ(delta.size(), 1);
+  EXPECT_EQ(delta[0]->tensors_size(), 1);
+
+  std::vector<std::unique_ptr<VariantTensorData>> restored;
+  TF_ASSERT_OK(
+      ApplyCheckpointDelta(/*base=*/{}, GetPointers(delta), &restored));
+  VariantTensorDataReader reader(GetPointers(restored));
+  int64_t val;
+  TF_ASSERT_OK(reader.ReadScalar("Iterator", "Key", &val));
+  EXPECT_EQ(val, 1);
+}
+
 TEST(SerializationUtilsTest, VariantTensorDataWriteAfterFlushing) {
   VariantTensorDataWriter writer;
   TF_ASSERT_OK(writer.WriteScalar(full_name("Int64"), 24));
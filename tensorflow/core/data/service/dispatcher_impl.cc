@@ -324,36 +324,38 @@ Status DataServiceDispatcherImpl::WorkerHeartbeat(
   TF_RETURN_IF_ERROR(CheckStarted());
   VLOG(4) << "Received worker heartbeat request from worker "
           << request->worker_address();
-  mutex_lock l(mu_);
-  const std::string& worker_address = request->worker_address();
-  // Assigned tasks from the perspective of the dispatcher.
-  std::vector<std::shared_ptr<const Task>> assigned_tasks;
-  Status s = state_.TasksForWorker(worker_address, assigned_tasks);
-  if (!s.ok()) {
-    if (!errors::IsNotFound(s)) {
-      return s;
+  {
+    mutex_lock l(mu_);
+    const std::string& worker_address = request->worker_address();
+    // Assigned tasks from the perspective of the dispatcher.
+    std::vector<std::shared_ptr<const Task>> assigned_tasks;
+    Status s = state_.TasksForWorker(worker_address, assigned_tasks);
+    if (!s.ok()) {
+      if (!errors::IsNotFound(s)) {
+        return s;
+      }
+      VLOG(1) << "Registering new worker at address " << worker_address;
+      TF_RETURN_IF_ERROR(state_.ValidateWorker(worker_address));
+      Update update;
+      update.mutable_register_worker()->set_worker_address(worker_address);
+      update.mutable_register_worker()->set_transfer_address(
+          request->transfer_address());
+      *update.mutable_register_worker()->mutable_worker_tags() =
+          request->worker_tags();
+      update.mutable_register_worker()->set_worker_uid(request->worker_uid());
+      TF_RETURN_IF_ERROR(Apply(update));
+      TF_RETURN_IF_ERROR(CreateTasksForWorker(worker_address));
+      TF_RETURN_IF_ERROR(state_.TasksForWorker(worker_address, assigned_tasks));
     }
-    VLOG(1) << "Registering new worker at address " << worker_address;
-    TF_RETURN_IF_ERROR(state_.ValidateWorker(worker_address));
-    Update update;
-    update.mutable_register_worker()->set_worker_address(worker_address);
-    update.mutable_register_worker()->set_transfer_address(
-        request->transfer_address());
-    *update.mutable_register_worker()->mutable_worker_tags() =
-        request->worker_tags();
-    update.mutable_register_worker()->set_worker_uid(request->worker_uid());
-    TF_RETURN_IF_ERROR(Apply(update));
-    TF_RETURN_IF_ERROR(CreateTasksForWorker(worker_address));
-    TF_RETURN_IF_ERROR(state_.TasksForWorker(worker_address, assigned_tasks));
+    absl::flat_hash_set<int64_t> current_tasks;
+    current_tasks.insert(request->current_tasks().cbegin(),
+                         request->current_tasks().cend());
+    TF_RETURN_IF_ERROR(
+        FindTasksToDelete(current_tasks, assigned_tasks, response));
+    TF_RETURN_IF_ERROR(
+        FindNewTasks(worker_address, current_tasks, assigned_tasks, response));
   }
-  absl::flat_hash_set<int64_t> current_tasks;
-  current_tasks.insert(request->current_tasks().cbegin(),
-                       request->current_tasks().cend());
-  TF_RETURN_IF_ERROR(
-      FindTasksToDelete(current_tasks, assigned_tasks, response));
-  TF_RETURN_IF_ERROR(
-      FindNewTasks(worker_address, current_tasks, assigned_tasks, response));
-
+  TF_RETURN_IF_ERROR(CommitJournal());
   VLOG(4) << "Finished worker heartbeat for worker at address "
           << request->worker_address();
   return OkStatus();
@@ -362,25 +364,27 @@ Status DataServiceDispatcherImpl::WorkerHeartbeat(
 Status DataServiceDispatcherImpl::WorkerUpdate(
     const WorkerUpdateRequest* request, WorkerUpdateResponse* response) {
   TF_RETURN_IF_ERROR(CheckStarted());
-  mutex_lock l(mu_);
-  for (auto& update : request->updates()) {
-    int64_t task_id = update.task_id();
-    std::shared_ptr<const Task> task;
-    TF_RETURN_IF_ERROR(state_.TaskFromId(task_id, task));
-    if (update.completed()) {
-      if (task->finished) {
-        VLOG(1) << "Received completion update for already-finished task "
-                << task->task_id << " on worker " << task->worker_address;
-        continue;
+  {
+    mutex_lock l(mu_);
+    for (auto& update : request->updates()) {
+      int64_t task_id = update.task_id();
+      std::shared_ptr<const Task> task;
+      TF_RETURN_IF_ERROR(state_.TaskFromId(task_id, task));
+      if (update.completed()) {
+        if (task->finished) {
+          VLOG(1) << "Received completion update for already-finished task "
+                  << task->task_id << " on worker " << task->worker_address;
+          continue;
+        }
+        Update update;
+        update.mutable_finish_task()->set_task_id(task_id);
+        TF_RETURN_IF_ERROR(Apply(update));
+        VLOG(3) << "Task " << task_id << " from iteration "
+                << task->iteration->iteration_id << " completed";
       }
-      Update update;
-      update.mutable_finish_task()->set_task_id(task_id);
-      TF_RETURN_IF_ERROR(Apply(update));
-      VLOG(3) << "Task " << task_id << " from iteration "
-              << task->iteration->iteration_id << " completed";
     }
   }
-  return OkStatus();
+  return CommitJournal();
 }
 
 Status DataServiceDispatcherImpl::GetDatasetDef(
@@ -398,45 +402,49 @@ Status DataServiceDispatcherImpl::GetDatasetDef(
 Status DataServiceDispatcherImpl::GetSplit(const GetSplitRequest* request,
                                            GetSplitResponse* response) {
   TF_RETURN_IF_ERROR(CheckStarted());
-  mutex_lock l(mu_);
   int64_t iteration_id = request->iteration_id();
   int64_t repetition = request->repetition();
   int64_t provider_index = request->split_provider_index();
   VLOG(3) << "Received GetSplit request for iteration " << iteration_id
           << ", repetition " << repetition << ", split provider index "
           << provider_index;
-  std::shared_ptr<const Iteration> iteration;
-  TF_RETURN_IF_ERROR(state_.IterationFromId(iteration_id, iteration));
-  if (!iteration->distributed_epoch_state.has_value()) {
-    return errors::FailedPrecondition(
-        "Cannot get split for iteration ", iteration_id,
-        ", since it is not a distributed_epoch iteration.");
-  }
-  int64_t current_repetition =
-      iteration->distributed_epoch_state.value().repetitions[provider_index];
-  if (repetition < current_repetition) {
-    response->set_end_of_splits(true);
-    VLOG(3) << "Returning end_of_splits since current repetition "
-            << current_repetition
-            << " is greater than the requested repetition " << repetition;
-    return OkStatus();
-  }
-  SplitProvider* split_provider =
-      split_providers_[iteration_id][provider_index].get();
-  DCHECK(split_provider != nullptr);
-  Tensor split;
   bool end_of_splits = false;
-  TF_RETURN_IF_ERROR(split_provider->GetNext(&split, &end_of_splits));
-  TF_RETURN_IF_ERROR(RecordSplitProduced(iteration_id, repetition,
-                                         request->split_provider_index(),
-                                         end_of_splits));
-  response->set_end_of_splits(end_of_splits);
-  if (end_of_splits) {
-    // Reset the split provider to prepare for the next iteration.
-    TF_RETURN_IF_ERROR(split_providers_[iteration_id][provider_index]->Reset());
-  } else {
-    split.AsProtoTensorContent(response->mutable_split());
+  {
+    mutex_lock l(mu_);
+    std::shared_ptr<const Iteration> iteration;
+    TF_RETURN_IF_ERROR(state_.IterationFromId(iteration_id, iteration));
+    if (!iteration->distributed_epoch_state.has_value()) {
+      return errors::FailedPrecondition(
+          "Cannot get split for iteration ", iteration_id,
+          ", since it is not a distributed_epoch iteration.");
+    }
+    int64_t current_repetition =
+        iteration->distributed_epoch_state.value().repetitions[provider_index];
+    if (repetition < current_repetition) {
+      response->set_end_of_splits(true);
+      VLOG(3) << "Returning end_of_splits since current repetition "
+              << current_repetition
+              << " is greater than the requested repetition " << repetition;
+      return OkStatus();
+    }
+    SplitProvider* split_provider =
+        split_providers_[iteration_id][provider_index].get();
+    DCHECK(split_provider != nullptr);
+    Tensor split;
+    TF_RETURN_IF_ERROR(split_provider->GetNext(&split, &end_of_splits));
+    TF_RETURN_IF_ERROR(RecordSplitProduced(iteration_id, repetition,
+                                           request->split_provider_index(),
+                                           end_of_splits));
+    response->set_end_of_splits(end_of_splits);
+    if (end_of_splits) {
+      // Reset the split provider to prepare for the next iteration.
+      TF_RETURN_IF_ERROR(
+          split_providers_[iteration_id][provider_index]->Reset());
+    } else {
+      split.AsProtoTensorContent(response->mutable_split());
+    }
   }
+  TF_RETURN_IF_ERROR(CommitJournal());
   VLOG(3) << "Returning from GetSplit, end_of_splits=" << end_of_splits;
   return OkStatus();
 }
@@ -473,29 +481,31 @@ Status DataServiceDispatcherImpl::GetOrRegisterDataset(
   PrepareGraph(graph);
   TF_RETURN_IF_ERROR(HashGraph(*graph, &fingerprint));
 
-  mutex_lock l(mu_);
+  int64_t id;
+  {
+    mutex_lock l(mu_);
 #if defined(PLATFORM_GOOGLE)
-  VLOG_LINES(4,
-             absl::StrCat("Registering dataset graph: ", graph->DebugString()));
+    VLOG_LINES(
+        4, absl::StrCat("Registering dataset graph: ", graph->DebugString()));
 #else
-  VLOG(4) << "Registering dataset graph: " << graph->DebugString();
+    VLOG(4) << "Registering dataset graph: " << graph->DebugString();
 #endif
-  std::shared_ptr<const Dataset> dataset;
-  Status s = state_.DatasetFromFingerprint(fingerprint, dataset);
-  if (s.ok()) {
-    int64_t id = dataset->dataset_id;
-    VLOG(3) << "Received duplicate RegisterDataset request with fingerprint "
-            << fingerprint << ". Returning id " << id;
-    response->set_dataset_id(id);
-    return OkStatus();
-  } else if (!errors::IsNotFound(s)) {
-    return s;
-  }
-
-  int64_t id;
-  TF_RETURN_IF_ERROR(
-      RegisterDataset(fingerprint, dataset_def, request->metadata(), id));
+    std::shared_ptr<const Dataset> dataset;
+    Status s = state_.DatasetFromFingerprint(fingerprint, dataset);
+    if (s.ok()) {
+      id = dataset->dataset_id;
+      VLOG(3) << "Received duplicate RegisterDataset request with fingerprint "
+              << fingerprint << ". Returning id " << id;
+      response->set_dataset_id(id);
+      return OkStatus();
+    } else if (!errors::IsNotFound(s)) {
+      return s;
+    }
 
+    TF_RETURN_IF_ERROR(
+        RegisterDataset(fingerprint, dataset_def, request->metadata(), id));
+  }
+  TF_RETURN_IF_ERROR(CommitJournal());
   response->set_dataset_id(id);
   VLOG(3) << "Registered new dataset with id " << id;
   return OkStatus();
@@ -563,6 +573,7 @@ Status DataServiceDispatcherImpl::GetOrCreateJob(
     }
     response->set_job_id(job->id);
   }
+  TF_RETURN_IF_ERROR(CommitJournal());
   VLOG(3) << "Received job id " << job->id << " for CreateJob("
           << request->DebugString() << ")";
   return Status::OK();
@@ -593,6 +604,7 @@ Status DataServiceDispatcherImpl::GetOrCreateIteration(
         AcquireIterationClientId(iteration, iteration_client_id));
     response->set_iteration_client_id(iteration_client_id);
   }
+  TF_RETURN_IF_ERROR(CommitJournal());
   TF_RETURN_IF_ERROR(AssignTasks(tasks));
   VLOG(3) << "Created iteration " << iteration->iteration_id
           << " for CreateIteration(" << request->DebugString() << ")";
@@ -631,13 +643,16 @@ Status DataServiceDispatcherImpl::MaybeRemoveTask(
     VLOG(1) << "Failed to remove task " << task->task_id;
     return OkStatus();
   }
-  mutex_lock l(mu_);
-  if (!task->removed) {
-    Update update;
-    RemoveTaskUpdate* remove_task = update.mutable_remove_task();
-    remove_task->set_task_id(request->task_id());
-    TF_RETURN_IF_ERROR(Apply(update));
+  {
+    mutex_lock l(mu_);
+    if (!task->removed) {
+      Update update;
+      RemoveTaskUpdate* remove_task = update.mutable_remove_task();
+      remove_task->set_task_id(request->task_id());
+      TF_RETURN_IF_ERROR(Apply(update));
+    }
   }
+  TF_RETURN_IF_ERROR(CommitJournal());
   VLOG(1) << "Task " << task->task_id << " successfully removed";
   return OkStatus();
 }
@@ -646,18 +661,20 @@ Status DataServiceDispatcherImpl::ReleaseIterationClient(
     const ReleaseIterationClientRequest* request,
     ReleaseIterationClientResponse* response) {
   TF_RETURN_IF_ERROR(CheckStarted());
-  mutex_lock l(mu_);
-  int64_t iteration_client_id = request->iteration_client_id();
-  std::shared_ptr<const Iteration> iteration;
-  TF_RETURN_IF_ERROR(
-      state_.IterationForIterationClientId(iteration_client_id, iteration));
-  Update update;
-  ReleaseIterationClientUpdate* release_iteration_client =
-      update.mutable_release_iteration_client();
-  release_iteration_client->set_iteration_client_id(iteration_client_id);
-  release_iteration_client->set_time_micros(env_->NowMicros());
-  TF_RETURN_IF_ERROR(Apply(update));
-  return OkStatus();
+  {
+    mutex_lock l(mu_);
+    int64_t iteration_client_id = request->iteration_client_id();
+    std::shared_ptr<const Iteration> iteration;
+    TF_RETURN_IF_ERROR(
+        state_.IterationForIterationClientId(iteration_client_id, iteration));
+    Update update;
+    ReleaseIterationClientUpdate* release_iteration_client =
+        update.mutable_release_iteration_client();
+    release_iteration_client->set_iteration_client_id(iteration_client_id);
+    release_iteration_client->set_time_micros(env_->NowMicros());
+    TF_RETURN_IF_ERROR(Apply(update));
+  }
+  return CommitJournal();
 }
 
 // Validates that the job matches the requested processing mode.
@@ -901,90 +918,99 @@ Status DataServiceDispatcherImpl::AssignTask(std::shared_ptr<const Task> task)
 Status DataServiceDispatcherImpl::ClientHeartbeat(
     const ClientHeartbeatRequest* request, ClientHeartbeatResponse* response) {
   TF_RETURN_IF_ERROR(CheckStarted());
-  mutex_lock l(mu_);
-  VLOG(4) << "Received heartbeat from client id "
-          << request->iteration_client_id();
-  latest_client_heartbeats_time_[request->iteration_client_id()] =
-      absl::FromUnixMicros(env_->NowMicros());
-  std::shared_ptr<const Iteration> iteration;
-  Status s = state_.IterationForIterationClientId(
-      request->iteration_client_id(), iteration);
-  if (errors::IsNotFound(s) && !config_.fault_tolerant_mode()) {
-    return errors::NotFound(
-        "Unknown iteration client id ", request->iteration_client_id(),
-        ". The dispatcher is not configured to be fault tolerant, so this "
-        "could be caused by a dispatcher restart.");
-  }
-  TF_RETURN_IF_ERROR(s);
-  if (iteration->garbage_collected) {
-    return errors::FailedPrecondition(
-        "The requested iteration has been garbage collected due to inactivity. "
-        "Consider configuring the dispatcher with a higher "
-        "`iteration_gc_timeout_ms`.");
-  }
-  if (request->optional_current_round_case() ==
-      ClientHeartbeatRequest::kCurrentRound) {
-    round_robin_rounds_[request->iteration_client_id()] =
-        std::max(round_robin_rounds_[request->iteration_client_id()],
-                 request->current_round());
-  }
-  if (!iteration->pending_tasks.empty()) {
-    const auto& task = iteration->pending_tasks.front();
-    Update update;
-    ClientHeartbeatUpdate* client_heartbeat = update.mutable_client_heartbeat();
-    bool apply_update = false;
-    client_heartbeat->set_iteration_client_id(request->iteration_client_id());
-    absl::optional<int64_t> blocked_round;
-    if (request->optional_blocked_round_case() ==
-        ClientHeartbeatRequest::kBlockedRound) {
-      blocked_round = request->blocked_round();
+  {
+    mutex_lock l(mu_);
+    VLOG(4) << "Received heartbeat from client id "
+            << request->iteration_client_id();
+    latest_client_heartbeats_time_[request->iteration_client_id()] =
+        absl::FromUnixMicros(env_->NowMicros());
+    std::shared_ptr<const Iteration> iteration;
+    Status s = state_.IterationForIterationClientId(
+        request->iteration_client_id(), iteration);
+    if (errors::IsNotFound(s) && !config_.fault_tolerant_mode()) {
+      return errors::NotFound(
+          "Unknown iteration client id ", request->iteration_client_id(),
+          ". The dispatcher is not configured to be fault tolerant, so this "
+          "could be caused by a dispatcher restart.");
     }
-    VLOG(1) << "Handling pending task in iteration client heartbeat. "
-               "iteration_client_id: "
-            << request->iteration_client_id()
-            << ". current_round: " << request->current_round()
-            << ". blocked_round: " << blocked_round.value_or(-1)
-            << ". target_round: " << task.target_round;
-    if (request->current_round() >= task.target_round) {
-      TaskRejected* rejected = client_heartbeat->mutable_task_rejected();
-      // Exponentially try later and later rounds until consumers all agree.
-      int64_t round_offset = 2;
-      for (int i = 0; i < task.failures; ++i) {
-        round_offset *= 2;
-      }
-      rejected->set_new_target_round(
-          round_robin_rounds_[request->iteration_client_id()] + round_offset);
-      apply_update = true;
+    TF_RETURN_IF_ERROR(s);
+    if (iteration->garbage_collected) {
+      return errors::FailedPrecondition(
+          "The requested iteration has been garbage collected due to "
+          "inactivity. Consider configuring the dispatcher with a higher "
+          "`iteration_gc_timeout_ms`.");
     }
-    if (blocked_round.has_value() &&
-        blocked_round.value() <= task.target_round &&
-        !task.ready_consumers.contains(request->iteration_client_id())) {
-      client_heartbeat->set_task_accepted(true);
-      apply_update = true;
+    if (request->optional_current_round_case() ==
+        ClientHeartbeatRequest::kCurrentRound) {
+      round_robin_rounds_[request->iteration_client_id()] =
+          std::max(round_robin_rounds_[request->iteration_client_id()],
+                   request->current_round());
     }
-    if (apply_update) {
-      TF_RETURN_IF_ERROR(Apply(update));
+    if (!iteration->pending_tasks.empty()) {
+      const auto& task = iteration->pending_tasks.front();
+      Update update;
+      ClientHeartbeatUpdate* client_heartbeat =
+          update.mutable_client_heartbeat();
+      bool apply_update = false;
+      client_heartbeat->set_iteration_client_id(request->iteration_client_id());
+      absl::optional<int64_t> blocked_round;
+      if (request->optional_blocked_round_case() ==
+          ClientHeartbeatRequest::kBlockedRound) {
+        blocked_round = request->blocked_round();
+      }
+      VLOG(1) << "Handling pending task in iteration client heartbeat. "
+                 "iteration_client_id: "
+              << request->iteration_client_id()
+              << ". current_round: " << request->current_round()
+              << ". blocked_round: " << blocked_round.value_or(-1)
+              << ". target_round: " << task.target_round;
+      if (request->current_round() >= task.target_round) {
+        TaskRejected* rejected = client_heartbeat->mutable_task_rejected();
+        // Exponentially try later and later rounds until consumers all agree.
+        int64_t round_offset = 2;
+        for (int i = 0; i < task.failures; ++i) {
+          round_offset *= 2;
+        }
+        rejected->set_new_target_round(
+            round_robin_rounds_[request->iteration_client_id()] + round_offset);
+        apply_update = true;
+      }
+      if (blocked_round.has_value() &&
+          blocked_round.value() <= task.target_round &&
+          !task.ready_consumers.contains(request->iteration_client_id())) {
+        client_heartbeat->set_task_accepted(true);
+        apply_update = true;
+      }
+      if (apply_update) {
+        TF_RETURN_IF_ERROR(Apply(update));
+      }
+    }
+    if (!iteration->pending_tasks.empty()) {
+      response->set_block_round(iteration->pending_tasks.front().target_round);
     }
-  }
-  if (!iteration->pending_tasks.empty()) {
-    response->set_block_round(iteration->pending_tasks.front().target_round);
-  }
 
-  std::vector<std::shared_ptr<const Task>> tasks;
-  TF_RETURN_IF_ERROR(state_.TasksForIteration(iteration->iteration_id, tasks));
-  for (const auto& task : tasks) {
-    TaskInfo* task_info = response->mutable_task_info()->Add();
-    task_info->set_worker_address(task->worker_address);
-    task_info->set_transfer_address(task->transfer_address);
-    *task_info->mutable_worker_tags() = {task->worker_tags.begin(),
-                                         task->worker_tags.end()};
-    task_info->set_task_id(task->task_id);
-    task_info->set_iteration_id(iteration->iteration_id);
-    task_info->set_worker_uid(task->worker_uid);
-    task_info->set_starting_round(task->starting_round);
+    std::vector<std::shared_ptr<const Task>> tasks;
+    TF_RETURN_IF_ERROR(
+        state_.TasksForIteration(iteration->iteration_id, tasks));
+    for (const auto& task : tasks) {
+      TaskInfo* task_info = response->mutable_task_info()->Add();
+      task_info->set_worker_address(task->worker_address);
+      task_info->set_transfer_address(task->transfer_address);
+      *task_info->mutable_worker_tags() = {task->worker_tags.begin(),
+                                           task->worker_tags.end()};
+      task_info->set_task_id(task->task_id);
+      task_info->set_iteration_id(iteration->iteration_id);
+      task_info->set_worker_uid(task->worker_uid);
+      task_info->set_starting_round(task->starting_round);
+    }
+    response->set_iteration_finished(iteration->finished);
+    response->set_deployment_mode(config_.deployment_mode());
   }
-  response->set_iteration_finished(iteration->finished);
-  response->set_deployment_mode(config_.deployment_mode());
+  // Sync any update applied above before responding, so that the client never
+  // acts on dispatcher state that could be lost on restart. Syncing outside
+  // `mu_` lets concurrent heartbeats share a single journal sync instead of
+  // serializing one sync each under the lock.
+  TF_RETURN_IF_ERROR(CommitJournal());
   VLOG(4) << "Found " << response->task_info_size()
           << " tasks for iteration client id "
           << request->iteration_client_id();
@@ -1075,38 +1101,87 @@ Status DataServiceDispatcherImpl::ApplyWithoutJournaling(const Update& update)
 Status DataServiceDispatcherImpl::Apply(const Update& update)
     TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   if (journal_writer_.has_value()) {
-    TF_RETURN_IF_ERROR(journal_writer_.value()->Write(update));
+    mutex_lock l(journal_mu_);
+    if (!journal_status_.ok()) {
+      return journal_status_;
+    }
+    pending_journal_updates_.push_back(update);
+    ++journal_updates_issued_;
   }
   return state_.Apply(update);
 }
 
+Status DataServiceDispatcherImpl::CommitJournal() {
+  std::vector<Update> batch;
+  int64_t batch_watermark;
+  {
+    mutex_lock l(journal_mu_);
+    int64_t target = journal_updates_issued_;
+    while (journal_updates_synced_ < target && journal_status_.ok() &&
+           journal_sync_in_progress_) {
+      journal_cv_.wait(l);
+    }
+    if (!journal_status_.ok()) {
+      return journal_status_;
+    }
+    if (journal_updates_synced_ >= target) {
+      return OkStatus();
+    }
+    // Become the sync leader, taking responsibility for everything buffered
+    // so far. Updates applied while the sync is in progress are picked up by
+    // the next leader.
+    journal_sync_in_progress_ = true;
+    batch.swap(pending_journal_updates_);
+    batch_watermark = journal_updates_issued_;
+  }
+  Status s = journal_writer_.value()->Write(batch);
+  {
+    mutex_lock l(journal_mu_);
+    journal_sync_in_progress_ = false;
+    journal_updates_synced_ = batch_watermark;
+    if (!s.ok()) {
+      journal_status_ = s;
+    }
+    journal_cv_.notify_all();
+  }
+  return s;
+}
+
 void DataServiceDispatcherImpl::IterationGcThread() {
   int64_t next_check_micros = 0;
   while (true) {
-    mutex_lock l(mu_);
-    while (!cancelled_ && env_->NowMicros() < next_check_micros) {
-      int64_t remaining_micros = next_check_micros - env_->NowMicros();
-      iteration_gc_thread_cv_.wait_for(
-          l, std::chrono::microseconds(remaining_micros));
-    }
-    if (cancelled_) {
-      return;
-    }
     {
-      Status s = ReleaseMissingClients();
-      if (!s.ok()) {
-        LOG(WARNING) << "Error releasing missing clients: " << s;
+      mutex_lock l(mu_);
+      while (!cancelled_ && env_->NowMicros() < next_check_micros) {
+        int64_t remaining_micros = next_check_micros - env_->NowMicros();
+        iteration_gc_thread_cv_.wait_for(
+            l, std::chrono::microseconds(remaining_micros));
+      }
+      if (cancelled_) {
+        return;
+      }
+      {
+        Status s = ReleaseMissingClients();
+        if (!s.ok()) {
+          LOG(WARNING) << "Error releasing missing clients: " << s;
+        }
       }
-    }
 
+      {
+        Status s = GcOldIterations();
+        if (!s.ok()) {
+          LOG(WARNING) << "Error garbage collecting old iterations: " << s;
+        }
+      }
+      next_check_micros =
+          env_->NowMicros() + (config_.job_gc_check_interval_ms() * 1000);
+    }
     {
-      Status s = GcOldIterations();
+      Status s = CommitJournal();
       if (!s.ok()) {
-        LOG(WARNING) << "Error garbage collecting old iterations: " << s;
+        LOG(WARNING) << "Error syncing the dispatcher journal: " << s;
       }
     }
-    next_check_micros =
-        env_->NowMicros() + (config_.job_gc_check_interval_ms() * 1000);
   }
 }
 
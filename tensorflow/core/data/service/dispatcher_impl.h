@@ -285,8 +285,18 @@ class DataServiceDispatcherImpl {
   Status RecordSplitProduced(int64_t iteration_id, int64_t repetition,
                              int64_t split_provider_index, bool finished)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
-  // Applies a state update, updating both the journal and the in-memory state.
+  // Applies a state update, updating the in-memory state and buffering the
+  // update for journaling. The update is not durable until `CommitJournal`
+  // returns; handlers must call `CommitJournal` after releasing `mu_` and
+  // before responding, so that clients never observe state that could be lost
+  // on dispatcher restart.
   Status Apply(const Update& update) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Blocks until every update buffered by `Apply` before this call has been
+  // synced to the journal, syncing a batch of buffered updates itself if no
+  // other thread is already doing so. Batching journal syncs this way lets
+  // many concurrent RPCs share a single file sync instead of serializing one
+  // sync per update under `mu_`.
+  Status CommitJournal() TF_LOCKS_EXCLUDED(mu_, journal_mu_);
   // Applies a state update, but doesn't update the journal. Only meant to be
   // used when recovering state when the dispatcher starts.
   Status ApplyWithoutJournaling(const Update& update)
@@ -334,8 +344,28 @@ class DataServiceDispatcherImpl {
   absl::flat_hash_map<int64_t, absl::Time> latest_client_heartbeats_time_
       TF_GUARDED_BY(mu_);
 
-  absl::optional<std::unique_ptr<JournalWriter>> journal_writer_
-      TF_GUARDED_BY(mu_);
+  // Set once in `Start` before the dispatcher serves requests. Afterwards the
+  // writer is only accessed by the journal sync leader, whose exclusivity is
+  // enforced by `journal_sync_in_progress_`.
+  absl::optional<std::unique_ptr<JournalWriter>> journal_writer_;
+  // Guards the journal group-commit state below. `journal_mu_` may be
+  // acquired while holding `mu_`, but never the other way around.
+  mutable mutex journal_mu_;
+  // Updates buffered by `Apply` but not yet synced to the journal, in the
+  // order they were applied to `state_`.
+  std::vector<Update> pending_journal_updates_ TF_GUARDED_BY(journal_mu_);
+  // Counts of journal updates buffered and synced, used by `CommitJournal` to
+  // tell when the updates a caller is waiting for have become durable.
+  int64_t journal_updates_issued_ TF_GUARDED_BY(journal_mu_) = 0;
+  int64_t journal_updates_synced_ TF_GUARDED_BY(journal_mu_) = 0;
+  // Whether some thread is currently writing a batch to the journal.
+  bool journal_sync_in_progress_ TF_GUARDED_BY(journal_mu_) = false;
+  // The first journal sync failure, if any. Once a sync fails, the journal
+  // may be missing updates that were already applied to `state_`, so all
+  // further journaled updates are failed with this status.
+  Status journal_status_ TF_GUARDED_BY(journal_mu_);
+  // Condition variable notified when a journal sync completes.
+  condition_variable journal_cv_;
   DispatcherState state_ TF_GUARDED_BY(mu_);
   // Condition variable for waking up the iteration gc thread.
   condition_variable iteration_gc_thread_cv_;
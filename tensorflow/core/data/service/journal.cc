@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "tensorflow/core/data/service/journal.pb.h"
@@ -43,6 +44,13 @@ Status ParseSequenceNumber(const std::string& journal_file,
 }
 }  // namespace
 
+Status JournalWriter::Write(const std::vector<Update>& updates) {
+  for (const Update& update : updates) {
+    TF_RETURN_IF_ERROR(Write(update));
+  }
+  return OkStatus();
+}
+
 std::string DataServiceJournalFile(const std::string& journal_dir,
                                    int64_t sequence_number) {
   return io::JoinPath(journal_dir,
@@ -73,22 +81,40 @@ Status FileJournalWriter::EnsureInitialized() {
   return OkStatus();
 }
 
-Status FileJournalWriter::Write(const Update& update) {
-  TF_RETURN_IF_ERROR(EnsureInitialized());
+Status FileJournalWriter::AppendRecord(const Update& update) {
   std::string s = update.SerializeAsString();
   if (s.empty()) {
     return errors::Internal("Failed to serialize update ", update.DebugString(),
                             " to string");
   }
   TF_RETURN_IF_ERROR(writer_->WriteRecord(s));
-  TF_RETURN_IF_ERROR(writer_->Flush());
-  TF_RETURN_IF_ERROR(file_->Sync());
   if (VLOG_IS_ON(4)) {
     VLOG(4) << "Wrote journal entry: " << update.DebugString();
   }
   return OkStatus();
 }
 
+Status FileJournalWriter::Write(const Update& update) {
+  TF_RETURN_IF_ERROR(EnsureInitialized());
+  TF_RETURN_IF_ERROR(AppendRecord(update));
+  TF_RETURN_IF_ERROR(writer_->Flush());
+  TF_RETURN_IF_ERROR(file_->Sync());
+  return OkStatus();
+}
+
+Status FileJournalWriter::Write(const std::vector<Update>& updates) {
+  if (updates.empty()) {
+    return OkStatus();
+  }
+  TF_RETURN_IF_ERROR(EnsureInitialized());
+  for (const Update& update : updates) {
+    TF_RETURN_IF_ERROR(AppendRecord(update));
+  }
+  TF_RETURN_IF_ERROR(writer_->Flush());
+  TF_RETURN_IF_ERROR(file_->Sync());
+  return OkStatus();
+}
+
 FileJournalReader::FileJournalReader(Env* env, StringPiece journal_dir)
     : env_(env), journal_dir_(journal_dir) {}
 
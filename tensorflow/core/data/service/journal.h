@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_DATA_SERVICE_JOURNAL_H_
 
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/data/service/journal.pb.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -36,6 +37,10 @@ class JournalWriter {
   virtual ~JournalWriter() = default;
   // Writes and syncs an update to the journal.
   virtual Status Write(const Update& update) = 0;
+  // Writes and syncs a batch of updates to the journal, in order. The default
+  // implementation writes and syncs the updates one at a time;
+  // implementations may override this to sync once per batch.
+  virtual Status Write(const std::vector<Update>& updates);
   // Initializes the writer if it is not yet initialized.
   virtual Status EnsureInitialized() = 0;
 };
@@ -66,9 +71,16 @@ class FileJournalWriter : public JournalWriter {
   FileJournalWriter& operator=(const FileJournalWriter&) = delete;
 
   Status Write(const Update& update) override;
+  // Writes the batch as a single journal append, flushing and syncing once
+  // for the whole batch rather than once per update.
+  Status Write(const std::vector<Update>& updates) override;
   Status EnsureInitialized() override;
 
  private:
+  // Serializes `update` and appends it to the current journal file, without
+  // flushing or syncing.
+  Status AppendRecord(const Update& update);
+
   Env* env_;
   const std::string journal_dir_;
   std::unique_ptr<WritableFile> file_;
@@ -0,0 +1,592 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shared_memory_transfer.h"
+
+#if !defined(PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // PLATFORM_WINDOWS
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/data/dataset.pb.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/platform.h"
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr uint64 kSegmentMagic = 0x7464736d656d7472ULL;
+constexpr uint32 kSegmentVersion = 1;
+
+constexpr int64_t kDefaultNumSlots = 4;
+constexpr int64_t kDefaultSlotBytes = 16 << 20;  // 16 MiB
+
+// Interval at which waiting sides re-check slot states, and staleness bound
+// after which a client considers the serving process dead.
+constexpr int64_t kPollMicros = 100;
+constexpr int64_t kHeartbeatTimeoutMicros = 10 * 1000 * 1000;
+
+// Slot states for the request/response handshake. A slot cycles
+// kFree -> kWritingRequest -> kRequestReady -> kProcessing -> kResponseReady
+// -> kFree. States live in lock-free atomics inside the shared segment, so
+// the handshake works across process boundaries.
+enum SlotState : uint32 {
+  kFree = 0,
+  kWritingRequest = 1,
+  kRequestReady = 2,
+  kProcessing = 3,
+  kResponseReady = 4,
+};
+
+// Lives at the start of the segment. The server writes the geometry once at
+// creation; clients validate the magic and version before using the ring.
+struct SegmentHeader {
+  uint64 magic;
+  uint32 version;
+  uint32 num_slots;
+  uint64 slot_bytes;
+  std::atomic<int64_t> heartbeat_micros;
+};
+
+// Precedes each slot's payload area, on its own cache line.
+struct SlotHeader {
+  std::atomic<uint32> state;
+  uint32 unused;
+  uint64 payload_size;
+};
+
+constexpr size_t kHeaderReservedBytes = 64;
+constexpr size_t kSlotHeaderReservedBytes = 64;
+
+static_assert(sizeof(SegmentHeader) <= kHeaderReservedBytes,
+              "SegmentHeader exceeds its reserved space");
+static_assert(sizeof(SlotHeader) <= kSlotHeaderReservedBytes,
+              "SlotHeader exceeds its reserved space");
+
+size_t SegmentBytes(int64_t num_slots, int64_t slot_bytes) {
+  return kHeaderReservedBytes +
+         num_slots * (kSlotHeaderReservedBytes + slot_bytes);
+}
+
+SlotHeader* GetSlotHeader(char* base, const SegmentHeader& header, int slot) {
+  return reinterpret_cast<SlotHeader*>(
+      base + kHeaderReservedBytes +
+      slot * (kSlotHeaderReservedBytes + header.slot_bytes));
+}
+
+char* GetSlotPayload(SlotHeader* slot_header) {
+  return reinterpret_cast<char*>(slot_header) + kSlotHeaderReservedBytes;
+}
+
+void EncodeFixed64At(char** position, uint64 value) {
+  core::EncodeFixed64(*position, value);
+  *position += sizeof(uint64);
+}
+
+uint64 DecodeFixed64At(const char** position) {
+  uint64 value = core::DecodeFixed64(*position);
+  *position += sizeof(uint64);
+  return value;
+}
+
+// Encodes `status` and (if OK) `result` into the slot payload:
+//
+//   fixed64 status code, fixed64 message size, message bytes,
+//   fixed64 element index, byte end_of_sequence, byte skip,
+//   fixed64 component count, then per component a fixed64 metadata size, a
+//   serialized `CompressedComponentMetadata`, and the raw tensor bytes
+//   (the buffer contents for memcpy-able dtypes, a serialized `TensorProto`
+//   otherwise).
+//
+// If the encoding does not fit in `capacity`, encodes a ResourceExhausted
+// error instead so that the client gets an actionable failure.
+void EncodeResult(const Status& status, const GetElementResult& result,
+                  size_t capacity, char* payload, uint64* payload_size) {
+  struct EncodedComponent {
+    std::string metadata;  // Serialized CompressedComponentMetadata.
+    std::string proto;     // Serialized TensorProto, for complex dtypes.
+    const char* data = nullptr;
+    size_t size = 0;
+  };
+
+  Status encoded_status = status;
+  std::vector<EncodedComponent> components;
+  size_t total_size = 0;
+  if (encoded_status.ok()) {
+    components.reserve(result.components.size());
+    for (const Tensor& tensor : result.components) {
+      EncodedComponent component;
+      CompressedComponentMetadata metadata;
+      metadata.set_dtype(tensor.dtype());
+      tensor.shape().AsProto(metadata.mutable_tensor_shape());
+      if (DataTypeCanUseMemcpy(tensor.dtype())) {
+        const TensorBuffer* buffer = DMAHelper::buffer(&tensor);
+        if (buffer) {
+          component.data = static_cast<const char*>(buffer->data());
+          component.size = buffer->size();
+        }
+      } else {
+        TensorProto proto;
+        tensor.AsProtoTensorContent(&proto);
+        proto.SerializeToString(&component.proto);
+        component.data = component.proto.data();
+        component.size = component.proto.size();
+      }
+      metadata.set_tensor_size_bytes(component.size);
+      metadata.SerializeToString(&component.metadata);
+      total_size +=
+          sizeof(uint64) + component.metadata.size() + component.size;
+      components.push_back(std::move(component));
+    }
+    const size_t fixed_size = 3 * sizeof(uint64) + 2 + sizeof(uint64) +
+                              encoded_status.error_message().size();
+    if (fixed_size + total_size > capacity) {
+      encoded_status = errors::ResourceExhausted(
+          "Element of size ", fixed_size + total_size,
+          " bytes does not fit in a shared memory transfer slot of ", capacity,
+          " bytes. Increase TF_DATA_SHM_TRANSFER_SLOT_BYTES on the worker.");
+      components.clear();
+    }
+  }
+
+  char* position = payload;
+  EncodeFixed64At(&position, static_cast<uint64>(encoded_status.code()));
+  const std::string message(encoded_status.error_message());
+  EncodeFixed64At(&position, message.size());
+  memcpy(position, message.data(), message.size());
+  position += message.size();
+  EncodeFixed64At(&position, static_cast<uint64>(result.element_index));
+  *position++ = result.end_of_sequence ? 1 : 0;
+  *position++ = result.skip ? 1 : 0;
+  EncodeFixed64At(&position, components.size());
+  for (const EncodedComponent& component : components) {
+    EncodeFixed64At(&position, component.metadata.size());
+    memcpy(position, component.metadata.data(), component.metadata.size());
+    position += component.metadata.size();
+    if (component.data) {
+      memcpy(position, component.data, component.size);
+    }
+    position += component.size;
+  }
+  *payload_size = position - payload;
+}
+
+// Decodes a payload written by `EncodeResult`.
+Status DecodeResult(const char* payload, size_t payload_size,
+                    GetElementResult& result) {
+  const char* position = payload;
+  const error::Code code =
+      static_cast<error::Code>(DecodeFixed64At(&position));
+  const size_t message_size = DecodeFixed64At(&position);
+  std::string message(position, message_size);
+  position += message_size;
+  if (code != error::OK) {
+    return Status(code, message);
+  }
+  result.element_index = static_cast<int64_t>(DecodeFixed64At(&position));
+  result.end_of_sequence = *position++ != 0;
+  result.skip = *position++ != 0;
+  const size_t num_components = DecodeFixed64At(&position);
+  result.components.clear();
+  result.components.reserve(num_components);
+  for (size_t i = 0; i < num_components; ++i) {
+    const size_t metadata_size = DecodeFixed64At(&position);
+    CompressedComponentMetadata metadata;
+    if (!metadata.ParseFromArray(position, metadata_size)) {
+      return errors::Internal(
+          "Failed to parse component metadata from shared memory transfer.");
+    }
+    position += metadata_size;
+    if (DataTypeCanUseMemcpy(metadata.dtype())) {
+      result.components.emplace_back(metadata.dtype(),
+                                     TensorShape(metadata.tensor_shape()));
+      TensorBuffer* buffer = DMAHelper::buffer(&result.components.back());
+      if (buffer) {
+        memcpy(buffer->data(), position, metadata.tensor_size_bytes());
+      }
+    } else {
+      TensorProto proto;
+      if (!proto.ParseFromArray(position, metadata.tensor_size_bytes())) {
+        return errors::Internal(
+            "Failed to parse tensor proto from shared memory transfer.");
+      }
+      result.components.emplace_back();
+      if (!result.components.back().FromProto(proto)) {
+        return errors::Internal(
+            "Failed to construct tensor from shared memory transfer.");
+      }
+    }
+    position += metadata.tensor_size_bytes();
+  }
+  if (position != payload + payload_size) {
+    return errors::Internal(
+        "Malformed shared memory transfer payload: expected ", payload_size,
+        " bytes but consumed ", position - payload, ".");
+  }
+  return OkStatus();
+}
+
+#if !defined(PLATFORM_WINDOWS)
+
+class SharedMemoryTransferServer : public DataTransferServer {
+ public:
+  explicit SharedMemoryTransferServer(GetElementT get_element)
+      : get_element_(std::move(get_element)) {}
+
+  ~SharedMemoryTransferServer() override {
+    {
+      mutex_lock l(mu_);
+      cancelled_ = true;
+    }
+    serve_thread_.reset();
+    if (base_ != nullptr) {
+      munmap(base_, segment_bytes_);
+      base_ = nullptr;
+    }
+    if (!segment_name_.empty()) {
+      shm_unlink(segment_name_.c_str());
+    }
+  }
+
+  Status Start() override {
+    int64_t num_slots = kDefaultNumSlots;
+    TF_RETURN_IF_ERROR(ReadInt64FromEnvVar("TF_DATA_SHM_TRANSFER_SLOTS",
+                                           kDefaultNumSlots, &num_slots));
+    int64_t slot_bytes = kDefaultSlotBytes;
+    TF_RETURN_IF_ERROR(ReadInt64FromEnvVar("TF_DATA_SHM_TRANSFER_SLOT_BYTES",
+                                           kDefaultSlotBytes, &slot_bytes));
+    if (num_slots < 1 || slot_bytes < (1 << 20)) {
+      return errors::InvalidArgument(
+          "Shared memory transfer requires at least 1 slot of at least 1 MiB; "
+          "got ",
+          num_slots, " slots of ", slot_bytes, " bytes.");
+    }
+
+    // The id doubles as the transfer server "port": it is substituted into
+    // the worker's advertised data transfer address, from which clients
+    // derive the segment name.
+    id_ = 1 + static_cast<int>(random::New64() % ((1LL << 30) - 1));
+    segment_name_ = strings::StrCat("/tfshm_", id_);
+    shm_unlink(segment_name_.c_str());  // Remove any stale segment.
+    int fd = shm_open(segment_name_.c_str(), O_CREAT | O_EXCL | O_RDWR,
+                      S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      return errors::Internal("Failed to create shared memory segment ",
+                              segment_name_, ": ", strerror(errno));
+    }
+    segment_bytes_ = SegmentBytes(num_slots, slot_bytes);
+    if (ftruncate(fd, segment_bytes_) != 0) {
+      close(fd);
+      return errors::Internal("Failed to size shared memory segment ",
+                              segment_name_, ": ", strerror(errno));
+    }
+    base_ = static_cast<char*>(mmap(nullptr, segment_bytes_,
+                                    PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                                    /*offset=*/0));
+    close(fd);
+    if (base_ == MAP_FAILED) {
+      base_ = nullptr;
+      return errors::Internal("Failed to map shared memory segment ",
+                              segment_name_, ": ", strerror(errno));
+    }
+
+    auto* header = reinterpret_cast<SegmentHeader*>(base_);
+    header->version = kSegmentVersion;
+    header->num_slots = num_slots;
+    header->slot_bytes = slot_bytes;
+    header->heartbeat_micros.store(
+        static_cast<int64_t>(Env::Default()->NowMicros()),
+        std::memory_order_relaxed);
+    for (int i = 0; i < num_slots; ++i) {
+      GetSlotHeader(base_, *header, i)->state.store(kFree,
+                                                    std::memory_order_relaxed);
+    }
+    // Publish the magic last: a client that sees it can rely on the rest of
+    // the header being initialized.
+    header->magic = kSegmentMagic;
+
+    serve_thread_ = absl::WrapUnique(Env::Default()->StartThread(
+        ThreadOptions(), "tf_data_shm_transfer", [this]() { Serve(); }));
+    LOG(INFO) << "Started shared memory data transfer server with segment "
+              << segment_name_ << " (" << num_slots << " slots of "
+              << slot_bytes << " bytes).";
+    return OkStatus();
+  }
+
+  int get_port() override { return id_; }
+
+ private:
+  void Serve() {
+    auto* header = reinterpret_cast<SegmentHeader*>(base_);
+    while (true) {
+      {
+        mutex_lock l(mu_);
+        if (cancelled_) {
+          return;
+        }
+      }
+      header->heartbeat_micros.store(
+          static_cast<int64_t>(Env::Default()->NowMicros()),
+          std::memory_order_relaxed);
+      bool served = false;
+      for (uint32 i = 0; i < header->num_slots; ++i) {
+        SlotHeader* slot = GetSlotHeader(base_, *header, i);
+        uint32 expected = kRequestReady;
+        if (!slot->state.compare_exchange_strong(expected, kProcessing,
+                                                 std::memory_order_acq_rel)) {
+          continue;
+        }
+        served = true;
+        char* payload = GetSlotPayload(slot);
+        GetElementRequest req;
+        GetElementResult result;
+        Status s;
+        if (!req.ParseFromArray(payload, slot->payload_size)) {
+          s = errors::InvalidArgument(
+              "Failed to parse GetElementRequest from shared memory "
+              "transfer.");
+        } else {
+          s = get_element_(&req, &result);
+        }
+        EncodeResult(s, result, header->slot_bytes, payload,
+                     &slot->payload_size);
+        slot->state.store(kResponseReady, std::memory_order_release);
+      }
+      if (!served) {
+        Env::Default()->SleepForMicroseconds(kPollMicros);
+      }
+    }
+  }
+
+  const GetElementT get_element_;
+  int id_ = 0;
+  std::string segment_name_;
+  size_t segment_bytes_ = 0;
+  char* base_ = nullptr;
+
+  mutex mu_;
+  bool cancelled_ TF_GUARDED_BY(mu_) = false;
+
+  // This has to be last so that the serving thread is joined before the
+  // members it uses are destroyed.
+  std::unique_ptr<Thread> serve_thread_;
+};
+
+class SharedMemoryDataTransferClient : public DataTransferClient {
+ public:
+  ~SharedMemoryDataTransferClient() override {
+    if (base_ != nullptr) {
+      munmap(base_, segment_bytes_);
+    }
+  }
+
+  // Maps the segment advertised through `address`. Fails if the segment does
+  // not exist on this host, which is how non-colocated clients are detected.
+  Status Attach(const std::string& address) {
+    const std::string segment_name = SharedMemorySegmentName(address);
+    if (segment_name.empty()) {
+      return errors::InvalidArgument(
+          "Cannot derive a shared memory segment name from transfer address ",
+          address);
+    }
+    int fd = shm_open(segment_name.c_str(), O_RDWR, /*mode=*/0);
+    if (fd < 0) {
+      return errors::Unavailable(
+          "No shared memory segment ", segment_name, " for worker ", address,
+          " on this host: ", strerror(errno),
+          ". The worker is either not colocated or not serving.");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      return errors::Internal("Failed to stat shared memory segment ",
+                              segment_name, ": ", strerror(errno));
+    }
+    segment_bytes_ = st.st_size;
+    base_ = static_cast<char*>(mmap(nullptr, segment_bytes_,
+                                    PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                                    /*offset=*/0));
+    close(fd);
+    if (base_ == MAP_FAILED) {
+      base_ = nullptr;
+      return errors::Internal("Failed to map shared memory segment ",
+                              segment_name, ": ", strerror(errno));
+    }
+    auto* header = reinterpret_cast<SegmentHeader*>(base_);
+    if (header->magic != kSegmentMagic) {
+      return errors::Unavailable("Shared memory segment ", segment_name,
+                                 " is not initialized.");
+    }
+    if (header->version != kSegmentVersion) {
+      return errors::FailedPrecondition(
+          "Shared memory segment ", segment_name, " has version ",
+          header->version, " but this client speaks version ",
+          kSegmentVersion);
+    }
+    if (SegmentBytes(header->num_slots, header->slot_bytes) > segment_bytes_) {
+      return errors::Internal("Shared memory segment ", segment_name,
+                              " is smaller than its header claims.");
+    }
+    VLOG(2) << "Attached to shared memory segment " << segment_name
+            << " for worker " << address << ".";
+    return OkStatus();
+  }
+
+  Status GetElement(const GetElementRequest& req,
+                    GetElementResult& result) override {
+    VLOG(3) << "GetElement for task " << req.task_id()
+            << " over shared memory.";
+    auto* header = reinterpret_cast<SegmentHeader*>(base_);
+    const std::string serialized_req = req.SerializeAsString();
+    if (serialized_req.size() > header->slot_bytes) {
+      return errors::InvalidArgument(
+          "GetElementRequest does not fit in a shared memory transfer slot.");
+    }
+
+    // Claim a free slot.
+    SlotHeader* slot = nullptr;
+    while (slot == nullptr) {
+      TF_RETURN_IF_ERROR(CheckNotCancelledOrDead(*header));
+      for (uint32 i = 0; i < header->num_slots; ++i) {
+        SlotHeader* candidate = GetSlotHeader(base_, *header, i);
+        uint32 expected = kFree;
+        if (candidate->state.compare_exchange_strong(
+                expected, kWritingRequest, std::memory_order_acq_rel)) {
+          slot = candidate;
+          break;
+        }
+      }
+      if (slot == nullptr) {
+        Env::Default()->SleepForMicroseconds(kPollMicros);
+      }
+    }
+
+    memcpy(GetSlotPayload(slot), serialized_req.data(), serialized_req.size());
+    slot->payload_size = serialized_req.size();
+    slot->state.store(kRequestReady, std::memory_order_release);
+
+    // Wait for the server's response.
+    while (slot->state.load(std::memory_order_acquire) != kResponseReady) {
+      Status s = CheckNotCancelledOrDead(*header);
+      if (!s.ok()) {
+        // The slot cannot be safely reused: the server may still write to it.
+        return s;
+      }
+      Env::Default()->SleepForMicroseconds(kPollMicros);
+    }
+    Status s = DecodeResult(GetSlotPayload(slot), slot->payload_size, result);
+    slot->state.store(kFree, std::memory_order_release);
+    return s;
+  }
+
+  void TryCancel() override {
+    VLOG(2) << "Cancel SharedMemoryDataTransferClient.";
+    mutex_lock l(mu_);
+    cancelled_ = true;
+  }
+
+ private:
+  Status CheckNotCancelledOrDead(const SegmentHeader& header)
+      TF_LOCKS_EXCLUDED(mu_) {
+    {
+      mutex_lock l(mu_);
+      if (cancelled_) {
+        return errors::Cancelled("Client was cancelled.");
+      }
+    }
+    const int64_t heartbeat =
+        header.heartbeat_micros.load(std::memory_order_relaxed);
+    const int64_t now = static_cast<int64_t>(Env::Default()->NowMicros());
+    if (now - heartbeat > kHeartbeatTimeoutMicros) {
+      return errors::Unavailable(
+          "Shared memory transfer server stopped responding (last heartbeat ",
+          (now - heartbeat) / 1000000, "s ago).");
+    }
+    return OkStatus();
+  }
+
+  size_t segment_bytes_ = 0;
+  char* base_ = nullptr;
+
+  mutex mu_;
+  bool cancelled_ TF_GUARDED_BY(mu_) = false;
+};
+
+#endif  // PLATFORM_WINDOWS
+
+class SharedMemoryTransferRegistrar {
+ public:
+  SharedMemoryTransferRegistrar() {
+#if !defined(PLATFORM_WINDOWS)
+    DataTransferServer::Register(
+        kSharedMemoryTransferProtocol,
+        [](DataTransferServer::GetElementT get_element) {
+          return std::make_shared<SharedMemoryTransferServer>(
+              std::move(get_element));
+        });
+    DataTransferClient::Register(
+        kSharedMemoryTransferProtocol,
+        [](DataTransferClient::Config config,
+           std::unique_ptr<DataTransferClient>* out) {
+          auto client = absl::make_unique<SharedMemoryDataTransferClient>();
+          TF_RETURN_IF_ERROR(client->Attach(config.address));
+          *out = std::move(client);
+          return OkStatus();
+        });
+#endif  // PLATFORM_WINDOWS
+  }
+};
+static SharedMemoryTransferRegistrar shared_memory_registrar;
+
+}  // namespace
+
+std::string SharedMemorySegmentName(const std::string& transfer_address) {
+  const size_t colon = transfer_address.rfind(':');
+  if (colon == std::string::npos) {
+    return "";
+  }
+  int64_t port = 0;
+  if (!absl::SimpleAtoi(transfer_address.substr(colon + 1), &port) ||
+      port <= 0) {
+    return "";
+  }
+  return strings::StrCat("/tfshm_", port);
+}
+
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,53 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_TRANSFER_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_TRANSFER_H_
+
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/platform/status.h"
+
+namespace tensorflow {
+namespace data {
+
+// Name under which the shared-memory data transfer implementation is
+// registered with the `DataTransferClient`/`DataTransferServer` factories.
+//
+// The transfer moves elements between a tf.data service worker and a
+// colocated trainer process through a ring of slots in a POSIX shared memory
+// segment, avoiding protobuf serialization over loopback TCP. The segment
+// name is derived from the worker's advertised data transfer address, so a
+// client on the same host attaches with nothing but the address it got from
+// the dispatcher; a client on a different host fails to attach and
+// `DataServiceWorkerClient` falls back to gRPC.
+//
+// To enable, start the worker with data_transfer_protocol = "shared_memory"
+// and data_transfer_address set to the worker's address. The ring geometry
+// can be tuned with the TF_DATA_SHM_TRANSFER_SLOTS and
+// TF_DATA_SHM_TRANSFER_SLOT_BYTES environment variables on the worker;
+// clients read the geometry from the segment header.
+constexpr const char kSharedMemoryTransferProtocol[] = "shared_memory";
+
+// Returns the shared memory segment name used for the worker advertising
+// `transfer_address`. Exposed for testing.
+std::string SharedMemorySegmentName(const std::string& transfer_address);
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_TRANSFER_H_
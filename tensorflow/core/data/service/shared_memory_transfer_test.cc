@@ -0,0 +1,114 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shared_memory_transfer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/data/dataset_test_base.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/platform.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+#if !defined(PLATFORM_WINDOWS)
+
+class SharedMemoryTransferTest : public DatasetOpsTestBase {};
+
+TEST_F(SharedMemoryTransferTest, SegmentNameFromAddress) {
+  EXPECT_EQ(SharedMemorySegmentName("localhost:1234"), "/tfshm_1234");
+  EXPECT_EQ(SharedMemorySegmentName("no_port"), "");
+  EXPECT_EQ(SharedMemorySegmentName("host:not_a_port"), "");
+}
+
+TEST_F(SharedMemoryTransferTest, RoundTrip) {
+  std::vector<Tensor> element = {
+      CreateTensor<int64_t>(TensorShape{2}, {1, 2}),
+      CreateTensor<tstring>(TensorShape{1}, {"hello"})};
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [&element](const GetElementRequest* req, GetElementResult* result) {
+        result->components = element;
+        result->element_index = 7;
+        result->end_of_sequence = false;
+        return OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start());
+
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(DataTransferClient::Build(
+      kSharedMemoryTransferProtocol,
+      {/*protocol=*/"grpc",
+       /*address=*/strings::StrCat("localhost:", server->get_port())},
+      &client));
+
+  GetElementRequest req;
+  GetElementResult result;
+  TF_ASSERT_OK(client->GetElement(req, result));
+  EXPECT_EQ(result.element_index, 7);
+  EXPECT_FALSE(result.end_of_sequence);
+  TF_EXPECT_OK(ExpectEqual(element, result.components,
+                           /*compare_order=*/true));
+}
+
+TEST_F(SharedMemoryTransferTest, ServerErrorIsPropagated) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* req, GetElementResult* result) {
+        return errors::FailedPrecondition("test error");
+      },
+      &server));
+  TF_ASSERT_OK(server->Start());
+
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(DataTransferClient::Build(
+      kSharedMemoryTransferProtocol,
+      {/*protocol=*/"grpc",
+       /*address=*/strings::StrCat("localhost:", server->get_port())},
+      &client));
+
+  GetElementRequest req;
+  GetElementResult result;
+  Status s = client->GetElement(req, result);
+  EXPECT_EQ(s.code(), error::FAILED_PRECONDITION);
+}
+
+TEST_F(SharedMemoryTransferTest, AttachFailsWithoutServer) {
+  std::unique_ptr<DataTransferClient> client;
+  Status s = DataTransferClient::Build(
+      kSharedMemoryTransferProtocol,
+      {/*protocol=*/"grpc", /*address=*/"localhost:1"}, &client);
+  EXPECT_EQ(s.code(), error::UNAVAILABLE);
+}
+
+#endif  // PLATFORM_WINDOWS
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -44,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/snapshot.pb.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -58,6 +59,80 @@ constexpr const char* const kCurrentCheckpointID = "current_checkpoint_id";
 constexpr const char* const kIndex = "index";
 constexpr const char* const kStartIndex = "start_index";
 
+// Whether `Writer::Create` may return a `PipelinedWriter` for configurations
+// the pipelined implementation supports. Serves as a kill switch.
+bool PipelinedWriteEnabled() {
+  static const bool result = [] {
+    bool enabled = true;
+    Status s = ReadBoolFromEnvVar("TF_DATA_SNAPSHOT_PIPELINED_WRITE",
+                                  /*default_val=*/true, &enabled);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to parse TF_DATA_SNAPSHOT_PIPELINED_WRITE: "
+                   << s.error_message();
+    }
+    return enabled;
+  }();
+  return result;
+}
+
+// Serializes `tensors` into the payload of a version 1 snappy-compressed
+// snapshot element: `metadata_str` receives the serialized
+// `SnapshotTensorMetadata` record and `uncompressed` the concatenated tensor
+// data, which is snappy-compressed before being written.
+Status SerializeElementPayload(const std::vector<Tensor>& tensors,
+                               const std::vector<bool>& simple_tensor_mask,
+                               int num_simple, int num_complex,
+                               std::string* metadata_str,
+                               std::vector<char>* uncompressed) {
+  std::vector<const TensorBuffer*> tensor_buffers;
+  tensor_buffers.reserve(num_simple);
+  std::vector<TensorProto> tensor_protos;
+  tensor_protos.reserve(num_complex);
+  experimental::SnapshotTensorMetadata metadata;
+  int64_t total_size = 0;
+  for (int i = 0, end = tensors.size(); i < end; ++i) {
+    const Tensor& tensor = tensors[i];
+    experimental::TensorMetadata* tensor_metadata =
+        metadata.add_tensor_metadata();
+    tensor.shape().AsProto(tensor_metadata->mutable_tensor_shape());
+    int64_t size = 0;
+    if (simple_tensor_mask[i]) {
+      auto tensor_buffer = DMAHelper::buffer(&tensor);
+      tensor_buffers.push_back(tensor_buffer);
+      size = tensor_buffer->size();
+    } else {
+      TensorProto proto;
+      tensor.AsProtoTensorContent(&proto);
+      size = proto.ByteSizeLong();
+      tensor_protos.push_back(std::move(proto));
+    }
+    tensor_metadata->set_tensor_size_bytes(size);
+    total_size += size;
+  }
+
+  uncompressed->resize(total_size);
+  char* position = uncompressed->data();
+  int buffer_index = 0;
+  int proto_index = 0;
+  for (int i = 0, end = tensors.size(); i < end; ++i) {
+    const auto& tensor_metadata = metadata.tensor_metadata(i);
+    if (simple_tensor_mask[i]) {
+      memcpy(position, tensor_buffers[buffer_index]->data(),
+             tensor_metadata.tensor_size_bytes());
+      buffer_index++;
+    } else {
+      tensor_protos[proto_index].SerializeToArray(
+          position, tensor_metadata.tensor_size_bytes());
+      proto_index++;
+    }
+    position += tensor_metadata.tensor_size_bytes();
+  }
+  DCHECK_EQ(position, uncompressed->data() + total_size);
+
+  metadata.SerializeToString(metadata_str);
+  return OkStatus();
+}
+
 }  // namespace
 
 /* static */ constexpr const int64_t
@@ -101,6 +176,14 @@ Status Writer::Create(Env* env, const std::string& filename,
                       std::unique_ptr<Writer>* out_writer) {
   switch (version) {
     case 1:
+#if !defined(IS_SLIM_BUILD)
+      if (compression_type == io::compression::kSnappy &&
+          PipelinedWriteEnabled()) {
+        *out_writer = absl::make_unique<PipelinedWriter>(
+            filename, compression_type, dtypes);
+        break;
+      }
+#endif  // IS_SLIM_BUILD
       *out_writer =
           absl::make_unique<CustomWriter>(filename, compression_type, dtypes);
       break;
@@ -130,24 +213,19 @@ Status TFRecordWriter::Initialize(tensorflow::Env* env) {
 }
 
 Status TFRecordWriter::WriteTensors(const std::vector<Tensor>& tensors) {
-  for (const auto& tensor : tensors) {
+  // Serialize all tensors of the element first so the record writer can
+  // frame and append them as a single batch instead of three appends per
+  // tensor.
+  std::vector<std::string> serialized(tensors.size());
+  std::vector<StringPiece> records;
+  records.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
     TensorProto proto;
-    tensor.AsProtoTensorContent(&proto);
-#if defined(TF_CORD_SUPPORT)
-    // Creating raw pointer here because std::move() in a releases in OSS TF
-    // will result in a smart pointer being moved upon function creation, which
-    // will result in proto_buffer == nullptr when WriteRecord happens.
-    auto proto_buffer = new std::string();
-    proto.SerializeToString(proto_buffer);
-    absl::Cord proto_serialized = absl::MakeCordFromExternal(
-        *proto_buffer,
-        [proto_buffer](absl::string_view) { delete proto_buffer; });
-    TF_RETURN_IF_ERROR(record_writer_->WriteRecord(proto_serialized));
-#else   // TF_CORD_SUPPORT
-    TF_RETURN_IF_ERROR(record_writer_->WriteRecord(proto.SerializeAsString()));
-#endif  // TF_CORD_SUPPORT
+    tensors[i].AsProtoTensorContent(&proto);
+    proto.SerializeToString(&serialized[i]);
+    records.push_back(serialized[i]);
   }
-  return OkStatus();
+  return record_writer_->WriteRecords(records);
 }
 
 Status TFRecordWriter::Sync() {
@@ -233,65 +311,19 @@ Status CustomWriter::WriteTensors(const std::vector<Tensor>& tensors) {
 #endif  // TF_CORD_SUPPORT
   }
 
-  std::vector<const TensorBuffer*> tensor_buffers;
-  tensor_buffers.reserve(num_simple_);
-  std::vector<TensorProto> tensor_protos;
-  tensor_protos.reserve(num_complex_);
-  experimental::SnapshotTensorMetadata metadata;
-  int64_t total_size = 0;
-  for (int i = 0, end = tensors.size(); i < end; ++i) {
-    const Tensor& tensor = tensors[i];
-    experimental::TensorMetadata* tensor_metadata =
-        metadata.add_tensor_metadata();
-    tensor.shape().AsProto(tensor_metadata->mutable_tensor_shape());
-    int64_t size = 0;
-    if (simple_tensor_mask_[i]) {
-      auto tensor_buffer = DMAHelper::buffer(&tensor);
-      tensor_buffers.push_back(tensor_buffer);
-      size = tensor_buffer->size();
-    } else {
-      TensorProto proto;
-      tensor.AsProtoTensorContent(&proto);
-      size = proto.ByteSizeLong();
-      tensor_protos.push_back(std::move(proto));
-    }
-    tensor_metadata->set_tensor_size_bytes(size);
-    total_size += size;
-  }
-
-  std::vector<char> uncompressed(total_size);
-  char* position = uncompressed.data();
-  int buffer_index = 0;
-  int proto_index = 0;
-  for (int i = 0, end = tensors.size(); i < end; ++i) {
-    const auto& tensor_metadata = metadata.tensor_metadata(i);
-    if (simple_tensor_mask_[i]) {
-      memcpy(position, tensor_buffers[buffer_index]->data(),
-             tensor_metadata.tensor_size_bytes());
-      buffer_index++;
-    } else {
-      tensor_protos[proto_index].SerializeToArray(
-          position, tensor_metadata.tensor_size_bytes());
-      proto_index++;
-    }
-    position += tensor_metadata.tensor_size_bytes();
-  }
-  DCHECK_EQ(position, uncompressed.data() + total_size);
+  std::string metadata_serialized;
+  std::vector<char> uncompressed;
+  TF_RETURN_IF_ERROR(SerializeElementPayload(tensors, simple_tensor_mask_,
+                                             num_simple_, num_complex_,
+                                             &metadata_serialized,
+                                             &uncompressed));
 
   string output;
-  if (!port::Snappy_Compress(uncompressed.data(), total_size, &output)) {
+  if (!port::Snappy_Compress(uncompressed.data(), uncompressed.size(),
+                             &output)) {
     return errors::Internal("Failed to compress using snappy.");
   }
 
-#if defined(TF_CORD_SUPPORT)
-  auto metadata_buffer = new std::string();
-  metadata.SerializeToString(metadata_buffer);
-  absl::Cord metadata_serialized = absl::MakeCordFromExternal(
-      *metadata_buffer,
-      [metadata_buffer](absl::string_view) { delete metadata_buffer; });
-#else
-  std::string metadata_serialized = metadata.SerializeAsString();
-#endif  // TF_CORD_SUPPORT
   TF_RETURN_IF_ERROR(WriteRecord(metadata_serialized));
   TF_RETURN_IF_ERROR(WriteRecord(output));
   return OkStatus();
@@ -334,6 +366,169 @@ Status CustomWriter::WriteRecord(const absl::Cord& data) {
 }
 #endif  // TF_CORD_SUPPORT
 
+/* static */ constexpr const int64_t
+    PipelinedWriter::kDefaultCompressionThreads;
+
+PipelinedWriter::PipelinedWriter(const std::string& filename,
+                                 const std::string& compression_type,
+                                 const DataTypeVector& dtypes)
+    : filename_(filename),
+      compression_type_(compression_type),
+      dtypes_(dtypes) {
+  DCHECK_EQ(compression_type_, io::compression::kSnappy);
+}
+
+Status PipelinedWriter::Initialize(tensorflow::Env* env) {
+  TF_RETURN_IF_ERROR(env->NewAppendableFile(filename_, &dest_));
+  simple_tensor_mask_.reserve(dtypes_.size());
+  for (const auto& dtype : dtypes_) {
+    if (DataTypeCanUseMemcpy(dtype)) {
+      simple_tensor_mask_.push_back(true);
+      num_simple_++;
+    } else {
+      simple_tensor_mask_.push_back(false);
+      num_complex_++;
+    }
+  }
+
+  int64_t num_threads = kDefaultCompressionThreads;
+  Status s = ReadInt64FromEnvVar("TF_DATA_SNAPSHOT_COMPRESSION_THREADS",
+                                 kDefaultCompressionThreads, &num_threads);
+  if (!s.ok() || num_threads < 1) {
+    LOG(WARNING) << "Invalid TF_DATA_SNAPSHOT_COMPRESSION_THREADS; using "
+                 << kDefaultCompressionThreads;
+    num_threads = kDefaultCompressionThreads;
+  }
+  max_inflight_elements_ = 2 * num_threads;
+  compression_pool_ = absl::make_unique<thread::ThreadPool>(
+      env, "snapshot_compression", num_threads);
+  io_thread_ = absl::WrapUnique(env->StartThread(
+      ThreadOptions(), "snapshot_pipeline_io", [this]() { IOThread(); }));
+  return OkStatus();
+}
+
+Status PipelinedWriter::WriteTensors(const std::vector<Tensor>& tensors) {
+  auto element = absl::make_unique<Element>();
+  TF_RETURN_IF_ERROR(SerializeElementPayload(tensors, simple_tensor_mask_,
+                                             num_simple_, num_complex_,
+                                             &element->metadata,
+                                             &element->uncompressed));
+  Element* raw_element = element.get();
+  {
+    mutex_lock l(mu_);
+    mu_.Await(tensorflow::Condition(this, &PipelinedWriter::CanAcceptElement));
+    TF_RETURN_IF_ERROR(status_);
+    inflight_.push_back(std::move(element));
+  }
+  // The element is owned by `inflight_` and the deque holds stable pointers,
+  // so the raw pointer remains valid: the I/O thread only removes an element
+  // after its compression has finished.
+  compression_pool_->Schedule(
+      [this, raw_element]() { CompressElement(raw_element); });
+  return OkStatus();
+}
+
+void PipelinedWriter::CompressElement(Element* element) {
+  Status s;
+  std::string compressed;
+  if (!port::Snappy_Compress(element->uncompressed.data(),
+                             element->uncompressed.size(), &compressed)) {
+    s = errors::Internal("Failed to compress using snappy.");
+  }
+  mutex_lock l(mu_);
+  element->compressed = std::move(compressed);
+  element->uncompressed.clear();
+  element->uncompressed.shrink_to_fit();
+  element->status = s;
+  element->done = true;
+}
+
+void PipelinedWriter::IOThread() {
+  while (true) {
+    std::unique_ptr<Element> element;
+    {
+      mutex_lock l(mu_);
+      mu_.Await(
+          tensorflow::Condition(this, &PipelinedWriter::FrontElementReady));
+      if (inflight_.empty()) {
+        return;
+      }
+      element = std::move(inflight_.front());
+      inflight_.pop_front();
+      if (!status_.ok() || !element->status.ok()) {
+        // Record the error (if new) and discard the element; the error is
+        // surfaced to the caller by `WriteTensors` or `Drain`.
+        status_.Update(element->status);
+        continue;
+      }
+      writing_ = true;
+    }
+    Status s = WriteRecord(element->metadata);
+    if (s.ok()) {
+      s = WriteRecord(element->compressed);
+    }
+    mutex_lock l(mu_);
+    writing_ = false;
+    status_.Update(s);
+  }
+}
+
+Status PipelinedWriter::WriteRecord(const StringPiece& data) {
+  char header[CustomWriter::kHeaderSize];
+  core::EncodeFixed64(header, data.size());
+  TF_RETURN_IF_ERROR(dest_->Append(StringPiece(header, sizeof(header))));
+  return dest_->Append(data);
+}
+
+Status PipelinedWriter::Drain() {
+  mutex_lock l(mu_);
+  mu_.Await(tensorflow::Condition(this, &PipelinedWriter::PipelineEmpty));
+  return status_;
+}
+
+bool PipelinedWriter::CanAcceptElement() {
+  return inflight_.size() < static_cast<size_t>(max_inflight_elements_) ||
+         !status_.ok();
+}
+
+bool PipelinedWriter::FrontElementReady() {
+  return inflight_.empty() ? eof_ : inflight_.front()->done;
+}
+
+bool PipelinedWriter::PipelineEmpty() {
+  return inflight_.empty() && !writing_;
+}
+
+Status PipelinedWriter::Sync() {
+  TF_RETURN_IF_ERROR(Drain());
+  return dest_->Sync();
+}
+
+Status PipelinedWriter::Close() {
+  if (dest_ == nullptr && io_thread_ == nullptr) {
+    return OkStatus();
+  }
+  Status status = Drain();
+  {
+    mutex_lock l(mu_);
+    eof_ = true;
+  }
+  io_thread_.reset();
+  compression_pool_.reset();
+  if (dest_ != nullptr) {
+    status.Update(dest_->Close());
+    dest_ = nullptr;
+  }
+  return status;
+}
+
+PipelinedWriter::~PipelinedWriter() {
+  Status s = Close();
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to close snapshot file " << filename_ << ": " << s;
+  }
+}
+
 Status Reader::Create(Env* env, const std::string& filename,
                       const string& compression_type, int version,
                       const DataTypeVector& dtypes,
@@ -49,9 +49,11 @@ BaseRendezvousMgr::BaseRendezvousMgr(const WorkerEnv* worker_env)
     : worker_env_(worker_env) {}
 
 BaseRendezvousMgr::~BaseRendezvousMgr() {
-  for (auto& p : table_) {
-    auto rendez = p.second;
-    StartAbortRendevous(rendez, errors::Aborted("Shutdown"));
+  for (TableShard& shard : shards_) {
+    for (auto& p : shard.table) {
+      auto rendez = p.second;
+      StartAbortRendevous(rendez, errors::Aborted("Shutdown"));
+    }
   }
 }
 
@@ -60,11 +62,12 @@ RemoteRendezvous* BaseRendezvousMgr::Find(int64_t step_id) {
 }
 
 BaseRemoteRendezvous* BaseRendezvousMgr::FindOrCreate(int64_t step_id) {
-  mutex_lock l(mu_);
-  auto iter = table_.find(step_id);
-  if (iter == table_.end()) {
+  TableShard& shard = ShardFor(step_id);
+  mutex_lock l(shard.mu);
+  auto iter = shard.table.find(step_id);
+  if (iter == shard.table.end()) {
     auto rr = Create(step_id, worker_env_);
-    iter = table_.insert({step_id, rr}).first;
+    iter = shard.table.insert({step_id, rr}).first;
   }
   iter->second->Ref();
   return iter->second;
@@ -106,11 +109,12 @@ Status BaseRendezvousMgr::RecvLocal(int64_t step_id,
 void BaseRendezvousMgr::Cleanup(int64_t step_id) {
   Rendezvous* rendez = nullptr;
   {
-    mutex_lock l(mu_);
-    auto iter = table_.find(step_id);
-    if (iter != table_.end()) {
+    TableShard& shard = ShardFor(step_id);
+    mutex_lock l(shard.mu);
+    auto iter = shard.table.find(step_id);
+    if (iter != shard.table.end()) {
       rendez = iter->second;
-      table_.erase(iter);
+      shard.table.erase(iter);
     }
   }
   if (rendez) {
@@ -119,10 +123,34 @@ void BaseRendezvousMgr::Cleanup(int64_t step_id) {
 }
 
 void BaseRendezvousMgr::CleanupAll() {
-  mutex_lock l(mu_);
-  for (auto iter = table_.begin(); iter != table_.end(); iter++) {
-    iter->second->Unref();
+  for (TableShard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    for (auto iter = shard.table.begin(); iter != shard.table.end(); iter++) {
+      iter->second->Unref();
+    }
+  }
+}
+
+Status RendezvousKeyCache::GetOrParse(const string& key,
+                                      Rendezvous::ParsedKey* out) {
+  Shard& shard = shards_[Hash64(key.data(), key.size()) % kNumShards];
+  {
+    mutex_lock l(shard.mu);
+    auto iter = shard.map.find(key);
+    if (iter != shard.map.end()) {
+      // Copying the cached entry is a string copy plus pointer fixups,
+      // which is much cheaper than re-parsing the device names.
+      *out = iter->second;
+      return OkStatus();
+    }
   }
+  TF_RETURN_IF_ERROR(Rendezvous::ParseKey(key, out));
+  mutex_lock l(shard.mu);
+  if (shard.map.size() >= kMaxEntriesPerShard) {
+    shard.map.clear();
+  }
+  shard.map.emplace(key, *out);
+  return OkStatus();
 }
 
 BaseRemoteRendezvous::BaseRemoteRendezvous(const WorkerEnv* env,
@@ -101,17 +101,58 @@ class BaseRendezvousMgr : public RendezvousMgrInterface {
   // Maps step_id to rendezvous.
   typedef absl::flat_hash_map<int64_t, BaseRemoteRendezvous*> Table;
 
+  // The step table is sharded by step_id hash so that concurrent RecvTensor
+  // handlers and graph executors for different steps do not serialize on a
+  // single mutex.
+  struct TableShard {
+    mutex mu;
+    Table table TF_GUARDED_BY(mu);
+  };
+  static constexpr int kNumShards = 16;
+
+  TableShard& ShardFor(int64_t step_id) {
+    return shards_[Hash64(reinterpret_cast<const char*>(&step_id),
+                          sizeof(step_id)) %
+                   kNumShards];
+  }
+
   // Not owned.
   const WorkerEnv* const worker_env_;
 
-  mutex mu_;
-  Table table_ TF_GUARDED_BY(mu_);
+  TableShard shards_[kNumShards];
 
   BaseRemoteRendezvous* FindOrCreate(int64_t step_id);
 
   TF_DISALLOW_COPY_AND_ASSIGN(BaseRendezvousMgr);
 };
 
+// Caches the parsed form of rendezvous keys seen on the RecvTensor path.
+// Rendezvous keys do not include the step id, so the same keys recur on
+// every step of a graph; after the first step a lookup replaces the full
+// string parse. Sharded by key hash; a shard is cleared wholesale when it
+// grows past a bound, which keeps the steady-state key set cached without
+// maintaining an LRU list. Thread safe.
+class RendezvousKeyCache {
+ public:
+  RendezvousKeyCache() = default;
+
+  // Sets *out to the parsed form of `key`, parsing and caching it if it has
+  // not been seen before.
+  Status GetOrParse(const string& key, Rendezvous::ParsedKey* out);
+
+ private:
+  struct Shard {
+    mutex mu;
+    absl::flat_hash_map<string, Rendezvous::ParsedKey> map TF_GUARDED_BY(mu);
+  };
+  static constexpr int kNumShards = 16;
+  static constexpr size_t kMaxEntriesPerShard = 1024;
+
+  Shard shards_[kNumShards];
+
+  TF_DISALLOW_COPY_AND_ASSIGN(RendezvousKeyCache);
+};
+
 // RemoteRendezvous is a Rendezvous which can handle either
 // the producer or consumer being in a remote process.
 //
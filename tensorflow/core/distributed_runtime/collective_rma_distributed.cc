@@ -23,6 +23,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/distributed_runtime/call_options.h"
 #include "tensorflow/core/distributed_runtime/cancellable_call.h"
+#include "tensorflow/core/distributed_runtime/collective_transport.h"
 #include "tensorflow/core/distributed_runtime/request_id.h"
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/framework/cancellation.h"
@@ -183,12 +184,17 @@ void CollectiveRemoteAccessDistributed::RecvFromPeer(
           // (NOP in 2nd case) In case the final to_tensor is on GPU, buf_ptr
           // points to a tmp CPU buffer and needs to be copied over to
           // to_tensor.
-          Status status =
-              PopulateTensorFromResponse(state->call->resp_, dst_tensor);
-          if (!status.ok()) {
-            done(status);
-            delete state;
-            return;
+          //
+          // A registered CollectiveTransport writes into dst_tensor directly
+          // and there is no response to unpack.
+          if (state->call != nullptr) {
+            Status status =
+                PopulateTensorFromResponse(state->call->resp_, dst_tensor);
+            if (!status.ok()) {
+              done(status);
+              delete state;
+              return;
+            }
           }
 
           if (to_device->tensorflow_accelerator_device_info()) {
@@ -211,6 +217,28 @@ void CollectiveRemoteAccessDistributed::RecvFromPeer(
         done(s);
       };
 
+  // Prefer a registered out-of-band transport (e.g. RDMA) that can write the
+  // peer's bytes directly into dst_tensor, avoiding protobuf serialization.
+  // The gRPC RecvBuf path below remains the fallback.
+  CollectiveTransport::RecvArgs transport_args;
+  transport_args.step_id = step_id_;
+  transport_args.peer_device = peer_device;
+  transport_args.peer_task = peer_task;
+  transport_args.key = key;
+  transport_args.to_device = to_device;
+  transport_args.to_device_ctx = to_device_ctx;
+  transport_args.to_alloc_attr = to_alloc_attr;
+  transport_args.to_tensor = dst_tensor;
+  transport_args.client_locality = client_locality;
+  transport_args.server_attributes = state->server_attributes;
+  transport_args.cancellation_manager = cancellation_manager;
+  CollectiveTransport* transport =
+      CollectiveTransportRegistry::Find(transport_args);
+  if (transport != nullptr) {
+    transport->RecvBufAsync(transport_args, recv_buf_callback);
+    return;
+  }
+
   state->call.reset(new RecvBufCall(
       step_id_, peer_device, peer_task, key, to_device, to_device_ctx,
       to_alloc_attr, dst_tensor, client_locality, state->server_attributes,
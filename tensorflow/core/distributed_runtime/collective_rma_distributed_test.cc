@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/collective_rma_distributed.h"
 
+#include "tensorflow/core/distributed_runtime/collective_transport.h"
+
 #include "google/protobuf/any.pb.h"
+#include "absl/strings/match.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/process_util.h"
@@ -76,6 +79,43 @@ static std::unique_ptr<Device> NewDevice(const string& type, const string& name,
 
 static int64_t kStepId = 123;
 
+// Serves receives whose rendezvous key carries a designated prefix by
+// copying bytes from a test-provided source tensor, standing in for an
+// out-of-band (e.g. RDMA) transport.
+class FakeCollectiveTransport : public CollectiveTransport {
+ public:
+  FakeCollectiveTransport() { instance_ = this; }
+
+  bool CanRecv(const RecvArgs& args) override {
+    return source_ != nullptr &&
+           absl::StartsWith(args.key, "transport_buf_key");
+  }
+
+  void RecvBufAsync(const RecvArgs& args, const StatusCallback& done) override {
+    if (args.to_tensor->TotalBytes() != source_->TotalBytes()) {
+      done(errors::Internal("FakeCollectiveTransport size mismatch"));
+      return;
+    }
+    memcpy(DMAHelper::base(args.to_tensor), DMAHelper::base(source_),
+           source_->TotalBytes());
+    ++recv_count_;
+    done(OkStatus());
+  }
+
+  void set_source(Tensor* source) { source_ = source; }
+  int recv_count() const { return recv_count_; }
+
+  static FakeCollectiveTransport* instance() { return instance_; }
+
+ private:
+  static FakeCollectiveTransport* instance_;
+  Tensor* source_ = nullptr;
+  int recv_count_ = 0;
+};
+FakeCollectiveTransport* FakeCollectiveTransport::instance_ = nullptr;
+
+REGISTER_COLLECTIVE_TRANSPORT(FakeTransport, FakeCollectiveTransport);
+
 class FakeWorker : public TestWorkerInterface {
  public:
   FakeWorker(const string& name, DeviceMgr* dev_mgr,
@@ -408,6 +448,37 @@ TEST_P(CollRMADistTest, ProdFirstOK) {
   ValidateResultTensor();
 }
 
+TEST_P(CollRMADistTest, RecvFromPeerViaRegisteredTransport) {
+  ResolveDeviceAttributes();
+  FakeCollectiveTransport* transport = FakeCollectiveTransport::instance();
+  ASSERT_TRUE(transport != nullptr);
+  transport->set_source(&expected_value_);
+  const int prior_recv_count = transport->recv_count();
+  Notification consumer_note;
+  Status consumer_status;
+  Device* dst_device = nullptr;
+  string dev_name = "CPU:0";
+  TF_EXPECT_OK(device_mgrs_[0]->LookupDevice(dev_name, &dst_device));
+  MaybeSetGPUDevice(dst_device);
+  DeviceContext* to_device_ctx = nullptr;
+  rma_->RecvFromPeer(
+      "/job:worker/replica:0/task:1/device:" + dev_name,  // peer_dev
+      "/job:worker/replica:0/task:1",                     // peer_task
+      false,                                              // peer_is_local
+      "transport_buf_key", dst_device, to_device_ctx, alloc_attr_, &to_tensor_,
+      device_locality_, 0 /*dev_to_dev_stream_index*/,
+      nullptr /*cancellation_manager*/,
+      [&consumer_status, &consumer_note](const Status& s) {
+        consumer_status = s;
+        consumer_note.Notify();
+      });
+  consumer_note.WaitForNotification();
+  transport->set_source(nullptr);
+  TF_EXPECT_OK(consumer_status);
+  EXPECT_EQ(prior_recv_count + 1, transport->recv_count());
+  ValidateResultTensor();
+}
+
 TEST_P(CollRMADistTest, ConsFirstOK) {
   ResolveDeviceAttributes();
   Notification consumer_note;
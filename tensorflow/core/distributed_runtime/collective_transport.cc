@@ -0,0 +1,66 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/distributed_runtime/collective_transport.h"
+
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+namespace tensorflow {
+namespace {
+
+struct RegistrationInfo {
+  RegistrationInfo(string n, CollectiveTransport* t)
+      : name(std::move(n)), instance(t) {}
+  string name;
+  CollectiveTransport* instance;  // Never deleted.
+};
+
+std::vector<RegistrationInfo>* MutableTransportRegistry() {
+  static std::vector<RegistrationInfo>* registry =
+      new std::vector<RegistrationInfo>;
+  return registry;
+}
+
+}  // namespace
+
+/*static*/
+CollectiveTransport* CollectiveTransportRegistry::Find(
+    const CollectiveTransport::RecvArgs& args) {
+  std::vector<RegistrationInfo>* registry = MutableTransportRegistry();
+  for (const RegistrationInfo& reg_info : *registry) {
+    if (reg_info.instance->CanRecv(args)) {
+      return reg_info.instance;
+    }
+  }
+  return nullptr;
+}
+
+/*static*/
+Status CollectiveTransportRegistry::Register(const string& transport_name,
+                                             Factory factory) {
+  std::vector<RegistrationInfo>* registry = MutableTransportRegistry();
+  for (const RegistrationInfo& reg_info : *registry) {
+    if (reg_info.name == transport_name) {
+      return errors::Internal("Already registered collective transport ",
+                              transport_name);
+    }
+  }
+  registry->emplace_back(transport_name, factory());
+  return OkStatus();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,114 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_COLLECTIVE_TRANSPORT_H_
+#define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_COLLECTIVE_TRANSPORT_H_
+
+#include <functional>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/framework/device_attributes.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+class Device;
+class DeviceContext;
+
+// Interface for pluggable bulk-transfer transports used by the distributed
+// collective implementation.
+//
+// CollectiveRemoteAccessDistributed moves tensor bytes between tasks with
+// the gRPC RecvBuf RPC, which chunks the payload through protobuf.  On
+// fabrics with remote memory access (e.g. RDMA verbs or RoCE) an
+// out-of-band transport can instead write the peer's bytes directly into
+// the destination buffer.  Implementations register themselves with
+// REGISTER_COLLECTIVE_TRANSPORT; for each receive the first registered
+// transport that accepts it is used, and the RecvBuf RPC remains the
+// fallback.
+class CollectiveTransport {
+ public:
+  virtual ~CollectiveTransport() {}
+
+  // Describes one pending receive.  `to_tensor` is the buffer the bytes
+  // must land in: the final destination tensor for CPU devices, or a
+  // gpu-compatible host staging tensor when the destination device is an
+  // accelerator.
+  struct RecvArgs {
+    int64_t step_id = 0;
+    string peer_device;
+    string peer_task;
+    string key;
+    Device* to_device = nullptr;
+    DeviceContext* to_device_ctx = nullptr;
+    AllocatorAttributes to_alloc_attr;
+    Tensor* to_tensor = nullptr;
+    DeviceLocality client_locality;
+    DeviceAttributes server_attributes;
+    CancellationManager* cancellation_manager = nullptr;
+  };
+
+  // Returns true if this transport can serve `args`, e.g. the peer task is
+  // reachable out-of-band and the destination buffer lies in (or can be
+  // placed in) memory registered with the fabric.
+  virtual bool CanRecv(const RecvArgs& args) = 0;
+
+  // Starts the receive described by `args` and invokes `done` exactly once,
+  // after the destination buffer has been filled or the transfer failed.
+  // May be called concurrently from multiple threads.
+  virtual void RecvBufAsync(const RecvArgs& args,
+                            const StatusCallback& done) = 0;
+};
+
+// Static-methods only class for registering and looking up collective
+// transports.
+class CollectiveTransportRegistry {
+ public:
+  using Factory = std::function<CollectiveTransport*()>;
+
+  // Returns the first registered transport that accepts `args`, or nullptr
+  // if none does.  Callers fall back to the RecvBuf RPC in that case.
+  // Transport instances are created at registration time and retained for
+  // the lifetime of the process.
+  static CollectiveTransport* Find(const CollectiveTransport::RecvArgs& args);
+
+ private:
+  friend class CollectiveTransportRegistration;
+  // Registers a CollectiveTransport under `transport_name` with factory
+  // `factory`.  Transports are consulted in registration order.
+  static Status Register(const string& transport_name, Factory factory);
+};
+
+// Class used to call CollectiveTransportRegistry::Register.  This should only
+// be used to create a global static object.
+class CollectiveTransportRegistration {
+ public:
+  CollectiveTransportRegistration(const string& transport_name,
+                                  CollectiveTransportRegistry::Factory factory) {
+    TF_CHECK_OK(CollectiveTransportRegistry::Register(transport_name,
+                                                      std::move(factory)));
+  }
+};
+
+#define REGISTER_COLLECTIVE_TRANSPORT(name, transport) \
+  static CollectiveTransportRegistration               \
+      register_##name##_collective_transport(#name,    \
+                                             []() { return new transport; });
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_COLLECTIVE_TRANSPORT_H_
@@ -390,10 +390,11 @@ void CoordinationServiceStandaloneImpl::StartCheckStaleness() {
               return;
             }
           }
-          // Heartbeat check.
-          Status status = OkStatus();
+          // Heartbeat check.  The scan only reads per-task state, so it runs
+          // under a shared lock and does not block incoming heartbeats; the
+          // exclusive lock is taken only when a timeout actually fired.
           {
-            mutex_lock l(state_mu_);
+            tf_shared_lock l(state_mu_);
             for (const auto& [task_name, task_state] : cluster_state_) {
               // Skip tasks that are not registered or in error state
               if (task_state->GetState() != TaskState::State::CONNECTED) {
@@ -405,14 +406,31 @@ void CoordinationServiceStandaloneImpl::StartCheckStaleness() {
                       << " stale?=" << is_stale;
               if (is_stale) {
                 stale_task_names.push_back(task_name);
-                status = MakeCoordinationError(errors::Unavailable(
-                    "Task ", task_name,
-                    " heartbeat timeout. This indicates that the remote task "
-                    "has failed, got preempted, or crashed unexpectedly."));
-                SetTaskError(task_name, status);
               }
             }
           }
+          if (!stale_task_names.empty()) {
+            mutex_lock l(state_mu_);
+            // Drop tasks that legally transitioned out of CONNECTED (e.g.
+            // gracefully disconnected) between the scan and this pass.
+            stale_task_names.erase(
+                std::remove_if(stale_task_names.begin(), stale_task_names.end(),
+                               [this](absl::string_view task_name)
+                                   TF_EXCLUSIVE_LOCKS_REQUIRED(state_mu_) {
+                                     return cluster_state_[task_name]
+                                                ->GetState() !=
+                                            TaskState::State::CONNECTED;
+                                   }),
+                stale_task_names.end());
+            for (const auto& stale_task_name : stale_task_names) {
+              SetTaskError(
+                  stale_task_name,
+                  MakeCoordinationError(errors::Unavailable(
+                      "Task ", stale_task_name,
+                      " heartbeat timeout. This indicates that the remote task "
+                      "has failed, got preempted, or crashed unexpectedly.")));
+            }
+          }
           // Propagate heartbeat timeout errors to other connected tasks.
           if (!stale_task_names.empty()) {
             if (!has_service_to_client_connection) {
@@ -645,26 +663,31 @@ Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
   const std::string& task_name = GetTaskName(task);
   Status s = OkStatus();
   {
-    mutex_lock l(state_mu_);
-    if (!cluster_state_.contains(task_name)) {
+    // Heartbeats are by far the most frequent request and only bump a
+    // per-task timestamp (protected by the task's own mutex), so they take a
+    // shared lock and may proceed in parallel with each other.  Task state is
+    // only mutated under an exclusive lock, and cluster_state_ itself is
+    // fixed after construction, so reads here cannot race.
+    tf_shared_lock l(state_mu_);
+    const auto task_iter = cluster_state_.find(task_name);
+    if (task_iter == cluster_state_.end()) {
       return MakeCoordinationError(errors::InvalidArgument(
           "Unexpected task request with task_name=", task_name));
     }
-    if (!cluster_state_[task_name]->GetStatus().ok()) {
-      return cluster_state_[task_name]->GetStatus();
-    } else if (cluster_state_[task_name]->GetState() ==
-                   TaskState::State::DISCONNECTED &&
+    TaskState* task_state = task_iter->second.get();
+    if (!task_state->GetStatus().ok()) {
+      return task_state->GetStatus();
+    } else if (task_state->GetState() == TaskState::State::DISCONNECTED &&
                // We accept heartbeats for a short grace period to account for
                // the lag time between the service recording the state change
                // and the agent stopping heartbeats.
                Env::Default()->NowMicros() >
-                   cluster_state_[task_name]
-                       ->GetDisconnectedGracePeriodMicros()) {
+                   task_state->GetDisconnectedGracePeriodMicros()) {
       return MakeCoordinationError(errors::InvalidArgument(
           "Task with task_name=", task_name,
           " must be registered before sending heartbeat messages"));
     }
-    s = cluster_state_[task_name]->RecordHeartbeat(incarnation);
+    s = task_state->RecordHeartbeat(incarnation);
   }
 
   // Set and propagate any heartbeat errors.
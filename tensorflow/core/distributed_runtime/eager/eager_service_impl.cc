@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/eager/context_distributed_manager.h"
 #include "tensorflow/core/common_runtime/eager/eager_operation.h"
 #include "tensorflow/core/common_runtime/eager/execute.h"
+#include "tensorflow/core/common_runtime/eager/shape_inference.h"
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/distributed_runtime/eager/cluster_function_library_runtime.h"
@@ -58,6 +59,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/coordination_config.pb.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace eager {
@@ -121,22 +123,60 @@ Status GetEagerOperationAndNumRetvals(const Operation& operation,
   {
     profiler::TraceMe activity("EagerService:RemoteTensorHandleInternal",
                                profiler::TraceMeLevel::kVerbose);
+
+    // Resolve all remote handles in one batched call so that locally resident
+    // handles are looked up under a single lock acquisition, instead of
+    // re-locking the remote handle table once per input.
+    std::vector<const RemoteTensorHandle*> remote_inputs;
+    for (const auto& input : operation.op_inputs()) {
+      if (input.has_remote_handle()) {
+        remote_inputs.push_back(&input.remote_handle());
+      }
+    }
+    std::vector<tensorflow::TensorHandle*> remote_handles;
+    if (!remote_inputs.empty()) {
+      TF_RETURN_IF_ERROR(
+          eager_context->RemoteMgr()->DeserializeRemoteTensorHandles(
+              remote_inputs, &remote_handles));
+    }
+
+    int next_remote_handle = 0;
     for (const auto& input : operation.op_inputs()) {
       tensorflow::TensorHandle* handle;
       if (input.has_remote_handle()) {
-        TF_RETURN_IF_ERROR(
-            eager_context->RemoteMgr()->DeserializeRemoteTensorHandle(
-                input.remote_handle(), &handle));
-        TF_RETURN_IF_ERROR(eager_op->AddInput(handle));
+        handle = remote_handles[next_remote_handle++];
+        Status s = eager_op->AddInput(handle);
+        if (!s.ok()) {
+          // Drop the references held on the not-yet-consumed handles.
+          for (int i = next_remote_handle, end = remote_handles.size();
+               i < end; ++i) {
+            remote_handles[i]->Unref();
+          }
+          handle->Unref();
+          return s;
+        }
       } else {
         Tensor tensor;
         if (!ParseTensorProtoToTensor(input.tensor(), &tensor)) {
+          // Drop the references held on the not-yet-consumed handles.
+          for (int i = next_remote_handle, end = remote_handles.size(); i < end;
+               ++i) {
+            remote_handles[i]->Unref();
+          }
           return errors::InvalidArgument("Invalid TensorProto: ",
                                          input.tensor().DebugString());
         } else {
           handle = TensorHandle::CreateLocalHandle(std::move(tensor), nullptr,
                                                    nullptr, eager_context);
-          TF_RETURN_IF_ERROR(eager_op->AddInput(handle));
+          Status s = eager_op->AddInput(handle);
+          if (!s.ok()) {
+            for (int i = next_remote_handle, end = remote_handles.size();
+                 i < end; ++i) {
+              remote_handles[i]->Unref();
+            }
+            handle->Unref();
+            return s;
+          }
         }
       }
       // Unref handle since it has a ref as an input now.
@@ -163,6 +203,16 @@ Status TensorHandleProto(TensorHandle* handle, TensorProto* proto) {
 Status TensorHandleShape(TensorHandle* handle, TensorShapeProto* proto) {
   const tensorflow::Tensor* t = nullptr;
 
+  // An async-executed op's output is usually not ready at this point.  If
+  // shape inference already fully determined its shape, report that instead
+  // of waiting: blocking here serializes every streamed op against completion
+  // of its predecessor.
+  TensorShape inferred_shape;
+  if (handle->InferredShapeIfFullyDefined(&inferred_shape)) {
+    inferred_shape.AsProto(proto);
+    return OkStatus();
+  }
+
   // TODO(nareshmodi): This call makes async calls sync calls. Fix this.
   if (handle->Type() == TensorHandle::LOCAL) {
     TF_RETURN_IF_ERROR(handle->Tensor(&t));
@@ -563,6 +613,35 @@ Status EagerServiceImpl::ExecuteOp(CallOptions* call_opts,
           num_retvals),
       &num_retvals));
 
+  // On a streaming enqueue with an async executor the outputs are usually not
+  // ready at this point.  Run shape inference now so the response can report
+  // fully defined output shapes without waiting for the kernels to finish;
+  // TensorHandleShape falls back to waiting when inference is inconclusive.
+  // TF_EAGER_REMOTE_INFERRED_SHAPES=false restores the always-wait behavior.
+  static const bool infer_shapes = []() {
+    bool v;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_EAGER_REMOTE_INFERRED_SHAPES",
+                                   /*default_val=*/true, &v));
+    return v;
+  }();
+  if (infer_shapes && eager_executor->Async() && !op.is_function()) {
+    gtl::InlinedVector<TensorHandle*, 4> input_handles;
+    input_handles.reserve(op.Inputs().size());
+    for (ImmediateExecutionTensorHandle* input : op.Inputs()) {
+      input_handles.push_back(TensorHandleFromInterface(input));
+    }
+    gtl::InlinedVector<TensorHandle*, 2> output_handles(
+        retvals.begin(), retvals.begin() + num_retvals);
+    Status inference_status = eager::RunShapeInference(
+        op.MutableAttrs()->BuildNodeDef(), *eager_context->FuncLibDef(),
+        input_handles, output_handles);
+    if (!inference_status.ok()) {
+      VLOG(1) << "Shape inference failed for op " << op.Name() << ": "
+              << inference_status.error_message()
+              << "; the response will wait for execution.";
+    }
+  }
+
   std::function<string*()> add_device_fn = nullptr;
   // Send the output devices of a function back to let a client know where the
   // outputs are. For a primitive op, an output devics is the op device which is
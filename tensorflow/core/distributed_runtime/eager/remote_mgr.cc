@@ -214,6 +214,58 @@ Status RemoteMgr::DeserializeRemoteTensorHandle(const RemoteTensorHandle& in,
   return OkStatus();
 }
 
+Status RemoteMgr::DeserializeRemoteTensorHandles(
+    const gtl::ArraySlice<const RemoteTensorHandle*> in,
+    std::vector<TensorHandle*>* out) {
+  out->clear();
+  out->reserve(in.size());
+  auto cleanup_on_error = [out]() {
+    for (TensorHandle* resolved : *out) {
+      if (resolved != nullptr) resolved->Unref();
+    }
+    out->clear();
+  };
+  // First pass: resolve all handles that live in the local handle table while
+  // holding the table lock once, rather than re-acquiring it per input.
+  {
+    tf_shared_lock l(remote_tensor_handle_mu_);
+    for (const RemoteTensorHandle* handle_proto : in) {
+      Device* device;
+      if (parent_->local_device_mgr()
+              ->LookupDevice(handle_proto->op_device(), &device)
+              .ok() ||
+          parent_->local_device_mgr()
+              ->LookupDevice(handle_proto->device(), &device)
+              .ok()) {
+        TensorHandle* handle = nullptr;
+        Status s = GetTensorHandleImpl(
+            RemoteTensorHandleInternal(*handle_proto), &handle);
+        if (!s.ok()) {
+          cleanup_on_error();
+          return s;
+        }
+        handle->Ref();
+        out->push_back(handle);
+      } else {
+        // Placeholder; resolved outside the lock below.
+        out->push_back(nullptr);
+      }
+    }
+  }
+  // Second pass: create lazy remote handles for inputs that are not local.
+  // This may take other locks, so it runs outside remote_tensor_handle_mu_.
+  for (int i = 0, end = in.size(); i < end; ++i) {
+    if ((*out)[i] != nullptr) continue;
+    Status s = DeserializeRemoteTensorHandle(*in[i], &(*out)[i]);
+    if (!s.ok()) {
+      (*out)[i] = nullptr;
+      cleanup_on_error();
+      return s;
+    }
+  }
+  return OkStatus();
+}
+
 EagerExecutor& RemoteMgr::GetOrCreateExecutorForStream(uint64 stream_id) {
   mutex_lock l(executor_map_mu_);
   auto it = executor_map_.find(stream_id);
@@ -75,6 +75,14 @@ class RemoteMgr {
   Status DeserializeRemoteTensorHandle(const RemoteTensorHandle& in,
                                        TensorHandle** out);
 
+  // Deserialize all of an op's RemoteTensorHandles at once. Handles resident
+  // in the local handle table are resolved under a single shared lock instead
+  // of locking once per input. On success `out` holds one reference per
+  // handle, in input order; on failure no references are retained.
+  Status DeserializeRemoteTensorHandles(
+      const gtl::ArraySlice<const RemoteTensorHandle*> in,
+      std::vector<TensorHandle*>* out);
+
   EagerExecutor& GetOrCreateExecutorForStream(uint64 stream_id);
 
   void DeleteExecutorForStream(uint64 stream_id);
@@ -152,6 +152,47 @@ TEST_F(RemoteMgrTest, SetRemoteShapeWithClusterUpdate) {
   handle->Unref();
 }
 
+TEST_F(RemoteMgrTest, DeserializeRemoteTensorHandlesBatched) {
+  RemoteMgr remote_mgr(false, ctx_);
+
+  TensorHandle* handle1 = TensorHandle::CreateLocalHandle(
+      Tensor(DT_FLOAT, TensorShape({0})), local_device_, local_device_, ctx_);
+  TensorHandle* handle2 = TensorHandle::CreateLocalHandle(
+      Tensor(DT_FLOAT, TensorShape({0})), local_device_, local_device_, ctx_);
+  const uint64 op_id = 4;
+  remote_mgr.AddOperationOutput(handle1, op_id, 0);
+  remote_mgr.AddOperationOutput(handle2, op_id, 1);
+  RemoteTensorHandle remote_handle1;
+  RemoteTensorHandle remote_handle2;
+  TF_ASSERT_OK(remote_mgr.SerializeRemoteTensorHandle(
+      handle1, /*wait_until_ready=*/true, &remote_handle1, local_device_,
+      local_device_->name()));
+  TF_ASSERT_OK(remote_mgr.SerializeRemoteTensorHandle(
+      handle2, /*wait_until_ready=*/true, &remote_handle2, local_device_,
+      local_device_->name()));
+
+  std::vector<const RemoteTensorHandle*> protos = {&remote_handle1,
+                                                   &remote_handle2};
+  std::vector<TensorHandle*> out;
+  TF_ASSERT_OK(remote_mgr.DeserializeRemoteTensorHandles(protos, &out));
+  ASSERT_EQ(2, out.size());
+  EXPECT_EQ(handle1, out[0]);
+  EXPECT_EQ(handle2, out[1]);
+  out[0]->Unref();
+  out[1]->Unref();
+
+  // A failed lookup resolves no handles and retains no references.
+  TF_ASSERT_OK(
+      remote_mgr.DeleteTensorHandle(RemoteTensorHandleInternal(op_id, 1)));
+  Status s = remote_mgr.DeserializeRemoteTensorHandles(protos, &out);
+  EXPECT_FALSE(s.ok());
+  EXPECT_TRUE(s.GetPayload(kErrorSource).has_value());
+  EXPECT_TRUE(out.empty());
+
+  TF_ASSERT_OK(
+      remote_mgr.DeleteTensorHandle(RemoteTensorHandleInternal(op_id, 0)));
+}
+
 TEST_F(RemoteMgrTest, ErrorSourcesShouldExist) {
   RemoteMgr remote_mgr(false, ctx_);
 
@@ -43,7 +43,9 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_partition.h"
 #include "tensorflow/core/graph/validate.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
@@ -262,9 +264,14 @@ Status GraphMgr::InitItem(const string& handle, const GraphDef& gdef,
           };
           // Kernels created for subgraph nodes need to be cached.  On
           // cache miss, create_fn() is invoked to create a kernel based
-          // on the function library here + global op registry.
-          return opseg->FindOrCreate(handle, props->node_def.name(), kernel,
-                                     create_fn);
+          // on the function library here + global op registry. The
+          // fingerprint lets registrations of identical node definitions
+          // (e.g. the same model loaded by another session on this
+          // worker) share one kernel instance.
+          return opseg->FindOrCreate(handle, props->node_def.name(),
+                                     OpSegment::KernelFingerprint(
+                                         props->node_def),
+                                     kernel, create_fn);
         };
     params.delete_kernel = [lib](OpKernel* kernel) {
       if (kernel && !OpSegment::ShouldOwnKernel(lib, kernel->type_string())) {
@@ -301,7 +308,46 @@ Status GraphMgr::Register(const string& handle, const GraphDef& gdef,
                           int64_t collective_graph_key, WorkerSession* session,
                           DistributedFunctionLibraryRuntime* cluster_flr,
                           string* graph_handle) {
+  static const bool reuse_registrations = []() {
+    bool result;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPH_MGR_REUSE_REGISTRATIONS",
+                                   /*default_val=*/true, &result));
+    return result;
+  }();
+  uint64 fingerprint = 0;
+  if (reuse_registrations) {
+    // GraphMgr is per-session, so the fingerprint only needs to cover the
+    // request itself.
+    fingerprint = DeterministicProtoHash64(gdef);
+    fingerprint = DeterministicProtoHash64(graph_options, fingerprint);
+    fingerprint = DeterministicProtoHash64(debug_options, fingerprint);
+    fingerprint = DeterministicProtoHash64(config_proto, fingerprint);
+    fingerprint = FingerprintCat64(fingerprint, collective_graph_key);
+    mutex_lock l(mu_);
+    auto fp_iter = fingerprint_to_handle_.find(fingerprint);
+    if (fp_iter != fingerprint_to_handle_.end()) {
+      auto iter = table_.find(fp_iter->second);
+      if (iter == table_.end()) {
+        // The previously registered copy has since been deregistered.
+        fingerprint_to_handle_.erase(fp_iter);
+      } else {
+        // An identical graph is already registered.  Alias its compiled item
+        // under a fresh handle instead of partitioning, optimizing and
+        // building executors again; cached kernels and executor state for
+        // the unchanged subgraph carry over.
+        Item* item = iter->second;
+        item->Ref();
+        *graph_handle =
+            strings::Printf("%016llx", static_cast<long long>(++next_id_));
+        CHECK(table_.insert({*graph_handle, item}).second);
+        fp_iter->second = *graph_handle;
+        return OkStatus();
+      }
+    }
+  }
+
   Item* item = new Item;
+  item->registration_fingerprint = fingerprint;
   Status s = InitItem(handle, gdef, graph_options, debug_options, config_proto,
                       collective_graph_key, session, cluster_flr, item);
   if (!s.ok()) {
@@ -316,6 +362,9 @@ Status GraphMgr::Register(const string& handle, const GraphDef& gdef,
         strings::Printf("%016llx", static_cast<long long>(++next_id_));
     item->handle = *graph_handle;
     CHECK(table_.insert({*graph_handle, item}).second);
+    if (reuse_registrations) {
+      fingerprint_to_handle_[fingerprint] = *graph_handle;
+    }
   }
   return OkStatus();
 }
@@ -332,6 +381,11 @@ Status GraphMgr::Deregister(const string& handle) {
     }
     item = iter->second;
     table_.erase(iter);
+    auto fp_iter =
+        fingerprint_to_handle_.find(item->registration_fingerprint);
+    if (fp_iter != fingerprint_to_handle_.end() && fp_iter->second == handle) {
+      fingerprint_to_handle_.erase(fp_iter);
+    }
   }
   item->Unref();
   return OkStatus();
@@ -346,6 +400,7 @@ Status GraphMgr::DeregisterAll() {
       items.push_back(entry.second);
     }
     table_.clear();
+    fingerprint_to_handle_.clear();
   }
   for (auto item : items) {
     item->Unref();
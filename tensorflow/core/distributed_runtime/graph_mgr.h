@@ -145,6 +145,11 @@ class GraphMgr {
     GraphMgr* graph_mgr;
 
     int64_t collective_graph_key;
+
+    // Fingerprint of the registration request that produced this item, or 0
+    // if registration reuse is disabled.  Used to drop the reuse index entry
+    // when the item is deregistered.
+    uint64 registration_fingerprint = 0;
   };
 
   const WorkerEnv* worker_env_;  // Not owned.
@@ -166,6 +171,13 @@ class GraphMgr {
   // mechanism to gc these graphs.
   std::unordered_map<string, Item*> table_;
 
+  // Maps the fingerprint of a registration request to the most recent graph
+  // handle produced for it.  When the master re-registers a byte-identical
+  // graph (e.g. after a re-partition that left this worker's subgraph
+  // unchanged), the compiled item is aliased under a fresh handle instead of
+  // being partitioned, optimized and compiled again.
+  std::unordered_map<uint64, string> fingerprint_to_handle_;
+
   void StartParallelExecutors(
       const string& handle, int64_t step_id, Item* item, Rendezvous* rendezvous,
       CollectiveExecutor::Handle* ce_handle, StepStatsCollector* collector,
@@ -1284,7 +1284,66 @@ Status MasterSession::Create(GraphDef&& graph_def,
         std::move(graph_def), execution_options, &execution_state_));
   }
   should_delete_worker_sessions_ = true;
-  return CreateWorkerSessions(cluster_def);
+  TF_RETURN_IF_ERROR(CreateWorkerSessions(cluster_def));
+  return PrewarmGraphs();
+}
+
+Status MasterSession::PrewarmGraphs() {
+  for (const CallableOptions& signature :
+       session_opts_.config.experimental().session_prewarm_signatures()) {
+    BuildGraphOptions opts;
+    opts.callable_options = signature;
+    opts.callable_options.clear_tensor_connection();
+    opts.callable_options.clear_run_options();
+    // Normalize the signature the same way BuildBuildGraphOptions does for
+    // RunStep requests, so the cached graph's hash matches later requests.
+    std::sort(opts.callable_options.mutable_feed()->begin(),
+              opts.callable_options.mutable_feed()->end());
+    std::sort(opts.callable_options.mutable_fetch()->begin(),
+              opts.callable_options.mutable_fetch()->end());
+    std::sort(opts.callable_options.mutable_target()->begin(),
+              opts.callable_options.mutable_target()->end());
+    if (session_opts_.config.experimental()
+            .collective_deterministic_sequential_execution()) {
+      opts.collective_order = GraphCollectiveOrder::kEdges;
+    } else if (session_opts_.config.experimental().collective_nccl()) {
+      opts.collective_order = GraphCollectiveOrder::kAttrs;
+    }
+    TF_RETURN_WITH_CONTEXT_IF_ERROR(PrewarmRunGraph(opts),
+                                    "while pre-warming signature:\n",
+                                    BuildGraphOptionsString(opts));
+  }
+  return OkStatus();
+}
+
+Status MasterSession::PrewarmRunGraph(const BuildGraphOptions& opts) {
+  const uint64 hash = HashBuildGraphOptions(opts);
+  ReffedClientGraph* rcg = nullptr;
+  {
+    mutex_lock l(mu_);
+    if (closed_) {
+      return errors::FailedPrecondition("Session is closed.");
+    }
+    auto iter = run_graphs_.find(hash);
+    if (iter == run_graphs_.end()) {
+      VLOG(1) << "Pre-warming hash " << hash << " for "
+              << BuildGraphOptionsString(opts);
+      std::unique_ptr<ClientGraph> client_graph;
+      TF_RETURN_IF_ERROR(execution_state_->BuildGraph(opts, &client_graph));
+      WorkerCacheInterface* worker_cache = get_worker_cache();
+      auto entry = new ReffedClientGraph(
+          handle_, opts, std::move(client_graph), session_opts_,
+          stats_publisher_factory_, /*is_partial=*/false, worker_cache,
+          !should_delete_worker_sessions_);
+      iter = run_graphs_.insert({hash, entry}).first;
+    }
+    rcg = iter->second;
+    rcg->Ref();
+  }
+  core::ScopedUnref unref(rcg);
+  // Partition the graph and register the partitions with the workers now, so
+  // the first step that uses this signature finds them already registered.
+  return BuildAndRegisterPartitions(rcg);
 }
 
 Status MasterSession::CreateWorkerSessions(const ClusterDef& cluster_def) {
@@ -224,6 +224,16 @@ class MasterSession : public core::RefCounted {
 
   Status StartStep(const BuildGraphOptions& opts, bool is_partial,
                    ReffedClientGraph** out_rcg, int64_t* out_count);
+
+  // Pre-builds, partitions, and registers the run graphs for the signatures
+  // listed in the session configuration's session_prewarm_signatures, so
+  // the first RunStep with a matching signature does not pay for them.
+  Status PrewarmGraphs();
+
+  // Ensures that a ReffedClientGraph for `opts` is cached in run_graphs_ and
+  // that its partitions are registered with the workers, without counting as
+  // an execution of the graph.
+  Status PrewarmRunGraph(const BuildGraphOptions& opts);
   void ClearRunsTable(std::vector<ReffedClientGraph*>* to_unref,
                       RCGMap* rcg_map) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void FillPerStepState(MasterSession::ReffedClientGraph* rcg,
@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_remote_worker.h"
 
+#include <atomic>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "grpcpp/generic/generic_stub.h"
 #include "grpcpp/grpcpp.h"
@@ -42,12 +45,11 @@ namespace tensorflow {
 
 class GrpcRemoteWorker : public WorkerInterface {
  public:
-  explicit GrpcRemoteWorker(SharedGrpcChannelPtr channel,
+  explicit GrpcRemoteWorker(std::vector<SharedGrpcChannelPtr> channels,
                             ::grpc::CompletionQueue* completion_queue,
                             thread::ThreadPool* callback_threadpool,
                             WorkerCacheLogger* logger, const string& target)
-      : channel_(std::move(channel)),
-        stub_(channel_),
+      : channels_(std::move(channels)),
         cq_(completion_queue),
         callback_threadpool_(callback_threadpool),
         getstatus_(Method(GrpcWorkerMethod::kGetStatus)),
@@ -67,7 +69,13 @@ class GrpcRemoteWorker : public WorkerInterface {
         getstepsequence_(Method(GrpcWorkerMethod::kGetStepSequence)),
         markrecvfinished_(Method(GrpcWorkerMethod::kMarkRecvFinished)),
         logger_(logger),
-        target_(target) {}
+        target_(target) {
+    CHECK(!channels_.empty());
+    stubs_.reserve(channels_.size());
+    for (const SharedGrpcChannelPtr& channel : channels_) {
+      stubs_.push_back(std::make_unique<::grpc::GenericStub>(channel));
+    }
+  }
 
   ~GrpcRemoteWorker() override {}
 
@@ -170,7 +178,8 @@ class GrpcRemoteWorker : public WorkerInterface {
       done(s);
     };
 
-    IssueRequest(request, response, recvbuf_, callback, call_opts);
+    IssueRequest(request, response, recvbuf_, callback, call_opts,
+                 /*fail_fast=*/true, NextDataStub());
   }
 
   void CompleteGroupAsync(CallOptions* call_opts,
@@ -272,21 +281,33 @@ class GrpcRemoteWorker : public WorkerInterface {
   void IssueRequest(const protobuf::Message* request,
                     protobuf::Message* response, const ::grpc::string& method,
                     StatusCallback done, CallOptions* call_opts = nullptr,
-                    bool fail_fast = true) {
+                    bool fail_fast = true,
+                    ::grpc::GenericStub* stub = nullptr) {
+    if (stub == nullptr) stub = stubs_[0].get();
     new RPCState<protobuf::Message>(
-        &stub_, cq_, method, *request, response, std::move(done), call_opts,
+        stub, cq_, method, *request, response, std::move(done), call_opts,
         callback_threadpool_, MaxRetries(), fail_fast, &target_);
   }
 
   void IssueRequest(const protobuf::Message* request, TensorResponse* response,
                     const ::grpc::string& method, StatusCallback done,
                     CallOptions* call_opts = nullptr) {
-    new RPCState<TensorResponse>(&stub_, cq_, method, *request, response,
-                                 std::move(done), call_opts,
+    new RPCState<TensorResponse>(NextDataStub(), cq_, method, *request,
+                                 response, std::move(done), call_opts,
                                  callback_threadpool_, MaxRetries(),
                                  /*fail_fast=*/true, &target_);
   }
 
+  // Returns the stub on which to issue the next bulk data transfer. Cycling
+  // through the channels spreads concurrent transfers over the available
+  // connections; single-channel workers always get stubs_[0].
+  ::grpc::GenericStub* NextDataStub() {
+    if (stubs_.size() == 1) return stubs_[0].get();
+    return stubs_[next_data_stub_.fetch_add(1, std::memory_order_relaxed) %
+                  stubs_.size()]
+        .get();
+  }
+
   void IssueMarkRecvFinishedRequest(int64_t request_id) {
     VLOG(2) << "Send MarkRecvFinishedRequest for request " << request_id;
     MarkRecvFinishedRequest request;
@@ -308,8 +329,9 @@ class GrpcRemoteWorker : public WorkerInterface {
     return max_retries;
   }
 
-  SharedGrpcChannelPtr channel_;
-  ::grpc::GenericStub stub_;
+  std::vector<SharedGrpcChannelPtr> channels_;
+  std::vector<std::unique_ptr<::grpc::GenericStub>> stubs_;
+  std::atomic<uint64> next_data_stub_{0};
   ::grpc::CompletionQueue* cq_;
   thread::ThreadPool* callback_threadpool_;
 
@@ -337,12 +359,12 @@ class GrpcRemoteWorker : public WorkerInterface {
   TF_DISALLOW_COPY_AND_ASSIGN(GrpcRemoteWorker);
 };
 
-WorkerInterface* NewGrpcRemoteWorker(SharedGrpcChannelPtr channel,
+WorkerInterface* NewGrpcRemoteWorker(std::vector<SharedGrpcChannelPtr> channels,
                                      ::grpc::CompletionQueue* completion_queue,
                                      thread::ThreadPool* callback_threadpool,
                                      WorkerCacheLogger* logger,
                                      const string& target) {
-  return new GrpcRemoteWorker(std::move(channel), completion_queue,
+  return new GrpcRemoteWorker(std::move(channels), completion_queue,
                               callback_threadpool, logger, target);
 }
 
@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_REMOTE_WORKER_H_
 
 #include <memory>
+#include <vector>
 
 #include "grpcpp/completion_queue.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_util.h"
@@ -26,7 +27,12 @@ namespace tensorflow {
 class WorkerCacheLogger;
 class WorkerInterface;
 
-WorkerInterface* NewGrpcRemoteWorker(SharedGrpcChannelPtr channel,
+// "channels" must be non-empty; all entries must point at the same target.
+// Control-plane RPCs are issued on the first channel. Bulk data transfers
+// (RecvTensor, RecvBuf) are striped round-robin across all of the channels so
+// that concurrent large transfers are not serialized onto a single TCP
+// connection.
+WorkerInterface* NewGrpcRemoteWorker(std::vector<SharedGrpcChannelPtr> channels,
                                      ::grpc::CompletionQueue* completion_queue,
                                      thread::ThreadPool* callback_threadpool,
                                      WorkerCacheLogger* logger,
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_util.h"
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/lib/random/random.h"
 
 namespace tensorflow {
@@ -91,6 +92,50 @@ bool GrpcMaybeParseProto(::grpc::ByteBuffer* src, protobuf::Message* dst) {
   return dst->ParseFromZeroCopyStream(&reader);
 }
 
+namespace {
+
+// TensorBuffer that keeps a reference on a grpc slice and exposes a
+// sub-range of it as tensor storage. The slice (and hence the transport's
+// receive buffer) stays alive for as long as any tensor refers to it.
+class GrpcSliceTensorBuffer : public TensorBuffer {
+ public:
+  GrpcSliceTensorBuffer(::grpc::Slice slice, const void* data, size_t size)
+      : TensorBuffer(const_cast<void*>(data)),
+        slice_(std::move(slice)),
+        size_(size) {}
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocated_bytes(size_);
+    proto->set_allocator_name("grpc_slice");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  ~GrpcSliceTensorBuffer() override {}
+
+  const ::grpc::Slice slice_;
+  const size_t size_;
+};
+
+}  // namespace
+
+TensorBuffer* GrpcByteSource::GetTensorBuffer(const void* data,
+                                              size_t length) {
+  std::vector<::grpc::Slice> slices;
+  if (!buffer_->Dump(&slices).ok()) return nullptr;
+  const char* begin = static_cast<const char*>(data);
+  for (::grpc::Slice& slice : slices) {
+    const char* slice_begin = reinterpret_cast<const char*>(slice.begin());
+    if (begin >= slice_begin && begin + length <= slice_begin + slice.size()) {
+      return new GrpcSliceTensorBuffer(std::move(slice), data, length);
+    }
+  }
+  return nullptr;
+}
+
 // Overload of GrpcParseProto so we can decode a TensorResponse without
 // extra copying.  This overload is used by the RPCState class in
 // grpc_state.h.
@@ -57,6 +57,12 @@ class GrpcByteSource : public TensorResponse::Source {
     return stream_;
   }
 
+  // Returns a TensorBuffer that holds a reference on the grpc slice
+  // containing [data, data + length), or nullptr if no single slice covers
+  // that range. This lets TensorResponse construct a Tensor directly over
+  // the wire bytes without copying them.
+  TensorBuffer* GetTensorBuffer(const void* data, size_t length) override;
+
  private:
   void DeleteStream() {
     if (stream_) {
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_cache.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/distributed_runtime/rpc/coordination/grpc_coordination_client.h"
 #include "tensorflow/core/distributed_runtime/rpc/eager/grpc_eager_client.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_remote_worker.h"
@@ -59,9 +63,25 @@ class GrpcWorkerCache : public WorkerCachePartial {
       if (!channel) {
         return nullptr;
       }
+      std::vector<SharedGrpcChannelPtr> channels;
+      channels.push_back(std::move(channel));
+      // Ask the channel cache for additional channels so that large tensor
+      // transfers can be striped over several TCP connections. The cache
+      // round-robins over RPCOptions.num_channels_per_target channels, so
+      // repeated lookups return distinct channels only when that option is
+      // also set; duplicates are dropped here.
+      for (int64_t i = 1; i < NumRecvStreams(); ++i) {
+        SharedGrpcChannelPtr extra = channel_cache_->FindWorkerChannel(target);
+        if (extra == nullptr) break;
+        if (std::find(channels.begin(), channels.end(), extra) !=
+            channels.end()) {
+          break;
+        }
+        channels.push_back(std::move(extra));
+      }
       size_t index = AssignWorkerToThread(target);
       return NewGrpcRemoteWorker(
-          channel, worker_env_->GetCompletionQueue(index),
+          std::move(channels), worker_env_->GetCompletionQueue(index),
           worker_env_->GetThreadPool(), &logger_, target);
     }
   }
@@ -97,6 +117,20 @@ class GrpcWorkerCache : public WorkerCachePartial {
   }
 
  private:
+  // Number of gRPC channels over which each remote worker stripes its bulk
+  // data transfers (RecvTensor/RecvBuf). Defaults to 1 (no striping); only
+  // effective when RPCOptions.num_channels_per_target provides a channel pool
+  // of at least this size.
+  static int64_t NumRecvStreams() {
+    static const int64_t num_streams = []() {
+      int64_t n;
+      TF_CHECK_OK(
+          ReadInt64FromEnvVar("TF_GRPC_RECV_STREAMS_PER_WORKER", 1, &n));
+      return n < 1 ? 1 : n;
+    }();
+    return num_streams;
+  }
+
   size_t AssignWorkerToThread(const string& target) {
     // Round-robin target assignment, but keeps the same target on the same
     // polling thread always, as this is important for gRPC performance
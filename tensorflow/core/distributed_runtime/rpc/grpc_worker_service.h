@@ -19,6 +19,7 @@ limitations under the License.
 #include <memory>
 #include <unordered_map>
 #include "grpcpp/server_builder.h"
+#include "tensorflow/core/distributed_runtime/base_rendezvous_mgr.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_response_cache.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_service_impl.h"
 #include "tensorflow/core/distributed_runtime/worker.h"
@@ -64,6 +65,9 @@ class GrpcWorker : public Worker {
 
  private:
   std::unique_ptr<GrpcResponseCache> response_cache_;
+  // Caches parsed rendezvous keys across RecvTensor requests; the same keys
+  // recur on every step of a graph.
+  RendezvousKeyCache key_cache_;
   const int32 recv_buf_max_chunk_;
 };
 
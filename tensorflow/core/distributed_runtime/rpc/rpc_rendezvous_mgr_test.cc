@@ -291,6 +291,52 @@ TEST_F(RpcRendezvousMgrTest, TransferDummyDeviceContext) {
   dc->Unref();
 }
 
+TEST_F(RpcRendezvousMgrTest, ManyStepsAcrossShards) {
+  // Many live step ids exercise every shard of the step table.
+  const Rendezvous::ParsedKey key = MakeKey(Rendezvous::CreateKey(
+      "/job:mnist/replica:1/task:2/cpu:0", 7890,
+      "/job:mnist/replica:1/task:2/cpu:1", "foo", FrameAndIter(0, 0)));
+  const int64_t num_steps = 50;
+  for (int64_t step_id = 0; step_id < num_steps; ++step_id) {
+    RemoteRendezvous* rendez = rmgr_.Find(step_id);
+    TF_ASSERT_OK(rendez->Initialize(&worker_session_));
+    core::ScopedUnref unref(rendez);
+    Rendezvous::Args args;
+    TF_ASSERT_OK(
+        rendez->Send(key, args, V(std::to_string(step_id)), false));
+  }
+  for (int64_t step_id = 0; step_id < num_steps; ++step_id) {
+    Tensor val(DT_FLOAT);
+    bool val_dead = false;
+    TF_ASSERT_OK(rmgr_.RecvLocal(step_id, key, &val, &val_dead));
+    EXPECT_EQ(V(val), std::to_string(step_id));
+    rmgr_.Cleanup(step_id);
+  }
+}
+
+TEST(RendezvousKeyCacheTest, GetOrParse) {
+  RendezvousKeyCache cache;
+  const string key_str = Rendezvous::CreateKey(
+      "/job:mnist/replica:1/task:2/cpu:0", 7890,
+      "/job:mnist/replica:1/task:2/cpu:1", "foo", FrameAndIter(0, 0));
+
+  Rendezvous::ParsedKey first;
+  TF_ASSERT_OK(cache.GetOrParse(key_str, &first));
+  EXPECT_EQ(first.FullKey(), key_str);
+  EXPECT_EQ(first.edge_name, "foo");
+
+  // A second lookup is served from the cache and must be equivalent.
+  Rendezvous::ParsedKey second;
+  TF_ASSERT_OK(cache.GetOrParse(key_str, &second));
+  EXPECT_EQ(second.FullKey(), key_str);
+  EXPECT_EQ(second.src_device, first.src_device);
+  EXPECT_EQ(second.dst_device, first.dst_device);
+  EXPECT_EQ(second.edge_name, first.edge_name);
+
+  Rendezvous::ParsedKey bad;
+  EXPECT_FALSE(cache.GetOrParse("not a rendezvous key", &bad).ok());
+}
+
 TEST_F(RpcRendezvousMgrTest, RemoteRecvOne) {
   const int64_t step_id = 123;
   const Rendezvous::ParsedKey key = MakeKey(Rendezvous::CreateKey(
@@ -144,7 +144,8 @@ bool ReadNestedMessage(protobuf::io::CodedInputStream* input,
 }  // namespace
 
 bool TensorResponse::ParseTensorSubmessage(
-    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta) {
+    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta,
+    Source* source) {
   bool seen_tensor_content = false;
   while (true) {
     auto p = input->ReadTagWithCutoff(127);
@@ -195,12 +196,33 @@ bool TensorResponse::ParseTensorSubmessage(
         if (!ReadVarintSizeAsInt(input, &num_bytes)) return false;
         seen_tensor_content = true;
         TensorShape shape(tensor_meta->tensor_shape());
+        // Zero-copy fast path: if the entire tensor content is contiguous in
+        // the stream's current underlying buffer, suitably aligned, and the
+        // transport can hand out refcounted ownership of it, wrap the bytes
+        // in a TensorBuffer instead of copying them.
+        const void* direct = nullptr;
+        int direct_size = 0;
+        if (num_bytes > 0 && !alloc_attrs_.gpu_compatible() &&
+            !alloc_attrs_.nic_compatible() &&
+            static_cast<int64_t>(num_bytes) ==
+                shape.num_elements() * DataTypeSize(tensor_meta->dtype()) &&
+            input->GetDirectBufferPointer(&direct, &direct_size) &&
+            direct_size >= num_bytes &&
+            reinterpret_cast<uintptr_t>(direct) %
+                    Allocator::kAllocatorAlignment ==
+                0) {
+          TensorBuffer* owned = source->GetTensorBuffer(direct, num_bytes);
+          if (owned != nullptr) {
+            Tensor t(tensor_meta->dtype(), shape, owned);
+            owned->Unref();
+            if (!input->Skip(num_bytes)) return false;
+            tensor_ = std::move(t);
+            break;
+          }
+        }
         Tensor t(allocator_, tensor_meta->dtype(), shape);
         StringPiece buf = t.tensor_data();
         if (static_cast<size_t>(num_bytes) != buf.size()) return false;
-        // TODO(jeff,sanjay): Figure out a way to avoid this copy if
-        // the underlying ZeroCopyInputStream data is properly aligned
-        // and compatible with what allocator_ wants.
         if (!input->ReadRaw(const_cast<char*>(buf.data()), num_bytes))
           return false;
         tensor_ = std::move(t);
@@ -233,7 +255,7 @@ bool TensorResponse::ParseFast(Source* source) {
         std::pair<protobuf::io::CodedInputStream::Limit, int> p =
             input.IncrementRecursionDepthAndPushLimit(length);
         if (p.second < 0 ||
-            !ParseTensorSubmessage(&input, meta_.mutable_tensor())) {
+            !ParseTensorSubmessage(&input, meta_.mutable_tensor(), source)) {
           return false;
         }
         if (!input.DecrementRecursionDepthAndPopLimit(p.first)) {
@@ -64,6 +64,16 @@ class TensorResponse {
     // Ownership of the returned stream is retained by the Source and
     // should not be deleted by the caller.
     virtual ::tensorflow::protobuf::io::ZeroCopyInputStream* contents() = 0;
+
+    // If the transport can hand out refcounted ownership of the `length`
+    // bytes starting at `data` (which must lie within the buffer most
+    // recently returned by contents()), returns a new TensorBuffer that
+    // keeps those bytes alive; the caller assumes one reference. Returns
+    // nullptr if a zero-copy handoff is not possible, in which case the
+    // caller copies the bytes instead.
+    virtual TensorBuffer* GetTensorBuffer(const void* data, size_t length) {
+      return nullptr;
+    }
   };
 
   // Parse the RecvTensorResponse encoded in the data yielded by
@@ -93,7 +103,7 @@ class TensorResponse {
 
  private:
   bool ParseTensorSubmessage(protobuf::io::CodedInputStream* input,
-                             TensorProto* tensor_meta);
+                             TensorProto* tensor_meta, Source* source);
   bool ParseFast(Source* source);
   bool ParseSlow(Source* source);
 
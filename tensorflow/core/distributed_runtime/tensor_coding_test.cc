@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -22,6 +23,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
@@ -156,6 +158,104 @@ TEST_F(TensorResponseTest, Simple) {
 
 TEST_F(TensorResponseTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+namespace {
+
+// Counts live instances so the test can verify the response keeps the
+// transport's buffer referenced exactly as long as the tensor is alive.
+class CountingTensorBuffer : public TensorBuffer {
+ public:
+  CountingTensorBuffer(const void* data, size_t size, int* live_count)
+      : TensorBuffer(const_cast<void*>(data)),
+        size_(size),
+        live_count_(live_count) {
+    ++*live_count_;
+  }
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  ~CountingTensorBuffer() override { --*live_count_; }
+
+  const size_t size_;
+  int* const live_count_;
+};
+
+// StringSource-alike that, like a transport holding a single contiguous
+// receive slice, can hand out refcounted ownership of its bytes.
+class ZeroCopySource : public TensorResponse::Source {
+ public:
+  ZeroCopySource(const char* data, size_t size, int* live_count)
+      : data_(data), size_(size), live_count_(live_count) {}
+
+  protobuf::io::ZeroCopyInputStream* contents() override {
+    stream_.reset(new protobuf::io::ArrayInputStream(data_, size_));
+    return stream_.get();
+  }
+
+  TensorBuffer* GetTensorBuffer(const void* data, size_t length) override {
+    const char* begin = static_cast<const char*>(data);
+    if (begin < data_ || begin + length > data_ + size_) return nullptr;
+    return new CountingTensorBuffer(data, length, live_count_);
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  int* live_count_;
+  std::unique_ptr<protobuf::io::ArrayInputStream> stream_;
+};
+
+}  // namespace
+
+TEST_F(TensorResponseTest, ZeroCopyTensorContent) {
+  Tensor src(DT_FLOAT, TensorShape({32}));
+  for (int i = 0; i < 32; i++) {
+    src.flat<float>()(i) = static_cast<float>(i) + 0.25f;
+  }
+
+  RecvTensorResponse proto;
+  proto.set_is_dead(false);
+  proto.set_send_start_micros(123456);
+  src.AsProtoTensorContent(proto.mutable_tensor());
+  string encoded;
+  proto.AppendToString(&encoded);
+
+  // Place the encoding so that the tensor content lands on an allocator
+  // aligned address, as a transport receive buffer typically would.
+  const size_t content_offset =
+      encoded.find(string(src.tensor_data().data(), src.tensor_data().size()));
+  ASSERT_NE(content_offset, string::npos);
+  const size_t alignment = Allocator::kAllocatorAlignment;
+  char* base = static_cast<char*>(
+      port::AlignedMalloc(encoded.size() + alignment, alignment));
+  const size_t shift = (alignment - content_offset % alignment) % alignment;
+  memcpy(base + shift, encoded.data(), encoded.size());
+
+  int live_buffers = 0;
+  {
+    ZeroCopySource source(base + shift, encoded.size(), &live_buffers);
+    TensorResponse response;
+    DummyDevice cpu_device(Env::Default());
+    response.InitAlloc(&cpu_device, AllocatorAttributes());
+    TF_ASSERT_OK(response.ParseFrom(&source));
+
+    const Tensor& result = response.tensor();
+    EXPECT_EQ(result.dtype(), src.dtype());
+    EXPECT_EQ(result.shape(), src.shape());
+    EXPECT_EQ(result.DebugString(), src.DebugString());
+    // The tensor aliases the wire bytes rather than a copy of them.
+    EXPECT_EQ(result.tensor_data().data(), base + shift + content_offset);
+    EXPECT_EQ(live_buffers, 1);
+  }
+  EXPECT_EQ(live_buffers, 0);
+  port::AlignedFree(base);
+}
+
 string MakeFloatTensorTestCase(int num_elems) {
   std::vector<int8> v(num_elems);
   for (int i = 0; i < num_elems; i++) {
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/example/feature_util.h"
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 
@@ -201,4 +203,273 @@ template <>
 protobuf::RepeatedPtrField<std::string>* GetFeatureValues<tstring>(
     Feature* feature);
 
+namespace {
+
+// A minimal reader for the protobuf wire format, sufficient for the fields
+// used by the Example schema (see feature.proto). All reads consume from the
+// front of a string_view; length-delimited payloads are returned as views
+// into the original buffer.
+
+enum WireType {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5,
+};
+
+bool ReadVarint64(absl::string_view* data, uint64* value) {
+  uint64 result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (data->empty()) return false;
+    const uint8 byte = static_cast<uint8>((*data)[0]);
+    data->remove_prefix(1);
+    result |= static_cast<uint64>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Reads a field tag. Returns false at the end of the buffer or on a corrupt
+// tag.
+bool ReadTag(absl::string_view* data, uint32* field_number,
+             WireType* wire_type) {
+  uint64 tag;
+  if (!ReadVarint64(data, &tag)) return false;
+  *field_number = static_cast<uint32>(tag >> 3);
+  *wire_type = static_cast<WireType>(tag & 7);
+  return *field_number != 0;
+}
+
+bool ReadLengthDelimited(absl::string_view* data, absl::string_view* value) {
+  uint64 length;
+  if (!ReadVarint64(data, &length)) return false;
+  if (length > data->size()) return false;
+  *value = data->substr(0, length);
+  data->remove_prefix(length);
+  return true;
+}
+
+// Skips a field of the given wire type. Groups do not occur in the Example
+// schema and are treated as corruption.
+bool SkipField(absl::string_view* data, WireType wire_type) {
+  switch (wire_type) {
+    case kVarint: {
+      uint64 unused;
+      return ReadVarint64(data, &unused);
+    }
+    case kFixed64:
+      if (data->size() < 8) return false;
+      data->remove_prefix(8);
+      return true;
+    case kLengthDelimited: {
+      absl::string_view unused;
+      return ReadLengthDelimited(data, &unused);
+    }
+    case kFixed32:
+      if (data->size() < 4) return false;
+      data->remove_prefix(4);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Decodes a little-endian IEEE float, independently of host byte order.
+float DecodeFloat(const char* p) {
+  const uint32 bits = static_cast<uint8>(p[0]) |
+                      static_cast<uint32>(static_cast<uint8>(p[1])) << 8 |
+                      static_cast<uint32>(static_cast<uint8>(p[2])) << 16 |
+                      static_cast<uint32>(static_cast<uint8>(p[3])) << 24;
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Splits an encoded Feature into the kind of list that is set and the encoded
+// payload(s) of that list message, mirroring oneof decoding semantics: the
+// last kind on the wire wins, and repeated occurrences of the winning kind
+// are merged (their repeated values concatenated).
+bool DecodeFeatureKind(absl::string_view encoded, uint32* kind,
+                       std::vector<absl::string_view>* payloads) {
+  *kind = 0;
+  payloads->clear();
+  while (!encoded.empty()) {
+    uint32 field_number;
+    WireType wire_type;
+    if (!ReadTag(&encoded, &field_number, &wire_type)) return false;
+    if (field_number >= Feature::kBytesList &&
+        field_number <= Feature::kInt64List &&
+        wire_type == kLengthDelimited) {
+      absl::string_view payload;
+      if (!ReadLengthDelimited(&encoded, &payload)) return false;
+      if (field_number != *kind) {
+        *kind = field_number;
+        payloads->clear();
+      }
+      payloads->push_back(payload);
+    } else {
+      if (!SkipField(&encoded, wire_type)) return false;
+    }
+  }
+  return true;
+}
+
+// Builds the feature-name index for a serialized Example. An Example holds a
+// single Features message in field 1; Features holds map entries in field 1,
+// each with the key in field 1 and the Feature in field 2. Later map entries
+// with the same key overwrite earlier ones.
+bool IndexExample(
+    absl::string_view serialized,
+    absl::flat_hash_map<absl::string_view, absl::string_view>* index) {
+  while (!serialized.empty()) {
+    uint32 field_number;
+    WireType wire_type;
+    if (!ReadTag(&serialized, &field_number, &wire_type)) return false;
+    if (field_number == 1 && wire_type == kLengthDelimited) {
+      absl::string_view features;
+      if (!ReadLengthDelimited(&serialized, &features)) return false;
+      while (!features.empty()) {
+        if (!ReadTag(&features, &field_number, &wire_type)) return false;
+        if (field_number == 1 && wire_type == kLengthDelimited) {
+          absl::string_view entry;
+          if (!ReadLengthDelimited(&features, &entry)) return false;
+          absl::string_view key, value;
+          while (!entry.empty()) {
+            if (!ReadTag(&entry, &field_number, &wire_type)) return false;
+            if (field_number == 1 && wire_type == kLengthDelimited) {
+              if (!ReadLengthDelimited(&entry, &key)) return false;
+            } else if (field_number == 2 && wire_type == kLengthDelimited) {
+              if (!ReadLengthDelimited(&entry, &value)) return false;
+            } else {
+              if (!SkipField(&entry, wire_type)) return false;
+            }
+          }
+          (*index)[key] = value;
+        } else {
+          if (!SkipField(&features, wire_type)) return false;
+        }
+      }
+    } else {
+      if (!SkipField(&serialized, wire_type)) return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+ExampleView::ExampleView(absl::string_view serialized) {
+  ok_ = IndexExample(serialized, &index_);
+  if (!ok_) index_.clear();
+}
+
+bool ExampleView::GetInt64List(absl::string_view key,
+                               std::vector<protobuf_int64>* values) const {
+  values->clear();
+  auto it = index_.find(key);
+  if (it == index_.end()) return false;
+  uint32 kind;
+  std::vector<absl::string_view> payloads;
+  if (!DecodeFeatureKind(it->second, &kind, &payloads) ||
+      kind != Feature::kInt64List) {
+    return false;
+  }
+  for (absl::string_view payload : payloads) {
+    while (!payload.empty()) {
+      uint32 field_number;
+      WireType wire_type;
+      if (!ReadTag(&payload, &field_number, &wire_type)) return false;
+      if (field_number == 1 && wire_type == kLengthDelimited) {  // packed
+        absl::string_view packed;
+        if (!ReadLengthDelimited(&payload, &packed)) return false;
+        while (!packed.empty()) {
+          uint64 value;
+          if (!ReadVarint64(&packed, &value)) return false;
+          values->push_back(static_cast<protobuf_int64>(value));
+        }
+      } else if (field_number == 1 && wire_type == kVarint) {
+        uint64 value;
+        if (!ReadVarint64(&payload, &value)) return false;
+        values->push_back(static_cast<protobuf_int64>(value));
+      } else {
+        if (!SkipField(&payload, wire_type)) return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ExampleView::GetFloatList(absl::string_view key,
+                               std::vector<float>* values) const {
+  values->clear();
+  auto it = index_.find(key);
+  if (it == index_.end()) return false;
+  uint32 kind;
+  std::vector<absl::string_view> payloads;
+  if (!DecodeFeatureKind(it->second, &kind, &payloads) ||
+      kind != Feature::kFloatList) {
+    return false;
+  }
+  for (absl::string_view payload : payloads) {
+    while (!payload.empty()) {
+      uint32 field_number;
+      WireType wire_type;
+      if (!ReadTag(&payload, &field_number, &wire_type)) return false;
+      if (field_number == 1 && wire_type == kLengthDelimited) {  // packed
+        absl::string_view packed;
+        if (!ReadLengthDelimited(&payload, &packed)) return false;
+        if (packed.size() % sizeof(float) != 0) return false;
+        values->reserve(values->size() + packed.size() / sizeof(float));
+        for (size_t i = 0; i < packed.size(); i += sizeof(float)) {
+          values->push_back(DecodeFloat(packed.data() + i));
+        }
+      } else if (field_number == 1 && wire_type == kFixed32) {
+        if (payload.size() < sizeof(float)) return false;
+        values->push_back(DecodeFloat(payload.data()));
+        payload.remove_prefix(sizeof(float));
+      } else {
+        if (!SkipField(&payload, wire_type)) return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ExampleView::GetBytesList(absl::string_view key,
+                               std::vector<absl::string_view>* values) const {
+  values->clear();
+  auto it = index_.find(key);
+  if (it == index_.end()) return false;
+  uint32 kind;
+  std::vector<absl::string_view> payloads;
+  if (!DecodeFeatureKind(it->second, &kind, &payloads) ||
+      kind != Feature::kBytesList) {
+    return false;
+  }
+  for (absl::string_view payload : payloads) {
+    while (!payload.empty()) {
+      uint32 field_number;
+      WireType wire_type;
+      if (!ReadTag(&payload, &field_number, &wire_type)) return false;
+      if (field_number == 1 && wire_type == kLengthDelimited) {
+        absl::string_view value;
+        if (!ReadLengthDelimited(&payload, &value)) return false;
+        values->push_back(value);
+      } else {
+        if (!SkipField(&payload, wire_type)) return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ExampleView::GetFeature(absl::string_view key, Feature* feature) const {
+  auto it = index_.find(key);
+  if (it == index_.end()) return false;
+  return feature->ParseFromArray(it->second.data(), it->second.size());
+}
+
 }  // namespace tensorflow
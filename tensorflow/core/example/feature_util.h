@@ -110,6 +110,9 @@ limitations under the License.
 //     Supported types for the proto: Example, Features.
 //   GetFeatureValues<FeatureType>(feature) -> RepeatedField<FeatureType>
 //     Returns values of the feature for the FeatureType.
+//
+// For reading a few features out of a serialized Example without parsing the
+// whole proto, see the ExampleView class at the bottom of this file.
 
 #ifndef TENSORFLOW_CORE_EXAMPLE_FEATURE_UTIL_H_
 #define TENSORFLOW_CORE_EXAMPLE_FEATURE_UTIL_H_
@@ -118,8 +121,10 @@ limitations under the License.
 #include <iterator>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/base/macros.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "tensorflow/core/example/example.pb.h"
 #include "tensorflow/core/example/feature.pb.h"
@@ -502,5 +507,61 @@ bool ExampleHasFeature(absl::string_view key, const Example& example) {
   return HasFeature<FeatureType...>(key, example);
 }
 
+// ExampleView provides selective, zero-copy access to the features of a
+// serialized Example proto.
+//
+// Parsing a full Example materializes every feature, even when the caller
+// only reads a few of them. ExampleView instead scans the wire format once to
+// build an index from feature name to the encoded bytes of the corresponding
+// Feature, and decodes individual features only when they are accessed.
+// Bytes-list values are returned as string_views into the original buffer, so
+// no feature data is copied.
+//
+// The serialized buffer must outlive the view as well as any string_views
+// obtained from it.
+//
+// Example usage:
+//   ExampleView view(serialized);
+//   if (!view.ok()) { /* corrupt buffer */ }
+//   std::vector<absl::string_view> terms;
+//   if (view.GetBytesList("terms", &terms)) { /* use terms */ }
+class ExampleView {
+ public:
+  // Indexes the features of the serialized Example. If the buffer cannot be
+  // indexed, ok() returns false and the view behaves as if it were empty.
+  explicit ExampleView(absl::string_view serialized);
+
+  // Returns false if the buffer could not be indexed as an Example.
+  bool ok() const { return ok_; }
+
+  // Returns the number of indexed features.
+  size_t feature_count() const { return index_.size(); }
+
+  // Returns true if a feature with the specified key is present.
+  bool HasFeature(absl::string_view key) const {
+    return index_.contains(key);
+  }
+
+  // Decodes the feature with the specified key into "values". Returns false
+  // if the feature is missing, malformed, or holds values of a different
+  // type; "values" is cleared in that case. Bytes values are views into the
+  // serialized buffer.
+  bool GetInt64List(absl::string_view key,
+                    std::vector<protobuf_int64>* values) const;
+  bool GetFloatList(absl::string_view key, std::vector<float>* values) const;
+  bool GetBytesList(absl::string_view key,
+                    std::vector<absl::string_view>* values) const;
+
+  // Fully parses the feature with the specified key into "feature". Returns
+  // false if the feature is missing or malformed.
+  bool GetFeature(absl::string_view key, Feature* feature) const;
+
+ private:
+  // Map from feature name to the encoded bytes of its Feature message, both
+  // viewing into the serialized buffer.
+  absl::flat_hash_map<absl::string_view, absl::string_view> index_;
+  bool ok_ = false;
+};
+
 }  // namespace tensorflow
 #endif  // TENSORFLOW_CORE_EXAMPLE_FEATURE_UTIL_H_
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/example/feature_util.h"
 
+#include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -636,5 +637,111 @@ TEST(SequenceExampleTest, SetFeatureValuesWithInitializerList) {
   EXPECT_EQ(se.DebugString(), expected_proto.DebugString());
 }
 
+Example MakeExampleViewTestProto() {
+  Example example;
+  AppendFeatureValues<protobuf_int64>({1, 2, 3}, "ids", &example);
+  AppendFeatureValues({1.1f, 2.2f}, "weights", &example);
+  AppendFeatureValues({"alpha", "beta"}, "tags", &example);
+  return example;
+}
+
+TEST(ExampleViewTest, IndexesSerializedExample) {
+  const std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+
+  ExampleView view(serialized);
+
+  ASSERT_TRUE(view.ok());
+  EXPECT_EQ(3, view.feature_count());
+  EXPECT_TRUE(view.HasFeature("ids"));
+  EXPECT_TRUE(view.HasFeature("weights"));
+  EXPECT_TRUE(view.HasFeature("tags"));
+  EXPECT_FALSE(view.HasFeature("missing"));
+}
+
+TEST(ExampleViewTest, ReadsInt64List) {
+  const std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+  ExampleView view(serialized);
+
+  std::vector<protobuf_int64> ids;
+  ASSERT_TRUE(view.GetInt64List("ids", &ids));
+  EXPECT_EQ(std::vector<protobuf_int64>({1, 2, 3}), ids);
+}
+
+TEST(ExampleViewTest, ReadsNegativeInt64Values) {
+  Example example;
+  AppendFeatureValues<protobuf_int64>({-1, -42}, "ids", &example);
+  ExampleView view(example.SerializeAsString());
+
+  std::vector<protobuf_int64> ids;
+  ASSERT_TRUE(view.GetInt64List("ids", &ids));
+  EXPECT_EQ(std::vector<protobuf_int64>({-1, -42}), ids);
+}
+
+TEST(ExampleViewTest, ReadsFloatList) {
+  const std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+  ExampleView view(serialized);
+
+  std::vector<float> weights;
+  ASSERT_TRUE(view.GetFloatList("weights", &weights));
+  ASSERT_EQ(2, weights.size());
+  EXPECT_NEAR(1.1, weights[0], kTolerance);
+  EXPECT_NEAR(2.2, weights[1], kTolerance);
+}
+
+TEST(ExampleViewTest, ReadsBytesListWithoutCopying) {
+  const std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+  ExampleView view(serialized);
+
+  std::vector<absl::string_view> tags;
+  ASSERT_TRUE(view.GetBytesList("tags", &tags));
+  ASSERT_EQ(2, tags.size());
+  EXPECT_EQ("alpha", tags[0]);
+  EXPECT_EQ("beta", tags[1]);
+  // The values are views into the serialized buffer, not copies.
+  for (absl::string_view tag : tags) {
+    EXPECT_GE(tag.data(), serialized.data());
+    EXPECT_LE(tag.data() + tag.size(), serialized.data() + serialized.size());
+  }
+}
+
+TEST(ExampleViewTest, RejectsMissingOrWrongTypedFeature) {
+  const std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+  ExampleView view(serialized);
+
+  std::vector<protobuf_int64> int_values;
+  std::vector<float> float_values;
+  EXPECT_FALSE(view.GetInt64List("missing", &int_values));
+  EXPECT_FALSE(view.GetInt64List("weights", &int_values));
+  EXPECT_FALSE(view.GetFloatList("ids", &float_values));
+}
+
+TEST(ExampleViewTest, ParsesIndividualFeature) {
+  const std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+  ExampleView view(serialized);
+
+  Feature feature;
+  ASSERT_TRUE(view.GetFeature("ids", &feature));
+  ASSERT_EQ(Feature::KindCase::kInt64List, feature.kind_case());
+  EXPECT_EQ(3, feature.int64_list().value_size());
+}
+
+TEST(ExampleViewTest, HandlesEmptyExample) {
+  Example example;
+  ExampleView view(example.SerializeAsString());
+
+  EXPECT_TRUE(view.ok());
+  EXPECT_EQ(0, view.feature_count());
+}
+
+TEST(ExampleViewTest, RejectsCorruptBuffer) {
+  std::string serialized = MakeExampleViewTestProto().SerializeAsString();
+  serialized.resize(serialized.size() - 1);  // Truncate the last feature.
+
+  ExampleView view(serialized);
+
+  EXPECT_FALSE(view.ok());
+  EXPECT_EQ(0, view.feature_count());
+}
+
 }  // namespace
 }  // namespace tensorflow
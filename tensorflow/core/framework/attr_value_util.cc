@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "tensorflow/core/framework/attr_value_util.h"
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/escaping.h"
 #include "tensorflow/core/framework/attr_value.pb_text.h"
 #include "tensorflow/core/framework/tensor.pb_text.h"
@@ -31,7 +33,9 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/protobuf.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 
 namespace tensorflow {
 namespace {
@@ -604,6 +608,11 @@ void SetAttrValue(gtl::ArraySlice<NameAttrList> value, AttrValue* out) {
 
 bool AreAttrValuesEqual(const AttrValue& a, const AttrValue& b,
                         bool allow_false_negatives) {
+  // Interned attr values (see InternAttrValue) compare equal by identity.
+  if (&a == &b) {
+    return true;
+  }
+
   if (a.type() != b.type()) {
     return false;
   } else if (a.type() != DT_INVALID && b.type() != DT_INVALID) {
@@ -651,6 +660,28 @@ uint64 FastAttrValueHash(const AttrValue& a) {
   return AttrValueHash(a, FastTensorProtoHash);
 }
 
+const AttrValue* InternAttrValue(const AttrValue& value) {
+  // Hash buckets hold every distinct interned value that shares a hash, so
+  // equality of interned pointers holds even across hash collisions.
+  struct InternTable {
+    mutex mu;
+    absl::flat_hash_map<uint64, std::vector<std::unique_ptr<AttrValue>>>
+        buckets TF_GUARDED_BY(mu);
+  };
+  static InternTable* table = new InternTable;
+
+  const uint64 h = AttrValueHash(value);
+  mutex_lock l(table->mu);
+  std::vector<std::unique_ptr<AttrValue>>& bucket = table->buckets[h];
+  for (const auto& interned : bucket) {
+    if (AreAttrValuesEqual(*interned, value)) {
+      return interned.get();
+    }
+  }
+  bucket.push_back(std::make_unique<AttrValue>(value));
+  return bucket.back().get();
+}
+
 bool HasPlaceHolder(const AttrValue& val) {
   switch (val.value_case()) {
     case AttrValue::kList: {
@@ -116,6 +116,14 @@ uint64 FastAttrValueHash(const AttrValue& a);
 bool AreAttrValuesEqual(const AttrValue& a, const AttrValue& b,
                         bool allow_false_negatives = false);
 
+// Returns a pointer to an immutable, process-lifetime AttrValue equal to
+// `value`. All calls with values that compare equal per AreAttrValuesEqual
+// return the same pointer, so equality between interned values is a pointer
+// compare and duplicated attr values (e.g. `T: DT_FLOAT`) share a single
+// representation. Interned values are never freed: intern only values drawn
+// from a bounded set, such as canonical node attrs, never arbitrary data.
+const AttrValue* InternAttrValue(const AttrValue& value);
+
 // Returns true if "val" has a placeholder.
 bool HasPlaceHolder(const AttrValue& val);
 
@@ -249,4 +249,23 @@ TEST(AttrValueEquality, GiantTensors) {
   EXPECT_TRUE(AreAttrValuesEqual(tensor, tensor));
 }
 
+TEST(AttrValueIntern, EqualValuesShareOneInstance) {
+  const AttrValue* a = InternAttrValue(V(DT_FLOAT));
+  const AttrValue* b = InternAttrValue(V(DT_FLOAT));
+  EXPECT_EQ(a, b);
+  EXPECT_TRUE(AreAttrValuesEqual(*a, V(DT_FLOAT)));
+
+  const AttrValue* c = InternAttrValue(V(DT_INT32));
+  EXPECT_NE(a, c);
+
+  const AttrValue* s1 = InternAttrValue(V("NHWC"));
+  const AttrValue* s2 = InternAttrValue(V(string("NHWC")));
+  EXPECT_EQ(s1, s2);
+  EXPECT_NE(a, s1);
+
+  const AttrValue* f1 = InternAttrValue(F("f", {{"T", V(DT_FLOAT)}}));
+  const AttrValue* f2 = InternAttrValue(F("f", {{"T", V(DT_FLOAT)}}));
+  EXPECT_EQ(f1, f2);
+}
+
 }  // namespace tensorflow
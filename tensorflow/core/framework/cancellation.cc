@@ -16,6 +16,8 @@ limitations under the License.
 #include "tensorflow/core/framework/cancellation.h"
 
 #include <forward_list>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "tensorflow/core/lib/core/errors.h"
@@ -43,7 +45,7 @@ void CancellationManager::StartCancel() {
 }
 
 void CancellationManager::StartCancelWithStatus(const Status& status) {
-  gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
+  std::vector<CallbackConfiguration> callbacks_to_run;
   std::forward_list<CancellationManager*> children_to_cancel;
   Notification* cancelled_notification = nullptr;
   {
@@ -53,7 +55,16 @@ void CancellationManager::StartCancelWithStatus(const Status& status) {
     }
     is_cancelling_ = true;
     if (state_) {
-      std::swap(state_->callbacks, callbacks_to_run);
+      // Holding `mu_` exclusively excludes every thread that acquires shard
+      // mutexes (they all hold `mu_` in shared mode while doing so), so the
+      // shard locks below are uncontended.
+      for (CallbackShard& shard : state_->callback_shards) {
+        mutex_lock sl(shard.mu);
+        for (auto& key_and_value : shard.callbacks) {
+          callbacks_to_run.push_back(std::move(key_and_value.second));
+        }
+        shard.callbacks.clear();
+      }
 
       // Remove all children from the list of children.
       CancellationManager* child = state_->first_child;
@@ -72,8 +83,7 @@ void CancellationManager::StartCancelWithStatus(const Status& status) {
   // not block. The callbacks remain valid because any concurrent call
   // to DeregisterCallback will block until the
   // cancelled_notification_ is notified.
-  for (auto key_and_value : callbacks_to_run) {
-    CallbackConfiguration& config = key_and_value.second;
+  for (CallbackConfiguration& config : callbacks_to_run) {
     if (!status.ok() && config.log_error) {
       LOG(WARNING) << "Cancellation callback \"" << config.name
                    << "\" is triggered due to a "
@@ -111,41 +121,64 @@ bool CancellationManager::RegisterCallbackWithErrorLogging(
 bool CancellationManager::RegisterCallbackConfig(CancellationToken token,
                                                  CallbackConfiguration config) {
   DCHECK_LT(token, next_cancellation_token_) << "Invalid cancellation token";
-  mutex_lock l(mu_);
-  bool should_register = !is_cancelled_ && !is_cancelling_;
-  if (should_register) {
-    if (!state_) {
-      state_ = absl::make_unique<State>();
+  {
+    // Fast path: the state already exists, so registration only needs `mu_`
+    // in shared mode plus the mutex of the shard the token maps to.
+    // Registrations for tokens in different shards proceed in parallel.
+    tf_shared_lock l(mu_);
+    if (is_cancelled_ || is_cancelling_) {
+      return false;
+    }
+    if (state_) {
+      CallbackShard& shard = state_->callback_shard(token);
+      mutex_lock sl(shard.mu);
+      std::swap(shard.callbacks[token], config);
+      return true;
     }
-    std::swap(state_->callbacks[token], config);
   }
-  return should_register;
+  // Slow path: take `mu_` exclusively to create the state, then re-check the
+  // cancellation flags, which may have changed while `mu_` was released.
+  mutex_lock l(mu_);
+  if (is_cancelled_ || is_cancelling_) {
+    return false;
+  }
+  if (!state_) {
+    state_ = absl::make_unique<State>();
+  }
+  CallbackShard& shard = state_->callback_shard(token);
+  mutex_lock sl(shard.mu);
+  std::swap(shard.callbacks[token], config);
+  return true;
 }
 
 bool CancellationManager::DeregisterCallback(CancellationToken token) {
-  mu_.lock();
-  if (is_cancelled_) {
-    mu_.unlock();
-    return false;
-  } else if (is_cancelling_) {
-    Notification* cancelled_notification =
-        state_ ? &state_->cancelled_notification : nullptr;
-    mu_.unlock();
-    // Wait for all of the cancellation callbacks to be called. This
-    // wait ensures that the caller of DeregisterCallback does not
-    // return immediately and free objects that may be used in the
-    // execution of any currently pending callbacks in StartCancel.
-    if (cancelled_notification) {
-      cancelled_notification->WaitForNotification();
+  Notification* cancelled_notification = nullptr;
+  {
+    tf_shared_lock l(mu_);
+    if (is_cancelled_) {
+      return false;
     }
-    return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
+    if (!is_cancelling_) {
+      // Common path: cancellation has not started, so the callback can be
+      // removed under the shard mutex alone without excluding concurrent
+      // registrations in other shards.
+      if (state_) {
+        CallbackShard& shard = state_->callback_shard(token);
+        mutex_lock sl(shard.mu);
+        shard.callbacks.erase(token);
+      }
+      return true;
     }
-    mu_.unlock();
-    return true;
+    cancelled_notification = state_ ? &state_->cancelled_notification : nullptr;
+  }
+  // Wait for all of the cancellation callbacks to be called. This
+  // wait ensures that the caller of DeregisterCallback does not
+  // return immediately and free objects that may be used in the
+  // execution of any currently pending callbacks in StartCancel.
+  if (cancelled_notification) {
+    cancelled_notification->WaitForNotification();
   }
+  return false;
 }
 
 bool CancellationManager::RegisterChild(CancellationManager* child) {
@@ -208,12 +241,14 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 }
 
 bool CancellationManager::TryDeregisterCallback(CancellationToken token) {
-  mutex_lock lock(mu_);
+  tf_shared_lock lock(mu_);
   if (is_cancelled_ || is_cancelling_) {
     return false;
   } else {
     if (state_) {
-      state_->callbacks.erase(token);
+      CallbackShard& shard = state_->callback_shard(token);
+      mutex_lock sl(shard.mu);
+      shard.callbacks.erase(token);
     }
     return true;
   }
@@ -168,9 +168,26 @@ class CancellationManager {
     bool log_error = false;
   };
 
+  // Registered callbacks are sharded by token so that concurrent
+  // registrations and deregistrations from unrelated ops do not serialize on
+  // a single mutex. A shard mutex is only acquired while `mu_` is held (at
+  // least in shared mode), so `mu_` always precedes a shard mutex in the
+  // lock order.
+  static constexpr int kNumCallbackShards = 8;
+
+  struct CallbackShard {
+    mutex mu;
+    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks
+        TF_GUARDED_BY(mu);
+  };
+
   struct State {
     Notification cancelled_notification;
-    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks;
+    CallbackShard callback_shards[kNumCallbackShards];
+
+    CallbackShard& callback_shard(CancellationToken token) {
+      return callback_shards[token % kNumCallbackShards];
+    }
 
     // If this CancellationManager has any children, this member points to the
     // head of a doubly-linked list of its children.
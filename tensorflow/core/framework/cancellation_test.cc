@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/framework/cancellation.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -128,6 +129,45 @@ TEST(Cancellation, CancelMultiple) {
   EXPECT_FALSE(is_cancelled_3);
 }
 
+TEST(Cancellation, ManyCallbacksAcrossShards) {
+  auto manager = std::make_unique<CancellationManager>();
+  std::atomic<int> num_cancelled{0};
+  std::vector<CancellationToken> tokens;
+  for (int i = 0; i < 100; ++i) {
+    auto token = manager->get_cancellation_token();
+    EXPECT_TRUE(manager->RegisterCallback(
+        token, [&num_cancelled]() { num_cancelled++; }));
+    tokens.push_back(token);
+  }
+  // Deregister every other callback before cancelling.
+  for (int i = 0; i < 100; i += 2) {
+    EXPECT_TRUE(manager->DeregisterCallback(tokens[i]));
+  }
+  manager->StartCancel();
+  EXPECT_EQ(num_cancelled.load(), 50);
+}
+
+TEST(Cancellation, ConcurrentRegisterDeregister) {
+  auto manager = std::make_unique<CancellationManager>();
+  std::atomic<int> num_cancelled{0};
+  {
+    thread::ThreadPool w(Env::Default(), "test", 4);
+    for (int i = 0; i < 4; ++i) {
+      w.Schedule([&manager, &num_cancelled]() {
+        for (int j = 0; j < 100; ++j) {
+          auto token = manager->get_cancellation_token();
+          if (manager->RegisterCallback(
+                  token, [&num_cancelled]() { num_cancelled++; })) {
+            manager->DeregisterCallback(token);
+          }
+        }
+      });
+    }
+  }
+  manager->StartCancel();
+  EXPECT_EQ(num_cancelled.load(), 0);
+}
+
 TEST(Cancellation, IsCancelled) {
   auto cm = std::make_unique<CancellationManager>();
   thread::ThreadPool w(Env::Default(), "test", 4);
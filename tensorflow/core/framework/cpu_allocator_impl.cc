@@ -14,6 +14,12 @@ limitations under the License.
 ==============================================================================*/
 
 #include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/allocator_registry.h"
@@ -25,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -61,6 +68,120 @@ static int64_t TotalAllocationWarningBytes() {
 
 namespace {
 
+// Opt-in pooled backing store for large host allocations. When enabled via
+// TF_CPU_LARGE_ALLOC_POOL=true, allocations of at least
+// TF_CPU_LARGE_ALLOC_POOL_THRESHOLD bytes (default 2MiB) are rounded up to a
+// multiple of 2MiB, advised onto transparent huge pages where supported, and
+// returned to a bounded free list on deallocation instead of going back to
+// the OS. Repeatedly allocated multi-MB buffers (e.g. training activations)
+// then reuse already-mapped pages rather than churning TLB entries and page
+// faults. TF_CPU_LARGE_ALLOC_POOL_MAX_BYTES (default 256MiB) bounds the
+// bytes retained on the free list.
+class LargeAllocationPool {
+ public:
+  // Returns the process-wide pool, or nullptr if pooling is not enabled.
+  static LargeAllocationPool* Get() {
+    static LargeAllocationPool* pool = []() -> LargeAllocationPool* {
+      bool enabled = false;
+      TF_CHECK_OK(
+          ReadBoolFromEnvVar("TF_CPU_LARGE_ALLOC_POOL", false, &enabled));
+      if (!enabled) return nullptr;
+      int64_t threshold;
+      TF_CHECK_OK(ReadInt64FromEnvVar("TF_CPU_LARGE_ALLOC_POOL_THRESHOLD",
+                                      kHugePageBytes, &threshold));
+      int64_t max_free_bytes;
+      TF_CHECK_OK(ReadInt64FromEnvVar("TF_CPU_LARGE_ALLOC_POOL_MAX_BYTES",
+                                      256LL << 20, &max_free_bytes));
+      return new LargeAllocationPool(threshold, max_free_bytes);
+    }();
+    return pool;
+  }
+
+  // Returns a block of at least "num_bytes" bytes, reusing a pooled block
+  // when one of the right size class is free. Returns nullptr if the request
+  // is below the pooling threshold or needs a stronger alignment than the
+  // pool provides; the caller should then fall back to port::AlignedMalloc.
+  void* Allocate(size_t alignment, size_t num_bytes) {
+    if (num_bytes < threshold_ ||
+        alignment > static_cast<size_t>(Allocator::kAllocatorAlignment)) {
+      return nullptr;
+    }
+    const size_t rounded = RoundUpToHugePage(num_bytes);
+    {
+      mutex_lock l(mu_);
+      auto it = free_blocks_.find(rounded);
+      if (it != free_blocks_.end() && !it->second.empty()) {
+        void* ptr = it->second.back();
+        it->second.pop_back();
+        free_bytes_ -= rounded;
+        in_use_.emplace(ptr, rounded);
+        return ptr;
+      }
+    }
+    void* ptr = port::AlignedMalloc(rounded, Allocator::kAllocatorAlignment);
+    if (ptr == nullptr) {
+      return nullptr;
+    }
+#if defined(__linux__)
+    // Ask the kernel to back this region with transparent huge pages. This
+    // is advisory; failure simply leaves the region on regular pages.
+    madvise(ptr, rounded, MADV_HUGEPAGE);
+#endif
+    mutex_lock l(mu_);
+    in_use_.emplace(ptr, rounded);
+    return ptr;
+  }
+
+  // Returns true iff "ptr" came from this pool, in which case the block has
+  // been returned to the free list (or released to the OS if the free list
+  // is at capacity). Returns false for pointers the pool does not own.
+  bool Deallocate(void* ptr) {
+    bool release_to_os = false;
+    {
+      mutex_lock l(mu_);
+      auto it = in_use_.find(ptr);
+      if (it == in_use_.end()) {
+        return false;
+      }
+      const size_t rounded = it->second;
+      in_use_.erase(it);
+      if (free_bytes_ + rounded <= max_free_bytes_) {
+        free_blocks_[rounded].push_back(ptr);
+        free_bytes_ += rounded;
+      } else {
+        release_to_os = true;
+      }
+    }
+    if (release_to_os) {
+      port::AlignedFree(ptr);
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int64_t kHugePageBytes = 2 << 20;
+
+  LargeAllocationPool(int64_t threshold, int64_t max_free_bytes)
+      : threshold_(threshold), max_free_bytes_(max_free_bytes) {}
+
+  static size_t RoundUpToHugePage(size_t num_bytes) {
+    return (num_bytes + kHugePageBytes - 1) & ~(kHugePageBytes - 1);
+  }
+
+  const size_t threshold_;
+  const size_t max_free_bytes_;
+
+  mutex mu_;
+  // rounded block size -> free blocks of that size.
+  std::unordered_map<size_t, std::vector<void*>> free_blocks_
+      TF_GUARDED_BY(mu_);
+  // live pooled pointer -> its rounded block size.
+  std::unordered_map<void*, size_t> in_use_ TF_GUARDED_BY(mu_);
+  size_t free_bytes_ TF_GUARDED_BY(mu_) = 0;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(LargeAllocationPool);
+};
+
 // A default Allocator for CPU devices.  ProcessState::GetCPUAllocator() will
 // return a different version that may perform better, but may also lack the
 // optional stats triggered by the functions above.  TODO(tucker): migrate all
@@ -84,7 +205,14 @@ class CPUAllocator : public Allocator {
                    << "% of free system memory.";
     }
 
-    void* p = port::AlignedMalloc(num_bytes, alignment);
+    void* p = nullptr;
+    LargeAllocationPool* pool = LargeAllocationPool::Get();
+    if (pool != nullptr) {
+      p = pool->Allocate(alignment, num_bytes);
+    }
+    if (p == nullptr) {
+      p = port::AlignedMalloc(num_bytes, alignment);
+    }
     if (cpu_allocator_collect_stats) {
       const std::size_t alloc_size = port::MallocExtension_GetAllocatedSize(p);
       mutex_lock l(mu_);
@@ -117,7 +245,10 @@ class CPUAllocator : public Allocator {
       stats_.bytes_in_use -= alloc_size;
       AddTraceMe("MemoryDeallocation", ptr, 0, alloc_size);
     }
-    port::AlignedFree(ptr);
+    LargeAllocationPool* pool = LargeAllocationPool::Get();
+    if (pool == nullptr || !pool->Deallocate(ptr)) {
+      port::AlignedFree(ptr);
+    }
   }
 
   void AddTraceMe(absl::string_view traceme_name, const void* chunk_ptr,
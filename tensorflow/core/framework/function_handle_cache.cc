@@ -22,8 +22,8 @@ namespace tensorflow {
 
 FunctionHandleCache::FunctionHandleCache(FunctionLibraryRuntime* lib)
     : lib_(lib),
-      state_handle_(
-          strings::Printf("%lld", static_cast<long long>(random::New64()))) {}
+      id_(random::New64()),
+      state_handle_(strings::Printf("%lld", static_cast<long long>(id_))) {}
 
 FunctionHandleCache::~FunctionHandleCache() {
   Status s = Clear();
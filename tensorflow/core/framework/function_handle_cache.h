@@ -42,9 +42,15 @@ class FunctionHandleCache {
   // functions involved.
   Status Clear();
 
+  // Returns an identifier unique to this cache instance. Callers that memoize
+  // per-cache state can use the identifier to make sure a memoized entry is
+  // not mistaken for a different cache allocated at the same address.
+  uint64 id() const { return id_; }
+
  private:
   mutex mu_;
   FunctionLibraryRuntime* lib_ = nullptr;  // not owned
+  const uint64 id_;
   const string state_handle_;
   std::unordered_map<string, FunctionLibraryRuntime::Handle> handles_
       TF_GUARDED_BY(mu_);
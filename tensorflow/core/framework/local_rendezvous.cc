@@ -97,29 +97,47 @@ void LocalRendezvous::ItemQueue::push_back(Item* item) {
   }
 }
 
+// Lock ordering: a shard mutex may be held while acquiring `status_mu_` or
+// `pending_callbacks_mu_`, but never the other way around, and no two shard
+// mutexes are ever held at the same time.
+
 LocalRendezvous::~LocalRendezvous() {
   // Before destroying this rendezvous instance, make sure all the done-callback
   // calls have finished and the tensors have been released from the queue.
   {
-    mutex_lock l(mu_);
+    mutex_lock l(pending_callbacks_mu_);
     while (pending_callback_counter_ != 0) {
       pending_callback_cond_var_.wait_for(l, std::chrono::milliseconds(50));
     }
   }
 
-  if (!table_.empty()) {
+  bool empty = true;
+  for (TableShard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    empty = empty && shard.table.empty();
+  }
+  if (!empty) {
     StartAbort(errors::Cancelled("LocalRendezvous deleted"));
   }
 }
 
 namespace {
 uint64 KeyHash(const StringPiece& k) { return Hash64(k.data(), k.size()); }
+
+// Keys produced by Rendezvous::ParseKey carry their hash; the send/recv ops
+// parse their keys once at kernel construction, so using the cached value
+// avoids re-hashing the key string on every step.  Keys assembled by hand
+// (hash 0) fall back to hashing here.
+uint64 KeyHash(const Rendezvous::ParsedKey& key) {
+  const uint64 h = key.FullKeyHash();
+  return TF_PREDICT_TRUE(h != 0) ? h : KeyHash(key.FullKey());
+}
 }  // namespace
 
 Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
                              const Rendezvous::Args& send_args,
                              const Tensor& val, const bool is_dead) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = KeyHash(key);
   DVLOG(2) << "Send " << this << " " << key_hash << " " << key.FullKey();
 
   if (is_dead) {
@@ -132,15 +150,22 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
         ->IncrementBy(1);
   }
 
-  mu_.lock();
-  if (!status_.ok()) {
-    // Rendezvous has been aborted.
-    Status s = status_;
-    mu_.unlock();
-    return s;
+  TableShard& shard = ShardFor(key_hash);
+  shard.mu.lock();
+  {
+    // Check the abort status while holding the shard lock, so that a
+    // concurrent StartAbort (which sets the status before draining the
+    // shards) cannot miss an item enqueued here.
+    mutex_lock l(status_mu_);
+    if (!status_.ok()) {
+      // Rendezvous has been aborted.
+      Status s = status_;
+      shard.mu.unlock();
+      return s;
+    }
   }
 
-  ItemQueue* queue = &table_[key_hash];
+  ItemQueue* queue = &shard.table[key_hash];
   if (queue->head == nullptr || queue->head->type == Item::kSend) {
     // There is no waiter for this message. Append the message
     // into the queue. The waiter will pick it up when arrives.
@@ -149,7 +174,7 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
     // the lock.
     DVLOG(2) << "Enqueue Send Item (key:" << key.FullKey() << "). ";
     queue->push_back(new Item(send_args, val, is_dead));
-    mu_.unlock();
+    shard.mu.unlock();
     return OkStatus();
   }
 
@@ -160,7 +185,7 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
   // Delete the queue when the last element has been consumed.
   if (item->next == nullptr) {
     DVLOG(2) << "Clean up Send/Recv queue (key:" << key.FullKey() << "). ";
-    table_.erase(key_hash);
+    shard.table.erase(key_hash);
   } else {
     queue->head = item->next;
   }
@@ -174,14 +199,17 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
     rc_owner_ref.reset(rc_owner_);
     rc_owner_->Ref();
   }
-  pending_callback_counter_++;
+  {
+    mutex_lock l(pending_callbacks_mu_);
+    pending_callback_counter_++;
+  }
   // Invoke the done-callback, without holding the lock.
-  mu_.unlock();
+  shard.mu.unlock();
   DCHECK_EQ(item->type, Item::kRecv);
   (*item->recv_state.waiter)(OkStatus(), send_args, item->args, val, is_dead);
   delete item;
   {
-    mutex_lock l(mu_);
+    mutex_lock l(pending_callbacks_mu_);
     pending_callback_counter_--;
     if (pending_callback_counter_ == 0) {
       pending_callback_cond_var_.notify_all();
@@ -193,19 +221,27 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
 void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
                                 const Rendezvous::Args& recv_args,
                                 Rendezvous::DoneCallback done) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = KeyHash(key);
   DVLOG(2) << "Recv " << this << " " << key_hash << " " << key.FullKey();
 
-  mu_.lock();
-  if (!status_.ok()) {
-    // Rendezvous has been aborted.
-    Status s = status_;
-    mu_.unlock();
-    done(s, Rendezvous::Args(), recv_args, Tensor(), false);
-    return;
+  TableShard& shard = ShardFor(key_hash);
+  shard.mu.lock();
+  {
+    // See the corresponding comment in Send.
+    Status s;
+    {
+      mutex_lock l(status_mu_);
+      s = status_;
+    }
+    if (!s.ok()) {
+      // Rendezvous has been aborted.
+      shard.mu.unlock();
+      done(s, Rendezvous::Args(), recv_args, Tensor(), false);
+      return;
+    }
   }
 
-  ItemQueue* queue = &table_[key_hash];
+  ItemQueue* queue = &shard.table[key_hash];
   if (queue->head == nullptr || queue->head->type == Item::kRecv) {
     // There is no message to pick up.
     // Only recv-related fields need to be filled.
@@ -231,8 +267,9 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
       already_cancelled = !cm->RegisterCallback(token, [this, token, key_hash] {
         Item* item = nullptr;
         {
-          mutex_lock l(mu_);
-          ItemQueue* queue = &table_[key_hash];
+          TableShard& shard = ShardFor(key_hash);
+          mutex_lock l(shard.mu);
+          ItemQueue* queue = &shard.table[key_hash];
           // Find an item in the queue with a cancellation token that matches
           // `token`, and remove it.
           if (queue->head != nullptr && queue->head->type == Item::kRecv) {
@@ -243,7 +280,7 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
                 if (queue->head->next == nullptr) {
                   // We have a single-element queue, so we can erase it from
                   // the table.
-                  table_.erase(key_hash);
+                  shard.table.erase(key_hash);
                 } else {
                   // Remove the current item from the queue.
                   if (curr == queue->head) {
@@ -275,7 +312,7 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
       });
     }
     if (already_cancelled) {
-      mu_.unlock();
+      shard.mu.unlock();
       // Unref case (2)
       if (rc_owner_) rc_owner_->Unref();
       done(StatusGroup::MakeDerived(
@@ -312,7 +349,7 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
       queue->push_back(new Item(recv_args, std::move(done), token));
     }
 
-    mu_.unlock();
+    shard.mu.unlock();
     return;
   }
 
@@ -324,7 +361,7 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
   // Delete the queue when the last element has been consumed.
   if (item->next == nullptr) {
     DVLOG(2) << "Clean up Send/Recv queue (key:" << key.FullKey() << "). ";
-    table_.erase(key_hash);
+    shard.table.erase(key_hash);
   } else {
     queue->head = item->next;
   }
@@ -338,15 +375,18 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
     rc_owner_ref.reset(rc_owner_);
     rc_owner_->Ref();
   }
-  pending_callback_counter_++;
+  {
+    mutex_lock l(pending_callbacks_mu_);
+    pending_callback_counter_++;
+  }
   // Invoke the done-callback, without holding the lock.
-  mu_.unlock();
+  shard.mu.unlock();
   DCHECK_EQ(item->type, Item::kSend);
   done(OkStatus(), item->args, recv_args, *item->send_state.value,
        item->send_state.is_dead);
   delete item;
   {
-    mutex_lock l(mu_);
+    mutex_lock l(pending_callbacks_mu_);
     pending_callback_counter_--;
     if (pending_callback_counter_ == 0) {
       pending_callback_cond_var_.notify_all();
@@ -356,31 +396,37 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
 
 void LocalRendezvous::StartAbort(const Status& status) {
   CHECK(!status.ok());
-  Table table;
+  // Set the status before draining any shard. Send/Recv check the status
+  // while holding the shard lock, so any item enqueued after this point is
+  // preceded by an aborted-status check and no item can be stranded.
   {
-    mutex_lock l(mu_);
+    mutex_lock l(status_mu_);
     status_.Update(status);
-    table_.swap(table);
   }
-  for (auto& p : table) {
-    Item* item = p.second.head;
-    while (item != nullptr) {
-      if (item->type == Item::kRecv) {
-        (*item->recv_state.waiter)(status, Rendezvous::Args(),
-                                   Rendezvous::Args(), Tensor(), false);
+  for (TableShard& shard : shards_) {
+    Table table;
+    {
+      mutex_lock l(shard.mu);
+      shard.table.swap(table);
+    }
+    for (auto& p : table) {
+      Item* item = p.second.head;
+      while (item != nullptr) {
+        if (item->type == Item::kRecv) {
+          (*item->recv_state.waiter)(status, Rendezvous::Args(),
+                                     Rendezvous::Args(), Tensor(), false);
+        }
+        Item* to_delete = item;
+        item = item->next;
+        delete to_delete;
       }
-      Item* to_delete = item;
-      item = item->next;
-      delete to_delete;
     }
   }
 }
 
 Status LocalRendezvous::status() {
-  mu_.lock();
-  Status s = status_;
-  mu_.unlock();
-  return s;
+  mutex_lock l(status_mu_);
+  return status_;
 }
 
 }  // namespace tensorflow
@@ -68,16 +68,33 @@ class LocalRendezvous {
 
   typedef gtl::FlatMap<uint64, ItemQueue> Table;
 
+  // The table is sharded by key hash so that Send/Recv pairs on different
+  // keys do not contend on a single mutex. Each shard is independently
+  // locked; abort status and the pending-callback counter have their own
+  // locks (see the lock-ordering comments in local_rendezvous.cc).
+  struct TableShard {
+    mutex mu;
+    Table table TF_GUARDED_BY(mu);
+  };
+  static constexpr int kNumShards = 16;
+
+  TableShard& ShardFor(uint64 key_hash) {
+    return shards_[key_hash % kNumShards];
+  }
+
   // Pointer to the owner class of this LocalRendezvous if it is refcounted.
   const Rendezvous* rc_owner_;
 
-  // TODO(zhifengc): shard table_.
-  mutex mu_;
-  Table table_ TF_GUARDED_BY(mu_);
-  Status status_ TF_GUARDED_BY(mu_);
-  // Track the number of pening callbacks using a counter.
-  int pending_callback_counter_ TF_GUARDED_BY(mu_);
-  condition_variable pending_callback_cond_var_ TF_GUARDED_BY(mu_);
+  TableShard shards_[kNumShards];
+
+  mutex status_mu_;
+  Status status_ TF_GUARDED_BY(status_mu_);
+
+  // Track the number of pending callbacks using a counter.
+  mutex pending_callbacks_mu_;
+  int pending_callback_counter_ TF_GUARDED_BY(pending_callbacks_mu_);
+  condition_variable pending_callback_cond_var_
+      TF_GUARDED_BY(pending_callbacks_mu_);
 
   TF_DISALLOW_COPY_AND_ASSIGN(LocalRendezvous);
 };
@@ -1992,6 +1992,9 @@ bool Model::ShouldStop(int64_t cpu_budget, int64_t ram_budget,
 Status Model::OptimizeLoop(AutotuneAlgorithm algorithm, int64_t cpu_budget,
                            int64_t ram_budget,
                            CancellationManager* cancellation_manager) {
+  // Publish the budget so that prefetch iterators sharing this model can
+  // bound their combined buffer footprint by it.
+  ram_budget_.store(ram_budget, std::memory_order_relaxed);
   std::function<void()> unused;
   TF_RETURN_IF_ERROR(RegisterCancellationCallback(
       cancellation_manager,
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_MODEL_H_
 #define TENSORFLOW_CORE_FRAMEWORK_MODEL_H_
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <string>
@@ -693,6 +694,28 @@ class Model {
     return output_;
   }
 
+  // Records a change in the number of bytes resident in prefetch buffers of
+  // iterators sharing this model.  Unlike the per-node buffered-bytes
+  // estimates used by the optimization (which are based on average element
+  // sizes), this counter tracks actual allocated sizes, so prefetch stages
+  // can bound their combined footprint even when element sizes vary widely
+  // within an epoch.
+  void RecordPrefetchedBytes(int64_t delta) {
+    prefetched_bytes_.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  // The total number of bytes currently resident in prefetch buffers of
+  // iterators sharing this model.
+  int64_t prefetched_bytes() const {
+    return prefetched_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // The RAM budget the optimization loop was started with, or 0 if the
+  // optimization loop has not run.
+  int64_t ram_budget() const {
+    return ram_budget_.load(std::memory_order_relaxed);
+  }
+
   // Adds a node with the given name and given parent.
   void AddNode(Node::Factory factory, const string& name,
                std::shared_ptr<Node> parent, std::shared_ptr<Node>* out_node)
@@ -835,6 +858,13 @@ class Model {
   // running optimizations.
   int64_t optimization_period_ms_ TF_GUARDED_BY(mu_);
 
+  // Actual bytes resident in prefetch buffers across the pipeline; see
+  // `RecordPrefetchedBytes`.
+  std::atomic<int64_t> prefetched_bytes_{0};
+
+  // RAM budget the optimization loop was started with; see `ram_budget`.
+  std::atomic<int64_t> ram_budget_{0};
+
   // Gauge cell that can be used to collect the state of the model.
   monitoring::GaugeCell<std::function<std::string()>>* model_gauge_cell_ =
       nullptr;
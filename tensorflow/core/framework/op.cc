@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -51,10 +52,13 @@ Status OpRegistryInterface::LookUpOpDef(const string& op_type_name,
 }
 
 OpRegistry::OpRegistry()
-    : initialized_(false), op_registry_validator_(DefaultValidator) {}
+    : initialized_(false),
+      lookup_index_(nullptr),
+      op_registry_validator_(DefaultValidator) {}
 
 OpRegistry::~OpRegistry() {
   for (const auto& e : registry_) delete e.second;
+  delete lookup_index_.load(std::memory_order_acquire);
 }
 
 void OpRegistry::Register(const OpRegistrationDataFactory& op_data_factory) {
@@ -89,6 +93,13 @@ Status OpRegistry::LookUp(const string& op_type_name,
 }
 
 const OpRegistrationData* OpRegistry::LookUp(const string& op_type_name) const {
+  // Fast path: probe the published lookup index without taking mu_. Entries
+  // are never removed from the registry, so a hit in a stale index is still
+  // valid; a miss falls through to the locked paths below.
+  if (const LookupIndex* index = lookup_index_.load(std::memory_order_acquire)) {
+    auto iter = index->find(op_type_name);
+    if (iter != index->end()) return iter->second;
+  }
   {
     tf_shared_lock l(mu_);
     if (initialized_) {
@@ -110,6 +121,10 @@ const OpRegistrationData* OpRegistry::LookUpSlow(
   {  // Scope for lock.
     mutex_lock lock(mu_);
     first_call = MustCallDeferred();
+    if (lookup_index_.load(std::memory_order_relaxed) == nullptr) {
+      lookup_index_.store(new LookupIndex(registry_.begin(), registry_.end()),
+                          std::memory_order_release);
+    }
     res = gtl::FindWithDefault(registry_, op_type_name, nullptr);
 
     static bool unregistered_before = false;
@@ -186,6 +201,7 @@ void OpRegistry::Export(bool include_internal, OpList* ops) const {
 void OpRegistry::DeferRegistrations() {
   mutex_lock lock(mu_);
   initialized_ = false;
+  InvalidateLookupIndex();
 }
 
 void OpRegistry::ClearDeferredRegistrations() {
@@ -249,12 +265,24 @@ Status OpRegistry::RegisterAlreadyLocked(
   }
   if (s.ok()) {
     op_reg_data.release();
+    InvalidateLookupIndex();
   } else {
     op_reg_data.reset();
   }
   return watcher_status;
 }
 
+void OpRegistry::InvalidateLookupIndex() const {
+  const LookupIndex* index =
+      lookup_index_.exchange(nullptr, std::memory_order_acq_rel);
+  if (index != nullptr) {
+    // Lock-free readers may still be probing the retired index, so it is kept
+    // alive for the lifetime of the registry. Registrations after lookups
+    // start are rare, so the cost is bounded in practice.
+    retired_lookup_indices_.emplace_back(index);
+  }
+}
+
 // static
 OpRegistry* OpRegistry::Global() {
   static OpRegistry* global_op_registry = new OpRegistry;
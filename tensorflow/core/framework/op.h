@@ -16,7 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_OP_H_
 #define TENSORFLOW_CORE_FRAMEWORK_OP_H_
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -159,6 +161,16 @@ class OpRegistry : public OpRegistryInterface {
 
   const OpRegistrationData* LookUpSlow(const std::string& op_type_name) const;
 
+  // Read-only copy of registry_ published for lock-free lookups once
+  // registration has settled.
+  typedef std::unordered_map<std::string, const OpRegistrationData*>
+      LookupIndex;
+
+  // Retires the published lookup index (if any) after a registry mutation.
+  // Concurrent readers may still hold the retired index, so it is kept alive
+  // for the lifetime of the registry.
+  void InvalidateLookupIndex() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   mutable mutex mu_;
   // Functions in deferred_ may only be called with mu_ held.
   mutable std::vector<OpRegistrationDataFactory> deferred_ TF_GUARDED_BY(mu_);
@@ -167,6 +179,12 @@ class OpRegistry : public OpRegistryInterface {
       TF_GUARDED_BY(mu_);
   mutable bool initialized_ TF_GUARDED_BY(mu_);
 
+  // Current lookup index, or nullptr if it is stale. Rebuilt lazily by
+  // LookUpSlow under mu_; read with an acquire load on the LookUp fast path.
+  mutable std::atomic<const LookupIndex*> lookup_index_;
+  mutable std::vector<std::unique_ptr<const LookupIndex>>
+      retired_lookup_indices_ TF_GUARDED_BY(mu_);
+
   // Registry watcher.
   mutable Watcher watcher_ TF_GUARDED_BY(mu_);
 
@@ -15,8 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/framework/op_kernel.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
@@ -50,6 +52,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/hash.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/platform_strings.h"
@@ -346,6 +349,11 @@ Allocator* OpKernelContext::get_allocator(AllocatorAttributes attr) {
   if (TF_PREDICT_FALSE(attr.scope_id > 0)) {
     allocator = params_->device->GetScopedAllocator(attr, step_id());
     CHECK(allocator);
+  } else if (TF_PREDICT_FALSE(params_->step_allocator != nullptr) &&
+             attr.value == 0) {
+    // Serve unconstrained allocations from the step-scoped allocator, which
+    // releases its backing memory wholesale when the step completes.
+    allocator = params_->step_allocator;
   } else {
     allocator = params_->device->GetAllocator(attr);
   }
@@ -1062,6 +1070,13 @@ struct KernelRegistration {
   std::unique_ptr<kernel_factory::OpKernelFactory> factory;
 };
 
+// Read-only index over a KernelRegistry, mapping a registration key
+// ("op:device:label", see Key() below) to the registrations for that key.
+// The registration pointers reference nodes owned by KernelRegistry::registry,
+// which remain stable across later inserts.
+typedef std::unordered_map<string, std::vector<const KernelRegistration*>>
+    KernelRegistryIndex;
+
 // This maps from 'op_type' + DeviceType to the set of KernelDefs and
 // factory functions for instantiating the OpKernel that matches the
 // KernelDef.
@@ -1069,6 +1084,12 @@ struct KernelRegistry {
   mutex mu;
   std::unordered_multimap<string, KernelRegistration> registry
       TF_GUARDED_BY(mu);
+  // Current index over `registry` published for lock-free lookups, or nullptr
+  // if it is stale. Rebuilt lazily on the next lookup; retired indices are
+  // kept alive for concurrent readers.
+  std::atomic<const KernelRegistryIndex*> index{nullptr};
+  std::vector<std::unique_ptr<const KernelRegistryIndex>> retired_indices
+      TF_GUARDED_BY(mu);
 };
 
 #if defined(_WIN32)
@@ -1171,6 +1192,35 @@ static string Key(StringPiece op_type, const DeviceType& device_type,
                          label);
 }
 
+// Returns the lock-free lookup index for `registry`, building and publishing
+// one if no current index exists.
+static const KernelRegistryIndex* GetKernelRegistryIndex(
+    KernelRegistry* registry) {
+  const KernelRegistryIndex* index =
+      registry->index.load(std::memory_order_acquire);
+  if (index != nullptr) return index;
+  mutex_lock l(registry->mu);
+  index = registry->index.load(std::memory_order_relaxed);
+  if (index != nullptr) return index;
+  auto* built = new KernelRegistryIndex;
+  for (const auto& entry : registry->registry) {
+    (*built)[entry.first].push_back(&entry.second);
+  }
+  registry->index.store(built, std::memory_order_release);
+  return built;
+}
+
+// Retires the published index (if any) after a mutation of `registry`.
+// Lock-free readers may still be probing the retired index, so it is kept
+// alive for the lifetime of the process. Registrations after lookups start
+// are rare, so the cost is bounded in practice.
+static void InvalidateKernelRegistryIndex(KernelRegistry* registry)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(registry->mu) {
+  const KernelRegistryIndex* index =
+      registry->index.exchange(nullptr, std::memory_order_acq_rel);
+  if (index != nullptr) registry->retired_indices.emplace_back(index);
+}
+
 // Provide a way for users to disable JIT kernels for a transitional period.
 // Until this is removed, this function also removes the JIT label that is added
 // to JIT kernels during the static registration, to allow them to be found
@@ -1211,6 +1261,8 @@ void SetupOrDisableJit(KernelRegistry* registry) {
   for (auto& jit_kernel : jit_kernels) {
     all_kernels.insert(std::move(jit_kernel));
   }
+
+  InvalidateKernelRegistryIndex(registry);
 }
 
 void* GlobalKernelRegistry() {
@@ -1222,6 +1274,76 @@ void* GlobalKernelRegistry() {
   return global_kernel_registry;
 }
 
+#if TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
+// Bounds of the linker section holding the LazyKernelRegistration records
+// emitted by REGISTER_KERNEL_BUILDER. The linker defines these symbols for
+// any section whose name is a valid C identifier.
+extern "C" {
+extern const kernel_factory::LazyKernelRegistration
+    __start_tf_kernel_registration[];
+extern const kernel_factory::LazyKernelRegistration
+    __stop_tf_kernel_registration[];
+}
+
+namespace {
+
+// The lazy registration records for one op, applied to the global kernel
+// registry at most once.
+struct LazyOpKernels {
+  mutable absl::once_flag once;
+  std::vector<const kernel_factory::LazyKernelRegistration*> records;
+};
+
+typedef std::unordered_map<StringPiece, LazyOpKernels, StringPieceHasher>
+    LazyKernelIndex;
+
+// Returns the lazy registration records grouped by op name. The index is
+// immutable once built; keys reference the string literals in the records.
+const LazyKernelIndex& GlobalLazyKernelIndex() {
+  static const LazyKernelIndex* index = []() {
+    auto* result = new LazyKernelIndex;
+    for (const kernel_factory::LazyKernelRegistration* record =
+             __start_tf_kernel_registration;
+         record != __stop_tf_kernel_registration; ++record) {
+      // Kernels excluded by selective registration have a null register_fn.
+      if (record->register_fn != nullptr) {
+        (*result)[StringPiece(record->op_name)].records.push_back(record);
+      }
+    }
+    return result;
+  }();
+  return *index;
+}
+
+// Applies the lazy registration records for `op_name` (if any) to the global
+// kernel registry. After the first call for an op this is a hash probe plus
+// the call_once fast path.
+void MaterializeLazyKernels(StringPiece op_name) {
+  const LazyKernelIndex& index = GlobalLazyKernelIndex();
+  auto iter = index.find(op_name);
+  if (iter == index.end()) return;
+  const LazyOpKernels& op_kernels = iter->second;
+  absl::call_once(op_kernels.once, [&op_kernels]() {
+    for (const kernel_factory::LazyKernelRegistration* record :
+         op_kernels.records) {
+      record->register_fn();
+    }
+  });
+}
+
+// Applies all lazy registration records, for callers that enumerate the
+// registry rather than looking up a single op.
+void MaterializeAllLazyKernels() {
+  for (const auto& entry : GlobalLazyKernelIndex()) {
+    MaterializeLazyKernels(entry.first);
+  }
+}
+
+}  // namespace
+
+#endif  // TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
 static KernelRegistry* GlobalKernelRegistryTyped() {
 #ifdef AUTOLOAD_DYNAMIC_KERNELS
   LoadDynamicKernels();
@@ -1256,6 +1378,7 @@ void OpKernelRegistrar::InitInternal(const KernelDef* kernel_def,
   global_registry->registry.emplace(
       key,
       KernelRegistration(*kernel_def, kernel_class_name, std::move(factory)));
+  InvalidateKernelRegistryIndex(global_registry);
   delete kernel_def;
 }
 
@@ -1298,31 +1421,40 @@ Status FindKernelRegistration(
 
   const string key = Key(node_op, device_type, label);
   auto typed_registry = GlobalKernelRegistryTyped();
-  tf_shared_lock lock(typed_registry->mu);
-  auto regs = typed_registry->registry.equal_range(key);
-  for (auto iter = regs.first; iter != regs.second; ++iter) {
-    // If there is a kernel registered for the op and device_type,
-    // check that the attrs match.
-    bool match;
-    TF_RETURN_IF_ERROR(KernelAttrsMatch(iter->second.def, node_attrs, &match));
-    if (match) {
-      if (*reg != nullptr) {
-        if ((*reg)->def.priority() == iter->second.def.priority()) {
-          return errors::InvalidArgument(
-              "Multiple OpKernel registrations match NodeDef at the same "
-              "priority '",
-              FormatNodeDefForError(node_name, has_experimental_debug_info,
-                                    experimental_debug_info),
-              "': '", (*reg)->def.ShortDebugString(), "' and '",
-              iter->second.def.ShortDebugString(), "'");
-        } else if ((*reg)->def.priority() > iter->second.def.priority()) {
-          continue;
+#if TF_OPTION_LAZY_KERNEL_REGISTRATION()
+  MaterializeLazyKernels(node_op);
+#endif  // TF_OPTION_LAZY_KERNEL_REGISTRATION()
+  // Probe the published index instead of locking the registry; registrations
+  // concurrent with this lookup were never guaranteed to be visible, and a
+  // registration retires the index before the next lookup rebuilds it.
+  const KernelRegistryIndex* index = GetKernelRegistryIndex(typed_registry);
+  auto entry = index->find(key);
+  if (entry != index->end()) {
+    for (const KernelRegistration* registration : entry->second) {
+      // If there is a kernel registered for the op and device_type,
+      // check that the attrs match.
+      bool match;
+      TF_RETURN_IF_ERROR(
+          KernelAttrsMatch(registration->def, node_attrs, &match));
+      if (match) {
+        if (*reg != nullptr) {
+          if ((*reg)->def.priority() == registration->def.priority()) {
+            return errors::InvalidArgument(
+                "Multiple OpKernel registrations match NodeDef at the same "
+                "priority '",
+                FormatNodeDefForError(node_name, has_experimental_debug_info,
+                                      experimental_debug_info),
+                "': '", (*reg)->def.ShortDebugString(), "' and '",
+                registration->def.ShortDebugString(), "'");
+          } else if ((*reg)->def.priority() > registration->def.priority()) {
+            continue;
+          }
+          // registration's priority is higher than *reg.
         }
-        // iter->second's priority is higher than *reg.
+        *reg = registration;
+      } else {
+        *was_attr_mismatch = true;
       }
-      *reg = &iter->second;
-    } else {
-      *was_attr_mismatch = true;
     }
   }
   // Check if no device specific registrations found. If not, try finding a
@@ -1330,25 +1462,27 @@ Status FindKernelRegistration(
   if (*reg == nullptr &&
       !IsSymbolicExecutionDevice(device_type.type_string())) {
     const string default_key = Key(node_op, DEVICE_DEFAULT, label);
-    auto regs = typed_registry->registry.equal_range(default_key);
-    for (auto iter = regs.first; iter != regs.second; ++iter) {
-      // If there is a kernel registered for the op and device_type,
-      // check that the attrs match.
-      bool match;
-      TF_RETURN_IF_ERROR(
-          KernelAttrsMatch(iter->second.def, node_attrs, &match));
-      if (match) {
-        if (*reg != nullptr) {
-          return errors::InvalidArgument(
-              "Multiple Default OpKernel registrations match NodeDef '",
-              FormatNodeDefForError(node_name, has_experimental_debug_info,
-                                    experimental_debug_info),
-              "': '", (*reg)->def.ShortDebugString(), "' and '",
-              iter->second.def.ShortDebugString(), "'");
+    entry = index->find(default_key);
+    if (entry != index->end()) {
+      for (const KernelRegistration* registration : entry->second) {
+        // If there is a kernel registered for the op and device_type,
+        // check that the attrs match.
+        bool match;
+        TF_RETURN_IF_ERROR(
+            KernelAttrsMatch(registration->def, node_attrs, &match));
+        if (match) {
+          if (*reg != nullptr) {
+            return errors::InvalidArgument(
+                "Multiple Default OpKernel registrations match NodeDef '",
+                FormatNodeDefForError(node_name, has_experimental_debug_info,
+                                      experimental_debug_info),
+                "': '", (*reg)->def.ShortDebugString(), "' and '",
+                registration->def.ShortDebugString(), "'");
+          }
+          *reg = registration;
+        } else {
+          *was_attr_mismatch = true;
         }
-        *reg = &iter->second;
-      } else {
-        *was_attr_mismatch = true;
       }
     }
 
@@ -1518,6 +1652,9 @@ KernelList GetAllRegisteredKernels() {
 KernelList GetFilteredRegisteredKernels(
     const std::function<bool(const KernelDef&)>& predicate) {
   KernelRegistry* const typed_registry = GlobalKernelRegistryTyped();
+#if TF_OPTION_LAZY_KERNEL_REGISTRATION()
+  MaterializeAllLazyKernels();
+#endif  // TF_OPTION_LAZY_KERNEL_REGISTRATION()
   KernelList kernel_list;
   tf_shared_lock lock(typed_registry->mu);
   kernel_list.mutable_kernel()->Reserve(typed_registry->registry.size());
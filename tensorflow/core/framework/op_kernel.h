@@ -615,6 +615,11 @@ class OpKernelContext {
     // stored in this container..
     ScopedStepContainer* step_container = nullptr;
 
+    // If non-null, an allocator scoped to the lifetime of the step (e.g. a
+    // bump-pointer arena) that is substituted for the device allocator when
+    // no special allocation attributes are requested. Owned by the step.
+    Allocator* step_allocator = nullptr;
+
     // Mechanism used by this op kernel invocation to communicate with
     // computations running on other devices.
     RendezvousInterface* rendezvous = nullptr;
@@ -1406,6 +1411,43 @@ class Name : public KernelDefBuilder {
   TF_EXTRACT_KERNEL_NAME_IMPL(m, TF_EXTRACT_KERNEL_NAME_##kernel_builder, \
                               __VA_ARGS__)
 
+#if TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
+#if !defined(__ELF__)
+#error TF_OPTION_LAZY_KERNEL_REGISTRATION(): Lazy kernel registration requires ELF linker section support
+#endif  // !defined(__ELF__)
+
+// Lazy variant of REGISTER_KERNEL_BUILDER_IMPL_3: instead of registering on
+// startup, emit a constant-initialized record into a dedicated linker section
+// (no constructor runs, and untouched records stay on cold pages). The record
+// is applied to the global registry on the first kernel lookup for the op.
+//
+// Unlike the default implementation, this form cannot appear inside a
+// function body, and the KernelDefBuilder expression must not reference
+// locals: it is not evaluated until the record is materialized.
+#define REGISTER_KERNEL_BUILDER_IMPL_3(ctr, op_name, kernel_builder_expr,      \
+                                       is_system_kernel, ...)                  \
+  static ::tensorflow::InitOnStartupMarker register_kernel_body_##ctr()        \
+      TF_ATTRIBUTE_UNUSED;                                                     \
+  static ::tensorflow::InitOnStartupMarker register_kernel_body_##ctr() {      \
+    ::tensorflow::kernel_factory::OpKernelRegistrar registrar(                 \
+        kernel_builder_expr.Build(), #__VA_ARGS__,                             \
+        [](::tensorflow::OpKernelConstruction* context)                        \
+            -> ::tensorflow::OpKernel* { return new __VA_ARGS__(context); });  \
+    (void)registrar;                                                           \
+    return ::tensorflow::InitOnStartupMarker{};                                \
+  }                                                                            \
+  static constexpr ::tensorflow::kernel_factory::LazyKernelRegistration        \
+      register_kernel_##ctr TF_ATTRIBUTE_UNUSED                                \
+      __attribute__((section(TF_KERNEL_REGISTRATION_SECTION_NAME), used)) = {  \
+          op_name, (is_system_kernel ||                                        \
+                    (SHOULD_REGISTER_OP_KERNEL(#__VA_ARGS__) &&                \
+                     SHOULD_REGISTER_OP(op_name)))                             \
+                       ? &register_kernel_body_##ctr                           \
+                       : nullptr};
+
+#else  // TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
 // REGISTER_KERNEL_BUILDER_IMPL_2, with a unique 'ctr' as the first argument.
 // TODO(dodgen): There are some uses of this macro inside functions, where
 // kernel_builder refers to (non-const) locals (they should be fixed). To
@@ -1429,6 +1471,8 @@ class Name : public KernelDefBuilder {
                return ::tensorflow::InitOnStartupMarker{};                  \
              })(kernel_builder_expr.Build());
 
+#endif  // TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
 // REGISTER_KERNEL_BUILDER_IMPL, but with kernel_builder split to op_name,
 // kernel_builder_expr.
 #define REGISTER_KERNEL_BUILDER_IMPL_2(op_name, kernel_builder_expr, \
@@ -1530,6 +1574,27 @@ class OpKernelRegistrar {
                     std::unique_ptr<OpKernelFactory> factory);
 };
 
+#if TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
+// Name of the linker section holding LazyKernelRegistration records. The name
+// must be a valid C identifier so that the linker provides __start_ / __stop_
+// bounds symbols for the section.
+#define TF_KERNEL_REGISTRATION_SECTION_NAME "tf_kernel_registration"
+
+// A deferred kernel registration. When lazy kernel registration is enabled,
+// REGISTER_KERNEL_BUILDER emits one constant-initialized record per
+// registration into a dedicated linker section instead of running a
+// registration constructor on startup. The records for an op are applied to
+// the global registry on the first kernel lookup for that op (see
+// MaterializeLazyKernels in op_kernel.cc). register_fn is null for kernels
+// excluded by selective registration.
+struct LazyKernelRegistration {
+  const char* op_name;
+  InitOnStartupMarker (*register_fn)();
+};
+
+#endif  // TF_OPTION_LAZY_KERNEL_REGISTRATION()
+
 }  // namespace kernel_factory
 
 // -----------------------------------------------------------------------------
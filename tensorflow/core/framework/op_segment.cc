@@ -15,10 +15,13 @@ limitations under the License.
 
 #include "tensorflow/core/framework/op_segment.h"
 
+#include <vector>
+
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
@@ -33,6 +36,11 @@ OpSegment::OpSegment() {}
 
 OpSegment::~OpSegment() {
   for (const auto& kv : sessions_) delete kv.second;
+  for (const auto& kv : shared_kernels_) delete kv.second.kernel;
+}
+
+uint64 OpSegment::KernelFingerprint(const NodeDef& ndef) {
+  return DeterministicProtoHash64(ndef);
 }
 
 Status OpSegment::FindOrCreate(const string& session_handle,
@@ -71,6 +79,51 @@ Status OpSegment::FindOrCreate(const string& session_handle,
   return OkStatus();
 }
 
+Status OpSegment::FindOrCreate(const string& session_handle,
+                               const string& node_name,
+                               uint64 node_fingerprint, OpKernel** kernel,
+                               CreateKernelFn create_fn) {
+  {
+    mutex_lock l(mu_);
+    Item* item = gtl::FindPtrOrNull(sessions_, session_handle);
+    if (item == nullptr) {
+      return errors::NotFound("Session ", session_handle, " is not found.");
+    }
+    auto siter = shared_kernels_.find(node_fingerprint);
+    if (siter != shared_kernels_.end()) {
+      if (item->fingerprints.insert(node_fingerprint).second) {
+        ++siter->second.ref_count;
+      }
+      *kernel = siter->second.kernel;
+      return OkStatus();
+    }
+  }
+  Status s = create_fn(kernel);
+  if (!s.ok()) {
+    LOG(ERROR) << "Create kernel failed: " << s;
+    return s;
+  }
+  {
+    mutex_lock l(mu_);
+    Item* item = gtl::FindPtrOrNull(sessions_, session_handle);
+    if (item == nullptr) {
+      return errors::NotFound("Session ", session_handle, " is not found.");
+    }
+    SharedKernel& shared = shared_kernels_[node_fingerprint];
+    if (shared.kernel == nullptr) {
+      shared.kernel = *kernel;  // Inserts 'kernel' in the cache.
+    } else {
+      // Another thread created the kernel concurrently.
+      delete *kernel;
+      *kernel = shared.kernel;
+    }
+    if (item->fingerprints.insert(node_fingerprint).second) {
+      ++shared.ref_count;
+    }
+  }
+  return OkStatus();
+}
+
 void OpSegment::AddHold(const string& session_handle) {
   mutex_lock l(mu_);
   Item** item = &sessions_[session_handle];
@@ -83,6 +136,7 @@ void OpSegment::AddHold(const string& session_handle) {
 
 void OpSegment::RemoveHold(const string& session_handle) {
   Item* item = nullptr;
+  std::vector<OpKernel*> unreferenced_shared_kernels;
   {
     mutex_lock l(mu_);
     auto siter = sessions_.find(session_handle);
@@ -96,8 +150,20 @@ void OpSegment::RemoveHold(const string& session_handle) {
     } else {
       sessions_.erase(siter);
     }
+    // Drop this session's references on cross-session kernels and
+    // collect the now-unreferenced ones for deletion outside the lock.
+    for (uint64 fingerprint : item->fingerprints) {
+      auto kiter = shared_kernels_.find(fingerprint);
+      if (kiter != shared_kernels_.end() && --(kiter->second.ref_count) == 0) {
+        unreferenced_shared_kernels.push_back(kiter->second.kernel);
+        shared_kernels_.erase(kiter);
+      }
+    }
   }
   delete item;
+  for (OpKernel* kernel : unreferenced_shared_kernels) {
+    delete kernel;
+  }
 }
 
 bool OpSegment::ShouldOwnKernel(FunctionLibraryRuntime* lib,
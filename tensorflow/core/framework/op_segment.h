@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -61,6 +62,24 @@ class OpSegment {
                       const std::string& node_name, OpKernel** kernel,
                       CreateKernelFn create_fn);
 
+  // Like the above, but additionally registers the kernel in a
+  // session-independent cache keyed by "node_fingerprint". If another
+  // session on the same device has already instantiated a kernel for a
+  // node with the same fingerprint, that kernel is shared rather than
+  // re-created, which avoids re-instantiating every kernel when the
+  // same model is loaded by a second session. A shared kernel stays
+  // alive until the last session referencing it drops its hold.
+  Status FindOrCreate(const std::string& session_handle,
+                      const std::string& node_name, uint64 node_fingerprint,
+                      OpKernel** kernel, CreateKernelFn create_fn);
+
+  // Returns a fingerprint of "ndef" suitable for the cross-session
+  // kernel cache. The fingerprint covers the full node definition
+  // (name, op, device, inputs and attrs), since kernel constructors may
+  // consult any of these; two sessions instantiating identical node
+  // definitions get the same fingerprint.
+  static uint64 KernelFingerprint(const NodeDef& ndef);
+
   // Returns true if OpSegment should own the kernel.
   static bool ShouldOwnKernel(FunctionLibraryRuntime* lib,
                               const std::string& node_op);
@@ -70,16 +89,27 @@ class OpSegment {
   typedef std::unordered_map<string, OpKernel*> KernelMap;
   struct Item {
     int num_holds = 1;      // Num of holds put on the session.
-    KernelMap name_kernel;  // op name -> kernel.
+    KernelMap name_kernel;  // op name -> kernel (owned by the item).
+    // Fingerprints of cross-session kernels this session references.
+    std::unordered_set<uint64> fingerprints;
     ~Item();
   };
 
+  // A kernel shared between sessions via the fingerprint-keyed cache.
+  // The kernel is deleted when the last referencing session goes away.
+  struct SharedKernel {
+    OpKernel* kernel = nullptr;
+    int ref_count = 0;  // Num of sessions referencing the kernel.
+  };
+
   // session handle -> item.
   // Session handles are produced by strings::FpToString()
   typedef std::unordered_map<string, Item*> SessionMap;
 
   mutable mutex mu_;
   SessionMap sessions_ TF_GUARDED_BY(mu_);
+  // node fingerprint -> kernel shared between sessions.
+  std::unordered_map<uint64, SharedKernel> shared_kernels_ TF_GUARDED_BY(mu_);
 
   TF_DISALLOW_COPY_AND_ASSIGN(OpSegment);
 };
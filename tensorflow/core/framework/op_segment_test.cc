@@ -111,6 +111,35 @@ TEST_F(OpSegmentTest, Basic) {
   opseg.RemoveHold("B");
 }
 
+TEST_F(OpSegmentTest, FingerprintSharesKernelsAcrossSessions) {
+  OpSegment opseg;
+  OpKernel* op_a;
+  OpKernel* op_b;
+  const auto& ndef = float_nodedefs_[0];
+  const uint64 fp = OpSegment::KernelFingerprint(ndef);
+
+  opseg.AddHold("A");
+  opseg.AddHold("B");
+
+  // Session A creates the kernel; session B finds the cached instance and
+  // its create_fn is never invoked.
+  TF_EXPECT_OK(opseg.FindOrCreate("A", ndef.name(), fp, &op_a, GetFn(&ndef)));
+  ValidateOpAndTypes(op_a, ndef, DT_FLOAT);
+  auto reterr = [](OpKernel** kernel) {
+    return errors::Internal("Should not be called");
+  };
+  TF_EXPECT_OK(opseg.FindOrCreate("B", ndef.name(), fp, &op_b, reterr));
+  EXPECT_EQ(op_a, op_b);
+
+  // Distinct node definitions get distinct fingerprints.
+  EXPECT_NE(fp, OpSegment::KernelFingerprint(int32_nodedefs_[0]));
+
+  // The kernel survives until the last referencing session is removed.
+  opseg.RemoveHold("A");
+  ValidateOpAndTypes(op_b, ndef, DT_FLOAT);
+  opseg.RemoveHold("B");
+}
+
 TEST_F(OpSegmentTest, SessionNotFound) {
   OpSegment opseg;
   OpKernel* op;
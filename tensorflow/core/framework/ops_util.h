@@ -57,28 +57,30 @@ bool IsInnerDimsSizeAligned(const TensorShape& s) {
 #endif
 }
 
-// Given a shape 's' of a tensor of type T and the `start` and `end` index of a
-// dim 0 slice, returns true iff slice is aligned with respect to original
-// tensor. Here aligned implies the address is a multiple of
-// EIGEN_MAX_ALIGN_BYTES.
+// Given a shape 's' of a tensor of type T and the `start` index of a dim 0
+// slice, returns true iff the slice is aligned with respect to the original
+// tensor. Here aligned implies the base address of the slice is a multiple of
+// EIGEN_MAX_ALIGN_BYTES, assuming the original tensor is aligned. Only the
+// byte offset of the slice start matters: the slice end does not affect the
+// base address of the result.
 template <typename T>
-bool IsDim0SliceAligned(const TensorShape& s, int64_t start,
-                        int64_t end_or_size) {
+bool IsDim0SliceAligned(const TensorShape& s, int64_t start) {
   if (s.dims() == 1) {
 #if EIGEN_MAX_ALIGN_BYTES == 0
     return true;
 #else
-    bool start_aligned = (start * sizeof(T)) % EIGEN_MAX_ALIGN_BYTES == 0;
-    // End is aligned if either the explicit end index is passed and is a
-    // a multiple of EIGEN_MAX_ALIGN_BYTES, or the start index is aligned and
-    // the size is aligned. So for convenience we can either pass start and
-    // index, or start and size.
-    bool end_aligned = (end_or_size * sizeof(T)) % EIGEN_MAX_ALIGN_BYTES == 0;
-    return start_aligned && end_aligned;
+    return (start * sizeof(T)) % EIGEN_MAX_ALIGN_BYTES == 0;
 #endif
-  } else {
-    return IsInnerDimsSizeAligned<T>(s);
   }
+  if (s.dims() == 0) return false;
+  const int64_t dim0_size = s.dim_size(0);
+  if (dim0_size == 0) return false;
+#if EIGEN_MAX_ALIGN_BYTES == 0
+  return true;
+#else
+  const int64_t bytes_per_dim0 = (s.num_elements() / dim0_size) * sizeof(T);
+  return (start * bytes_per_dim0) % EIGEN_MAX_ALIGN_BYTES == 0;
+#endif
 }
 
 // Returns <suffix> sanitized to have only [a-zA-Z0-9-_].
@@ -22,4 +22,6 @@ limitations under the License.
 
 #define_option REGISTRATION_V2
 
+#define_option LAZY_KERNEL_REGISTRATION
+
 #endif  // TENSORFLOW_CORE_FRAMEWORK_REGISTRATION_OPTIONS_TMPL_H_
@@ -69,12 +69,18 @@ class RendezvousInterface {
 
     ParsedKey& operator=(const ParsedKey& b);
     StringPiece FullKey() const { return buf_; }
+    // Hash of FullKey(), filled in by ParseKey().  Rendezvous
+    // implementations that index their tables by key hash can use this to
+    // avoid re-hashing the key string on every Send/Recv; keys that were
+    // parsed once at kernel construction then pay nothing per step.
+    uint64 FullKeyHash() const { return hash_; }
 
    private:
     friend class Rendezvous;
     friend class SendOp;
     friend class RecvOp;
     std::string buf_;
+    uint64 hash_ = 0;
   };
 
   // The caller is a tensor producer and it sends a message (a tensor
@@ -77,6 +77,7 @@ Status ValidateDevice(OpKernelContext* ctx, const ResourceHandle& p) {
 
 Status ResourceMgr::InsertDebugTypeName(uint64 hash_code,
                                         const string& type_name) {
+  mutex_lock l(debug_type_names_mu_);
   auto iter = debug_type_names_.emplace(hash_code, type_name);
   if (iter.first->second != type_name) {
     return errors::AlreadyExists("Duplicate hash code found for type ",
@@ -86,6 +87,7 @@ Status ResourceMgr::InsertDebugTypeName(uint64 hash_code,
 }
 
 const char* ResourceMgr::DebugTypeName(uint64 hash_code) const {
+  mutex_lock l(debug_type_names_mu_);
   auto type_name_iter = debug_type_names_.find(hash_code);
   if (type_name_iter == debug_type_names_.end()) {
     return "<unknown>";
@@ -135,58 +137,73 @@ ResourceMgr::ResourceMgr(const string& default_container)
 
 ResourceMgr::~ResourceMgr() { Clear(); }
 
+bool ResourceMgr::ContainerExists(const string& container) const {
+  mutex_lock l(known_containers_mu_);
+  return known_containers_.contains(container);
+}
+
 void ResourceMgr::Clear() {
-  // We do the deallocation outside of the lock to avoid a potential deadlock
+  // We do the deallocation outside of the locks to avoid a potential deadlock
   // in case any of the destructors access the resource manager.
-  absl::flat_hash_map<string, Container*> tmp_containers;
+  std::vector<Container*> tmp_containers;
+  for (Shard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& p : shard.containers) {
+      tmp_containers.push_back(p.second);
+    }
+    shard.containers.clear();
+  }
   {
-    mutex_lock l(mu_);
-    tmp_containers = std::move(containers_);
+    mutex_lock l(known_containers_mu_);
+    known_containers_.clear();
   }
-  for (const auto& p : tmp_containers) {
-    delete p.second;
+  for (Container* c : tmp_containers) {
+    delete c;
   }
-  tmp_containers.clear();
 }
 
 string ResourceMgr::DebugString() const {
-  mutex_lock l(mu_);
   struct Line {
-    const string* container;
+    string container;
     const string type;
-    const string* resource;
+    string resource;
     const string detail;
   };
   std::vector<Line> lines;
-  for (const auto& p : containers_) {
-    const string& container = p.first;
-    for (const auto& q : *p.second) {
-      const Key& key = q.first;
-      const char* type = DebugTypeName(key.first);
-      const core::RefCountPtr<ResourceBase> resource = q.second.GetResource();
-      Line l{&container, port::Demangle(type), q.second.name.get(),
-             resource ? resource->DebugString() : "<nullptr>"};
-      lines.push_back(l);
+  for (const Shard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& p : shard.containers) {
+      const string& container = p.first;
+      for (const auto& q : *p.second) {
+        const Key& key = q.first;
+        const char* type = DebugTypeName(key.first);
+        const core::RefCountPtr<ResourceBase> resource = q.second.GetResource();
+        Line l{container, port::Demangle(type), *q.second.name,
+               resource ? resource->DebugString() : "<nullptr>"};
+        lines.push_back(l);
+      }
     }
   }
   std::vector<string> text;
   text.reserve(lines.size());
   for (const Line& line : lines) {
     text.push_back(strings::Printf(
-        "%-20s | %-40s | %-40s | %-s", line.container->c_str(),
-        line.type.c_str(), line.resource->c_str(), line.detail.c_str()));
+        "%-20s | %-40s | %-40s | %-s", line.container.c_str(),
+        line.type.c_str(), line.resource.c_str(), line.detail.c_str()));
   }
   std::sort(text.begin(), text.end());
   return absl::StrJoin(text, "\n");
 }
 
-Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
-                             const string& name, ResourceBase* resource,
-                             bool owns_resource) {
-  Container* container = [&]() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    Container** ptr = &containers_[container_name];
+Status ResourceMgr::DoCreate(Shard& shard, const string& container_name,
+                             TypeIndex type, const string& name,
+                             ResourceBase* resource, bool owns_resource) {
+  Container* container = [&]() TF_EXCLUSIVE_LOCKS_REQUIRED(shard.mu) {
+    Container** ptr = &shard.containers[container_name];
     if (*ptr == nullptr) {
       *ptr = new Container;
+      mutex_lock l(known_containers_mu_);
+      known_containers_.insert(container_name);
     }
     return *ptr;
   }();
@@ -200,8 +217,9 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
   if (owns_resource) {
     resource_and_name.resource = core::RefCountPtr<ResourceBase>(resource);
   } else {
-    auto cleanup_fn = [this, container, type, borrowed_name]() {
-      mutex_lock l(mu_);
+    Shard* shard_ptr = &shard;
+    auto cleanup_fn = [shard_ptr, container, type, borrowed_name]() {
+      mutex_lock l(shard_ptr->mu);
       auto iter = container->find({type.hash_code(), borrowed_name});
       if (iter != container->end()) {
         container->erase(iter);
@@ -225,26 +243,34 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
 
 Status ResourceMgr::Lookup(const ResourceHandle& handle,
                            ResourceBase** resource) const {
-  tf_shared_lock l(mu_);
-  return DoLookup(handle.container(), handle.hash_code(),
+  const Shard& s = shard(handle.name());
+  tf_shared_lock l(s.mu);
+  return DoLookup(s, handle.container(), handle.hash_code(),
                   /*type_name=*/"ResourceBase", handle.name(), resource);
 }
 
-Status ResourceMgr::DoLookup(const string& container, TypeIndex type,
-                             const string& name,
+Status ResourceMgr::DoLookup(const Shard& shard, const string& container,
+                             TypeIndex type, const string& name,
                              ResourceBase** resource) const {
-  return DoLookup(container, type.hash_code(), type.name(), name, resource);
+  return DoLookup(shard, container, type.hash_code(), type.name(), name,
+                  resource);
 }
 
-Status ResourceMgr::DoLookup(const string& container, uint64 type_hash_code,
-                             const string& type_name,
+Status ResourceMgr::DoLookup(const Shard& shard, const string& container,
+                             uint64 type_hash_code, const string& type_name,
                              const string& resource_name,
                              ResourceBase** resource) const {
-  const Container* b = gtl::FindPtrOrNull(containers_, container);
+  const Container* b = gtl::FindPtrOrNull(shard.containers, container);
   if (b == nullptr) {
-    return errors::NotFound("Container ", container,
-                            " does not exist. (Could not find resource: ",
-                            container, "/", resource_name, ")");
+    // The container has no resources in this shard; it may still exist in
+    // others, in which case the resource itself is what is missing.
+    if (!ContainerExists(container)) {
+      return errors::NotFound("Container ", container,
+                              " does not exist. (Could not find resource: ",
+                              container, "/", resource_name, ")");
+    }
+    return errors::NotFound("Resource ", container, "/", resource_name, "/",
+                            type_name, " does not exist.");
   }
   auto iter = b->find({type_hash_code, resource_name});
   if (iter == b->end()) {
@@ -265,10 +291,15 @@ Status ResourceMgr::PopResourceAndName(const string& container,
                                        const string& resource_name,
                                        const string& type_name,
                                        ResourceAndName& resource_and_name) {
-  mutex_lock l(mu_);
-  Container* b = gtl::FindPtrOrNull(containers_, container);
+  Shard& s = shard(resource_name);
+  mutex_lock l(s.mu);
+  Container* b = gtl::FindPtrOrNull(s.containers, container);
   if (b == nullptr) {
-    return errors::NotFound("Container ", container, " does not exist.");
+    if (!ContainerExists(container)) {
+      return errors::NotFound("Container ", container, " does not exist.");
+    }
+    return errors::NotFound("Resource ", container, "/", resource_name, "/",
+                            type_name, " does not exist.");
   }
   auto iter = b->find({type_hash_code, resource_name});
   if (iter == b->end()) {
@@ -309,26 +340,26 @@ Status ResourceMgr::Delete(const ResourceHandle& handle) {
 }
 
 Status ResourceMgr::Cleanup(const string& container) {
-  {
-    tf_shared_lock l(mu_);
-    if (!gtl::FindOrNull(containers_, container)) {
-      // Nothing to cleanup.
-      return OkStatus();
+  // A container's resources are spread across the shards, so remove the
+  // container's entry from each of them. Deletion happens outside the locks
+  // to avoid a potential deadlock in case any of the destructors access the
+  // resource manager.
+  std::vector<Container*> to_delete;
+  for (Shard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    auto iter = shard.containers.find(container);
+    if (iter != shard.containers.end()) {
+      to_delete.push_back(iter->second);
+      shard.containers.erase(iter);
     }
   }
-  Container* b = nullptr;
   {
-    mutex_lock l(mu_);
-    auto iter = containers_.find(container);
-    if (iter == containers_.end()) {
-      // Nothing to cleanup, it's OK (concurrent cleanup).
-      return OkStatus();
-    }
-    b = iter->second;
-    containers_.erase(iter);
+    mutex_lock l(known_containers_mu_);
+    known_containers_.erase(container);
+  }
+  for (Container* b : to_delete) {
+    delete b;
   }
-  CHECK(b != nullptr);
-  delete b;
   return OkStatus();
 }
 
@@ -94,6 +94,27 @@ Status FindErr(const ResourceMgr& rm, const string& container,
   return s;
 }
 
+TEST(ResourceMgrTest, ManyResourcesAcrossShards) {
+  // Enough distinct names to populate every internal shard.
+  ResourceMgr rm;
+  for (int i = 0; i < 100; ++i) {
+    TF_CHECK_OK(rm.Create("foo", strings::StrCat("r", i),
+                          new Resource(strings::StrCat("v", i))));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(strings::StrCat("R/v", i),
+              Find<Resource>(rm, "foo", strings::StrCat("r", i)));
+  }
+  // A missing resource in an existing container reports the resource, not
+  // the container, regardless of which shard the name maps to.
+  HasError(FindErr<Resource>(rm, "foo", "no-such-name"), error::NOT_FOUND,
+           "Resource foo/no-such-name");
+  // Cleanup removes the container's resources from every shard.
+  TF_CHECK_OK(rm.Cleanup("foo"));
+  HasError(FindErr<Resource>(rm, "foo", "r0"), error::NOT_FOUND,
+           "Container foo");
+}
+
 TEST(ResourceMgrTest, Basic) {
   ResourceMgr rm;
   TF_CHECK_OK(rm.Create("foo", "bar", new Resource("cat")));
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 
+#include <memory>
+
 #include "tensorflow/core/framework/resource_base.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -57,6 +59,17 @@ namespace tensorflow {
 // shared mutex prevents them from overlapping with dense writes, which is
 // necessary as dense writes can change the shape the of the tensor.
 //
+// As an optimization for read-mostly variables, a dense read done in
+// copy-on-write mode publishes a refcounted snapshot of the tensor that later
+// dense reads can alias without touching the mutex at all. Every writer
+// invalidates the snapshot, under the exclusive lock, before it inspects the
+// tensor's reference count or mutates the tensor; the next read then goes
+// through the locked path again and republishes. Because the snapshot itself
+// holds a reference to the buffer, a writer that has not invalidated it can
+// never see a reference count of one, so it will copy rather than write in
+// place; a stale snapshot can therefore delay visibility of a write only
+// until the invalidation, never expose a torn value.
+//
 // Transitioning a variable from copy-on-read mode to copy-on-write mode is
 // currently not supported. To upgrade a variable from copy-on-write to
 // copy-on-read use `EnsureSparseVariableAccess()`, and then grab the variable's
@@ -73,9 +86,37 @@ class Var : public ResourceBase {
   mutex* mu() { return &mu_; }
   Tensor* tensor() { return &tensor_; }
 
+  // Returns the snapshot published by the most recent dense read, or nullptr
+  // if no snapshot is current. The returned tensor aliases the variable's
+  // buffer as of the time of publication and may be used without holding
+  // mu(); see the class comment for the protocol.
+  std::shared_ptr<const Tensor> SnapshotForRead() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+  }
+
+  // Publishes the variable's current value so that subsequent dense reads can
+  // skip mu(). The caller must hold mu() at least in shared mode and must
+  // have checked that copy_on_read_mode is false.
+  void PublishSnapshot() {
+    std::atomic_store_explicit(&snapshot_,
+                               std::make_shared<const Tensor>(tensor_),
+                               std::memory_order_release);
+  }
+
+  // Drops the published snapshot, sending subsequent dense reads back under
+  // mu(). Writers must call this while holding mu() exclusively before
+  // inspecting the tensor's reference count or mutating the tensor: the
+  // snapshot holds a reference to the buffer, so until it is dropped the
+  // buffer can never look unshared.
+  void InvalidateSnapshot() {
+    std::atomic_store_explicit(&snapshot_, std::shared_ptr<const Tensor>(),
+                               std::memory_order_release);
+  }
+
   // Uninitializes the variable, by reverting the state of the tensor to
   // the state when the variable is first created.
   void Uninitialize() {
+    InvalidateSnapshot();
     // move frees the buffer of the tensor after unused goes out of scope.
     Tensor unused = std::move(tensor_);
     is_initialized = false;
@@ -106,6 +147,10 @@ class Var : public ResourceBase {
  private:
   mutex mu_;
   Tensor tensor_;
+  // Accessed with the std::atomic_... free functions; written by readers
+  // holding mu_ in shared mode (PublishSnapshot) and by writers holding mu_
+  // exclusively (InvalidateSnapshot), read without any lock.
+  std::shared_ptr<const Tensor> snapshot_;
 
   ~Var() override {}
   TF_DISALLOW_COPY_AND_ASSIGN(Var);
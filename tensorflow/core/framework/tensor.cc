@@ -23,6 +23,10 @@ limitations under the License.
 //   default constructors and destructors when T is not a simple type
 //   (e.g., string.), and skips them otherwise.
 //
+// * InlineBuffer: a small-buffer variant of Buffer<T> whose element
+//   storage lives inline in the buffer object itself, used for tiny
+//   host tensors of simple types.
+//
 // * Helper<T>: provides various routines given type T.  The routines
 //   includes running the constructor and destructor of T[], encoding
 //   an decoding T[] into/from a Cord, etc.
@@ -150,6 +154,46 @@ class Buffer : public BufferBase {
   TF_DISALLOW_COPY_AND_ASSIGN(Buffer);
 };
 
+// Ref-counted buffer whose element storage lives inline in the same heap
+// object, so creating a tiny host tensor costs a single small allocation and
+// never calls into an Allocator. This is the same single-allocation idea as
+// Tensor::ValueAndTensorBuffer uses for host scalars, generalized to any
+// memcpy-able element type and up to kMaxBytes of data.
+class InlineBuffer : public TensorBuffer {
+ public:
+  // A tensor whose contents are at most this many bytes is eligible.
+  static constexpr size_t kMaxBytes = 16;
+
+  explicit InlineBuffer(size_t size) : TensorBuffer(storage_), size_(size) {
+    DCHECK_LE(size, kMaxBytes);
+  }
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+
+  bool GetAllocatedBytes(size_t* out_bytes) const override { return false; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocator_name("InlineTensorBuffer");
+    proto->set_ptr(reinterpret_cast<uintptr_t>(data()));
+  }
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return AllocatorMemoryType::kHostPageable;
+  }
+
+ private:
+  ~InlineBuffer() override = default;
+
+  const size_t size_;
+  // Matches the alignment the CPU allocator guarantees, so that
+  // Tensor::IsAligned() holds just as it would for an allocated buffer.
+  alignas(Allocator::kAllocatorAlignment) char storage_[kMaxBytes];
+
+  TF_DISALLOW_COPY_AND_ASSIGN(InlineBuffer);
+};
+
 void LogUnexpectedSize(int64_t actual, int64_t expected) {
   LOG(ERROR) << "Input size was " << actual << " and expected " << expected;
 }
@@ -159,6 +203,26 @@ bool MemoryLoggingEnabled() {
   return memory_logging_enabled;
 }
 
+// Returns true if a tensor of "n" elements of "type" requested from "a" can
+// be backed by an InlineBuffer: memcpy-able elements that fit into the inline
+// storage, requested from an untracked pageable-host-memory allocator.
+// Tracking allocators, memory logging and basic CPU allocator stats are never
+// bypassed, so allocation instrumentation stays complete when anyone is
+// observing it. (Basic stats are counted inside CPUAllocator::AllocateRaw
+// without making TracksAllocationSizes() return true, so they need their own
+// check.)
+bool CanUseInlineBuffer(Allocator* a, DataType type, int64_t n) {
+  if (a->GetMemoryType() != AllocatorMemoryType::kHostPageable ||
+      a->TracksAllocationSizes() || a->AllocatesOpaqueHandle() ||
+      MemoryLoggingEnabled() || CPUAllocatorStatsEnabled()) {
+    return false;
+  }
+  if (!DataTypeCanUseMemcpy(type)) return false;
+  const int size = DataTypeSize(type);
+  return size > 0 && n > 0 &&
+         static_cast<size_t>(n) * size <= InlineBuffer::kMaxBytes;
+}
+
 // A set of helper functions depending on T.
 template <typename T>
 struct Helper {
@@ -819,7 +883,11 @@ Tensor::Tensor(Allocator* a, DataType type, const TensorShape& shape)
   set_dtype(type);
   CHECK_NOTNULL(a);
   if (shape_.num_elements() > 0 || a->AllocatesOpaqueHandle()) {
-    CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    if (CanUseInlineBuffer(a, type, shape_.num_elements())) {
+      buf_ = new InlineBuffer(shape_.num_elements() * DataTypeSize(type));
+    } else {
+      CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    }
   }
   if (MemoryLoggingEnabled() && buf_ != nullptr && buf_->data() != nullptr) {
     LogMemory::RecordTensorAllocation("Unknown", LogMemory::UNKNOWN_STEP_ID,
@@ -100,6 +100,16 @@ class TensorBuffer : public core::RefCounted {
     return AllocatorMemoryType::kUnknown;
   }
 
+  /// \brief Releases a reference like `RefCounted::Unref()`, destroying a
+  /// singly-owned buffer without an atomic read-modify-write.
+  ///
+  /// Within an executor step most buffers have exactly one owner, so the
+  /// sole-owner test skips the locked decrement on the hot release path.
+  /// Hiding `RefCounted::Unref()` is safe here because tensor buffers are
+  /// never weakly referenced, which rules out a concurrent `TryRef()`
+  /// resurrecting the buffer after the test.
+  bool Unref() const { return UnrefSingleOwner(); }
+
  private:
   void* const data_;
 };
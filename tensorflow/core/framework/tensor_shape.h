@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_TENSOR_SHAPE_H_
 #define TENSORFLOW_CORE_FRAMEWORK_TENSOR_SHAPE_H_
 
+#include <array>
 #include <string>
 
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
@@ -624,6 +625,99 @@ class PartialTensorShapeUtils {
                             const gtl::ArraySlice<PartialTensorShape>& shapes1);
 };
 
+/// \brief The shape of a tensor whose rank is fixed at compile time.
+///
+/// `FixedRankShape<NDIMS>` stores exactly `NDIMS` dimension sizes in a plain
+/// array, so `dim_size()` is an unchecked array read and rank-dependent index
+/// arithmetic over it can be fully unrolled by the compiler. It is intended
+/// for kernels that have already dispatched on a statically known rank and
+/// converts to and from `TensorShape` at the dispatch boundary.
+template <int NDIMS, typename IndexType = int64_t>
+class FixedRankShape {
+ public:
+  static_assert(NDIMS >= 0, "Rank must be non-negative");
+
+  /// Constructs a shape with all dimension sizes zero.
+  FixedRankShape() : dims_{} {}
+
+  /// Constructs a shape from the first `NDIMS` sizes of `shape`.
+  /// REQUIRES: `shape.dims() == NDIMS`
+  explicit FixedRankShape(const TensorShape& shape) {
+    DCHECK_EQ(NDIMS, shape.dims());
+    for (int d = 0; d < NDIMS; d++) {
+      dims_[d] = static_cast<IndexType>(shape.dim_size(d));
+    }
+  }
+
+  explicit FixedRankShape(const std::array<IndexType, NDIMS>& dim_sizes) {
+    for (int d = 0; d < NDIMS; d++) dims_[d] = dim_sizes[d];
+  }
+
+  /// Returns the rank, a compile-time constant.
+  static constexpr int dims() { return NDIMS; }
+
+  /// Returns the size of dimension `d`.
+  /// REQUIRES: `0 <= d < NDIMS`
+  IndexType dim_size(int d) const {
+    DCHECK_GE(d, 0);
+    DCHECK_LT(d, NDIMS);
+    return dims_[d];
+  }
+
+  /// Sets the size of dimension `d` to `size`.
+  /// REQUIRES: `0 <= d < NDIMS`
+  void set_dim(int d, IndexType size) {
+    DCHECK_GE(d, 0);
+    DCHECK_LT(d, NDIMS);
+    dims_[d] = size;
+  }
+
+  /// Returns the number of elements, an unrolled product with no branches.
+  IndexType num_elements() const {
+    IndexType n = 1;
+    for (int d = 0; d < NDIMS; d++) n *= dims_[d];
+    return n;
+  }
+
+  /// Returns the row-major strides of the shape: `strides()[d]` is the
+  /// distance in elements between consecutive indices along dimension `d`.
+  Eigen::DSizes<IndexType, NDIMS> strides() const {
+    Eigen::DSizes<IndexType, NDIMS> s;
+    IndexType stride = 1;
+    for (int d = NDIMS - 1; d >= 0; d--) {
+      s[d] = stride;
+      stride *= dims_[d];
+    }
+    return s;
+  }
+
+  /// Returns the equivalent dynamic-rank shape.
+  TensorShape AsTensorShape() const {
+    gtl::InlinedVector<int64_t, 8> dim_sizes(NDIMS);
+    for (int d = 0; d < NDIMS; d++) {
+      dim_sizes[d] = static_cast<int64_t>(dims_[d]);
+    }
+    return TensorShape(dim_sizes);
+  }
+
+  Eigen::DSizes<IndexType, NDIMS> AsEigenDSizes() const {
+    Eigen::DSizes<IndexType, NDIMS> dsizes;
+    for (int d = 0; d < NDIMS; d++) dsizes[d] = dims_[d];
+    return dsizes;
+  }
+
+  bool operator==(const FixedRankShape& b) const {
+    for (int d = 0; d < NDIMS; d++) {
+      if (dims_[d] != b.dims_[d]) return false;
+    }
+    return true;
+  }
+  bool operator!=(const FixedRankShape& b) const { return !(*this == b); }
+
+ private:
+  IndexType dims_[NDIMS > 0 ? NDIMS : 1];
+};
+
 // ----------------------------------------------------------------------------
 // Template method implementation details below
 // ----------------------------------------------------------------------------
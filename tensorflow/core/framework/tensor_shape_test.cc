@@ -684,6 +684,45 @@ TEST(TensorShapeUtilsTest, EndsWith) {
       TensorShapeUtils::EndsWith(TensorShape({2, 3, 4}), TensorShape({2, 3})));
 }
 
+TEST(FixedRankShapeTest, Basics) {
+  FixedRankShape<3> s(TensorShape({2, 3, 4}));
+  EXPECT_EQ(3, s.dims());
+  EXPECT_EQ(2, s.dim_size(0));
+  EXPECT_EQ(3, s.dim_size(1));
+  EXPECT_EQ(4, s.dim_size(2));
+  EXPECT_EQ(24, s.num_elements());
+  EXPECT_EQ(TensorShape({2, 3, 4}), s.AsTensorShape());
+
+  s.set_dim(1, 5);
+  EXPECT_EQ(5, s.dim_size(1));
+  EXPECT_EQ(40, s.num_elements());
+
+  FixedRankShape<3> t(std::array<int64_t, 3>{{2, 5, 4}});
+  EXPECT_TRUE(s == t);
+  t.set_dim(2, 7);
+  EXPECT_TRUE(s != t);
+
+  FixedRankShape<2> d;
+  EXPECT_EQ(0, d.dim_size(0));
+  EXPECT_EQ(0, d.num_elements());
+
+  FixedRankShape<0> scalar(TensorShape({}));
+  EXPECT_EQ(1, scalar.num_elements());
+}
+
+TEST(FixedRankShapeTest, StridesAndEigenDSizes) {
+  FixedRankShape<3, int32> s(TensorShape({2, 3, 4}));
+  Eigen::DSizes<int32, 3> dsizes = s.AsEigenDSizes();
+  EXPECT_EQ(2, dsizes[0]);
+  EXPECT_EQ(3, dsizes[1]);
+  EXPECT_EQ(4, dsizes[2]);
+
+  Eigen::DSizes<int32, 3> strides = s.strides();
+  EXPECT_EQ(12, strides[0]);
+  EXPECT_EQ(4, strides[1]);
+  EXPECT_EQ(1, strides[2]);
+}
+
 // A few different test cases for tensor sizes for benchmarks
 static std::vector<int64_t> MakeSizes(int arg) {
   std::vector<int64_t> sizes;
@@ -902,6 +902,48 @@ TEST(Tensor_HostScalar, Basics) {
   }
 }
 
+TEST(Tensor_InlineBuffer, Basics) {
+  // Tiny host tensors of simple types are backed by inline buffer storage,
+  // which must behave exactly like an allocated buffer.
+  {
+    Tensor t(DT_INT32, TensorShape({}));
+    EXPECT_EQ(1, t.NumElements());
+    EXPECT_TRUE(t.IsAligned());
+    t.scalar<int32>()() = 42;
+    EXPECT_EQ(42, t.scalar<int32>()());
+
+    // Copies alias the same buffer, as for any other tensor.
+    Tensor copy = t;
+    EXPECT_TRUE(t.SharesBufferWith(copy));
+    copy.scalar<int32>()() = 43;
+    EXPECT_EQ(43, t.scalar<int32>()());
+
+    Tensor moved = std::move(copy);
+    EXPECT_TRUE(t.SharesBufferWith(moved));
+    EXPECT_EQ(43, moved.scalar<int32>()());
+  }
+  {
+    Tensor t(DT_INT64, TensorShape({2}));
+    EXPECT_TRUE(t.IsAligned());
+    EXPECT_EQ(2 * sizeof(int64_t), t.TotalBytes());
+    t.vec<int64_t>()(0) = 123;
+    t.vec<int64_t>()(1) = 456;
+
+    TensorProto proto;
+    t.AsProtoField(&proto);
+    Tensor from_proto;
+    EXPECT_TRUE(from_proto.FromProto(proto));
+    test::ExpectEqual(t, from_proto);
+  }
+  {
+    // Just over the inline threshold: takes the regular allocated path.
+    Tensor t(DT_INT32, TensorShape({8}));
+    EXPECT_TRUE(t.IsAligned());
+    for (int i = 0; i < 8; ++i) t.vec<int32>()(i) = i;
+    EXPECT_EQ(7, t.vec<int32>()(7));
+  }
+}
+
 TEST(Tensor_Float, Reshape_And_Slice_Assignment) {
   // A test to experiment with a way to assign to a subset of a tensor
   Tensor t(DT_FLOAT, TensorShape({10, 4, 3, 2}));
@@ -20,15 +20,29 @@ limitations under the License.
 
 namespace tensorflow {
 
-TrackingAllocator::TrackingAllocator(Allocator* allocator, bool track_sizes)
+TrackingAllocator::TrackingAllocator(Allocator* allocator, bool track_sizes,
+                                     int64_t sample_interval)
     : allocator_(allocator),
       ref_(1),
       allocated_(0),
       high_watermark_(0),
       total_bytes_(0),
+      num_allocs_(0),
+      sample_interval_(sample_interval),
+      sample_counter_(0),
       track_sizes_locally_(track_sizes && !allocator_->TracksAllocationSizes()),
       next_allocation_id_(0) {}
 
+void TrackingAllocator::AddAllocated(size_t bytes) {
+  size_t allocated =
+      allocated_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  size_t watermark = high_watermark_.load(std::memory_order_relaxed);
+  while (allocated > watermark &&
+         !high_watermark_.compare_exchange_weak(watermark, allocated,
+                                                std::memory_order_relaxed)) {
+  }
+}
+
 void* TrackingAllocator::AllocateRaw(
     size_t alignment, size_t num_bytes,
     const AllocationAttributes& allocation_attr) {
@@ -38,15 +52,15 @@ void* TrackingAllocator::AllocateRaw(
   if (nullptr == ptr) {
     return ptr;
   }
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+  ref_.fetch_add(1, std::memory_order_relaxed);
   if (allocator_->TracksAllocationSizes()) {
     size_t allocated_bytes = allocator_->AllocatedSize(ptr);
-    {
+    AddAllocated(allocated_bytes);
+    total_bytes_.fetch_add(allocated_bytes, std::memory_order_relaxed);
+    if (ShouldSample()) {
       mutex_lock lock(mu_);
-      allocated_ += allocated_bytes;
-      high_watermark_ = std::max(high_watermark_, allocated_);
-      total_bytes_ += allocated_bytes;
       allocations_.emplace_back(allocated_bytes, Env::Default()->NowMicros());
-      ++ref_;
     }
   } else if (track_sizes_locally_) {
     // Call the underlying allocator to try to get the allocated size
@@ -54,20 +68,22 @@ void* TrackingAllocator::AllocateRaw(
     // use the requested size as an approximation.
     size_t allocated_bytes = allocator_->AllocatedSizeSlow(ptr);
     allocated_bytes = std::max(num_bytes, allocated_bytes);
+    AddAllocated(allocated_bytes);
+    total_bytes_.fetch_add(allocated_bytes, std::memory_order_relaxed);
+    bool sample = ShouldSample();
     mutex_lock lock(mu_);
     next_allocation_id_ += 1;
     Chunk chunk = {num_bytes, allocated_bytes, next_allocation_id_};
     in_use_.emplace(std::make_pair(ptr, chunk));
-    allocated_ += allocated_bytes;
-    high_watermark_ = std::max(high_watermark_, allocated_);
-    total_bytes_ += allocated_bytes;
-    allocations_.emplace_back(allocated_bytes, Env::Default()->NowMicros());
-    ++ref_;
+    if (sample) {
+      allocations_.emplace_back(allocated_bytes, Env::Default()->NowMicros());
+    }
   } else {
-    mutex_lock lock(mu_);
-    total_bytes_ += num_bytes;
-    allocations_.emplace_back(num_bytes, Env::Default()->NowMicros());
-    ++ref_;
+    total_bytes_.fetch_add(num_bytes, std::memory_order_relaxed);
+    if (ShouldSample()) {
+      mutex_lock lock(mu_);
+      allocations_.emplace_back(num_bytes, Env::Default()->NowMicros());
+    }
   }
   return ptr;
 }
@@ -94,15 +110,15 @@ void TrackingAllocator::DeallocateRaw(void* ptr) {
     }
   }
   Allocator* allocator = allocator_;
-  {
-    mutex_lock lock(mu_);
-    if (tracks_allocation_sizes) {
-      CHECK_GE(allocated_, allocated_bytes);
-      allocated_ -= allocated_bytes;
+  if (tracks_allocation_sizes) {
+    CHECK_GE(allocated_.fetch_sub(allocated_bytes, std::memory_order_relaxed),
+             allocated_bytes);
+    if (ShouldSample()) {
+      mutex_lock lock(mu_);
       allocations_.emplace_back(-allocated_bytes, Env::Default()->NowMicros());
     }
-    should_delete = UnRef();
   }
+  should_delete = UnRef();
   allocator->DeallocateRaw(ptr);
   if (should_delete) {
     delete this;
@@ -153,33 +169,37 @@ int64_t TrackingAllocator::AllocationId(const void* ptr) const {
 }
 
 absl::optional<AllocatorStats> TrackingAllocator::GetStats() {
-  return allocator_->GetStats();
+  absl::optional<AllocatorStats> stats = allocator_->GetStats();
+  if (stats) {
+    return stats;
+  }
+  // The underlying allocator does not report stats; synthesize them from the
+  // counters this wrapper maintains so that memory attribution is still
+  // visible through the usual AllocatorStats plumbing.
+  AllocatorStats local_stats;
+  local_stats.num_allocs = num_allocs_.load(std::memory_order_relaxed);
+  local_stats.bytes_in_use = allocated_.load(std::memory_order_relaxed);
+  local_stats.peak_bytes_in_use =
+      high_watermark_.load(std::memory_order_relaxed);
+  return local_stats;
 }
 
 bool TrackingAllocator::ClearStats() { return allocator_->ClearStats(); }
 
 std::tuple<size_t, size_t, size_t> TrackingAllocator::GetSizes() {
-  size_t high_watermark;
-  size_t total_bytes;
-  size_t still_live_bytes;
-  {
-    mutex_lock lock(mu_);
-    high_watermark = high_watermark_;
-    total_bytes = total_bytes_;
-    still_live_bytes = allocated_;
-  }
+  size_t high_watermark = high_watermark_.load(std::memory_order_relaxed);
+  size_t total_bytes = total_bytes_.load(std::memory_order_relaxed);
+  size_t still_live_bytes = allocated_.load(std::memory_order_relaxed);
   return std::make_tuple(total_bytes, high_watermark, still_live_bytes);
 }
 
 gtl::InlinedVector<AllocRecord, 4> TrackingAllocator::GetRecordsAndUnRef() {
-  bool should_delete;
   gtl::InlinedVector<AllocRecord, 4> allocations;
   {
     mutex_lock lock(mu_);
     allocations.swap(allocations_);
-    should_delete = UnRef();
   }
-  if (should_delete) {
+  if (UnRef()) {
     delete this;
   }
   return allocations;
@@ -196,10 +216,4 @@ gtl::InlinedVector<AllocRecord, 4> TrackingAllocator::GetCurrentRecords() {
   return allocations;
 }
 
-bool TrackingAllocator::UnRef() {
-  CHECK_GE(ref_, 1);
-  --ref_;
-  return (ref_ == 0);
-}
-
 }  // end namespace tensorflow
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_TRACKING_ALLOCATOR_H_
 #define TENSORFLOW_CORE_FRAMEWORK_TRACKING_ALLOCATOR_H_
 
+#include <atomic>
 #include <unordered_map>
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
@@ -53,7 +54,13 @@ struct AllocRecord {
 
 class TrackingAllocator : public Allocator {
  public:
-  explicit TrackingAllocator(Allocator* allocator, bool track_ids);
+  // If `sample_interval` is greater than one, only every `sample_interval`-th
+  // allocation event is appended to the allocation record log; the byte
+  // counters remain exact. Counters are maintained with atomics, so unsampled
+  // events do not take the wrapper's mutex. This makes the wrapper cheap
+  // enough to leave enabled outside of offline debugging.
+  explicit TrackingAllocator(Allocator* allocator, bool track_ids,
+                             int64_t sample_interval = 1);
   std::string Name() override { return allocator_->Name(); }
   void* AllocateRaw(size_t alignment, size_t num_bytes) override {
     return AllocateRaw(alignment, num_bytes, AllocationAttributes());
@@ -95,27 +102,47 @@ class TrackingAllocator : public Allocator {
   ~TrackingAllocator() override {}
 
  private:
-  bool UnRef() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  bool UnRef() { return ref_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+  // Returns true iff the current allocation event should be appended to the
+  // allocation record log. Always true when sampling is disabled; otherwise
+  // true for every `sample_interval_`-th event. Lock-free.
+  bool ShouldSample() {
+    return sample_interval_ <= 1 ||
+           sample_counter_.fetch_add(1, std::memory_order_relaxed) %
+                   sample_interval_ ==
+               0;
+  }
+
+  // Adds `bytes` to the outstanding-byte count and raises the high watermark
+  // if the new count exceeds it. Lock-free.
+  void AddAllocated(size_t bytes);
 
   Allocator* allocator_;  // not owned.
   mutable mutex mu_;
   // the number of calls to AllocateRaw that have not yet been matched
   // by a corresponding call to DeAllocateRaw, plus 1 if the Executor
   // has not yet read out the high watermark.
-  int ref_ TF_GUARDED_BY(mu_);
+  std::atomic<int> ref_;
   // the current number of outstanding bytes that have been allocated
   // by this wrapper, or 0 if the underlying allocator does not track
   // allocation sizes.
-  size_t allocated_ TF_GUARDED_BY(mu_);
+  std::atomic<size_t> allocated_;
   // the maximum number of outstanding bytes that have been allocated
   // by this wrapper, or 0 if the underlying allocator does not track
   // allocation sizes.
-  size_t high_watermark_ TF_GUARDED_BY(mu_);
+  std::atomic<size_t> high_watermark_;
   // the total number of bytes that have been allocated by this
   // wrapper if the underlying allocator tracks allocation sizes,
   // otherwise the total number of bytes that have been requested by
   // this allocator.
-  size_t total_bytes_ TF_GUARDED_BY(mu_);
+  std::atomic<size_t> total_bytes_;
+  // the total number of calls to AllocateRaw that returned non-null.
+  std::atomic<int64_t> num_allocs_;
+
+  // Record every `sample_interval_`-th allocation event; 1 records them all.
+  const int64_t sample_interval_;
+  std::atomic<int64_t> sample_counter_;
 
   gtl::InlinedVector<AllocRecord, 4> allocations_ TF_GUARDED_BY(mu_);
 
@@ -139,6 +139,37 @@ TEST(TrackingAllocatorTest, SimpleTracking) {
   EXPECT_EQ(-4, records[3].alloc_bytes);
 }
 
+TEST(TrackingAllocatorTest, SamplingKeepsSizesExact) {
+  TestableSizeTrackingAllocator a = TestableSizeTrackingAllocator();
+
+  // Record only every second allocation event; the byte counters must still
+  // be exact.
+  TrackingAllocator* ta =
+      new TrackingAllocator(&a, false, /*sample_interval=*/2);
+
+  void* ptrs[4];
+  const size_t requested[4] = {12, 4, 8, 16};
+  for (int i = 0; i < 4; ++i) {
+    ptrs[i] = ta->AllocateRaw(4, requested[i]);
+  }
+
+  std::tuple<size_t, size_t, size_t> sizes = ta->GetSizes();
+  EXPECT_EQ(40, std::get<0>(sizes));
+  EXPECT_EQ(40, std::get<1>(sizes));
+  EXPECT_EQ(40, std::get<2>(sizes));
+
+  for (int i = 0; i < 4; ++i) {
+    ta->DeallocateRaw(ptrs[i]);
+  }
+
+  auto records = ta->GetRecordsAndUnRef();
+  EXPECT_EQ(4, records.size());
+  EXPECT_EQ(12, records[0].alloc_bytes);
+  EXPECT_EQ(8, records[1].alloc_bytes);
+  EXPECT_EQ(-12, records[2].alloc_bytes);
+  EXPECT_EQ(-8, records[3].alloc_bytes);
+}
+
 TEST(TrackingAllocatorTest, OutOfMemory) {
   NoMemoryAllocator a;
 
@@ -95,7 +95,8 @@ bool DecodeVariantImpl(VariantTensorData data,
                        TypeResolver<T, false /* is_pod */, true /* Tensor */,
                                     false /* protobuf */>,
                        T* value) {
-  *value = data.tensors(0);
+  if (data.tensors_size() != 1) return false;
+  *value = std::move(data.tensors_[0]);
   return true;
 }
 
@@ -105,9 +106,9 @@ bool DecodeVariantImpl(VariantTensorData data,
                        TypeResolver<T, false /* is_pod */, false /* Tensor */,
                                     true /* protobuf */>,
                        T* value) {
-  std::string metadata;
-  data.get_metadata(&metadata);
-  return value->ParseFromString(std::move(metadata));
+  // `data` is owned here, so parse straight out of its metadata instead of
+  // copying the bytes first.
+  return value->ParseFromString(data.metadata_string());
 }
 
 // Specialization for other types
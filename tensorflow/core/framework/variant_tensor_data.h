@@ -46,6 +46,9 @@ class VariantTensorData {
   // Name of the type of objects being serialized.
   const std::string& type_name() const { return type_name_; }
   void set_type_name(const std::string& type_name) { type_name_ = type_name; }
+  void set_type_name(std::string&& type_name) {
+    type_name_ = std::move(type_name);
+  }
 
   template <typename T, bool = std::is_pod<typename std::decay<T>::type>::value>
   struct PODResolver {};
@@ -57,6 +60,10 @@ class VariantTensorData {
     SetMetadata<T>(value, PODResolver<T>());
   }
 
+  // Overload so that callers handing over an rvalue string do not pay for a
+  // copy of the metadata bytes.
+  void set_metadata(std::string&& value) { metadata_ = std::move(value); }
+
   template <typename T>
   bool get_metadata(T* value) const {
     return GetMetadata<T>(value, PODResolver<T>());
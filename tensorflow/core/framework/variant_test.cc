@@ -493,6 +493,45 @@ TEST(VariantTest, TensorProto) {
   EXPECT_EQ(x.get<TensorProto>()->tensor_shape().unknown_rank(), true);
 }
 
+TEST(VariantTest, VariantTensorDataMoveSetters) {
+  VariantTensorData data;
+  data.set_type_name(std::string("MyType"));
+  EXPECT_EQ(data.type_name(), "MyType");
+  data.set_metadata(std::string("some metadata"));
+  EXPECT_EQ(data.metadata_string(), "some metadata");
+}
+
+TEST(VariantTest, TensorEncodeDecodeRoundTrip) {
+  Variant x;
+  Tensor t(DT_FLOAT, {});
+  t.flat<float>()(0) = 42.0f;
+  x = t;
+
+  VariantTensorData data;
+  x.Encode(&data);
+
+  Variant y = Tensor();
+  EXPECT_TRUE(y.Decode(std::move(data)));
+  EXPECT_NE(y.get<Tensor>(), nullptr);
+  EXPECT_EQ(y.get<Tensor>()->flat<float>()(0), 42.0f);
+}
+
+TEST(VariantTest, TensorProtoEncodeDecodeRoundTrip) {
+  Variant x;
+  TensorProto t;
+  t.set_dtype(DT_FLOAT);
+  t.mutable_tensor_shape()->set_unknown_rank(true);
+  x = t;
+
+  VariantTensorData data;
+  x.Encode(&data);
+
+  Variant y = TensorProto();
+  EXPECT_TRUE(y.Decode(std::move(data)));
+  EXPECT_EQ(y.get<TensorProto>()->dtype(), DT_FLOAT);
+  EXPECT_EQ(y.get<TensorProto>()->tensor_shape().unknown_rank(), true);
+}
+
 template <bool BIG>
 void TestCopyValue() {
   Variant x, y;
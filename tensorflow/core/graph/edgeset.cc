@@ -21,38 +21,47 @@ std::pair<EdgeSet::const_iterator, bool> EdgeSet::insert(value_type value) {
   RegisterMutation();
   const_iterator ci;
   ci.Init(this);
-  auto s = get_set();
-  if (!s) {
+  auto rep = get_rep();
+  if (!rep) {
     for (int i = 0; i < kInline; i++) {
       if (ptrs_[i] == value) {
-        ci.array_iter_ = &ptrs_[i];
+        ci.ptr_ = &ptrs_[i];
         return std::make_pair(ci, false);
       }
     }
     for (int i = 0; i < kInline; i++) {
       if (ptrs_[i] == nullptr) {
         ptrs_[i] = value;
-        ci.array_iter_ = &ptrs_[i];
+        ci.ptr_ = &ptrs_[i];
         return std::make_pair(ci, true);
       }
     }
-    // array is full. convert to set.
-    s = new gtl::FlatSet<const Edge*>;
-    s->insert(reinterpret_cast<const Edge**>(std::begin(ptrs_)),
-              reinterpret_cast<const Edge**>(std::end(ptrs_)));
+    // array is full. convert to overflow rep.
+    rep = new OverflowRep;
+    rep->elems.assign(reinterpret_cast<const Edge**>(std::begin(ptrs_)),
+                      reinterpret_cast<const Edge**>(std::end(ptrs_)));
+    for (int i = 0; i < kInline; i++) {
+      rep->index[rep->elems[i]] = i;
+    }
     ptrs_[0] = this;
-    ptrs_[1] = s;
+    ptrs_[1] = rep;
     // fall through.
   }
-  auto p = s->insert(value);
-  ci.tree_iter_ = p.first;
+  auto p = rep->index.insert(
+      std::make_pair(value, static_cast<int32>(rep->elems.size())));
+  if (p.second) {
+    rep->elems.push_back(value);
+  }
+  ci.ptr_ =
+      reinterpret_cast<const void* const*>(rep->elems.data() +
+                                           p.first->second);
   return std::make_pair(ci, p.second);
 }
 
 EdgeSet::size_type EdgeSet::erase(key_type key) {
   RegisterMutation();
-  auto s = get_set();
-  if (!s) {
+  auto rep = get_rep();
+  if (!rep) {
     for (int i = 0; i < kInline; i++) {
       if (ptrs_[i] == key) {
         size_t n = size();
@@ -63,7 +72,20 @@ EdgeSet::size_type EdgeSet::erase(key_type key) {
     }
     return 0;
   } else {
-    return s->erase(key);
+    auto it = rep->index.find(key);
+    if (it == rep->index.end()) {
+      return 0;
+    }
+    const int32 i = it->second;
+    rep->index.erase(key);
+    const Edge* last = rep->elems.back();
+    rep->elems.pop_back();
+    if (static_cast<size_t>(i) < rep->elems.size()) {
+      // Fill the hole with the last element to keep the array packed.
+      rep->elems[i] = last;
+      rep->index[last] = i;
+    }
+    return 1;
   }
 }
 
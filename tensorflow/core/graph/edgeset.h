@@ -18,7 +18,9 @@ limitations under the License.
 
 #include <stddef.h>
 
-#include "tensorflow/core/lib/gtl/flatset.h"
+#include <vector>
+
+#include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/types.h"
@@ -27,8 +29,10 @@ namespace tensorflow {
 class Edge;
 
 // An unordered set of edges.  Uses very little memory for small sets.
-// Unlike gtl::FlatSet, EdgeSet does NOT allow mutations during
-// iteration.
+// Elements are always stored contiguously (inline for small sets, in a
+// heap-allocated array for large ones), so iteration touches a minimal
+// number of cache lines.  Unlike gtl::FlatSet, EdgeSet does NOT allow
+// mutations during iteration.
 class EdgeSet {
  public:
   EdgeSet();
@@ -48,12 +52,18 @@ class EdgeSet {
   std::pair<iterator, bool> insert(value_type value);
   size_type erase(key_type key);
   void reserve(size_type new_size) {
-    if (new_size > kInline) {
-      auto s = new gtl::FlatSet<const Edge*>(new_size);
-      s->insert(reinterpret_cast<const Edge**>(std::begin(ptrs_)),
-                reinterpret_cast<const Edge**>(&ptrs_[0] + size()));
+    if (new_size > kInline && get_rep() == nullptr) {
+      auto rep = new OverflowRep;
+      rep->elems.reserve(new_size);
+      rep->index.reserve(new_size);
+      const size_type n = size();
+      for (size_type i = 0; i < n; i++) {
+        const Edge* e = static_cast<const Edge*>(ptrs_[i]);
+        rep->index[e] = static_cast<int32>(i);
+        rep->elems.push_back(e);
+      }
       ptrs_[0] = this;
-      ptrs_[1] = s;
+      ptrs_[1] = rep;
     }
   }
 
@@ -62,17 +72,27 @@ class EdgeSet {
   const_iterator end() const;
 
  private:
+  // When a set outgrows the inline array, its elements move to an
+  // OverflowRep: the edges stay in a contiguous array (every pass that
+  // walks the graph iterates these, so locality matters) and a hash index
+  // maps each edge to its position for constant-time insert/erase.
+  // Erase fills the hole with the last element, so `elems` is always
+  // densely packed and unordered.
+  struct OverflowRep {
+    std::vector<const Edge*> elems;
+    gtl::FlatMap<const Edge*, int32> index;
+  };
+
   // Up to kInline elements are stored directly in ptrs_ (nullptr means none).
-  // If ptrs_[0] == this then ptrs_[1] points to a set<const Edge*>.
+  // If ptrs_[0] == this then ptrs_[1] points to an OverflowRep.
   // kInline must be >= 2, and is chosen such that ptrs_ fills a 64 byte
   // cacheline.
   static constexpr int kInline = 64 / sizeof(const void*);
   const void* ptrs_[kInline];
 
-  gtl::FlatSet<const Edge*>* get_set() const {
+  OverflowRep* get_rep() const {
     if (ptrs_[0] == this) {
-      return static_cast<gtl::FlatSet<const Edge*>*>(
-          const_cast<void*>(ptrs_[1]));
+      return static_cast<OverflowRep*>(const_cast<void*>(ptrs_[1]));
     } else {
       return nullptr;
     }
@@ -111,8 +131,9 @@ class EdgeSet::const_iterator {
  private:
   friend class EdgeSet;
 
-  void const* const* array_iter_ = nullptr;
-  typename gtl::FlatSet<const Edge*>::const_iterator tree_iter_;
+  // Both representations store elements contiguously, so an iterator is
+  // just a pointer into the inline or overflow array.
+  void const* const* ptr_ = nullptr;
 
 #ifdef NDEBUG
   inline void Init(const EdgeSet* e) {}
@@ -136,14 +157,14 @@ inline EdgeSet::EdgeSet() {
   }
 }
 
-inline EdgeSet::~EdgeSet() { delete get_set(); }
+inline EdgeSet::~EdgeSet() { delete get_rep(); }
 
 inline bool EdgeSet::empty() const { return size() == 0; }
 
 inline EdgeSet::size_type EdgeSet::size() const {
-  auto s = get_set();
-  if (s) {
-    return s->size();
+  auto rep = get_rep();
+  if (rep) {
+    return rep->elems.size();
   } else {
     size_t result = 0;
     for (int i = 0; i < kInline; i++) {
@@ -155,7 +176,7 @@ inline EdgeSet::size_type EdgeSet::size() const {
 
 inline void EdgeSet::clear() {
   RegisterMutation();
-  delete get_set();
+  delete get_rep();
   for (int i = 0; i < kInline; i++) {
     ptrs_[i] = nullptr;
   }
@@ -164,11 +185,11 @@ inline void EdgeSet::clear() {
 inline EdgeSet::const_iterator EdgeSet::begin() const {
   const_iterator ci;
   ci.Init(this);
-  auto s = get_set();
-  if (s) {
-    ci.tree_iter_ = s->begin();
+  auto rep = get_rep();
+  if (rep) {
+    ci.ptr_ = reinterpret_cast<const void* const*>(rep->elems.data());
   } else {
-    ci.array_iter_ = &ptrs_[0];
+    ci.ptr_ = &ptrs_[0];
   }
   return ci;
 }
@@ -176,22 +197,19 @@ inline EdgeSet::const_iterator EdgeSet::begin() const {
 inline EdgeSet::const_iterator EdgeSet::end() const {
   const_iterator ci;
   ci.Init(this);
-  auto s = get_set();
-  if (s) {
-    ci.tree_iter_ = s->end();
+  auto rep = get_rep();
+  if (rep) {
+    ci.ptr_ = reinterpret_cast<const void* const*>(rep->elems.data() +
+                                                   rep->elems.size());
   } else {
-    ci.array_iter_ = &ptrs_[size()];
+    ci.ptr_ = &ptrs_[size()];
   }
   return ci;
 }
 
 inline EdgeSet::const_iterator& EdgeSet::const_iterator::operator++() {
   CheckNoMutations();
-  if (array_iter_ != nullptr) {
-    ++array_iter_;
-  } else {
-    ++tree_iter_;
-  }
+  ++ptr_;
   return *this;
 }
 
@@ -208,11 +226,7 @@ inline EdgeSet::const_iterator EdgeSet::const_iterator::operator++(
 inline const EdgeSet::const_iterator::value_type* EdgeSet::const_iterator::
 operator->() const {
   CheckNoMutations();
-  if (array_iter_ != nullptr) {
-    return reinterpret_cast<const value_type*>(array_iter_);
-  } else {
-    return tree_iter_.operator->();
-  }
+  return reinterpret_cast<const value_type*>(ptr_);
 }
 
 // gcc's set and multiset always use const_iterator since it will otherwise
@@ -220,24 +234,13 @@ operator->() const {
 inline EdgeSet::const_iterator::value_type EdgeSet::const_iterator::operator*()
     const {
   CheckNoMutations();
-  if (array_iter_ != nullptr) {
-    return static_cast<value_type>(*array_iter_);
-  } else {
-    return *tree_iter_;
-  }
+  return static_cast<value_type>(*ptr_);
 }
 
 inline bool EdgeSet::const_iterator::operator==(
     const const_iterator& other) const {
-  DCHECK((array_iter_ == nullptr) == (other.array_iter_ == nullptr))
-      << "Iterators being compared must be from same set that has not "
-      << "been modified since the iterator was constructed";
   CheckNoMutations();
-  if (array_iter_ != nullptr) {
-    return array_iter_ == other.array_iter_;
-  } else {
-    return other.array_iter_ == nullptr && tree_iter_ == other.tree_iter_;
-  }
+  return ptr_ == other.ptr_;
 }
 
 }  // namespace tensorflow
@@ -62,7 +62,7 @@ class EdgeSetTest : public ::testing::Test {
 namespace {
 
 TEST_F(EdgeSetTest, Ops) {
-  for (int n : {0, 1, 2, kInline + 1}) {
+  for (int n : {0, 1, 2, kInline + 1, kInline * 4 + 1}) {
     MakeEdgeSet(n);
     CheckSame();
     EXPECT_EQ((n == 0), eset_.empty());
@@ -80,7 +80,7 @@ TEST_F(EdgeSetTest, Ops) {
 
 // Try insert/erase of existing elements at different positions.
 TEST_F(EdgeSetTest, Exists) {
-  for (int n : {0, 1, 2, kInline + 1}) {
+  for (int n : {0, 1, 2, kInline + 1, kInline * 4 + 1}) {
     MakeEdgeSet(n);
     for (int pos = 0; pos < n; pos++) {
       auto p = eset_.insert(&edges_[pos]);
@@ -96,7 +96,7 @@ TEST_F(EdgeSetTest, Exists) {
 
 // Try insert/erase of non-existent element.
 TEST_F(EdgeSetTest, DoesNotExist) {
-  for (int n : {0, 1, 2, kInline + 1}) {
+  for (int n : {0, 1, 2, kInline + 1, kInline * 4 + 1}) {
     MakeEdgeSet(n);
     EXPECT_EQ(0, eset_.erase(&nonexistent_));
     auto p = eset_.insert(&nonexistent_);
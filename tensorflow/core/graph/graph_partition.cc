@@ -36,9 +36,13 @@ limitations under the License.
 #include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/dump_graph.h"
 
@@ -46,6 +50,10 @@ namespace tensorflow {
 
 namespace {
 
+// Memory-type lookups are sharded across threads for graphs at least this
+// large; below it the thread pool costs more than the pass itself.
+constexpr int kMinNodesToParallelizeMemoryInfo = 1024;
+
 inline bool IsMerge(const NodeDef& node_def) {
   return node_def.op() == "Merge" || node_def.op() == "RefMerge" ||
          node_def.op() == "_XlaMerge";
@@ -573,29 +581,66 @@ Status AddControlLoop(const PartitionOptions& opts, Graph* g, const Node* src,
 // TODO(yuanbyu): It might be simpler if we convert MemoryType to
 // DeviceType for the inputs/outputs of each node.
 Status BuildMemoryDeviceInfo(const Graph& g, GraphInfo* info) {
-  MemoryTypeVector input_memory_types;
-  MemoryTypeVector output_memory_types;
-
   info->device_types.resize(g.num_node_ids(), DEVICE_CPU);
+
+  std::vector<const Node*> op_nodes;
+  op_nodes.reserve(g.num_op_nodes());
   for (const Node* node : g.op_nodes()) {
-    DeviceNameUtils::ParsedName parsed;
-    if (!DeviceNameUtils::ParseFullName(node->assigned_device_name(),
-                                        &parsed)) {
-      return errors::Internal("Malformed assigned device '",
-                              node->assigned_device_name(), "'");
-    }
+    op_nodes.push_back(node);
+  }
 
-    TF_RETURN_IF_ERROR(MemoryTypesForNode(
-        g.op_registry(), DeviceType(parsed.type), node->def(),
-        &input_memory_types, &output_memory_types));
+  // The lookup is independent per node and involves a kernel registry match,
+  // so for large graphs we shard it across threads. Each node's result lands
+  // in its own slot of `memory_types` (and its own index of `device_types`);
+  // the shared maps are filled serially below.
+  const int64_t num_nodes = op_nodes.size();
+  std::vector<std::pair<MemoryTypeVector, MemoryTypeVector>> memory_types(
+      num_nodes);
+  mutex mu;
+  Status status;
+  auto process_nodes = [&g, &info, &op_nodes, &memory_types, &mu, &status](
+                           int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const Node* node = op_nodes[i];
+      DeviceNameUtils::ParsedName parsed;
+      if (!DeviceNameUtils::ParseFullName(node->assigned_device_name(),
+                                          &parsed)) {
+        mutex_lock l(mu);
+        status.Update(errors::Internal("Malformed assigned device '",
+                                       node->assigned_device_name(), "'"));
+        return;
+      }
+
+      Status s = MemoryTypesForNode(g.op_registry(), DeviceType(parsed.type),
+                                    node->def(), &memory_types[i].first,
+                                    &memory_types[i].second);
+      if (!s.ok()) {
+        mutex_lock l(mu);
+        status.Update(s);
+        return;
+      }
 
-    int node_id = node->id();
-    info->device_types[node_id] = DeviceType(parsed.type);
-    for (int i = 0; i < input_memory_types.size(); ++i) {
-      info->input_types[{node_id, i}] = input_memory_types[i];
+      info->device_types[node->id()] = DeviceType(parsed.type);
     }
-    for (int i = 0; i < output_memory_types.size(); ++i) {
-      info->output_types[{node_id, i}] = output_memory_types[i];
+  };
+  if (num_nodes < kMinNodesToParallelizeMemoryInfo) {
+    process_nodes(0, num_nodes);
+  } else {
+    thread::ThreadPool pool(Env::Default(), "partition_memory_info",
+                            port::NumSchedulableCPUs());
+    pool.ParallelFor(num_nodes, /*cost_per_unit=*/10000, process_nodes);
+  }
+  TF_RETURN_IF_ERROR(status);
+
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    const int node_id = op_nodes[i]->id();
+    const MemoryTypeVector& input_memory_types = memory_types[i].first;
+    for (int j = 0; j < input_memory_types.size(); ++j) {
+      info->input_types[{node_id, j}] = input_memory_types[j];
+    }
+    const MemoryTypeVector& output_memory_types = memory_types[i].second;
+    for (int j = 0; j < output_memory_types.size(); ++j) {
+      info->output_types[{node_id, j}] = output_memory_types[j];
     }
   }
   return OkStatus();
@@ -1226,16 +1271,42 @@ Status Partition(const PartitionOptions& opts, Graph* g,
     flib_def = &g->flib_def();
   }
 
-  // Set versions, function library and send/recv incarnation.
+  // Set versions and function library. Pruning the function library down to
+  // the definitions each partition reaches is independent per partition and
+  // dominates partitioning time for graphs with large libraries, so it is
+  // sharded across threads. FunctionLibraryDefinition reads are internally
+  // synchronized.
+  std::vector<GraphDef*> gdefs;
+  gdefs.reserve(partitions->size());
+  for (auto& it : *partitions) {
+    gdefs.push_back(&it.second);
+  }
+  auto set_versions_and_library = [&g, &flib_def, &gdefs](int64_t begin,
+                                                         int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      GraphDef* gdef = gdefs[i];
+      *gdef->mutable_versions() = g->versions();
+      // Prune unreachable functions from `flib_def` before adding them to
+      // `gdef`.
+      *gdef->mutable_library() =
+          flib_def->ReachableDefinitions(*gdef).ToProto();
+    }
+  };
+  if (gdefs.size() > 1) {
+    thread::ThreadPool pool(
+        Env::Default(), "partition_flib",
+        std::min<int>(port::NumSchedulableCPUs(), gdefs.size()));
+    pool.ParallelFor(gdefs.size(), /*cost_per_unit=*/1 << 20,
+                     set_versions_and_library);
+  } else {
+    set_versions_and_library(0, gdefs.size());
+  }
+
+  // Traverse each graph to fill every send/recv op's incarnation
+  // information. This stays on the caller's thread: opts.get_incarnation is
+  // caller-supplied and not required to be thread-safe.
   for (auto& it : *partitions) {
-    GraphDef* gdef = &it.second;
-    *gdef->mutable_versions() = g->versions();
-    // Prune unreachable functions from `flib_def` before adding them to `gdef`.
-    *gdef->mutable_library() = flib_def->ReachableDefinitions(*gdef).ToProto();
-
-    // Traverse the graph to fill every send/recv op's incarnation
-    // information.
-    SetIncarnation(opts, gdef);
+    SetIncarnation(opts, &it.second);
   }
 
   // Set the start times for recvs at the very end.
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/costs/graph_properties.h"
 
+#include <algorithm>
+
 #include "absl/types/optional.h"
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
@@ -1385,6 +1387,43 @@ class SymbolicShapeRefiner {
     return s;
   }
 
+  // Create the context of `node` and seed its output shapes from
+  // `output_properties` instead of running its shape function. Used for
+  // incremental re-inference, where `node` is a fanin of the re-inferred
+  // subgraph and its previously inferred properties are known to still be
+  // valid. Symbolic dimensions are demoted to unknown dimensions since their
+  // identities aren't preserved across inference runs.
+  Status SeedNodeContext(
+      const NodeDef* node,
+      const std::vector<OpInfo::TensorProperties>& output_properties) {
+    TF_RETURN_IF_ERROR(AddNode(node));
+    NodeContext* ctx = CHECK_NOTNULL(GetNodeContext(node));
+    InferenceContext* ic = ctx->inference_context.get();
+    const int num_properties = output_properties.size();
+    for (int i = 0; i < ic->num_outputs(); ++i) {
+      if (i >= num_properties) {
+        ic->set_output(i, ic->UnknownShape());
+        continue;
+      }
+      TensorShapeProto shape = output_properties[i].shape();
+      for (auto& dim : *shape.mutable_dim()) {
+        if (dim.size() < -1) {
+          dim.set_size(-1);
+        }
+      }
+      ShapeHandle output;
+      TF_RETURN_IF_ERROR(ic->MakeShapeFromShapeProto(shape, &output));
+      ic->set_output(i, output);
+    }
+    // Make the value of a constant fanin available to the shape functions of
+    // its fanout, as a regular inference run would.
+    if (IsConstant(*node)) {
+      ctx->output_tensor_protos.resize(ic->num_outputs(), nullptr);
+      ctx->output_tensor_protos[0] = &node->attr().at("value").tensor();
+    }
+    return OkStatus();
+  }
+
  private:
   // Return the one ShapeHandle used to denote a fully unknown shape for a node
   // output.
@@ -2512,6 +2551,95 @@ Status GraphProperties::UpdateEnqueue(
   return OkStatus();
 }
 
+Status GraphProperties::ExtractNodeProperties(
+    const GraphView& graph_view, SymbolicShapeRefiner* refiner,
+    SymbolicShapeManager* shape_manager, const NodeDef& node,
+    bool aggressive_shape_inference, bool include_input_tensor_values,
+    bool include_output_tensor_values) {
+  VLOG(4) << "Filling in graph properties for node: " << node.name();
+  auto ctx = refiner->GetNodeContext(&node);
+  if (!ctx) {
+    return OkStatus();
+  }
+
+  auto* ic = ctx->inference_context.get();
+
+  // Fill input properties.
+  {
+    auto& input_properties = input_properties_[node.name()];
+
+    // Should always be empty, node names in graph are supposed to be unique.
+    CHECK_EQ(input_properties.size(), 0);
+
+    input_properties.resize(ic->num_inputs());
+    GraphView::InputPort input(&node, -1);
+    for (int i = 0; i < ic->num_inputs(); ++i) {
+      shape_manager->AsTensorProperties(ic->input(i), ctx->input_types[i],
+                                        &input_properties[i]);
+      input.port_id = i;
+      GraphView::OutputPort fanin = graph_view.GetRegularFanin(input);
+      if (include_input_tensor_values) {
+        // Export tensor value to input_properties.value.
+        if (IsConstant(*fanin.node)) {
+          const TensorProto& raw_val = fanin.node->attr().at("value").tensor();
+          *input_properties[i].mutable_value() = raw_val;
+        } else if (static_cast<int>(ctx->input_tensor_protos.size()) > i &&
+                   ctx->input_tensor_protos[i] != nullptr) {
+          *input_properties[i].mutable_value() = *ctx->input_tensor_protos[i];
+        } else if (static_cast<int>(ic->input_tensors_as_shapes().size()) > i &&
+                   IsShapeFullyDefinedIntegerVectorOrScalar(
+                       ic, ic->input(i), ic->input_tensors_as_shapes()[i],
+                       ctx->input_types[i])) {
+          *input_properties[i].mutable_value() = MakeTensorProtoFromShape(
+              ic, ic->input(i), ic->input_tensors_as_shapes()[i],
+              ctx->input_types[i]);
+        }
+      }
+    }
+  }
+
+  // Fill output properties.
+  {
+    auto& output_properties = output_properties_[node.name()];
+
+    // Should always be empty, node names in graph are supposed to be unique.
+    CHECK_EQ(output_properties.size(), 0);
+
+    output_properties.resize(ic->num_outputs());
+    for (int i = 0; i < ic->num_outputs(); ++i) {
+      shape_manager->AsTensorProperties(ic->output(i), ctx->output_types[i],
+                                        &output_properties[i]);
+      auto converted_output_tensors_as_shapes =
+          ReplaceUnknownDimFromConstWithUnknownDim(
+              ic, ctx->output_tensors_as_shapes);
+      if (include_output_tensor_values) {
+        // Export tensor value to output_properties.value.
+        if (IsConstant(node)) {
+          // TODO(rmlarsen): Eliminate this copy.
+          const TensorProto& raw_val = node.attr().at("value").tensor();
+          *output_properties[i].mutable_value() = raw_val;
+        } else if (static_cast<int>(ctx->output_tensor_protos.size()) > i &&
+                   ctx->output_tensor_protos[i] != nullptr) {
+          *output_properties[i].mutable_value() = *ctx->output_tensor_protos[i];
+        } else if (static_cast<int>(converted_output_tensors_as_shapes.size()) >
+                       i &&
+                   IsShapeFullyDefinedIntegerVectorOrScalar(
+                       ic, ic->output(i), converted_output_tensors_as_shapes[i],
+                       ctx->output_types[i])) {
+          *output_properties[i].mutable_value() = MakeTensorProtoFromShape(
+              ic, ic->output(i), converted_output_tensors_as_shapes[i],
+              ctx->output_types[i]);
+        }
+      }
+    }
+  }
+
+  if (aggressive_shape_inference && ctx->shape_incompatible)
+    incompatible_shape_nodes_.insert(node.name());
+
+  return OkStatus();
+}
+
 Status GraphProperties::InferStatically(bool assume_valid_feeds,
                                         bool aggressive_shape_inference,
                                         bool include_input_tensor_values,
@@ -2657,99 +2785,217 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
                                                   shape_manager.get()));
 
   for (const NodeDef& node : item_.graph.node()) {
-    VLOG(4) << "Filling in graph properties for node: " << node.name();
-    auto ctx = refiner->GetNodeContext(&node);
-    if (!ctx) {
-      continue;
+    TF_RETURN_IF_ERROR(ExtractNodeProperties(
+        graph_view, refiner.get(), shape_manager.get(), node,
+        aggressive_shape_inference, include_input_tensor_values,
+        include_output_tensor_values));
+  }
+
+  if (aggressive_shape_inference && !incompatible_shape_nodes_.empty())
+    LOG(WARNING) << incompatible_shape_nodes_.size()
+                 << " nodes have incompatible output shapes.";
+
+  // Help trace the unknown dimensions to their origins.
+  VerboseLogUnknownDimensionSources(item_.graph, input_properties_,
+                                    output_properties_);
+
+  TF_RETURN_IF_ERROR(VerboseShapeInferenceLogging(item_.graph, refiner.get(),
+                                                  shape_manager.get()));
+
+  return OkStatus();
+}
+
+Status GraphProperties::InferIncrementally(
+    const absl::flat_hash_set<string>& modified_nodes, bool assume_valid_feeds,
+    bool aggressive_shape_inference, bool include_input_tensor_values,
+    bool include_output_tensor_values) {
+  if (modified_nodes.empty()) {
+    return OkStatus();
+  }
+  // Without a previous inference there is nothing to reuse.
+  if (!has_properties()) {
+    return InferStatically(assume_valid_feeds, aggressive_shape_inference,
+                           include_input_tensor_values,
+                           include_output_tensor_values);
+  }
+
+  absl::flat_hash_map<string, absl::flat_hash_set<int>> fed_ports;
+  if (!assume_valid_feeds) {
+    for (const auto& feed : item_.feed) {
+      SafeTensorId tensor_id = ParseTensorName(feed.first);
+      fed_ports[tensor_id.node()].insert(tensor_id.index());
     }
+  }
 
-    auto* ic = ctx->inference_context.get();
+  GraphView graph_view(&item_.graph);
 
-    // Fill input properties.
-    {
-      auto& input_properties = input_properties_[node.name()];
-
-      // Should always be empty, node names in graph are supposed to be unique.
-      CHECK_EQ(input_properties.size(), 0);
-
-      input_properties.resize(ic->num_inputs());
-      GraphView::InputPort input(&node, -1);
-      for (int i = 0; i < ic->num_inputs(); ++i) {
-        shape_manager->AsTensorProperties(ic->input(i), ctx->input_types[i],
-                                          &input_properties[i]);
-        input.port_id = i;
-        GraphView::OutputPort fanin = graph_view.GetRegularFanin(input);
-        if (include_input_tensor_values) {
-          // Export tensor value to input_properties.value.
-          if (IsConstant(*fanin.node)) {
-            const TensorProto& raw_val =
-                fanin.node->attr().at("value").tensor();
-            *input_properties[i].mutable_value() = raw_val;
-          } else if (static_cast<int>(ctx->input_tensor_protos.size()) > i &&
-                     ctx->input_tensor_protos[i] != nullptr) {
-            *input_properties[i].mutable_value() = *ctx->input_tensor_protos[i];
-          } else if (static_cast<int>(ic->input_tensors_as_shapes().size()) >
-                         i &&
-                     IsShapeFullyDefinedIntegerVectorOrScalar(
-                         ic, ic->input(i), ic->input_tensors_as_shapes()[i],
-                         ctx->input_types[i])) {
-            *input_properties[i].mutable_value() = MakeTensorProtoFromShape(
-                ic, ic->input(i), ic->input_tensors_as_shapes()[i],
-                ctx->input_types[i]);
-          }
-        }
+  // Collect the nodes whose properties must be re-inferred: the modified
+  // nodes and their transitive fanout.
+  absl::flat_hash_set<const NodeDef*> affected;
+  std::vector<const NodeDef*> worklist;
+  absl::flat_hash_set<string> found_modified_nodes;
+  for (const NodeDef& node : item_.graph.node()) {
+    if (modified_nodes.contains(node.name())) {
+      found_modified_nodes.insert(node.name());
+      if (affected.insert(&node).second) {
+        worklist.push_back(&node);
+      }
+    }
+  }
+  // Modified nodes that are no longer in the graph were deleted: drop their
+  // properties. Their former fanouts are expected to be listed in
+  // modified_nodes as well, since their inputs changed.
+  if (found_modified_nodes.size() != modified_nodes.size()) {
+    for (const string& name : modified_nodes) {
+      if (!found_modified_nodes.contains(name)) {
+        input_properties_.erase(name);
+        output_properties_.erase(name);
+        incompatible_shape_nodes_.erase(name);
       }
     }
+  }
+  while (!worklist.empty()) {
+    const NodeDef* node = worklist.back();
+    worklist.pop_back();
+    for (const GraphView::InputPort& fanout :
+         graph_view.GetFanouts(*node, /*include_controlled_nodes=*/false)) {
+      if (affected.insert(fanout.node).second) {
+        worklist.push_back(fanout.node);
+      }
+    }
+  }
 
-    // Fill output properties.
-    {
-      auto& output_properties = output_properties_[node.name()];
+  // The propagation below doesn't implement the relaxation machinery required
+  // for loops and queues: if the affected subgraph touches them, fall back to
+  // a full inference.
+  for (const NodeDef* node : affected) {
+    if (IsMerge(*node) || IsEnter(*node) || IsExit(*node) ||
+        IsNextIteration(*node) || IsQueue(*node) || IsEnqueue(*node) ||
+        IsDequeue(*node)) {
+      Clear();
+      return InferStatically(assume_valid_feeds, aggressive_shape_inference,
+                             include_input_tensor_values,
+                             include_output_tensor_values);
+    }
+  }
 
-      // Should always be empty, node names in graph are supposed to be unique.
-      CHECK_EQ(output_properties.size(), 0);
+  auto refiner = absl::make_unique<SymbolicShapeRefiner>(
+      graph_view, fed_ports, aggressive_shape_inference);
 
-      output_properties.resize(ic->num_outputs());
-      for (int i = 0; i < ic->num_outputs(); ++i) {
-        shape_manager->AsTensorProperties(ic->output(i), ctx->output_types[i],
-                                          &output_properties[i]);
-        auto converted_output_tensors_as_shapes =
-            ReplaceUnknownDimFromConstWithUnknownDim(
-                ic, ctx->output_tensors_as_shapes);
-        if (include_output_tensor_values) {
-          // Export tensor value to output_properties.value.
-          if (IsConstant(node)) {
-            // TODO(rmlarsen): Eliminate this copy.
-            const TensorProto& raw_val = node.attr().at("value").tensor();
-            *output_properties[i].mutable_value() = raw_val;
-          } else if (static_cast<int>(ctx->output_tensor_protos.size()) > i &&
-                     ctx->output_tensor_protos[i] != nullptr) {
-            *output_properties[i].mutable_value() =
-                *ctx->output_tensor_protos[i];
-          } else if (static_cast<int>(
-                         converted_output_tensors_as_shapes.size()) > i &&
-                     IsShapeFullyDefinedIntegerVectorOrScalar(
-                         ic, ic->output(i),
-                         converted_output_tensors_as_shapes[i],
-                         ctx->output_types[i])) {
-            *output_properties[i].mutable_value() = MakeTensorProtoFromShape(
-                ic, ic->output(i), converted_output_tensors_as_shapes[i],
-                ctx->output_types[i]);
-          }
-        }
+  // Seed the direct fanins of the affected subgraph with the output shapes
+  // inferred for them by the previous run.
+  for (const NodeDef* node : affected) {
+    const int num_inputs = NumNonControlInputs(*node);
+    for (int i = 0; i < num_inputs; ++i) {
+      const GraphView::OutputPort fanin =
+          graph_view.GetRegularFanin(GraphView::InputPort(node, i));
+      if (fanin.node == nullptr || affected.contains(fanin.node) ||
+          refiner->GetNodeContext(fanin.node) != nullptr) {
+        continue;
+      }
+      auto it = output_properties_.find(fanin.node->name());
+      if (it == output_properties_.end()) {
+        // We know nothing about this fanin: re-infer everything.
+        Clear();
+        return InferStatically(assume_valid_feeds, aggressive_shape_inference,
+                               include_input_tensor_values,
+                               include_output_tensor_values);
       }
+      TF_RETURN_IF_ERROR(refiner->SeedNodeContext(fanin.node, it->second));
     }
+  }
 
-    if (aggressive_shape_inference && ctx->shape_incompatible)
-      incompatible_shape_nodes_.insert(node.name());
+  std::vector<const NodeDef*> topo_order;
+  TF_RETURN_IF_ERROR(ComputeTopologicalOrder(item_.graph, &topo_order));
+
+  TopoQueue new_shapes(topo_order);
+  for (const NodeDef* node : affected) {
+    new_shapes.push(node);
   }
+  const absl::flat_hash_map<const NodeDef*, const NodeDef*> resource_handles;
+  TF_RETURN_IF_ERROR(PropagateShapes(refiner.get(), &new_shapes,
+                                     resource_handles, /*num_loops=*/0));
 
-  if (aggressive_shape_inference && !incompatible_shape_nodes_.empty())
-    LOG(WARNING) << incompatible_shape_nodes_.size()
-                 << " nodes have incompatible output shapes.";
+  // Track shapes globally across the re-inferred subgraph.
+  std::unique_ptr<SymbolicShapeManager> shape_manager =
+      absl::make_unique<SymbolicShapeManager>();
+  bool found_error = false;
+  for (const NodeDef& node : item_.graph.node()) {
+    auto node_ctx = refiner->GetContext(&node);
+    if (!node_ctx) {
+      continue;
+    }
+    // Skip any information that comes from fed nodes.
+    if (fed_ports.find(node.name()) != fed_ports.end()) {
+      VLOG(2) << "Skipping feed node shape: " << node.name();
+      continue;
+    }
+    for (const auto& merged_shapes : node_ctx->MergedShapes()) {
+      if (!shape_manager->Merge(merged_shapes.first, merged_shapes.second)
+               .ok()) {
+        found_error = true;
+        break;
+      }
+    }
+    for (const auto& merged_dims : node_ctx->MergedDims()) {
+      if (!shape_manager->Merge(merged_dims.first, merged_dims.second).ok()) {
+        found_error = true;
+        break;
+      }
+    }
+    if (found_error) {
+      // The shapes aren't consistent, we can't infer safely: discard all the
+      // information discovered so far.
+      shape_manager = absl::make_unique<SymbolicShapeManager>();
+      break;
+    }
+  }
 
-  // Help trace the unknown dimensions to their origins.
-  VerboseLogUnknownDimensionSources(item_.graph, input_properties_,
-                                    output_properties_);
+  TF_RETURN_IF_ERROR(ValidateSymbolicShapeManager(item_.graph, refiner.get(),
+                                                  shape_manager.get()));
+
+  // The symbolic dimension ids assigned by this run are unrelated to the ids
+  // retained for the untouched nodes. Shift them below the smallest retained
+  // id so that a stale id can't be mistaken for an equal dimension.
+  for (const NodeDef* node : affected) {
+    input_properties_.erase(node->name());
+    output_properties_.erase(node->name());
+    incompatible_shape_nodes_.erase(node->name());
+  }
+  int64_t min_retained_dim = -1;
+  for (const auto* properties : {&input_properties_, &output_properties_}) {
+    for (const auto& entry : *properties) {
+      for (const auto& tensor_properties : entry.second) {
+        for (const auto& dim : tensor_properties.shape().dim()) {
+          min_retained_dim = std::min(min_retained_dim, dim.size());
+        }
+      }
+    }
+  }
+  const int64_t symbolic_dim_offset = min_retained_dim + 1;
+
+  for (const NodeDef* node : affected) {
+    TF_RETURN_IF_ERROR(ExtractNodeProperties(
+        graph_view, refiner.get(), shape_manager.get(), *node,
+        aggressive_shape_inference, include_input_tensor_values,
+        include_output_tensor_values));
+    if (symbolic_dim_offset == 0) {
+      continue;
+    }
+    for (auto* properties : {&input_properties_, &output_properties_}) {
+      auto it = properties->find(node->name());
+      if (it == properties->end()) {
+        continue;
+      }
+      for (auto& tensor_properties : it->second) {
+        for (auto& dim : *tensor_properties.mutable_shape()->mutable_dim()) {
+          if (dim.size() < -1) {
+            dim.set_size(dim.size() + symbolic_dim_offset);
+          }
+        }
+      }
+    }
+  }
 
   TF_RETURN_IF_ERROR(VerboseShapeInferenceLogging(item_.graph, refiner.get(),
                                                   shape_manager.get()));
@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/framework/shape_inference.h"
 #include "tensorflow/core/grappler/clusters/cluster.h"
 #include "tensorflow/core/grappler/costs/op_performance_data.pb.h"
@@ -69,6 +70,8 @@ ABSL_CONST_INIT const char kOutputTypes[] = "_output_dtype_vector";
 // Outputs TensorShapeProto vector.
 ABSL_CONST_INIT const char kOutputShapes[] = "_output_shape_vector";
 
+class GraphView;
+class SymbolicShapeManager;
 class SymbolicShapeRefiner;
 class TopoQueue;
 
@@ -114,6 +117,28 @@ class GraphProperties {
                            /*aggressive_shape_inference=*/false,
                            /*include_tensor_values=*/true);
   }
+  // Re-infer the properties of the nodes listed in `modified_nodes` and of
+  // their transitive fanout, reusing the properties inferred by a previous
+  // call to InferStatically for the rest of the graph. `modified_nodes` must
+  // name every node that was added to or mutated in `item_.graph` since the
+  // last inference; removed nodes are accounted for by listing their former
+  // fanouts. Falls back to a full InferStatically pass when no properties
+  // have been inferred yet, when a fanin of the re-inferred subgraph has no
+  // recorded properties, or when the subgraph requires the relaxation
+  // machinery used for loops and queues. Symbolic dimension equivalences
+  // between re-inferred nodes and untouched nodes are not preserved.
+  Status InferIncrementally(const absl::flat_hash_set<string>& modified_nodes,
+                            bool assume_valid_feeds,
+                            bool aggressive_shape_inference,
+                            bool include_input_tensor_values,
+                            bool include_output_tensor_values);
+  Status InferIncrementally(const absl::flat_hash_set<string>& modified_nodes,
+                            bool assume_valid_feeds) {
+    return InferIncrementally(modified_nodes, assume_valid_feeds,
+                              /*aggressive_shape_inference=*/false,
+                              /*include_input_tensor_values=*/true,
+                              /*include_output_tensor_values=*/true);
+  }
   // Infer the shape by running the graph on the specified cluster and recording
   // the shapes of the processed tensors.
   Status InferDynamically(Cluster* cluster);
@@ -199,6 +224,17 @@ class GraphProperties {
       const absl::flat_hash_map<const NodeDef*, const NodeDef*>&
           resource_handles,
       int num_loops) const;
+  // Extract the properties of the inputs and outputs of `node` from the
+  // shapes tracked by `shape_refiner` and `shape_manager`, and store them in
+  // input_properties_ and output_properties_. No-op for nodes the refiner
+  // knows nothing about.
+  Status ExtractNodeProperties(const GraphView& graph_view,
+                               SymbolicShapeRefiner* shape_refiner,
+                               SymbolicShapeManager* shape_manager,
+                               const NodeDef& node,
+                               bool aggressive_shape_inference,
+                               bool include_input_tensor_values,
+                               bool include_output_tensor_values);
 
   // Data members
   const GrapplerItem& item_;
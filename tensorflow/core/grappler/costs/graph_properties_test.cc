@@ -233,6 +233,62 @@ TEST_F(GraphPropertiesTest, Clear) {
   EXPECT_FALSE(properties.has_properties());
 }
 
+TEST_F(GraphPropertiesTest, InferIncrementally) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output a = ops::Placeholder(s.WithOpName("a"), DT_FLOAT,
+                              ops::Placeholder::Shape({5, 7}));
+  Output b = ops::Square(s.WithOpName("b"), a);
+  Output c = ops::Identity(s.WithOpName("c"), b);
+
+  GrapplerItem item;
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  GraphProperties properties(item);
+  TF_ASSERT_OK(properties.InferStatically(/*assume_valid_feeds=*/false));
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("c")[0]),
+            "float: [5,7]");
+
+  // Replace the op of "b": its fanin "a" is untouched, so its re-inference
+  // is seeded with the properties of "a" from the previous run.
+  for (NodeDef& node : *item.graph.mutable_node()) {
+    if (node.name() == "b") {
+      node.set_op("Neg");
+    }
+  }
+  TF_ASSERT_OK(properties.InferIncrementally({"b"},
+                                             /*assume_valid_feeds=*/false));
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("b")[0]),
+            "float: [5,7]");
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("c")[0]),
+            "float: [5,7]");
+
+  // Reroute "b" to read from a new placeholder with a different shape: the
+  // new shape must propagate through the fanout of "b", while the properties
+  // of the untouched placeholder are preserved.
+  NodeDef* a2 = item.graph.add_node();
+  a2->set_name("a2");
+  a2->set_op("Placeholder");
+  (*a2->mutable_attr())["dtype"].set_type(DT_FLOAT);
+  TensorShapeProto* a2_shape = (*a2->mutable_attr())["shape"].mutable_shape();
+  a2_shape->add_dim()->set_size(3);
+  a2_shape->add_dim()->set_size(4);
+  for (NodeDef& node : *item.graph.mutable_node()) {
+    if (node.name() == "b") {
+      node.set_input(0, "a2");
+    }
+  }
+  TF_ASSERT_OK(properties.InferIncrementally({"a2", "b"},
+                                             /*assume_valid_feeds=*/false));
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("a2")[0]),
+            "float: [3,4]");
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("b")[0]),
+            "float: [3,4]");
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("c")[0]),
+            "float: [3,4]");
+  EXPECT_EQ(PropToString(properties.GetOutputProperties("a")[0]),
+            "float: [5,7]");
+}
+
 TEST_F(GraphPropertiesTest, DynamicProperties) {
   TrivialTestGraphInputYielder fake_input(4, 1, 10, false,
                                           cluster_->GetDeviceNames());
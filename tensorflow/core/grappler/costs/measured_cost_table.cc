@@ -0,0 +1,113 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/costs/measured_cost_table.h"
+
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+namespace grappler {
+
+namespace {
+
+// Rounds a dimension up to the next power of two, so that nearby shapes share
+// a measurement. Unknown (-1) and degenerate dimensions are kept as is.
+int64_t BucketDim(int64_t dim) {
+  if (dim <= 1) return dim;
+  int64_t bucket = 1;
+  while (bucket < dim) bucket <<= 1;
+  return bucket;
+}
+
+}  // namespace
+
+string MeasuredCostTable::Key(const OpInfo& op_info) {
+  string key = strings::StrCat(op_info.op(), "|", op_info.device().type());
+  for (const auto& input : op_info.inputs()) {
+    strings::StrAppend(&key, "|", static_cast<int>(input.dtype()), ":");
+    if (input.shape().unknown_rank()) {
+      strings::StrAppend(&key, "?");
+      continue;
+    }
+    for (const auto& dim : input.shape().dim()) {
+      strings::StrAppend(&key, BucketDim(dim.size()), ",");
+    }
+  }
+  return key;
+}
+
+void MeasuredCostTable::AddMeasurements(const OpPerformanceList& perf_list) {
+  for (const OpPerformance& perf : perf_list.op_performance()) {
+    // Measurements without a runtime carry no signal for cost prediction.
+    if (perf.compute_cost() <= 0) continue;
+    Measurement& measurement = measurements_[Key(perf.op())];
+    measurement.total_time_ns += perf.compute_cost();
+    measurement.total_temporary_memory += perf.op_memory().temp_memory();
+    ++measurement.count;
+  }
+}
+
+Status MeasuredCostTable::LoadFromFile(Env* env, const string& path) {
+  OpPerformanceList perf_list;
+  Status status = ReadBinaryProto(env, path, &perf_list);
+  if (!status.ok()) {
+    // Small hand-maintained or debug tables are kept in text format.
+    TF_RETURN_IF_ERROR(ReadTextProto(env, path, &perf_list));
+  }
+  AddMeasurements(perf_list);
+  return OkStatus();
+}
+
+bool MeasuredCostTable::EstimateCosts(const OpInfo& op_info,
+                                      Costs* costs) const {
+  auto it = measurements_.find(Key(op_info));
+  if (it == measurements_.end()) return false;
+  const Measurement& measurement = it->second;
+  const double average_time_ns =
+      measurement.total_time_ns / measurement.count;
+  *costs = Costs::ZeroCosts();
+  costs->execution_time = Costs::NanoSeconds(average_time_ns);
+  // Measured runtime covers both compute and memory access; attribute it all
+  // to compute_time so downstream consumers summing the components do not
+  // double count.
+  costs->compute_time = costs->execution_time;
+  costs->temporary_memory = static_cast<int64_t>(
+      measurement.total_temporary_memory / measurement.count);
+  costs->num_ops_total = 1;
+  return true;
+}
+
+const MeasuredCostTable* MeasuredCostTable::GetGlobalTable() {
+  static const MeasuredCostTable* global_table = []() -> MeasuredCostTable* {
+    const char* path = std::getenv("TF_GRAPPLER_MEASURED_COST_TABLE");
+    if (path == nullptr || path[0] == '\0') return nullptr;
+    auto* table = new MeasuredCostTable();
+    Status status = table->LoadFromFile(Env::Default(), path);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to load measured cost table from " << path
+                   << ": " << status;
+      delete table;
+      return nullptr;
+    }
+    LOG(INFO) << "Loaded measured cost table from " << path << " ("
+              << table->num_entries() << " entries)";
+    return table;
+  }();
+  return global_table;
+}
+
+}  // end namespace grappler
+}  // end namespace tensorflow
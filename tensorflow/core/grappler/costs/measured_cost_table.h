@@ -0,0 +1,80 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_COSTS_MEASURED_COST_TABLE_H_
+#define TENSORFLOW_CORE_GRAPPLER_COSTS_MEASURED_COST_TABLE_H_
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/grappler/costs/cost_estimator.h"
+#include "tensorflow/core/grappler/costs/op_performance_data.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/env.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// A table of measured op latencies, keyed by (op, input shape bucket, device
+// type). Measurements are shipped as a serialized OpPerformanceList - the same
+// format produced by CostGraphToOpPerformanceData() from profiled runs - so
+// cost tables collected on the fleet can be distributed alongside models and
+// consulted before falling back to analytical FLOP models.
+//
+// Shape bucketing rounds every dimension up to the next power of two, so a
+// measurement taken at batch 48 also serves predictions for batch 33..64.
+class MeasuredCostTable {
+ public:
+  MeasuredCostTable() = default;
+
+  // Merges all measurements from `perf_list` into the table. Multiple
+  // measurements falling into the same bucket are averaged.
+  void AddMeasurements(const OpPerformanceList& perf_list);
+
+  // Reads an OpPerformanceList (binary or text format) from `path` and merges
+  // its measurements into the table.
+  Status LoadFromFile(Env* env, const string& path);
+
+  // If the table holds a measurement for op_info's op, device type and
+  // bucketed input shapes, fills `costs` with the measured latency and returns
+  // true. Returns false on a miss; the caller is expected to fall back to an
+  // analytical estimate.
+  bool EstimateCosts(const OpInfo& op_info, Costs* costs) const;
+
+  int64_t num_entries() const { return measurements_.size(); }
+
+  // Process-wide table read from the file named by the environment variable
+  // TF_GRAPPLER_MEASURED_COST_TABLE, or nullptr when the variable is unset or
+  // the file fails to load. Never deleted.
+  static const MeasuredCostTable* GetGlobalTable();
+
+ private:
+  struct Measurement {
+    double total_time_ns = 0;
+    double total_temporary_memory = 0;
+    int64_t count = 0;
+  };
+
+  // Builds the lookup key: op name, device type, and per-input dtype plus
+  // bucketed dimensions.
+  static string Key(const OpInfo& op_info);
+
+  absl::flat_hash_map<string, Measurement> measurements_;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_COSTS_MEASURED_COST_TABLE_H_
@@ -0,0 +1,131 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/costs/measured_cost_table.h"
+
+#include <vector>
+
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+OpInfo DescribeOp(const string& op, const string& device_type,
+                  const std::vector<std::vector<int64_t>>& input_shapes) {
+  OpInfo op_info;
+  op_info.set_op(op);
+  op_info.mutable_device()->set_type(device_type);
+  for (const auto& shape : input_shapes) {
+    auto* input = op_info.add_inputs();
+    input->set_dtype(DT_FLOAT);
+    for (int64_t dim : shape) {
+      input->mutable_shape()->add_dim()->set_size(dim);
+    }
+  }
+  return op_info;
+}
+
+OpPerformance MakeMeasurement(const OpInfo& op_info, int64_t compute_cost_ns) {
+  OpPerformance perf;
+  *perf.mutable_op() = op_info;
+  perf.set_compute_cost(compute_cost_ns);
+  return perf;
+}
+
+TEST(MeasuredCostTableTest, LookupAveragesMeasurements) {
+  OpInfo matmul = DescribeOp("MatMul", "CPU", {{64, 64}, {64, 64}});
+
+  OpPerformanceList perf_list;
+  *perf_list.add_op_performance() = MakeMeasurement(matmul, 1000);
+  *perf_list.add_op_performance() = MakeMeasurement(matmul, 3000);
+
+  MeasuredCostTable table;
+  table.AddMeasurements(perf_list);
+  EXPECT_EQ(1, table.num_entries());
+
+  Costs costs;
+  ASSERT_TRUE(table.EstimateCosts(matmul, &costs));
+  EXPECT_EQ(Costs::NanoSeconds(2000), costs.execution_time);
+  EXPECT_EQ(Costs::NanoSeconds(2000), costs.compute_time);
+  EXPECT_FALSE(costs.inaccurate);
+}
+
+TEST(MeasuredCostTableTest, ShapesShareBuckets) {
+  OpInfo measured = DescribeOp("MatMul", "CPU", {{48, 64}, {64, 64}});
+  OpPerformanceList perf_list;
+  *perf_list.add_op_performance() = MakeMeasurement(measured, 500);
+
+  MeasuredCostTable table;
+  table.AddMeasurements(perf_list);
+
+  // Batch 33..64 rounds up to the same bucket as the measured batch 48.
+  Costs costs;
+  EXPECT_TRUE(table.EstimateCosts(
+      DescribeOp("MatMul", "CPU", {{33, 64}, {64, 64}}), &costs));
+  EXPECT_TRUE(table.EstimateCosts(
+      DescribeOp("MatMul", "CPU", {{64, 64}, {64, 64}}), &costs));
+  // Batch 65 falls into the next bucket.
+  EXPECT_FALSE(table.EstimateCosts(
+      DescribeOp("MatMul", "CPU", {{65, 64}, {64, 64}}), &costs));
+}
+
+TEST(MeasuredCostTableTest, MissesOnOpAndDevice) {
+  OpInfo matmul = DescribeOp("MatMul", "CPU", {{64, 64}, {64, 64}});
+  OpPerformanceList perf_list;
+  *perf_list.add_op_performance() = MakeMeasurement(matmul, 500);
+
+  MeasuredCostTable table;
+  table.AddMeasurements(perf_list);
+
+  Costs costs;
+  EXPECT_FALSE(table.EstimateCosts(
+      DescribeOp("Conv2D", "CPU", {{64, 64}, {64, 64}}), &costs));
+  EXPECT_FALSE(table.EstimateCosts(
+      DescribeOp("MatMul", "GPU", {{64, 64}, {64, 64}}), &costs));
+}
+
+TEST(MeasuredCostTableTest, IgnoresMeasurementsWithoutRuntime) {
+  OpInfo matmul = DescribeOp("MatMul", "CPU", {{64, 64}, {64, 64}});
+  OpPerformanceList perf_list;
+  *perf_list.add_op_performance() = MakeMeasurement(matmul, 0);
+
+  MeasuredCostTable table;
+  table.AddMeasurements(perf_list);
+  EXPECT_EQ(0, table.num_entries());
+}
+
+TEST(MeasuredCostTableTest, LoadFromFileRoundTrip) {
+  OpInfo matmul = DescribeOp("MatMul", "CPU", {{64, 64}, {64, 64}});
+  OpPerformanceList perf_list;
+  *perf_list.add_op_performance() = MakeMeasurement(matmul, 750);
+
+  const string path = io::JoinPath(testing::TmpDir(), "cost_table.pb");
+  TF_ASSERT_OK(WriteBinaryProto(Env::Default(), path, perf_list));
+
+  MeasuredCostTable table;
+  TF_ASSERT_OK(table.LoadFromFile(Env::Default(), path));
+
+  Costs costs;
+  ASSERT_TRUE(table.EstimateCosts(matmul, &costs));
+  EXPECT_EQ(Costs::NanoSeconds(750), costs.execution_time);
+}
+
+}  // namespace
+}  // end namespace grappler
+}  // end namespace tensorflow
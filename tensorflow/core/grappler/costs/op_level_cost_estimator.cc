@@ -646,10 +646,20 @@ OpLevelCostEstimator::OpLevelCostEstimator() {
 
   // By default, use sum of memory_time and compute_time for execution_time.
   compute_memory_overlap_ = false;
+
+  measured_cost_table_ = MeasuredCostTable::GetGlobalTable();
 }
 
 Costs OpLevelCostEstimator::PredictCosts(const OpContext& op_context) const {
   Costs costs;
+  // Prefer a measured latency when one is available; the analytical models
+  // below are only a fallback for ops without fleet measurements.
+  if (measured_cost_table_ != nullptr &&
+      measured_cost_table_->EstimateCosts(op_context.op_info, &costs)) {
+    VLOG(1) << "Operation " << op_context.op_info.op() << " takes "
+            << costs.execution_time.count() << " ns (measured).";
+    return costs;
+  }
   NodeCosts node_costs;
   if (PredictNodeCosts(op_context, &node_costs).ok()) {
     if (node_costs.has_costs) {
@@ -19,6 +19,7 @@ limitations under the License.
 #include <numeric>
 
 #include "tensorflow/core/grappler/costs/cost_estimator.h"
+#include "tensorflow/core/grappler/costs/measured_cost_table.h"
 #include "tensorflow/core/grappler/costs/op_context.h"
 #include "tensorflow/core/grappler/costs/op_performance_data.pb.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -98,6 +99,14 @@ class OpLevelCostEstimator {
   // Returns basic device performance info.
   virtual DeviceInfo GetDeviceInfo(const DeviceProperties& device) const;
 
+  // Overrides the measured cost table consulted before the analytical model.
+  // The default is the process-wide table from
+  // MeasuredCostTable::GetGlobalTable(). `table` is not owned and must outlive
+  // the estimator; pass nullptr to force purely analytical estimates.
+  void set_measured_cost_table(const MeasuredCostTable* table) {
+    measured_cost_table_ = table;
+  }
+
  protected:
   // TODO(dyoon): Consider to remove PredictOpCountBasedCosts() with OpInfo.
   // Naive cost estimate based on the given operations count and total
@@ -320,6 +329,8 @@ class OpLevelCostEstimator {
   // compute_time and memory_time, instead of sum of those two.
   bool compute_memory_overlap_;
   std::set<string> persistent_ops_;
+  // Measured latencies consulted before the analytical model; not owned.
+  const MeasuredCostTable* measured_cost_table_;
 
  private:
   friend class OpLevelCostEstimatorTest;
@@ -184,7 +184,7 @@ Status HeapReadyManager::Init(
 void HeapReadyManager::AddNode(const NodeDef* node) {
   // push_heap in AddNode and pop_heap in RemoveCurrNode() guarantees that the
   // first element is the node with minimum time_ready.
-  nodes_.push_back(node);
+  nodes_.push_back({node, node_map_->at(node).time_ready, NodePriority(node)});
   std::push_heap(nodes_.begin(), nodes_.end(), greater_);
 }
 
@@ -193,10 +193,9 @@ const NodeDef* HeapReadyManager::GetCurrNode() {
   if (nodes_.empty()) {
     CHECK(!nodes_.empty()) << "GetCurrNode(), but there's no ready node";
   }
-  const std::string node_name = nodes_.front()->name();
   // Next time we call GetCurrNode(), it just returns the cached copy
   // curr_node_, until we call the RemoveCurrNode().
-  curr_node_ = nodes_.front();
+  curr_node_ = nodes_.front().node;
   // Remove current node from the heap immediately. Because if we wait until
   // later, the heap could have gotten re-organized if AddNode is called. The
   // current node is anyways cached, incase GetCurrNode() is called again.
@@ -221,41 +220,41 @@ bool HeapReadyManager::Empty() const {
   return nodes_.empty() && curr_node_ == nullptr;
 }
 
-bool FirstReadyCmp(
-    const std::unordered_map<const NodeDef*, NodeState>* node_map,
-    const NodeDef* a, const NodeDef* b) {
-  if (node_map->at(a).time_ready == node_map->at(b).time_ready) {
+bool FirstReadyCmp(const HeapReadyManager::ReadyNode& a,
+                   const HeapReadyManager::ReadyNode& b) {
+  if (a.time_ready == b.time_ready) {
     // Use Node name as tie-breaker for deterministic node scheduling.
-    return a->name().compare(b->name()) > 0;
+    return a.node->name().compare(b.node->name()) > 0;
   } else {
     // Note: we need a node with minimum time_ready, not maximum; hence, using
     // a > b for comparison function.
-    return node_map->at(a).time_ready > node_map->at(b).time_ready;
+    return a.time_ready > b.time_ready;
   }
 }
 
-std::function<bool(const NodeDef*, const NodeDef*)>
+std::function<bool(const HeapReadyManager::ReadyNode&,
+                   const HeapReadyManager::ReadyNode&)>
 FirstReadyManager::Greater() {
-  auto greater = [this](const NodeDef* a, const NodeDef* b) -> bool {
-    return FirstReadyCmp(node_map_, a, b);
-  };
-  return greater;
+  return FirstReadyCmp;
 }
 
-std::function<bool(const NodeDef*, const NodeDef*)>
+std::function<bool(const HeapReadyManager::ReadyNode&,
+                   const HeapReadyManager::ReadyNode&)>
 PriorityReadyManager::Greater() {
-  auto greater = [this](const NodeDef* a, const NodeDef* b) -> bool {
-    auto pri_a = node_priority_.at(a->name());
-    auto pri_b = node_priority_.at(b->name());
-    if (pri_a == pri_b) {
+  auto greater = [](const ReadyNode& a, const ReadyNode& b) -> bool {
+    if (a.priority == b.priority) {
       // Fallback to default (FirstReady) behaviour.
-      return FirstReadyCmp(node_map_, a, b);
+      return FirstReadyCmp(a, b);
     }
-    return pri_a > pri_b;
+    return a.priority > b.priority;
   };
   return greater;
 }
 
+int PriorityReadyManager::NodePriority(const NodeDef* node) const {
+  return node_priority_.at(node->name());
+}
+
 void PriorityReadyManager::AddNode(const NodeDef* node) {
   if (node_priority_.count(node->name()) == 0) {
     VLOG(3) << "Priority of node " << node->name() << " not found.";
@@ -353,7 +352,7 @@ void CompositeNodeManager::RemoveCurrNode() {
   } else if (IsRecv(*node)) {
     recv_manager_.RemoveCurrNode();
   } else {
-    const auto device = node_map_->at(node).device_name;
+    const auto& device = node_map_->at(node).device_name;
     ops_lifo_map_[device].RemoveCurrNode();
   }
   // Reset curr_node_ so that GetCurrNode() finds another node.
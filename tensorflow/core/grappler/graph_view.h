@@ -318,6 +318,18 @@ class GraphViewInternal {
  protected:
   explicit GraphViewInternal(GraphDefT* graph) : graph_(graph) {}
 
+  // Reserves capacity in the internal lookup maps ahead of bulk insertions
+  // (e.g. during construction) to avoid repeated rehashing. `num_edges` should
+  // be an upper bound on the number of output ports with fanouts; the total
+  // number of node inputs is a cheap over-approximation.
+  void Reserve(int num_nodes, int num_edges) {
+    nodes_.reserve(nodes_.size() + num_nodes);
+    fanouts_.reserve(fanouts_.size() + num_edges);
+    max_regular_input_port_.reserve(max_regular_input_port_.size() + num_nodes);
+    max_regular_output_port_.reserve(max_regular_output_port_.size() +
+                                     num_nodes);
+  }
+
   Status AddUniqueNode(NodeDefT* node) {
     auto inserted = nodes_.emplace(node->name(), node);
     return inserted.second
@@ -401,6 +413,9 @@ class GraphView
     : public internal::GraphViewInternal<const GraphDef, const NodeDef> {
  public:
   explicit GraphView(const GraphDef* graph) : GraphViewInternal(graph) {
+    int num_edges = 0;
+    for (const NodeDef& node : graph->node()) num_edges += node.input_size();
+    Reserve(graph->node_size(), num_edges);
     for (const NodeDef& node : graph->node()) AddUniqueNodeOrDie(&node);
     for (const NodeDef& node : graph->node()) AddFanouts(&node);
   }
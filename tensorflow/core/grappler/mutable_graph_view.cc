@@ -495,6 +495,10 @@ Status MutableGraphView::AddSubgraph(GraphDef&& subgraph) {
   // 2. Add all nodes to the underlying graph.
   int node_size_before = graph()->node_size();
 
+  int num_edges = 0;
+  for (const NodeDef& node : subgraph.node()) num_edges += node.input_size();
+  Reserve(subgraph.node_size(), num_edges);
+
   for (NodeDef& node : *subgraph.mutable_node()) {
     auto* node_in_graph = graph()->add_node();
     node_in_graph->Swap(&node);
@@ -767,6 +771,35 @@ Status MutableGraphView::UpdateFanouts(absl::string_view from_node_name,
   return UpdateFanoutsInternal(from_node, to_node);
 }
 
+Status MutableGraphView::UpdateFanouts(
+    absl::Span<const std::pair<string, string>> fanout_updates) {
+  // Resolve and validate all nodes before mutating the graph, so a missing
+  // node reported partway through the batch doesn't leave a partial update.
+  std::vector<std::pair<NodeDef*, NodeDef*>> nodes;
+  nodes.reserve(fanout_updates.size());
+  for (const auto& fanout_update : fanout_updates) {
+    NodeDef* from_node = GetNode(fanout_update.first);
+    TF_RETURN_IF_ERROR(
+        CheckNodeExists(fanout_update.first, from_node,
+                        UpdateFanoutsError(fanout_update.first,
+                                           fanout_update.second)));
+    NodeDef* to_node = GetNode(fanout_update.second);
+    TF_RETURN_IF_ERROR(
+        CheckNodeExists(fanout_update.second, to_node,
+                        UpdateFanoutsError(fanout_update.first,
+                                           fanout_update.second)));
+    nodes.emplace_back(from_node, to_node);
+  }
+
+  // UpdateFanoutsInternal doesn't add or remove nodes, so the resolved
+  // pointers stay valid across the batch.
+  for (const auto& from_to : nodes) {
+    TF_RETURN_IF_ERROR(UpdateFanoutsInternal(from_to.first, from_to.second));
+  }
+
+  return OkStatus();
+}
+
 Status MutableGraphView::UpdateFanoutsInternal(NodeDef* from_node,
                                                NodeDef* to_node) {
   VLOG(2) << absl::Substitute("Update fanouts from '$0' to '$1'.",
@@ -43,6 +43,9 @@ const char kMutableGraphViewCtrl[] = "ConstantFoldingCtrl";
 class MutableGraphView : public internal::GraphViewInternal<GraphDef, NodeDef> {
  public:
   explicit MutableGraphView(GraphDef* graph) : GraphViewInternal(graph) {
+    int num_edges = 0;
+    for (const NodeDef& node : graph->node()) num_edges += node.input_size();
+    Reserve(graph->node_size(), num_edges);
     for (NodeDef& node : *graph->mutable_node()) AddUniqueNodeOrDie(&node);
     for (NodeDef& node : *graph->mutable_node()) AddAndDedupFanouts(&node);
   }
@@ -133,6 +136,13 @@ class MutableGraphView : public internal::GraphViewInternal<GraphDef, NodeDef> {
   Status UpdateFanouts(absl::string_view from_node_name,
                        absl::string_view to_node_name);
 
+  // Updates fanouts for multiple `{from_node_name, to_node_name}` pairs, as if
+  // UpdateFanouts was called once per pair in order, but with all node lookups
+  // performed upfront. If any node does not exist, an error will be returned
+  // and nothing will be modified in the graph.
+  Status UpdateFanouts(
+      absl::Span<const std::pair<string, string>> fanout_updates);
+
   // Adds regular fanin `fanin` to node `node_name`. If the node or fanin do not
   // exist in the graph, nothing will be modified in the graph. Otherwise fanin
   // will be added after existing non control dependency fanins. Control
@@ -890,6 +890,71 @@ TEST(MutableGraphViewTest, UpdateFanoutsToSwitchWithNoControlFromSwitch) {
   CheckGraph(graph);
 }
 
+TEST(MutableGraphViewTest, UpdateFanoutsBatched) {
+  // Actual node.op() is not important in this test.
+  GraphDef graph_def = test::function::GDef(
+      {NDef("bar_1", "NotImportant", {}, {}),
+       NDef("bar_2", "NotImportant", {}, {}),
+       NDef("foo_1", "NotImportant", {"bar_1", "bar_2:1", "^bar_1"}),
+       NDef("foo_2", "NotImportant", {"bar_2", "^bar_2"})},
+      /*funcs=*/{});
+
+  MutableGraphView graph(&graph_def);
+
+  graph.AddNode(NDef("new_bar_1", "NotImportant", {}, {}));
+  graph.AddNode(NDef("new_bar_2", "NotImportant", {}, {}));
+
+  std::vector<std::pair<string, string>> fanout_updates = {
+      {"bar_1", "new_bar_1"}, {"bar_2", "new_bar_2"}};
+  TF_EXPECT_OK(graph.UpdateFanouts(absl::MakeSpan(fanout_updates)));
+
+  // Fanins and fanouts must be updated for all pairs.
+  CheckNode(graph, "bar_1", "NotImportant", "", {}, {}, {});
+  CheckNode(graph, "bar_2", "NotImportant", "", {}, {}, {});
+  CheckNode(graph, "foo_1", "NotImportant", "", {},
+            {"new_bar_1", "new_bar_2:1", "^new_bar_1"}, {});
+  CheckNode(graph, "foo_2", "NotImportant", "", {},
+            {"new_bar_2", "^new_bar_2"}, {});
+  CheckNode(graph, "new_bar_1", "NotImportant", "", {}, {},
+            {"foo_1:0", "^foo_1"});
+  CheckNode(graph, "new_bar_2", "NotImportant", "", {}, {},
+            {"foo_1:1", "foo_2:0", "^foo_2"});
+
+  CheckGraph(graph);
+}
+
+TEST(MutableGraphViewTest, UpdateFanoutsBatchedMissingNode) {
+  // Actual node.op() is not important in this test.
+  GraphDef graph_def = test::function::GDef(
+      {NDef("bar_1", "NotImportant", {}, {}),
+       NDef("bar_2", "NotImportant", {}, {}),
+       NDef("foo_1", "NotImportant", {"bar_1", "bar_2:1", "^bar_1"})},
+      /*funcs=*/{});
+
+  MutableGraphView graph(&graph_def);
+
+  graph.AddNode(NDef("new_bar_1", "NotImportant", {}, {}));
+
+  std::vector<std::pair<string, string>> fanout_updates = {
+      {"bar_1", "new_bar_1"}, {"bar_2", "new_bar_2"}};
+  Status s = graph.UpdateFanouts(absl::MakeSpan(fanout_updates));
+  EXPECT_FALSE(s.ok());
+  string expected_msg =
+      "MutableGraphView::UpdateFanouts(from_node_name='bar_2', "
+      "to_node_name='new_bar_2') error: node 'new_bar_2' was not found.";
+  EXPECT_EQ(s.error_message(), expected_msg);
+
+  // A missing node anywhere in the batch must leave the graph unmodified.
+  CheckNode(graph, "bar_1", "NotImportant", "", {}, {},
+            {"foo_1:0", "^foo_1"});
+  CheckNode(graph, "bar_2", "NotImportant", "", {}, {}, {"foo_1:1"});
+  CheckNode(graph, "foo_1", "NotImportant", "", {},
+            {"bar_1", "bar_2:1", "^bar_1"}, {});
+  CheckNode(graph, "new_bar_1", "NotImportant", "", {}, {}, {});
+
+  CheckGraph(graph);
+}
+
 GraphDef SimpleMutateFaninGraph() {
   // Actual node.op() is not important in this test.
   GraphDef graph_def = test::function::GDef(
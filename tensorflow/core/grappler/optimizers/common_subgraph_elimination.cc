@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/common_subgraph_elimination.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -35,7 +36,10 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils/canonicalizer.h"
 #include "tensorflow/core/grappler/utils/topological_sort.h"
 #include "tensorflow/core/grappler/utils/traversal.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/flatset.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/hash.h"
 #include "tensorflow/core/platform/status.h"
@@ -53,6 +57,34 @@ using tensorflow::strings::StrCat;
 
 namespace tensorflow {
 namespace grappler {
+namespace {
+
+// Graphs below this size are hashed serially; spinning up a thread pool costs
+// more than it saves.
+constexpr int kMinNodesToParallelizeSignatures = 8192;
+
+// Hashes the op, device, inputs and attributes of a node. The hash is
+// independent of the order of inputs and attributes.
+uint64 NodeSignature(const NodeDef& node) {
+  uint64 h = Hash64(node.op());
+  h = Hash64Combine(Hash64(node.device()), h);
+
+  for (const auto& input : node.input()) {
+    const TensorId input_tensor = ParseTensorName(input);
+    uint64 input_hash = Hash64Combine(
+        Hash64(input_tensor.node().data(), input_tensor.node().size()),
+        std::hash<int>()(input_tensor.index()));
+    h = Hash64CombineUnordered(input_hash, h);
+  }
+  for (const auto& attr : node.attr()) {
+    uint64 attr_hash =
+        Hash64Combine(Hash64(attr.first), FastAttrValueHash(attr.second));
+    h = Hash64CombineUnordered(attr_hash, h);
+  }
+  return h;
+}
+
+}  // namespace
 
 class UniqueNodes {
  public:
@@ -86,6 +118,36 @@ class UniqueNodes {
     memoized_signatures_.erase(node);
   }
 
+  // Seeds the signature memoization table for all dedupable nodes of the
+  // graph, sharding the hashing across threads. Signature computation is
+  // independent per node, so the initial pass over a large graph parallelizes
+  // cleanly; later passes only rehash nodes whose inputs were rewritten.
+  void PrecomputeSignatures(const GraphDef& graph,
+                            const std::vector<bool>& can_dedup) {
+    const int num_nodes = graph.node_size();
+    if (num_nodes < kMinNodesToParallelizeSignatures) return;
+
+    std::vector<uint64> signatures(num_nodes);
+    thread::ThreadPool pool(Env::Default(), "cse_signatures",
+                            port::NumSchedulableCPUs());
+    pool.ParallelFor(num_nodes, /*cost_per_unit=*/1000,
+                     [&graph, &can_dedup, &signatures](int64_t begin,
+                                                       int64_t end) {
+                       for (int64_t i = begin; i < end; ++i) {
+                         if (can_dedup[i]) {
+                           signatures[i] = NodeSignature(graph.node(i));
+                         }
+                       }
+                     });
+
+    memoized_signatures_.reserve(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) {
+      if (can_dedup[i]) {
+        memoized_signatures_.emplace(&graph.node(i), signatures[i]);
+      }
+    }
+  }
+
  private:
   uint64 ComputeSignature(const NodeDef& node);
   bool SameNode(const NodeDef& node1, const NodeDef& node2) const;
@@ -98,21 +160,7 @@ uint64 UniqueNodes::ComputeSignature(const NodeDef& node) {
   auto it = memoized_signatures_.find(&node);
   if (it != memoized_signatures_.end()) return it->second;
 
-  uint64 h = Hash64(node.op());
-  h = Hash64Combine(Hash64(node.device()), h);
-
-  for (const auto& input : node.input()) {
-    const TensorId input_tensor = ParseTensorName(input);
-    uint64 input_hash = Hash64Combine(
-        Hash64(input_tensor.node().data(), input_tensor.node().size()),
-        std::hash<int>()(input_tensor.index()));
-    h = Hash64CombineUnordered(input_hash, h);
-  }
-  for (const auto& attr : node.attr()) {
-    uint64 attr_hash =
-        Hash64Combine(Hash64(attr.first), FastAttrValueHash(attr.second));
-    h = Hash64CombineUnordered(attr_hash, h);
-  }
+  uint64 h = NodeSignature(node);
   memoized_signatures_.emplace(&node, h);
   return h;
 }
@@ -208,14 +256,32 @@ Status CommonSubgraphElimination::DedupComputations(GraphDef* optimized_graph) {
                    CanDedup(node);
   }
 
-  bool stop = true;
   std::set<int> duplicates;
   UniqueNodes nodes;
+  nodes.PrecomputeSignatures(*optimized_graph, can_dedup);
   NodeMap node_map(optimized_graph);
-  do {
-    stop = true;
-    for (int i = 0; i < optimized_graph->node_size(); ++i) {
-      if (!can_dedup[i] || duplicates.find(i) != duplicates.end()) {
+
+  // Deduping a node only changes the signatures of its fanouts, so rounds
+  // after the first need to revisit just the nodes whose inputs were rewritten
+  // instead of rescanning the whole graph.
+  absl::flat_hash_map<const NodeDef*, int> node_index;
+  node_index.reserve(optimized_graph->node_size());
+  for (int i = 0; i < optimized_graph->node_size(); ++i) {
+    node_index.emplace(&optimized_graph->node(i), i);
+  }
+  std::vector<int> current_round;
+  current_round.reserve(optimized_graph->node_size());
+  for (int i = 0; i < optimized_graph->node_size(); ++i) {
+    if (can_dedup[i]) {
+      current_round.push_back(i);
+    }
+  }
+  std::vector<bool> queued(optimized_graph->node_size(), false);
+  std::vector<int> next_round;
+  while (!current_round.empty()) {
+    next_round.clear();
+    for (int i : current_round) {
+      if (duplicates.find(i) != duplicates.end()) {
         continue;
       }
       NodeDef* node = optimized_graph->mutable_node(i);
@@ -255,15 +321,24 @@ Status CommonSubgraphElimination::DedupComputations(GraphDef* optimized_graph) {
         if (updated_fanout) {
           node_map.UpdateInput(fanout->name(), node->name(), rep->name());
           CanonicalizeNode(fanout);
+          const int fanout_index = node_index.at(fanout);
+          if (can_dedup[fanout_index] && !queued[fanout_index]) {
+            queued[fanout_index] = true;
+            next_round.push_back(fanout_index);
+          }
         }
       }
       if (fetch_nodes_known_) {
         node->Clear();
       }
       duplicates.insert(i);
-      stop = false;
     }
-  } while (!stop);
+    std::sort(next_round.begin(), next_round.end());
+    for (int i : next_round) {
+      queued[i] = false;
+    }
+    current_round.swap(next_round);
+  }
 
   // Delete duplicates
   if (fetch_nodes_known_ && !duplicates.empty()) {
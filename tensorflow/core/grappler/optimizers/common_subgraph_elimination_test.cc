@@ -174,5 +174,42 @@ TEST_F(CommonSubgraphEliminationTest, OpDedupCommutative) {
   test::ExpectTensorNear<float>(tensors[0], tensors_expected[0], 1e-6);
 }
 
+TEST_F(CommonSubgraphEliminationTest, OpDedupCascaded) {
+  // Deduping c2 into c1 makes sqrt2 a duplicate of sqrt1, which in turn makes
+  // the duplication visible to add1; the dedup must propagate through all
+  // three levels.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output c1 = ops::Const(s.WithOpName("c1"), {3.14f, 2.7f}, {1, 2});
+  Output c2 = ops::Const(s.WithOpName("c2"), {3.14f, 2.7f}, {1, 2});
+  Output sqrt1 = ops::Sqrt(s.WithOpName("sqrt1"), c1);
+  Output sqrt2 = ops::Sqrt(s.WithOpName("sqrt2"), c2);
+  Output add1 = ops::Add(s.WithOpName("add1"), sqrt1, sqrt2);
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"add1"};
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch);
+  ASSERT_EQ(tensors_expected.size(), 1);
+
+  CommonSubgraphElimination optimizer;
+  GraphDef output;
+  OptimizeTwice(&optimizer, &item, &output);
+  NodeMap node_map(&output);
+
+  EXPECT_EQ(output.node_size(), 3);
+  const NodeDef* new_sqrt1 = node_map.GetNode("sqrt1");
+  ASSERT_NE(new_sqrt1, nullptr);
+  ASSERT_EQ(new_sqrt1->input_size(), 1);
+  EXPECT_EQ(new_sqrt1->input(0), "c1");
+  const NodeDef* new_add1 = node_map.GetNode("add1");
+  ASSERT_NE(new_add1, nullptr);
+  ASSERT_EQ(new_add1->input_size(), 2);
+  EXPECT_EQ(new_add1->input(0), "sqrt1");
+  EXPECT_EQ(new_add1->input(1), "sqrt1");
+
+  auto tensors = EvaluateNodes(output, item.fetch);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectTensorNear<float>(tensors[0], tensors_expected[0], 1e-6);
+}
+
 }  // namespace grappler
 }  // namespace tensorflow
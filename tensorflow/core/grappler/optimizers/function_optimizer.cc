@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/function_optimizer.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/algorithm/container.h"
@@ -51,7 +52,10 @@ limitations under the License.
 #include "tensorflow/core/grappler/op_types.h"
 #include "tensorflow/core/grappler/utils.h"
 #include "tensorflow/core/grappler/utils/functions.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -304,16 +308,6 @@ class FunctionOptimizerContext {
     return gtl::FindWithDefault(truly_const_nodes_, name, nullptr);
   }
 
-  const FunctionSpecialization* FindFunctionSpecialization(
-      const FunctionSpecializationSignature& sig) const {
-    return gtl::FindOrNull(specialized_functions_, sig);
-  }
-
-  void AddSpecializedFunction(const FunctionSpecializationSignature& sig,
-                              const FunctionSpecialization& specialized_func) {
-    specialized_functions_.emplace(sig, specialized_func);
-  }
-
   void AddTensorMapping(const SafeTensorId& from, const SafeTensorId& to) {
     DCHECK(from.index() != Graph::kControlSlot)
         << "Tensor mapping must be from regular tensor";
@@ -365,10 +359,6 @@ class FunctionOptimizerContext {
 
   // Nodes that are Const and not in feed.
   absl::flat_hash_map<string, const NodeDef*> truly_const_nodes_;
-  // Specialized functions.
-  absl::flat_hash_map<FunctionSpecializationSignature,
-                      const FunctionSpecialization>
-      specialized_functions_;
 
   // After function specialization, the optimized graph might be in invalid
   // state, nodes can read from output index that is no longer valid after
@@ -680,53 +670,34 @@ string SpecializedFunctionName(const FunctionOptimizerContext& ctx,
       absl::StrReplaceAll(func_node.name(), {{"/", "_"}}), ctx.item().id);
 }
 
-Status SpecializeFunction(const NodeDef& func_node, const FunctionDef& func,
-                          FunctionOptimizerContext* ctx,
-                          GraphDef* optimized_graph) {
+// Builds the specialized function body and metadata for the given function
+// call node. Only reads from the context and the function library, so
+// specializations for distinct signatures can be built concurrently; adding
+// the result to the function library and to the optimized graph is left to
+// the caller.
+Status MakeFunctionSpecialization(
+    const NodeDef& func_node, const FunctionDef& func,
+    const FunctionSpecializationSignature& signature,
+    const FunctionOptimizerContext& ctx, FunctionDef* specialized_func,
+    FunctionSpecialization* specialization) {
   VLOG(2) << "Specialize function call: " << SummarizeNodeDef(func_node);
 
   const AttrSlice func_instantiation_attr =
       FunctionInstantiationAttributes(func, func_node);
 
-  FunctionSpecializationSignature signature;
-  TF_RETURN_IF_ERROR(InitializeFunctionSpecializationSignature(
-      func_node, func, func_instantiation_attr, *ctx, &signature));
-
-  // Check if function was already specialized for identical context.
-  const FunctionSpecialization* already_specialized =
-      ctx->FindFunctionSpecialization(signature);
-
-  if (already_specialized) {
-    VLOG(2) << "Function was already specialized in identical context: "
-               "specialized_name="
-            << already_specialized->specialized_func_name;
-
-    // Add a function call node for the specialized function.
-    NodeDef* specialized_func_node = optimized_graph->add_node();
-    *specialized_func_node = func_node;
-
-    TF_RETURN_IF_ERROR(UpdateSpecializedFunctionNode(
-        func, func_node, *already_specialized, specialized_func_node));
-
-    ctx->AddTensorMapping(specialized_func_node->name(), *already_specialized);
-
-    return OkStatus();
-  }
-
-  // Add a new specialized function definition to the library.
-  const auto& flib = ctx->function_library();
+  const auto& flib = ctx.function_library();
 
   // Make a GrapplerFunctionItem and convert it back to FunctionDef after
   // pushing all constant inputs into the function body.
   GrapplerFunctionItem item;
   TF_RETURN_IF_ERROR(MakeGrapplerFunctionItem(
-      func, func_instantiation_attr, flib, ctx->graph_version(), &item));
+      func, func_instantiation_attr, flib, ctx.graph_version(), &item));
 
   // Push const inputs into the function body, and keep track of their control
   // dependencies.
   absl::flat_hash_set<string> const_inputs;
   absl::flat_hash_set<string> control_deps;
-  TF_RETURN_IF_ERROR(PushDownConstInputs(func_node, *ctx, &item, &const_inputs,
+  TF_RETURN_IF_ERROR(PushDownConstInputs(func_node, ctx, &item, &const_inputs,
                                          &control_deps));
 
   // Remove function outputs that do not have any consumers. We can't safely
@@ -744,38 +715,24 @@ Status SpecializeFunction(const NodeDef& func_node, const FunctionDef& func,
   }
 
   // TODO(ezhulenev): Push down known input shapes.
-  FunctionDef specialized_func;
-  TF_RETURN_IF_ERROR(MakeFunctionDef(item, flib, &specialized_func));
+  TF_RETURN_IF_ERROR(MakeFunctionDef(item, flib, specialized_func));
 
   // Find a name for specialized function.
   const string specialized_func_name =
-      SpecializedFunctionName(*ctx, func, func_node);
+      SpecializedFunctionName(ctx, func, func_node);
   if (flib.Contains(specialized_func_name)) {
     // NOTE(ezhulenev): This should never happen. If it happens, it's a sign of
     // a serious internal error, that must be investigated.
     return errors::Internal("Created duplicate function specialization");
   }
 
-  specialized_func.mutable_signature()->set_name(specialized_func_name);
-  auto* specialized_attr = specialized_func.mutable_attr();
+  specialized_func->mutable_signature()->set_name(specialized_func_name);
+  auto* specialized_attr = specialized_func->mutable_attr();
   (*specialized_attr)[kGrapplerSpecializedFuncAttr].set_b(true);
 
-  // Add specialized function to the library.
-  TF_RETURN_IF_ERROR(ctx->function_library().AddFunctionDef(specialized_func));
-
-  // Add a function call node for the specialized function.
-  NodeDef* specialized_func_node = optimized_graph->add_node();
-  *specialized_func_node = func_node;
-
-  FunctionSpecialization func_specialization = {
-      specialized_func_name, signature.is_in_fetch_set, const_inputs,
-      control_deps,          signature.active_outputs,  output_mapping};
-
-  TF_RETURN_IF_ERROR(UpdateSpecializedFunctionNode(
-      func, func_node, func_specialization, specialized_func_node));
-
-  ctx->AddSpecializedFunction(signature, func_specialization);
-  ctx->AddTensorMapping(specialized_func_node->name(), func_specialization);
+  *specialization = {specialized_func_name, signature.is_in_fetch_set,
+                     const_inputs,          control_deps,
+                     signature.active_outputs, output_mapping};
 
   return OkStatus();
 }
@@ -1450,25 +1407,35 @@ Status FunctionOptimizer::RunFunctionOptimizerPass(
   // Specialize function calls that we could not inline.
   FunctionOptimizerContext ctx(item, opt_level_, graph_after_inlining);
 
-  for (const NodeDef& node : graph_after_inlining.node()) {
-    // Function specialization can modify optimized graph only by adding new
-    // nodes, we can check node size to make sure that graph was not modified.
-    const int num_nodes_before = optimized_graph->node_size();
-    const auto is_graph_modified = [&]() {
-      int num_nodes = optimized_graph->node_size();
-      DCHECK_GE(num_nodes, num_nodes_before) << "Nodes should not be removed";
-      return num_nodes > num_nodes_before;
-    };
+  // Building a specialized function body only reads from the context and the
+  // function library, so instantiations with distinct signatures can be
+  // specialized concurrently. Collect one specialization task per unique
+  // signature, run the tasks on a thread pool, and then merge the results
+  // into the function library and the optimized graph serially to keep the
+  // output deterministic.
+  struct SpecializationTask {
+    const NodeDef* func_node;  // first instantiation with this signature
+    const FunctionDef* func;
+    FunctionSpecializationSignature signature;
+    FunctionDef specialized_func;
+    FunctionSpecialization specialization;
+    Status status;
+    bool added_to_library = false;
+  };
 
-    // Copy node from the `graph_after_inlining` to the `optimized_graph`.
-    const auto copy_node = [&]() { *optimized_graph->add_node() = node; };
+  const int num_nodes = graph_after_inlining.node_size();
+  // Index of the specialization task for each node; -1 for nodes that are
+  // copied to the optimized graph unchanged.
+  std::vector<int> task_index(num_nodes, -1);
+  std::vector<SpecializationTask> tasks;
+  absl::flat_hash_map<FunctionSpecializationSignature, int> signature_to_task;
+
+  for (int i = 0; i < num_nodes; ++i) {
+    const NodeDef& node = graph_after_inlining.node(i);
 
     // Find if a node is a function call (direct or indirect).
     const FunctionDef* func = FindFunctionCall(ctx, node);
-    if (func == nullptr) {
-      copy_node();
-      continue;
-    }
+    if (func == nullptr) continue;
 
     const string& func_name = func->signature().name();
 
@@ -1484,21 +1451,88 @@ Status FunctionOptimizer::RunFunctionOptimizerPass(
         !grad_func.empty() || ctx.IsFeedNode(node.name()) ||
         MarkedNoSpecialize(*func) || MarkedForXlaCompilation(node);
 
-    if (specialization_worthy && !no_specialize) {
-      // TODO(ezhulenev): Specialize function call if input has a known shape.
-      // Specialize function body for its instantiation attributes and inputs.
-      Status status = SpecializeFunction(node, *func, &ctx, optimized_graph);
-      if (!status.ok() && is_graph_modified()) {
-        return status;
-      } else if (!status.ok() && !is_graph_modified()) {
-        VLOG(3) << "Skip specialization error: " << status.error_message();
-        copy_node();
-      }
+    if (!specialization_worthy || no_specialize) {
+      VLOG(2) << "Skip function specialization: " << func_name;
       continue;
-    } else {
-      VLOG(2) << "Skip function specialization: " << func->signature().name();
+    }
+
+    FunctionSpecializationSignature signature;
+    Status sig_status = InitializeFunctionSpecializationSignature(
+        node, *func, FunctionInstantiationAttributes(*func, node), ctx,
+        &signature);
+    if (!sig_status.ok()) {
+      VLOG(3) << "Skip specialization error: " << sig_status.error_message();
+      continue;
+    }
+
+    // Instantiations with identical signatures share one specialization.
+    auto it = signature_to_task.find(signature);
+    if (it == signature_to_task.end()) {
+      it = signature_to_task.emplace(signature, tasks.size()).first;
+      tasks.push_back(SpecializationTask{&node, func, std::move(signature)});
+    }
+    task_index[i] = it->second;
+  }
+
+  // TODO(ezhulenev): Specialize function call if input has a known shape.
+  // Specialize function bodies for their instantiation attributes and inputs.
+  const auto run_task = [&ctx](SpecializationTask* task) {
+    task->status = MakeFunctionSpecialization(
+        *task->func_node, *task->func, task->signature, ctx,
+        &task->specialized_func, &task->specialization);
+  };
+  if (tasks.size() > 1) {
+    thread::ThreadPool pool(
+        Env::Default(), "function_specialization",
+        std::min<int>(tasks.size(), port::NumSchedulableCPUs()));
+    for (SpecializationTask& task : tasks) {
+      pool.Schedule([&run_task, &task]() { run_task(&task); });
+    }
+    // The thread pool destructor waits for all scheduled tasks.
+  } else {
+    for (SpecializationTask& task : tasks) run_task(&task);
+  }
+
+  // Merge the specialized functions into the library and build the optimized
+  // graph, preserving the original node order.
+  for (int i = 0; i < num_nodes; ++i) {
+    const NodeDef& node = graph_after_inlining.node(i);
+
+    // Copy node from the `graph_after_inlining` to the `optimized_graph`.
+    const auto copy_node = [&]() { *optimized_graph->add_node() = node; };
+
+    if (task_index[i] < 0) {
+      copy_node();
+      continue;
+    }
+
+    SpecializationTask& task = tasks[task_index[i]];
+    if (!task.status.ok()) {
+      VLOG(3) << "Skip specialization error: " << task.status.error_message();
       copy_node();
+      continue;
+    }
+
+    if (!task.added_to_library) {
+      // Add the new specialized function definition to the library.
+      Status added = ctx.function_library().AddFunctionDef(task.specialized_func);
+      if (!added.ok()) {
+        VLOG(3) << "Skip specialization error: " << added.error_message();
+        task.status = added;
+        copy_node();
+        continue;
+      }
+      task.added_to_library = true;
     }
+
+    // Add a function call node for the specialized function.
+    NodeDef* specialized_func_node = optimized_graph->add_node();
+    *specialized_func_node = node;
+
+    TF_RETURN_IF_ERROR(UpdateSpecializedFunctionNode(
+        *task.func, node, task.specialization, specialized_func_node));
+
+    ctx.AddTensorMapping(specialized_func_node->name(), task.specialization);
   }
 
   RestoreTensorMapping(ctx, optimized_graph);
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/generic_layout_optimizer.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
@@ -24,11 +26,14 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/costs/op_level_cost_estimator.h"
+#include "tensorflow/core/grappler/costs/utils.h"
 #include "tensorflow/core/grappler/grappler_item.h"
 #include "tensorflow/core/grappler/op_types.h"
 #include "tensorflow/core/grappler/optimizers/generic_layout_optimizer_transposer.h"
 #include "tensorflow/core/grappler/optimizers/generic_layout_optimizer_transposer_factory.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -124,6 +129,249 @@ inline std::pair<string, string> GetSrcAndDstDataFormats(
   return {src_format, dst_format};
 }
 
+// When enabled, layout conversion is decided per region of connected layout
+// sensitive nodes, based on the cost of the transposes the conversion would
+// insert at the region boundaries.
+constexpr char kSelectiveLayoutEnvVar[] = "TF_GRAPPLER_SELECTIVE_LAYOUT";
+// Fraction of a region's compute cost that boundary transposes may add before
+// converting the region is considered unprofitable.
+constexpr double kMaxTransposeToComputeRatio = 0.1;
+
+bool IsSelectiveLayoutEnabled() {
+  bool enabled = false;
+  ReadBoolFromEnvVar(kSelectiveLayoutEnvVar, /*default_val=*/false, &enabled)
+      .IgnoreError();
+  return enabled;
+}
+
+bool IsOnTargetDevice(const TransposeContext& context, const NodeDef& node) {
+  const string& device_name = GetDeviceName(node);
+  string device;
+  string task;
+  return DeviceNameUtils::SplitDeviceName(device_name, &task, &device) &&
+         absl::StrContains(absl::AsciiStrToLower(device),
+                           absl::AsciiStrToLower(context.target_device));
+}
+
+// Returns true if `node` is a layout sensitive op that the transposers would
+// convert from src format to dst format.
+bool IsConversionCandidate(const TransposeContext& context,
+                           const NodeDef& node) {
+  if (!IsLayoutSensitiveOp(node) || !IsOnTargetDevice(context, node)) {
+    return false;
+  }
+  const auto data_format_attr = node.attr().find("data_format");
+  const string data_format = data_format_attr != node.attr().end()
+                                 ? data_format_attr->second.s()
+                                 : kNHWC;
+  return data_format == context.src_format;
+}
+
+bool IsRank4(const OpInfo::TensorProperties& properties) {
+  return !properties.shape().unknown_rank() &&
+         properties.shape().dim_size() == 4;
+}
+
+// Returns a copy of `properties` with the shape permuted by `permutation` if
+// it has rank 4, unchanged otherwise.
+OpInfo::TensorProperties PermuteTensorProperties(
+    const OpInfo::TensorProperties& properties,
+    absl::Span<const int> permutation) {
+  OpInfo::TensorProperties permuted = properties;
+  if (IsRank4(properties)) {
+    for (int i = 0; i < 4; ++i) {
+      *permuted.mutable_shape()->mutable_dim(i) =
+          properties.shape().dim(permutation[i]);
+    }
+  }
+  return permuted;
+}
+
+// Predicts the execution time of `node` in nanoseconds, either with its
+// current data format or converted to the dst format of `context`.
+double PredictComputeTime(const TransposeContext& context,
+                          OpLevelCostEstimator* estimator, const NodeDef& node,
+                          bool in_dst_format) {
+  OpContext op_context;
+  op_context.name = node.name();
+  op_context.op_info.set_op(node.op());
+  *op_context.op_info.mutable_attr() = node.attr();
+  for (const auto& properties :
+       context.graph_properties->GetInputProperties(node.name())) {
+    *op_context.op_info.add_inputs() =
+        in_dst_format ? PermuteTensorProperties(properties, context.src_to_dst)
+                      : properties;
+  }
+  for (const auto& properties :
+       context.graph_properties->GetOutputProperties(node.name())) {
+    *op_context.op_info.add_outputs() =
+        in_dst_format ? PermuteTensorProperties(properties, context.src_to_dst)
+                      : properties;
+  }
+  if (in_dst_format) {
+    (*op_context.op_info.mutable_attr())["data_format"].set_s(
+        context.dst_format);
+  }
+  *op_context.op_info.mutable_device() = GetDeviceInfo(node.device());
+  return static_cast<double>(
+      estimator->PredictCosts(op_context).execution_time.count());
+}
+
+// Predicts the execution time in nanoseconds of transposing a tensor with
+// `properties` on `device`.
+double PredictTransposeTime(const TransposeContext& context,
+                            OpLevelCostEstimator* estimator,
+                            const OpInfo::TensorProperties& properties,
+                            const string& device) {
+  OpContext op_context;
+  op_context.op_info.set_op("Transpose");
+  *op_context.op_info.add_inputs() = properties;
+  OpInfo::TensorProperties perm_properties;
+  perm_properties.set_dtype(DT_INT32);
+  perm_properties.mutable_shape()->add_dim()->set_size(4);
+  *op_context.op_info.add_inputs() = perm_properties;
+  *op_context.op_info.add_outputs() =
+      PermuteTensorProperties(properties, context.src_to_dst);
+  *op_context.op_info.mutable_device() = GetDeviceInfo(device);
+  return static_cast<double>(
+      estimator->PredictCosts(op_context).execution_time.count());
+}
+
+// Decides per region of connected layout sensitive nodes whether converting
+// it to the dst format pays for the transposes inserted at the region
+// boundaries, and records the regions to keep in src format in
+// context->nodes_to_skip. Regions are grown through layout agnostic nodes
+// since those are absorbed by the expansion pass and don't materialize
+// transposes on interior edges; this slightly overestimates how far a region
+// extends and therefore errs towards converting. The decision trace is
+// logged with VLOG(1).
+Status AssignLayoutsByCost(TransposeContext* context) {
+  utils::MutableGraphView* graph_view = context->graph_view.get();
+  const int num_nodes = context->num_nodes;
+
+  std::vector<bool> is_sensitive(num_nodes, false);
+  std::vector<bool> is_conductive(num_nodes, false);
+  for (int i = 0; i < num_nodes; ++i) {
+    const NodeDef& node = *graph_view->GetNode(i)->node();
+    if (IsConversionCandidate(*context, node)) {
+      is_sensitive[i] = true;
+    } else if (IsLayoutAgnosticOp(node) && IsOnTargetDevice(*context, node)) {
+      is_conductive[i] = true;
+    }
+  }
+
+  OpLevelCostEstimator estimator;
+  std::vector<int> region_id(num_nodes, -1);
+  int num_regions = 0;
+  for (int i = 0; i < num_nodes; ++i) {
+    if (!is_sensitive[i] || region_id[i] != -1) {
+      continue;
+    }
+    const int region = num_regions++;
+    std::vector<int> members;
+    std::vector<int> stack = {i};
+    region_id[i] = region;
+    while (!stack.empty()) {
+      const int member = stack.back();
+      stack.pop_back();
+      members.push_back(member);
+      auto* member_view = graph_view->GetNode(member);
+      const int num_fanins = member_view->NumRegularFanins();
+      for (int p = 0; p < num_fanins; ++p) {
+        const int fanin = member_view->GetRegularFanin(p).node_index();
+        if (fanin < num_nodes && region_id[fanin] == -1 &&
+            (is_sensitive[fanin] || is_conductive[fanin])) {
+          region_id[fanin] = region;
+          stack.push_back(fanin);
+        }
+      }
+      for (const auto& fanouts_port : member_view->GetRegularFanouts()) {
+        for (const auto& fanout : fanouts_port) {
+          const int fanout_index = fanout.node_index();
+          if (fanout_index < num_nodes && region_id[fanout_index] == -1 &&
+              (is_sensitive[fanout_index] || is_conductive[fanout_index])) {
+            region_id[fanout_index] = region;
+            stack.push_back(fanout_index);
+          }
+        }
+      }
+    }
+
+    // Price the conversion of the region: the compute time of the layout
+    // sensitive nodes in both formats, and a transpose for every rank 4
+    // tensor crossing the region boundary.
+    int num_sensitive = 0;
+    double src_compute_ns = 0.0;
+    double dst_compute_ns = 0.0;
+    double boundary_transpose_ns = 0.0;
+    for (const int member : members) {
+      auto* member_view = graph_view->GetNode(member);
+      const NodeDef& node = *member_view->node();
+      if (is_sensitive[member]) {
+        ++num_sensitive;
+        src_compute_ns += PredictComputeTime(*context, &estimator, node,
+                                             /*in_dst_format=*/false);
+        dst_compute_ns += PredictComputeTime(*context, &estimator, node,
+                                             /*in_dst_format=*/true);
+      }
+      const auto& input_properties =
+          context->graph_properties->GetInputProperties(node.name());
+      const int num_fanins = std::min(member_view->NumRegularFanins(),
+                                      static_cast<int>(input_properties.size()));
+      for (int p = 0; p < num_fanins; ++p) {
+        const int fanin = member_view->GetRegularFanin(p).node_index();
+        if (fanin < num_nodes && region_id[fanin] == region) {
+          continue;
+        }
+        if (IsRank4(input_properties[p])) {
+          boundary_transpose_ns += PredictTransposeTime(
+              *context, &estimator, input_properties[p], node.device());
+        }
+      }
+      const auto& output_properties =
+          context->graph_properties->GetOutputProperties(node.name());
+      const auto& fanouts = member_view->GetRegularFanouts();
+      const int num_fanout_ports =
+          std::min(static_cast<int>(fanouts.size()),
+                   static_cast<int>(output_properties.size()));
+      for (int p = 0; p < num_fanout_ports; ++p) {
+        if (!IsRank4(output_properties[p])) {
+          continue;
+        }
+        for (const auto& fanout : fanouts[p]) {
+          const int fanout_index = fanout.node_index();
+          if (fanout_index >= num_nodes || region_id[fanout_index] != region) {
+            boundary_transpose_ns += PredictTransposeTime(
+                *context, &estimator, output_properties[p], node.device());
+            break;
+          }
+        }
+      }
+    }
+
+    const bool convert =
+        dst_compute_ns + boundary_transpose_ns <=
+        src_compute_ns * (1.0 + kMaxTransposeToComputeRatio);
+    if (!convert) {
+      for (const int member : members) {
+        if (is_sensitive[member]) {
+          context->nodes_to_skip.insert(
+              graph_view->GetNode(member)->GetName());
+        }
+      }
+    }
+    VLOG(1) << "Selective layout: region #" << region << " anchored at '"
+            << graph_view->GetNode(i)->GetName() << "' with " << num_sensitive
+            << " layout sensitive node(s), compute " << context->src_format
+            << "=" << src_compute_ns << "ns " << context->dst_format << "="
+            << dst_compute_ns << "ns, boundary transposes="
+            << boundary_transpose_ns << "ns -> "
+            << (convert ? "converting to " : "keeping ")
+            << (convert ? context->dst_format : context->src_format);
+  }
+  return OkStatus();
+}
+
 Status ExpandLayoutSensitiveOp(TransposeContext* context,
                                TransposerFactory* transposer_factory) {
   const int num_nodes = context->num_nodes;
@@ -458,6 +706,10 @@ Status GenericLayoutOptimizer::Optimize(Cluster* cluster,
     }
   }
 
+  if (IsSelectiveLayoutEnabled()) {
+    TF_RETURN_IF_ERROR(AssignLayoutsByCost(&context));
+  }
+
   TransposerFactory transposer_factory;
   TF_RETURN_IF_ERROR(ExpandLayoutSensitiveOp(&context, &transposer_factory));
   if (context.graph.node_size() > context.num_nodes || is_aggressive) {
@@ -339,6 +339,43 @@ TEST_F(GenericLayoutOptimizerTest, CPUDevice) {
 #endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
 }
 
+TEST_F(GenericLayoutOptimizerTest, SelectiveLayoutSkipsUnprofitableRegion) {
+  // A lone, memory bound MaxPool: the transposes a conversion would insert
+  // around it cost about as much as the op itself, so the cost analysis must
+  // keep the node in the source format.
+  Scope scope = Scope::NewRootScope();
+  TensorShape input_shape(DIMS(8, 32, 32, 16));
+  Tensor input_data(DT_FLOAT, input_shape);
+  test::FillIota<float>(&input_data, 1.0f);
+  Output input =
+      ops::Const(scope.WithOpName("Input"), Input::Initializer(input_data));
+  Output maxpool =
+      ops::MaxPool(scope.WithOpName("MaxPool").WithDevice(
+                       absl::StrCat("/device:", DEVICE, ":0")),
+                   input, DIMS(1, 2, 2, 1), DIMS(1, 2, 2, 1), "VALID",
+                   ops::MaxPool::Attrs().DataFormat(SRC_DATA_FORMAT));
+  Output fetch = ops::Identity(scope.WithOpName("Fetch"), maxpool);
+  GrapplerItem item;
+  TF_ASSERT_OK(scope.ToGraphDef(&item.graph));
+
+  setenv("TF_GRAPPLER_SELECTIVE_LAYOUT", "1", 1 /* overwrite */);
+  GenericLayoutOptimizer optimizer(REWRITER_CONFIG);
+  GraphDef output;
+  Status optimize_status =
+      optimizer.Optimize(virtual_cluster_.get(), item, &output);
+  unsetenv("TF_GRAPPLER_SELECTIVE_LAYOUT");
+  TF_ASSERT_OK(optimize_status);
+
+  Status status;
+  utils::GraphView graph_view(&output, &status);
+  TF_ASSERT_OK(status);
+  auto* maxpool_node = graph_view.GetNode("MaxPool");
+  ASSERT_NE(maxpool_node, nullptr);
+  VerifyDataFormatAttributeMatch(maxpool_node, SRC_DATA_FORMAT);
+  // No transpose pair was inserted around the node.
+  EXPECT_EQ(output.node_size(), item.graph.node_size());
+}
+
 TEST_F(GenericLayoutOptimizerTest, NoOptimizeIntegerConvolution) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   auto conv = SimpleConv2D<int32>(&s, 4, 2, "VALID", "");
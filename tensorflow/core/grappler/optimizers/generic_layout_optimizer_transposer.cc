@@ -279,6 +279,7 @@ bool Transposer::ShouldProcess(const TransposeContext& context,
 
   return is_on_target_device && data_format_match && !is_integer_conv2d &&
          !context.nodes_to_preserve.contains(node_def->name()) &&
+         !context.nodes_to_skip.contains(node_def->name()) &&
          !(node.NumRegularFanouts() == 0 && node.NumControlledFanouts() == 0);
 }
 
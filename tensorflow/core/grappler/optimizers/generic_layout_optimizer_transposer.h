@@ -73,6 +73,10 @@ struct TransposeContext {
   // to this.
   int num_nodes;
   absl::flat_hash_set<string> nodes_to_preserve;
+  // Layout sensitive nodes to keep in src format because converting them was
+  // deemed unprofitable, e.g. by a cost analysis of the transposes that the
+  // conversion would introduce.
+  absl::flat_hash_set<string> nodes_to_skip;
   std::unique_ptr<GraphProperties> graph_properties;
   std::unique_ptr<utils::MutableGraphView> graph_view;
 
@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/clusters/virtual_cluster.h"
 #include "tensorflow/core/grappler/costs/graph_memory.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
+#include "tensorflow/core/grappler/costs/op_level_cost_estimator.h"
 #include "tensorflow/core/grappler/costs/utils.h"
 #include "tensorflow/core/grappler/graph_topology_view.h"
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -43,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -166,6 +168,127 @@ struct RecomputedSubGraph {
   std::unordered_set<NodeDef*> target_nodes;
 };
 
+// Per-session memory budget (in bytes) for the budget-driven recomputation
+// planner; 0 disables the planner and keeps the op-list heuristics.
+int64_t RecomputationMemoryBudget() {
+  int64_t budget_mb;
+  Status status = ReadInt64FromEnvVar(
+      "TF_GRAPPLER_RECOMPUTATION_MEMORY_BUDGET_MB", 0, &budget_mb);
+  if (!status.ok()) {
+    LOG(WARNING) << status.error_message();
+    return 0;
+  }
+  return budget_mb * (1LL << 20);
+}
+
+// Selects recomputation candidates to bring peak memory under `memory_budget`
+// with minimal added runtime. Candidates are ranked by bytes freed per
+// nanosecond of recomputation (estimated with GraphMemory and
+// OpLevelCostEstimator) and chosen greedily until the projected savings cover
+// the budget overshoot. This is a fast heuristic for the underlying
+// min-runtime-under-memory-budget problem; solving it exactly requires an ILP
+// solver that we do not want to depend on here.
+//
+// Returns false if memory or shape inference failed, in which case the caller
+// should fall back to the op-list heuristics. On success `planned` holds the
+// selected nodes; it is empty if the graph already fits the budget.
+bool PlanBudgetedRecomputation(
+    Cluster* cluster, const GrapplerItem& item, const GraphDef* graph,
+    const NodeMap& node_map, const std::function<bool(const NodeDef&)>& is_target,
+    const std::unordered_set<string>& feeds, int64_t memory_budget,
+    std::unordered_set<const NodeDef*>* planned) {
+  planned->clear();
+
+  GrapplerItem planning_item = item.WithGraph(GraphDef(*graph));
+  GraphMemory memory(planning_item);
+  Status status = memory.InferStatically(cluster->GetDevices());
+  if (!status.ok()) {
+    VLOG(1) << "Failed to infer memory usage: " << status.error_message();
+    return false;
+  }
+
+  int64_t peak_memory = 0;
+  for (const auto& device : cluster->GetDevices()) {
+    const GraphMemory::MemoryUsage& mem_usage =
+        memory.GetPeakMemoryUsage(device.first);
+    peak_memory = std::max(peak_memory, mem_usage.used_memory);
+  }
+  if (peak_memory <= memory_budget) {
+    VLOG(1) << "Peak memory usage " << peak_memory
+            << " is already under the recomputation budget " << memory_budget;
+    return true;
+  }
+  const int64_t bytes_to_save = peak_memory - memory_budget;
+
+  GraphProperties properties(planning_item);
+  status = properties.InferStatically(/*assume_valid_feeds=*/false,
+                                      /*aggressive_shape_inference=*/false,
+                                      /*include_tensor_values=*/false);
+  if (!status.ok()) {
+    VLOG(1) << "Failed to infer shapes: " << status.error_message();
+    return false;
+  }
+
+  // Rank every side-effect free forward node feeding a target by the bytes its
+  // outputs occupy per nanosecond it takes to recompute them.
+  struct Candidate {
+    const NodeDef* node;
+    int64_t bytes;
+    double bytes_per_ns;
+  };
+  OpLevelCostEstimator cost_estimator;
+  std::vector<Candidate> candidates;
+  for (const NodeDef& node : graph->node()) {
+    if (is_target(node) || feeds.count(node.name()) > 0 ||
+        !IsFreeOfSideEffect(node) || IsConstant(node)) {
+      continue;
+    }
+    if (!properties.HasOutputProperties(node.name())) continue;
+
+    const auto& output_properties = properties.GetOutputProperties(node.name());
+    int64_t bytes = 0;
+    for (const auto& output_property : output_properties) {
+      bytes += CalculateTensorSize(output_property);
+    }
+    if (bytes <= 0) continue;
+
+    OpContext op_context;
+    op_context.op_info.set_op(node.op());
+    *op_context.op_info.mutable_attr() = node.attr();
+    for (const auto& input_property :
+         properties.GetInputProperties(node.name())) {
+      *op_context.op_info.add_inputs() = input_property;
+    }
+    for (const auto& output_property : output_properties) {
+      *op_context.op_info.add_outputs() = output_property;
+    }
+    *op_context.op_info.mutable_device() = GetDeviceInfo(node.device());
+    const Costs costs = cost_estimator.PredictCosts(op_context);
+    const double recompute_ns =
+        std::max<double>(static_cast<double>(costs.execution_time.count()), 1.0);
+
+    candidates.push_back({&node, bytes, bytes / recompute_ns});
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& first, const Candidate& second) {
+              return first.bytes_per_ns > second.bytes_per_ns ||
+                     (first.bytes_per_ns == second.bytes_per_ns &&
+                      first.node->name() < second.node->name());
+            });
+
+  int64_t planned_bytes = 0;
+  for (const Candidate& candidate : candidates) {
+    if (planned_bytes >= bytes_to_save) break;
+    planned->insert(candidate.node);
+    planned_bytes += candidate.bytes;
+  }
+  VLOG(1) << "Budgeted recomputation planner selected " << planned->size()
+          << " candidate nodes to save " << planned_bytes << " of "
+          << bytes_to_save << " bytes over budget";
+  return true;
+}
+
 // Find groups of ops to recompute together based on `should_recompute`.
 std::vector<RecomputedSubGraph> GetOpGroupsToRecompute(
     const GraphDef* graph, const NodeMap& node_map,
@@ -442,7 +565,8 @@ void RecomputeSubgraph(
 
 void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
                                 const string& recomputation_targets_name_scope,
-                                GraphDef* graph, const GrapplerItem& item) {
+                                GraphDef* graph, const GrapplerItem& item,
+                                Cluster* cluster) {
   // The topological numberings and NodeMap will be stale as soon as we start
   // modifying the graph in RecomputeSubgraph. However, RecomputeSubgraph only
   // looks up nodes which were in the original graph, and preserves the graph
@@ -472,8 +596,28 @@ void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
                    "/" + recomputation_targets_name_scope)) != -1;
       };
 
-  if (optimization_level == RewriterConfig::RECOMPUTATION_HEURISTICS ||
-      optimization_level == RewriterConfig::HEURISTICS) {
+  // When a memory budget is set, plan recomputation against the inferred
+  // peak memory usage and per-node cost estimates instead of the op-list
+  // heuristics. Falls back to the heuristics below if inference fails.
+  std::unordered_set<const NodeDef*> planned;
+  bool use_budgeted_plan = false;
+  const int64_t memory_budget = RecomputationMemoryBudget();
+  if (memory_budget > 0 && cluster != nullptr && !item.fetch.empty() &&
+      (optimization_level == RewriterConfig::RECOMPUTATION_HEURISTICS ||
+       optimization_level == RewriterConfig::HEURISTICS)) {
+    use_budgeted_plan = PlanBudgetedRecomputation(
+        cluster, item, graph, node_map, is_target, feeds, memory_budget,
+        &planned);
+  }
+
+  if (use_budgeted_plan) {
+    if (planned.empty()) return;
+    recomputed_subgraphs = GetOpGroupsToRecompute(
+        graph, node_map,
+        [&planned](const NodeDef& node) { return planned.count(&node) > 0; },
+        is_target);
+  } else if (optimization_level == RewriterConfig::RECOMPUTATION_HEURISTICS ||
+             optimization_level == RewriterConfig::HEURISTICS) {
     // TODO(allenl): Handle ResNet-like architectures better. Right now all of
     // the cheap forward ops get grouped into a single subgraph which must
     // execute before gradients start executing (unless layers are manually
@@ -1397,7 +1541,7 @@ Status MemoryOptimizer::Optimize(Cluster* cluster, const GrapplerItem& item,
   if (run_recomputation_pass) {
     RecomputationRewritingPass(optimization_level_,
                                recomputation_targets_name_scope_,
-                               &optimized_item.graph, item);
+                               &optimized_item.graph, item, cluster);
   }
 
   std::unordered_set<string> skip_list;
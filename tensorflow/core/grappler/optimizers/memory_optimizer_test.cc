@@ -201,6 +201,79 @@ TEST_F(RecomputeSubgraphTest, MultiNode) {
   EXPECT_EQ("^gradients/BN1Grad", recompute_trigger_c->input(0));
 }
 
+class RecomputeBudgetPlannerTest : public GrapplerTest {
+ protected:
+  static constexpr char kDevice[] = "/job:localhost/replica:0/task:0/cpu:0";
+
+  static std::unique_ptr<VirtualCluster> CreateVirtualCluster() {
+    DeviceProperties cpu_device;
+    cpu_device.set_type("CPU");
+    cpu_device.set_frequency(1000);
+    cpu_device.set_num_cores(4);
+    cpu_device.set_bandwidth(32);
+    cpu_device.set_memory_size(64 * 1024 * 1024);
+    std::unordered_map<string, DeviceProperties> devices;
+    devices[kDevice] = cpu_device;
+    return std::unique_ptr<VirtualCluster>(new VirtualCluster(devices));
+  }
+
+  // Forward chain with two 2MB activations feeding gradient nodes.
+  static GrapplerItem CreateItem() {
+    tensorflow::Scope s =
+        tensorflow::Scope::NewRootScope().WithDevice(kDevice);
+    Output a = ops::Variable(s.WithOpName("a"), {128, 64, 64}, DT_FLOAT);
+    Output b = ops::Relu(s.WithOpName("b"), a);  // Recomputed
+    Output c = ops::Relu(s.WithOpName("c"), b);  // Recomputed
+    Output d = ops::AddN(s.WithOpName("gradients/d"), {c});
+    Output e = ops::AddN(s.WithOpName("gradients/e"), {d, b});
+    Output f = ops::AddN(s.WithOpName("gradients/f"), {e, a});
+
+    GrapplerItem item;
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    item.fetch = {"gradients/f"};
+    return item;
+  }
+};
+
+constexpr char RecomputeBudgetPlannerTest::kDevice[];
+
+TEST_F(RecomputeBudgetPlannerTest, RecomputesOverBudget) {
+  GrapplerItem item = CreateItem();
+  std::unique_ptr<VirtualCluster> cluster(CreateVirtualCluster());
+
+  // The activations alone exceed a 1MB budget, so the planner must pick them.
+  setenv("TF_GRAPPLER_RECOMPUTATION_MEMORY_BUDGET_MB", "1", 1 /* overwrite */);
+  MemoryOptimizer optimizer(RewriterConfig::RECOMPUTATION_HEURISTICS);
+  GraphDef output;
+  Status status = optimizer.Optimize(cluster.get(), item, &output);
+  unsetenv("TF_GRAPPLER_RECOMPUTATION_MEMORY_BUDGET_MB");
+  TF_EXPECT_OK(status);
+
+  NodeMap node_map(&output);
+  EXPECT_NE(node_map.GetNode("Recomputed/b"), nullptr);
+  EXPECT_NE(node_map.GetNode("Recomputed/c"), nullptr);
+}
+
+TEST_F(RecomputeBudgetPlannerTest, NoRecomputationUnderBudget) {
+  GrapplerItem item = CreateItem();
+  std::unique_ptr<VirtualCluster> cluster(CreateVirtualCluster());
+
+  // Relu is on the cheap-to-recompute op list, but a graph that already fits
+  // the budget should be left alone.
+  setenv("TF_GRAPPLER_RECOMPUTATION_MEMORY_BUDGET_MB", "1024",
+         1 /* overwrite */);
+  MemoryOptimizer optimizer(RewriterConfig::RECOMPUTATION_HEURISTICS);
+  GraphDef output;
+  Status status = optimizer.Optimize(cluster.get(), item, &output);
+  unsetenv("TF_GRAPPLER_RECOMPUTATION_MEMORY_BUDGET_MB");
+  TF_EXPECT_OK(status);
+
+  NodeMap node_map(&output);
+  EXPECT_EQ(output.node_size(), item.graph.node_size());
+  EXPECT_EQ(node_map.GetNode("Recomputed/b"), nullptr);
+  EXPECT_EQ(node_map.GetNode("Recomputed/c"), nullptr);
+}
+
 class MemoryOptimizerTest : public GrapplerTest {
  public:
   static std::unique_ptr<VirtualCluster> CreateVirtualCluster() {
@@ -17,9 +17,13 @@ limitations under the License.
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
@@ -59,7 +63,11 @@ limitations under the License.
 #include "tensorflow/core/grappler/verifiers/structure_verifier.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/ptr_util.h"
 #include "tensorflow/core/util/util.h"
 #include "tensorflow/core/util/xla_config_registry.h"
@@ -125,6 +133,89 @@ FunctionDefLibrary GetFunctionDefLibraryStub(
   return stub;
 }
 
+// Process-wide cache of optimized function bodies, keyed by a fingerprint of
+// the function, its transitively reachable callees, the rewriter configuration
+// and the cluster devices. Periodic session/function rebuilds re-optimize a
+// library that is almost entirely unchanged; a hit replays the previous
+// optimization result instead of re-running the full optimizer pipeline over
+// the function body. Set TF_GRAPPLER_FUNCTION_OPTIMIZATION_CACHE=false to
+// disable.
+bool FunctionOptimizationCacheEnabled() {
+  static bool enabled = [] {
+    bool enabled = true;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPPLER_FUNCTION_OPTIMIZATION_CACHE",
+                                   true, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+struct OptimizedFunctionEntry {
+  FunctionDef optimized_func;
+  // Specialized functions created while optimizing the body; on a cache hit
+  // they must be re-added to the library along with the optimized function.
+  std::vector<FunctionDef> new_funcs;
+};
+
+mutex function_cache_mu(LINKER_INITIALIZED);
+auto* function_cache TF_GUARDED_BY(function_cache_mu) =
+    new absl::flat_hash_map<uint64, OptimizedFunctionEntry>();
+// Bounds the process-wide memory held by cached function bodies.
+constexpr int kMaxCachedFunctions = 512;
+
+uint64 FunctionOptimizationFingerprint(
+    const FunctionDef& func, const FunctionLibraryDefinition& flib,
+    const ConfigProto& config_proto, int graph_def_version,
+    bool allow_non_differentiable_rewrites, Cluster* cluster) {
+  uint64 h = DeterministicProtoHash64(func);
+  h = FingerprintCat64(h, DeterministicProtoHash64(config_proto));
+  h = FingerprintCat64(h, static_cast<uint64>(graph_def_version));
+  h = FingerprintCat64(h, allow_non_differentiable_rewrites ? 1 : 0);
+  if (cluster != nullptr) {
+    // Optimizers may consult cluster device properties (e.g. for layout or
+    // cost based decisions), so a different cluster must not share entries.
+    const std::map<string, DeviceProperties> ordered_devices(
+        cluster->GetDevices().begin(), cluster->GetDevices().end());
+    for (const auto& device : ordered_devices) {
+      h = FingerprintCat64(h, Fingerprint64(device.first));
+      h = FingerprintCat64(h, DeterministicProtoHash64(device.second));
+    }
+  }
+  // The optimized body also depends on everything the function may call
+  // (function optimizer inlines and specializes callees), so mix in all
+  // transitively reachable functions.
+  std::set<string> reachable;
+  std::function<void(const FunctionDef&)> visit = [&](const FunctionDef& fdef) {
+    for (const NodeDef& node : fdef.node_def()) {
+      for (const auto& attr : node.attr()) {
+        const AttrValue& attr_value = attr.second;
+        if (attr_value.has_func()) {
+          if (reachable.insert(attr_value.func().name()).second) {
+            const FunctionDef* callee = flib.Find(attr_value.func().name());
+            if (callee != nullptr) visit(*callee);
+          }
+        } else if (attr_value.has_list()) {
+          for (const NameAttrList& name_attr_list : attr_value.list().func()) {
+            if (reachable.insert(name_attr_list.name()).second) {
+              const FunctionDef* callee = flib.Find(name_attr_list.name());
+              if (callee != nullptr) visit(*callee);
+            }
+          }
+        }
+      }
+    }
+  };
+  visit(func);
+  for (const string& callee_name : reachable) {
+    h = FingerprintCat64(h, Fingerprint64(callee_name));
+    const FunctionDef* callee = flib.Find(callee_name);
+    if (callee != nullptr) {
+      h = FingerprintCat64(h, DeterministicProtoHash64(*callee));
+    }
+  }
+  return h;
+}
+
 uint64 DeadlineMicroSeconds(const RewriterConfig& cfg) {
   if (cfg.meta_optimizer_timeout_ms() <= 0) return 0;  // no deadline
   return Env::Default()->NowMicros() + cfg.meta_optimizer_timeout_ms() * 1000;
@@ -1163,6 +1254,43 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       optimize_function_library = true;
       optimized_funcs.insert(func_name);
 
+      const bool allow_non_differentiable_rewrites =
+          !differentiable_functions.contains(func_name);
+
+      // Function body optimization is deterministic given the function, its
+      // callees, the configuration and the cluster, so consult the
+      // process-wide cache before re-running the optimizer pipeline.
+      const bool use_function_cache =
+          FunctionOptimizationCacheEnabled() && !is_tpu_graph;
+      uint64 func_fingerprint = 0;
+      if (use_function_cache) {
+        func_fingerprint = FunctionOptimizationFingerprint(
+            func, flib, config_proto_, producer,
+            allow_non_differentiable_rewrites, cluster);
+        OptimizedFunctionEntry cached;
+        bool found = false;
+        {
+          mutex_lock l(function_cache_mu);
+          auto it = function_cache->find(func_fingerprint);
+          if (it != function_cache->end()) {
+            cached = it->second;
+            found = true;
+          }
+        }
+        if (found) {
+          VLOG(3) << "Reusing cached optimization result: function="
+                  << func_name;
+          for (const FunctionDef& func_def : cached.new_funcs) {
+            if (flib.Find(func_def.signature().name()) == nullptr) {
+              TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+            }
+          }
+          TF_RETURN_IF_ERROR(
+              flib.ReplaceFunction(func_name, cached.optimized_func));
+          continue;
+        }
+      }
+
       // Make a GrapplerItem from a FunctionDef.
       GrapplerFunctionItem func_item;
       TF_RETURN_IF_ERROR(
@@ -1171,7 +1299,7 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       // If we need to compute the gradient of optimized function at runtime, we
       // can't perform non-differentiable rewrites.
       func_item.optimization_options().allow_non_differentiable_rewrites =
-          !differentiable_functions.contains(func_name);
+          allow_non_differentiable_rewrites;
 
       // Device set available to the function is defined only by the runtime,
       // when we instantiate and execute the function. We can't use all devices
@@ -1221,10 +1349,12 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
       // Function body optimization might have created new specialized
       // functions for each instantiation context. Add them to the library.
+      std::vector<FunctionDef> new_funcs;
       for (const FunctionDef& func_def :
            optimized_func_graph.library().function()) {
         if (flib.Find(func_def.signature().name()) == nullptr) {
           TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+          if (use_function_cache) new_funcs.push_back(func_def);
         }
       }
 
@@ -1235,6 +1365,15 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
       // Replace optimized function with a new FunctionDef.
       TF_RETURN_IF_ERROR(flib.ReplaceFunction(func_name, optimized_func));
+
+      if (use_function_cache) {
+        mutex_lock l(function_cache_mu);
+        if (function_cache->size() >= kMaxCachedFunctions) {
+          function_cache->clear();
+        }
+        (*function_cache)[func_fingerprint] = {std::move(optimized_func),
+                                               std::move(new_funcs)};
+      }
     }
 
     // If optimized at least one function, update the graph library.
@@ -1483,24 +1483,8 @@ bool FindFusedBatchNormEx(const RemapperContext& ctx, int node_index,
     const auto* fused_batch_norm_node_def = fused_batch_norm.node();
     if (!IsFusedBatchNorm(*fused_batch_norm_node_def)) return false;
 
-    // We fuse FusedBatchNorm on GPU or oneDNN CPU.
-    if (!IsMKLEnabled() && !NodeIsOnGpu(fused_batch_norm_node_def))
-      return false;
-
     DataType t_dtype = GetDataTypeFromAttr(*fused_batch_norm_node_def, "T");
 
-    if (NodeIsOnGpu(fused_batch_norm_node_def)) {
-      // GPU supports float and half.
-      // Put this condition before check `IsMKLEnabled()` because this node
-      // should be processed when it's on GPU and oneDNN CPU is enabled.
-      if (t_dtype != DT_FLOAT && t_dtype != DT_HALF) return false;
-    } else {
-      // Bfloat16 is available only with oneDNN.
-      // Half is not available with oneDNN.
-      if (IsMKLEnabled() && t_dtype != DT_FLOAT && t_dtype != DT_BFLOAT16)
-        return false;
-    }
-
     // Get the FusedBatchNorm training mode.
     bool is_training;
     if (!GetNodeAttr(*fused_batch_norm_node_def, kIsTraining, &is_training)
@@ -1512,6 +1496,22 @@ bool FindFusedBatchNormEx(const RemapperContext& ctx, int node_index,
       return false;
     if (data_format != "NHWC" && data_format != "NCHW") return false;
 
+    if (NodeIsOnGpu(fused_batch_norm_node_def)) {
+      // GPU supports float and half.
+      // Put this condition before check `IsMKLEnabled()` because this node
+      // should be processed when it's on GPU and oneDNN CPU is enabled.
+      if (t_dtype != DT_FLOAT && t_dtype != DT_HALF) return false;
+    } else if (IsMKLEnabled()) {
+      // Bfloat16 is available only with oneDNN.
+      // Half is not available with oneDNN.
+      if (t_dtype != DT_FLOAT && t_dtype != DT_BFLOAT16) return false;
+    } else {
+      // The default CPU kernel fuses the side input and activation only in
+      // inference mode, in NHWC layout, with float data.
+      if (is_training || data_format != "NHWC" || t_dtype != DT_FLOAT)
+        return false;
+    }
+
     // In training mode we rely on cuDNN for computing FusedBatchNorm with side
     // inputs and activation, and it has its own limitations. In inference mode
     // we have a custom CUDA kernel that doesn't not have these constraints.
@@ -1563,8 +1563,9 @@ bool FindFusedBatchNormEx(const RemapperContext& ctx, int node_index,
 
   // Input to a Relu can be an Add node with FusedBatchNorm as one of the inputs
   if (IsAdd(*relu_fanin_0_node_def)) {
-    // Currently no CPU implementation for "FusedBatchNorm + SideInput +
-    // <Activation>""
+    // Currently no oneDNN CPU implementation for "FusedBatchNorm + SideInput
+    // + <Activation>". The default CPU kernel supports it in inference mode,
+    // which `valid_batch_norm` checks below.
     if (IsMKLEnabled() && !NodeIsOnGpu(node_def)) return false;
 
     // Check that only Relu node consumes the output of an Add node.
@@ -1886,6 +1887,123 @@ bool FindFusedBatchMatMul(RemapperContext* ctx, int node_index,
   return found_op_type_match;
 }
 
+// Attention blocks compute Softmax(QK^T * scale + mask); when the scale and
+// mask cannot be folded into the batched matmul as post ops (e.g. a full
+// [batch, heads, seq, seq] mask, or builds without oneDNN), the Mul and AddV2
+// still materialize a full intermediate each per attention head. Fuse
+// Mul(scale) + AddV2(mask) + Softmax into a single _ScaledMaskedSoftmax op.
+bool FindScaledMaskedSoftmax(RemapperContext* ctx, int node_index,
+                             std::map<string, int>* matched_nodes_map,
+                             std::set<int>* remove_node_indices) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+  // clang-format off
+  utils::OpTypePattern fusion_pattern1 =
+    {"Softmax", "softmax", NodeStatus::kReplace,
+      {
+        {"AddV2", "mask_add", NodeStatus::kRemove,
+          {
+            {"Mul", "scale_mul", NodeStatus::kRemove,
+              {
+                {"*", "input", NodeStatus::kRemain},
+                {"*", "scale", NodeStatus::kRemain}
+              }
+            },
+            {"*", "mask", NodeStatus::kRemain}
+          }
+        }
+      }
+    };
+
+  utils::OpTypePattern fusion_pattern2 =
+    {"Softmax", "softmax", NodeStatus::kReplace,
+      {
+        {"AddV2", "mask_add", NodeStatus::kRemove,
+          {
+            {"*", "mask", NodeStatus::kRemain},
+            {"Mul", "scale_mul", NodeStatus::kRemove,
+              {
+                {"*", "input", NodeStatus::kRemain},
+                {"*", "scale", NodeStatus::kRemain}
+              }
+            }
+          }
+        }
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  bool found_op_type_match = false;
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  found_op_type_match =
+      graph_matcher.GetMatchedNodes(fusion_pattern1, ctx->nodes_to_preserve,
+                                    ctx->graph_view.GetNode(node_index),
+                                    matched_nodes_map, remove_node_indices);
+
+  if (!found_op_type_match) {
+    matched_nodes_map->clear();
+    remove_node_indices->clear();
+    found_op_type_match =
+        graph_matcher.GetMatchedNodes(fusion_pattern2, ctx->nodes_to_preserve,
+                                      ctx->graph_view.GetNode(node_index),
+                                      matched_nodes_map, remove_node_indices);
+  }
+  if (!found_op_type_match) return false;
+
+  // The CPU kernel supports float and bfloat16 on 4D tensors only.
+  NodeDef* softmax_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("softmax"))->node();
+  if (!NodeIsOnCpu(softmax_node_def)) return false;
+  DataType dtype = GetDataTypeFromAttr(*softmax_node_def, "T");
+  if (dtype != DT_FLOAT && dtype != DT_BFLOAT16) return false;
+
+  if (!ctx->inferred_graph_properties) {
+    Status s = ctx->graph_properties.InferStatically(
+        /*assume_valid_feeds=*/true,
+        /*aggressive_shape_inference=*/false,
+        /*include_input_tensor_values=*/false,
+        /*include_output_tensor_values=*/true);
+    if (!s.ok()) return false;
+    ctx->inferred_graph_properties = true;
+  }
+
+  // The Mul operands are matched positionally; whichever one is a scalar is
+  // the scale.
+  const auto output_props = [&](const string& label) {
+    NodeDef* node_def =
+        ctx->graph_view.GetNode(matched_nodes_map->at(label))->node();
+    return ctx->graph_properties.GetOutputProperties(node_def->name());
+  };
+  auto input_props = output_props("input");
+  auto scale_props = output_props("scale");
+  if (input_props.empty() || scale_props.empty()) return false;
+  if (NumCoefficients(scale_props[0].shape()) != 1) {
+    if (NumCoefficients(input_props[0].shape()) != 1) return false;
+    std::swap(matched_nodes_map->at("input"), matched_nodes_map->at("scale"));
+    std::swap(input_props, scale_props);
+  }
+
+  // Softmax runs over the innermost dimension; the kernel requires the
+  // canonical 4D attention logits, and a mask that broadcasts onto them
+  // without expanding the output.
+  auto logits_shape = input_props[0].shape();
+  if (Rank(logits_shape) != 4) return false;
+  auto mask_props = output_props("mask");
+  if (mask_props.empty()) return false;
+  auto mask_shape = mask_props[0].shape();
+  if (Rank(mask_shape) != 4) return false;
+  for (int i = 0; i < 4; ++i) {
+    const auto mask_dim = mask_shape.dim(i).size();
+    const auto logits_dim = logits_shape.dim(i).size();
+    if (mask_dim < 0 || logits_dim < 0) return false;
+    if (mask_dim != logits_dim && mask_dim != 1) return false;
+  }
+  return found_op_type_match;
+}
+
 void CopyConv2DAttributes(const NodeDef& conv2d, NodeDef* fused_conv2d,
                           const NodeDef* activation = nullptr) {
   DCHECK(IsConv2D(conv2d)) << "Input node must be a Conv2D";
@@ -2946,6 +3064,43 @@ Status AddFusedBatchMatMul(RemapperContext* ctx,
   return OkStatus();
 }
 
+Status AddScaledMaskedSoftmax(RemapperContext* ctx,
+                              const std::map<string, int>& matched_nodes_map,
+                              const std::set<int>& remove_node_indices,
+                              std::vector<bool>* invalidated_nodes,
+                              std::vector<bool>* nodes_to_delete) {
+  auto* softmax_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("softmax"))->node();
+  auto* input_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("input"))->node();
+  auto* scale_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("scale"))->node();
+  auto* mask_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("mask"))->node();
+
+  NodeDef fused_node;
+  fused_node.set_name(softmax_node->name());
+  fused_node.set_op("_ScaledMaskedSoftmax");
+  fused_node.set_device(softmax_node->device());
+  fused_node.add_input(input_node->name());
+  fused_node.add_input(scale_node->name());
+  fused_node.add_input(mask_node->name());
+  auto* attr = fused_node.mutable_attr();
+  (*attr)["T"] = softmax_node->attr().at("T");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("softmax")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return OkStatus();
+}
+
 // This function supports below patterns that require inferred
 // shapes:
 // 1. Contraction + Add.
@@ -3340,6 +3495,18 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       }
     }
 
+    // Remap Mul(scale)+AddV2(mask)+Softmax into the _ScaledMaskedSoftmax.
+    std::map<string, int> softmax_matched_nodes_map;
+    std::set<int> softmax_remove_node_indices;
+    if (allow_non_differentiable_rewrites &&
+        FindScaledMaskedSoftmax(&ctx, i, &softmax_matched_nodes_map,
+                                &softmax_remove_node_indices)) {
+      TF_RETURN_IF_ERROR(AddScaledMaskedSoftmax(
+          &ctx, softmax_matched_nodes_map, softmax_remove_node_indices,
+          &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
     // Remap {Conv2D,DepthwiseConv2D,MatMul}+BiasAdd into the
     // _Fused{Conv2D,DepthwiseConv2dNative,MatMul}
     ContractionWithBiasAdd contract_with_bias;
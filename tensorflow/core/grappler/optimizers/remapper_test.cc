@@ -2344,5 +2344,58 @@ TEST_F(RemapperFusePadWithFusedConv3D, FusedConv3D_BF16) {
 }
 #endif
 
+TEST_F(RemapperTest, FuseScaledMaskedSoftmax) {
+  using ::tensorflow::ops::Placeholder;
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto logits_shape = ops::Placeholder::Shape({2, 4, 8, 8});
+  auto mask_shape = ops::Placeholder::Shape({2, 1, 8, 8});
+
+  auto logits = Placeholder(s.WithOpName("logits"), DT_FLOAT, logits_shape);
+  auto mask = Placeholder(s.WithOpName("mask"), DT_FLOAT, mask_shape);
+  auto scale = ops::Const(s.WithOpName("scale"), 0.125f, {});
+
+  auto scale_mul = ops::Mul(s.WithOpName("scale_mul"), logits, scale);
+  auto mask_add = ops::AddV2(s.WithOpName("mask_add"), scale_mul, mask);
+  auto softmax = ops::Softmax(s.WithOpName("softmax"), mask_add);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), softmax);
+
+  auto logits_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 4, 8, 8});
+  auto mask_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 1, 8, 8});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"logits", logits_t}, {"mask", mask_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "softmax") {
+      EXPECT_EQ(node.op(), "_ScaledMaskedSoftmax");
+      ASSERT_EQ(node.input_size(), 3);
+      EXPECT_EQ(node.input(0), "logits");
+      EXPECT_EQ(node.input(1), "scale");
+      EXPECT_EQ(node.input(2), "mask");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 1);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+}
+
 }  // namespace grappler
 }  // namespace tensorflow
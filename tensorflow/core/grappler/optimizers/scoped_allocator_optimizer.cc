@@ -19,6 +19,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -506,11 +507,13 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
   }
 
   // Build the ScopedAllocator node that will be assigned to allocate
-  // the output tensors of the input node set.
+  // the output tensors of the input node set.  `expected_call_count` is the
+  // number of tensors that will be allocated from the backing tensor,
+  // i.e. the number of entries in `input_shapes`.
   Status ConstructScopedAllocatorNode(
       ScopedAllocatorOptimizer* sa_opti, GraphDef* graph, NodeMap* node_map,
-      const std::vector<NodeDef*>& ops, const string& device_name,
-      DataType dtype, int sa_id, const string& sa_name,
+      int64_t expected_call_count, const string& device_name, DataType dtype,
+      int sa_id, const string& sa_name,
       const std::vector<TensorShape>& input_shapes,
       const std::vector<InputDesc>& inputs, const TensorShape& sa_shape) {
     VLOG(2) << "ConstructScopedAllocatorNode " << sa_name;
@@ -521,7 +524,7 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
     sa_builder.Attr("id", sa_id);
     sa_builder.Attr("shapes", input_shapes);
     sa_builder.Attr("shape", sa_shape);
-    sa_builder.Attr("expected_call_count", static_cast<int64_t>(ops.size()));
+    sa_builder.Attr("expected_call_count", expected_call_count);
     NodeDef* sa_node = graph->add_node();
     LOG_WARNING_AND_RETURN_IF_ERROR(sa_builder.Finalize(sa_node));
     node_map->AddNode(sa_name, sa_node);
@@ -852,8 +855,8 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
     string sa_name =
         strings::StrCat("scoped_allocator_", sa_id, "_", invocation_count);
     TF_RETURN_IF_ERROR(ConstructScopedAllocatorNode(
-        sa_opti, graph, node_map, ops, device_name, dtype, sa_id, sa_name,
-        input_shapes, inputs, sa_shape));
+        sa_opti, graph, node_map, static_cast<int64_t>(ops.size()), device_name,
+        dtype, sa_id, sa_name, input_shapes, inputs, sa_shape));
 
     // Build a ScopedAllocatorConcat below all of the input nodes.
     std::vector<NodeDefBuilder::NodeOut> sac_inputs;
@@ -886,22 +889,326 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
   }
 };
 
+// Rewrites an axis-0 ConcatV2 into a _ScopedAllocatorConcat.  The upstream
+// ops producing the concatenated tensors are annotated to allocate their
+// outputs directly from consecutive regions of a single ScopedAllocator
+// backing tensor, so the concatenation itself becomes a zero-copy view of
+// that backing tensor.  Unlike UnaryElementwiseRewriter, which coalesces
+// multiple parallel instances of an op, this Rewriter acts on one ConcatV2
+// instance at a time.
+//
+// Derives from UnaryElementwiseRewriter in order to share the analysis and
+// ScopedAllocator construction helpers.
+class ConcatRewriter : public UnaryElementwiseRewriter {
+ public:
+  ~ConcatRewriter() override {}
+
+  int MinGroupSize() const override { return 1; }
+
+  // Everything Rewrite needs to know about one eligible ConcatV2 instance.
+  struct ConcatAnalysis {
+    DataType dtype = DT_INVALID;
+    int num_inputs = 0;
+    // Names of the data input edges, in order.  The last entry is the axis
+    // input, which is dropped by the rewrite.
+    std::vector<string> data_input_names;
+    std::vector<InputDesc> inputs;
+    std::vector<TensorShape> input_shapes;
+    TensorShape output_shape;
+  };
+
+  // Returns non-OK status if `axis_node` is not a Const holding a scalar
+  // zero (or the equivalent negative index for inputs of rank `rank`).
+  // Only an axis-0 concatenation of row-major tensors degenerates to a
+  // layout of the inputs at consecutive addresses.
+  Status CheckAxisIsZero(const NodeDef& axis_node, int rank) {
+    if (!IsConstant(axis_node)) {
+      return errors::Aborted("Concat axis ", axis_node.name(),
+                             " is not a Const op");
+    }
+    Tensor axis_tensor;
+    TF_RETURN_IF_ERROR(GetNodeAttr(AttrSlice(axis_node), "value", &axis_tensor));
+    if (axis_tensor.NumElements() != 1) {
+      return errors::Aborted("Concat axis ", axis_node.name(),
+                             " is not a scalar");
+    }
+    int64_t axis = 0;
+    if (axis_tensor.dtype() == DT_INT32) {
+      axis = axis_tensor.scalar<int32>()();
+    } else if (axis_tensor.dtype() == DT_INT64) {
+      axis = axis_tensor.scalar<int64_t>()();
+    } else {
+      return errors::Aborted("Concat axis ", axis_node.name(),
+                             " has unexpected type");
+    }
+    if (axis != 0 && axis != -rank) {
+      return errors::Aborted("Concat axis is ", axis, ", not 0");
+    }
+    return OkStatus();
+  }
+
+  // Decides whether `concat` can be replaced by a _ScopedAllocatorConcat,
+  // without modifying the graph.  On success populates *analysis.  Returns
+  // Aborted if the node is ineligible; this is expected and means the node
+  // is simply skipped.
+  Status AnalyzeConcat(ScopedAllocatorOptimizer* sa_opti, NodeDef* concat,
+                       ConcatAnalysis* analysis) {
+    CHECK(graph_properties_);
+    NodeMap* node_map = sa_opti->node_map();
+    AttrSlice n_attrs = AttrSlice(*concat);
+    TF_RETURN_IF_ERROR(GetNodeAttr(n_attrs, "T", &analysis->dtype));
+    TF_RETURN_IF_ERROR(GetNodeAttr(n_attrs, "N", &analysis->num_inputs));
+    // _ScopedAllocatorConcat requires N >= 2.
+    if (analysis->num_inputs < 2) {
+      return errors::Aborted("Concat ", concat->name(), " has fewer than 2 ",
+                             "inputs");
+    }
+    const int dt_size = DataTypeSize(analysis->dtype);
+    if (dt_size == 0 || (Allocator::kAllocatorAlignment % dt_size) != 0) {
+      return errors::Aborted("Data type ", DataTypeString(analysis->dtype),
+                             " does not evenly divide kAllocatorAlignment");
+    }
+    if (HasNodeAttr(*concat, kScopedAllocatorAttrName)) {
+      return errors::Aborted("Concat ", concat->name(), " output is already ",
+                             "committed to a ScopedAllocator");
+    }
+    for (const string& input_name : concat->input()) {
+      if (!IsControlInput(input_name)) {
+        analysis->data_input_names.push_back(input_name);
+      }
+    }
+    const int expected_data_inputs = analysis->num_inputs + 1;  // + axis
+    if (static_cast<int>(analysis->data_input_names.size()) !=
+        expected_data_inputs) {
+      return errors::Internal("Concat ", concat->name(), " has ",
+                              analysis->data_input_names.size(),
+                              " data inputs, expected ", expected_data_inputs);
+    }
+
+    // Examine the producer of each concatenated tensor.
+    std::set<string> seen_edges;
+    for (int i = 0; i < analysis->num_inputs; ++i) {
+      const string& input_name = analysis->data_input_names[i];
+      if (!seen_edges.insert(input_name).second) {
+        return errors::Aborted("Tensor ", input_name, " is concatenated ",
+                               "more than once by ", concat->name());
+      }
+      int output_slot = 0;
+      ParseNodeName(input_name, &output_slot);
+      NodeDef* inode = node_map->GetNode(input_name);
+      if (inode == nullptr) {
+        return errors::Internal("Did not find node ", input_name);
+      }
+      // Const ops do not use the AllocatorAttributes set by the executor,
+      // and frame ops forward their inputs rather than allocating.
+      if (IsConstant(*inode) || IsArg(*inode) || ModifiesFrameInfo(*inode)) {
+        return errors::Aborted("Input ", inode->name(), " of concat ",
+                               concat->name(), " cannot allocate from a ",
+                               "ScopedAllocator");
+      }
+      if (inode->device() != concat->device()) {
+        return errors::Aborted("Input ", inode->name(),
+                               " is on a different device than concat ",
+                               concat->name());
+      }
+      // Require that this concat is the only consumer of the tensor.  If the
+      // tensor were read elsewhere too, those reads would alias the backing
+      // tensor; we conservatively leave such patterns alone.
+      for (NodeDef* consumer : node_map->GetOutputs(inode->name())) {
+        if (consumer == concat) continue;
+        for (const string& consumer_input : consumer->input()) {
+          if (consumer_input == input_name) {
+            return errors::Aborted("Tensor ", input_name, " feeds ",
+                                   consumer->name(), " in addition to ",
+                                   concat->name());
+          }
+        }
+      }
+      analysis->inputs.emplace_back(inode, output_slot, concat);
+    }
+    TF_RETURN_IF_ERROR(CheckExistingScopedAllocator(analysis->inputs));
+
+    // Gather the input shapes and check the types.
+    for (const InputDesc& nd : analysis->inputs) {
+      if (!graph_properties_->HasOutputProperties(nd.from_node_def->name())) {
+        return errors::Aborted("Node ", nd.from_node_def->name(),
+                               " lacks output shape");
+      }
+      const std::vector<OpInfo::TensorProperties>& prop_list =
+          graph_properties_->GetOutputProperties(nd.from_node_def->name());
+      if (nd.output_slot >= static_cast<int>(prop_list.size())) {
+        return errors::Internal("Invalid output slot ", nd.output_slot,
+                                " for node ", nd.from_node_def->name());
+      }
+      const OpInfo::TensorProperties& props = prop_list[nd.output_slot];
+      if (props.dtype() != analysis->dtype) {
+        return errors::Aborted("Type mismatch on input ",
+                               nd.from_node_def->name(), " of concat ",
+                               concat->name());
+      }
+      if (!TensorShape::IsValid(props.shape()) ||
+          props.shape().unknown_rank()) {
+        return errors::Aborted("Complete shape not known for ",
+                               nd.from_node_def->name());
+      }
+      analysis->input_shapes.push_back(TensorShape(props.shape()));
+    }
+
+    // ScopedAllocatorMgr::PopulateFields aligns each field offset to
+    // kAllocatorAlignment, so the backing tensor is a true concatenation of
+    // the inputs only if no interior padding is introduced: every input but
+    // the last must occupy a multiple of kAllocatorAlignment bytes.
+    for (int i = 0; i < analysis->num_inputs - 1; ++i) {
+      const int64_t bytes = analysis->input_shapes[i].num_elements() * dt_size;
+      if (bytes % Allocator::kAllocatorAlignment != 0) {
+        return errors::Aborted("Input ", i, " of concat ", concat->name(),
+                               " is ", bytes, " bytes, which is not a ",
+                               "multiple of kAllocatorAlignment");
+      }
+    }
+
+    // The axis must be a compile-time zero.
+    NodeDef* axis_node = node_map->GetNode(
+        analysis->data_input_names[analysis->num_inputs]);
+    if (axis_node == nullptr) {
+      return errors::Internal(
+          "Did not find node ",
+          analysis->data_input_names[analysis->num_inputs]);
+    }
+    TF_RETURN_IF_ERROR(
+        CheckAxisIsZero(*axis_node, analysis->input_shapes[0].dims()));
+
+    // The output shape must be fully known and must exactly cover the
+    // backing tensor.
+    if (!graph_properties_->HasOutputProperties(concat->name())) {
+      return errors::Aborted("Node ", concat->name(), " lacks output shape");
+    }
+    const OpInfo::TensorProperties& out_props =
+        graph_properties_->GetOutputProperties(concat->name())[0];
+    if (!TensorShape::IsValid(out_props.shape()) ||
+        out_props.shape().unknown_rank()) {
+      return errors::Aborted("Complete shape not known for ", concat->name());
+    }
+    analysis->output_shape = TensorShape(out_props.shape());
+    int64_t num_input_elements = 0;
+    for (const TensorShape& shape : analysis->input_shapes) {
+      num_input_elements += shape.num_elements();
+    }
+    if (analysis->output_shape.num_elements() != num_input_elements) {
+      return errors::Aborted("Output of concat ", concat->name(), " has ",
+                             analysis->output_shape.num_elements(),
+                             " elements but its inputs have ",
+                             num_input_elements);
+    }
+    return OkStatus();
+  }
+
+  // Performs the rewrite decided by AnalyzeConcat.  Builds a new
+  // _ScopedAllocator node, annotates the producers of the concatenated
+  // tensors to allocate from it, and turns `concat` into a
+  // _ScopedAllocatorConcat in place so that consumers (and fetches) keep
+  // referring to the same node name.  The axis input edge is dropped; the
+  // axis node itself is left for dead-node pruning.
+  Status ApplyRewrite(ScopedAllocatorOptimizer* sa_opti,
+                      int64_t invocation_count, GraphDef* graph,
+                      NodeDef* concat, const ConcatAnalysis& analysis) {
+    NodeMap* node_map = sa_opti->node_map();
+    std::vector<ScopedAllocator::Field> sa_fields;
+    int64_t num_bytes = ScopedAllocatorMgr::PopulateFields(
+        0 /*scope_id*/, analysis.input_shapes, analysis.dtype, &sa_fields);
+    int64_t num_elts = num_bytes / DataTypeSize(analysis.dtype);
+    TensorShape sa_shape({num_elts});
+    if (num_elts != analysis.output_shape.num_elements()) {
+      return errors::Internal("Backing tensor of concat ", concat->name(),
+                              " has ", num_elts, " elements, expected ",
+                              analysis.output_shape.num_elements());
+    }
+
+    int sa_id = sa_opti->NewScopedAllocatorId(analysis.num_inputs);
+    string sa_name =
+        strings::StrCat("scoped_allocator_", sa_id, "_", invocation_count);
+    TF_RETURN_IF_ERROR(ConstructScopedAllocatorNode(
+        sa_opti, graph, node_map, static_cast<int64_t>(analysis.num_inputs),
+        concat->device(), analysis.dtype, sa_id, sa_name,
+        analysis.input_shapes, analysis.inputs, sa_shape));
+
+    // Drop the axis input edge, then rebuild the node as a
+    // _ScopedAllocatorConcat over the same data inputs, with the backing
+    // tensor prepended.
+    const string& axis_input = analysis.data_input_names[analysis.num_inputs];
+    node_map->RemoveOutput(NodeName(axis_input), concat->name());
+    std::vector<string> ctl_inputs;
+    for (const string& input_name : concat->input()) {
+      if (IsControlInput(input_name)) {
+        ctl_inputs.push_back(input_name);
+      }
+    }
+    concat->set_op("_ScopedAllocatorConcat");
+    concat->clear_attr();
+    AddNodeAttr("sa_name", sa_name, concat);
+    AddNodeAttr("id", sa_id, concat);
+    AddNodeAttr("T", analysis.dtype, concat);
+    AttrValue shape_attr;
+    SetAttrValue(analysis.output_shape, &shape_attr);
+    AddNodeAttr("shape", shape_attr, concat);
+    AddNodeAttr("reshape", true, concat);
+    AddNodeAttr("N", analysis.num_inputs, concat);
+    concat->clear_input();
+    concat->add_input(sa_name);
+    for (int i = 0; i < analysis.num_inputs; ++i) {
+      concat->add_input(analysis.data_input_names[i]);
+    }
+    for (const string& ctl_input : ctl_inputs) {
+      concat->add_input(ctl_input);
+    }
+    node_map->AddOutput(sa_name, concat->name());
+    return OkStatus();
+  }
+
+  Status Rewrite(ScopedAllocatorOptimizer* sa_opti, int64_t invocation_count,
+                 GraphDef* graph, const string& op_name,
+                 const std::vector<NodeDef*>& ops, bool* applied) override {
+    *applied = false;
+    for (NodeDef* concat : ops) {
+      ConcatAnalysis analysis;
+      Status s = AnalyzeConcat(sa_opti, concat, &analysis);
+      if (!s.ok()) {
+        // This instance is not a profitable or safe application of a
+        // ScopedAllocator; leave it alone and move on.
+        VLOG(1) << "ConcatRewriter skipping " << concat->name() << ": " << s;
+        continue;
+      }
+      VLOG(1) << "ConcatRewriter::Rewrite " << concat->name();
+      LOG_WARNING_AND_RETURN_IF_ERROR(
+          ApplyRewrite(sa_opti, invocation_count, graph, concat, analysis));
+      *applied = true;
+    }
+    return OkStatus();
+  }
+};
+
 ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
     RewriterConfig::Toggle opt_level, const ScopedAllocatorOptions& opts)
     : opt_level_(opt_level) {
   VLOG(1) << "ScopedAllocatorOptimizer::ScopedAllocatorOptimizer";
-  Rewriter* r = new UnaryElementwiseRewriter();
-  to_delete_.push_back(r);
+  Rewriter* unary_rewriter = new UnaryElementwiseRewriter();
+  to_delete_.push_back(unary_rewriter);
+  Rewriter* concat_rewriter = new ConcatRewriter();
+  to_delete_.push_back(concat_rewriter);
+  auto rewriter_for_op = [unary_rewriter,
+                          concat_rewriter](const string& op_name) {
+    return op_name == "ConcatV2" ? concat_rewriter : unary_rewriter;
+  };
   if (opts.enable_op_size() == 0) {
     // Opts handled by default:
-    for (const auto& op_name : {"CollectiveReduce"}) {
+    for (const auto& op_name : {"CollectiveReduce", "ConcatV2"}) {
       op_name_set_.insert(op_name);
-      rewriters_[op_name] = r;
+      rewriters_[op_name] = rewriter_for_op(op_name);
     }
   } else {
     for (const auto& op_name : opts.enable_op()) {
       op_name_set_.insert(op_name);
-      rewriters_[op_name] = r;
+      rewriters_[op_name] = rewriter_for_op(op_name);
     }
   }
 }
@@ -1124,11 +1431,12 @@ Status ScopedAllocatorOptimizer::ProcessGraphDef(
                                          &op_name, invocation_count](Tree* t) {
           VLOG(2) << "applied to tree node " << t->edge_ << " at depth "
                   << t->depth_ << " of size " << t->nodes_.size();
-          if (t->nodes_.size() > 1) {
+          const int min_group_size = rewriter->MinGroupSize();
+          if (static_cast<int>(t->nodes_.size()) >= min_group_size) {
             std::vector<std::vector<NodeDef*>> loop_groups;
             PartitionByLoopStructure(frame_view, t->nodes_, &loop_groups);
             for (auto& lg : loop_groups) {
-              if (lg.size() > 1) {
+              if (static_cast<int>(lg.size()) >= min_group_size) {
                 bool applied = false;
                 Status s = OrderNodeSet(&lg);
                 TF_RETURN_IF_ERROR(s);
@@ -93,6 +93,12 @@ class ScopedAllocatorOptimizer : public GraphOptimizer {
                            const std::vector<NodeDef*>& nodes,
                            bool* applied) = 0;
 
+    // Minimum number of instances of the target Op that must occur together
+    // in a group for Rewrite to be called on that group.  The default suits
+    // Rewriters that coalesce multiple parallel Op instances; Rewriters that
+    // act on one instance at a time should override this to return 1.
+    virtual int MinGroupSize() const { return 2; }
+
     void SetGraphProperties(const GraphProperties& graph_properties) {
       graph_properties_ = &graph_properties;
       CHECK(graph_properties_);
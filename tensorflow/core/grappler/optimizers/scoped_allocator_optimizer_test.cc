@@ -267,6 +267,41 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     TF_CHECK_OK(s.ToGraphDef(graph_def));
   }
 
+  // Constructs the following graph.
+  //
+  // c1 and c2 are Const ops.  a1 and a2 are Abs ops.  concat is a ConcatV2
+  // over axis 0.
+  //
+  // The intended optimization is to have a1 and a2 allocate their outputs
+  // from a new ScopedAllocator, and to replace concat with a
+  // _ScopedAllocatorConcat that aliases the backing tensor.  Each input is a
+  // 4x4 float tensor, i.e. 64 bytes, so the fields of the backing tensor are
+  // contiguous.
+  /*
+          c1   c2
+          |    |
+          a1   a2
+           \  /
+          concat
+  */
+  void BuildConcatGraph(GraphDef* graph_def) {
+    Scope s = Scope::NewRootScope();
+    s = s.WithDevice("/job:localhost/replica:0/task:0/device:CPU:0");
+
+    std::vector<float> c1_values;
+    std::vector<float> c2_values;
+    for (int i = 0; i < 16; ++i) {
+      c1_values.push_back(-1.0 * i);
+      c2_values.push_back(1.0 * i);
+    }
+    Output c1 = ops::Const<float>(s.WithOpName("c1"), c1_values, {4, 4});
+    Output c2 = ops::Const<float>(s.WithOpName("c2"), c2_values, {4, 4});
+    Output a1 = ops::Abs(s.WithOpName("a1"), c1);
+    Output a2 = ops::Abs(s.WithOpName("a2"), c2);
+    Output concat = ops::Concat(s.WithOpName("concat"), {a1, a2}, 0);
+    TF_CHECK_OK(s.ToGraphDef(graph_def));
+  }
+
   void SetShapes(GraphDef* graph_def) {
     TensorShapeProto shape_proto;
     shape_proto.add_dim()->set_size(2);
@@ -283,7 +318,8 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
   // returns the outputs specified by `output_names` in `outputs`.
   void ExecuteGraph(const GraphDef& graph_def,
                     const std::vector<string>& output_names,
-                    std::vector<Tensor>* outputs) {
+                    std::vector<Tensor>* outputs,
+                    const string& enable_op = "Abs") {
     // Turn off all optimization except the ScopedAllocatorOptimizer
     // to avoid anything that would alter the expected graph input/output,
     // e.g. by constant folding away all calculations.
@@ -297,7 +333,7 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     RewriterConfig* rwcfg = gopt->mutable_rewrite_options();
     rwcfg->clear_optimizers();
     (*rwcfg->add_optimizers()) = "scoped_allocator";
-    rwcfg->mutable_scoped_allocator_opts()->add_enable_op("Abs");
+    rwcfg->mutable_scoped_allocator_opts()->add_enable_op(enable_op);
     std::unique_ptr<Session> session(CreateSession(graph_def, config));
 
     std::vector<std::pair<string, Tensor>> inputs;
@@ -596,6 +632,68 @@ TEST_F(ScopedAllocatorOptimizerTest, ConstInput) {
   }
   EXPECT_EQ(num_identity_ops, 2);
 }
+
+// Tests that an axis-0 ConcatV2 is rewritten into a _ScopedAllocatorConcat
+// whose inputs allocate directly from the backing tensor.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatRewrite) {
+  GrapplerItem item;
+  BuildConcatGraph(&item.graph);
+
+  ScopedAllocatorOptions opts;
+  opts.add_enable_op("ConcatV2");
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+
+  GraphDef optimized_graph;
+  TF_ASSERT_OK(sao.Optimize(nullptr /*cluster*/, item, &optimized_graph));
+
+  // The concat node keeps its name but becomes a _ScopedAllocatorConcat
+  // whose first input is the backing tensor.
+  NodeMap node_map(&optimized_graph);
+  NodeDef* concat = nullptr;
+  GetNode(&node_map, "concat", &concat);
+  EXPECT_EQ(concat->op(), "_ScopedAllocatorConcat");
+  ASSERT_EQ(concat->input_size(), 3);
+  EXPECT_EQ(concat->input(0), "scoped_allocator_1_1");
+  EXPECT_EQ(concat->input(1), "a1");
+  EXPECT_EQ(concat->input(2), "a2");
+  bool reshape = false;
+  TF_EXPECT_OK(GetNodeAttr(AttrSlice(*concat), "reshape", &reshape));
+  EXPECT_TRUE(reshape);
+  TensorShape shape;
+  TF_EXPECT_OK(GetNodeAttr(AttrSlice(*concat), "shape", &shape));
+  EXPECT_EQ(shape, TensorShape({8, 4}));
+
+  // Both producers are annotated to allocate from the ScopedAllocator and
+  // have a control edge from it.
+  for (const auto& abs_name : {"a1", "a2"}) {
+    NodeDef* abs_node = nullptr;
+    GetNode(&node_map, abs_name, &abs_node);
+    EXPECT_TRUE(HasNodeAttr(*abs_node, "_scoped_allocator"));
+    NodeDef* sa_node = ValidateSAControlInput(&optimized_graph, &node_map,
+                                              abs_name);
+    EXPECT_EQ(sa_node->name(), "scoped_allocator_1_1");
+  }
+}
+
+TEST_F(ScopedAllocatorOptimizerTest, ConcatExecute) {
+  // Builds the same graph as ConcatRewrite but also executes it and
+  // validates the output.
+  GraphDef graph_def;
+  BuildConcatGraph(&graph_def);
+  std::vector<Tensor> outputs;
+  ExecuteGraph(graph_def, /*output_names=*/{"concat:0"}, &outputs,
+               /*enable_op=*/"ConcatV2");
+  ASSERT_EQ(outputs.size(), 1);
+  EXPECT_EQ(outputs[0].shape(), TensorShape({8, 4}));
+  std::vector<float> expected;
+  for (int i = 0; i < 16; ++i) {
+    expected.push_back(1.0 * i);
+  }
+  for (int i = 0; i < 16; ++i) {
+    expected.push_back(1.0 * i);
+  }
+  ValidateValues(outputs, {expected});
+}
 #endif  // ENABLE_MKL
 
 }  // namespace
@@ -19,6 +19,8 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/aggregate_ops.h"
 
+#include <numeric>
+
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/op_requires.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -50,20 +52,17 @@ class AddNOp : public OpKernel {
     }
 
     // Try to forward and accumulate the result in one of the input buffers.
+    // Every input is a forwarding candidate: any that is exclusively owned
+    // and about to die can donate its buffer, in which case the adds below
+    // accumulate over the forwarded buffer with no new allocation.
     int reused_input = -1;
     gtl::InlinedVector<int, 8> input_indices(num);
     std::iota(input_indices.begin(), input_indices.end(), 0);
     Tensor* output = nullptr;
-    for (int input_idx = 0; input_idx < num; ++input_idx) {
-      if (ctx->forward_input_to_output_with_shape(input_idx, 0, input0.shape(),
-                                                  &output)) {
-        reused_input = input_idx;
-        break;
-      }
-    }
-    if (reused_input == -1) {
-      OP_REQUIRES_OK(ctx, ctx->allocate_output(0, input0.shape(), &output));
-    } else if (reused_input > 0) {
+    OP_REQUIRES_OK(ctx, ctx->forward_input_or_allocate_output(
+                            input_indices, 0, input0.shape(), &output,
+                            &reused_input));
+    if (reused_input > 0) {
       // Move the forwarded buffer to the front so we don't double count
       // anything if there are more than 8 inputs.
       input_indices[0] = reused_input;
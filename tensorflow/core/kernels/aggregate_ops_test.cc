@@ -0,0 +1,145 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <vector>
+
+#include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+
+namespace tensorflow {
+namespace {
+
+class AddNOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(int num_inputs, DataType dtype) {
+    TF_EXPECT_OK(NodeDefBuilder("add_n_op", "AddN")
+                     .Input(FakeInput(num_inputs, dtype))
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+  }
+};
+
+TEST_F(AddNOpTest, TwoInputsFloat) {
+  MakeOp(2, DT_FLOAT);
+  AddInputFromArray<float>(TensorShape({2, 2}), {1, 2, 3, 4});
+  AddInputFromArray<float>(TensorShape({2, 2}), {10, 20, 30, 40});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2, 2}));
+  test::FillValues<float>(&expected, {11, 22, 33, 44});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
+TEST_F(AddNOpTest, ThreeInputsInt32) {
+  MakeOp(3, DT_INT32);
+  AddInputFromArray<int32>(TensorShape({3}), {1, 2, 3});
+  AddInputFromArray<int32>(TensorShape({3}), {10, 20, 30});
+  AddInputFromArray<int32>(TensorShape({3}), {100, 200, 300});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_INT32, TensorShape({3}));
+  test::FillValues<int32>(&expected, {111, 222, 333});
+  test::ExpectTensorEqual<int32>(expected, *GetOutput(0));
+}
+
+// Eleven inputs exercises both the Add3Functor head and the accumulating
+// Add8pFunctor tail of the unrolled summation.
+TEST_F(AddNOpTest, ElevenInputsFloat) {
+  const int kNumInputs = 11;
+  MakeOp(kNumInputs, DT_FLOAT);
+  float sum = 0;
+  for (int i = 0; i < kNumInputs; ++i) {
+    const float value = i + 1;
+    AddInputFromArray<float>(TensorShape({2}), {value, 2 * value});
+    sum += value;
+  }
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2}));
+  test::FillValues<float>(&expected, {sum, 2 * sum});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
+TEST_F(AddNOpTest, SingleInputIsPassedThrough) {
+  MakeOp(1, DT_FLOAT);
+  AddInputFromArray<float>(TensorShape({4}), {1, 2, 3, 4});
+  const void* input_buffer = mutable_input(0).tensor->data();
+  TF_ASSERT_OK(RunOpKernel());
+
+  // With a single input the kernel forwards the input tensor as-is.
+  EXPECT_EQ(input_buffer, GetOutput(0)->data());
+}
+
+TEST_F(AddNOpTest, ForwardsExclusivelyOwnedInputBuffer) {
+  MakeOp(3, DT_FLOAT);
+  AddInputFromArray<float>(TensorShape({2}), {1, 2});
+  AddInputFromArray<float>(TensorShape({2}), {10, 20});
+  AddInputFromArray<float>(TensorShape({2}), {100, 200});
+  // Each test input exclusively owns its buffer, so the first input is an
+  // eligible donor and the sum should be accumulated in place over it
+  // rather than in a fresh allocation.
+  const void* input_buffer = mutable_input(0).tensor->data();
+  TF_ASSERT_OK(RunOpKernel());
+
+  EXPECT_EQ(input_buffer, GetOutput(0)->data());
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2}));
+  test::FillValues<float>(&expected, {111, 222});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
+static Graph* AddN(int num_inputs, int dim) {
+  Graph* g = new Graph(OpRegistry::Global());
+  std::vector<NodeBuilder::NodeOut> inputs;
+  inputs.reserve(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    Tensor data(DT_FLOAT, TensorShape({dim}));
+    data.flat<float>().setRandom();
+    inputs.push_back(test::graph::Constant(g, data));
+  }
+  Node* node;
+  TF_CHECK_OK(NodeBuilder(g->NewName("addn"), "AddN")
+                  .Input(inputs)
+                  .Finalize(g, &node));
+  return g;
+}
+
+static void BM_AddN(::testing::benchmark::State& state) {
+  const int num_inputs = state.range(0);
+  const int dim = state.range(1);
+
+  test::Benchmark("cpu", AddN(num_inputs, dim), /*old_benchmark_api=*/false)
+      .Run(state);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_inputs * dim * sizeof(float));
+}
+BENCHMARK(BM_AddN)
+    ->UseRealTime()
+    ->ArgPair(2, 4096)
+    ->ArgPair(8, 4096)
+    ->ArgPair(16, 4096);
+
+}  // namespace
+}  // namespace tensorflow
@@ -47,6 +47,8 @@ constexpr char kMinInflightBatchesAttr[] = "_min_inflight_batches";
 constexpr char kInitialInflightBatchesAttr[] = "_initial_inflight_batches";
 constexpr char kMaxInflightBatchesAttr[] = "_max_inflight_batches";
 constexpr char kBatchesToAverageOverAttr[] = "_batches_to_average_over";
+constexpr char kBatchPriorityAttr[] = "_batch_priority";
+constexpr char kEnableRaggedBatchingAttr[] = "_enable_ragged_batching";
 
 // Default thread count in the per-process batching thread pool.
 constexpr int64_t kBatchThreadPoolSize = 128;
@@ -137,6 +139,7 @@ class BatchResource : public serving::BatchResourceBase {
                        FunctionLibraryRuntime::Handle fhandle,
                        FunctionLibraryRuntime* flib,
                        bool enable_large_batch_splitting,
+                       bool enable_ragged_batching,
                        std::unique_ptr<BatchResource>* resource) {
     BatcherT::Options batcher_options;
     batcher_options.num_batch_threads = num_batch_threads;
@@ -149,7 +152,7 @@ class BatchResource : public serving::BatchResourceBase {
                                batch_timeout_micros, max_enqueued_batches,
                                allowed_batch_sizes,
                                enable_large_batch_splitting),
-        allowed_batch_sizes));
+        allowed_batch_sizes, enable_ragged_batching));
     return OkStatus();
   }
 
@@ -159,7 +162,7 @@ class BatchResource : public serving::BatchResourceBase {
       int32_t max_enqueued_batches,
       const std::vector<int32>& allowed_batch_sizes,
       FunctionLibraryRuntime::Handle fhandle, FunctionLibraryRuntime* flib,
-      std::unique_ptr<BatchResource>* resource) {
+      bool enable_ragged_batching, std::unique_ptr<BatchResource>* resource) {
     std::shared_ptr<AdaptiveBatcherT> batcher;
     TF_RETURN_IF_ERROR(AdaptiveBatcherT::Create(
         adaptive_shared_batch_scheduler_options, &batcher));
@@ -169,7 +172,7 @@ class BatchResource : public serving::BatchResourceBase {
         GetAdaptiveBatcherQueueOptions(
             max_batch_size, batch_timeout_micros, max_enqueued_batches,
             true /* enable large batch split */, allowed_batch_sizes),
-        allowed_batch_sizes));
+        allowed_batch_sizes, enable_ragged_batching));
     return OkStatus();
   }
 
@@ -179,11 +182,12 @@ class BatchResource : public serving::BatchResourceBase {
   BatchResource(FunctionLibraryRuntime::Handle fhandle,
                 FunctionLibraryRuntime* flib, std::shared_ptr<BatcherT> batcher,
                 const BatcherT::QueueOptions& batcher_queue_options,
-                std::vector<int32> allowed_batch_sizes)
+                std::vector<int32> allowed_batch_sizes,
+                bool enable_ragged_batching)
       : BatchResourceBase(
             /*has_process_batch_function=*/fhandle != kInvalidHandle,
             std::move(batcher), batcher_queue_options,
-            std::move(allowed_batch_sizes)),
+            std::move(allowed_batch_sizes), enable_ragged_batching),
         fhandle_(fhandle),
         flib_(flib) {}
 
@@ -191,11 +195,12 @@ class BatchResource : public serving::BatchResourceBase {
                 FunctionLibraryRuntime* flib,
                 std::shared_ptr<AdaptiveBatcherT> batcher,
                 const AdaptiveBatcherT::QueueOptions& batcher_queue_options,
-                std::vector<int32> allowed_batch_sizes)
+                std::vector<int32> allowed_batch_sizes,
+                bool enable_ragged_batching)
       : BatchResourceBase(
             /*has_process_batch_function=*/fhandle != kInvalidHandle,
             std::move(batcher), batcher_queue_options,
-            std::move(allowed_batch_sizes)),
+            std::move(allowed_batch_sizes), enable_ragged_batching),
         fhandle_(fhandle),
         flib_(flib) {}
 
@@ -256,6 +261,19 @@ BatchFunctionKernel::BatchFunctionKernel(OpKernelConstruction* c)
     has_attribute_enable_large_batch_splitting_ = false;
   }
 
+  if (c->HasAttr(kBatchPriorityAttr)) {
+    OP_REQUIRES_OK(c, c->GetAttr(kBatchPriorityAttr, &batch_priority_));
+    has_attribute_batch_priority_ = true;
+  } else {
+    batch_priority_ = 0;
+    has_attribute_batch_priority_ = false;
+  }
+
+  if (c->HasAttr(kEnableRaggedBatchingAttr)) {
+    OP_REQUIRES_OK(
+        c, c->GetAttr(kEnableRaggedBatchingAttr, &enable_ragged_batching_));
+  }
+
   // Helper function `SetAdaptiveBatchSchedulerOptions` calls
   // `OP_REQUIRES_OK`, which exits the current function upon error.
   // So validate status of `op-kernel-construction`.
@@ -331,7 +349,7 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
       TF_RETURN_IF_ERROR(BatchResource::Create(
           adaptive_shared_batch_scheduler_options, max_batch_size_,
           batch_timeout_micros_, max_enqueued_batches_, allowed_batch_sizes_,
-          handle, flib_, &new_resource));
+          handle, flib_, enable_ragged_batching_, &new_resource));
       *r = new_resource.release();
       return OkStatus();
     };
@@ -341,7 +359,8 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
       TF_RETURN_IF_ERROR(BatchResource::Create(
           num_batch_threads_, max_batch_size_, batch_timeout_micros_,
           max_enqueued_batches_, allowed_batch_sizes_, handle, flib_,
-          enable_large_batch_splitting_, &new_resource));
+          enable_large_batch_splitting_, enable_ragged_batching_,
+          &new_resource));
       *r = new_resource.release();
       return OkStatus();
     };
@@ -352,8 +371,14 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
                        c->resource_manager()->LookupOrCreate(
                            container_, shared_name_, &br, creator),
                        done);
-  const Status status =
-      br->RegisterInput(random::New64(), c, batcher_queue_, done);
+  // When a priority tier is annotated on the node, this op's own batch
+  // timeout applies to its queue, so tiers sharing a batch resource keep
+  // separate timeouts.
+  const Status status = br->RegisterInput(
+      random::New64(), c, batcher_queue_, done, batch_priority_,
+      has_attribute_batch_priority_
+          ? absl::make_optional<int64_t>(batch_timeout_micros_)
+          : absl::nullopt);
   br->Unref();
   OP_REQUIRES_OK_ASYNC(c, status, done);
   // Assume br calls done, so nothing to do here.
@@ -563,7 +588,8 @@ class BatchKernel : public AsyncOpKernel {
       TF_RETURN_IF_ERROR(BatchResource::Create(
           num_batch_threads_, max_batch_size_, batch_timeout_micros_,
           max_enqueued_batches_, allowed_batch_sizes_, kInvalidHandle,
-          /*flib=*/nullptr, false, &new_resource));
+          /*flib=*/nullptr, /*enable_large_batch_splitting=*/false,
+          /*enable_ragged_batching=*/false, &new_resource));
       *r = new_resource.release();
       return OkStatus();
     };
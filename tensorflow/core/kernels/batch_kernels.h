@@ -94,6 +94,18 @@ class BatchFunctionKernel : public AsyncOpKernel {
   FunctionLibraryRuntime* flib_;
   bool enable_large_batch_splitting_;
   bool has_attribute_enable_large_batch_splitting_;
+  // Scheduling priority tier of this op's batcher queue, read from the
+  // optional node attribute `_batch_priority`. When the attribute is present,
+  // this op's `batch_timeout_micros` also applies to its own queue even if
+  // the underlying batch resource is shared, so interactive and bulk traffic
+  // tiers can share one model instance with per-tier timeouts.
+  int32 batch_priority_;
+  bool has_attribute_batch_priority_;
+  // True if the optional node attribute `_enable_ragged_batching` is set to
+  // true. In ragged mode, requests arrive pre-packed along dimension 0 and an
+  // int64 row-splits tensor describing per-request boundaries is appended to
+  // the batched inputs passed to the function.
+  bool enable_ragged_batching_ = false;
   bool enable_adaptive_batch_threads_ = false;
 
   mutex mu_;
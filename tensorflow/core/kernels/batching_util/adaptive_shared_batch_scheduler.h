@@ -125,6 +125,17 @@ class AdaptiveSharedBatchScheduler
     // responsive to changes in workload.
     int64_t batches_to_average_over = 1000;
 
+    // If positive, in_flight_batches_limit_ is adjusted to keep the
+    // 'target_latency_percentile' batch latency (queueing + processing) at or
+    // below this target while otherwise maximizing throughput, instead of
+    // minimizing average latency.  Useful when SLOs are expressed as a tail
+    // latency bound rather than a mean.
+    int64_t target_tail_latency_micros = 0;
+    // The latency percentile (in (0, 100]) held to
+    // 'target_tail_latency_micros'; e.g. 99.0 targets the p99 latency.
+    // Ignored unless 'target_tail_latency_micros' is positive.
+    double target_latency_percentile = 99.0;
+
     // If true, schedule batches using FIFO policy.
     // Requires that `full_batch_scheduling_boost_micros` is zero.
     // NOTE:
@@ -211,6 +222,12 @@ class AdaptiveSharedBatchScheduler
 
   void MaybeAdjustInflightLimit() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Adjusts in_flight_batches_limit_ to hold the configured latency percentile
+  // at or below options_.target_tail_latency_micros, raising the limit for
+  // throughput whenever the tail latency is within the target.  Called instead
+  // of the average-latency adjustment when a tail-latency target is set.
+  void AdjustInflightLimitForTailLatency() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Notifies scheduler of non-empty batch which is eligible for processing.
   void AddBatch(const internal::ASBSBatch<TaskType>* batch);
 
@@ -274,6 +291,10 @@ class AdaptiveSharedBatchScheduler
   // batch.
   DelayStats batch_delay_stats_ TF_GUARDED_BY(mu_);
 
+  // Per-batch latencies (creation to completion) for batches counted by
+  // batch_count_.  Only populated when a tail-latency target is configured.
+  std::vector<int64_t> window_latencies_micros_ TF_GUARDED_BY(mu_);
+
   // Max adjustment size (as a fraction of in_flight_batches_limit_).
   constexpr static double kMaxStepSizeMultiplier = 0.125;  // 1/8;
   // Min adjustment size (as a fraction of in_flight_batches_limit_).
@@ -417,6 +438,18 @@ Status AdaptiveSharedBatchScheduler<TaskType>::Create(
         "greater than or equal to 1; was ",
         options.batches_to_average_over);
   }
+  if (options.target_tail_latency_micros < 0) {
+    return errors::InvalidArgument(
+        "target_tail_latency_micros can't be negative; was ",
+        options.target_tail_latency_micros);
+  }
+  if (options.target_tail_latency_micros > 0 &&
+      (options.target_latency_percentile <= 0 ||
+       options.target_latency_percentile > 100)) {
+    return errors::InvalidArgument(
+        "target_latency_percentile must be in (0, 100]; was ",
+        options.target_latency_percentile);
+  }
   scheduler->reset(new AdaptiveSharedBatchScheduler<TaskType>(options));
   return OkStatus();
 }
@@ -645,6 +678,9 @@ void AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper(
   in_flight_batches_--;
   batch_count_++;
   batch_delay_stats_.batch_latency_sum += end_time - start_time;
+  if (options_.target_tail_latency_micros > 0) {
+    window_latencies_micros_.push_back(end_time - start_time);
+  }
 
   MaybeAdjustInflightLimit();
 
@@ -658,6 +694,10 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeAdjustInflightLimit() {
   // be a simple convex function of in_flight_batches_limit_, allowing us to
   // locate the global minimum relatively quickly.
   if (batch_count_ == options_.batches_to_average_over) {
+    if (options_.target_tail_latency_micros > 0) {
+      AdjustInflightLimitForTailLatency();
+      return;
+    }
     double current_avg_latency_ms =
         (batch_delay_stats_.batch_latency_sum / 1000.) / batch_count_;
     bool current_latency_decreased =
@@ -694,6 +734,44 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeAdjustInflightLimit() {
   }
 }
 
+template <typename TaskType>
+void AdaptiveSharedBatchScheduler<TaskType>::AdjustInflightLimitForTailLatency() {
+  // Treat the tail-latency target as a constraint: when the window's
+  // percentile latency exceeds the target, back the concurrency off (less
+  // queueing behind in-flight batches, shorter tail); otherwise raise it to
+  // recover throughput.  The controller oscillates around the largest limit
+  // that satisfies the target, with the step size shrinking every time the
+  // direction reverses and growing while the direction is sustained.
+  const size_t rank = std::min(
+      window_latencies_micros_.size() - 1,
+      static_cast<size_t>(options_.target_latency_percentile / 100.0 *
+                          window_latencies_micros_.size()));
+  std::nth_element(window_latencies_micros_.begin(),
+                   window_latencies_micros_.begin() + rank,
+                   window_latencies_micros_.end());
+  const int64_t tail_latency_micros = window_latencies_micros_[rank];
+  const int step_direction =
+      tail_latency_micros > options_.target_tail_latency_micros ? -1 : 1;
+  if (step_direction == batch_delay_stats_.step_direction) {
+    step_size_multiplier_ = std::min(step_size_multiplier_ * 2,
+                                     kMaxStepSizeMultiplier);
+  } else {
+    step_size_multiplier_ = std::max(step_size_multiplier_ * 0.5,
+                                     kMinStepSizeMultiplier);
+  }
+  batch_delay_stats_.step_direction = step_direction;
+  in_flight_batches_limit_ +=
+      step_direction * in_flight_batches_limit_ * step_size_multiplier_;
+  in_flight_batches_limit_ = std::min(
+      in_flight_batches_limit_, static_cast<double>(options_.num_batch_threads));
+  in_flight_batches_limit_ =
+      std::max(in_flight_batches_limit_,
+               static_cast<double>(options_.min_in_flight_batches_limit));
+  batch_count_ = 0;
+  batch_delay_stats_.batch_latency_sum = 0;
+  window_latencies_micros_.clear();
+}
+
 // ---------------- ASBSQueue ----------------
 
 namespace internal {
@@ -26,7 +26,6 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/request_cost_accessor.h"
 #include "tensorflow/core/common_runtime/request_cost_accessor_registry.h"
 #include "tensorflow/core/framework/ops_util.h"
-#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/kernels/batching_util/concat_split_util.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
@@ -234,7 +233,8 @@ using TensorMatrix = std::vector<std::vector<Tensor>>;
 
 Status BatchResourceBase::RegisterInput(
     int64_t guid, OpKernelContext* context, const string& batcher_queue_name,
-    AsyncOpKernel::DoneCallback done_callback) {
+    AsyncOpKernel::DoneCallback done_callback, int priority,
+    absl::optional<int64_t> batch_timeout_micros) {
   std::unique_ptr<BatchTask> batch_components;
   TF_RETURN_IF_ERROR(CreateBatchTask(context, &batch_components));
   batch_components->start_time = EnvTime::NowNanos();
@@ -307,8 +307,8 @@ Status BatchResourceBase::RegisterInput(
   }
 
   BatcherQueueT* batcher_queue;
-  TF_RETURN_IF_ERROR(
-      LookupOrCreateBatcherQueue(batcher_queue_name, &batcher_queue));
+  TF_RETURN_IF_ERROR(LookupOrCreateBatcherQueue(
+      batcher_queue_name, priority, batch_timeout_micros, &batcher_queue));
   return batcher_queue->Schedule(&batch_components);
 }
 
@@ -469,6 +469,27 @@ Status BatchResourceBase::ConcatInputTensors(
     TF_RETURN_IF_ERROR(concat_status);
     concatenated_tensors->push_back(concatenated_tensor);
   }
+
+  // In ragged mode, append the request boundaries within the packed 0th
+  // dimension so the batch function can recover per-request rows. The tensor
+  // has batch.num_tasks() + 2 entries: 0, the cumulative row count of each
+  // request, and the padded total row count (the rows between the last two
+  // entries are padding).
+  if (enable_ragged_batching_ && has_process_batch_function_) {
+    Tensor row_splits;
+    AllocatorAttributes attr;
+    attr.set_on_host(true);
+    TF_RETURN_IF_ERROR(context->allocate_temp(
+        DT_INT64, TensorShape({batch.num_tasks() + 2}), &row_splits, attr));
+    auto row_splits_vec = row_splits.vec<int64_t>();
+    row_splits_vec(0) = 0;
+    for (int task_idx = 0; task_idx < batch.num_tasks(); ++task_idx) {
+      row_splits_vec(task_idx + 1) =
+          row_splits_vec(task_idx) + batch.task(task_idx).size();
+    }
+    row_splits_vec(batch.num_tasks() + 1) = padded_batch_size;
+    concatenated_tensors->push_back(row_splits);
+  }
   return OkStatus();
 }
 
@@ -610,8 +631,14 @@ Status BatchResourceBase::SplitOutputTensors(
     }
 
     std::vector<Tensor> split_tensor;
-    const Status split_status = tensor::Split(
-        output_tensor, task_sizes_plus_optional_padding, &split_tensor);
+    // Each task consumes a disjoint range of the output's 0th dimension, so
+    // whenever alignment allows this emits aliased slices of the batched
+    // output buffer (kept alive by refcounting until the last task releases
+    // its output) rather than copying every result; misaligned cases fall
+    // back to a copying split.
+    const Status split_status =
+        Split(batch->task(0).context, output_tensor,
+              task_sizes_plus_optional_padding, &split_tensor);
     DCHECK(split_status.ok()) << split_status.ToString();
     if (!split_status.ok()) {
       return errors::Internal("Tensor split operation failed: ",
@@ -847,8 +874,9 @@ void BatchResourceBase::ProcessBatch(std::unique_ptr<BatchT> batch) const {
 
 // Looks up the batcher queue for 'queue_name'. If it did't previously exist,
 // creates it.
-Status BatchResourceBase::LookupOrCreateBatcherQueue(const string& queue_name,
-                                                     BatcherQueueT** queue) {
+Status BatchResourceBase::LookupOrCreateBatcherQueue(
+    const string& queue_name, int priority,
+    absl::optional<int64_t> batch_timeout_micros, BatcherQueueT** queue) {
   mutex_lock l(batcher_queues_mu_);
 
   auto it = batcher_queues_.find(queue_name);
@@ -866,11 +894,23 @@ Status BatchResourceBase::LookupOrCreateBatcherQueue(const string& queue_name,
     }
   };
   if (batcher_) {
-    TF_RETURN_IF_ERROR(batcher_->AddQueue(batcher_queue_options_,
-                                          process_batch_callback, &new_queue));
+    BatcherT::QueueOptions queue_options = batcher_queue_options_;
+    queue_options.priority = priority;
+    if (batch_timeout_micros.has_value()) {
+      queue_options.batch_timeout_micros = batch_timeout_micros.value();
+    }
+    TF_RETURN_IF_ERROR(
+        batcher_->AddQueue(queue_options, process_batch_callback, &new_queue));
   } else if (adaptive_batcher_) {
+    // The adaptive scheduler has no priority tiers; only the timeout override
+    // applies.
+    AdaptiveBatcherT::QueueOptions queue_options =
+        adaptive_batcher_queue_options_;
+    if (batch_timeout_micros.has_value()) {
+      queue_options.batch_timeout_micros = batch_timeout_micros.value();
+    }
     TF_RETURN_IF_ERROR(adaptive_batcher_->AddQueue(
-        adaptive_batcher_queue_options_, process_batch_callback, &new_queue));
+        queue_options, process_batch_callback, &new_queue));
   } else {
     return errors::Internal("No batcher defined.");
   }
@@ -19,6 +19,7 @@ limitations under the License.
 #include <map>
 
 #include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
 #include "tensorflow/core/common_runtime/cost_measurement_registry.h"
 #include "tensorflow/core/common_runtime/request_cost.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -48,9 +49,19 @@ class BatchResourceBase : public ResourceBase {
 
   // Ingests data from one invocation of the batch op. The data is enqueued to
   // be combined with others into a batch, asynchronously.
-  Status RegisterInput(int64_t guid, OpKernelContext* context,
-                       const string& batcher_queue_name,
-                       AsyncOpKernel::DoneCallback done_callback);
+  //
+  // 'priority' selects the scheduling tier of the batcher queue named
+  // 'batcher_queue_name'; batches from higher tiers are dispatched ahead of
+  // queued batches from lower tiers of the same scheduler. When
+  // 'batch_timeout_micros' is set it overrides the resource-wide timeout for
+  // that queue, giving each tier its own timeout. Both only take effect when
+  // the queue is first created, and the priority is ignored by the adaptive
+  // scheduler, which has no priority tiers.
+  Status RegisterInput(
+      int64_t guid, OpKernelContext* context,
+      const string& batcher_queue_name,
+      AsyncOpKernel::DoneCallback done_callback, int priority = 0,
+      absl::optional<int64_t> batch_timeout_micros = absl::nullopt);
 
  public:
   // One task to be batched, corresponds to a `slice` of input from one batch-op
@@ -126,25 +137,37 @@ class BatchResourceBase : public ResourceBase {
   using BatcherQueueT = BatchScheduler<BatchResourceBase::BatchTask>;
   using BatchT = Batch<BatchResourceBase::BatchTask>;
 
+  // When 'enable_ragged_batching' is true, request inputs are treated as
+  // pre-packed along the 0th dimension (e.g. the tokens of variable-length
+  // sequences flattened to [num_rows, ...]), and the batch function receives
+  // one extra int64 row-splits tensor appended after the batched inputs,
+  // holding the request boundaries within the packed dimension. See
+  // ConcatInputTensors() for the exact layout. Combined with
+  // 'allowed_batch_sizes', which rounds the packed dimension up to a small
+  // set of sizes, this avoids padding every request to the longest sequence.
   BatchResourceBase(bool has_process_batch_function,
                     std::shared_ptr<BatcherT> batcher,
                     const BatcherT::QueueOptions& batcher_queue_options,
-                    std::vector<int32> allowed_batch_sizes)
+                    std::vector<int32> allowed_batch_sizes,
+                    bool enable_ragged_batching = false)
       : has_process_batch_function_(has_process_batch_function),
         batcher_(std::move(batcher)),
         batcher_queue_options_(batcher_queue_options),
-        allowed_batch_sizes_(std::move(allowed_batch_sizes)) {
+        allowed_batch_sizes_(std::move(allowed_batch_sizes)),
+        enable_ragged_batching_(enable_ragged_batching) {
     allowed_batch_sizes_str_ = absl::StrJoin(allowed_batch_sizes_, ",");
   }
 
   BatchResourceBase(bool has_process_batch_function,
                     std::shared_ptr<AdaptiveBatcherT> batcher,
                     const AdaptiveBatcherT::QueueOptions& batcher_queue_options,
-                    std::vector<int32> allowed_batch_sizes)
+                    std::vector<int32> allowed_batch_sizes,
+                    bool enable_ragged_batching = false)
       : has_process_batch_function_(has_process_batch_function),
         adaptive_batcher_(std::move(batcher)),
         adaptive_batcher_queue_options_(batcher_queue_options),
-        allowed_batch_sizes_(std::move(allowed_batch_sizes)) {}
+        allowed_batch_sizes_(std::move(allowed_batch_sizes)),
+        enable_ragged_batching_(enable_ragged_batching) {}
 
   static BatcherT::QueueOptions GetBatcherQueueOptions(
       int32_t num_batch_threads, int32_t max_batch_size,
@@ -239,9 +262,11 @@ class BatchResourceBase : public ResourceBase {
                                 int output_index);
 
   // Looks up the batcher queue for 'queue_name'. If it did't previously exist,
-  // creates it.
-  Status LookupOrCreateBatcherQueue(const string& queue_name,
-                                    BatcherQueueT** queue);
+  // creates it with the given scheduling priority tier and, if set, a
+  // queue-specific batch timeout in place of the resource-wide one.
+  Status LookupOrCreateBatcherQueue(
+      const string& queue_name, int priority,
+      absl::optional<int64_t> batch_timeout_micros, BatcherQueueT** queue);
 
   // True if user specified a batch processing function for this resource.
   const bool has_process_batch_function_;
@@ -264,6 +289,11 @@ class BatchResourceBase : public ResourceBase {
   // A concatenated string of <allowed_batch_sizes_>, separated by ",". This is
   // used to record batching parameter.
   string allowed_batch_sizes_str_;
+
+  // Whether request inputs are pre-packed along the 0th dimension and the
+  // batch function receives a row-splits tensor with the request boundaries.
+  // See the constructor comment.
+  const bool enable_ragged_batching_ = false;
 };
 
 }  // namespace serving
@@ -218,6 +218,16 @@ class SharedBatchScheduler
     // submit batches whose size is in a small set of allowed sizes, that can be
     // done by adding padding in the process-batch callback.
     size_t max_execution_batch_size = 1000;
+
+    // The scheduling priority tier of the queue. Batch threads always take
+    // work from the highest-priority tier that has a schedulable batch,
+    // round-robining between queues within a tier, so batches from
+    // higher-priority queues are dispatched ahead of queued batches from
+    // lower-priority queues sharing the scheduler. Tiers can be combined with
+    // per-queue 'batch_timeout_micros' and batch size options to serve
+    // latency-sensitive and bulk traffic from one scheduler. Queues left at
+    // the default tier retain the pure round-robin behavior.
+    int priority = 0;
   };
   Status AddQueue(const QueueOptions& options,
                   std::function<void(std::unique_ptr<Batch<TaskType>>)>
@@ -293,6 +303,11 @@ namespace internal {
 // but the queue isn't full, then that batch is closed and a new open batch is
 // started.
 //
+// For queues that do not split tasks, submitted tasks are first appended to a
+// staging buffer guarded by its own mutex, and are moved into the open batch
+// by the scheduler threads. This keeps request threads off 'mu_', so they
+// never contend with batch formation or the batch-processing bookkeeping.
+//
 // Batch pull requests are handled by dequeuing the front-most batch if it is
 // closed. If the front-most batch is open (i.e. the queue contains only one
 // batch) and has reached the timeout, it is immediately closed and returned;
@@ -328,6 +343,11 @@ class Queue {
   // dequeued (out of mutex-protected area).
   Status ScheduleWithLazySplit(std::unique_ptr<TaskType>* task);
 
+  // Enqueue `task` by appending it to the staging buffer, without taking
+  // 'mu_'. Staged tasks are moved into 'batches_' by the scheduler threads in
+  // `ScheduleBatch`. Used iff the queue does neither eager nor lazy splitting.
+  Status ScheduleWithStaging(std::unique_ptr<TaskType>* task);
+
   // Returns the number of enqueued tasks, with the same semantics as
   // BatchScheduler::NumEnqueuedTasks().
   size_t NumEnqueuedTasks() const;
@@ -361,6 +381,14 @@ class Queue {
   // processed.
   bool IsEmpty() const;
 
+  // Determines whether a call to ScheduleBatch() would currently return a
+  // batch. Used by the scheduler to find the highest-priority tier with
+  // available work before committing to a queue.
+  bool HasSchedulableBatch() const;
+
+  // Returns the scheduling priority tier the queue was configured with.
+  int priority() const { return options_.priority; }
+
   // Marks the queue closed, and waits until it is empty.
   void CloseAndWaitUntilEmpty();
 
@@ -390,6 +418,11 @@ class Queue {
   // fresh open batch behind it.
   void StartNewBatch() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Moves all tasks in 'staged_tasks_' into 'batches_', in submission order.
+  // Called by `ScheduleBatchWithEagerSplit` before making batch-formation
+  // decisions.
+  void DrainStagedTasks() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_, staging_mu_);
+
   // Split `input task` into `output_tasks` according to 'task_sizes'.
   Status SplitInputBatchIntoSubtasks(
       std::unique_ptr<TaskType>* input_task,
@@ -484,6 +517,24 @@ class Queue {
   // 'empty_notification_->Notify()'.
   Notification* empty_notification_ TF_GUARDED_BY(mu_) = nullptr;
 
+  // Guards the staging buffer. Acquired after 'mu_' when both are held.
+  // Request threads hold it only for O(1) work, so they contend with each
+  // other briefly but never with batch formation (which holds 'mu_').
+  mutable mutex staging_mu_ TF_ACQUIRED_AFTER(mu_);
+
+  // Tasks accepted by `ScheduleWithStaging` but not yet placed into
+  // 'batches_'. Drained by the scheduler threads in `ScheduleBatch`.
+  //
+  // Used iff the queue does neither eager nor lazy splitting.
+  std::vector<std::unique_ptr<TaskType>> staged_tasks_
+      TF_GUARDED_BY(staging_mu_);
+
+  // The number of batches, and the size of the open (back-most) batch, that
+  // 'batches_' will contain once 'staged_tasks_' has been drained. Maintained
+  // so the capacity check on the request path does not need 'mu_'.
+  size_t staged_num_batches_ TF_GUARDED_BY(staging_mu_) = 1;
+  size_t staged_tail_batch_size_ TF_GUARDED_BY(staging_mu_) = 0;
+
   TF_DISALLOW_COPY_AND_ASSIGN(Queue);
 };
 
@@ -666,6 +717,22 @@ void SharedBatchScheduler<TaskType>::GetNextWorkItem_Locked(
   BatchUniquePtr batch_to_process;
   internal::Queue<TaskType>* queue_for_batch = nullptr;
   const int num_queues = queues_.size();
+
+  // Determine the highest priority tier that currently has a schedulable
+  // batch. Queues outside that tier are passed over below, so batches from
+  // higher-priority queues preempt queued batches from lower-priority ones.
+  // When all queues use the default tier this reduces to pure round-robin.
+  bool schedulable_tier_found = false;
+  int schedulable_tier_priority = 0;
+  for (const auto& queue : queues_) {
+    if (queue->HasSchedulableBatch() &&
+        (!schedulable_tier_found ||
+         queue->priority() > schedulable_tier_priority)) {
+      schedulable_tier_priority = queue->priority();
+      schedulable_tier_found = true;
+    }
+  }
+
   for (int num_queues_tried = 0;
        (BatchExists(batch_to_process)) && num_queues_tried < num_queues;
        ++num_queues_tried) {
@@ -677,8 +744,12 @@ void SharedBatchScheduler<TaskType>::GetNextWorkItem_Locked(
     // calling ScheduleBatch().
     const bool queue_closed = (*next_queue_to_schedule_)->closed();
 
-    // Ask '*next_queue_to_schedule_' if it wants us to process a batch.
-    batch_to_process = (*next_queue_to_schedule_)->ScheduleBatch();
+    // Ask '*next_queue_to_schedule_' if it wants us to process a batch,
+    // unless it sits below the highest priority tier with available work.
+    if (!schedulable_tier_found ||
+        (*next_queue_to_schedule_)->priority() == schedulable_tier_priority) {
+      batch_to_process = (*next_queue_to_schedule_)->ScheduleBatch();
+    }
 
     if (!BatchExists(batch_to_process)) {
       queue_for_batch = next_queue_to_schedule_->get();
@@ -800,9 +871,64 @@ Status Queue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
   if (options_.enable_lazy_split) {
     return ScheduleWithLazySplit(std::move(task));
   }
+  if (!options_.enable_large_batch_splitting) {
+    // Tasks that never need splitting go through the staging buffer, keeping
+    // request threads off 'mu_'.
+    return ScheduleWithStaging(task);
+  }
   return ScheduleWithoutOrEagerSplit(std::move(task));
 }
 
+template <typename TaskType>
+Status Queue<TaskType>::ScheduleWithStaging(std::unique_ptr<TaskType>* task) {
+  profiler::TraceMe trace_me([task] {
+    return profiler::TraceMeEncode(
+        "ScheduleWithStaging", {{"batching_input_task_size", (*task)->size()}});
+  });
+
+  bool notify_of_schedulable_batch = false;
+  {
+    mutex_lock l(staging_mu_);
+
+    DCHECK(!closed());
+
+    // Mirror of the capacity check in BatchTaskExceedQueueCapacity(), applied
+    // to the post-drain queue shape. (The no-split capacity check is loose by
+    // design; see the comment there.)
+    if (staged_tail_batch_size_ + (*task)->size() >
+        options_.input_batch_size_limit) {
+      if (staged_num_batches_ >= options_.max_enqueued_batches) {
+        return errors::Unavailable(
+            "The batch scheduling queue to which this task was submitted is "
+            "full");
+      }
+      // This task will close the open batch and start a new one, making the
+      // closed batch eligible for scheduling.
+      ++staged_num_batches_;
+      staged_tail_batch_size_ = 0;
+      notify_of_schedulable_batch = true;
+    }
+    staged_tail_batch_size_ += (*task)->size();
+    staged_tasks_.push_back(std::move(*task));
+
+    // Fast-path size check: only wake a scheduler thread when the open batch
+    // reaches a batch boundary, or is immediately schedulable because the
+    // queue has no timeout. Otherwise the periodic scheduler-thread poll picks
+    // the staged tasks up, and the request thread avoids the condition
+    // variable signal as well as 'mu_'.
+    if (staged_tail_batch_size_ >= max_execution_batch_size() ||
+        options_.batch_timeout_micros == 0) {
+      notify_of_schedulable_batch = true;
+    }
+  }
+
+  if (notify_of_schedulable_batch) {
+    schedulable_batch_callback_();
+  }
+
+  return OkStatus();
+}
+
 template <typename TaskType>
 Status Queue<TaskType>::ScheduleWithLazySplit(std::unique_ptr<TaskType>* task) {
   profiler::TraceMe trace_me([task] {
@@ -951,6 +1077,10 @@ template <typename TaskType>
 size_t Queue<TaskType>::NumEnqueuedTasks() const {
   size_t num_enqueued_tasks = 0;
   mutex_lock l(mu_);
+  {
+    mutex_lock staging_l(staging_mu_);
+    num_enqueued_tasks += staged_tasks_.size();
+  }
   if (options_.enable_lazy_split) {
     for (const auto& batch : task_handle_batches_) {
       num_enqueued_tasks += batch->num_tasks();
@@ -966,6 +1096,19 @@ size_t Queue<TaskType>::NumEnqueuedTasks() const {
 
 template <typename TaskType>
 size_t Queue<TaskType>::SchedulingCapacity() const {
+  if (!options_.enable_large_batch_splitting) {
+    // For staging queues the post-drain queue shape is tracked under
+    // 'staging_mu_', so capacity can be answered without touching 'mu_'.
+    mutex_lock l(staging_mu_);
+    const int64_t num_new_batches_schedulable =
+        static_cast<int64_t>(options_.max_enqueued_batches) -
+        staged_num_batches_;
+    const int64_t execution_batch_size_limit = max_execution_batch_size();
+    const int64_t open_batch_capacity =
+        execution_batch_size_limit - staged_tail_batch_size_;
+    return (num_new_batches_schedulable * execution_batch_size_limit) +
+           open_batch_capacity;
+  }
   mutex_lock l(mu_);
   return SchedulingCapacityInternal();
 }
@@ -1020,6 +1163,11 @@ Queue<TaskType>::ScheduleBatchWithEagerSplit() {
 
   {
     mutex_lock l(mu_);
+    mutex_lock staging_l(staging_mu_);
+
+    // Move any tasks submitted via the staging buffer into 'batches_' before
+    // making batch-formation decisions.
+    DrainStagedTasks();
 
     // Consider closing the open batch at this time, to schedule it.
     if (batches_.size() == 1 && IsOpenBatchSchedulable()) {
@@ -1034,11 +1182,41 @@ Queue<TaskType>::ScheduleBatchWithEagerSplit() {
     } else {
       schedulable_batch_ = false;
     }
+
+    // Re-derive the post-drain queue shape used by the request-path capacity
+    // check, now that 'batches_' has changed.
+    staged_num_batches_ = batches_.size();
+    staged_tail_batch_size_ = batches_.back()->size();
   }
 
   return batch_to_schedule;
 }
 
+template <typename TaskType>
+void Queue<TaskType>::DrainStagedTasks() {
+  for (int i = 0; i < staged_tasks_.size(); ++i) {
+    std::unique_ptr<TaskType>& task = staged_tasks_[i];
+    if (batches_.back()->size() + task->size() > max_execution_batch_size()) {
+      StartNewBatch();
+    }
+    if (batches_.back()->empty()) {
+      // The open batch's start time is recorded at drain time rather than at
+      // enqueue time. Drains happen at least once per scheduler-thread poll,
+      // so the skew is bounded by the poll granularity in ThreadLogic().
+      open_batch_start_time_micros_ = env_->NowMicros();
+    }
+    profiler::TraceMeProducer trace_me(
+        [&task] {
+          return profiler::TraceMeEncode("ScheduleOutputTask",
+                                         {{"size", task->size()}});
+        },
+        profiler::ContextType::kSharedBatchScheduler,
+        batches_.back()->traceme_context_id());
+    batches_.back()->AddTask(std::move(task));
+  }
+  staged_tasks_.clear();
+}
+
 template <typename TaskType>
 typename SharedBatchScheduler<TaskType>::BatchUniquePtr
 Queue<TaskType>::ScheduleBatch() {
@@ -1098,6 +1276,27 @@ bool Queue<TaskType>::IsEmpty() const {
   return IsEmptyInternal();
 }
 
+template <typename TaskType>
+bool Queue<TaskType>::HasSchedulableBatch() const {
+  mutex_lock l(mu_);
+  {
+    mutex_lock staging_l(staging_mu_);
+    // Staged tasks yield a batch upon drain if they complete a batch, or
+    // immediately for queues with no timeout.
+    if (!staged_tasks_.empty() &&
+        (options_.batch_timeout_micros == 0 ||
+         staged_num_batches_ > static_cast<size_t>(num_enqueued_batches()) ||
+         staged_tail_batch_size_ >= max_execution_batch_size())) {
+      return true;
+    }
+  }
+  if (num_enqueued_batches() >= 2) {
+    // There is at least one closed batch.
+    return true;
+  }
+  return IsOpenBatchSchedulable();
+}
+
 template <typename TaskType>
 void Queue<TaskType>::CloseAndWaitUntilEmpty() {
   Notification empty;
@@ -1116,6 +1315,12 @@ void Queue<TaskType>::CloseAndWaitUntilEmpty() {
 
 template <typename TaskType>
 bool Queue<TaskType>::IsEmptyInternal() const {
+  {
+    mutex_lock staging_l(staging_mu_);
+    if (!staged_tasks_.empty()) {
+      return false;
+    }
+  }
   if (options_.enable_lazy_split) {
     return num_batches_being_processed_ == 0 &&
            task_handle_batches_.size() == 1 &&
@@ -109,6 +109,38 @@ struct LaunchGeneric {
           input.shaped<T, 2>({conv_width, filter.dim_size(2)}),
           filter.shaped<T, 2>({filter.dim_size(2), filter.dim_size(3)}),
           dim_pair);
+    } else if (filter.dim_size(0) == 1 && filter.dim_size(1) == 1 &&
+               (padding == SAME || padding == VALID)) {
+      // For a 1x1 kernel with spatial stride, each output pixel reads exactly
+      // one input pixel, so gather the strided pixels and reduce the
+      // convolution to a single matrix multiplication, skipping the patch
+      // extraction machinery entirely. A 1x1 kernel never pads under SAME, so
+      // SAME and VALID agree here, and dilation has no effect.
+      const int64_t in_depth = filter.dim_size(2);
+      const int64_t out_depth = filter.dim_size(3);
+      int64_t conv_width = 1;  // Width for the convolution step.
+      for (int i = 0; i < 3; ++i) {
+        conv_width *= output->dim_size(i);
+      }
+
+      Tensor strided_input;
+      OP_REQUIRES_OK(
+          ctx, ctx->allocate_temp(
+                   input.dtype(),
+                   TensorShape({output->dim_size(0), output->dim_size(1),
+                                output->dim_size(2), in_depth}),
+                   &strided_input));
+      Eigen::array<Eigen::DenseIndex, 4> strides{1, row_stride, col_stride, 1};
+      strided_input.tensor<T, 4>().device(ctx->eigen_device<Device>()) =
+          input.tensor<T, 4>().stride(strides);
+
+      Eigen::array<Eigen::IndexPair<Eigen::DenseIndex>, 1> dim_pair;
+      dim_pair[0] = Eigen::IndexPair<Eigen::DenseIndex>(1, 0);
+      functor::MatMulConvFunctor<Device, T>()(
+          ctx->eigen_device<Device>(),
+          output->shaped<T, 2>({conv_width, out_depth}),
+          strided_input.shaped<T, 2>({conv_width, in_depth}),
+          filter.shaped<T, 2>({in_depth, out_depth}), dim_pair);
     } else if (filter.dim_size(0) == input.dim_size(1) &&
                filter.dim_size(1) == input.dim_size(2) && row_dilation == 1 &&
                col_dilation == 1 && padding == VALID) {
@@ -83,7 +83,8 @@ static Tensor MakeRandomTensor(const TensorShape& shape) {
 template <typename T>
 static Conv2DGraph Conv2D(int batch, int height, int width, int in_depth,
                           int filter_w, int filter_h, int out_depth,
-                          TensorFormat data_format = FORMAT_NHWC) {
+                          TensorFormat data_format = FORMAT_NHWC,
+                          int stride = 1) {
   Graph* graph = new Graph(OpRegistry::Global());
 
   Tensor images_t = data_format == FORMAT_NHWC
@@ -105,7 +106,7 @@ static Conv2DGraph Conv2D(int batch, int height, int width, int in_depth,
   TF_CHECK_OK(builder.Input(images)
                   .Input(filter)
                   .Attr("T", DataTypeToEnum<T>::value)
-                  .Attr("strides", {1, 1, 1, 1})
+                  .Attr("strides", {1, stride, stride, 1})
                   .Attr("padding", "SAME")
                   .Attr("data_format", ToString(data_format))
                   .Finalize(graph, &conv2d));
@@ -347,6 +348,19 @@ static Graph* FusedConv2DWithBatchNorm(
   BENCHMARK(BM_NAME(BM_Conv2D, type, N, H, W, C, FW, FH, FC))           \
       ->Arg(/*unused arg*/ 1);
 
+#define BM_Conv2DStrided(N, H, W, C, FW, FH, FC, S, type, LABEL)           \
+  static void BM_NAME(BM_Conv2DStrided##S, type, N, H, W, C, FW, FH,       \
+                      FC)(::testing::benchmark::State & state) {           \
+    test::Benchmark(                                                       \
+        #type,                                                             \
+        Conv2D<float>(N, H, W, C, FW, FH, FC, FORMAT_NHWC, S).graph,       \
+        /*old_benchmark_api=*/false)                                       \
+        .Run(state);                                                       \
+    BM_SET_INFO(N, H, W, C, type, LABEL, Conv2D);                          \
+  }                                                                        \
+  BENCHMARK(BM_NAME(BM_Conv2DStrided##S, type, N, H, W, C, FW, FH, FC))    \
+      ->Arg(/*unused arg*/ 1);
+
 #define BM_Conv2DWithBias(N, H, W, C, FW, FH, FC, type, LABEL)           \
   static void BM_NAME(BM_Conv2DWithBias, type, N, H, W, C, FW, FH,       \
                       FC)(::testing::benchmark::State & state) {         \
@@ -466,6 +480,13 @@ BM_Conv2D(8, 32, 32, 128, 1, 1, 1024, cpu, "1x1 /b 8");
 BM_Conv2D(16, 32, 32, 128, 1, 1, 1024, cpu, "1x1 /b 16");
 BM_Conv2D(32, 32, 32, 128, 1, 1, 1024, cpu, "1x1 /b 32");
 
+// Strided 1x1 convolution (e.g. ResNet downsampling projections): strided
+// gather + MatMulFunctor instead of the patch extraction path.
+
+BM_Conv2DStrided(8, 32, 32, 128, 1, 1, 1024, 2, cpu, "1x1 s2 /b 8");
+BM_Conv2DStrided(16, 32, 32, 128, 1, 1, 1024, 2, cpu, "1x1 s2 /b 16");
+BM_Conv2DStrided(32, 32, 32, 128, 1, 1, 1024, 2, cpu, "1x1 s2 /b 32");
+
 // 1) BiasAdd {+ Relu}
 
 BM_Conv2DWithBias(8, 32, 32, 128, 1, 1, 1024, cpu, "1x1 /b 8");
@@ -425,6 +425,47 @@ class ConvOpTest : public OpsTestBase {
     test::ExpectTensorNear<float>(expected, output, 1e-5);
   }
 
+  void StridedPointwise() {
+    const int stride = 2;
+    TF_EXPECT_OK(NodeDefBuilder("conv_op", "Conv2D")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Attr("T", DT_FLOAT)
+                     .Attr("strides", {1, stride, stride, 1})
+                     .Attr("padding", "SAME")
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+    const int depth = 2;
+    const int image_width = 4;
+    const int image_height = 3;
+    const int image_batch_count = 1;
+    // Channel 0 of pixel i (in row-major order) holds i + 1, channel 1 holds
+    // 100 + i + 1.
+    Tensor image(DT_FLOAT,
+                 {image_batch_count, image_height, image_width, depth});
+    test::FillValues<float>(&image, {1, 101, 2,  102, 3,  103, 4,  104,  //
+                                     5, 105, 6,  106, 7,  107, 8,  108,  //
+                                     9, 109, 10, 110, 11, 111, 12, 112});
+
+    // A 1x1 filter mapping two input channels to one output channel as
+    // c0 + 10 * c1; with stride 2 the kernel reads pixels 1, 3, 9 and 11.
+    const int filter_count = 1;
+    Tensor filter(DT_FLOAT, {1, 1, depth, filter_count});
+    test::FillValues<float>(&filter, {1, 10});
+
+    AddInputFromArray<float>(image.shape(), image.flat<float>());
+    AddInputFromArray<float>(filter.shape(), filter.flat<float>());
+    TF_ASSERT_OK(RunOpKernel());
+
+    const int expected_width = 2;
+    const int expected_height = 2;
+    Tensor expected(DT_FLOAT, TensorShape({image_batch_count, expected_height,
+                                           expected_width, filter_count}));
+    test::FillValues<float>(&expected, {1011, 1033, 1099, 1121});
+    const Tensor& output = *GetOutput(0);
+    test::ExpectTensorNear<float>(expected, output, 1e-5);
+  }
+
   void AnisotropicStrides() {
     const int stride_width = 3;
     const int stride_height = 1;
@@ -473,6 +514,8 @@ TEST_F(ConvOpTest, HandwrittenConv) { HandwrittenConv(); }
 
 TEST_F(ConvOpTest, AnisotropicStride) { AnisotropicStrides(); }
 
+TEST_F(ConvOpTest, StridedPointwise) { StridedPointwise(); }
+
 template <typename T>
 class FusedConv2DOpTest : public OpsTestBase {
  protected:
@@ -32,9 +32,18 @@ limitations under the License.
 #include "tensorflow/core/kernels/cwise_ops.h"
 #include "tensorflow/core/kernels/cwise_ops_gradients.h"
 #include "tensorflow/core/kernels/fill_functor.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/bcast.h"
 
+// Runtime ISA dispatch is available for a few dense arithmetic loops on
+// x86-64 when the compiler supports per-function target attributes. The
+// binary stays compiled for its baseline ISA; the dispatched loops below are
+// compiled for wider vector extensions and selected per host with CPUID.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__ANDROID__)
+#define TF_CWISE_RUNTIME_VECTOR_DISPATCH 1
+#endif
+
 namespace tensorflow {
 
 typedef Eigen::ThreadPoolDevice CPUDevice;
@@ -354,6 +363,82 @@ void Assign(const D& d, Out out, Rhs rhs) {
   out.device(d) = rhs;
 }
 
+// `DenseBinaryLoop` maps a cwise functor to a runtime-dispatched dense inner
+// loop. Functors without a specialization keep the Eigen expression path,
+// which is vectorized for the ISA the binary was compiled for. Only
+// per-element IEEE arithmetic is dispatched here, so the result does not
+// depend on which loop version runs.
+template <typename Functor>
+struct DenseBinaryLoop {
+  static constexpr bool kEnabled = false;
+};
+
+#ifdef TF_CWISE_RUNTIME_VECTOR_DISPATCH
+
+#define TF_CWISE_DISPATCHED_LOOP(FUNCTOR, TYPE, OP)                          \
+  template <>                                                                \
+  struct DenseBinaryLoop<FUNCTOR<TYPE>> {                                    \
+    static constexpr bool kEnabled = true;                                   \
+    __attribute__((target("avx512f"))) static void RunAvx512(                \
+        const TYPE* x, const TYPE* y, TYPE* z, int64_t n) {                  \
+      for (int64_t i = 0; i < n; ++i) {                                      \
+        z[i] = x[i] OP y[i];                                                 \
+      }                                                                      \
+    }                                                                        \
+    static void RunBaseline(const TYPE* x, const TYPE* y, TYPE* z,           \
+                            int64_t n) {                                     \
+      for (int64_t i = 0; i < n; ++i) {                                      \
+        z[i] = x[i] OP y[i];                                                 \
+      }                                                                      \
+    }                                                                        \
+    static void Run(const TYPE* x, const TYPE* y, TYPE* z, int64_t n) {      \
+      static const bool use_avx512 =                                         \
+          port::TestCPUFeature(port::CPUFeature::AVX512F);                   \
+      if (use_avx512) {                                                      \
+        RunAvx512(x, y, z, n);                                               \
+      } else {                                                               \
+        RunBaseline(x, y, z, n);                                             \
+      }                                                                      \
+    }                                                                        \
+  };
+
+TF_CWISE_DISPATCHED_LOOP(add, float, +)
+TF_CWISE_DISPATCHED_LOOP(add, double, +)
+TF_CWISE_DISPATCHED_LOOP(sub, float, -)
+TF_CWISE_DISPATCHED_LOOP(sub, double, -)
+TF_CWISE_DISPATCHED_LOOP(mul, float, *)
+TF_CWISE_DISPATCHED_LOOP(mul, double, *)
+TF_CWISE_DISPATCHED_LOOP(div, float, /)
+TF_CWISE_DISPATCHED_LOOP(div, double, /)
+
+#undef TF_CWISE_DISPATCHED_LOOP
+
+#endif  // TF_CWISE_RUNTIME_VECTOR_DISPATCH
+
+// Runs the dispatched loop for `Functor` over the flat inputs, sharded across
+// the intra-op pool like the Eigen expression it replaces. Returns false when
+// no dispatched loop exists so the caller can fall through to Eigen.
+template <typename Functor>
+bool MaybeRunDispatchedDenseLoop(const CPUDevice& d,
+                                 typename Functor::tout_type out,
+                                 typename Functor::tin_type in0,
+                                 typename Functor::tin_type in1) {
+  using Loop = DenseBinaryLoop<Functor>;
+  if constexpr (Loop::kEnabled) {
+    using T = typename Functor::out_type;
+    const T* x = in0.data();
+    const T* y = in1.data();
+    T* z = out.data();
+    const Eigen::TensorOpCost cost(2 * sizeof(T), sizeof(T), 1);
+    d.parallelFor(out.size(), cost,
+                  [x, y, z](Eigen::Index begin, Eigen::Index end) {
+                    Loop::Run(x + begin, y + begin, z + begin, end - begin);
+                  });
+    return true;
+  }
+  return false;
+}
+
 // Partial specialization of BinaryFunctor<Device=CPUDevice, Functor, NDIMS>
 // for functors with no error checking.
 template <typename Functor, int NDIMS>
@@ -361,6 +446,7 @@ struct BinaryFunctor<CPUDevice, Functor, NDIMS, false> {
   void operator()(const CPUDevice& d, typename Functor::tout_type out,
                   typename Functor::tin_type in0,
                   typename Functor::tin_type in1, bool* error) {
+    if (MaybeRunDispatchedDenseLoop<Functor>(d, out, in0, in1)) return;
     Assign(d, out, in0.binaryExpr(in1, typename Functor::func()));
   }
 
@@ -422,6 +508,7 @@ struct BinaryFunctor<CPUDevice, Functor, 2, false> {
   void operator()(const CPUDevice& d, typename Functor::tout_type out,
                   typename Functor::tin_type in0,
                   typename Functor::tin_type in1, bool* error) {
+    if (MaybeRunDispatchedDenseLoop<Functor>(d, out, in0, in1)) return;
     Assign(d, out, in0.binaryExpr(in1, typename Functor::func()));
   }
 
@@ -755,12 +755,26 @@ class DataServiceDatasetOp::Dataset : public DatasetBase {
     }
 
     Status AddTask(const TaskInfo& task_info) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-      TF_ASSIGN_OR_RETURN(
-          std::unique_ptr<DataServiceWorkerClient> worker,
+      StatusOr<std::unique_ptr<DataServiceWorkerClient>> worker =
           CreateDataServiceWorkerClient(task_info.transfer_address(),
                                         dataset()->protocol_,
-                                        dataset()->data_transfer_protocol_));
-      tasks_.push_back(std::make_shared<Task>(task_info, std::move(worker)));
+                                        dataset()->data_transfer_protocol_);
+      if (!worker.ok() &&
+          dataset()->data_transfer_protocol_ != kGrpcTransferProtocol) {
+        // An alternative transfer protocol may only work for some workers,
+        // e.g. shared memory transfer requires the worker to be colocated.
+        LOG(WARNING) << "Failed to create a "
+                     << dataset()->data_transfer_protocol_
+                     << " transfer client for worker "
+                     << task_info.worker_address() << ": " << worker.status()
+                     << ". Falling back to gRPC.";
+        worker = CreateDataServiceWorkerClient(
+            task_info.worker_address(), dataset()->protocol_,
+            kGrpcTransferProtocol);
+      }
+      TF_RETURN_IF_ERROR(worker.status());
+      tasks_.push_back(
+          std::make_shared<Task>(task_info, std::move(worker.value())));
       worker_thread_cv_.notify_one();
       if (StrictRoundRobin()) {
         VLOG(1) << "Consumer " << dataset()->consumer_index_.value()
@@ -425,8 +425,9 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
       }
 
       std::shared_ptr<std::vector<Tensor>> return_values =
-          std::make_shared<std::vector<Tensor>>();
-      auto done = [this, ctx, result, return_values, offset](Status status) {
+          BorrowReturnValuesBuffer();
+      auto done = [this, ctx, result, return_values,
+                   offset](Status status) mutable {
         if (dataset()->preserve_cardinality_ && errors::IsOutOfRange(status)) {
           // To guarantee that the transformation preserves the cardinality of
           // the dataset, we convert `OutOfRange` to `InvalidArgument` as the
@@ -458,9 +459,9 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
                     offset);
                 break;
               }
-              // TODO(mrry): Add a version of DoParallelConcat that allows us
-              // to move `tensor` where possible, to speed up string tensor
-              // batching.
+              // `CopyElementToSlice` moves `tensor` into the batch where the
+              // element type supports it (e.g. string tensors), so the copy
+              // below is elided for those components.
               Status copy_status = batch_util::CopyElementToSlice(
                   std::move(tensor), batch, offset);
               if (!copy_status.ok()) {
@@ -474,6 +475,7 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
             result->num_elements++;
           }
         }
+        RecycleReturnValuesBuffer(std::move(return_values));
         CallCompleted(ctx, result);
       };
 
@@ -505,6 +507,35 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
       }
     }
 
+    // Returns a buffer to hold the map function's output for one element,
+    // reusing the buffer of a completed call when one is available. Buffers
+    // are recycled through `return_values_pool_` so that producing an element
+    // does not allocate (and free) a vector and shared_ptr control block.
+    std::shared_ptr<std::vector<Tensor>> BorrowReturnValuesBuffer()
+        TF_LOCKS_EXCLUDED(*mu_) {
+      mutex_lock l(*mu_);
+      if (return_values_pool_.empty()) {
+        return std::make_shared<std::vector<Tensor>>();
+      }
+      std::shared_ptr<std::vector<Tensor>> buffer =
+          std::move(return_values_pool_.back());
+      return_values_pool_.pop_back();
+      return buffer;
+    }
+
+    // Returns `buffer` to `return_values_pool_` for reuse by a future call.
+    // The pool is bounded by the parallelism so that a transient burst of
+    // calls does not pin buffer memory for the lifetime of the iterator.
+    void RecycleReturnValuesBuffer(std::shared_ptr<std::vector<Tensor>> buffer)
+        TF_LOCKS_EXCLUDED(*mu_) {
+      buffer->clear();
+      mutex_lock l(*mu_);
+      if (return_values_pool_.size() <
+          static_cast<size_t>(num_parallel_calls_->value)) {
+        return_values_pool_.push_back(std::move(buffer));
+      }
+    }
+
     Status EnsureOutputAllocated(
         const std::shared_ptr<IteratorContext>& ctx,
         const std::shared_ptr<BatchResult>& result,
@@ -682,6 +713,10 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
     // `batch_results_`, call `RecordBufferEnqueue` or `RecordBufferDequeue`
     // respectively.
     std::deque<std::shared_ptr<BatchResult>> batch_results_ TF_GUARDED_BY(*mu_);
+    // Recycled buffers for the map function's per-element output. See
+    // `BorrowReturnValuesBuffer`.
+    std::vector<std::shared_ptr<std::vector<Tensor>>> return_values_pool_
+        TF_GUARDED_BY(*mu_);
     // Determines whether the transformation has been cancelled.
     bool cancelled_ TF_GUARDED_BY(*mu_) = false;
     // Identifies the number of callers currently waiting for a batch result.
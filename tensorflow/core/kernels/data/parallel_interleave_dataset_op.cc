@@ -81,6 +81,8 @@ namespace data {
 /* static */ constexpr const char* const
     ParallelInterleaveDatasetOp::kDeterministic;
 /* static */ constexpr const char* const ParallelInterleaveDatasetOp::kSloppy;
+/* static */ constexpr const char* const
+    ParallelInterleaveDatasetOp::kResultSkewBound;
 
 namespace {
 
@@ -163,7 +165,8 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
           std::unique_ptr<CapturedFunction> captured_func, int64_t cycle_length,
           int64_t block_length, int64_t buffer_output_elements,
           int64_t prefetch_input_elements, int64_t num_parallel_calls,
-          DeterminismPolicy deterministic, const DataTypeVector& output_types,
+          DeterminismPolicy deterministic, int64_t result_skew_bound,
+          const DataTypeVector& output_types,
           const std::vector<PartialTensorShape>& output_shapes, int op_version)
       : DatasetBase(DatasetContext(ctx)),
         input_(input),
@@ -176,6 +179,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
             prefetch_input_elements, cycle_length)),
         num_parallel_calls_(num_parallel_calls),
         deterministic_(deterministic),
+        result_skew_bound_(result_skew_bound),
         output_types_(output_types),
         output_shapes_(output_shapes),
         op_version_(op_version),
@@ -300,6 +304,11 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       b->BuildAttrValue(deterministic_.String(), &deterministic_attr);
       attrs.emplace_back(kDeterministic, deterministic_attr);
     }
+    if (result_skew_bound_ > 0) {
+      AttrValue result_skew_bound_attr;
+      b->BuildAttrValue(result_skew_bound_, &result_skew_bound_attr);
+      attrs.emplace_back(kResultSkewBound, result_skew_bound_attr);
+    }
 
     TF_RETURN_IF_ERROR(b->AddDataset(this, inputs, list_inputs, attrs, output));
     return OkStatus();
@@ -316,6 +325,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
               params.dataset->num_parallel_calls_, mu_,
               num_parallel_calls_cond_var_)),
           deterministic_(deterministic),
+          steal_credits_(params.dataset->result_skew_bound_),
           current_elements_(params.dataset->cycle_length_) {}
 
     ~ParallelInterleaveIterator() override { CancelThreads(/*wait=*/true); }
@@ -684,10 +694,28 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       // available.
       for (int i = 0; i < dataset()->cycle_length_; ++i) {
         if (ConsumeHelper(result)) {
+          steal_credits_ = dataset()->result_skew_bound_;
           return true;
         }
         AdvanceToNextInCycle();
       }
+      // No cycle element has a result buffered. If a skew bound is set, steal
+      // a bounded number of results from prefetched future elements so that a
+      // straggling cycle element does not stall the output. Only the front of
+      // an element's result queue is consumed, so per-element result order is
+      // preserved. The credits are replenished whenever a cycle element
+      // produces a result, which bounds how far the output can run ahead of
+      // the straggler.
+      if (steal_credits_ > 0) {
+        for (auto& element : future_elements_) {
+          if (element && !element->results.empty()) {
+            std::swap(*result, element->results.front());
+            element->results.pop_front();
+            --steal_credits_;
+            return true;
+          }
+        }
+      }
       return false;
     }
 
@@ -1556,6 +1584,12 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
     // Determines whether outputs can be produced in deterministic order.
     const bool deterministic_;
 
+    // Number of results that may still be consumed from future cycle elements
+    // while no current cycle element has a result buffered. Replenished to
+    // `result_skew_bound_` whenever a current element produces a result. Only
+    // used when `deterministic` is false.
+    int64_t steal_credits_ TF_GUARDED_BY(mu_);
+
     // Controls cancellation of `input_impl_`. Must be ordered before
     // `input_impl_` so that `input_impl_` is destroyed first.
     std::unique_ptr<CancellationManager> cancellation_manager_;
@@ -1623,6 +1657,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
   const int64_t prefetch_input_elements_;
   const int64_t num_parallel_calls_;
   const DeterminismPolicy deterministic_;
+  const int64_t result_skew_bound_;
   const DataTypeVector output_types_;
   const std::vector<PartialTensorShape> output_shapes_;
   const int op_version_;
@@ -1653,6 +1688,13 @@ ParallelInterleaveDatasetOp::ParallelInterleaveDatasetOp(
     OP_REQUIRES_OK(
         ctx, DeterminismPolicy::FromString(deterministic, &deterministic_));
   }
+  if (ctx->HasAttr(kResultSkewBound)) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr(kResultSkewBound, &result_skew_bound_));
+    OP_REQUIRES(ctx, result_skew_bound_ >= 0,
+                errors::InvalidArgument("`", kResultSkewBound,
+                                        "` must be >= 0 but is ",
+                                        result_skew_bound_));
+  }
 }
 
 void ParallelInterleaveDatasetOp::MakeDataset(OpKernelContext* ctx,
@@ -1726,7 +1768,8 @@ void ParallelInterleaveDatasetOp::MakeDataset(OpKernelContext* ctx,
   *output = new Dataset(
       ctx, input, std::move(captured_func), cycle_length, block_length,
       buffer_output_elements, prefetch_input_elements, num_parallel_calls,
-      deterministic_, output_types_, output_shapes_, op_version_);
+      deterministic_, result_skew_bound_, output_types_, output_shapes_,
+      op_version_);
 }
 
 namespace {
@@ -40,6 +40,13 @@ class ParallelInterleaveDatasetOp : public UnaryDatasetOpKernel {
   static constexpr const char* const kOutputShapes = "output_shapes";
   static constexpr const char* const kDeterministic = "deterministic";
   static constexpr const char* const kSloppy = "sloppy";
+  // Optional attribute. When set to N > 0 (and `deterministic` is false),
+  // a consumer that finds no result buffered in the current interleave cycle
+  // may consume up to N results from prefetched future cycle elements before
+  // it has to wait for a current element again.  This bounds how far the
+  // output stream can run ahead of a straggling cycle element instead of
+  // letting the straggler cap pipeline throughput.
+  static constexpr const char* const kResultSkewBound = "_result_skew_bound";
 
   explicit ParallelInterleaveDatasetOp(OpKernelConstruction* ctx);
 
@@ -54,6 +61,7 @@ class ParallelInterleaveDatasetOp : public UnaryDatasetOpKernel {
   DataTypeVector output_types_;
   std::vector<PartialTensorShape> output_shapes_;
   DeterminismPolicy deterministic_;
+  int64_t result_skew_bound_ = 0;
 };
 
 }  // namespace data
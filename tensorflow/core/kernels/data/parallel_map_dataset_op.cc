@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/parallel_map_dataset_op.h"
 
+#include <algorithm>
 #include <deque>
 
 #include "tensorflow/core/common_runtime/function.h"
@@ -26,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/stats_aggregator.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/platform/stringprintf.h"
@@ -54,6 +56,8 @@ namespace data {
 /* static */ constexpr const char* const ParallelMapDatasetOp::kSloppy;
 /* static */ constexpr const char* const
     ParallelMapDatasetOp::kPreserveCardinality;
+/* static */ constexpr const char* const
+    ParallelMapDatasetOp::kVectorizedBatchSize;
 
 namespace {
 
@@ -79,17 +83,19 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
           const std::vector<PartialTensorShape>& output_shapes,
           DeterminismPolicy deterministic,
           std::unique_ptr<CapturedFunction> captured_func,
-          bool preserve_cardinality, int op_version)
+          bool preserve_cardinality, int64_t vectorized_batch_size,
+          int op_version)
       : Dataset(DatasetContext(ctx), input, num_parallel_calls, output_types,
                 output_shapes, deterministic, std::move(captured_func),
-                preserve_cardinality, op_version) {}
+                preserve_cardinality, vectorized_batch_size, op_version) {}
 
   Dataset(DatasetContext dataset_context, const DatasetBase* input,
           int64_t num_parallel_calls, const DataTypeVector& output_types,
           const std::vector<PartialTensorShape>& output_shapes,
           DeterminismPolicy deterministic,
           std::unique_ptr<CapturedFunction> captured_func,
-          bool preserve_cardinality, int op_version)
+          bool preserve_cardinality, int64_t vectorized_batch_size,
+          int op_version)
       : DatasetBase(std::move(dataset_context)),
         input_(input),
         num_parallel_calls_(num_parallel_calls),
@@ -97,6 +103,7 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
         output_shapes_(output_shapes),
         deterministic_(deterministic),
         preserve_cardinality_(preserve_cardinality),
+        vectorized_batch_size_(vectorized_batch_size),
         captured_func_(std::move(captured_func)),
         op_version_(op_version) {
     input_->Ref();
@@ -222,6 +229,13 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
     b->BuildAttrValue(preserve_cardinality_, &preserve_cardinality_attr);
     attrs.emplace_back(kPreserveCardinality, preserve_cardinality_attr);
 
+    // Attr: _vectorized_batch_size (only serialized when enabled)
+    if (vectorized_batch_size_ > 1) {
+      AttrValue vectorized_batch_size_attr;
+      b->BuildAttrValue(vectorized_batch_size_, &vectorized_batch_size_attr);
+      attrs.emplace_back(kVectorizedBatchSize, vectorized_batch_size_attr);
+    }
+
     TF_RETURN_IF_ERROR(b->AddDataset(
         this,
         {std::make_pair(0, input_graph_node),
@@ -470,15 +484,21 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
         CallCompleted(ctx, result);
         return;
       }
+      InvokeFunction(ctx, result, std::move(input_element));
+    }
 
+    // Applies the map function to `input_element`, storing the result in
+    // `result->return_values` and completing `result` when finished.
+    void InvokeFunction(const std::shared_ptr<IteratorContext>& ctx,
+                        const std::shared_ptr<InvocationResult>& result,
+                        std::vector<Tensor> input_element)
+        TF_LOCKS_EXCLUDED(*mu_) {
       auto done = [this, ctx, result](Status status) {
         result->status.Update(status);
         RecordBufferEnqueue(ctx.get(), result->return_values);
         CallCompleted(ctx, result);
       };
 
-      // Apply the map function on `input_element`, storing the result in
-      // `result->return_values`, and invoking `done` when finished.
       if (dataset()->captured_func_->use_inter_op_parallelism()) {
         instantiated_captured_func_->RunAsync(
             ctx.get(), std::move(input_element), &result->return_values,
@@ -511,6 +531,149 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
       }
     }
 
+    // Applies the map function to up to `vectorized_batch_size` input
+    // elements with a single invocation: the fetched elements are stacked
+    // along a new leading dimension, the function runs once on the stacked
+    // batch, and its outputs are unstacked into the per-element `results`.
+    // Groups whose component shapes do not match fall back to one invocation
+    // per element, so the mode degrades to regular behavior rather than
+    // failing on ragged inputs.
+    void CallBatchedFunction(
+        const std::shared_ptr<IteratorContext>& ctx,
+        std::vector<std::shared_ptr<InvocationResult>> results)
+        TF_LOCKS_EXCLUDED(*mu_) {
+      std::vector<std::shared_ptr<InvocationResult>> pending;
+      std::vector<std::vector<Tensor>> input_elements;
+      pending.reserve(results.size());
+      input_elements.reserve(results.size());
+      bool reached_end_of_input = false;
+      for (const auto& result : results) {
+        if (reached_end_of_input) {
+          // A per-element call would observe end-of-input here as well.
+          result->end_of_input = true;
+          CallCompleted(ctx, result);
+          continue;
+        }
+        std::vector<Tensor> input_element;
+        result->status = input_impl_->GetNext(ctx.get(), &input_element,
+                                              &result->end_of_input);
+        if (result->end_of_input || !result->status.ok()) {
+          reached_end_of_input = result->end_of_input;
+          CallCompleted(ctx, result);
+          continue;
+        }
+        pending.push_back(result);
+        input_elements.push_back(std::move(input_element));
+      }
+      if (pending.empty()) {
+        return;
+      }
+      if (pending.size() == 1) {
+        InvokeFunction(ctx, pending[0], std::move(input_elements[0]));
+        return;
+      }
+      // Stacking requires every element to agree on per-component shapes.
+      for (size_t i = 1; i < input_elements.size(); ++i) {
+        for (size_t c = 0; c < input_elements[i].size(); ++c) {
+          if (input_elements[i][c].shape() != input_elements[0][c].shape()) {
+            for (size_t j = 0; j < pending.size(); ++j) {
+              InvokeFunction(ctx, pending[j], std::move(input_elements[j]));
+            }
+            return;
+          }
+        }
+      }
+      const int64_t batch_size = pending.size();
+      auto batched_result = std::make_shared<InvocationResult>();
+      batched_result->status = CopyBatch(CopyBatchParams(ctx.get()),
+                                         input_elements,
+                                         /*parallel_copy=*/false,
+                                         /*allocation_callback=*/nullptr,
+                                         &batched_result->return_values);
+      if (!batched_result->status.ok()) {
+        for (const auto& result : pending) {
+          result->status = batched_result->status;
+          CallCompleted(ctx, result);
+        }
+        return;
+      }
+      std::vector<Tensor> batched_inputs =
+          std::move(batched_result->return_values);
+      batched_result->return_values.clear();
+
+      auto done = [this, ctx, batched_result, pending,
+                   batch_size](Status status) {
+        status.Update(UnstackBatchedResult(ctx, *batched_result, pending,
+                                           batch_size, status));
+        for (const auto& result : pending) {
+          result->status.Update(status);
+          RecordBufferEnqueue(ctx.get(), result->return_values);
+          CallCompleted(ctx, result);
+        }
+      };
+
+      if (dataset()->captured_func_->use_inter_op_parallelism()) {
+        instantiated_captured_func_->RunAsync(
+            ctx.get(), std::move(batched_inputs),
+            &batched_result->return_values, std::move(done), model_node());
+      } else {
+        auto fn = std::bind(
+            [this, ctx, batched_result](std::vector<Tensor> batched_inputs) {
+              return instantiated_captured_func_->Run(
+                  ctx.get(), std::move(batched_inputs),
+                  &batched_result->return_values, model_node());
+            },
+            std::move(batched_inputs));
+        (*ctx->runner())(
+            [this, ctx, fn = std::move(fn), done = std::move(done)]() {
+              Status s;
+              if (IsRecording(ctx.get())) {
+                s = fn();
+              } else {
+                RecordStart(ctx.get());
+                s = fn();
+                RecordStop(ctx.get());
+              }
+              done(s);
+            });
+      }
+    }
+
+    // Distributes the outputs of a batched invocation to the per-element
+    // results by slicing along the leading dimension.  Rows are aliased when
+    // properly aligned and copied otherwise.
+    Status UnstackBatchedResult(
+        const std::shared_ptr<IteratorContext>& ctx,
+        const InvocationResult& batched_result,
+        const std::vector<std::shared_ptr<InvocationResult>>& pending,
+        int64_t batch_size, const Status& status) TF_LOCKS_EXCLUDED(*mu_) {
+      if (!status.ok()) {
+        return OkStatus();
+      }
+      for (const Tensor& t : batched_result.return_values) {
+        if (t.dims() == 0 || t.dim_size(0) != batch_size) {
+          return errors::InvalidArgument(
+              "Vectorized map function must return outputs with a leading "
+              "dimension equal to the number of stacked elements (",
+              batch_size, "), but got shape: ", t.shape().DebugString(),
+              ". The function is likely not batch-polymorphic; unset ",
+              kVectorizedBatchSize, ".");
+        }
+      }
+      for (int64_t i = 0; i < batch_size; ++i) {
+        pending[i]->return_values.reserve(
+            batched_result.return_values.size());
+        for (const Tensor& t : batched_result.return_values) {
+          Tensor row = t.SubSlice(i);
+          if (!row.IsAligned()) {
+            row = tensor::DeepCopy(row);
+          }
+          pending[i]->return_values.push_back(std::move(row));
+        }
+      }
+      return OkStatus();
+    }
+
     Status ProcessResult(IteratorContext* ctx,
                          const std::shared_ptr<InvocationResult>& result,
                          std::vector<Tensor>* out_tensors,
@@ -572,8 +735,23 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
           }
           cond_var_->notify_all();
         }
-        for (const auto& call : new_calls) {
-          CallFunction(ctx, call);
+        const int64_t vectorized_batch_size =
+            dataset()->vectorized_batch_size_;
+        if (vectorized_batch_size > 1) {
+          for (size_t i = 0; i < new_calls.size();
+               i += vectorized_batch_size) {
+            size_t group_size =
+                std::min(static_cast<size_t>(vectorized_batch_size),
+                         new_calls.size() - i);
+            CallBatchedFunction(
+                ctx, std::vector<std::shared_ptr<InvocationResult>>(
+                         new_calls.begin() + i,
+                         new_calls.begin() + i + group_size));
+          }
+        } else {
+          for (const auto& call : new_calls) {
+            CallFunction(ctx, call);
+          }
         }
         new_calls.clear();
       }
@@ -713,6 +891,7 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
   const std::vector<PartialTensorShape> output_shapes_;
   const DeterminismPolicy deterministic_;
   const bool preserve_cardinality_;
+  const int64_t vectorized_batch_size_;
   const std::unique_ptr<CapturedFunction> captured_func_;
   const int op_version_;
   // This is used for random access provided by Get().
@@ -747,6 +926,14 @@ ParallelMapDatasetOp::ParallelMapDatasetOp(OpKernelConstruction* ctx)
   }
   OP_REQUIRES_OK(ctx,
                  ctx->GetAttr(kPreserveCardinality, &preserve_cardinality_));
+  if (ctx->HasAttr(kVectorizedBatchSize)) {
+    OP_REQUIRES_OK(ctx,
+                   ctx->GetAttr(kVectorizedBatchSize, &vectorized_batch_size_));
+    OP_REQUIRES(ctx, vectorized_batch_size_ >= 1,
+                errors::InvalidArgument(kVectorizedBatchSize,
+                                        " must be >= 1 but is ",
+                                        vectorized_batch_size_));
+  }
 }
 
 void ParallelMapDatasetOp::MakeDataset(OpKernelContext* ctx, DatasetBase* input,
@@ -778,7 +965,7 @@ void ParallelMapDatasetOp::MakeDataset(OpKernelContext* ctx, DatasetBase* input,
   *output =
       new Dataset(ctx, input, num_parallel_calls, output_types_, output_shapes_,
                   deterministic_, std::move(captured_func),
-                  preserve_cardinality_, op_version_);
+                  preserve_cardinality_, vectorized_batch_size_, op_version_);
 }
 
 std::unique_ptr<DatasetBase> MakeDataServiceUncompressDataset(
@@ -793,7 +980,8 @@ std::unique_ptr<DatasetBase> MakeDataServiceUncompressDataset(
       /*num_parallel_calls=*/model::kAutotune, output_types, output_shapes,
       DeterminismPolicy(DeterminismPolicy::Type::kDefault),
       std::move(captured_function),
-      /*preserve_cardinality=*/true, /*op_version=*/2);
+      /*preserve_cardinality=*/true, /*vectorized_batch_size=*/1,
+      /*op_version=*/2);
 }
 
 namespace {
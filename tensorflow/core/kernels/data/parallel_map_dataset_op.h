@@ -38,6 +38,14 @@ class ParallelMapDatasetOp : public UnaryDatasetOpKernel {
   static constexpr const char* const kSloppy = "sloppy";
   static constexpr const char* const kPreserveCardinality =
       "preserve_cardinality";
+  // Optional attribute. When set to N > 1, the iterator applies the map
+  // function to N input elements at a time: the elements are stacked along a
+  // new leading dimension, the function is invoked once on the stacked batch,
+  // and its outputs are unstacked into per-element results. This is only
+  // correct for functions that are batch-polymorphic (e.g. elementwise math),
+  // so it must be set deliberately, typically by a graph rewrite.
+  static constexpr const char* const kVectorizedBatchSize =
+      "_vectorized_batch_size";
 
   explicit ParallelMapDatasetOp(OpKernelConstruction* ctx);
 
@@ -54,6 +62,7 @@ class ParallelMapDatasetOp : public UnaryDatasetOpKernel {
   bool sloppy_;
   bool preserve_cardinality_;
   DeterminismPolicy deterministic_;
+  int64_t vectorized_batch_size_ = 1;
 
   friend std::unique_ptr<DatasetBase> MakeDataServiceUncompressDataset(
       DatasetBase* input, std::unique_ptr<CapturedFunction> captured_function,
@@ -159,11 +159,16 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     ~Iterator() override {
       CancelThreads();
       if (deregister_fn_) deregister_fn_();
+      mutex_lock l(*mu_);
+      if (model_ && buffer_bytes_ > 0) {
+        model_->RecordPrefetchedBytes(-buffer_bytes_);
+      }
     }
 
     Status Initialize(IteratorContext* ctx) override {
       mutex_lock l(*mu_);
       interleave_depth_ = ctx->interleave_depth();
+      model_ = ctx->model();
 
       if (buffer_size_->value == model::kAutotune) {
         buffer_size_->value = buffer_size_min_;
@@ -298,18 +303,20 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           }
         }
         RecordBufferEnqueue(ctx, buffer_element.value);
+        RecordBufferBytes(GetAllocatedBytes(buffer_element.value));
       }
       return OkStatus();
     }
 
     data::TraceMeMetadata GetTraceMeMetadata() const override {
-      int64_t limit = -1, size = -1;
+      int64_t limit = -1, size = -1, bytes = -1;
       data::TraceMeMetadata result;
       // NOTE: We only set the parallelism value if the lock can be acquired
       // right away to avoid introducing tracing overhead.
       if (mu_->try_lock()) {
         limit = buffer_limit();
         size = buffer_.size();
+        bytes = buffer_bytes_;
         if (!buffer_.empty()) {
           std::vector<std::string> shapes(buffer_.front().value.size());
           for (const auto& component : buffer_.front().value) {
@@ -329,6 +336,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           "buffer_size",
           size == -1 ? kTraceInfoUnavailable
                      : strings::Printf("%lld", static_cast<long long>(size))));
+      result.push_back(std::make_pair(
+          "buffer_bytes",
+          bytes == -1
+              ? kTraceInfoUnavailable
+              : strings::Printf("%lld", static_cast<long long>(bytes))));
       result.push_back(std::make_pair(
           "autotune",
           dataset()->buffer_size_ == model::kAutotune ? "true" : "false"));
@@ -366,6 +378,29 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       return buffer_size_->value;
     }
 
+    // Returns true if fetching another element should wait because the bytes
+    // already resident in the prefetch buffers of this pipeline exhaust the
+    // autotuning RAM budget.  The accounting uses actual allocated sizes and
+    // is shared across all prefetch stages through the model, so a stage
+    // holding a few huge elements throttles the others.  Each stage is always
+    // allowed one buffered element so the pipeline cannot deadlock on a
+    // single over-budget element.
+    bool RamBudgetExhausted() const TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) {
+      if (!model_ || buffer_.empty()) {
+        return false;
+      }
+      const int64_t ram_budget = model_->ram_budget();
+      return ram_budget > 0 && model_->prefetched_bytes() >= ram_budget;
+    }
+
+    // Adjusts the byte accounting of the buffer by `delta` bytes.
+    void RecordBufferBytes(int64_t delta) TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) {
+      buffer_bytes_ += delta;
+      if (model_) {
+        model_->RecordPrefetchedBytes(delta);
+      }
+    }
+
     void CancelThreads() TF_LOCKS_EXCLUDED(mu_) {
       cancellation_manager_->StartCancel();
       mutex_lock l(*mu_);
@@ -392,6 +427,7 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       }
       // A new element is available. Forward the status from computing it, and
       // (if we successfully got an element) the output values.
+      RecordBufferBytes(-GetAllocatedBytes(buffer_.front().value));
       Status s = buffer_.front().status;
       if (s.ok()) {
         int64_t buffer_element_id = buffer_.front().uid;
@@ -461,7 +497,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         // 1. Wait for a slot in the buffer.
         {
           mutex_lock l(*mu_);
-          while (!cancelled_ && buffer_.size() >= buffer_limit()) {
+          // A stage blocked on the RAM budget always holds at least one
+          // element, so a local Consume is guaranteed to eventually wake it;
+          // no cross-stage notification is needed.
+          while (!cancelled_ &&
+                 (buffer_.size() >= buffer_limit() || RamBudgetExhausted())) {
             RecordStop(ctx.get());
             cond_var_->wait(l);
             RecordStart(ctx.get());
@@ -511,6 +551,7 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         {
           mutex_lock l(*mu_);
           RecordBufferEnqueue(ctx.get(), buffer_element.value);
+          RecordBufferBytes(GetAllocatedBytes(buffer_element.value));
           buffer_element.created_us = EnvTime::NowMicros();
           buffer_.push_back(std::move(buffer_element));
           cond_var_->notify_all();
@@ -574,6 +615,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     const int64_t buffer_size_min_;
     PrefetchAutotuner auto_tuner_ TF_GUARDED_BY(*mu_);
     std::deque<BufferElement> buffer_ TF_GUARDED_BY(*mu_);
+    // The model shared by all iterators of the pipeline, used for the
+    // cross-stage RAM budget accounting; null when modeling is disabled.
+    std::shared_ptr<model::Model> model_ TF_GUARDED_BY(*mu_);
+    // Actual allocated bytes of the elements in `buffer_`.
+    int64_t buffer_bytes_ TF_GUARDED_BY(*mu_) = 0;
     bool cancelled_ TF_GUARDED_BY(*mu_) = false;
     bool prefetch_thread_finished_ TF_GUARDED_BY(*mu_) = false;
     const bool legacy_autotune_;
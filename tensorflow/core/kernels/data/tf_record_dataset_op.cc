@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/utils.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -25,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -52,6 +54,72 @@ bool is_cloud_tpu_gcs_fs() {
   return false;
 }
 
+// Whether uncompressed files may be read through a memory mapping instead of
+// a buffered input stream. Mapping skips the copy into the stream buffer and
+// serves repeated epochs of local files straight from the page cache.
+bool MmapEnabled() {
+  static const bool result = [] {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_TFRECORD_DATASET_MMAP",
+                                  /*default_val=*/false, &enabled);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to parse TF_DATA_TFRECORD_DATASET_MMAP: "
+                   << s.error_message();
+    }
+    return enabled;
+  }();
+  return result;
+}
+
+// Whether records read through a memory mapping are returned as tstring
+// views over the mapped bytes instead of owned copies. The produced tensors
+// keep the mapping alive, so a single retained tensor pins its whole file in
+// memory; hence a separate opt-in. Implies mapping uncompressed files.
+bool ZeroCopyEnabled() {
+  static const bool result = [] {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_TFRECORD_DATASET_ZERO_COPY",
+                                  /*default_val=*/false, &enabled);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to parse TF_DATA_TFRECORD_DATASET_ZERO_COPY: "
+                   << s.error_message();
+    }
+    return enabled;
+  }();
+  return result;
+}
+
+namespace {
+
+// Holds one record as a tstring view over a mapped file. The buffer shares
+// ownership of the mapping, tying its lifetime to the produced tensor, so
+// the view stays valid for as long as any downstream op holds the tensor.
+class MappedRecordTensorBuffer : public TensorBuffer {
+ public:
+  MappedRecordTensorBuffer(std::shared_ptr<ReadOnlyMemoryRegion> region,
+                           StringPiece record)
+      : TensorBuffer(&str_), region_(std::move(region)) {
+    str_ = tstring::view(record.data(), record.size());
+  }
+
+  size_t size() const override { return sizeof(tstring); }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size());
+    proto->set_allocated_bytes(size());
+    proto->set_allocator_name("mmap_tfrecord");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  ~MappedRecordTensorBuffer() override {}
+
+  const std::shared_ptr<ReadOnlyMemoryRegion> region_;
+  tstring str_;
+};
+
+}  // namespace
+
 class TFRecordDatasetOp::Dataset : public DatasetBase {
  public:
   explicit Dataset(OpKernelContext* ctx, std::vector<string> filenames,
@@ -122,10 +190,26 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       do {
         // We are currently processing a file, so try to read the next record.
         if (reader_) {
-          out_tensors->emplace_back(ctx->allocator({}), DT_STRING,
-                                    TensorShape({}));
-          Status s =
-              reader_->ReadRecord(&out_tensors->back().scalar<tstring>()());
+          Status s;
+          if (region_ && ZeroCopyEnabled()) {
+            // Produce a view over the mapped record bytes instead of
+            // copying them; the tensor buffer keeps the mapping alive.
+            StringPiece record;
+            s = reader_->ReadRecord(&record);
+            if (s.ok()) {
+              TensorBuffer* buffer =
+                  new MappedRecordTensorBuffer(region_, record);
+              out_tensors->emplace_back(DT_STRING, TensorShape({}), buffer);
+              buffer->Unref();
+            }
+          } else {
+            out_tensors->emplace_back(ctx->allocator({}), DT_STRING,
+                                      TensorShape({}));
+            s = reader_->ReadRecord(&out_tensors->back().scalar<tstring>()());
+            if (!s.ok()) {
+              out_tensors->pop_back();
+            }
+          }
           if (s.ok()) {
             static monitoring::CounterCell* bytes_counter =
                 metrics::GetTFDataBytesReadCounter(kDatasetType);
@@ -134,7 +218,6 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
             *end_of_sequence = false;
             return OkStatus();
           }
-          out_tensors->pop_back();
           if (!errors::IsOutOfRange(s)) {
             // In case of other errors e.g., DataLoss, we still move forward
             // the file index so that it works with ignore_errors.
@@ -247,9 +330,25 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       }
 
       // Actually move on to next file.
-      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
-          TranslateFileName(dataset()->filenames_[current_file_index_]),
-          &file_));
+      const string filename =
+          TranslateFileName(dataset()->filenames_[current_file_index_]);
+      if ((MmapEnabled() || ZeroCopyEnabled()) &&
+          dataset()->options_.compression_type ==
+              io::RecordReaderOptions::NONE) {
+        std::unique_ptr<ReadOnlyMemoryRegion> region;
+        Status s = env->NewReadOnlyMemoryRegionFromFile(filename, &region);
+        if (s.ok()) {
+          region_ = std::move(region);
+          reader_ = absl::make_unique<io::SequentialRecordReader>(
+              region_.get(), dataset()->options_);
+          return OkStatus();
+        }
+        // Fall back to streaming reads for file systems that cannot map
+        // (e.g. GCS, S3).
+        VLOG(2) << "Failed to memory-map " << filename << ": " << s
+                << ". Falling back to streaming reads.";
+      }
+      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file_));
       reader_ = absl::make_unique<io::SequentialRecordReader>(
           file_.get(), dataset()->options_);
       return OkStatus();
@@ -259,14 +358,18 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     void ResetStreamsLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       reader_.reset();
       file_.reset();
+      region_.reset();
     }
 
     mutex mu_;
     size_t current_file_index_ TF_GUARDED_BY(mu_) = 0;
 
-    // `reader_` will borrow the object that `file_` points to, so
-    // we must destroy `reader_` before `file_`.
+    // `reader_` will borrow the object that `file_` (or `region_`) points
+    // to, so we must destroy `reader_` before either of them. Zero-copy
+    // output tensors share ownership of `region_`, so a mapping may outlive
+    // the iterator's reference to it.
     std::unique_ptr<RandomAccessFile> file_ TF_GUARDED_BY(mu_);
+    std::shared_ptr<ReadOnlyMemoryRegion> region_ TF_GUARDED_BY(mu_);
     std::unique_ptr<io::SequentialRecordReader> reader_ TF_GUARDED_BY(mu_);
   };
 
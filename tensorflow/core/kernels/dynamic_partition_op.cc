@@ -15,12 +15,15 @@ limitations under the License.
 
 // See docs in ../ops/data_flow_ops.cc.
 
+#include <algorithm>
 #include <vector>
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/util/util.h"
 
@@ -39,9 +42,15 @@ class DynamicPartitionOp_Shared : public OpKernel {
     //   in the graph?
   }
 
+  // Validates the inputs, allocates the outputs, and fills `shard_offsets`
+  // with num_shards * num_partitions_ entries, where entry
+  // s * num_partitions_ + p is the output row at which shard s (covering the
+  // s-th contiguous block of `partitions`) starts writing rows of partition
+  // p. Shards cover ascending index ranges, so scattering every shard at its
+  // offsets reproduces the serial output order exactly.
   void ValidateAndAllocateOutputs(OpKernelContext* c, const Tensor** data,
-                                  const Tensor** partitions,
-                                  OpOutputList* Tout) {
+                                  const Tensor** partitions, OpOutputList* Tout,
+                                  std::vector<int64_t>* shard_offsets) {
     OP_REQUIRES_OK(c, c->input("data", data));
     OP_REQUIRES_OK(c, c->input("partitions", partitions));
     OP_REQUIRES(
@@ -52,33 +61,102 @@ class DynamicPartitionOp_Shared : public OpKernel {
             "got data.shape = ", (*data)->shape().DebugString(),
             ", partitions.shape = ", (*partitions)->shape().DebugString()));
 
-    // Count how many occurrences of each partition id we have in partitions
-    gtl::InlinedVector<int, 32> partition_count(num_partitions_);
     auto e_partitions = (*partitions)->flat<int32>();
     const int64_t N = e_partitions.dimension(0);
-    for (int64_t i = 0; i < N; i++) {
-      const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-      OP_REQUIRES(c, FastBoundsCheck(p, num_partitions_),
+    const int64_t num_shards = NumShards(c, N);
+    const int64_t block = (N + num_shards - 1) / num_shards;
+
+    // Count how many occurrences of each partition id each shard sees.
+    // Out-of-range ids are recorded per shard and reported after the join;
+    // shards cover ascending index ranges, so the first shard with a bad id
+    // holds the globally first one.
+    std::vector<int64_t> shard_count(num_shards * num_partitions_, 0);
+    std::vector<int64_t> bad_index(num_shards, -1);
+    std::vector<int32> bad_id(num_shards, 0);
+    auto count_shard = [&](int64_t s) {
+      int64_t* count = &shard_count[s * num_partitions_];
+      const int64_t begin = s * block;
+      const int64_t end = std::min(N, begin + block);
+      for (int64_t i = begin; i < end; i++) {
+        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+        if (!FastBoundsCheck(p, num_partitions_)) {
+          bad_index[s] = i;
+          bad_id[s] = p;
+          return;
+        }
+        count[p]++;
+      }
+    };
+    RunShards(c, num_shards, count_shard);
+    for (int64_t s = 0; s < num_shards; s++) {
+      OP_REQUIRES(c, bad_index[s] < 0,
                   errors::InvalidArgument(
-                      "partitions", SliceDebugString((*partitions)->shape(), i),
-                      " = ", p, " is not in [0, ", num_partitions_, ")"));
-      partition_count[p]++;
+                      "partitions",
+                      SliceDebugString((*partitions)->shape(), bad_index[s]),
+                      " = ", bad_id[s], " is not in [0, ", num_partitions_,
+                      ")"));
     }
 
     // Allocate output tensors of the right size
     OP_REQUIRES_OK(c, c->output_list("outputs", Tout));
     for (int p = 0; p < num_partitions_; p++) {
+      int64_t partition_count = 0;
+      for (int64_t s = 0; s < num_shards; s++) {
+        partition_count += shard_count[s * num_partitions_ + p];
+      }
       TensorShape shape;
-      shape.AddDim(partition_count[p]);
+      shape.AddDim(partition_count);
       for (int i = (*partitions)->dims(); i < (*data)->dims(); i++) {
         shape.AddDim((*data)->dim_size(i));
       }
       Tensor* out;
       OP_REQUIRES_OK(c, Tout->allocate(p, shape, &out));
     }
+
+    // Exclusive scan of the per-shard counts along the shard axis gives each
+    // shard its starting row in every partition's output.
+    shard_offsets->resize(num_shards * num_partitions_);
+    for (int p = 0; p < num_partitions_; p++) {
+      int64_t running = 0;
+      for (int64_t s = 0; s < num_shards; s++) {
+        (*shard_offsets)[s * num_partitions_ + p] = running;
+        running += shard_count[s * num_partitions_ + p];
+      }
+    }
   }
 
  protected:
+  // Number of elements each shard of the counting and scatter passes should
+  // own at a minimum; below this the serial loops beat the fork/join.
+  static constexpr int64_t kMinElementsPerShard = 1 << 15;
+
+  int64_t NumShards(OpKernelContext* c, int64_t N) const {
+    const int64_t num_threads =
+        c->device()->tensorflow_cpu_worker_threads()->num_threads;
+    return std::max<int64_t>(
+        1, std::min<int64_t>(num_threads, N / kMinElementsPerShard));
+  }
+
+  // Runs shard_fn(s) for s in [0, num_shards), on the intra-op pool when more
+  // than one shard was chosen.
+  template <typename ShardFn>
+  void RunShards(OpKernelContext* c, int64_t num_shards, ShardFn shard_fn) {
+    if (num_shards == 1) {
+      shard_fn(0);
+      return;
+    }
+    auto workers = c->device()->tensorflow_cpu_worker_threads()->workers;
+    BlockingCounter counter(num_shards - 1);
+    for (int64_t s = 1; s < num_shards; s++) {
+      workers->Schedule([&shard_fn, &counter, s]() {
+        shard_fn(s);
+        counter.DecrementCount();
+      });
+    }
+    shard_fn(0);
+    counter.Wait();
+  }
+
   int num_partitions_;
 };
 
@@ -91,13 +169,16 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
     const Tensor* data;
     const Tensor* partitions;
     OpOutputList outputs;
-    ValidateAndAllocateOutputs(c, &data, &partitions, &outputs);
+    std::vector<int64_t> shard_offsets;
+    ValidateAndAllocateOutputs(c, &data, &partitions, &outputs,
+                               &shard_offsets);
     if (!c->status().ok()) return;
     if (num_partitions_ == 0 || data->NumElements() == 0) return;
 
     auto e_partitions = partitions->flat<int32>();
     const int64_t N = e_partitions.dimension(0);
-    gtl::InlinedVector<int, 32> output_index(num_partitions_);
+    const int64_t num_shards = shard_offsets.size() / num_partitions_;
+    const int64_t block = (N + num_shards - 1) / num_shards;
 
     if (partitions->dims() == data->dims()) {
       // Walk through data and copy the data to the appropriate output tensor
@@ -109,19 +190,27 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
       for (int p = 0; p < num_partitions_; p++) {
         out_vec.push_back(outputs[p]->vec<T>());
       }
-      for (int64_t i = 0; i < N; i++) {
-        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-        OP_REQUIRES(
-            c, FastBoundsCheck(p, num_partitions_),
-            errors::InvalidArgument("indices[", i, "] is out of range"));
-        auto oi = output_index[p];
-        OP_REQUIRES(c, FastBoundsCheck(oi, out_vec[p].size()),
-                    errors::InvalidArgument(
-                        "out_vec[", p, "] size: ", out_vec[p].size(),
-                        " is not LTE output_index[", p, "] : ", oi));
-        out_vec[p](oi) = data_flat(i);
-        output_index[p]++;
-      }
+      auto scatter_shard = [&](int64_t s) {
+        gtl::InlinedVector<int64_t, 32> output_index(
+            shard_offsets.begin() + s * num_partitions_,
+            shard_offsets.begin() + (s + 1) * num_partitions_);
+        const int64_t begin = s * block;
+        const int64_t end = std::min(N, begin + block);
+        for (int64_t i = begin; i < end; i++) {
+          const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+          OP_REQUIRES(
+              c, FastBoundsCheck(p, num_partitions_),
+              errors::InvalidArgument("indices[", i, "] is out of range"));
+          auto oi = output_index[p];
+          OP_REQUIRES(c, FastBoundsCheck(oi, out_vec[p].size()),
+                      errors::InvalidArgument(
+                          "out_vec[", p, "] size: ", out_vec[p].size(),
+                          " is not LTE output_index[", p, "] : ", oi));
+          out_vec[p](oi) = data_flat(i);
+          output_index[p]++;
+        }
+      };
+      RunShards(c, num_shards, scatter_shard);
     } else {
       // If data has extra dimensions, use Eigen slices
       std::vector<Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>,
@@ -136,24 +225,32 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
       const int64_t slice_size = data->NumElements() / N;
       const auto data_flat = data->shaped<T, 2>({N, slice_size});
       Eigen::DSizes<Eigen::DenseIndex, 2> sizes(1, slice_size);
-      for (int64_t i = 0; i < N; i++) {
-        // outputs[p][output_index[p]++] = data[i]
-        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-        OP_REQUIRES(
-            c, FastBoundsCheck(p, num_partitions_),
-            errors::InvalidArgument("indices[", i,
-                                    "] has been asynchronously overwritten and "
-                                    "is no longer in range!"));
-        auto oi = output_index[p];
-        OP_REQUIRES(c, FastBoundsCheck(oi, out_flat[p].dimension(0)),
-                    errors::InvalidArgument("Size of output_index: ", oi,
-                                            " is no longer in range."));
-        Eigen::DSizes<Eigen::DenseIndex, 2> out_indices(oi, 0);
-        Eigen::DSizes<Eigen::DenseIndex, 2> data_indices(i, 0);
-        out_flat[p].slice(out_indices, sizes) =
-            data_flat.slice(data_indices, sizes);
-        output_index[p]++;
-      }
+      auto scatter_shard = [&](int64_t s) {
+        gtl::InlinedVector<int64_t, 32> output_index(
+            shard_offsets.begin() + s * num_partitions_,
+            shard_offsets.begin() + (s + 1) * num_partitions_);
+        const int64_t begin = s * block;
+        const int64_t end = std::min(N, begin + block);
+        for (int64_t i = begin; i < end; i++) {
+          // outputs[p][output_index[p]++] = data[i]
+          const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+          OP_REQUIRES(
+              c, FastBoundsCheck(p, num_partitions_),
+              errors::InvalidArgument("indices[", i,
+                                      "] has been asynchronously overwritten "
+                                      "and is no longer in range!"));
+          auto oi = output_index[p];
+          OP_REQUIRES(c, FastBoundsCheck(oi, out_flat[p].dimension(0)),
+                      errors::InvalidArgument("Size of output_index: ", oi,
+                                              " is no longer in range."));
+          Eigen::DSizes<Eigen::DenseIndex, 2> out_indices(oi, 0);
+          Eigen::DSizes<Eigen::DenseIndex, 2> data_indices(i, 0);
+          out_flat[p].slice(out_indices, sizes) =
+              data_flat.slice(data_indices, sizes);
+          output_index[p]++;
+        }
+      };
+      RunShards(c, num_shards, scatter_shard);
     }
   }
 };
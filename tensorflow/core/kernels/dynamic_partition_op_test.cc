@@ -15,6 +15,7 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/framework/allocator.h"
@@ -159,6 +160,33 @@ TEST_F(DynamicPartitionOpTest, Error_IndexOutOfRange) {
       << s;
 }
 
+TEST_F(DynamicPartitionOpTest, LargeInputKeepsInputOrder) {
+  MakeOp();
+
+  // Large enough that the kernel shards the counting and scatter passes
+  // across the intra-op pool when more than one thread is available.
+  const int64_t kRows = 1 << 17;
+  std::vector<float> data(kRows);
+  std::vector<int32> partitions(kRows);
+  std::vector<std::vector<float>> expected(4);
+  for (int64_t i = 0; i < kRows; i++) {
+    data[i] = static_cast<float>(i);
+    partitions[i] = (i * 7) % 4;
+    expected[partitions[i]].push_back(data[i]);
+  }
+  AddInputFromArray<float>(TensorShape({kRows}), data);
+  AddInputFromArray<int32>(TensorShape({kRows}), partitions);
+  TF_ASSERT_OK(RunOpKernel());
+
+  for (int p = 0; p < 4; p++) {
+    Tensor expected_tensor(
+        allocator(), DT_FLOAT,
+        TensorShape({static_cast<int64_t>(expected[p].size())}));
+    test::FillValues<float>(&expected_tensor, expected[p]);
+    test::ExpectTensorEqual<float>(expected_tensor, *GetOutput(p));
+  }
+}
+
 Node* DynamicPartitionNode(Graph* g, Node* in0, Node* in1, int num_partitions) {
   Node* ret;
   TF_CHECK_OK(NodeBuilder(g->NewName("n"), "DynamicPartition")
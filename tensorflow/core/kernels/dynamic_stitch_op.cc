@@ -15,6 +15,8 @@ limitations under the License.
 
 // See docs in ../ops/data_flow_ops.cc.
 
+#include <algorithm>
+
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -286,8 +288,36 @@ class DynamicStitchOpImplCPU : public DynamicStitchOpImplBase<T> {
           }
         }
       };
-      if (Parallel &&
-          c->device()->tensorflow_cpu_worker_threads()->num_threads > 1) {
+      const int num_threads =
+          c->device()->tensorflow_cpu_worker_threads()->num_threads;
+      if (Parallel && num_threads > 1 &&
+          DataTypeCanUseMemcpy(DataTypeToEnum<T>::v()) &&
+          indices_inputs.size() < num_threads) {
+        // With fewer inputs than threads, sharding across whole inputs leaves
+        // most of the pool idle; shard across the rows of each input instead.
+        // Rows with duplicate indices may then be written concurrently, which
+        // this op already permits across inputs.
+        auto thread_pool =
+            c->device()->tensorflow_cpu_worker_threads()->workers;
+        T* merged_base = merged_flat.data();
+        for (int input_num = 0; input_num < indices_inputs.size();
+             ++input_num) {
+          auto indices_vec = indices_inputs[input_num].flat<int32>();
+          const T* data_base = data_inputs[input_num].template flat<T>().data();
+          auto CopyRows = [&](int64_t first, int64_t last) {
+            for (int64_t i = first; i < last; i++) {
+              int32_t index = internal::SubtleMustCopy(indices_vec(i));
+              OP_REQUIRES(
+                  c, FastBoundsCheck(index, first_dim_size),
+                  errors::InvalidArgument("indices[", i, "] is out of range"));
+              memcpy(merged_base + index * slice_size,
+                     data_base + i * slice_size, slice_bytes);
+            }
+          };
+          thread_pool->ParallelFor(indices_vec.size(),
+                                   std::max<size_t>(slice_bytes, 1), CopyRows);
+        }
+      } else if (Parallel && num_threads > 1) {
         auto thread_pool =
             c->device()->tensorflow_cpu_worker_threads()->workers;
         size_t total_indices_size = 0;
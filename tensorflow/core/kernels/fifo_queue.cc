@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/kernels/queue_base.h"
+#include "tensorflow/core/kernels/ring_buffer_fifo_queue.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
@@ -34,6 +35,10 @@ limitations under the License.
 
 namespace tensorflow {
 
+namespace {
+constexpr char kUseRingBufferAttr[] = "_use_ring_buffer";
+}  // namespace
+
 FIFOQueue::FIFOQueue(int capacity, const DataTypeVector& component_dtypes,
                      const std::vector<TensorShape>& component_shapes,
                      const string& name)
@@ -373,9 +378,18 @@ Status FIFOQueue::MatchesNodeDef(const NodeDef& node_def) {
 FIFOQueueOp::FIFOQueueOp(OpKernelConstruction* context)
     : TypedQueueOp(context) {
   OP_REQUIRES_OK(context, context->GetAttr("shapes", &component_shapes_));
+  if (context->HasAttr(kUseRingBufferAttr)) {
+    OP_REQUIRES_OK(context,
+                   context->GetAttr(kUseRingBufferAttr, &use_ring_buffer_));
+  }
 }
 
 Status FIFOQueueOp::CreateResource(QueueInterface** ret) {
+  if (use_ring_buffer_ && capacity_ > 0 && capacity_ != QueueBase::kUnbounded) {
+    RingBufferFIFOQueue* queue = new RingBufferFIFOQueue(
+        capacity_, component_types_, component_shapes_, cinfo_.name());
+    return CreateTypedQueue(queue, ret);
+  }
   FIFOQueue* queue = new FIFOQueue(capacity_, component_types_,
                                    component_shapes_, cinfo_.name());
   return CreateTypedQueue(queue, ret);
@@ -83,6 +83,11 @@ class FIFOQueueOp : public TypedQueueOp {
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   std::vector<TensorShape> component_shapes_;
+  // True if the optional node attr `_use_ring_buffer` is set. Backs the
+  // queue with a lock-free MPMC ring buffer (RingBufferFIFOQueue) instead of
+  // mutex-guarded deques. Treated as a hint: queues with an unbounded
+  // capacity fall back to the regular FIFOQueue.
+  bool use_ring_buffer_ = false;
   TF_DISALLOW_COPY_AND_ASSIGN(FIFOQueueOp);
 };
 
@@ -522,7 +522,10 @@ INSTANTIATE_TYPED_TEST_SUITE_P(Test, FusedBatchNormExOpTrainingTest,
 // -------------------------------------------------------------------------- //
 // FusedBatchNormEx[is_training=false].
 
-#if defined(GOOGLE_CUDA)
+// In non-CUDA builds the tests exercise the default CPU kernel, which supports
+// inference fusion for float only (with oneDNN the op is rewritten away, see
+// mkl_fused_batch_norm_op.cc).
+#if defined(GOOGLE_CUDA) || !defined(INTEL_MKL)
 template <typename T>
 using FusedBatchNormExOpInferenceTest =
     FusedBatchNormExOpTestBase<T, float>;  // scale is always float
@@ -550,10 +553,14 @@ REGISTER_TYPED_TEST_SUITE_P(FusedBatchNormExOpInferenceTest,  //
                             InferenceWithReluInNHWCTest,      //
                             InferenceWithSideInputAndReluInNHWCTest);
 
+#if defined(GOOGLE_CUDA)
 using FusedBatchNormExInferenceDataTypes = ::testing::Types<Eigen::half, float>;
+#else
+using FusedBatchNormExInferenceDataTypes = ::testing::Types<float>;
+#endif  // defined(GOOGLE_CUDA)
 INSTANTIATE_TYPED_TEST_SUITE_P(Test, FusedBatchNormExOpInferenceTest,
                                FusedBatchNormExInferenceDataTypes);
-#endif  // defined(GOOGLE_CUDA)
+#endif  // defined(GOOGLE_CUDA) || !defined(INTEL_MKL)
 
 // -------------------------------------------------------------------------- //
 // Performance benchmarks are below.                                          //
@@ -241,14 +241,13 @@ struct FusedBatchNorm<CPUDevice, T, U, /* is_training= */ false> {
                   Tensor* batch_var_output, Tensor* saved_mean_output,
                   Tensor* saved_var_output, TensorFormat tensor_format,
                   bool use_reserved_space) {
-    OP_REQUIRES(context, side_input == nullptr,
-                errors::Internal(
-                    "The CPU implementation of FusedBatchNorm does not support "
-                    "side input."));
+    // A side input is added in the layout of y, so it would need its own
+    // transpose below; only the NHWC fast path supports it.
     OP_REQUIRES(context,
-                activation_mode == FusedBatchNormActivationMode::kIdentity,
-                errors::Internal("The CPU implementation of FusedBatchNorm "
-                                 "does not support activations."));
+                side_input == nullptr || tensor_format == FORMAT_NHWC,
+                errors::Internal(
+                    "The CPU implementation of FusedBatchNorm with side input "
+                    "supports only NHWC tensor format."));
 
     if (use_reserved_space) {
       Tensor* dummy_reserve_space = nullptr;
@@ -329,7 +328,24 @@ struct FusedBatchNorm<CPUDevice, T, U, /* is_training= */ false> {
         (x_scaled + offset.reshape(one_by_depth).broadcast(bcast_spec))
             .template cast<T>();
 
-    y.reshape(rest_by_depth).device(d) = x_shifted;
+    // Fold the optional residual side input and Relu activation into the
+    // normalization expression, so the activations make a single trip through
+    // memory (this is what _FusedBatchNormEx fuses on the CPU).
+    const bool with_relu =
+        activation_mode == FusedBatchNormActivationMode::kRelu;
+    if (side_input != nullptr && with_relu) {
+      const auto side = side_input->flat<T>().reshape(rest_by_depth);
+      y.reshape(rest_by_depth).device(d) =
+          (x_shifted + side).cwiseMax(static_cast<T>(0));
+    } else if (side_input != nullptr) {
+      const auto side = side_input->flat<T>().reshape(rest_by_depth);
+      y.reshape(rest_by_depth).device(d) = x_shifted + side;
+    } else if (with_relu) {
+      y.reshape(rest_by_depth).device(d) =
+          x_shifted.cwiseMax(static_cast<T>(0));
+    } else {
+      y.reshape(rest_by_depth).device(d) = x_shifted;
+    }
     batch_mean.device(d) = estimated_mean;
     batch_variance.device(d) = estimated_variance;
 
@@ -1722,6 +1738,16 @@ REGISTER_KERNEL_BUILDER(Name("FusedBatchNormV3")
                             .TypeConstraint<float>("U"),
                         FusedBatchNormOpV3<CPUDevice, float, float>);
 
+#ifndef INTEL_MKL
+// With oneDNN this name is registered by the oneDNN graph rewrite
+// (see mkl_fused_batch_norm_op.cc).
+REGISTER_KERNEL_BUILDER(Name("_FusedBatchNormEx")
+                            .Device(DEVICE_CPU)
+                            .TypeConstraint<float>("T")
+                            .TypeConstraint<float>("U"),
+                        FusedBatchNormOpEx<CPUDevice, float, float>);
+#endif  // !INTEL_MKL
+
 REGISTER_KERNEL_BUILDER(Name("FusedBatchNormGradV3")
                             .Device(DEVICE_CPU)
                             .TypeConstraint<float>("T")
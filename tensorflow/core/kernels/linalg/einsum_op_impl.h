@@ -332,32 +332,58 @@ struct EinsumHelper {
     return true;
   }
 
-  template <typename Device, typename T>
-  static Status ReduceOperand(
-      OpKernelContext* ctx, const Tensor& input,
-      const std::vector<EinsumDimensionType>& label_types,
-      const LabelCounts& label_counts, Labels* labels, Labels* free_labels,
-      bool* swap_free_and_contract, Tensor* output) {
-    // Find the permutation to transpose the input dimensions in the order of
-    // EinsumDimensionType; i.e. batch, free, contract and reduce dimensions.
-    // This makes it more convenient to invoke Reduce/Contract operations.
-    std::vector<int> permutation(input.dims());
-    absl::c_iota(permutation, 0);
-    Tensor input_transposed;
-    // Check if we can avoid the transpose. We need to flip the adj_x (or adj_y)
-    // flag during BatchMatMul. This is an extra optimization not necessary for
-    // correctness.
-    if (ShouldSwapFreeAndContract(*labels, label_types)) {
+  // Finds the permutation to transpose the input dimensions in the order of
+  // EinsumDimensionType; i.e. batch, free, contract and reduce dimensions.
+  // This makes it more convenient to invoke Reduce/Contract operations. The
+  // permutation depends only on the operand labels, not on the runtime shapes,
+  // so for equations without an ellipsis it can be computed once at kernel
+  // construction.
+  static void PlanReduceTranspose(
+      const Labels& labels, const std::vector<EinsumDimensionType>& label_types,
+      std::vector<int>* permutation, bool* swap_free_and_contract) {
+    permutation->resize(labels.size());
+    absl::c_iota(*permutation, 0);
+    // Check if we can avoid the transpose. We need to flip the adj_x (or
+    // adj_y) flag during BatchMatMul. This is an extra optimization not
+    // necessary for correctness.
+    if (ShouldSwapFreeAndContract(labels, label_types)) {
       *swap_free_and_contract = true;
     } else {
-      absl::c_sort(permutation, [&](int i, int j) {
-        int label_i = (*labels)[i];
-        int label_j = (*labels)[j];
+      *swap_free_and_contract = false;
+      absl::c_sort(*permutation, [&](int i, int j) {
+        int label_i = labels[i];
+        int label_j = labels[j];
         return std::tie(label_types[label_i], label_i) <
                std::tie(label_types[label_j], label_j);
       });
     }
+  }
+
+  template <typename Device, typename T>
+  static Status ReduceOperand(
+      OpKernelContext* ctx, const Tensor& input,
+      const std::vector<EinsumDimensionType>& label_types,
+      const LabelCounts& label_counts, Labels* labels, Labels* free_labels,
+      bool* swap_free_and_contract, Tensor* output) {
+    std::vector<int> permutation;
+    PlanReduceTranspose(*labels, label_types, &permutation,
+                        swap_free_and_contract);
+    return ReduceOperand<Device, T>(ctx, input, label_types, label_counts,
+                                    permutation, *swap_free_and_contract,
+                                    labels, free_labels, output);
+  }
+
+  // Variant of the above taking the transpose plan precomputed by
+  // PlanReduceTranspose.
+  template <typename Device, typename T>
+  static Status ReduceOperand(
+      OpKernelContext* ctx, const Tensor& input,
+      const std::vector<EinsumDimensionType>& label_types,
+      const LabelCounts& label_counts, const std::vector<int>& permutation,
+      const bool swap_free_and_contract, Labels* labels, Labels* free_labels,
+      Tensor* output) {
     // Transpose the input so that EinsumDimensionTypes are in order.
+    Tensor input_transposed;
     TF_RETURN_IF_ERROR(TransposeOperand<Device, T>(ctx, input, permutation,
                                                    &input_transposed));
     PermuteLabels(permutation, labels);
@@ -388,7 +414,7 @@ struct EinsumHelper {
       }
       reshape[label_types[label]] *= dim;
     }
-    if (*swap_free_and_contract)
+    if (swap_free_and_contract)
       std::swap(reshape[EinsumDimensionType::kFree],
                 reshape[EinsumDimensionType::kContract]);
     output_shape.AddDim(reshape[EinsumDimensionType::kFree]);
@@ -482,6 +508,23 @@ class EinsumOp : public OpKernel {
                                &label_types_, &input_label_counts_,
                                &output_label_counts_, &input_has_ellipsis_,
                                &output_has_ellipsis_));
+    equation_has_ellipsis_ = output_has_ellipsis_ ||
+                             absl::c_linear_search(input_has_ellipsis_, true);
+    // Without an ellipsis, the labels seen at execution time are exactly the
+    // parsed ones, so the per-operand transpose planning can be done once
+    // here rather than on every call.
+    if (!equation_has_ellipsis_) {
+      const int num_inputs = input_labels_.size();
+      reduce_permutations_.resize(num_inputs);
+      reduce_swap_free_and_contract_.resize(num_inputs);
+      for (int i = 0; i < num_inputs; ++i) {
+        bool swap_free_and_contract = false;
+        EinsumHelper::PlanReduceTranspose(input_labels_[i], label_types_,
+                                          &reduce_permutations_[i],
+                                          &swap_free_and_contract);
+        reduce_swap_free_and_contract_[i] = swap_free_and_contract;
+      }
+    }
   }
 
   void Compute(OpKernelContext* ctx) override {
@@ -511,11 +554,23 @@ class EinsumOp : public OpKernel {
     gtl::InlinedVector<Tensor, 2> inputs_reduced(num_inputs);
     gtl::InlinedVector<bool, 2> swap_free_and_contract(num_inputs);
     for (int i = 0; i < num_inputs; ++i) {
-      OP_REQUIRES_OK(ctx,
-                     EinsumHelper::ReduceOperand<Device, T>(
-                         ctx, inputs[i], label_types, input_label_counts[i],
-                         &input_labels[i], &free_labels[i],
-                         &swap_free_and_contract[i], &inputs_reduced[i]));
+      if (!equation_has_ellipsis_) {
+        // Use the transpose plan cached at construction.
+        swap_free_and_contract[i] = reduce_swap_free_and_contract_[i];
+        OP_REQUIRES_OK(
+            ctx, EinsumHelper::ReduceOperand<Device, T>(
+                     ctx, inputs[i], label_types, input_label_counts[i],
+                     reduce_permutations_[i], swap_free_and_contract[i],
+                     &input_labels[i], &free_labels[i], &inputs_reduced[i]));
+      } else {
+        // Broadcasting labels inserted by ProcessDimensions depend on the
+        // runtime shapes, so the transpose must be planned per call.
+        OP_REQUIRES_OK(ctx,
+                       EinsumHelper::ReduceOperand<Device, T>(
+                           ctx, inputs[i], label_types, input_label_counts[i],
+                           &input_labels[i], &free_labels[i],
+                           &swap_free_and_contract[i], &inputs_reduced[i]));
+      }
     }
 
     // After reduction, the inputs should be reshaped to Tensors suitable for
@@ -622,6 +677,11 @@ class EinsumOp : public OpKernel {
   LabelCounts output_label_counts_;
   gtl::InlinedVector<bool, 2> input_has_ellipsis_;
   bool output_has_ellipsis_ = false;
+  bool equation_has_ellipsis_ = false;
+  // Transpose plans cached at construction; populated only when the equation
+  // has no ellipsis.
+  gtl::InlinedVector<std::vector<int>, 2> reduce_permutations_;
+  gtl::InlinedVector<bool, 2> reduce_swap_free_and_contract_;
 };
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
@@ -16,9 +16,11 @@ limitations under the License.
 #include "tensorflow/core/kernels/lookup_table_op.h"
 #define EIGEN_USE_THREADS
 
+#include <array>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/types.h"
@@ -36,11 +38,19 @@ std::string UniqueNodeName(const std::string& base) {
   return strings::StrCat(base, "/", counter.fetch_add(1), "/", random::New64());
 }
 
+// Number of sub-tables a mutable hash table is split into. Keys are
+// distributed across shards by hash, so concurrent Find/Insert calls that
+// touch different shards do not contend on a single mutex.
+constexpr int kNumTableShards = 16;
+
 // Lookup table that wraps an unordered_map, where the key and value data type
 // is specified. Each individual value must be a scalar. If vector values are
 // required, use MutableHashTableOfTensors.
 //
 // This table is mutable and thread safe - Insert can be called at any time.
+// The key space is partitioned into kNumTableShards sub-tables, each with its
+// own reader-writer mutex, so lookups and inserts of different shards proceed
+// in parallel.
 //
 // Sample use case:
 //
@@ -56,8 +66,12 @@ class MutableHashTableOfScalars final : public LookupInterface {
   MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel) {}
 
   size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
+    size_t ret = 0;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      ret += shard.table.size();
+    }
+    return ret;
   }
 
   Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
@@ -70,33 +84,57 @@ class MutableHashTableOfScalars final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
+    // Group the queried keys by shard so each shard mutex is taken at most
+    // once per call and probes of the same sub-table run back to back.
+    std::array<std::vector<int64_t>, kNumTableShards> shard_keys;
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      // is_full_size_default is true:
-      //   Each key has an independent default value, key_values(i)
-      //   corresponding uses default_flat(i) as its default value.
-      //
-      // is_full_size_default is false:
-      //   All keys will share the default_flat(0) as default value.
-      value_values(i) = gtl::FindWithDefault(
-          table_, SubtleMustCopyIfIntegral(key_values(i)),
-          is_full_size_default ? default_flat(i) : default_flat(0));
+      shard_keys[shard_index(key_values(i))].push_back(i);
+    }
+    for (int s = 0; s < kNumTableShards; ++s) {
+      if (shard_keys[s].empty()) continue;
+      const Shard& shard = shards_[s];
+      tf_shared_lock l(shard.mu);
+      for (int64_t i : shard_keys[s]) {
+        // is_full_size_default is true:
+        //   Each key has an independent default value, key_values(i)
+        //   corresponding uses default_flat(i) as its default value.
+        //
+        // is_full_size_default is false:
+        //   All keys will share the default_flat(0) as default value.
+        value_values(i) = gtl::FindWithDefault(
+            shard.table, SubtleMustCopyIfIntegral(key_values(i)),
+            is_full_size_default ? default_flat(i) : default_flat(0));
+      }
     }
 
     return OkStatus();
   }
 
-  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values) {
+  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat<V>();
 
-    mutex_lock l(mu_);
-    if (clear) {
-      table_.clear();
-    }
+    std::array<std::vector<int64_t>, kNumTableShards> shard_keys;
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
-                          SubtleMustCopyIfIntegral(value_values(i)));
+      shard_keys[shard_index(key_values(i))].push_back(i);
+    }
+    if (clear) {
+      // Hold every shard exclusively so the clear-and-refill of an import is
+      // atomic with respect to readers, as it was with a single table.
+      std::vector<mutex_lock> locks = LockAllExclusive();
+      for (int s = 0; s < kNumTableShards; ++s) {
+        Shard& shard = shards_[s];
+        shard.table.clear();
+        InsertShard(&shard, shard_keys[s], key_values, value_values);
+      }
+    } else {
+      for (int s = 0; s < kNumTableShards; ++s) {
+        if (shard_keys[s].empty()) continue;
+        Shard& shard = shards_[s];
+        mutex_lock l(shard.mu);
+        InsertShard(&shard, shard_keys[s], key_values, value_values);
+      }
     }
     return OkStatus();
   }
@@ -109,9 +147,17 @@ class MutableHashTableOfScalars final : public LookupInterface {
   Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
+    std::array<std::vector<int64_t>, kNumTableShards> shard_keys;
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      shard_keys[shard_index(key_values(i))].push_back(i);
+    }
+    for (int s = 0; s < kNumTableShards; ++s) {
+      if (shard_keys[s].empty()) continue;
+      Shard& shard = shards_[s];
+      mutex_lock l(shard.mu);
+      for (int64_t i : shard_keys[s]) {
+        shard.table.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      }
     }
     return OkStatus();
   }
@@ -121,9 +167,15 @@ class MutableHashTableOfScalars final : public LookupInterface {
     return DoInsert(true, keys, values);
   }
 
-  Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status ExportValues(OpKernelContext* ctx) override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    // All shard locks are held so the total size stays consistent with the
+    // shard contents while the output tensors are filled.
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.table.size();
+    }
 
     Tensor* keys;
     Tensor* values;
@@ -145,21 +197,27 @@ class MutableHashTableOfScalars final : public LookupInterface {
 
   int64_t MemoryUsed() const override {
     int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      for (unsigned i = 0; i < shard.table.bucket_count(); ++i) {
+        size_t bucket_size = shard.table.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
       }
     }
     return sizeof(MutableHashTableOfScalars) + ret;
   }
 
-  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.table.size();
+    }
     Tensor keys(key_dtype(), TensorShape({size}));
     Tensor values(value_dtype(), TensorShape({size}));
     ExportKeysAndValues(&keys, &values);
@@ -195,21 +253,67 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
  private:
+  struct Shard {
+    mutable mutex mu;
+    std::unordered_map<K, V> table TF_GUARDED_BY(mu);
+  };
+
+  size_t shard_index(const K& key) const {
+    return hasher_(key) % kNumTableShards;
+  }
+
+  // Acquires every shard lock in index order. The returned locks must stay
+  // alive for as long as a consistent view across shards is needed.
+  std::vector<tf_shared_lock> LockAllShared() const
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks;
+    locks.reserve(kNumTableShards);
+    for (const Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  std::vector<mutex_lock> LockAllExclusive() TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<mutex_lock> locks;
+    locks.reserve(kNumTableShards);
+    for (Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  // Inserts the keys at positions `key_indices` into `shard`. The caller must
+  // hold the shard's mutex exclusively.
+  void InsertShard(Shard* shard, const std::vector<int64_t>& key_indices,
+                   const typename TTypes<K>::ConstFlat& key_values,
+                   const typename TTypes<V>::ConstFlat& value_values)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    for (int64_t i : key_indices) {
+      gtl::InsertOrUpdate(&shard->table,
+                          SubtleMustCopyIfIntegral(key_values(i)),
+                          SubtleMustCopyIfIntegral(value_values(i)));
+    }
+  }
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
+  // must point to tensors whose size is the sum of the shard sizes, and the
+  // caller must hold every shard lock (see LockAllShared).
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     auto keys_data = keys->flat<K>();
     auto values_data = values->flat<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      keys_data(i) = it->first;
-      values_data(i) = it->second;
+    for (const Shard& shard : shards_) {
+      for (auto it = shard.table.begin(); it != shard.table.end(); ++it, ++i) {
+        keys_data(i) = it->first;
+        values_data(i) = it->second;
+      }
     }
   }
 
-  mutable mutex mu_;
-  std::unordered_map<K, V> table_ TF_GUARDED_BY(mu_);
+  std::hash<K> hasher_;
+  std::array<Shard, kNumTableShards> shards_;
 };
 
 // Lookup table that wraps an unordered_map. Behaves identical to
@@ -227,8 +331,12 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
   size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
+    size_t ret = 0;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      ret += shard.table.size();
+    }
+    return ret;
   }
 
   Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
@@ -242,24 +350,34 @@ class MutableHashTableOfTensors final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
+    // Group the queried keys by shard so each shard mutex is taken at most
+    // once per call and probes of the same sub-table run back to back.
+    std::array<std::vector<int64_t>, kNumTableShards> shard_keys;
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      ValueArray* value_vec =
-          gtl::FindOrNull(table_, SubtleMustCopyIfIntegral(key_values(i)));
-      if (value_vec != nullptr) {
-        for (int64_t j = 0; j < value_dim; j++) {
-          value_values(i, j) = value_vec->at(j);
-        }
-      } else {
-        // is_full_size_default is true:
-        //   Each key has an independent default value, key_values(i)
-        //   corresponding uses default_flat(i) as its default value.
-        //
-        // is_full_size_default is false:
-        //   All keys will share the default_flat(0) as default value.
-        for (int64_t j = 0; j < value_dim; j++) {
-          value_values(i, j) =
-              is_full_size_default ? default_flat(i, j) : default_flat(0, j);
+      shard_keys[shard_index(key_values(i))].push_back(i);
+    }
+    for (int s = 0; s < kNumTableShards; ++s) {
+      if (shard_keys[s].empty()) continue;
+      const Shard& shard = shards_[s];
+      tf_shared_lock l(shard.mu);
+      for (int64_t i : shard_keys[s]) {
+        const ValueArray* value_vec = gtl::FindOrNull(
+            shard.table, SubtleMustCopyIfIntegral(key_values(i)));
+        if (value_vec != nullptr) {
+          for (int64_t j = 0; j < value_dim; j++) {
+            value_values(i, j) = value_vec->at(j);
+          }
+        } else {
+          // is_full_size_default is true:
+          //   Each key has an independent default value, key_values(i)
+          //   corresponding uses default_flat(i) as its default value.
+          //
+          // is_full_size_default is false:
+          //   All keys will share the default_flat(0) as default value.
+          for (int64_t j = 0; j < value_dim; j++) {
+            value_values(i, j) =
+                is_full_size_default ? default_flat(i, j) : default_flat(0, j);
+          }
         }
       }
     }
@@ -267,23 +385,31 @@ class MutableHashTableOfTensors final : public LookupInterface {
     return OkStatus();
   }
 
-  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values) {
+  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat_inner_dims<V, 2>();
-    int64_t value_dim = value_shape_.dim_size(0);
 
-    mutex_lock l(mu_);
-    if (clear) {
-      table_.clear();
-    }
+    std::array<std::vector<int64_t>, kNumTableShards> shard_keys;
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      ValueArray value_vec;
-      for (int64_t j = 0; j < value_dim; j++) {
-        V value = value_values(i, j);
-        value_vec.push_back(value);
+      shard_keys[shard_index(key_values(i))].push_back(i);
+    }
+    if (clear) {
+      // Hold every shard exclusively so the clear-and-refill of an import is
+      // atomic with respect to readers, as it was with a single table.
+      std::vector<mutex_lock> locks = LockAllExclusive();
+      for (int s = 0; s < kNumTableShards; ++s) {
+        Shard& shard = shards_[s];
+        shard.table.clear();
+        InsertShard(&shard, shard_keys[s], key_values, value_values);
+      }
+    } else {
+      for (int s = 0; s < kNumTableShards; ++s) {
+        if (shard_keys[s].empty()) continue;
+        Shard& shard = shards_[s];
+        mutex_lock l(shard.mu);
+        InsertShard(&shard, shard_keys[s], key_values, value_values);
       }
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
-                          value_vec);
     }
     return OkStatus();
   }
@@ -296,9 +422,17 @@ class MutableHashTableOfTensors final : public LookupInterface {
   Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
+    std::array<std::vector<int64_t>, kNumTableShards> shard_keys;
     for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      shard_keys[shard_index(key_values(i))].push_back(i);
+    }
+    for (int s = 0; s < kNumTableShards; ++s) {
+      if (shard_keys[s].empty()) continue;
+      Shard& shard = shards_[s];
+      mutex_lock l(shard.mu);
+      for (int64_t i : shard_keys[s]) {
+        shard.table.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      }
     }
     return OkStatus();
   }
@@ -308,9 +442,15 @@ class MutableHashTableOfTensors final : public LookupInterface {
     return DoInsert(true, keys, values);
   }
 
-  Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status ExportValues(OpKernelContext* ctx) override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    // All shard locks are held so the total size stays consistent with the
+    // shard contents while the output tensors are filled.
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.table.size();
+    }
     int64_t value_dim = value_shape_.dim_size(0);
 
     Tensor* keys;
@@ -333,21 +473,27 @@ class MutableHashTableOfTensors final : public LookupInterface {
 
   int64_t MemoryUsed() const override {
     int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      for (unsigned i = 0; i < shard.table.bucket_count(); ++i) {
+        size_t bucket_size = shard.table.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
       }
     }
     return sizeof(MutableHashTableOfTensors) + ret;
   }
 
-  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+  Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks = LockAllShared();
+    int64_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.table.size();
+    }
     Tensor keys(key_dtype(), TensorShape({size}));
     Tensor values(value_dtype(), TensorShape({size, value_shape_.dim_size(0)}));
     ExportKeysAndValues(&keys, &values);
@@ -384,28 +530,80 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
  private:
+  typedef gtl::InlinedVector<V, 4> ValueArray;
+
+  struct Shard {
+    mutable mutex mu;
+    std::unordered_map<K, ValueArray> table TF_GUARDED_BY(mu);
+  };
+
+  size_t shard_index(const K& key) const {
+    return hasher_(key) % kNumTableShards;
+  }
+
+  // Acquires every shard lock in index order. The returned locks must stay
+  // alive for as long as a consistent view across shards is needed.
+  std::vector<tf_shared_lock> LockAllShared() const
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks;
+    locks.reserve(kNumTableShards);
+    for (const Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  std::vector<mutex_lock> LockAllExclusive() TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<mutex_lock> locks;
+    locks.reserve(kNumTableShards);
+    for (Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  // Inserts the keys at positions `key_indices` into `shard`. The caller must
+  // hold the shard's mutex exclusively.
+  void InsertShard(Shard* shard, const std::vector<int64_t>& key_indices,
+                   const typename TTypes<K>::ConstFlat& key_values,
+                   const typename TTypes<V>::ConstMatrix& value_values)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    int64_t value_dim = value_shape_.dim_size(0);
+    for (int64_t i : key_indices) {
+      ValueArray value_vec;
+      for (int64_t j = 0; j < value_dim; j++) {
+        V value = value_values(i, j);
+        value_vec.push_back(value);
+      }
+      gtl::InsertOrUpdate(&shard->table,
+                          SubtleMustCopyIfIntegral(key_values(i)), value_vec);
+    }
+  }
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
+  // must point to tensors whose size is the sum of the shard sizes, and the
+  // caller must hold every shard lock (see LockAllShared).
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     int64_t value_dim = value_shape_.dim_size(0);
     auto keys_data = keys->flat<K>();
     auto values_data = values->matrix<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      K key = it->first;
-      ValueArray value = it->second;
-      keys_data(i) = key;
-      for (int64_t j = 0; j < value_dim; j++) {
-        values_data(i, j) = value[j];
+    for (const Shard& shard : shards_) {
+      for (auto it = shard.table.begin(); it != shard.table.end();
+           ++it, ++i) {
+        keys_data(i) = it->first;
+        const ValueArray& value = it->second;
+        for (int64_t j = 0; j < value_dim; j++) {
+          values_data(i, j) = value[j];
+        }
       }
     }
   }
 
   TensorShape value_shape_;
-  mutable mutex mu_;
-  typedef gtl::InlinedVector<V, 4> ValueArray;
-  std::unordered_map<K, ValueArray> table_ TF_GUARDED_BY(mu_);
+  std::hash<K> hasher_;
+  std::array<Shard, kNumTableShards> shards_;
 };
 
 namespace {
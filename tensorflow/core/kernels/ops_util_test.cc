@@ -322,13 +322,13 @@ TEST_F(OpsUtilTest, Aligned1DSlice) {
   Tensor t(DT_FLOAT, TensorShape({3}));
   int64 start = 0;
   int64 end = 1;
-  bool output = IsDim0SliceAligned<float>(t.shape(), start, end);
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
   EXPECT_EQ(output, true);
 #else
   Tensor t(DT_FLOAT, TensorShape({EIGEN_MAX_ALIGN_BYTES * 2}));
   int64_t start = 0;
   int64_t end = EIGEN_MAX_ALIGN_BYTES;
-  bool output = IsDim0SliceAligned<float>(t.shape(), start, end);
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
   EXPECT_EQ(output, true);
   // Checks sliced 1D tensor is aligned for sanity.
   Tensor sliced;
@@ -342,7 +342,7 @@ TEST_F(OpsUtilTest, Misaligned1DSlice) {
   Tensor t(DT_FLOAT, TensorShape({EIGEN_MAX_ALIGN_BYTES * 2}));
   int64_t start = 1;
   int64_t end = EIGEN_MAX_ALIGN_BYTES + 1;
-  bool output = IsDim0SliceAligned<float>(t.shape(), start, end);
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
   EXPECT_EQ(output, false);
   // Checks sliced 1D tensor is misaligned for sanity.
   Tensor sliced;
@@ -358,7 +358,7 @@ TEST_F(OpsUtilTest, Aligned2DSliceOfDim0) {
   Tensor t(DT_FLOAT, TensorShape({3, 4}));
   int64 start = 1;
   int64 end = 2;
-  bool output = IsDim0SliceAligned<float>(t.shape(), start, end);
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
   EXPECT_EQ(output, true);
 #else
   // For multidimensional tensors, alignment is dictated by inner_dim_size.
@@ -366,7 +366,7 @@ TEST_F(OpsUtilTest, Aligned2DSliceOfDim0) {
   Tensor t(DT_FLOAT, TensorShape({3, inner_dim_size}));
   int64_t start = 1;
   int64_t end = 2;
-  bool output = IsDim0SliceAligned<float>(t.shape(), start, end);
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
   EXPECT_EQ(output, true);
   // Checks sliced 2D is aligned, for sanity.
   Tensor sliced;
@@ -382,28 +382,44 @@ TEST_F(OpsUtilTest, Misaligned2DSliceOfDim0) {
   Tensor t(DT_FLOAT, TensorShape({3, inner_dim_size}));
   int64_t start = 1;
   int64_t end = 2;
-  bool output = IsDim0SliceAligned<float>(t.shape(), start, end);
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
   EXPECT_EQ(output, false);
   // Checks sliced 2D is misaligned, for sanity.
   Tensor sliced;
   CHECK(sliced.CopyFrom(t.Slice(start, end), TensorShape({1, inner_dim_size})));
   EXPECT_EQ(sliced.IsAligned(), false);
 }
+
+TEST_F(OpsUtilTest, Aligned2DSliceOfDim0WithUnalignedRows) {
+  // Rows are not a multiple of the alignment, but a slice whose starting byte
+  // offset is a multiple of the alignment is still aligned.
+  int64_t inner_dim_size = EIGEN_MAX_ALIGN_BYTES + 1;
+  Tensor t(DT_FLOAT,
+           TensorShape({2 * EIGEN_MAX_ALIGN_BYTES, inner_dim_size}));
+  // start * inner_dim_size * sizeof(float) is a multiple of
+  // EIGEN_MAX_ALIGN_BYTES because start is.
+  int64_t start = EIGEN_MAX_ALIGN_BYTES;
+  int64_t end = start + 1;
+  bool output = IsDim0SliceAligned<float>(t.shape(), start);
+  EXPECT_EQ(output, true);
+  // Checks sliced 2D is aligned, for sanity.
+  Tensor sliced;
+  CHECK(sliced.CopyFrom(t.Slice(start, end), TensorShape({1, inner_dim_size})));
+  EXPECT_EQ(sliced.IsAligned(), true);
+}
 #endif
 
 TEST_F(OpsUtilTest, MisalignedEmptyShape) {
   TensorShape shape({});
   int64_t start = 1;
-  int64_t end = 2;
-  bool output = IsDim0SliceAligned<float>(shape, start, end);
+  bool output = IsDim0SliceAligned<float>(shape, start);
   EXPECT_EQ(output, false);
 }
 
 TEST_F(OpsUtilTest, MisalignedEmptyDim0) {
   TensorShape shape({0, 1, 2});
   int64_t start = 0;
-  int64_t end = 1;
-  bool output = IsDim0SliceAligned<float>(shape, start, end);
+  bool output = IsDim0SliceAligned<float>(shape, start);
   EXPECT_EQ(output, false);
 }
 
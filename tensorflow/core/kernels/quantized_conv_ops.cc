@@ -14,6 +14,16 @@ limitations under the License.
 ==============================================================================*/
 
 // Implements quantized eight-bit versions of the convolution operations.
+//
+// This is the portable implementation: the im2col patches are multiplied with
+// gemmlowp (or gemmlowp/meta on Arm), whose inner kernels are selected by the
+// compiler flags the binary was built with.  On x86 servers, int8
+// convolutions with AVX-512 VNNI / AMX-INT8 inner kernels (selected at
+// runtime by oneDNN's own CPU dispatcher, with per-channel requantization
+// fused into the epilogue) are provided by the oneDNN build via the
+// _MklQuantizedConv2D* kernels in kernels/mkl/, which the
+// MklLayoutRewritePass substitutes for the fused QuantizedConv2D* ops.
+// ISA-specific int8 kernels are deliberately not hand-written here.
 
 #include <algorithm>
 #include <vector>
@@ -14,6 +14,15 @@ limitations under the License.
 ==============================================================================*/
 
 // Implements a quantized eight-bit version of the matmul operation.
+//
+// This is the portable implementation: it uses gemmlowp (or gemmlowp/meta on
+// Arm), whose inner kernels are selected by the compiler flags the binary was
+// built with.  On x86 servers, int8 matmuls with AVX-512 VNNI / AMX-INT8
+// inner kernels (selected at runtime by oneDNN's own CPU dispatcher, with
+// requantization fused into the epilogue) are provided by the oneDNN build
+// via the _MklQuantizedMatMul* kernels in kernels/mkl/mkl_qmatmul_op.cc,
+// which the MklLayoutRewritePass substitutes for the fused QuantizedMatMul*
+// ops.  ISA-specific int8 kernels are deliberately not hand-written here.
 
 #define EIGEN_USE_THREADS
 
@@ -12,6 +12,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
@@ -22,6 +23,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -30,23 +32,45 @@ namespace {
 // For each slice in `(start, limit)` in `value_slices`, append
 // `params_dense_values_in[start:limit] to `values_out`.  `value_size` indicates
 // the number of scalars contained in each value params_dense_values_in[i].
+// The output offset of each slice is precomputed, so the slices are
+// independent of one another and are copied in parallel.
 template <typename VALUE_TYPE, typename SPLITS_TYPE>
 void WriteValueSlices(
-    const Tensor& params_dense_values_in,
+    OpKernelContext* context, const Tensor& params_dense_values_in,
     const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
     SPLITS_TYPE value_size, Tensor* values_out) {
   const auto& params_dense_values =
       params_dense_values_in.flat_outer_dims<VALUE_TYPE, 2>();
   auto values = values_out->flat_outer_dims<VALUE_TYPE, 2>();
-  int out_pos = 0;
+
+  // Output row where each slice starts (a prefix sum of the slice lengths).
+  std::vector<SPLITS_TYPE> slice_offsets;
+  slice_offsets.reserve(value_slices.size());
+  SPLITS_TYPE num_rows = 0;
   for (const auto& slice : value_slices) {
-    for (int i = slice.first; i < slice.second; ++i) {
-      for (int j = 0; j < value_size; ++j) {
-        values(out_pos, j) = params_dense_values(i, j);
+    slice_offsets.push_back(num_rows);
+    num_rows += slice.second - slice.first;
+  }
+  if (num_rows == 0) return;
+
+  auto copy_slices = [&](int64_t begin_slice, int64_t end_slice) {
+    for (int64_t s = begin_slice; s < end_slice; ++s) {
+      const auto& slice = value_slices[s];
+      SPLITS_TYPE out_pos = slice_offsets[s];
+      for (SPLITS_TYPE i = slice.first; i < slice.second; ++i, ++out_pos) {
+        for (SPLITS_TYPE j = 0; j < value_size; ++j) {
+          values(out_pos, j) = params_dense_values(i, j);
+        }
       }
-      ++out_pos;
     }
-  }
+  };
+  auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+  // Slices may have uneven lengths, so cost them at the average size.
+  const int64_t cost_per_slice =
+      std::max<int64_t>(1, static_cast<int64_t>(num_rows) * value_size *
+                               sizeof(VALUE_TYPE) / value_slices.size());
+  Shard(worker_threads->num_threads, worker_threads->workers,
+        value_slices.size(), cost_per_slice, copy_slices);
 }
 
 }  // namespace
@@ -251,8 +275,8 @@ class RaggedGatherOpBase : public OpKernel {
     const SPLITS_TYPE value_size =
         num_elements == 0 ? 0
                           : (num_elements / params_dense_values_in.dim_size(0));
-    CallWriteValueSlices(params_dense_values_in, value_slices, value_size,
-                         values_out);
+    CallWriteValueSlices(context, params_dense_values_in, value_slices,
+                         value_size, values_out);
     return OkStatus();
   }
 
@@ -263,7 +287,7 @@ class RaggedGatherOpBase : public OpKernel {
   // index type), rather than 14 (one for each index type and value type),
   // which cuts the binary size of this op from ~300k to <90k.
   virtual void CallWriteValueSlices(
-      const Tensor& params_dense_values_in,
+      OpKernelContext* context, const Tensor& params_dense_values_in,
       const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
       SPLITS_TYPE value_size, Tensor* values_out) const = 0;
 };
@@ -275,10 +299,10 @@ class RaggedGatherOp : public RaggedGatherOpBase<INDEX_TYPE, SPLITS_TYPE> {
 
  private:
   void CallWriteValueSlices(
-      const Tensor& params_dense_values_in,
+      OpKernelContext* context, const Tensor& params_dense_values_in,
       const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
       SPLITS_TYPE value_size, Tensor* values_out) const override {
-    WriteValueSlices<VALUE_TYPE>(params_dense_values_in, value_slices,
+    WriteValueSlices<VALUE_TYPE>(context, params_dense_values_in, value_slices,
                                  value_size, values_out);
   }
 };
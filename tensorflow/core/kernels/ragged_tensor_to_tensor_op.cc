@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/bcast.h"
 #include "tensorflow/core/util/ragged_to_dense_util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -397,8 +398,23 @@ class RaggedTensorToTensorBaseOp : public OpKernel {
                    context->allocate_output(0, output_shape, &output_tensor));
     const INDEX_TYPE full_size = multiplier[0] * output_size[0];
     if (full_size > 0) {
-      vector<INDEX_TYPE> output_index, new_output_index;
       int nvals = context->input(kValueInputIndex).shape().dim_size(0);
+
+      // In the common rank-2 case partitioned by a single well-formed
+      // row_splits tensor, every output row is an independent contiguous
+      // region, so the rows can be written directly (and in parallel)
+      // without materializing a per-value output index.  Malformed splits
+      // fall through to the general path, which reports the usual errors.
+      if (ragged_rank_ == 1 &&
+          GetRowPartitionTypeByDimension(0) == RowPartitionType::ROW_SPLITS) {
+        const RowPartitionTensor row_split = GetRowPartitionTensor(context, 0);
+        if (RowSplitsAreSimple(row_split, first_dimension, nvals)) {
+          SetOutputRowSplit(context, row_split, output_tensor);
+          return;
+        }
+      }
+
+      vector<INDEX_TYPE> output_index, new_output_index;
       output_index.reserve(nvals);
       new_output_index.reserve(nvals);
 
@@ -419,6 +435,27 @@ class RaggedTensorToTensorBaseOp : public OpKernel {
                          const vector<INDEX_TYPE>& output_index,
                          Tensor* output_tensor) = 0;
 
+  // Fills the output tensor directly from a single row_splits tensor.  Only
+  // called when ragged_rank is 1 and RowSplitsAreSimple() holds.
+  virtual void SetOutputRowSplit(OpKernelContext* context,
+                                 const RowPartitionTensor& row_split,
+                                 Tensor* output_tensor) = 0;
+
+  // Returns true if `row_split` describes `first_dimension` rows whose values
+  // are a sequence of non-overlapping slices of the first `num_values` values,
+  // i.e. if it can be handled by SetOutputRowSplit().
+  static bool RowSplitsAreSimple(const RowPartitionTensor& row_split,
+                                 INDEX_TYPE first_dimension,
+                                 INDEX_TYPE num_values) {
+    const INDEX_TYPE nrows = row_split.size() - 1;
+    if (nrows < 0 || nrows > first_dimension) return false;
+    if (row_split(0) != 0 || row_split(nrows) > num_values) return false;
+    for (INDEX_TYPE i = 0; i < nrows; ++i) {
+      if (row_split(i + 1) < row_split(i)) return false;
+    }
+    return true;
+  }
+
  private:
   vector<RowPartitionType> row_partition_types_;
   int ragged_rank_;
@@ -466,9 +503,103 @@ void copy_array<Eigen::half, int32>(Eigen::half* dst, const Eigen::half* src,
 template <typename VALUE_TYPE, typename INDEX_TYPE>
 class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
  public:
+  typedef typename RaggedTensorToTensorBaseOp<INDEX_TYPE>::RowPartitionTensor
+      RowPartitionTensor;
+
   explicit RaggedTensorToTensorOp(OpKernelConstruction* context)
       : RaggedTensorToTensorBaseOp<INDEX_TYPE>(context) {}
 
+  // Sets `*default_value` to point at value_element_size scalars (or a single
+  // scalar, if default_value_tensor is a scalar), broadcasting
+  // default_value_tensor into `*bcast_default` if necessary.  `*bcast_default`
+  // must outlive any use of `*default_value`.
+  Status GetBroadcastedDefaultValue(OpKernelContext* context,
+                                    const Tensor& default_value_tensor,
+                                    const TensorShape& element_shape,
+                                    Tensor* bcast_default,
+                                    const VALUE_TYPE** default_value) {
+    *default_value = default_value_tensor.flat<VALUE_TYPE>().data();
+    if (default_value_tensor.NumElements() != element_shape.num_elements() &&
+        default_value_tensor.NumElements() != 1) {
+      const auto& src_shape = default_value_tensor.shape();
+      BCast bcast(BCast::FromShape(src_shape), BCast::FromShape(element_shape),
+                  /*fewer_dims_optimization=*/true);
+      // Note: bcast should always be valid, since we rejected any incompatible
+      // shapes when we called ValidateDefaultValueShape().
+      if (!bcast.IsValid()) {
+        return errors::InvalidArgument("Error broadcasting default_value");
+      }
+      TF_RETURN_IF_ERROR(context->allocate_temp(default_value_tensor.dtype(),
+                                                element_shape, bcast_default));
+      const CPUDevice& device = context->eigen_device<CPUDevice>();
+      functor::BroadcastTo<CPUDevice, VALUE_TYPE>()(
+          device, context, *bcast_default, element_shape, default_value_tensor,
+          src_shape, bcast);
+      *default_value = bcast_default->flat<VALUE_TYPE>().data();
+    }
+    return OkStatus();
+  }
+
+  void SetOutputRowSplit(OpKernelContext* context,
+                         const RowPartitionTensor& row_split,
+                         Tensor* output_tensor) override {
+    if (output_tensor->NumElements() == 0) return;
+
+    const auto& values_tensor = context->input(kValueInputIndex);
+    const VALUE_TYPE* values_base = values_tensor.flat<VALUE_TYPE>().data();
+    const auto& default_value_tensor = context->input(kDefaultValueInputIndex);
+    VALUE_TYPE* output_base = output_tensor->flat<VALUE_TYPE>().data();
+
+    TensorShape element_shape = output_tensor->shape();
+    element_shape.RemoveDimRange(0, 2);
+    const INDEX_TYPE value_element_size = element_shape.num_elements();
+    const INDEX_TYPE output_rows = output_tensor->shape().dim_size(0);
+    const INDEX_TYPE output_cols = output_tensor->shape().dim_size(1);
+    const INDEX_TYPE num_split_rows = row_split.size() - 1;
+
+    const VALUE_TYPE* default_value = nullptr;
+    Tensor bcast_default;  // Temporary tensor for result of broadcast
+    OP_REQUIRES_OK(context, GetBroadcastedDefaultValue(
+                                context, default_value_tensor, element_shape,
+                                &bcast_default, &default_value));
+    const bool scalar_default = default_value_tensor.NumElements() == 1;
+
+    // Each output row is a single contiguous region: the values of the
+    // corresponding ragged row (truncated to output_cols), followed by
+    // padding with the default value.  Rows are independent, so they can be
+    // written in parallel.
+    const INDEX_TYPE row_size = output_cols * value_element_size;
+    auto fill_rows = [&](int64_t begin_row, int64_t end_row) {
+      for (int64_t row = begin_row; row < end_row; ++row) {
+        VALUE_TYPE* dst = output_base + row * row_size;
+        INDEX_TYPE row_length = 0;
+        if (row < num_split_rows) {
+          row_length = std::min(static_cast<INDEX_TYPE>(row_split(row + 1) -
+                                                        row_split(row)),
+                                output_cols);
+          const VALUE_TYPE* src =
+              values_base + row_split(row) * value_element_size;
+          copy_array<VALUE_TYPE, INDEX_TYPE>(dst, src,
+                                             row_length * value_element_size);
+        }
+        VALUE_TYPE* pad = dst + row_length * value_element_size;
+        VALUE_TYPE* pad_end = dst + row_size;
+        if (scalar_default) {
+          std::fill(pad, pad_end, *default_value);
+        } else {
+          for (; pad < pad_end; pad += value_element_size) {
+            copy_array<VALUE_TYPE, INDEX_TYPE>(pad, default_value,
+                                               value_element_size);
+          }
+        }
+      }
+    };
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t cost_per_row = row_size * sizeof(VALUE_TYPE);
+    Shard(worker_threads->num_threads, worker_threads->workers, output_rows,
+          cost_per_row, fill_rows);
+  }
+
   void SetOutput(OpKernelContext* context, int ragged_rank,
                  const vector<INDEX_TYPE>& output_index,
                  Tensor* output_tensor) override {
@@ -491,27 +622,11 @@ class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
     // Broadcast the default value to value_element_size.  (We can skip this
     // if default_value_tensor.NumElements() == 1, since we use std::fill
     // when that's true.)
-    const VALUE_TYPE* default_value =
-        default_value_tensor.flat<VALUE_TYPE>().data();
+    const VALUE_TYPE* default_value = nullptr;
     Tensor bcast_default;  // Temporary tensor for result of broadcast
-    if (default_value_tensor.NumElements() != value_element_size &&
-        default_value_tensor.NumElements() != 1) {
-      const auto& src_shape = default_value_tensor.shape();
-      BCast bcast(BCast::FromShape(src_shape), BCast::FromShape(element_shape),
-                  /*fewer_dims_optimization=*/true);
-      // Note: bcast should always be valid, since we rejected any incompatible
-      // shapes when we called ValidateDefaultValueShape().
-      OP_REQUIRES(context, bcast.IsValid(),
-                  errors::InvalidArgument("Error broadcasting default_value"));
-      OP_REQUIRES_OK(context,
-                     context->allocate_temp(default_value_tensor.dtype(),
-                                            element_shape, &bcast_default));
-      const CPUDevice& device = context->eigen_device<CPUDevice>();
-      functor::BroadcastTo<CPUDevice, VALUE_TYPE>()(
-          device, context, bcast_default, element_shape, default_value_tensor,
-          src_shape, bcast);
-      default_value = bcast_default.flat<VALUE_TYPE>().data();
-    }
+    OP_REQUIRES_OK(context, GetBroadcastedDefaultValue(
+                                context, default_value_tensor, element_shape,
+                                &bcast_default, &default_value));
 
     // Loop through the output_index vector, finding contiguous regions that
     // should be copied.  Once we find the end of a contiguous region, copy it
@@ -418,6 +418,8 @@ class RandomBinomialOp : public OpKernel {
                     "For Philox algorithm, the size of state must be at least ",
                     PHILOX_MIN_STATE_SIZE, "; got ", var_tensor_flat.size()));
 
+    // Drop any published read snapshot before checking the buffer refcount.
+    var->InvalidateSnapshot();
     OP_REQUIRES_OK(ctx, PrepareToUpdateVariable<Device, StateElementType>(
                             ctx, var_tensor, var->copy_on_read_mode.load()));
     auto var_data = var_tensor_flat.data();
@@ -81,6 +81,17 @@ struct FillPhiloxRandomTask;
 template <class Distribution>
 struct FillPhiloxRandomTask<Distribution, false> {
   typedef typename Distribution::ResultElementType T;
+
+  // Number of generator streams processed per iteration of the main loop.
+  // Each 128-bit Philox sample is a chain of ten serially-dependent rounds,
+  // but samples at different counter offsets are independent; computing
+  // several of them per iteration exposes instruction-level parallelism and
+  // lets the compiler vectorize across the streams. Each dist() invocation
+  // consumes exactly one 128-bit sample (this is the same contract that
+  // makes the gen.Skip(start_group) below correct), so the batched loop
+  // produces bit-identical output to the serial one.
+  static constexpr int kBatchedGroups = 4;
+
   static void Run(random::PhiloxRandom gen, T* data, int64_t size,
                   int64_t start_group, int64_t limit_group, Distribution dist) {
     const int kGroupSize = Distribution::kResultElementCount;
@@ -88,9 +99,24 @@ struct FillPhiloxRandomTask<Distribution, false> {
     gen.Skip(start_group);
     int64_t offset = start_group * kGroupSize;
 
-    // First fill all the full-size groups
+    // First fill all the full-size groups, several streams at a time.
     int64_t limit_group_full = std::min(limit_group, size / kGroupSize);
-    for (int64_t index = start_group; index < limit_group_full; ++index) {
+    int64_t index = start_group;
+    for (; index + kBatchedGroups <= limit_group_full;
+         index += kBatchedGroups) {
+      typename Distribution::ResultType samples[kBatchedGroups];
+      for (int j = 0; j < kBatchedGroups; ++j) {
+        random::PhiloxRandom stream_gen = gen;
+        stream_gen.Skip(j);
+        samples[j] = dist(&stream_gen);
+      }
+      gen.Skip(kBatchedGroups);
+      for (int j = 0; j < kBatchedGroups; ++j) {
+        std::copy(&samples[j][0], &samples[j][0] + kGroupSize, data + offset);
+        offset += kGroupSize;
+      }
+    }
+    for (; index < limit_group_full; ++index) {
       auto samples = dist(&gen);
       std::copy(&samples[0], &samples[0] + kGroupSize, data + offset);
       offset += kGroupSize;
@@ -145,6 +145,17 @@ void ReadVariableOp::Compute(OpKernelContext* ctx) {
                   "Debug info: container=", handle.container(),
                   ", status error message=", status.error_message()));
 
+  // Fast path: a previous dense read published a snapshot and no write has
+  // invalidated it since, so the variable's mutex can be skipped entirely.
+  // The snapshot holds its own reference to the buffer, and any write done
+  // after the invalidation goes to a fresh buffer, so this aliases exactly
+  // the value some locked read would have seen.
+  std::shared_ptr<const Tensor> snapshot = variable->SnapshotForRead();
+  if (snapshot != nullptr && dtype_ == snapshot->dtype()) {
+    ctx->set_output(0, *snapshot);
+    return;
+  }
+
   tf_shared_lock ml(*variable->mu());
   // We're acquiring a reference to the underlying buffer while
   // holding a shared lock to guarantee ordering of reads and
@@ -157,6 +168,7 @@ void ReadVariableOp::Compute(OpKernelContext* ctx) {
             "Trying to read variable with wrong dtype. Expected ",
             DataTypeString(dtype_), " got ", DataTypeString(t->dtype())));
     ctx->set_output(0, *t);
+    variable->PublishSnapshot();
   } else {
     OP_REQUIRES_OK(ctx, CopyVariable(0, ctx, t));
   }
@@ -195,6 +207,13 @@ void ReadVariablesOp::Compute(OpKernelContext* ctx) {
                   absl::StrJoin(uninitialized_vars, ", ")));
 
   for (size_t i = 0; i < dtypes_.size(); ++i) {
+    // Fast path: alias a published snapshot without taking the variable's
+    // mutex. See ReadVariableOp::Compute for why this is safe.
+    std::shared_ptr<const Tensor> snapshot = variables[i]->SnapshotForRead();
+    if (snapshot != nullptr && dtypes_[i] == snapshot->dtype()) {
+      ctx->set_output(i, *snapshot);
+      continue;
+    }
     // We're acquiring a reference to the underlying buffer while
     // holding a shared lock to guarantee ordering of reads and
     // writes.
@@ -210,6 +229,7 @@ void ReadVariablesOp::Compute(OpKernelContext* ctx) {
     } else {
       const Tensor& t = *variables[i]->tensor();
       ctx->set_output(i, t);
+      variables[i]->PublishSnapshot();
     }
   }
 }
@@ -424,6 +444,9 @@ class AssignVariableOp : public OpKernel {
                                   return OkStatus();
                                 }));
     mutex_lock ml(*variable->mu());
+    // Send concurrent lock-free reads back under the mutex so they observe
+    // the new value.
+    variable->InvalidateSnapshot();
     // (variable->tensor()->dtype() == DT_INVALID && !variable->is_initialized)
     // check below is to allow an XLA specific situation wherein update can
     // happen first by the AssignVariableOp,
@@ -512,6 +535,9 @@ class AssignVariableOp<Device, Variant> : public OpKernel {
         attr);
 
     mutex_lock ml(*variable->mu());
+    // Drop any published read snapshot: it holds a reference to the buffer,
+    // so the RefCountIsOne check below could otherwise never pass.
+    variable->InvalidateSnapshot();
     OP_REQUIRES(context, variable->tensor()->dtype() == DT_VARIANT,
                 errors::InvalidArgument(
                     "Trying to assign variable with wrong dtype. Expected ",
@@ -591,6 +617,9 @@ class AssignUpdateVariableOp : public OpKernel {
     // PrepareToUpdateVariable() for commutative operations like Op ==
     // ADD if value's refcount was 1.
     mutex_lock ml(*variable->mu());
+    // Invalidate before PrepareToUpdateVariable() so a published read
+    // snapshot does not make the buffer look shared.
+    variable->InvalidateSnapshot();
     Tensor* var_tensor = variable->tensor();
     OP_REQUIRES_OK(context, ValidateAssignUpdateVariableOpShapes(
                                 var_tensor->shape(), value.shape()));
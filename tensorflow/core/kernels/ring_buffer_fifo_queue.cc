@@ -0,0 +1,458 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/ring_buffer_fifo_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/queue_base.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/batch_util.h"
+
+namespace tensorflow {
+
+RingBufferFIFOQueue::RingBufferFIFOQueue(
+    int32_t capacity, const DataTypeVector& component_dtypes,
+    const std::vector<TensorShape>& component_shapes, const string& name)
+    : FIFOQueue(capacity, component_dtypes, component_shapes, name) {}
+
+Status RingBufferFIFOQueue::Initialize() {
+  TF_RETURN_IF_ERROR(FIFOQueue::Initialize());
+  if (capacity_ <= 0 || capacity_ == kUnbounded) {
+    return errors::InvalidArgument("RingBufferFIFOQueue '", name_,
+                                   "' requires a bounded capacity, got ",
+                                   capacity_);
+  }
+  slots_.reset(new Slot[capacity_]);
+  for (int64_t i = 0; i < capacity_; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  return OkStatus();
+}
+
+bool RingBufferFIFOQueue::TryEnqueueRing(const Tuple& tuple) {
+  uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot* slot = &slots_[pos % capacity_];
+    const uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+    const int64_t dif = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if (dif == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        slot->tuple = tuple;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (dif < 0) {
+      // The slot is still occupied one lap behind: the ring is full.
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool RingBufferFIFOQueue::TryDequeueRangeRing(int64_t num_elements,
+                                              std::vector<Tuple>* elements) {
+  uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    // The whole contiguous range must be published before we claim any of
+    // it, so a failed reservation has no side effects.
+    bool all_ready = true;
+    for (int64_t i = 0; i < num_elements; ++i) {
+      const uint64_t seq = slots_[(pos + i) % capacity_].sequence.load(
+          std::memory_order_acquire);
+      if (static_cast<int64_t>(seq) - static_cast<int64_t>(pos + i + 1) != 0) {
+        all_ready = false;
+        break;
+      }
+    }
+    if (!all_ready) return false;
+    if (dequeue_pos_.compare_exchange_weak(pos, pos + num_elements,
+                                           std::memory_order_relaxed)) {
+      elements->clear();
+      elements->reserve(num_elements);
+      for (int64_t i = 0; i < num_elements; ++i) {
+        Slot* slot = &slots_[(pos + i) % capacity_];
+        elements->push_back(std::move(slot->tuple));
+        slot->tuple.clear();
+        slot->sequence.store(pos + i + capacity_, std::memory_order_release);
+      }
+      return true;
+    }
+    // Another consumer claimed the range first; `pos` has been reloaded by
+    // the failed compare-exchange, re-check readiness from there.
+  }
+}
+
+void RingBufferFIFOQueue::MaybeWakeWaiters() {
+  // The fence orders this thread's slot publication before the flag load;
+  // see MustUseSlowPath() for the pairing argument.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (slow_path_only_.load(std::memory_order_relaxed)) {
+    FlushUnlocked();
+    ClearWaitersIfIdle();
+  }
+}
+
+void RingBufferFIFOQueue::ClearWaitersIfIdle() {
+  mutex_lock l(mu_);
+  if (enqueue_attempts_.empty() && dequeue_attempts_.empty() &&
+      !closed_hint_) {
+    has_waiters_ = false;
+    slow_path_only_.store(false, std::memory_order_seq_cst);
+  }
+}
+
+Status RingBufferFIFOQueue::AssembleBatch(OpKernelContext* ctx,
+                                          std::vector<Tuple>* elements,
+                                          Tuple* batch) {
+  const int64_t batch_size = elements->size();
+  batch->clear();
+  batch->reserve(num_components());
+  for (int i = 0; i < num_components(); ++i) {
+    Tensor component;
+    TF_RETURN_IF_ERROR(ctx->allocate_temp(
+        component_dtypes_[i], ManyOutShape(i, batch_size), &component));
+    batch->push_back(component);
+  }
+  for (int64_t index = 0; index < batch_size; ++index) {
+    Tuple& element = (*elements)[index];
+    for (int i = 0; i < num_components(); ++i) {
+      TF_RETURN_IF_ERROR(batch_util::CopyElementToSlice(
+          std::move(element[i]), &(*batch)[i], index));
+    }
+  }
+  return OkStatus();
+}
+
+void RingBufferFIFOQueue::TryEnqueue(const Tuple& tuple, OpKernelContext* ctx,
+                                     DoneCallback callback) {
+  if (!MustUseSlowPath() && TryEnqueueRing(tuple)) {
+    MaybeWakeWaiters();
+    callback();
+    return;
+  }
+  CancellationManager* cm = ctx->cancellation_manager();
+  CancellationToken token = cm->get_cancellation_token();
+  bool already_cancelled;
+  {
+    mutex_lock l(mu_);
+    already_cancelled = !cm->RegisterCallback(
+        token, [this, cm, token]() { Cancel(kEnqueue, cm, token); });
+    if (!already_cancelled) {
+      SetWaiters();
+      enqueue_attempts_.emplace_back(
+          1, callback, ctx, cm, token,
+          [tuple, this](Attempt* attempt) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+            if (closed_) {
+              attempt->context->SetStatus(errors::Cancelled(
+                  "RingBufferFIFOQueue '", name_, "' is closed."));
+              return kComplete;
+            }
+            if (TryEnqueueRing(tuple)) {
+              return kComplete;
+            }
+            return kNoProgress;
+          });
+    }
+  }
+  if (!already_cancelled) {
+    FlushUnlocked();
+    ClearWaitersIfIdle();
+  } else {
+    ctx->SetStatus(errors::Cancelled("Enqueue operation was cancelled"));
+    callback();
+  }
+}
+
+void RingBufferFIFOQueue::TryEnqueueMany(const Tuple& tuple,
+                                         OpKernelContext* ctx,
+                                         DoneCallback callback) {
+  const int64_t batch_size = tuple[0].dim_size(0);
+  if (batch_size == 0) {
+    callback();
+    return;
+  }
+
+  // Push as many elements as the ring will take without locking; like
+  // FIFOQueue, a batch enqueue becomes visible element by element.
+  int64_t index = 0;
+  if (!MustUseSlowPath()) {
+    for (; index < batch_size; ++index) {
+      Tuple element;
+      element.reserve(num_components());
+      for (int i = 0; i < num_components(); ++i) {
+        Tensor component;
+        Status s =
+            GetElementComponentFromBatch(tuple, index, i, ctx, &component);
+        if (!s.ok()) {
+          ctx->SetStatus(s);
+          callback();
+          return;
+        }
+        element.push_back(component);
+      }
+      if (!TryEnqueueRing(element)) break;
+    }
+    MaybeWakeWaiters();
+    if (index == batch_size) {
+      callback();
+      return;
+    }
+  }
+
+  CancellationManager* cm = ctx->cancellation_manager();
+  CancellationToken token = cm->get_cancellation_token();
+  bool already_cancelled;
+  {
+    mutex_lock l(mu_);
+    already_cancelled = !cm->RegisterCallback(
+        token, [this, cm, token]() { Cancel(kEnqueue, cm, token); });
+    if (!already_cancelled) {
+      SetWaiters();
+      enqueue_attempts_.emplace_back(
+          batch_size - index, callback, ctx, cm, token,
+          [tuple, this](Attempt* attempt) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+            if (closed_) {
+              attempt->context->SetStatus(errors::Cancelled(
+                  "RingBufferFIFOQueue '", name_, "' is closed."));
+              return kComplete;
+            }
+            RunResult result = kNoProgress;
+            while (attempt->elements_requested > 0) {
+              const int64_t index =
+                  tuple[0].dim_size(0) - attempt->elements_requested;
+              Tuple element;
+              element.reserve(num_components());
+              for (int i = 0; i < num_components(); ++i) {
+                Tensor component;
+                attempt->context->SetStatus(GetElementComponentFromBatch(
+                    tuple, index, i, attempt->context, &component));
+                if (!attempt->context->status().ok()) return kComplete;
+                element.push_back(component);
+              }
+              if (!TryEnqueueRing(element)) return result;
+              result = kProgress;
+              --attempt->elements_requested;
+            }
+            return kComplete;
+          });
+    }
+  }
+  if (!already_cancelled) {
+    FlushUnlocked();
+    ClearWaitersIfIdle();
+  } else {
+    ctx->SetStatus(errors::Cancelled("Enqueue operation was cancelled"));
+    callback();
+  }
+}
+
+void RingBufferFIFOQueue::TryDequeue(OpKernelContext* ctx,
+                                     CallbackWithTuple callback) {
+  if (!MustUseSlowPath()) {
+    std::vector<Tuple> elements;
+    if (TryDequeueRangeRing(1, &elements)) {
+      MaybeWakeWaiters();
+      callback(elements[0]);
+      return;
+    }
+  }
+  CancellationManager* cm = ctx->cancellation_manager();
+  CancellationToken token = cm->get_cancellation_token();
+  bool already_cancelled;
+  {
+    mutex_lock l(mu_);
+    already_cancelled = !cm->RegisterCallback(
+        token, [this, cm, token]() { Cancel(kDequeue, cm, token); });
+    if (!already_cancelled) {
+      SetWaiters();
+      dequeue_attempts_.emplace_back(
+          1, [callback]() { callback(Tuple()); }, ctx, cm, token,
+          [callback, this](Attempt* attempt) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+            const int64_t queue_size = size();
+            if (closed_ && queue_size == 0) {
+              attempt->context->SetStatus(errors::OutOfRange(
+                  "RingBufferFIFOQueue '", name_, "' is closed and has ",
+                  "insufficient elements (requested ", 1, ", current size ",
+                  queue_size, ")"));
+              return kComplete;
+            }
+            std::vector<Tuple> elements;
+            if (TryDequeueRangeRing(1, &elements)) {
+              Tuple tuple = std::move(elements[0]);
+              attempt->done_callback = [callback, tuple]() { callback(tuple); };
+              return kComplete;
+            }
+            return kNoProgress;
+          });
+    }
+  }
+  if (!already_cancelled) {
+    FlushUnlocked();
+    ClearWaitersIfIdle();
+  } else {
+    ctx->SetStatus(errors::Cancelled("Dequeue operation was cancelled"));
+    callback(Tuple());
+  }
+}
+
+void RingBufferFIFOQueue::TryDequeueMany(int num_elements, OpKernelContext* ctx,
+                                         bool allow_small_batch,
+                                         CallbackWithTuple callback) {
+  if (!specified_shapes()) {
+    ctx->SetStatus(errors::InvalidArgument(
+        "RingBufferFIFOQueue's DequeueMany and DequeueUpTo require the "
+        "components to have specified shapes."));
+    callback(Tuple());
+    return;
+  }
+  if (num_elements == 0) {
+    Tuple tuple;
+    tuple.reserve(num_components());
+    for (int i = 0; i < num_components(); ++i) {
+      Tensor element;
+      Status status = ctx->allocate_temp(component_dtypes_[i],
+                                         ManyOutShape(i, 0), &element);
+      if (!status.ok()) {
+        ctx->SetStatus(status);
+        callback(Tuple());
+        return;
+      }
+      tuple.emplace_back(element);
+    }
+    callback(tuple);
+    return;
+  }
+  if (num_elements > capacity_) {
+    // A bounded ring cannot stage a batch bigger than itself; FIFOQueue
+    // drains such requests incrementally, but that requires the restore-on-
+    // close machinery the ring deliberately avoids.
+    ctx->SetStatus(errors::InvalidArgument(
+        "RingBufferFIFOQueue '", name_,
+        "' cannot dequeue batches larger than its capacity (requested ",
+        num_elements, ", capacity ", capacity_, ")"));
+    callback(Tuple());
+    return;
+  }
+
+  if (!MustUseSlowPath()) {
+    std::vector<Tuple> elements;
+    if (TryDequeueRangeRing(num_elements, &elements)) {
+      MaybeWakeWaiters();
+      Tuple batch;
+      Status s = AssembleBatch(ctx, &elements, &batch);
+      if (!s.ok()) {
+        ctx->SetStatus(s);
+        callback(Tuple());
+        return;
+      }
+      callback(batch);
+      return;
+    }
+  }
+
+  CancellationManager* cm = ctx->cancellation_manager();
+  CancellationToken token = cm->get_cancellation_token();
+  bool already_cancelled;
+  {
+    mutex_lock l(mu_);
+    already_cancelled = !cm->RegisterCallback(
+        token, [this, cm, token]() { Cancel(kDequeue, cm, token); });
+    if (!already_cancelled) {
+      SetWaiters();
+      dequeue_attempts_.emplace_back(
+          num_elements, [callback]() { callback(Tuple()); }, ctx, cm, token,
+          [callback, allow_small_batch,
+           this](Attempt* attempt) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+            int64_t queue_size = size();
+            if (closed_ && queue_size < attempt->elements_requested) {
+              if (allow_small_batch && queue_size > 0) {
+                // Request all remaining elements in the queue.
+                attempt->elements_requested = queue_size;
+              } else {
+                if (allow_small_batch && !enqueue_attempts_.empty()) {
+                  // There may be some other attempts containing
+                  // values.  If so, we'll yield and wait for them
+                  // to add elements to the queue.
+                  return kProgress;
+                }
+                if (attempt->context->status().ok()) {
+                  attempt->context->SetStatus(errors::OutOfRange(
+                      "RingBufferFIFOQueue '", name_, "' is closed and has ",
+                      "insufficient elements (requested ",
+                      attempt->elements_requested, ", current size ",
+                      queue_size, ")"));
+                }
+                return kComplete;
+              }
+            }
+            std::vector<Tuple> elements;
+            if (!TryDequeueRangeRing(attempt->elements_requested, &elements)) {
+              return kNoProgress;
+            }
+            Tuple batch;
+            attempt->context->SetStatus(
+                AssembleBatch(attempt->context, &elements, &batch));
+            if (!attempt->context->status().ok()) return kComplete;
+            attempt->done_callback = [callback, batch]() { callback(batch); };
+            return kComplete;
+          });
+    }
+  }
+  if (!already_cancelled) {
+    FlushUnlocked();
+    ClearWaitersIfIdle();
+  } else {
+    ctx->SetStatus(errors::Cancelled("Dequeue operation was cancelled"));
+    callback(Tuple());
+  }
+}
+
+void RingBufferFIFOQueue::Close(OpKernelContext* ctx,
+                                bool cancel_pending_enqueues,
+                                DoneCallback callback) {
+  {
+    mutex_lock l(mu_);
+    closed_hint_ = true;
+    slow_path_only_.store(true, std::memory_order_seq_cst);
+  }
+  QueueBase::Close(ctx, cancel_pending_enqueues, callback);
+}
+
+int64_t RingBufferFIFOQueue::MemoryUsed() const {
+  int64_t ret = capacity_ * static_cast<int64_t>(sizeof(Slot));
+  // Slot tuples are touched lock-free, so account for them through the
+  // element shapes rather than by walking the ring.
+  if (specified_shapes()) {
+    int64_t bytes_per_element = 0;
+    for (int i = 0; i < num_components(); ++i) {
+      bytes_per_element += DataTypeSize(component_dtypes_[i]) *
+                           component_shapes_[i].num_elements();
+    }
+    ret += size() * bytes_per_element;
+  }
+  return ret;
+}
+
+}  // namespace tensorflow
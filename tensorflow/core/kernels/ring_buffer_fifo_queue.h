@@ -0,0 +1,153 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_KERNELS_RING_BUFFER_FIFO_QUEUE_H_
+#define TENSORFLOW_CORE_KERNELS_RING_BUFFER_FIFO_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/fifo_queue.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A FIFOQueue backed by a bounded lock-free MPMC ring buffer instead of
+// mutex-guarded deques.
+//
+// Each ring slot carries a sequence counter (Vyukov-style bounded queue):
+// producers claim a slot by advancing `enqueue_pos_` with a CAS, move their
+// tuple in and publish the slot; consumers do the symmetric dance on
+// `dequeue_pos_`. As long as the queue is neither empty nor full, Enqueue,
+// Dequeue and DequeueMany complete without taking `mu_` and without running
+// any tensor copies under a lock. DequeueMany additionally claims its whole
+// batch with a single reservation over a contiguous range of slots rather
+// than popping element by element.
+//
+// Operations that cannot complete immediately (empty/full ring, or a closed
+// queue) fall back to QueueBase's mutex-guarded attempt machinery, which
+// also provides blocking, cancellation and Close() semantics identical to
+// FIFOQueue. While any attempt is parked, new operations take the slow path
+// too, so parked attempts are never overtaken; the lock-free path therefore
+// pays off in the steady state where the queue is partially full.
+//
+// Unlike FIFOQueue, DequeueMany/DequeueUpTo requests larger than the queue
+// capacity are rejected: a bounded ring cannot stage a batch bigger than
+// itself.
+//
+// Selected by setting the optional node attr `_use_ring_buffer` on a
+// FIFOQueue(V2) node with a bounded capacity.
+class RingBufferFIFOQueue : public FIFOQueue {
+ public:
+  RingBufferFIFOQueue(int32_t capacity, const DataTypeVector& component_dtypes,
+                      const std::vector<TensorShape>& component_shapes,
+                      const string& name);
+
+  Status Initialize() override;  // Must be called before any other method.
+
+  // Implementations of QueueInterface methods --------------------------------
+
+  void TryEnqueue(const Tuple& tuple, OpKernelContext* ctx,
+                  DoneCallback callback) override;
+  void TryEnqueueMany(const Tuple& tuple, OpKernelContext* ctx,
+                      DoneCallback callback) override;
+  void TryDequeue(OpKernelContext* ctx, CallbackWithTuple callback) override;
+  void TryDequeueMany(int num_elements, OpKernelContext* ctx,
+                      bool allow_small_batch,
+                      CallbackWithTuple callback) override;
+  void Close(OpKernelContext* ctx, bool cancel_pending_enqueues,
+             DoneCallback callback) override;
+
+  int32 size() const override {
+    const int64_t d = dequeue_pos_.load(std::memory_order_relaxed);
+    const int64_t e = enqueue_pos_.load(std::memory_order_relaxed);
+    return static_cast<int32>(std::max<int64_t>(0, e - d));
+  }
+
+  int64_t MemoryUsed() const override;
+
+ protected:
+  ~RingBufferFIFOQueue() override {}
+
+ private:
+  // One ring slot. `sequence` encodes slot state: equal to the claiming
+  // position for an empty slot, position + 1 once a tuple is published, and
+  // position + capacity once the tuple has been consumed again.
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    Tuple tuple;
+  };
+
+  // Lock-free primitives. All of these are also safe to call while holding
+  // `mu_` (the slow-path attempt closures do).
+
+  // Claims one slot and publishes `tuple`. Returns false if the ring is full.
+  bool TryEnqueueRing(const Tuple& tuple);
+
+  // Claims `num_elements` contiguous published slots in one reservation and
+  // moves their tuples into `elements`. All-or-nothing: returns false
+  // without side effects if fewer than `num_elements` are ready.
+  bool TryDequeueRangeRing(int64_t num_elements, std::vector<Tuple>* elements);
+
+  // True while operations must take the mutex-guarded slow path: the queue
+  // has been closed (or is closing), or attempts are parked.
+  bool MustUseSlowPath() const {
+    // The seq_cst load pairs with the seq_cst store in SetWaiters(): a
+    // fast-path operation either observes the waiter flag, or its slot
+    // publication is ordered before the parked attempt's retry and the
+    // attempt makes progress on its own. Either way no wakeup is lost.
+    return slow_path_only_.load(std::memory_order_seq_cst);
+  }
+  void SetWaiters() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    has_waiters_ = true;
+    slow_path_only_.store(true, std::memory_order_seq_cst);
+  }
+
+  // Flushes parked attempts if the slow-path flag is set; called after every
+  // successful lock-free operation so blocked peers observe the new state.
+  void MaybeWakeWaiters();
+
+  // Re-derives `slow_path_only_` after attempts have been flushed.
+  void ClearWaitersIfIdle();
+
+  // Moves `elements` into a freshly allocated `[batch_size, ...]` tuple;
+  // used by both DequeueMany paths.
+  Status AssembleBatch(OpKernelContext* ctx, std::vector<Tuple>* elements,
+                       Tuple* batch);
+
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> enqueue_pos_{0};
+  std::atomic<uint64_t> dequeue_pos_{0};
+
+  // Set under `mu_` whenever an attempt is parked or the queue is closed;
+  // mirrored into `slow_path_only_` for lock-free reads.
+  bool has_waiters_ TF_GUARDED_BY(mu_) = false;
+  bool closed_hint_ TF_GUARDED_BY(mu_) = false;
+  std::atomic<bool> slow_path_only_{false};
+
+  TF_DISALLOW_COPY_AND_ASSIGN(RingBufferFIFOQueue);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_RING_BUFFER_FIFO_QUEUE_H_
@@ -0,0 +1,348 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/ring_buffer_fifo_queue.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+// Drives RingBufferFIFOQueue through its QueueInterface, the same surface the
+// queue kernels use: every operation runs against its own OpKernelContext and
+// completes through its callback, so blocking behavior is observable as a
+// callback that has not fired yet.
+class RingBufferFIFOQueueTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = DeviceFactory::NewDevice("CPU", {},
+                                       "/job:localhost/replica:0/task:0");
+    NodeDef def;
+    TF_ASSERT_OK(NodeDefBuilder("ring_buffer_queue_test", "NoOp")
+                     .Finalize(&def));
+    Status status;
+    kernel_ = CreateOpKernel(DEVICE_CPU, device_.get(), cpu_allocator(), def,
+                             TF_GRAPH_DEF_VERSION, &status);
+    TF_ASSERT_OK(status);
+  }
+
+  void TearDown() override {
+    if (queue_ != nullptr) queue_->Unref();
+  }
+
+  void InitQueue(int32_t capacity) {
+    queue_ = new RingBufferFIFOQueue(capacity, {DT_FLOAT}, {TensorShape({})},
+                                     "test_queue");
+    TF_ASSERT_OK(queue_->Initialize());
+  }
+
+  // One in-flight queue operation: owns the context the operation runs
+  // against and latches its completion and result.
+  struct QueueOp {
+    explicit QueueOp(RingBufferFIFOQueueTest* test) {
+      params.device = test->device_.get();
+      params.op_kernel = test->kernel_.get();
+      params.cancellation_manager = &cancellation_manager;
+      params.inputs = &inputs;
+      context.reset(new OpKernelContext(&params));
+    }
+
+    // Blocks until the operation completes and returns its status.
+    Status status() {
+      done.WaitForNotification();
+      return context->status();
+    }
+
+    OpKernelContext::Params params;
+    gtl::InlinedVector<TensorValue, 4> inputs;
+    CancellationManager cancellation_manager;
+    std::unique_ptr<OpKernelContext> context;
+    Notification done;
+    QueueInterface::Tuple tuple;  // Result of a dequeue.
+  };
+
+  static Tensor ScalarTensor(float value) {
+    Tensor tensor(DT_FLOAT, TensorShape({}));
+    tensor.scalar<float>()() = value;
+    return tensor;
+  }
+
+  std::unique_ptr<QueueOp> StartEnqueue(float value) {
+    std::unique_ptr<QueueOp> op(new QueueOp(this));
+    queue_->TryEnqueue({ScalarTensor(value)}, op->context.get(),
+                       [op = op.get()]() { op->done.Notify(); });
+    return op;
+  }
+
+  std::unique_ptr<QueueOp> StartEnqueueMany(const Tensor& batch) {
+    std::unique_ptr<QueueOp> op(new QueueOp(this));
+    queue_->TryEnqueueMany({batch}, op->context.get(),
+                           [op = op.get()]() { op->done.Notify(); });
+    return op;
+  }
+
+  std::unique_ptr<QueueOp> StartDequeue() {
+    std::unique_ptr<QueueOp> op(new QueueOp(this));
+    queue_->TryDequeue(op->context.get(),
+                       [op = op.get()](const QueueInterface::Tuple& tuple) {
+                         op->tuple = tuple;
+                         op->done.Notify();
+                       });
+    return op;
+  }
+
+  std::unique_ptr<QueueOp> StartDequeueMany(int num_elements,
+                                            bool allow_small_batch) {
+    std::unique_ptr<QueueOp> op(new QueueOp(this));
+    queue_->TryDequeueMany(num_elements, op->context.get(), allow_small_batch,
+                           [op = op.get()](const QueueInterface::Tuple& tuple) {
+                             op->tuple = tuple;
+                             op->done.Notify();
+                           });
+    return op;
+  }
+
+  std::unique_ptr<QueueOp> StartClose(bool cancel_pending_enqueues) {
+    std::unique_ptr<QueueOp> op(new QueueOp(this));
+    queue_->Close(op->context.get(), cancel_pending_enqueues,
+                  [op = op.get()]() { op->done.Notify(); });
+    return op;
+  }
+
+  // Blocking wrappers used where the test does not care about overlap.
+  Status Enqueue(float value) { return StartEnqueue(value)->status(); }
+
+  Status Dequeue(float* value) {
+    std::unique_ptr<QueueOp> op = StartDequeue();
+    Status s = op->status();
+    if (s.ok()) {
+      EXPECT_EQ(1, op->tuple.size());
+      *value = op->tuple[0].scalar<float>()();
+    }
+    return s;
+  }
+
+  std::unique_ptr<Device> device_;
+  std::unique_ptr<OpKernel> kernel_;
+  RingBufferFIFOQueue* queue_ = nullptr;
+};
+
+TEST_F(RingBufferFIFOQueueTest, EnqueueDequeueRoundTrip) {
+  InitQueue(8);
+  TF_ASSERT_OK(Enqueue(1.0f));
+  TF_ASSERT_OK(Enqueue(2.0f));
+  TF_ASSERT_OK(Enqueue(3.0f));
+  EXPECT_EQ(3, queue_->size());
+
+  float value = -1.0f;
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(1.0f, value);
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(2.0f, value);
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(3.0f, value);
+  EXPECT_EQ(0, queue_->size());
+}
+
+TEST_F(RingBufferFIFOQueueTest, EnqueueManyDequeueManyRoundTrip) {
+  InitQueue(8);
+  Tensor batch(DT_FLOAT, TensorShape({5}));
+  for (int i = 0; i < 5; ++i) batch.vec<float>()(i) = 10.0f + i;
+  TF_ASSERT_OK(StartEnqueueMany(batch)->status());
+  EXPECT_EQ(5, queue_->size());
+
+  std::unique_ptr<QueueOp> op =
+      StartDequeueMany(5, /*allow_small_batch=*/false);
+  TF_ASSERT_OK(op->status());
+  ASSERT_EQ(1, op->tuple.size());
+  ASSERT_EQ(TensorShape({5}), op->tuple[0].shape());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(10.0f + i, op->tuple[0].vec<float>()(i));
+  }
+}
+
+TEST_F(RingBufferFIFOQueueTest, DequeueManyLargerThanCapacityFails) {
+  InitQueue(4);
+  std::unique_ptr<QueueOp> op =
+      StartDequeueMany(5, /*allow_small_batch=*/false);
+  EXPECT_TRUE(errors::IsInvalidArgument(op->status()));
+}
+
+TEST_F(RingBufferFIFOQueueTest, BlockingDequeueWokenByEnqueue) {
+  InitQueue(4);
+  std::unique_ptr<QueueOp> dequeue = StartDequeue();
+  // Nothing can complete a dequeue on an empty queue.
+  EXPECT_FALSE(dequeue->done.HasBeenNotified());
+
+  TF_ASSERT_OK(Enqueue(7.0f));
+  TF_ASSERT_OK(dequeue->status());
+  ASSERT_EQ(1, dequeue->tuple.size());
+  EXPECT_EQ(7.0f, dequeue->tuple[0].scalar<float>()());
+}
+
+TEST_F(RingBufferFIFOQueueTest, BlockingDequeueManyWokenByEnqueues) {
+  InitQueue(8);
+  TF_ASSERT_OK(Enqueue(1.0f));
+  std::unique_ptr<QueueOp> dequeue =
+      StartDequeueMany(3, /*allow_small_batch=*/false);
+  EXPECT_FALSE(dequeue->done.HasBeenNotified());
+
+  TF_ASSERT_OK(Enqueue(2.0f));
+  EXPECT_FALSE(dequeue->done.HasBeenNotified());
+  TF_ASSERT_OK(Enqueue(3.0f));
+  TF_ASSERT_OK(dequeue->status());
+  ASSERT_EQ(1, dequeue->tuple.size());
+  ASSERT_EQ(TensorShape({3}), dequeue->tuple[0].shape());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(1.0f + i, dequeue->tuple[0].vec<float>()(i));
+  }
+}
+
+TEST_F(RingBufferFIFOQueueTest, BlockingEnqueueWhenFullWokenByDequeue) {
+  InitQueue(2);
+  TF_ASSERT_OK(Enqueue(1.0f));
+  TF_ASSERT_OK(Enqueue(2.0f));
+  std::unique_ptr<QueueOp> enqueue = StartEnqueue(3.0f);
+  // The ring is full, so the enqueue must park.
+  EXPECT_FALSE(enqueue->done.HasBeenNotified());
+
+  float value = -1.0f;
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(1.0f, value);
+  TF_ASSERT_OK(enqueue->status());
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(2.0f, value);
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(3.0f, value);
+}
+
+TEST_F(RingBufferFIFOQueueTest, CloseWakesBlockedDequeue) {
+  InitQueue(2);
+  std::unique_ptr<QueueOp> dequeue = StartDequeue();
+  EXPECT_FALSE(dequeue->done.HasBeenNotified());
+
+  TF_ASSERT_OK(StartClose(/*cancel_pending_enqueues=*/false)->status());
+  EXPECT_TRUE(errors::IsOutOfRange(dequeue->status()));
+  EXPECT_TRUE(dequeue->tuple.empty());
+
+  // Enqueues on a closed queue are rejected.
+  EXPECT_TRUE(errors::IsCancelled(Enqueue(1.0f)));
+}
+
+TEST_F(RingBufferFIFOQueueTest, CloseCancelsPendingEnqueues) {
+  InitQueue(2);
+  TF_ASSERT_OK(Enqueue(1.0f));
+  TF_ASSERT_OK(Enqueue(2.0f));
+  std::unique_ptr<QueueOp> enqueue = StartEnqueue(3.0f);
+  EXPECT_FALSE(enqueue->done.HasBeenNotified());
+
+  TF_ASSERT_OK(StartClose(/*cancel_pending_enqueues=*/true)->status());
+  EXPECT_FALSE(enqueue->status().ok());
+
+  // The elements enqueued before the close are still dequeueable.
+  float value = -1.0f;
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(1.0f, value);
+  TF_ASSERT_OK(Dequeue(&value));
+  EXPECT_EQ(2.0f, value);
+  EXPECT_TRUE(errors::IsOutOfRange(Dequeue(&value)));
+}
+
+TEST_F(RingBufferFIFOQueueTest, CancellationUnparksDequeue) {
+  InitQueue(2);
+  std::unique_ptr<QueueOp> dequeue = StartDequeue();
+  EXPECT_FALSE(dequeue->done.HasBeenNotified());
+
+  dequeue->cancellation_manager.StartCancel();
+  EXPECT_TRUE(errors::IsCancelled(dequeue->status()));
+  EXPECT_TRUE(dequeue->tuple.empty());
+}
+
+TEST_F(RingBufferFIFOQueueTest, DequeueUpToReturnsRemainderAfterClose) {
+  InitQueue(8);
+  TF_ASSERT_OK(Enqueue(1.0f));
+  TF_ASSERT_OK(Enqueue(2.0f));
+  TF_ASSERT_OK(StartClose(/*cancel_pending_enqueues=*/false)->status());
+
+  std::unique_ptr<QueueOp> op = StartDequeueMany(5, /*allow_small_batch=*/true);
+  TF_ASSERT_OK(op->status());
+  ASSERT_EQ(1, op->tuple.size());
+  ASSERT_EQ(TensorShape({2}), op->tuple[0].shape());
+  EXPECT_EQ(1.0f, op->tuple[0].vec<float>()(0));
+  EXPECT_EQ(2.0f, op->tuple[0].vec<float>()(1));
+}
+
+TEST_F(RingBufferFIFOQueueTest, MultiProducerMultiConsumerStress) {
+  InitQueue(32);
+  constexpr int kProducers = 4;
+  constexpr int kConsumers = 4;
+  constexpr int kPerProducer = 200;
+  constexpr int kTotal = kProducers * kPerProducer;
+  mutex mu;
+  std::vector<float> consumed;
+  {
+    thread::ThreadPool pool(Env::Default(), "ring_buffer_queue_stress",
+                            kProducers + kConsumers);
+    for (int p = 0; p < kProducers; ++p) {
+      pool.Schedule([this, p] {
+        for (int i = 0; i < kPerProducer; ++i) {
+          TF_EXPECT_OK(Enqueue(static_cast<float>(p * kPerProducer + i)));
+        }
+      });
+    }
+    // Consumers collectively dequeue exactly as many elements as the
+    // producers enqueue, so every blocking operation eventually completes.
+    for (int c = 0; c < kConsumers; ++c) {
+      pool.Schedule([this, &mu, &consumed] {
+        for (int i = 0; i < kTotal / kConsumers; ++i) {
+          float value = -1.0f;
+          TF_EXPECT_OK(Dequeue(&value));
+          mutex_lock l(mu);
+          consumed.push_back(value);
+        }
+      });
+    }
+  }  // Joins the workers.
+  ASSERT_EQ(kTotal, consumed.size());
+  std::sort(consumed.begin(), consumed.end());
+  for (int i = 0; i < kTotal; ++i) {
+    EXPECT_EQ(static_cast<float>(i), consumed[i]);
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
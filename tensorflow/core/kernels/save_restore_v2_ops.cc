@@ -31,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
@@ -87,6 +88,24 @@ void ValidateInputs(bool is_save_op, OpKernelContext* context,
   }
 }
 
+// Whether SaveV2 compresses tensor data in the written bundle.  Off by
+// default: compressed bundles cannot be read by TensorFlow releases that
+// predate BundleEntryProto.compression.
+bool CheckpointCompressionEnabled() {
+  static const bool enabled = [] {
+    bool compress = false;
+    Status s =
+        ReadBoolFromEnvVar("TF_CHECKPOINT_COMPRESS", false, &compress);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to parse TF_CHECKPOINT_COMPRESS: "
+                   << s.error_message();
+      return false;
+    }
+    return compress;
+  }();
+  return enabled;
+}
+
 }  // namespace
 
 // Saves a list of named tensors using the tensor bundle library.
@@ -108,7 +127,9 @@ class SaveV2 : public OpKernel {
     const auto& tensor_names_flat = tensor_names.flat<tstring>();
     const auto& shape_and_slices_flat = shape_and_slices.flat<tstring>();
 
-    BundleWriter writer(Env::Default(), prefix_string);
+    BundleWriter::Options writer_options;
+    writer_options.compress = CheckpointCompressionEnabled();
+    BundleWriter writer(Env::Default(), prefix_string, writer_options);
     OP_REQUIRES_OK(context, writer.status());
     VLOG(1) << "BundleWriter, prefix_string: " << prefix_string;
 
@@ -0,0 +1,126 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/nn_ops.cc.
+
+#define EIGEN_USE_THREADS
+
+#include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+// Computes Softmax(logits * scale + mask) over the innermost dimension
+// without materializing the scaled and masked intermediates. Created by the
+// grappler remapper for the attention pattern Softmax(AddV2(Mul(x, s), m)).
+template <typename T>
+class ScaledMaskedSoftmaxOp : public OpKernel {
+ public:
+  explicit ScaledMaskedSoftmaxOp(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& logits = context->input(0);
+    const Tensor& scale = context->input(1);
+    const Tensor& mask = context->input(2);
+    OP_REQUIRES(context, logits.dims() == 4,
+                errors::InvalidArgument("logits must be 4-dimensional, got ",
+                                        logits.shape().DebugString()));
+    OP_REQUIRES(context, TensorShapeUtils::IsScalar(scale.shape()),
+                errors::InvalidArgument("scale must be a scalar, got ",
+                                        scale.shape().DebugString()));
+    OP_REQUIRES(context, mask.dims() == 4,
+                errors::InvalidArgument("mask must be 4-dimensional, got ",
+                                        mask.shape().DebugString()));
+    for (int d = 0; d < 4; ++d) {
+      OP_REQUIRES(
+          context,
+          mask.dim_size(d) == logits.dim_size(d) || mask.dim_size(d) == 1,
+          errors::InvalidArgument("mask dimension ", d,
+                                  " must be 1 or match logits; got mask ",
+                                  mask.shape().DebugString(), " and logits ",
+                                  logits.shape().DebugString()));
+    }
+
+    Tensor* softmax_out = nullptr;
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, logits.shape(), &softmax_out));
+    if (logits.NumElements() == 0) return;
+
+    const int64_t depth = logits.dim_size(3);
+    const int64_t num_rows = logits.NumElements() / depth;
+    const int64_t rows_per_head = logits.dim_size(2);
+    const int64_t rows_per_batch = logits.dim_size(1) * rows_per_head;
+
+    const T* logits_data = logits.flat<T>().data();
+    const T* mask_data = mask.flat<T>().data();
+    T* out_data = softmax_out->flat<T>().data();
+    const T scale_value = scale.scalar<T>()();
+
+    // Strides into the mask for each logits dimension; broadcast dimensions
+    // contribute stride 0.
+    const int64_t mask_depth = mask.dim_size(3);
+    int64_t mask_strides[3];
+    int64_t stride = mask_depth;
+    for (int d = 2; d >= 0; --d) {
+      mask_strides[d] = mask.dim_size(d) == 1 ? 0 : stride;
+      stride *= mask.dim_size(d);
+    }
+
+    auto compute_rows = [&](int64_t begin, int64_t end) {
+      typedef Eigen::Array<T, Eigen::Dynamic, 1> ArrayXt;
+      for (int64_t row = begin; row < end; ++row) {
+        const int64_t b = row / rows_per_batch;
+        const int64_t h = (row % rows_per_batch) / rows_per_head;
+        const int64_t s = row % rows_per_head;
+        const T* mask_row = mask_data + b * mask_strides[0] +
+                            h * mask_strides[1] + s * mask_strides[2];
+
+        Eigen::Map<const ArrayXt> in(logits_data + row * depth, depth);
+        Eigen::Map<ArrayXt> out(out_data + row * depth, depth);
+        if (mask_depth == 1) {
+          out = in * scale_value + mask_row[0];
+        } else {
+          Eigen::Map<const ArrayXt> mask_vec(mask_row, depth);
+          out = in * scale_value + mask_vec;
+        }
+        out = (out - out.maxCoeff()).exp();
+        out /= out.sum();
+      }
+    };
+
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    // Roughly five flops per element: scale, mask add, subtract max, exp,
+    // and normalize.
+    const int64_t cost_per_row = 5 * depth;
+    Shard(worker_threads->num_threads, worker_threads->workers, num_rows,
+          cost_per_row, compute_rows);
+  }
+};
+
+#define REGISTER_CPU(T)                                \
+  REGISTER_KERNEL_BUILDER(Name("_ScaledMaskedSoftmax") \
+                              .Device(DEVICE_CPU)      \
+                              .TypeConstraint<T>("T"), \
+                          ScaledMaskedSoftmaxOp<T>);
+TF_CALL_float(REGISTER_CPU);
+TF_CALL_bfloat16(REGISTER_CPU);
+#undef REGISTER_CPU
+
+}  // namespace tensorflow
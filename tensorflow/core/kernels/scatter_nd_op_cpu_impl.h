@@ -20,7 +20,10 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
 #include <atomic>
+#include <numeric>
+#include <vector>
 
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 
@@ -100,9 +103,24 @@ class UpdateExecutor<T, Input, Update, Output, scatter_nd_op::UpdateOp::MAX> {
 
 }  // namespace update_executor
 
-namespace functor {
+// Minimum number of scalar elements that must be written before the sharded
+// implementation is used; below this the partitioning bookkeeping costs more
+// than the copies it parallelizes.
+constexpr Eigen::DenseIndex kMinElementsForParallelScatterNd = 64 << 10;
+
+// A destination bucket is "hot" when it holds more than this many times the
+// average per-shard share of the updates.  A contiguous row-range partition
+// cannot balance around a hot bucket, so the sort-based partition is used
+// instead.
+constexpr Eigen::DenseIndex kScatterNdSkewFactor = 2;
 
 // Implementation of update functor for CPU.
+//
+// The updates are applied in parallel when the payload is large enough.  Both
+// parallel strategies give each output row exactly one writer and apply
+// updates aimed at the same row in their original order, so the result (and
+// any floating-point accumulation order) is identical to the serial loop's,
+// independent of thread scheduling.
 template <typename T, typename Index, scatter_nd_op::UpdateOp OP, int IXDIM>
 struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
   Index operator()(
@@ -117,6 +135,7 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
     Index error_loc = -1;
 
     const Eigen::DenseIndex batch_size = Tindices.dimension(0);
+    const Eigen::DenseIndex num_rows = Toutput.dimension(0);
 
     Index batch_strides[IXDIM];
     for (int dim = IXDIM - 1; dim >= 0; --dim) {
@@ -128,6 +147,12 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
       }
     }
 
+    // Flatten every multi-index to a destination row up front.  This also
+    // finds the first out-of-bounds index, so the error reported (and the
+    // prefix of updates applied before it) stays identical to the serial
+    // loop's.
+    std::vector<Index> dest(batch_size);
+    Eigen::DenseIndex valid_count = batch_size;
     for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
       Index i = 0;
       bool out_of_bounds = false;
@@ -138,9 +163,21 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
       }
       if (TF_PREDICT_FALSE(out_of_bounds)) {
         error_loc = loc;
+        valid_count = loc;
         break;
-      } else {
-        auto input_chip = Toutput.template chip<0>(i);
+      }
+      dest[loc] = i;
+    }
+
+    const Eigen::DenseIndex total_elements = valid_count * slice_size;
+    const Eigen::DenseIndex num_shards = std::min<Eigen::DenseIndex>(
+        std::min<Eigen::DenseIndex>(
+            d.numThreads(), total_elements / kMinElementsForParallelScatterNd),
+        num_rows);
+
+    if (num_shards <= 1) {
+      for (Eigen::DenseIndex loc = 0; loc < valid_count; ++loc) {
+        auto input_chip = Toutput.template chip<0>(dest[loc]);
         auto output_chip = input_chip;
         auto update_chip = Tupdates.template chip<0>(loc);
         update_executor::UpdateExecutor<
@@ -148,6 +185,113 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
             decltype(output_chip), OP>::Execute(d, input_chip, update_chip,
                                                 output_chip);
       }
+      return error_loc;
+    }
+
+    // Applies one update on a worker thread.  Workers use the default device
+    // so that per-slice Eigen assignments never re-enter the thread pool.
+    Eigen::DefaultDevice device;
+    auto apply_update = [&](Eigen::DenseIndex loc) {
+      auto input_chip = Toutput.template chip<0>(dest[loc]);
+      auto output_chip = input_chip;
+      auto update_chip = Tupdates.template chip<0>(loc);
+      update_executor::UpdateExecutor<
+          Eigen::DefaultDevice, decltype(input_chip), decltype(update_chip),
+          decltype(output_chip), OP>::Execute(device, input_chip, update_chip,
+                                              output_chip);
+    };
+
+    // Histogram the destinations over contiguous row buckets.  The bucket
+    // counts both pick balanced shard boundaries and detect skewed index
+    // distributions.
+    const Eigen::DenseIndex num_buckets = num_shards * 8;
+    const Eigen::DenseIndex bucket_width =
+        (num_rows + num_buckets - 1) / num_buckets;
+    std::vector<Eigen::DenseIndex> bucket_counts(num_buckets, 0);
+    for (Eigen::DenseIndex loc = 0; loc < valid_count; ++loc) {
+      ++bucket_counts[dest[loc] / bucket_width];
+    }
+    const Eigen::DenseIndex target_per_shard =
+        (valid_count + num_shards - 1) / num_shards;
+    const bool skewed =
+        *std::max_element(bucket_counts.begin(), bucket_counts.end()) >
+        kScatterNdSkewFactor * target_per_shard;
+
+    // The per-shard cost is made deliberately large so that parallelFor
+    // dispatches every shard as its own block.
+    const Eigen::DenseIndex elements_per_shard = total_elements / num_shards;
+    const Eigen::TensorOpCost shard_cost(elements_per_shard * sizeof(T),
+                                         elements_per_shard * sizeof(T),
+                                         elements_per_shard);
+
+    if (!skewed) {
+      // Partition the output rows into contiguous ranges holding roughly
+      // equal numbers of updates; each shard scans the destinations and
+      // applies the updates that fall in its range.
+      std::vector<Eigen::DenseIndex> row_bounds;
+      row_bounds.reserve(num_shards + 1);
+      row_bounds.push_back(0);
+      Eigen::DenseIndex acc = 0;
+      for (Eigen::DenseIndex b = 0; b < num_buckets; ++b) {
+        acc += bucket_counts[b];
+        if (acc >= target_per_shard &&
+            row_bounds.size() < static_cast<size_t>(num_shards)) {
+          row_bounds.push_back(
+              std::min((b + 1) * bucket_width, num_rows));
+          acc = 0;
+        }
+      }
+      row_bounds.push_back(num_rows);
+      const Eigen::DenseIndex actual_shards = row_bounds.size() - 1;
+      d.parallelFor(actual_shards, shard_cost,
+                    [&](Eigen::DenseIndex start, Eigen::DenseIndex end) {
+                      for (Eigen::DenseIndex s = start; s < end; ++s) {
+                        const Index row_begin = row_bounds[s];
+                        const Index row_end = row_bounds[s + 1];
+                        for (Eigen::DenseIndex loc = 0; loc < valid_count;
+                             ++loc) {
+                          if (dest[loc] >= row_begin && dest[loc] < row_end) {
+                            apply_update(loc);
+                          }
+                        }
+                      }
+                    });
+    } else {
+      // Sort-based partition for skewed distributions: order the updates by
+      // destination row (stably, to preserve per-row application order) and
+      // split the order into equal-count chunks, never splitting a run of
+      // identical destinations across two shards.
+      std::vector<Eigen::DenseIndex> order(valid_count);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&dest](Eigen::DenseIndex a, Eigen::DenseIndex b) {
+                         return dest[a] < dest[b];
+                       });
+      std::vector<Eigen::DenseIndex> chunk_bounds;
+      chunk_bounds.reserve(num_shards + 1);
+      chunk_bounds.push_back(0);
+      Eigen::DenseIndex pos = 0;
+      while (chunk_bounds.size() < static_cast<size_t>(num_shards) &&
+             pos < valid_count) {
+        pos = std::min(pos + target_per_shard, valid_count);
+        while (pos < valid_count && dest[order[pos]] == dest[order[pos - 1]]) {
+          ++pos;
+        }
+        chunk_bounds.push_back(pos);
+      }
+      if (chunk_bounds.back() != valid_count) {
+        chunk_bounds.push_back(valid_count);
+      }
+      const Eigen::DenseIndex actual_shards = chunk_bounds.size() - 1;
+      d.parallelFor(actual_shards, shard_cost,
+                    [&](Eigen::DenseIndex start, Eigen::DenseIndex end) {
+                      for (Eigen::DenseIndex s = start; s < end; ++s) {
+                        for (Eigen::DenseIndex p = chunk_bounds[s];
+                             p < chunk_bounds[s + 1]; ++p) {
+                          apply_update(order[p]);
+                        }
+                      }
+                    });
     }
 
     return error_loc;
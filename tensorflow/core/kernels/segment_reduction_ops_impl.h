@@ -19,6 +19,8 @@ limitations under the License.
 #define TENSORFLOW_CORE_KERNELS_SEGMENT_REDUCTION_OPS_IMPL_H_
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/op_requires.h"
 #include "tensorflow/core/platform/types.h"
@@ -40,6 +42,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/segment_reduction_ops.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/prefetch.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/util.h"
 
@@ -125,80 +128,97 @@ class SegmentReductionOp : public OpKernel {
                 errors::InvalidArgument("segment ids must be >= 0"));
     auto output_flat = output->flat_outer_dims<T>();
 
-    Eigen::IndexList<Eigen::type2index<0> > dims_to_reduce;
-    Index start = 0, end = 1;
-
-    Index uninitialized_index = 0;  // Index from which the output is not set.
-    Index out_index = internal::SubtleMustCopy(segment_vec(start));
-
-    // TODO(agarwal): if this loop becomes a bottleneck, consider sharding it
-    // across threads.
-    Eigen::DSizes<Eigen::DenseIndex, 1> out_slice_shape(num_col);
-    while (end <= num_indices) {
-      // We initialize next_index to 0 to avoid "warning: 'next_index' may be
-      // used uninitialized in this function" in the Mac build (since the
-      // compiler isn't smart enough to realize the code is safe).
-      Index next_index = 0;
-      if (end < num_indices) {
-        next_index = internal::SubtleMustCopy(segment_vec(end));
-        if (out_index == next_index) {
-          ++end;
-          continue;
-        }
-        // We have a new segment here.  Verify that the segment ids are growing.
-        OP_REQUIRES(context, out_index < next_index,
+    // Pass 1 (serial, index vector only): find the start offset of every
+    // distinct segment and validate that the ids are in range and
+    // increasing. All OP_REQUIRES checks happen here so the reduction pass
+    // below can run on pool threads. The validated id is recorded alongside
+    // each start so that the reduction pass never re-reads the ids tensor;
+    // re-reading it would let a concurrent mutation bypass the bounds checks.
+    std::vector<std::pair<int64_t, Index>> segment_starts;
+    Index prev_id = 0;
+    for (int64_t i = 0; i < num_indices; ++i) {
+      const Index id = internal::SubtleMustCopy(segment_vec(i));
+      if (i == 0 || id != prev_id) {
+        OP_REQUIRES(
+            context, FastBoundsCheck(id, output_rows),
+            errors::InvalidArgument(
+                "Segment id ", id, " out of range [0, ", output_rows,
+                "), possibly because 'segment_ids' input is not sorted."));
+        OP_REQUIRES(context, i == 0 || id > prev_id,
                     errors::InvalidArgument("segment ids are not increasing"));
+        segment_starts.push_back({i, id});
+        prev_id = id;
       }
+    }
+    const int64_t num_segments = segment_starts.size();
+
+    // Pass 2: reduce each segment into its output row. Segments are
+    // partitioned across workers, so every output row (including the
+    // default-value rows for missing segment ids, which are attributed to
+    // the following present segment) has exactly one writer and each
+    // segment is accumulated serially in index order; the result is
+    // bit-exact identical to the single-threaded computation regardless of
+    // how the pool splits the range.
+    auto reduce_segments = [&](int64_t sbegin, int64_t send) {
+      Eigen::IndexList<Eigen::type2index<0> > dims_to_reduce;
+      Eigen::DSizes<Eigen::DenseIndex, 1> out_slice_shape(num_col);
+      for (int64_t s = sbegin; s < send; ++s) {
+        const int64_t start = segment_starts[s].first;
+        const int64_t end =
+            (s + 1 < num_segments) ? segment_starts[s + 1].first : num_indices;
+        const Index out_index = segment_starts[s].second;
+
+        // If there is a gap between two indices, we need to set that gap to
+        // the default value.
+        const Index gap_begin = (s == 0) ? 0 : segment_starts[s - 1].second + 1;
+        if (out_index > gap_begin) {
+          Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
+              out_index - gap_begin, num_col);
+          Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>,
+                           Eigen::Unaligned>
+              gap_slice(&output_flat(gap_begin, 0), gap_slice_shape);
+          gap_slice.setConstant(T(default_value));
+        }
 
-      // Process segment [start, end)
-      const T* in_slice_ptr = &input_flat(start, 0);
-      typedef Eigen::TensorMap<Eigen::Tensor<T, 1, Eigen::RowMajor>,
-                               Eigen::Unaligned>
-          OutT;
-
-      OP_REQUIRES(
-          context, FastBoundsCheck(out_index, output_rows),
-          errors::InvalidArgument(
-              "Segment id ", out_index, " out of range [0, ", output_rows,
-              "), possibly because 'segment_ids' input is not sorted."));
-
-      // If there is a gap between two indices, we need to set that gap to the
-      // default value.
-      if (out_index > uninitialized_index) {
-        Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
-            out_index - uninitialized_index, num_col);
-        Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>, Eigen::Unaligned>
-            gap_slice(&output_flat(uninitialized_index, 0), gap_slice_shape);
-        gap_slice.setConstant(T(default_value));
-      }
-
-      T* out_slice_ptr = &output_flat(out_index, 0);
-      OutT out_slice(out_slice_ptr, out_slice_shape);
-      // We don't use out_slice.device(context->eigen_device<Device>)
-      // because these pieces of work are likely to be very small and
-      // the context switching overhead dwarfs any benefit we get from
-      // using another thread to do this work.
-      if (start == end - 1) {
-        typedef Eigen::TensorMap<Eigen::Tensor<const T, 1, Eigen::RowMajor>,
-                                 Eigen::Unaligned>
-            InT;
-        InT in_slice(in_slice_ptr, out_slice_shape);
-        out_slice = in_slice;
-      } else {
-        Eigen::DSizes<Eigen::DenseIndex, 2> in_slice_shape(end - start,
-                                                           num_col);
-        typedef Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor>,
+        // Process segment [start, end)
+        const T* in_slice_ptr = &input_flat(start, 0);
+        typedef Eigen::TensorMap<Eigen::Tensor<T, 1, Eigen::RowMajor>,
                                  Eigen::Unaligned>
-            InT;
-        InT in_slice(in_slice_ptr, in_slice_shape);
-
-        out_slice = in_slice.reduce(dims_to_reduce, Reducer());
+            OutT;
+        T* out_slice_ptr = &output_flat(out_index, 0);
+        OutT out_slice(out_slice_ptr, out_slice_shape);
+        // We don't use out_slice.device(context->eigen_device<Device>)
+        // because these pieces of work are likely to be very small and
+        // the context switching overhead dwarfs any benefit we get from
+        // using another thread to do this work.
+        if (start == end - 1) {
+          typedef Eigen::TensorMap<Eigen::Tensor<const T, 1, Eigen::RowMajor>,
+                                   Eigen::Unaligned>
+              InT;
+          InT in_slice(in_slice_ptr, out_slice_shape);
+          out_slice = in_slice;
+        } else {
+          Eigen::DSizes<Eigen::DenseIndex, 2> in_slice_shape(end - start,
+                                                             num_col);
+          typedef Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor>,
+                                   Eigen::Unaligned>
+              InT;
+          InT in_slice(in_slice_ptr, in_slice_shape);
+
+          out_slice = in_slice.reduce(dims_to_reduce, Reducer());
+        }
       }
-      if (end >= num_indices) break;
-      start = end;
-      ++end;
-      uninitialized_index = out_index + 1;
-      out_index = next_index;
+    };
+
+    if (num_segments > 0) {
+      const int64_t avg_rows_per_segment = num_indices / num_segments;
+      const int64_t compute_cycles = 5 * num_col * avg_rows_per_segment;
+      const int64_t input_bytes = sizeof(T) * num_col * avg_rows_per_segment;
+      const int64_t output_bytes = sizeof(T) * num_col;
+      const Eigen::TensorOpCost cost(input_bytes, output_bytes,
+                                     compute_cycles);
+      context->eigen_cpu_device().parallelFor(num_segments, cost,
+                                              reduce_segments);
     }
   }
 };
@@ -828,6 +848,18 @@ class SparseSegmentReductionOpBase : public OpKernel {
         }
       }
       for (; r < num; r += 8) {
+        // Prefetch the rows of the next block while the current one is being
+        // accumulated. Embedding lookups are effectively random access into a
+        // table much larger than L2, so without this the adds below stall on
+        // every row fetch.
+        const int64_t prefetch_end = std::min(num, r + 16);
+        for (int64_t p = r + 8; p < prefetch_end; ++p) {
+          const auto prefetch_index = indices_vec(start + p);
+          if (FastBoundsCheck(prefetch_index, input_flat.dimension(0))) {
+            port::prefetch<port::PREFETCH_HINT_T0>(
+                &input_flat(prefetch_index, 0));
+          }
+        }
         INDEX(0, r);
         INDEX(1, r + 1);
         INDEX(2, r + 2);
@@ -57,6 +57,11 @@ namespace tensorflow {
 static constexpr int32_t kMaxShards = 20;
 // Number of shards allocated to each thread.
 static constexpr int32_t kNumShardsPerThread = 3;
+// Rough relative cost of moving one nonzero while transposing a CSR matrix (a
+// random scatter) versus touching one element of a dense accumulation buffer
+// (a streaming access). Used to choose between the two transposed-LHS matmul
+// strategies below.
+static constexpr int32_t kCsrTransposeCostPerNnz = 4;
 
 typedef Eigen::ThreadPoolDevice CPUDevice;
 typedef Eigen::GpuDevice GPUDevice;
@@ -216,6 +221,17 @@ class CSRMatMulCPUOp : public CSRMatMulOp<CPUDevice, T> {
     if (!this->transpose_a_) {
       SparseDenseMatMulWithoutTransposedLHS(
           ctx, batch_size, num_lhs_rows, *sparse_matrix_a, *rhs, matmul_result);
+    } else if (ShouldTransposeLHS(ctx, *sparse_matrix_a,
+                                  matmul_result->NumElements())) {
+      // A is hypersparse relative to the output: materialize A^T once with an
+      // O(nnz) pass and reuse the row-partitioned kernel, instead of summing
+      // per-thread copies of the output below.
+      functor::CSRSparseMatrixTranspose<CPUDevice, T> transpose;
+      CSRSparseMatrix a_transposed;
+      OP_REQUIRES_OK(ctx, transpose(ctx, this->conjugate_a_, *sparse_matrix_a,
+                                    &a_transposed));
+      SparseDenseMatMulWithoutTransposedLHS(ctx, batch_size, num_lhs_rows,
+                                            a_transposed, *rhs, matmul_result);
     } else {  // transpose_a_ == true
       SparseDenseMatMulWithTransposedLHS(ctx, batch_size, num_lhs_rows,
                                          num_lhs_cols, *sparse_matrix_a, *rhs,
@@ -235,6 +251,20 @@ class CSRMatMulCPUOp : public CSRMatMulOp<CPUDevice, T> {
   }
 
  private:
+  // Decides whether to compute A^T * B by explicitly transposing the sparse
+  // matrix A, rather than via the identity (A^T B) = (B^T A)^T which
+  // accumulates into (num_threads + 1) per-thread copies of the output. The
+  // explicit transpose costs one O(nnz) scatter pass per batch; the
+  // accumulation path zeroes and reduces every copy of the output. Compare
+  // the two in units of memory traffic.
+  bool ShouldTransposeLHS(OpKernelContext* ctx, const CSRSparseMatrix& lhs,
+                          const int64_t output_size) {
+    const int32_t num_threads =
+        ctx->device()->tensorflow_cpu_worker_threads()->num_threads;
+    return static_cast<int64_t>(lhs.total_nnz()) * kCsrTransposeCostPerNnz <
+           (num_threads + 1) * output_size;
+  }
+
   // Allocates the output with the appropriate shape. Additionally, if
   // transpose_output is True, allocates a temporary buffer with the transposed
   // output. 'matmul_result' points to either output or output_transposed, based
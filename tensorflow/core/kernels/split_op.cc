@@ -89,8 +89,11 @@ class SplitOpBase : public OpKernel {
     // the resulting tensors must be aligned. It's conservative
     // because if the immediate consumer of the resulting tensors are
     // not using eigen for computation, its perfectly fine to avoid
-    // the copying.
-    if ((split_dim == 0) && IsInnerDimsSizeAligned<T>(input_shape)) {
+    // the copying. Every output starts at a multiple of `delta` rows, so it
+    // suffices that a slice starting at row `delta` is aligned.
+    if ((split_dim == 0) &&
+        IsDim0SliceAligned<T>(input_shape,
+                              input_shape.dim_size(0) / num_split)) {
       VLOG(1) << "Slice dim 0: " << input_shape.DebugString();
       const int64_t delta = input_shape.dim_size(0) / num_split;
       for (int i = 0; i < num_split; ++i) {
@@ -202,7 +202,7 @@ class SplitVOpBase : public OpKernel {
     }
     Tlen start = 0;
     for (const Tlen split_size : split_sizes) {
-      if (!IsDim0SliceAligned<T>(input_shape, start, start + split_size)) {
+      if (!IsDim0SliceAligned<T>(input_shape, start)) {
         return false;
       }
       start += split_size;
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/stack.h"
 
 #include <limits.h>
+#include <array>
 #include <atomic>
 #include <vector>
 
@@ -27,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/bits.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
@@ -35,9 +37,23 @@ limitations under the License.
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
+// A per-step LIFO of tensors, used mostly by while_loop gradient
+// accumulation which pushes once per forward iteration and pops once per
+// backward iteration.  Storage is a growable arena of geometrically sized
+// chunks, so growth never relocates (and never re-refs) previously pushed
+// tensors, and slot addresses are stable for the stack's lifetime.
+//
+// Pushes on one stack are serialized by the loop-carried dependencies of
+// the enclosing frame, so Push claims its slot with a single atomic
+// increment and only takes the mutex when a new chunk must be allocated.
+// Pop, Close and the swap heuristic keep the mutex; a per-slot `ready`
+// flag hands each slot off between a claiming pusher and the popper so
+// that even an (illegal, graph-level) race cannot observe a half-written
+// slot.
 class Stack : public ResourceBase {
  public:
   static std::atomic<int64_t> stack_counter;
@@ -54,27 +70,55 @@ class Stack : public ResourceBase {
         max_size_(max_size),
         closed_(false) {}
 
+  ~Stack() override {
+    for (std::atomic<Slot*>& chunk : chunks_) {
+      delete[] chunk.load(std::memory_order_relaxed);
+    }
+  }
+
   Status Push(const TensorAndAllocation& value) {
-    mutex_lock l(mu_);
-    TF_RETURN_IF_ERROR(CheckNotClosed());
-    int stack_size = stack_.size();
-    if (max_size_ >= 0 && stack_size >= max_size_) {
+    if (TF_PREDICT_FALSE(closed_.load(std::memory_order_acquire))) {
+      return ClosedError();
+    }
+    const int64_t index = top_.fetch_add(1, std::memory_order_acq_rel);
+    if (max_size_ >= 0 && index >= max_size_) {
+      top_.fetch_sub(1, std::memory_order_acq_rel);
       return errors::InvalidArgument("Stack[", stack_name_, "] overflowed ",
                                      "its max_size (", max_size_, ")");
     }
-    stack_.push_back(value);
+    Slot* slot = SlotFor(index);
+    // If a popper that handed this index back is still extracting the old
+    // value, wait for it to release the slot.  Graph-level ordering of the
+    // stack ops makes this wait unreachable in practice.
+    while (slot->ready.load(std::memory_order_acquire)) {
+    }
+    slot->value = value;
+    slot->ready.store(true, std::memory_order_release);
     return OkStatus();
   }
 
   Status Pop(TensorAndAllocation* value) {
     mutex_lock l(mu_);
-    TF_RETURN_IF_ERROR(CheckNotClosed());
-    if (stack_.empty()) {
-      return errors::InvalidArgument("Stack[", stack_name_,
-                                     "] is empty when calling Pop().");
+    if (closed_.load(std::memory_order_acquire)) {
+      return ClosedError();
     }
-    *value = stack_.back();
-    stack_.pop_back();
+    int64_t top = top_.load(std::memory_order_acquire);
+    do {
+      if (top <= 0) {
+        return errors::InvalidArgument("Stack[", stack_name_,
+                                       "] is empty when calling Pop().");
+      }
+      // CAS rather than a plain store: a concurrent Push claims slots with
+      // fetch_add on the same counter.
+    } while (!top_.compare_exchange_weak(top, top - 1,
+                                         std::memory_order_acq_rel));
+    Slot* slot = SlotFor(top - 1);
+    // Wait for an in-flight pusher to finish publishing the slot.
+    while (!slot->ready.load(std::memory_order_acquire)) {
+    }
+    *value = std::move(slot->value);
+    slot->value = TensorAndAllocation();
+    slot->ready.store(false, std::memory_order_release);
     return OkStatus();
   }
 
@@ -82,23 +126,32 @@ class Stack : public ResourceBase {
   // that share the buffer with the first tensor.
   bool IsUsefulToSwap(const Tensor& tensor) const {
     mutex_lock l(mu_);
-    if (stack_.empty()) {
+    if (top_.load(std::memory_order_acquire) <= 0) {
+      return false;
+    }
+    Slot* first_chunk = chunks_[0].load(std::memory_order_acquire);
+    if (first_chunk == nullptr ||
+        !first_chunk[0].ready.load(std::memory_order_acquire)) {
       return false;
     }
-    const Tensor& first = stack_.front().tensor;
-    return !tensor.SharesBufferWith(first);
+    return !tensor.SharesBufferWith(first_chunk[0].value.tensor);
   }
 
   void Close() {
     mutex_lock l(mu_);
-    stack_.clear();
-    closed_ = true;
+    closed_.store(true, std::memory_order_release);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    for (int64_t i = 0; i < top; ++i) {
+      Slot* slot = SlotFor(i);
+      slot->value = TensorAndAllocation();
+      slot->ready.store(false, std::memory_order_release);
+    }
+    top_.store(0, std::memory_order_release);
   }
 
   DataType ElemType() { return elem_type_; }
 
   string DebugString() const override {
-    mutex_lock l(mu_);
     return strings::StrCat("Stack[", stack_name_, "]");
   }
 
@@ -108,21 +161,47 @@ class Stack : public ResourceBase {
   friend class StackOp;
   mutex* mu() { return &mu_; }
 
+  struct Slot {
+    std::atomic<bool> ready{false};
+    TensorAndAllocation value;
+  };
+
+  // Chunk c holds (kFirstChunkSize << c) slots; 48 chunks cover any
+  // representable stack depth while keeping the pointer table small enough
+  // to embed in the resource.
+  static constexpr int64_t kFirstChunkSize = 8;
+  static constexpr int kMaxChunks = 48;
+
+  // Returns the slot for `index`, allocating its chunk if needed.
+  Slot* SlotFor(int64_t index) {
+    const int chunk = Log2Floor64(index / kFirstChunkSize + 1);
+    const int64_t offset = index - kFirstChunkSize * ((1LL << chunk) - 1);
+    Slot* slots = chunks_[chunk].load(std::memory_order_acquire);
+    if (TF_PREDICT_FALSE(slots == nullptr)) {
+      mutex_lock l(mu_);
+      slots = chunks_[chunk].load(std::memory_order_relaxed);
+      if (slots == nullptr) {
+        slots = new Slot[kFirstChunkSize << chunk];
+        chunks_[chunk].store(slots, std::memory_order_release);
+      }
+    }
+    return &slots[offset];
+  }
+
+  Status ClosedError() const {
+    return errors::InvalidArgument("Stack[", stack_name_,
+                                   "] has already been closed.");
+  }
+
   mutable mutex mu_;
   DataType elem_type_;
   const string stack_name_;
   Tensor handle_;
   int max_size_;
-  bool closed_ TF_GUARDED_BY(mu_);
-  std::vector<TensorAndAllocation> stack_ TF_GUARDED_BY(mu_);
-
-  Status CheckNotClosed() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    if (closed_) {
-      return errors::InvalidArgument("Stack[", stack_name_,
-                                     "] has already been closed.");
-    }
-    return OkStatus();
-  }
+  std::atomic<bool> closed_;
+  // Number of elements on the stack; also the claim counter for pushers.
+  std::atomic<int64_t> top_{0};
+  mutable std::array<std::atomic<Slot*>, kMaxChunks> chunks_{};
 };
 
 Status GetStack(OpKernelContext* ctx, Stack** stack) {
@@ -237,11 +316,25 @@ void StackPushOp::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
   AllocatorAttributes alloc_attrs = ctx->input_alloc_attr(1);
   // For now, we use a simple heuristic for swapping: A GPU tensor is moved
   // to CPU if the tensor has more than kCopyThreshold bytes and the GPU
-  // allocator says more than kOccupancy of the memory is in use.
-  static constexpr int kCopyThreshold = 2048;
-  static constexpr double kOccupancy = 0.7;
+  // allocator says more than kOccupancy of the memory is in use.  Both
+  // thresholds apply process-wide so a training job can tune them without
+  // editing every while_loop in the graph; the defaults match the
+  // historical hard-coded values.
+  static const int64_t kCopyThreshold = []() {
+    int64_t v = 2048;
+    Status s = ReadInt64FromEnvVar("TF_STACK_SWAP_COPY_THRESHOLD_BYTES", v, &v);
+    if (!s.ok()) LOG(WARNING) << s.error_message();
+    return v;
+  }();
+  static const float kOccupancy = []() {
+    float v = 0.7f;
+    Status s = ReadFloatFromEnvVar("TF_STACK_SWAP_OCCUPANCY", v, &v);
+    if (!s.ok()) LOG(WARNING) << s.error_message();
+    return v;
+  }();
   if (swap_memory_ && !alloc_attrs.on_host() &&
-      tensor.TotalBytes() > kCopyThreshold && stack->IsUsefulToSwap(tensor)) {
+      static_cast<int64_t>(tensor.TotalBytes()) > kCopyThreshold &&
+      stack->IsUsefulToSwap(tensor)) {
     DeviceContext* device_ctxt = ctx->op_device_context();
     auto device = static_cast<tensorflow::Device*>(ctx->device());
     Allocator* allocator = device->GetAllocator(alloc_attrs);
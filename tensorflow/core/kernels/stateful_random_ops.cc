@@ -107,6 +107,8 @@ Status UpdateVariableAndFill(
   }
   if (alg == RNG_ALG_PHILOX) {
     TF_RETURN_IF_ERROR(CheckPhiloxState(*var_tensor, alg_tag_skip));
+    // Drop any published read snapshot before checking the buffer refcount.
+    var->InvalidateSnapshot();
     TF_RETURN_IF_ERROR(PrepareToUpdateVariable<Device, StateElementType>(
         ctx, var_tensor, var->copy_on_read_mode.load()));
 
@@ -280,6 +282,8 @@ class RngSkipOp : public OpKernel {
     Tensor* var_tensor = var->tensor();
     OP_REQUIRES_OK(ctx, CheckState(*var_tensor));
     using T = StateElementType;
+    // Drop any published read snapshot before checking the buffer refcount.
+    var->InvalidateSnapshot();
     OP_REQUIRES_OK(ctx, PrepareToUpdateVariable<Device, T>(
                             ctx, var_tensor, var->copy_on_read_mode.load()));
     if (read_old_value) {
@@ -119,7 +119,7 @@ class StridedSliceOp : public OpKernel {
     }
 
     // Optimization #2, slice is memory contiguous (only occurs in dim 0)
-    if (slice_dim0 && IsDim0SliceAligned<T>(input.shape(), begin[0], end[0])) {
+    if (slice_dim0 && IsDim0SliceAligned<T>(input.shape(), begin[0])) {
       OP_REQUIRES(context, input.dims() >= 1,
                   errors::InvalidArgument(
                       "Input must have rank at least 1, got: ", input.dims()));
@@ -134,6 +134,58 @@ class StridedSliceOp : public OpKernel {
       return;
     }
 
+    // Optimization #2b, slice is a single contiguous region of the input.
+    // This covers unit-stride slices which pin every axis before some axis k
+    // to a single index, take an arbitrary range of axis k, and take every
+    // later axis in full (e.g. x[3, 5:9] or x[b, t0:t1, :], common for
+    // windows over an outer dimension). Collapsing the input to a matrix
+    // whose rows are slices of axis k turns this into a dim-0 slice, which
+    // can alias the input buffer just like Optimization #2. Aliasing is safe
+    // for the same reason it is above: tensors are immutable once produced.
+    if (is_simple_slice && new_axis_mask == 0 && input.dims() > 0 &&
+        processing_shape.num_elements() > 0) {
+      int slice_axis = -1;
+      bool contiguous = true;
+      for (int i = input.dims() - 1; i >= 0; --i) {
+        const int64_t extent = processing_shape.dim_size(i);
+        if (slice_axis == -1) {
+          if (extent != input.dim_size(i)) slice_axis = i;
+        } else if (extent != 1) {
+          contiguous = false;
+          break;
+        }
+      }
+      // slice_axis == 0 is Optimization #2 (and fails the same alignment
+      // check when that path fell through); slice_axis == -1 is the identity.
+      if (contiguous && slice_axis > 0) {
+        int64_t outer_rows = 1;
+        int64_t row_begin = 0;
+        for (int i = 0; i <= slice_axis; ++i) {
+          outer_rows *= input.dim_size(i);
+          row_begin = row_begin * input.dim_size(i) + begin[i];
+        }
+        int64_t inner = 1;
+        for (int i = slice_axis + 1; i < input.dims(); ++i) {
+          inner *= input.dim_size(i);
+        }
+        const TensorShape collapsed_shape({outer_rows, inner});
+        if (IsDim0SliceAligned<T>(collapsed_shape, row_begin)) {
+          VLOG(1) << "Strided slice contiguous region of "
+                  << input.shape().DebugString();
+          Tensor collapsed;
+          OP_REQUIRES(context, collapsed.CopyFrom(input, collapsed_shape),
+                      errors::Internal("Copy failed"));
+          Tensor slice = collapsed.Slice(
+              row_begin, row_begin + processing_shape.dim_size(slice_axis));
+          Tensor tmp;
+          OP_REQUIRES(context, tmp.CopyFrom(slice, final_shape),
+                      errors::Internal("Copy failed"));
+          context->set_output(0, tmp);
+          return;
+        }
+      }
+    }
+
     Tensor* result = nullptr;
     OP_REQUIRES_OK(context, context->allocate_output(0, final_shape, &result));
     const int input_dims = input.dims();
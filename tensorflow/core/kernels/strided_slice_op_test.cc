@@ -15,9 +15,13 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <numeric>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
@@ -35,6 +39,88 @@ limitations under the License.
 namespace tensorflow {
 namespace {
 
+class StridedSliceOpTest : public OpsTestBase {
+ protected:
+  void MakeOp() {
+    TF_EXPECT_OK(NodeDefBuilder("strided_slice_op", "StridedSlice")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_INT32))
+                     .Input(FakeInput(DT_INT32))
+                     .Input(FakeInput(DT_INT32))
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+  }
+
+  // Adds a {4, 8, 32} float input whose value at flat index i is i, so that
+  // expected slices can be written down as flat offsets. 32 floats per
+  // innermost row keeps every row EIGEN_MAX_ALIGN_BYTES-aligned.
+  void AddIotaInput() {
+    std::vector<float> values(4 * 8 * 32);
+    std::iota(values.begin(), values.end(), 0.0f);
+    AddInputFromArray<float>(TensorShape({4, 8, 32}), values);
+  }
+};
+
+// x[1:2, 2:6, :] is one contiguous region of the input, so the output must
+// alias the input buffer at the offset of row (1 * 8 + 2).
+TEST_F(StridedSliceOpTest, ContiguousRegionAliasesInput) {
+  MakeOp();
+  AddIotaInput();
+  AddInputFromArray<int32>(TensorShape({3}), {1, 2, 0});
+  AddInputFromArray<int32>(TensorShape({3}), {2, 6, 32});
+  AddInputFromArray<int32>(TensorShape({3}), {1, 1, 1});
+  const float* input_base = mutable_input(0).tensor->flat<float>().data();
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({1, 4, 32}));
+  test::FillFn<float>(&expected,
+                      [](int i) -> float { return (1 * 8 + 2) * 32 + i; });
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+  EXPECT_EQ(input_base + (1 * 8 + 2) * 32, GetOutput(0)->flat<float>().data());
+}
+
+// A stride of 2 on the sliced axis is not a contiguous region; the result
+// must be computed into a freshly allocated buffer.
+TEST_F(StridedSliceOpTest, StridedSliceDoesNotAliasInput) {
+  MakeOp();
+  AddIotaInput();
+  AddInputFromArray<int32>(TensorShape({3}), {1, 2, 0});
+  AddInputFromArray<int32>(TensorShape({3}), {2, 6, 32});
+  AddInputFromArray<int32>(TensorShape({3}), {1, 2, 1});
+  const float* input_base = mutable_input(0).tensor->flat<float>().data();
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({1, 2, 32}));
+  test::FillFn<float>(&expected, [](int i) -> float {
+    return (1 * 8 + 2 + 2 * (i / 32)) * 32 + i % 32;
+  });
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+  const float* output_base = GetOutput(0)->flat<float>().data();
+  EXPECT_TRUE(output_base < input_base ||
+              output_base >= input_base + 4 * 8 * 32);
+}
+
+// Slicing the innermost axis to less than its full extent makes the selected
+// elements non-contiguous, so the contiguous-region path must not trigger.
+TEST_F(StridedSliceOpTest, PartialInnerDimDoesNotAliasInput) {
+  MakeOp();
+  AddIotaInput();
+  AddInputFromArray<int32>(TensorShape({3}), {1, 2, 0});
+  AddInputFromArray<int32>(TensorShape({3}), {2, 6, 8});
+  AddInputFromArray<int32>(TensorShape({3}), {1, 1, 1});
+  const float* input_base = mutable_input(0).tensor->flat<float>().data();
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({1, 4, 8}));
+  test::FillFn<float>(&expected, [](int i) -> float {
+    return (1 * 8 + 2 + i / 8) * 32 + i % 8;
+  });
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+  const float* output_base = GetOutput(0)->flat<float>().data();
+  EXPECT_TRUE(output_base < input_base ||
+              output_base >= input_base + 4 * 8 * 32);
+}
+
 // For the benchmark, we set up two 2-dimensional tensors, each kDim1 x 'dim'
 // in size, and concat them together along "concat_dimension"
 template <typename T>
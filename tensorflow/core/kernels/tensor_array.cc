@@ -114,4 +114,27 @@ Status TensorArray::CopyShapesFrom(TensorArray* rhs,
   return OkStatus();
 }
 
+bool TensorArray::TryPackContiguous(const int32_t num_indices, Tensor* value) {
+  mutex_lock l(mu_);
+  if (!use_contiguous_storage_ || closed_ ||
+      !contiguous_storage_.IsInitialized()) {
+    return false;
+  }
+  if (static_cast<size_t>(num_indices) != tensors_.size()) return false;
+  for (const TensorAndState& t : tensors_) {
+    if (!t.in_contiguous_storage || t.cleared) return false;
+  }
+  *value = contiguous_storage_;
+  for (TensorAndState& t : tensors_) {
+    t.read = true;
+    if (clear_after_read_) t.cleared = true;
+  }
+  if (clear_after_read_) {
+    // Drop the array's own reference; '*value' keeps the buffer alive for
+    // the consumer.
+    contiguous_storage_ = Tensor();
+  }
+  return true;
+}
+
 }  // namespace tensorflow
@@ -152,6 +152,10 @@ class TensorArray : public ResourceBase {
         marked_size_(marked_size),
         element_shape_(element_shape),
         identical_element_shapes_(identical_element_shapes),
+        use_contiguous_storage_(!dynamic_size && !multiple_writes_aggregate &&
+                                !is_grad && N > 0 &&
+                                element_shape.IsFullyDefined() &&
+                                DataTypeCanUseMemcpy(dtype)),
         tensors_(N) {}
 
   // Write Tensor 'value' to index 'index'.
@@ -333,10 +337,19 @@ class TensorArray : public ResourceBase {
   // to the rhs to access its mutex.
   Status CopyShapesFrom(TensorArray* rhs, const TensorShape* shape_to_prepend);
 
+  // If the TensorArray is backed by one contiguous buffer and every index
+  // has been written (and none cleared), returns that buffer of shape
+  // [Size()] + element_shape in '*value' without copying, marking all
+  // indices as read.  'num_indices' must equal Size().  Returns false when
+  // the fast path does not apply; the caller should then fall back to
+  // reading the elements individually.
+  bool TryPackContiguous(int32_t num_indices, Tensor* value);
+
   // Clear the TensorArray, including any Tensor references, and mark as closed.
   void ClearAndMarkClosed() {
     mutex_lock l(mu_);
     tensors_.clear();
+    contiguous_storage_ = Tensor();
     closed_ = true;
   }
 
@@ -361,6 +374,21 @@ class TensorArray : public ResourceBase {
   Status LockedRead(OpKernelContext* ctx, const int32_t index, Tensor* value)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Copies 'value' in place into row 'index' of the contiguous backing
+  // buffer, allocating the buffer of shape [Size()] + element_shape on the
+  // first write.  Only called when 'use_contiguous_storage_' is set, which
+  // restricts the element type to memcpy-able dtypes.
+  template <typename Device>
+  Status LockedWriteContiguous(OpKernelContext* ctx, const int32_t index,
+                               const Tensor* value)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Emits row 'index' of the contiguous backing buffer, as an alias when the
+  // row satisfies the tensor alignment requirement and as a copy otherwise.
+  template <typename Device>
+  Status LockedReadContiguous(OpKernelContext* ctx, const int32_t index,
+                              Tensor* value) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   Status LockedReturnIfClosed() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     if (closed_) {
       return errors::InvalidArgument("TensorArray ", handle_.vec<tstring>()(1),
@@ -411,6 +439,18 @@ class TensorArray : public ResourceBase {
   // was not fully defined.
   const bool identical_element_shapes_;
 
+  // True if the TensorArray is backed by one contiguous buffer of shape
+  // [N] + element_shape instead of one Tensor per element: the size is
+  // fixed, the element shape is fully known up front, writes are not
+  // aggregated and the dtype is memcpy-able.  Writes then land in place in
+  // the buffer and a full in-order gather returns the buffer itself (see
+  // TryPackContiguous), cutting per-element allocator traffic.
+  const bool use_contiguous_storage_;
+
+  // The contiguous backing buffer; allocated lazily on the first write when
+  // 'use_contiguous_storage_' is set.
+  Tensor contiguous_storage_ TF_GUARDED_BY(mu_);
+
   // TensorAndState is used to keep track of the Tensors stored in the
   // TensorArray, along with their shapes, and a boolean that determines whether
   // they have already been read or not.
@@ -423,6 +463,10 @@ class TensorArray : public ResourceBase {
     bool read;  // True if a Tensor has been written to and read from the index.
     bool cleared;  // True if a tensor has been read with
                    // clear_after_read = true;
+    // True if the value lives in 'contiguous_storage_' rather than in
+    // 'tensor'.  Entries that were only marked written (e.g. zero-filled
+    // reads or CopyShapesFrom) never set this.
+    bool in_contiguous_storage = false;
 
     // Used by writes when multiple_writes_aggregate is true.  In this
     // case, the first time a value is written, it is a shallow copy.
@@ -531,13 +575,67 @@ Status TensorArray::LockedWriteOrAggregate(OpKernelContext* ctx,
     // TensorArray.
     gradients_disallowed_ = true;
   } else {
-    t.tensor = *value;
+    if (use_contiguous_storage_) {
+      // element_shape_ is fully defined, so a compatible value has exactly
+      // that shape and fills one row of the backing buffer.
+      TF_RETURN_IF_ERROR(LockedWriteContiguous<Device>(ctx, index, value));
+      t.in_contiguous_storage = true;
+    } else {
+      t.tensor = *value;
+    }
     t.shape = value->shape();
     t.written = true;
   }
   return OkStatus();
 }
 
+template <typename Device>
+Status TensorArray::LockedWriteContiguous(OpKernelContext* ctx,
+                                          const int32_t index,
+                                          const Tensor* value) {
+  if (!contiguous_storage_.IsInitialized()) {
+    TensorShape storage_shape;
+    element_shape_.AsTensorShape(&storage_shape);  // Always succeeds.
+    storage_shape.InsertDim(0, tensors_.size());
+    TF_RETURN_IF_ERROR(
+        ctx->allocate_temp(dtype_, storage_shape, &contiguous_storage_));
+  }
+  const int64_t element_bytes = value->TotalBytes();
+  if (element_bytes > 0) {
+    char* dst = const_cast<char*>(contiguous_storage_.tensor_data().data()) +
+                index * element_bytes;
+    ctx->eigen_device<Device>().memcpy(dst, value->tensor_data().data(),
+                                       element_bytes);
+  }
+  return OkStatus();
+}
+
+template <typename Device>
+Status TensorArray::LockedReadContiguous(OpKernelContext* ctx,
+                                         const int32_t index, Tensor* value) {
+  Tensor row = contiguous_storage_.Slice(index, index + 1);
+  const TensorShape& element_shape = tensors_[index].shape;
+  if (row.IsAligned()) {
+    Tensor aliased;
+    if (!aliased.CopyFrom(row, element_shape)) {
+      return errors::Internal("TensorArray ", handle_.vec<tstring>()(1),
+                              ": failed to alias contiguous storage row ",
+                              index);
+    }
+    *value = aliased;
+    return OkStatus();
+  }
+  // The row starts at an unaligned offset; downstream kernels may assume
+  // aligned inputs, so hand out a copy instead.
+  TF_RETURN_IF_ERROR(ctx->allocate_temp(dtype_, element_shape, value));
+  if (row.TotalBytes() > 0) {
+    ctx->eigen_device<Device>().memcpy(
+        const_cast<char*>(value->tensor_data().data()),
+        row.tensor_data().data(), row.TotalBytes());
+  }
+  return OkStatus();
+}
+
 template <typename Device, typename T>
 Status TensorArray::LockedRead(OpKernelContext* ctx, const int32_t index,
                                Tensor* value) {
@@ -600,6 +698,17 @@ Status TensorArray::LockedRead(OpKernelContext* ctx, const int32_t index,
                                    "clear_after_read = false?).");
   }
 
+  if (t.in_contiguous_storage) {
+    TF_RETURN_IF_ERROR(LockedReadContiguous<Device>(ctx, index, value));
+    if (clear_after_read_) {
+      // The backing buffer cannot release individual rows; only the
+      // bookkeeping that prevents a second read is performed.
+      t.cleared = true;
+    }
+    t.read = true;
+    return OkStatus();
+  }
+
   if (!t.tensor.IsInitialized() || t.tensor.NumElements() == 0) {
     // We stored just a shape, but no value.  This means create and
     // return zeros of the appropriate shape.
@@ -649,6 +649,24 @@ class TensorArrayPackOrGatherOp : public OpKernel {
       return;
     }
 
+    // If the array is backed by one contiguous buffer and the gather covers
+    // every index in order, the result is exactly that buffer: emit it
+    // without reading or concatenating the individual elements.
+    bool sequential_indices = true;
+    for (int i = 0; i < num_indices; ++i) {
+      if (indices[i] != i) {
+        sequential_indices = false;
+        break;
+      }
+    }
+    if (sequential_indices) {
+      Tensor packed;
+      if (tensor_array->TryPackContiguous(num_indices, &packed)) {
+        ctx->set_output(0, packed);
+        return;
+      }
+    }
+
     // Read all the Tensors into a vector to keep track of their memory.
     Status s = tensor_array->ReadMany<Device, T>(ctx, indices, &values);
     OP_REQUIRES_OK(ctx, s);
@@ -141,6 +141,118 @@ struct TopKFunctor<CPUDevice, T> {
       return OkStatus();
     }
 
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+
+    // Cost of a single comparison in the selection loops below.
+    const double cmp_cost = 3 * Eigen::TensorOpCost::AddCost<int32>() +
+                            Eigen::TensorOpCost::AddCost<T>();
+
+    // When there are only a few very wide rows, sharding across rows alone
+    // cannot fill the intra-op pool. In that regime each row is split into
+    // column shards: every shard selects its own top-k candidates, and a
+    // cheap per-row merge selects the final top-k out of the (few) shard
+    // candidates. The comparator orders by (value, index), which is a total
+    // order, so the merged result is bit-identical to a single-pass
+    // selection over the whole row.
+    constexpr int64_t kMinColsPerShard = 1 << 14;
+    const int64_t num_threads = worker_threads.num_threads;
+    if (k > 1 && k < num_cols && num_rows < num_threads &&
+        num_cols >= 2 * kMinColsPerShard) {
+      const int64_t max_shards_by_size = num_cols / kMinColsPerShard;
+      const int64_t wanted_shards = (num_threads + num_rows - 1) / num_rows;
+      const int64_t num_shards = std::min(max_shards_by_size, wanted_shards);
+      if (num_shards > 1) {
+        const int64_t cols_per_shard =
+            (num_cols + num_shards - 1) / num_shards;
+        Tensor candidates_t;
+        TF_RETURN_IF_ERROR(context->allocate_temp(
+            DT_INT32, TensorShape({num_rows, num_shards * k}), &candidates_t));
+        auto candidates = candidates_t.matrix<int32>();
+
+        // Number of candidates shard `s` contributes for any row.
+        auto shard_candidates = [&](int64_t s) {
+          const int64_t col_begin = s * cols_per_shard;
+          const int64_t col_end =
+              std::min(num_cols, col_begin + cols_per_shard);
+          return std::min<int64_t>(k, col_end - col_begin);
+        };
+
+        auto select_shard = [&](int64_t begin, int64_t end) {
+          for (int64_t unit = begin; unit < end; ++unit) {
+            const int64_t b = unit / num_shards;
+            const int64_t s = unit % num_shards;
+            const int64_t col_begin = s * cols_per_shard;
+            const int64_t col_end =
+                std::min(num_cols, col_begin + cols_per_shard);
+            const T* input_data = &input(b, 0);
+            const auto stable_comp = [input_data](const int32_t a,
+                                                  const int32_t b) {
+              if (input_data[b] < input_data[a]) {
+                return true;
+              } else if (input_data[b] > input_data[a]) {
+                return false;
+              } else {
+                return a < b;
+              }
+            };
+            gtl::TopN<int32, decltype(stable_comp)> filter(shard_candidates(s),
+                                                           stable_comp);
+            filter.reserve(col_end - col_begin);
+            for (int32_t c = col_begin; c < col_end; ++c) {
+              filter.push(c);
+            }
+            std::unique_ptr<std::vector<int32>> top_k(filter.Extract());
+            int64_t out = s * k;
+            for (const int32_t c : *top_k) {
+              candidates(b, out++) = c;
+            }
+          }
+        };
+        const double select_cost =
+            cmp_cost * cols_per_shard *
+            Eigen::numext::log2(static_cast<float>(k + 1));
+        Shard(worker_threads.num_threads, worker_threads.workers,
+              num_rows * num_shards, static_cast<int64_t>(select_cost),
+              select_shard);
+
+        auto merge_rows = [&](int64_t start_batch, int64_t limit_batch) {
+          std::vector<int32> merged;
+          for (int64_t b = start_batch; b < limit_batch; ++b) {
+            const T* input_data = &input(b, 0);
+            const auto stable_comp = [input_data](const int32_t a,
+                                                  const int32_t b) {
+              if (input_data[b] < input_data[a]) {
+                return true;
+              } else if (input_data[b] > input_data[a]) {
+                return false;
+              } else {
+                return a < b;
+              }
+            };
+            merged.clear();
+            for (int64_t s = 0; s < num_shards; ++s) {
+              const int64_t num_candidates = shard_candidates(s);
+              for (int64_t i = 0; i < num_candidates; ++i) {
+                merged.push_back(candidates(b, s * k + i));
+              }
+            }
+            std::partial_sort(merged.begin(), merged.begin() + k, merged.end(),
+                              stable_comp);
+            std::copy(merged.begin(), merged.begin() + k, &indices(b, 0));
+            std::transform(
+                &indices(b, 0), &indices(b, k), &values(b, 0),
+                [b, &input](const int32_t loc) { return input(b, loc); });
+          }
+        };
+        const double merge_cost =
+            cmp_cost * num_shards * k *
+            Eigen::numext::log2(static_cast<float>(k + 1));
+        Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
+              static_cast<int64_t>(merge_cost), merge_rows);
+        return OkStatus();
+      }
+    }
+
     auto SortIndices = [&](int64_t start_batch, int64_t limit_batch) {
       for (int32_t b = start_batch; b < limit_batch; ++b) {
         const T* input_data = &input(b, 0);
@@ -216,8 +328,6 @@ struct TopKFunctor<CPUDevice, T> {
 
     // Guesstimate of cost; 4*N*log(K) where N == num_cols.
     // If K == N, assume the cost is N*log(K + 1).
-    const double cmp_cost = 3 * Eigen::TensorOpCost::AddCost<int32>() +
-                            Eigen::TensorOpCost::AddCost<T>();
     const double base_cost =
         cmp_cost *
         static_cast<double>(num_cols *
@@ -228,7 +338,6 @@ struct TopKFunctor<CPUDevice, T> {
     const int64_t final_cost = (total_cost >= static_cast<double>(kint64max))
                                    ? kint64max
                                    : static_cast<int64_t>(total_cost);
-    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
     Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
           final_cost, SortIndices);
 
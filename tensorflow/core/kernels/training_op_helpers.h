@@ -34,6 +34,9 @@ Status EnsureSparseVariableAccess(OpKernelContext* ctx, Var* var) {
     return OkStatus();
   }
   mutex_lock ml(*var->mu());
+  // A published read snapshot would hold a reference to the buffer; drop it
+  // before looking at the reference count.
+  var->InvalidateSnapshot();
   // Once copy-on-read mode is True the refcount is guaranteed to be 1. This can
   // also happen if there are no concurrent reads of the variable and
   // copy-on-read mode is false.
@@ -243,6 +246,9 @@ Status GetInputTensorFromVariable(OpKernelContext* ctx, int input,
       *out = *var->tensor();
       return OkStatus();
     }
+    // Our caller holds the variable's mutex; drop any published read snapshot
+    // so PrepareToUpdateVariable() only counts genuine aliases.
+    var->InvalidateSnapshot();
     TF_RETURN_IF_ERROR(PrepareToUpdateVariable<Device, T>(
         ctx, var->tensor(), var->copy_on_read_mode.load()));
     *out = *var->tensor();
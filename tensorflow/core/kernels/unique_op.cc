@@ -13,9 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -23,9 +26,11 @@ limitations under the License.
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
@@ -68,6 +73,15 @@ struct UniqueOpHashMap<bfloat16, TIndex> {
   using map_type = std::unordered_map<bfloat16, TIndex>;
 };
 
+// Whether the sharded scalar implementation may be used for element type `T`.
+// It requires lookups of previously inserted keys to succeed, which does not
+// hold for the floating-point maps above where `NaN` keys never compare equal
+// to themselves.
+template <typename T>
+constexpr bool UniqueOpCanShard() {
+  return std::is_integral<T>::value || std::is_same<T, tstring>::value;
+}
+
 // `UniqueOp` computes the unique elements in the input tensor.
 //
 // * `T` is the element type.
@@ -150,26 +164,40 @@ class UniqueOp : public OpKernel {
       auto Tin = input.flat<T>();
       const int64_t N = static_cast<int64_t>(Tin.size());
 
-      typename UniqueOpHashMap<T, TIndex>::map_type uniq;
-      uniq.reserve(2 * N);
-      for (Eigen::Index i = 0, j = 0; i < N; ++i) {
-        auto it = uniq.emplace(Tin(i), j);
-        idx_vec(i) = it.first->second;
-        if (it.second) {
-          ++j;
+      // For large inputs the serial hash map build is the bottleneck, so
+      // shard the scan across the intra-op pool when there is enough work
+      // per shard to amortize the merge.
+      static constexpr int64_t kMinElementsPerShard = 1 << 16;
+      auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+      const int64_t num_shards =
+          std::min<int64_t>(worker_threads->num_threads,
+                            N / kMinElementsPerShard);
+      if (UniqueOpCanShard<T>() && num_shards > 1) {
+        OP_REQUIRES_OK(
+            context, ComputeSharded(context, input, axis, idx_vec,
+                                    static_cast<int>(num_shards), &uniq_size));
+      } else {
+        typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+        uniq.reserve(2 * N);
+        for (Eigen::Index i = 0, j = 0; i < N; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            ++j;
+          }
         }
-      }
 
-      uniq_size = static_cast<int64_t>(uniq.size());
-      TensorShape output_shape(input.shape());
-      output_shape.set_dim(axis, uniq_size);
-      Tensor* output = nullptr;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output(0, output_shape, &output));
-      auto Tout = output->flat<T>();
+        uniq_size = static_cast<int64_t>(uniq.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
 
-      for (const auto& it : uniq) {
-        Tout(it.second) = it.first;
+        for (const auto& it : uniq) {
+          Tout(it.second) = it.first;
+        }
       }
     } else {
       // General implementation when unique is run over multiple elements.
@@ -237,6 +265,91 @@ class UniqueOp : public OpKernel {
       }
     }
   }
+
+ private:
+  // Computes unique elements of a 1-D input across the intra-op pool. Every
+  // shard scans a contiguous range of the input and records the values it saw
+  // first; the per-shard results are then merged in shard order, so ranks are
+  // assigned in exactly the global first-occurrence order; finally a second
+  // parallel pass translates every element to the rank of its first
+  // occurrence through the (now read-only) merged map.
+  Status ComputeSharded(OpKernelContext* context, const Tensor& input,
+                        int64_t axis, typename TTypes<TIndex>::Vec idx_vec,
+                        int num_shards, int64_t* uniq_size) {
+    auto Tin = input.flat<T>();
+    const int64_t N = static_cast<int64_t>(Tin.size());
+    const int64_t block = (N + num_shards - 1) / num_shards;
+    using map_type = typename UniqueOpHashMap<T, TIndex>::map_type;
+
+    // Per-shard maps deduplicate within the shard's range; `local_first`
+    // records the input position of every within-shard first occurrence in
+    // scan order.
+    std::vector<map_type> local_maps(num_shards);
+    std::vector<std::vector<int64_t>> local_first(num_shards);
+    auto build_shard = [&](int s) {
+      const int64_t begin = s * block;
+      const int64_t end = std::min(N, begin + block);
+      map_type& uniq = local_maps[s];
+      uniq.reserve(2 * (end - begin));
+      std::vector<int64_t>& first = local_first[s];
+      for (int64_t i = begin; i < end; ++i) {
+        auto it = uniq.emplace(Tin(i), TIndex(0));
+        if (it.second) {
+          first.push_back(i);
+        }
+      }
+    };
+    auto* workers = context->device()->tensorflow_cpu_worker_threads()->workers;
+    BlockingCounter build_counter(num_shards - 1);
+    for (int s = 1; s < num_shards; ++s) {
+      workers->Schedule([&build_shard, &build_counter, s] {
+        build_shard(s);
+        build_counter.DecrementCount();
+      });
+    }
+    build_shard(0);
+    build_counter.Wait();
+
+    // Merge in shard order. Shards cover ascending index ranges and each
+    // shard recorded its first occurrences in ascending order, so inserting
+    // in this order assigns ranks by global first occurrence.
+    int64_t total_local = 0;
+    for (const map_type& m : local_maps) {
+      total_local += m.size();
+    }
+    map_type merged;
+    merged.reserve(2 * total_local);
+    TIndex j = 0;
+    for (int s = 0; s < num_shards; ++s) {
+      for (int64_t i : local_first[s]) {
+        auto it = merged.emplace(Tin(i), j);
+        if (it.second) {
+          ++j;
+        }
+      }
+    }
+    *uniq_size = static_cast<int64_t>(merged.size());
+
+    TensorShape output_shape(input.shape());
+    output_shape.set_dim(axis, *uniq_size);
+    Tensor* output = nullptr;
+    TF_RETURN_IF_ERROR(context->allocate_output(0, output_shape, &output));
+    auto Tout = output->flat<T>();
+    for (const auto& it : merged) {
+      Tout(it.second) = it.first;
+    }
+
+    // Second pass: every element is already present in the merged map, so
+    // this is a lock-free lookup.
+    auto translate = [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        idx_vec(i) = merged.find(Tin(i))->second;
+      }
+    };
+    const int64_t cost_per_unit = 20;  // Rough cycles per hash lookup.
+    Shard(num_shards, workers, N, cost_per_unit, translate);
+    return OkStatus();
+  }
 };
 
 #define REGISTER_UNIQUE(type)                                      \
@@ -13,11 +13,17 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/framework/types.h"
@@ -35,6 +41,47 @@ namespace tensorflow {
 
 namespace {
 
+class UniqueOpTest : public OpsTestBase {};
+
+// Large inputs take the sharded implementation; verify it produces the same
+// first-occurrence ordering as the serial reference.
+TEST_F(UniqueOpTest, LargeInt32KeepsFirstOccurrenceOrder) {
+  TF_ASSERT_OK(NodeDefBuilder("unique", "Unique")
+                   .Input(FakeInput(DT_INT32))
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  constexpr int64_t kNumElements = 1 << 18;
+  std::vector<int32> input(kNumElements);
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    input[i] = static_cast<int32>((i * 131) % 997);
+  }
+  AddInputFromArray<int32>(TensorShape({kNumElements}), input);
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Serial reference: ranks assigned in order of first occurrence.
+  std::vector<int32> expected_values;
+  std::vector<int32> expected_idx(kNumElements);
+  std::unordered_map<int32, int32> ranks;
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    auto it = ranks.emplace(input[i], static_cast<int32>(ranks.size()));
+    if (it.second) {
+      expected_values.push_back(input[i]);
+    }
+    expected_idx[i] = it.first->second;
+  }
+
+  Tensor expected_values_t(
+      DT_INT32, TensorShape({static_cast<int64_t>(expected_values.size())}));
+  std::copy(expected_values.begin(), expected_values.end(),
+            expected_values_t.flat<int32>().data());
+  Tensor expected_idx_t(DT_INT32, TensorShape({kNumElements}));
+  std::copy(expected_idx.begin(), expected_idx.end(),
+            expected_idx_t.flat<int32>().data());
+  test::ExpectTensorEqual<int32>(expected_values_t, *GetOutput(0));
+  test::ExpectTensorEqual<int32>(expected_idx_t, *GetOutput(1));
+}
+
 const int kMaxStrLen = 40;
 
 TensorProto GetRandomInt32TensorProto(int dim, int max_int) {
@@ -74,7 +74,8 @@ class UnpackOp : public OpKernel {
     // not using eigen for computation, its perfectly fine to avoid
     // the copying.
     if (axis == 0 &&
-        (output_size == 0 || IsInnerDimsSizeAligned<T>(input_shape))) {
+        (output_size == 0 || num == 1 ||
+         IsInnerDimsSizeAligned<T>(input_shape))) {
       for (int i = 0; i < num; ++i) {
         Tensor output;
         CHECK(output.CopyFrom(input.Slice(i, i + 1), output_shape));
@@ -23,8 +23,11 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/where_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
+#include <vector>
+
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -36,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
@@ -69,6 +73,11 @@ int64_t CountAccumulator<bool>(const bool* begin, const bool* end) {
   return std::accumulate(begin, end, 0LL);
 }
 
+// Minimum number of input elements per shard of the two-pass parallel
+// implementation; below one shard's worth the serial scan is cheaper than
+// the sharding bookkeeping.
+constexpr int64_t kWhereMinShardSize = 1 << 15;
+
 }  // namespace
 
 template <typename T>
@@ -120,6 +129,61 @@ struct Where<CPUDevice, DIMS, T, TIndex> {
     }
     return OkStatus();
   }
+
+  // Parallel variant of Compute().  Shard s covers input elements
+  // [s * shard_size, (s + 1) * shard_size) and emits their coordinates into
+  // output rows [shard_offsets[s], shard_offsets[s + 1]), where the offsets
+  // are an exclusive prefix sum of per-shard counts taken over the same
+  // element ranges.  Every output row therefore has exactly one writer.  If
+  // the input changes between the counting pass and this one, a shard never
+  // writes outside its own row range, and the mismatch is reported through
+  // found_true just as in Compute().
+  EIGEN_ALWAYS_INLINE static Status ComputeParallel(
+      OpKernelContext* ctx, const CPUDevice& d,
+      typename TTypes<T, DIMS>::ConstTensor input,
+      typename TTypes<int64_t>::Matrix output,
+      const std::vector<TIndex>& shard_offsets, TIndex shard_size,
+      TIndex* found_true) {
+    Eigen::DSizes<Eigen::DenseIndex, DIMS> dims = input.dimensions();
+    Eigen::DSizes<TIndex, DIMS> strides;
+
+    EIGEN_STATIC_ASSERT((static_cast<int>(decltype(input)::Layout) ==
+                         static_cast<int>(Eigen::RowMajor)),
+                        INTERNAL_ERROR_INPUT_SHOULD_BE_ROWMAJOR);
+
+    strides[DIMS - 1] = 1;
+    for (int i = DIMS - 2; i >= 0; --i) {
+      strides[i] = strides[i + 1] * dims[i + 1];
+    }
+
+    const int64_t num_shards = shard_offsets.size() - 1;
+    const TIndex input_size = input.size();
+    std::vector<TIndex> shard_found(num_shards, 0);
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, num_shards,
+          shard_size, [&](int64_t shard_begin, int64_t shard_end) {
+            for (int64_t s = shard_begin; s < shard_end; ++s) {
+              const TIndex begin = s * shard_size;
+              const TIndex end = std::min(begin + shard_size, input_size);
+              TIndex true_n = shard_offsets[s];
+              const TIndex row_limit = shard_offsets[s + 1];
+              TIndex seen = 0;
+              for (TIndex n = begin; n < end; ++n) {
+                if (input.data()[n] != T(0)) {
+                  ++seen;
+                  if (true_n < row_limit) {
+                    WriteIndexRowMajor(output, strides, true_n, n);
+                    ++true_n;
+                  }
+                }
+              }
+              shard_found[s] = seen;
+            }
+          });
+    *found_true +=
+        std::accumulate(shard_found.begin(), shard_found.end(), TIndex(0));
+    return OkStatus();
+  }
 };
 
 }  // namespace functor
@@ -140,6 +204,19 @@ class WhereCPUOp : public OpKernel {
 
     const int input_dims = input.dims();
 
+    // Large inputs take a two-pass parallel path: per-shard counts, an
+    // exclusive prefix sum over the shards, then parallel coordinate
+    // emission into the preallocated output.
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    const int64_t input_size = input.NumElements();
+    const int64_t num_shards = std::max<int64_t>(
+        1, std::min<int64_t>(worker_threads.num_threads,
+                             input_size / functor::kWhereMinShardSize));
+    if (num_shards > 1) {
+      ComputeParallel(context, input, input_dims, num_shards, input_size);
+      return;
+    }
+
     int64_t num_true;
     TTypes<int64_t>::UnalignedScalar num_true_t(&num_true);
 
@@ -151,9 +228,6 @@ class WhereCPUOp : public OpKernel {
     Tensor* output = nullptr;
     OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
 
-    // TODO(ebrevdo): Replace single-threaded copy with a multithreaded block
-    // copy by getting block counts above instead of a global NumTrue, then
-    // having each block filled in separate threads below.
     int64_t found_true = 0;
 
 #define HANDLE_DIM(NDIM)                                                      \
@@ -191,6 +265,71 @@ class WhereCPUOp : public OpKernel {
   }
 
  private:
+  void ComputeParallel(OpKernelContext* context, const Tensor& input,
+                       const int input_dims, const int64_t num_shards,
+                       const int64_t input_size) {
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    const int64_t shard_size = (input_size + num_shards - 1) / num_shards;
+    const T* input_data = input.flat<T>().data();
+
+    // Pass 1: count the true elements in each shard of the input.
+    std::vector<int64_t> shard_offsets(num_shards + 1, 0);
+    Shard(worker_threads.num_threads, worker_threads.workers, num_shards,
+          shard_size, [&](int64_t shard_begin, int64_t shard_end) {
+            for (int64_t s = shard_begin; s < shard_end; ++s) {
+              const int64_t begin = s * shard_size;
+              const int64_t end = std::min(begin + shard_size, input_size);
+              shard_offsets[s + 1] = functor::CountAccumulator<T>(
+                  input_data + begin, input_data + end);
+            }
+          });
+    // Exclusive prefix sum turns the counts into output row offsets.
+    for (int64_t s = 0; s < num_shards; ++s) {
+      shard_offsets[s + 1] += shard_offsets[s];
+    }
+    const int64_t num_true = shard_offsets[num_shards];
+
+    TensorShape output_shape({num_true, input_dims});
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
+
+    // Pass 2: each shard emits coordinates into its own output row range.
+    int64_t found_true = 0;
+
+#define HANDLE_DIM(NDIM)                                                      \
+  case NDIM: {                                                                \
+    Status s = functor::Where<CPUDevice, NDIM, T, int64_t>::ComputeParallel(  \
+        context, context->eigen_device<CPUDevice>(), input.tensor<T, NDIM>(), \
+        output->matrix<int64_t>(), shard_offsets, shard_size, &found_true);   \
+    OP_REQUIRES_OK(context, s);                                               \
+  } break;
+
+    switch (input_dims) {
+      HANDLE_DIM(1);
+      HANDLE_DIM(2);
+      HANDLE_DIM(3);
+      HANDLE_DIM(4);
+      HANDLE_DIM(5);
+      HANDLE_DIM(6);
+      HANDLE_DIM(7);
+      HANDLE_DIM(8);
+
+      default:
+        OP_REQUIRES(context, false,
+                    errors::InvalidArgument(
+                        "WhereOp : Unhandled input dimensions: ", input_dims));
+    }
+#undef HANDLE_DIM
+
+    OP_REQUIRES(
+        context, found_true == num_true,
+        errors::InvalidArgument(
+            "WhereOp: Race condition between counting the number of true "
+            "elements and writing them.  When counting, saw ",
+            num_true, " elements; but when writing their indices, saw ",
+            found_true, " elements."));
+  }
+
   TF_DISALLOW_COPY_AND_ASSIGN(WhereCPUOp);
 };
 
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/lib/core/threadpool.h"
 
+#include <algorithm>
 #include <atomic>
 
 #include "absl/synchronization/barrier.h"
@@ -63,6 +64,89 @@ TEST(ThreadPool, DoWork) {
   }
 }
 
+TEST(ThreadPool, CreatePerNumaNodePools) {
+  const int num_threads = 8;
+  std::vector<std::unique_ptr<ThreadPool>> pools =
+      ThreadPool::CreatePerNumaNodePools(Env::Default(), ThreadOptions(),
+                                         "test", num_threads,
+                                         /*low_latency_hint=*/true);
+  ASSERT_GE(pools.size(), 1);
+  // The threads are split across the pools, each pool getting at least one.
+  int total_threads = 0;
+  for (const auto& pool : pools) {
+    ASSERT_GE(pool->NumThreads(), 1);
+    total_threads += pool->NumThreads();
+  }
+  EXPECT_EQ(total_threads, std::max<int>(num_threads, pools.size()));
+
+  // Every sub-pool must be able to run work.
+  const int num_pools = pools.size();
+  std::atomic<int> counter{0};
+  for (const auto& pool : pools) {
+    pool->Schedule([&counter]() { counter++; });
+  }
+  pools.clear();  // Waits for the scheduled work.
+  EXPECT_EQ(counter.load(), num_pools);
+}
+
+TEST(ThreadPool, StealDomains) {
+  const int num_threads = 8;
+  ThreadPool pool(Env::Default(), "test", num_threads);
+  EXPECT_EQ(pool.NumStealDomains(), 1);
+  pool.SetStealDomains({{0, 4}, {4, 8}});
+  EXPECT_EQ(pool.NumStealDomains(), 2);
+
+  // Tasks scheduled into a domain only ever run on its threads: work is
+  // pushed to a queue within the domain and stealing is confined to it.
+  const int kTasksPerDomain = 100;
+  absl::BlockingCounter counter(2 * kTasksPerDomain);
+  for (int i = 0; i < kTasksPerDomain; i++) {
+    pool.ScheduleInDomain(
+        [&pool, &counter]() {
+          const int id = pool.CurrentThreadId();
+          EXPECT_GE(id, 0);
+          EXPECT_LT(id, 4);
+          counter.DecrementCount();
+        },
+        /*domain=*/0);
+    pool.ScheduleInDomain(
+        [&pool, &counter]() {
+          const int id = pool.CurrentThreadId();
+          EXPECT_GE(id, 4);
+          EXPECT_LT(id, 8);
+          counter.DecrementCount();
+        },
+        /*domain=*/1);
+  }
+  counter.Wait();
+
+  // An out-of-range domain and cleared domains fall back to Schedule.
+  absl::BlockingCounter fallback_counter(2);
+  pool.ScheduleInDomain([&fallback_counter]() {
+    fallback_counter.DecrementCount();
+  }, /*domain=*/5);
+  pool.SetStealDomains({});
+  EXPECT_EQ(pool.NumStealDomains(), 1);
+  pool.ScheduleInDomain([&fallback_counter]() {
+    fallback_counter.DecrementCount();
+  }, /*domain=*/0);
+  fallback_counter.Wait();
+}
+
+TEST(ThreadPool, ScheduleForBuffer) {
+  ThreadPool pool(Env::Default(), "test", 4);
+  pool.SetStealDomains({{0, 2}, {2, 4}});
+  // The task runs whether or not the platform reports a NUMA affinity for
+  // the buffer.
+  std::vector<float> buffer(1024);
+  absl::BlockingCounter counter(2);
+  pool.ScheduleForBuffer([&counter]() { counter.DecrementCount(); },
+                         buffer.data());
+  pool.ScheduleForBuffer([&counter]() { counter.DecrementCount(); },
+                         /*buf=*/nullptr);
+  counter.Wait();
+}
+
 void RunWithFixedBlockSize(int64_t block_size, int64_t total,
                            ThreadPool* threads) {
   mutex mu;
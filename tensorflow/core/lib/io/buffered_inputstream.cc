@@ -16,17 +16,23 @@ limitations under the License.
 #include "tensorflow/core/lib/io/buffered_inputstream.h"
 
 #include "tensorflow/core/lib/io/random_inputstream.h"
+#include "tensorflow/core/platform/env.h"
 
 namespace tensorflow {
 namespace io {
 
 BufferedInputStream::BufferedInputStream(InputStreamInterface* input_stream,
                                          size_t buffer_bytes,
-                                         bool owns_input_stream)
+                                         bool owns_input_stream,
+                                         bool double_buffered)
     : input_stream_(input_stream),
       size_(buffer_bytes),
       owns_input_stream_(owns_input_stream) {
   buf_.reserve(size_);
+  if (double_buffered) {
+    prefetch_thread_.reset(new thread::ThreadPool(
+        Env::Default(), "buffered_inputstream_prefetch", 1));
+  }
 }
 
 BufferedInputStream::BufferedInputStream(RandomAccessFile* file,
@@ -35,23 +41,74 @@ BufferedInputStream::BufferedInputStream(RandomAccessFile* file,
                           true) {}
 
 BufferedInputStream::~BufferedInputStream() {
+  // Joins any in-flight background read before input_stream_ can go away.
+  prefetch_thread_.reset();
   if (owns_input_stream_) {
     delete input_stream_;
   }
 }
 
+void BufferedInputStream::SchedulePrefetch() {
+  if (!prefetch_thread_ || prefetch_valid_ || !file_status_.ok()) {
+    return;
+  }
+  {
+    mutex_lock l(mu_);
+    prefetch_in_flight_ = true;
+  }
+  prefetch_thread_->Schedule([this]() {
+    Status s = input_stream_->ReadNBytes(size_, &prefetch_buf_);
+    mutex_lock l(mu_);
+    prefetch_status_ = s;
+    prefetch_in_flight_ = false;
+    prefetch_done_.notify_all();
+  });
+  prefetch_valid_ = true;
+}
+
+void BufferedInputStream::WaitForPrefetch() const {
+  mutex_lock l(mu_);
+  while (prefetch_in_flight_) {
+    prefetch_done_.wait(l);
+  }
+}
+
+Status BufferedInputStream::PromotePrefetchBuffer() {
+  WaitForPrefetch();
+  std::swap(buf_, prefetch_buf_);
+  prefetch_valid_ = false;
+  pos_ = 0;
+  limit_ = buf_.size();
+  Status s;
+  {
+    mutex_lock l(mu_);
+    s = prefetch_status_;
+  }
+  if (!s.ok()) {
+    file_status_ = s;
+  }
+  return s;
+}
+
 Status BufferedInputStream::FillBuffer() {
   if (!file_status_.ok()) {
     pos_ = 0;
     limit_ = 0;
     return file_status_;
   }
-  Status s = input_stream_->ReadNBytes(size_, &buf_);
-  pos_ = 0;
-  limit_ = buf_.size();
-  if (!s.ok()) {
-    file_status_ = s;
+  Status s;
+  if (prefetch_valid_) {
+    s = PromotePrefetchBuffer();
+  } else {
+    s = input_stream_->ReadNBytes(size_, &buf_);
+    pos_ = 0;
+    limit_ = buf_.size();
+    if (!s.ok()) {
+      file_status_ = s;
+    }
   }
+  // Start filling the other buffer while the caller consumes this one.
+  SchedulePrefetch();
   return s;
 }
 
@@ -140,10 +197,26 @@ Status BufferedInputStream::SkipNBytes(int64_t bytes_to_skip) {
     // If we aren't skipping too much, then we can just move pos_;
     pos_ += bytes_to_skip;
   } else {
-    // Otherwise, we already have read limit_ - pos_, so skip the rest. At this
-    // point we need to get fresh data into the buffer, so reset pos_ and
-    // limit_.
-    Status s = input_stream_->SkipNBytes(bytes_to_skip - (limit_ - pos_));
+    // Otherwise, we already have read limit_ - pos_, so skip the rest.
+    const int64_t remaining = bytes_to_skip - (limit_ - pos_);
+    if (prefetch_valid_) {
+      // The underlying stream has already advanced past the prefetched
+      // buffer, so consume that buffer before skipping in the stream itself.
+      Status s = PromotePrefetchBuffer();
+      if (limit_ != 0) {
+        return SkipNBytes(remaining);
+      }
+      if (remaining == 0) {
+        // The skip lands exactly at the end of the buffered data.
+        return OkStatus();
+      }
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    // At this point we need to get fresh data into the buffer, so reset pos_
+    // and limit_.
+    Status s = input_stream_->SkipNBytes(remaining);
     pos_ = 0;
     limit_ = 0;
     if (errors::IsOutOfRange(s)) {
@@ -155,7 +228,14 @@ Status BufferedInputStream::SkipNBytes(int64_t bytes_to_skip) {
 }
 
 int64_t BufferedInputStream::Tell() const {
-  return input_stream_->Tell() - (limit_ - pos_);
+  int64_t prefetched = 0;
+  if (prefetch_valid_) {
+    // The underlying stream is ahead by however much the background read
+    // pulled in.
+    WaitForPrefetch();
+    prefetched = prefetch_buf_.size();
+  }
+  return input_stream_->Tell() - prefetched - (limit_ - pos_);
 }
 
 Status BufferedInputStream::Seek(int64_t position) {
@@ -164,8 +244,13 @@ Status BufferedInputStream::Seek(int64_t position) {
                                    position);
   }
 
+  int64_t prefetched = 0;
+  if (prefetch_valid_) {
+    WaitForPrefetch();
+    prefetched = prefetch_buf_.size();
+  }
   // Position of the buffer's lower limit within file.
-  const int64_t buf_lower_limit = input_stream_->Tell() - limit_;
+  const int64_t buf_lower_limit = input_stream_->Tell() - prefetched - limit_;
   if (position < buf_lower_limit) {
     // Seek before buffer, reset input stream and skip 'position' bytes.
     TF_RETURN_IF_ERROR(Reset());
@@ -206,6 +291,10 @@ template Status BufferedInputStream::ReadAll<std::string>(std::string* result);
 template Status BufferedInputStream::ReadAll<tstring>(tstring* result);
 
 Status BufferedInputStream::Reset() {
+  // Any in-flight background read must finish before the stream is rewound,
+  // and whatever it fetched is stale afterwards.
+  WaitForPrefetch();
+  prefetch_valid_ = false;
   TF_RETURN_IF_ERROR(input_stream_->Reset());
   pos_ = 0;
   limit_ = 0;
@@ -18,6 +18,8 @@ limitations under the License.
 
 #include "tensorflow/core/lib/io/inputstream_interface.h"
 #include "tensorflow/core/platform/file_system.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 namespace io {
@@ -28,10 +30,17 @@ class BufferedInputStream : public InputStreamInterface {
  public:
   // Does not take ownership of input_stream unless owns_input_stream is set
   // to true. input_stream must outlive *this then.
+  //
+  // If double_buffered is true, a background thread reads the next buffer
+  // from input_stream while the current one is consumed, so refills overlap
+  // with the caller's processing. The two buffers are recycled, so steady
+  // state does no allocation. input_stream must then not be accessed by
+  // anyone else until *this is destroyed.
   // TODO(rohanj): Remove owns_input_stream once the constructor below is
   // removed.
   BufferedInputStream(InputStreamInterface* input_stream, size_t buffer_bytes,
-                      bool owns_input_stream = false);
+                      bool owns_input_stream = false,
+                      bool double_buffered = false);
 
   // For backwards compatibility, expose an interface that is similar to what
   // InputBuffer exposes. Does not take ownership of file. file must outlive
@@ -95,6 +104,14 @@ class BufferedInputStream : public InputStreamInterface {
 
  private:
   tensorflow::Status FillBuffer();
+  // Kicks off a background read of the next buffer. No-op unless
+  // double-buffering is on and the stream is healthy.
+  void SchedulePrefetch();
+  // Blocks until no background read is in flight.
+  void WaitForPrefetch() const;
+  // Waits for the outstanding background read and makes its buffer the
+  // current one, resetting pos_/limit_. Returns the status of that read.
+  tensorflow::Status PromotePrefetchBuffer();
   template <typename StringType>
   tensorflow::Status ReadLineHelper(StringType* result, bool include_eol);
 
@@ -109,6 +126,19 @@ class BufferedInputStream : public InputStreamInterface {
   // buffer allocations.
   tensorflow::Status file_status_ = OkStatus();
 
+  // Double-buffering state; prefetch_thread_ is null unless enabled.
+  std::unique_ptr<thread::ThreadPool> prefetch_thread_;
+  // True while prefetch_buf_/prefetch_status_ hold (or will hold) the next
+  // buffer's worth of data. Only touched by the consumer thread.
+  bool prefetch_valid_ = false;
+  // Owned by the background thread while a read is in flight; the consumer
+  // must call WaitForPrefetch() before touching it.
+  tstring prefetch_buf_;
+  mutable mutex mu_;
+  mutable condition_variable prefetch_done_;
+  bool prefetch_in_flight_ TF_GUARDED_BY(mu_) = false;
+  tensorflow::Status prefetch_status_ TF_GUARDED_BY(mu_);
+
   TF_DISALLOW_COPY_AND_ASSIGN(BufferedInputStream);
 };
 
@@ -20,6 +20,10 @@ limitations under the License.
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "tensorflow/core/platform/coding.h"
 #include "tensorflow/core/platform/mutex.h"
 
@@ -61,6 +65,7 @@ struct LRUHandle {
   size_t charge;  // TODO(opt): Only allow uint32_t?
   size_t key_length;
   bool in_cache;     // Whether entry is in the cache.
+  bool pinned;       // Whether entry is exempt from eviction.
   uint32_t refs;     // References, including cache reference, if present.
   uint32_t hash;     // Hash of key(); used for fast sharding and comparisons
   char key_data[1];  // Beginning of key
@@ -159,6 +164,74 @@ class HandleTable {
   }
 };
 
+// A fixed-size array of 4-bit counters indexed by several independent mixes
+// of an entry's hash, approximating how often each entry has been accessed
+// recently (a small count-min sketch, as used by TinyLFU-style admission
+// policies).  All counters are halved once enough increments accumulate, so
+// estimates decay and track recent popularity rather than all-time counts.
+class FrequencySketch {
+ public:
+  FrequencySketch() : counters_(kNumCounters / 2, 0), additions_(0) {}
+
+  void Increment(uint32_t hash) {
+    bool incremented = false;
+    for (int i = 0; i < kNumProbes; i++) {
+      incremented |= IncrementCounter(IndexFor(hash, i));
+    }
+    if (incremented && ++additions_ >= kSampleSize) {
+      Age();
+    }
+  }
+
+  int Estimate(uint32_t hash) const {
+    int estimate = kMaxCount;
+    for (int i = 0; i < kNumProbes; i++) {
+      estimate = std::min(estimate, CounterAt(IndexFor(hash, i)));
+    }
+    return estimate;
+  }
+
+ private:
+  static constexpr int kNumProbes = 4;
+  static constexpr int kMaxCount = 15;
+  static constexpr size_t kNumCounters = 1 << 13;
+  static constexpr size_t kSampleSize = 10 * kNumCounters;
+
+  static size_t IndexFor(uint32_t hash, int probe) {
+    static const uint32_t kSeeds[kNumProbes] = {0x9e3779b9, 0x85ebca6b,
+                                                0xc2b2ae35, 0x27d4eb2f};
+    uint32_t h = hash * kSeeds[probe];
+    h ^= h >> 16;
+    return h & (kNumCounters - 1);
+  }
+
+  int CounterAt(size_t index) const {
+    const uint8_t byte = counters_[index >> 1];
+    return (index & 1) ? (byte >> 4) : (byte & 0x0f);
+  }
+
+  // Returns false if the counter was already saturated.
+  bool IncrementCounter(size_t index) {
+    const int count = CounterAt(index);
+    if (count >= kMaxCount) return false;
+    uint8_t& byte = counters_[index >> 1];
+    byte = (index & 1) ? ((byte & 0x0f) | ((count + 1) << 4))
+                       : ((byte & 0xf0) | (count + 1));
+    return true;
+  }
+
+  void Age() {
+    for (uint8_t& byte : counters_) {
+      byte = (byte >> 1) & 0x77;  // Halve both nibbles.
+    }
+    additions_ /= 2;
+  }
+
+  // Two 4-bit counters per byte.
+  std::vector<uint8_t> counters_;
+  size_t additions_;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -167,11 +240,15 @@ class LRUCache {
 
   // Separate from constructor so caller can easily make an array of LRUCache
   void SetCapacity(size_t capacity) { capacity_ = capacity; }
+  void SetScanResistant(bool scan_resistant) {
+    scan_resistant_ = scan_resistant;
+  }
 
   // Like Cache methods, but with an extra "hash" parameter.
   Cache::Handle* Insert(const Slice& key, uint32_t hash, void* value,
                         size_t charge,
-                        void (*deleter)(const Slice& key, void* value));
+                        void (*deleter)(const Slice& key, void* value),
+                        bool pinned);
   Cache::Handle* Lookup(const Slice& key, uint32_t hash);
   void Release(Cache::Handle* handle);
   void Erase(const Slice& key, uint32_t hash);
@@ -190,6 +267,7 @@ class LRUCache {
 
   // Initialized before use.
   size_t capacity_;
+  bool scan_resistant_ = false;
 
   // mutex_ protects the following state.
   mutable mutex mutex_;
@@ -204,6 +282,14 @@ class LRUCache {
   // Entries are in use by clients, and have refs >= 2 and in_cache==true.
   LRUHandle in_use_ TF_GUARDED_BY(mutex_);
 
+  // Dummy head of pinned list.  Pinned entries not currently referenced by
+  // clients live here instead of on the LRU list, so the eviction loop never
+  // sees them.
+  LRUHandle pinned_ TF_GUARDED_BY(mutex_);
+
+  // Tracks access frequencies for admission when `scan_resistant_` is set.
+  FrequencySketch sketch_ TF_GUARDED_BY(mutex_);
+
   HandleTable table_ TF_GUARDED_BY(mutex_);
 };
 
@@ -213,17 +299,21 @@ LRUCache::LRUCache() : capacity_(0), usage_(0) {
   lru_.prev = &lru_;
   in_use_.next = &in_use_;
   in_use_.prev = &in_use_;
+  pinned_.next = &pinned_;
+  pinned_.prev = &pinned_;
 }
 
 LRUCache::~LRUCache() {
   assert(in_use_.next == &in_use_);  // Error if caller has an unreleased handle
-  for (LRUHandle* e = lru_.next; e != &lru_;) {
-    LRUHandle* next = e->next;
-    assert(e->in_cache);
-    e->in_cache = false;
-    assert(e->refs == 1);  // Invariant of lru_ list.
-    Unref(e);
-    e = next;
+  for (LRUHandle* list : {&lru_, &pinned_}) {
+    for (LRUHandle* e = list->next; e != list;) {
+      LRUHandle* next = e->next;
+      assert(e->in_cache);
+      e->in_cache = false;
+      assert(e->refs == 1);  // Invariant of lru_ and pinned_ lists.
+      Unref(e);
+      e = next;
+    }
   }
 }
 
@@ -243,9 +333,9 @@ void LRUCache::Unref(LRUHandle* e) {
     (*e->deleter)(e->key(), e->value);
     free(e);
   } else if (e->in_cache && e->refs == 1) {
-    // No longer in use; move to lru_ list.
+    // No longer in use; move to lru_ (or pinned_) list.
     LRU_Remove(e);
-    LRU_Append(&lru_, e);
+    LRU_Append(e->pinned ? &pinned_ : &lru_, e);
   }
 }
 
@@ -264,6 +354,9 @@ void LRUCache::LRU_Append(LRUHandle* list, LRUHandle* e) {
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash) {
   mutex_lock l(mutex_);
+  if (scan_resistant_) {
+    sketch_.Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     Ref(e);
@@ -278,8 +371,8 @@ void LRUCache::Release(Cache::Handle* handle) {
 
 Cache::Handle* LRUCache::Insert(const Slice& key, uint32_t hash, void* value,
                                 size_t charge,
-                                void (*deleter)(const Slice& key,
-                                                void* value)) {
+                                void (*deleter)(const Slice& key, void* value),
+                                bool pinned) {
   mutex_lock l(mutex_);
 
   LRUHandle* e =
@@ -290,16 +383,32 @@ Cache::Handle* LRUCache::Insert(const Slice& key, uint32_t hash, void* value,
   e->key_length = key.size();
   e->hash = hash;
   e->in_cache = false;
+  e->pinned = pinned;
   e->refs = 1;  // for the returned handle.
   memcpy(e->key_data, key.data(), key.size());
 
-  if (capacity_ > 0) {
+  bool admit = capacity_ > 0;
+  if (admit && scan_resistant_ && !pinned) {
+    sketch_.Increment(hash);
+    if (usage_ + charge > capacity_ && lru_.next != &lru_) {
+      // Inserting would evict: only admit entries that have been accessed at
+      // least as often as the eviction victim, so one-touch scan traffic
+      // cannot flush frequently used entries.
+      const LRUHandle* victim = lru_.next;
+      if (sketch_.Estimate(hash) < sketch_.Estimate(victim->hash)) {
+        admit = false;
+      }
+    }
+  }
+
+  if (admit) {
     e->refs++;  // for the cache's reference.
     e->in_cache = true;
     LRU_Append(&in_use_, e);
     usage_ += charge;
     FinishErase(table_.Insert(e));
-  } else {  // don't cache. (capacity_==0 is supported and turns off caching.)
+  } else {  // don't cache. (capacity_==0 turns off caching; the admission
+            // policy may also decline individual entries.)
     // next is read by key() in an assert, so it must be initialized
     e->next = nullptr;
   }
@@ -345,12 +454,13 @@ void LRUCache::Prune() {
   }
 }
 
-static const int kNumShardBits = 4;
-static const int kNumShards = 1 << kNumShardBits;
+static const int kMaxShardBits = 10;
 
 class ShardedLRUCache : public Cache {
  private:
-  LRUCache shard_[kNumShards];
+  const int num_shard_bits_;
+  const int num_shards_;
+  std::unique_ptr<LRUCache[]> shard_;
   mutex id_mutex_;
   uint64_t last_id_;
 
@@ -358,20 +468,39 @@ class ShardedLRUCache : public Cache {
     return Hash(s.data(), s.size(), 0);
   }
 
-  static uint32_t Shard(uint32_t hash) { return hash >> (32 - kNumShardBits); }
+  uint32_t Shard(uint32_t hash) const {
+    return num_shard_bits_ == 0 ? 0 : (hash >> (32 - num_shard_bits_));
+  }
+
+  static int ClampShardBits(int num_shard_bits) {
+    return std::min(std::max(num_shard_bits, 0), kMaxShardBits);
+  }
 
  public:
-  explicit ShardedLRUCache(size_t capacity) : last_id_(0) {
-    const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
-    for (int s = 0; s < kNumShards; s++) {
+  ShardedLRUCache(size_t capacity, const LRUCacheOptions& options)
+      : num_shard_bits_(ClampShardBits(options.num_shard_bits)),
+        num_shards_(1 << num_shard_bits_),
+        shard_(new LRUCache[num_shards_]),
+        last_id_(0) {
+    const size_t per_shard = (capacity + (num_shards_ - 1)) / num_shards_;
+    for (int s = 0; s < num_shards_; s++) {
       shard_[s].SetCapacity(per_shard);
+      shard_[s].SetScanResistant(options.scan_resistant);
     }
   }
   ~ShardedLRUCache() override {}
   Handle* Insert(const Slice& key, void* value, size_t charge,
                  void (*deleter)(const Slice& key, void* value)) override {
     const uint32_t hash = HashSlice(key);
-    return shard_[Shard(hash)].Insert(key, hash, value, charge, deleter);
+    return shard_[Shard(hash)].Insert(key, hash, value, charge, deleter,
+                                      /*pinned=*/false);
+  }
+  Handle* InsertPinned(const Slice& key, void* value, size_t charge,
+                       void (*deleter)(const Slice& key,
+                                       void* value)) override {
+    const uint32_t hash = HashSlice(key);
+    return shard_[Shard(hash)].Insert(key, hash, value, charge, deleter,
+                                      /*pinned=*/true);
   }
   Handle* Lookup(const Slice& key) override {
     const uint32_t hash = HashSlice(key);
@@ -393,13 +522,13 @@ class ShardedLRUCache : public Cache {
     return ++(last_id_);
   }
   void Prune() override {
-    for (int s = 0; s < kNumShards; s++) {
+    for (int s = 0; s < num_shards_; s++) {
       shard_[s].Prune();
     }
   }
   size_t TotalCharge() const override {
     size_t total = 0;
-    for (int s = 0; s < kNumShards; s++) {
+    for (int s = 0; s < num_shards_; s++) {
       total += shard_[s].TotalCharge();
     }
     return total;
@@ -443,7 +572,13 @@ class ShardedLRUCache : public Cache {
 
 }  // end anonymous namespace
 
-Cache* NewLRUCache(size_t capacity) { return new ShardedLRUCache(capacity); }
+Cache* NewLRUCache(size_t capacity) {
+  return new ShardedLRUCache(capacity, LRUCacheOptions());
+}
+
+Cache* NewLRUCache(size_t capacity, const LRUCacheOptions& options) {
+  return new ShardedLRUCache(capacity, options);
+}
 
 }  // namespace table
 
@@ -39,10 +39,28 @@ namespace table {
 
 class Cache;
 
+struct LRUCacheOptions {
+  // log2 of the number of shards the cache is split into.  More shards
+  // reduce mutex contention between concurrent readers at the cost of a
+  // less exact global LRU order.  Clamped to [0, 10].
+  int num_shard_bits = 4;
+
+  // If true, an insert that would evict an entry first consults a small
+  // sketch of recent access frequencies (a TinyLFU-style admission policy)
+  // and bypasses caching when the incoming entry has been accessed less
+  // often than the eviction victim.  This keeps one-touch scan traffic from
+  // flushing frequently used entries.  Bypassed inserts still return a
+  // usable handle; the entry is simply not retained after release.
+  bool scan_resistant = false;
+};
+
 // Create a new cache with a fixed size capacity.  This implementation
 // of Cache uses a least-recently-used eviction policy.
 Cache* NewLRUCache(size_t capacity);
 
+// Like the above, with the sharding and admission behavior in "options".
+Cache* NewLRUCache(size_t capacity, const LRUCacheOptions& options);
+
 class Cache {
  public:
   Cache() = default;
@@ -69,6 +87,18 @@ class Cache {
   virtual Handle* Insert(const Slice& key, void* value, size_t charge,
                          void (*deleter)(const Slice& key, void* value)) = 0;
 
+  // Like Insert, but the entry is exempt from eviction: it stays cached
+  // until it is removed with Erase() or the cache is destroyed, and it is
+  // never considered by the admission policy.  Pinned entries still count
+  // against the capacity, so pinning is only appropriate for small,
+  // long-lived values such as table index or footer blocks.
+  // Implementations that do not support pinning treat this as Insert.
+  virtual Handle* InsertPinned(const Slice& key, void* value, size_t charge,
+                               void (*deleter)(const Slice& key,
+                                               void* value)) {
+    return Insert(key, value, charge, deleter);
+  }
+
   // If the cache has no mapping for "key", returns nullptr.
   //
   // Else return a handle that corresponds to the mapping.  The caller
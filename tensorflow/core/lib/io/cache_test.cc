@@ -207,6 +207,55 @@ TEST_F(CacheTest, HeavyEntries) {
   ASSERT_LE(cached_weight, kCacheSize + kCacheSize / 10);
 }
 
+TEST_F(CacheTest, PinnedEntriesSurviveEviction) {
+  cache_->Release(cache_->InsertPinned(EncodeKey(100), EncodeValue(101), 1,
+                                       &CacheTest::Deleter));
+
+  // Overfill the cache with one-touch entries; the pinned entry must not be
+  // selected for eviction.
+  for (int i = 0; i < kCacheSize + 100; i++) {
+    Insert(1000 + i, 2000 + i);
+  }
+  ASSERT_EQ(101, Lookup(100));
+
+  // Pinned entries can still be erased explicitly.
+  Erase(100);
+  ASSERT_EQ(-1, Lookup(100));
+  ASSERT_EQ(101, deleted_values_.back());
+}
+
+TEST_F(CacheTest, ScanResistance) {
+  delete cache_;
+  LRUCacheOptions options;
+  options.scan_resistant = true;
+  cache_ = NewLRUCache(kCacheSize, options);
+
+  // Make one entry hot.
+  Insert(100, 101);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(101, Lookup(100));
+  }
+
+  // A one-touch scan larger than the cache must not displace the hot entry,
+  // even though the scan never touches it again.
+  for (int i = 0; i < kCacheSize + 200; i++) {
+    Insert(1000 + i, 2000 + i);
+  }
+  ASSERT_EQ(101, Lookup(100));
+}
+
+TEST_F(CacheTest, ConfigurableShardCount) {
+  delete cache_;
+  LRUCacheOptions options;
+  options.num_shard_bits = 0;
+  cache_ = NewLRUCache(kCacheSize, options);
+
+  Insert(100, 101);
+  Insert(200, 201);
+  ASSERT_EQ(101, Lookup(100));
+  ASSERT_EQ(201, Lookup(200));
+}
+
 TEST_F(CacheTest, NewId) {
   uint64_t a = cache_->NewId();
   uint64_t b = cache_->NewId();
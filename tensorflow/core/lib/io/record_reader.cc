@@ -85,6 +85,18 @@ RecordReader::RecordReader(RandomAccessFile* file,
 #endif
 }
 
+RecordReader::RecordReader(const ReadOnlyMemoryRegion* region,
+                           const RecordReaderOptions& options)
+    : options_(options),
+      region_data_(static_cast<const char*>(region->data())),
+      region_size_(region->length()),
+      last_read_failed_(false) {
+  if (options.compression_type != RecordReaderOptions::NONE) {
+    LOG(FATAL) << "Compression is not supported when reading records from a "
+                  "memory region.";
+  }
+}
+
 // Read n+4 bytes from file, verify that checksum of first n bytes is
 // stored in the last 4 bytes and store the first n bytes in *result.
 //
@@ -114,6 +126,69 @@ Status RecordReader::ReadChecksummed(uint64 offset, size_t n, tstring* result) {
   return OkStatus();
 }
 
+// Verify that the checksum of the n bytes at "offset" in the memory region
+// is stored in the following 4 bytes and return a view of those n bytes in
+// *result, without copying them.
+Status RecordReader::ReadChecksummedView(uint64 offset, size_t n,
+                                         StringPiece* result) {
+  if (n >= SIZE_MAX - sizeof(uint32)) {
+    return errors::DataLoss("record size too large");
+  }
+
+  if (offset >= region_size_) {
+    return errors::OutOfRange("eof");
+  }
+  const uint64 expected = n + sizeof(uint32);
+  if (expected > region_size_ - offset) {
+    return errors::DataLoss("truncated record at ", offset);
+  }
+
+  const char* data = region_data_ + offset;
+  const uint32 masked_crc = core::DecodeFixed32(data + n);
+  if (crc32c::Unmask(masked_crc) != crc32c::Value(data, n)) {
+    return errors::DataLoss("corrupted record at ", offset);
+  }
+  *result = StringPiece(data, n);
+  return OkStatus();
+}
+
+Status RecordReader::SetIndex(const ReadOnlyMemoryRegion* index) {
+  if (options_.compression_type != RecordReaderOptions::NONE) {
+    return errors::InvalidArgument(
+        "Indexes can only be used with uncompressed readers");
+  }
+  if (index->length() % kIndexEntrySize != 0) {
+    return errors::DataLoss("index size ", index->length(),
+                            " is not a multiple of the entry size ",
+                            kIndexEntrySize);
+  }
+  index_data_ = static_cast<const char*>(index->data());
+  index_size_ = index->length();
+  return OkStatus();
+}
+
+int64_t RecordReader::NumIndexedRecords() const {
+  return index_size_ / kIndexEntrySize;
+}
+
+Status RecordReader::SeekToRecord(int64_t i, uint64* offset) const {
+  if (index_data_ == nullptr) {
+    return errors::FailedPrecondition(
+        "SeekToRecord requires an index supplied via SetIndex");
+  }
+  if (i < 0 || i >= NumIndexedRecords()) {
+    return errors::OutOfRange("record index ", i, " out of range [0, ",
+                              NumIndexedRecords(), ")");
+  }
+  const char* entry = index_data_ + i * kIndexEntrySize;
+  const uint32 masked_crc = core::DecodeFixed32(entry + sizeof(uint64));
+  if (crc32c::Unmask(masked_crc) != crc32c::Value(entry, sizeof(uint64))) {
+    return errors::DataLoss("corrupted index entry for record ", i);
+  }
+  *offset = core::DecodeFixed64(entry);
+  return OkStatus();
+}
+
 Status RecordReader::GetMetadata(Metadata* md) {
   if (!md) {
     return errors::InvalidArgument(
@@ -122,7 +197,9 @@ Status RecordReader::GetMetadata(Metadata* md) {
 
   // Compute the metadata of the TFRecord file if not cached.
   if (!cached_metadata_) {
-    TF_RETURN_IF_ERROR(input_stream_->Reset());
+    if (input_stream_) {
+      TF_RETURN_IF_ERROR(input_stream_->Reset());
+    }
 
     int64_t data_size = 0;
     int64_t entries = 0;
@@ -132,9 +209,18 @@ Status RecordReader::GetMetadata(Metadata* md) {
     // or encountering an error.
     uint64 offset = 0;
     tstring record;
+    StringPiece view;
     while (true) {
       // Read header, containing size of data.
-      Status s = ReadChecksummed(offset, sizeof(uint64), &record);
+      Status s;
+      const char* header;
+      if (region_data_) {
+        s = ReadChecksummedView(offset, sizeof(uint64), &view);
+        header = view.data();
+      } else {
+        s = ReadChecksummed(offset, sizeof(uint64), &record);
+        header = record.data();
+      }
       if (!s.ok()) {
         if (errors::IsOutOfRange(s)) {
           // We should reach out of range when the record file is complete.
@@ -144,11 +230,13 @@ Status RecordReader::GetMetadata(Metadata* md) {
       }
 
       // Read the length of the data.
-      const uint64 length = core::DecodeFixed64(record.data());
+      const uint64 length = core::DecodeFixed64(header);
 
       // Skip reading the actual data since we just want the number
       // of records and the size of the data.
-      TF_RETURN_IF_ERROR(input_stream_->SkipNBytes(length + kFooterSize));
+      if (input_stream_) {
+        TF_RETURN_IF_ERROR(input_stream_->SkipNBytes(length + kFooterSize));
+      }
       offset += kHeaderSize + length + kFooterSize;
 
       // Increment running stats.
@@ -183,6 +271,16 @@ Status RecordReader::PositionInputStream(uint64 offset) {
 }
 
 Status RecordReader::ReadRecord(uint64* offset, tstring* record) {
+  if (region_data_) {
+    // Reading from the mapping still costs one copy, into *record; callers
+    // that can bound the record's lifetime by the region's can use the
+    // StringPiece overload to avoid it.
+    StringPiece view;
+    TF_RETURN_IF_ERROR(ReadRecord(offset, &view));
+    record->assign(view.data(), view.size());
+    return OkStatus();
+  }
+
   TF_RETURN_IF_ERROR(PositionInputStream(*offset));
 
   // Read header data.
@@ -209,8 +307,55 @@ Status RecordReader::ReadRecord(uint64* offset, tstring* record) {
   return OkStatus();
 }
 
+Status RecordReader::ReadRecord(uint64* offset, StringPiece* record) {
+  if (!region_data_) {
+    return errors::FailedPrecondition(
+        "Reading records as views requires a reader backed by a memory "
+        "region.");
+  }
+
+  // Read header data.
+  StringPiece header;
+  TF_RETURN_IF_ERROR(ReadChecksummedView(*offset, sizeof(uint64), &header));
+  const uint64 length = core::DecodeFixed64(header.data());
+
+  // Read data
+  Status s = ReadChecksummedView(*offset + kHeaderSize, length, record);
+  if (!s.ok()) {
+    if (errors::IsOutOfRange(s)) {
+      s = errors::DataLoss("truncated record at ", *offset, "' failed with ",
+                           s.error_message());
+    }
+    return s;
+  }
+
+  *offset += kHeaderSize + length + kFooterSize;
+  return OkStatus();
+}
+
 Status RecordReader::SkipRecords(uint64* offset, int num_to_skip,
                                  int* num_skipped) {
+  if (region_data_) {
+    *num_skipped = 0;
+    for (int i = 0; i < num_to_skip; ++i) {
+      // Validate the header, then step over the data and footer without
+      // touching (or faulting in) the record bytes themselves.
+      StringPiece header;
+      TF_RETURN_IF_ERROR(
+          ReadChecksummedView(*offset, sizeof(uint64), &header));
+      const uint64 length = core::DecodeFixed64(header.data());
+      if (length >= SIZE_MAX - sizeof(uint32)) {
+        return errors::DataLoss("record size too large");
+      }
+      if (length + kFooterSize > region_size_ - (*offset + kHeaderSize)) {
+        return errors::DataLoss("truncated record at ", *offset);
+      }
+      *offset += kHeaderSize + length + kFooterSize;
+      (*num_skipped)++;
+    }
+    return OkStatus();
+  }
+
   TF_RETURN_IF_ERROR(PositionInputStream(*offset));
 
   Status s;
@@ -245,5 +390,9 @@ SequentialRecordReader::SequentialRecordReader(
     RandomAccessFile* file, const RecordReaderOptions& options)
     : underlying_(file, options), offset_(0) {}
 
+SequentialRecordReader::SequentialRecordReader(
+    const ReadOnlyMemoryRegion* region, const RecordReaderOptions& options)
+    : underlying_(region, options), offset_(0) {}
+
 }  // namespace io
 }  // namespace tensorflow
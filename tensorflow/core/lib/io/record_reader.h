@@ -31,6 +31,7 @@ limitations under the License.
 namespace tensorflow {
 
 class RandomAccessFile;
+class ReadOnlyMemoryRegion;
 
 namespace io {
 
@@ -72,6 +73,12 @@ class RecordReader {
   static constexpr size_t kHeaderSize = sizeof(uint64) + sizeof(uint32);
   static constexpr size_t kFooterSize = sizeof(uint32);
 
+  // Format of a single entry in an index sidecar produced by
+  // RecordWriter::EnableIndexing:
+  //  uint64    offset of the record in the record file
+  //  uint32    masked crc of offset
+  static constexpr size_t kIndexEntrySize = sizeof(uint64) + sizeof(uint32);
+
   // Statistics (sizes are in units of bytes)
   struct Stats {
     int64_t file_size = -1;
@@ -90,6 +97,15 @@ class RecordReader {
       RandomAccessFile* file,
       const RecordReaderOptions& options = RecordReaderOptions());
 
+  // Create a reader over the mapped TFRecord file contents in "*region".
+  // "*region" must remain live while this Reader is in use. Records are
+  // checksummed directly against the mapped bytes, avoiding the copy into
+  // an input stream buffer; compression is not supported and
+  // `options.buffer_size` is ignored (the mapping needs no buffering).
+  explicit RecordReader(
+      const ReadOnlyMemoryRegion* region,
+      const RecordReaderOptions& options = RecordReaderOptions());
+
   virtual ~RecordReader() = default;
 
   // Read the record at "*offset" into *record and update *offset to
@@ -97,6 +113,12 @@ class RecordReader {
   // OUT_OF_RANGE for end of file, or something else for an error.
   Status ReadRecord(uint64* offset, tstring* record);
 
+  // Like the above, but returns a view of the record bytes inside the
+  // memory region backing this reader instead of copying them. The view is
+  // valid only for as long as the region is live. Returns
+  // FAILED_PRECONDITION for readers that are not backed by a memory region.
+  Status ReadRecord(uint64* offset, StringPiece* record);
+
   // Skip num_to_skip record starting at "*offset" and update *offset
   // to point to the offset of the next num_to_skip + 1 record.
   // Return OK on success, OUT_OF_RANGE for end of file, or something
@@ -104,6 +126,21 @@ class RecordReader {
   // are actually skipped. It should be equal to num_to_skip on success.
   Status SkipRecords(uint64* offset, int num_to_skip, int* num_skipped);
 
+  // Supplies the contents of an index sidecar, produced by
+  // RecordWriter::EnableIndexing, for the file this reader reads, enabling
+  // SeekToRecord. "*index" must remain live while this Reader is in use.
+  // Record offsets are not well defined within a compressed stream, so
+  // indexes can only be used with uncompressed readers.
+  Status SetIndex(const ReadOnlyMemoryRegion* index);
+
+  // Number of records in the index supplied via SetIndex, or 0 if none was.
+  int64_t NumIndexedRecords() const;
+
+  // Sets *offset to the file offset of the i-th record, validating the index
+  // entry's checksum; the result can be passed to ReadRecord or SkipRecords.
+  // Requires an index supplied via SetIndex.
+  Status SeekToRecord(int64_t i, uint64* offset) const;
+
   // Return the metadata of the Record file.
   //
   // The current implementation scans the file to completion,
@@ -117,10 +154,18 @@ class RecordReader {
 
  private:
   Status ReadChecksummed(uint64 offset, size_t n, tstring* result);
+  Status ReadChecksummedView(uint64 offset, size_t n, StringPiece* result);
   Status PositionInputStream(uint64 offset);
 
   RecordReaderOptions options_;
   std::unique_ptr<InputStreamInterface> input_stream_;
+  // Set only for readers backed by a memory region, in which case
+  // `input_stream_` is null and reads go directly against the mapped bytes.
+  const char* region_data_ = nullptr;
+  uint64 region_size_ = 0;
+  // Set only when an index sidecar was supplied via SetIndex.
+  const char* index_data_ = nullptr;
+  uint64 index_size_ = 0;
   bool last_read_failed_;
 
   std::unique_ptr<Metadata> cached_metadata_;
@@ -139,6 +184,13 @@ class SequentialRecordReader {
       RandomAccessFile* file,
       const RecordReaderOptions& options = RecordReaderOptions());
 
+  // Create a reader over the mapped TFRecord file contents in "*region".
+  // "*region" must remain live while this Reader is in use. See the
+  // corresponding RecordReader constructor for restrictions.
+  explicit SequentialRecordReader(
+      const ReadOnlyMemoryRegion* region,
+      const RecordReaderOptions& options = RecordReaderOptions());
+
   virtual ~SequentialRecordReader() = default;
 
   // Read the next record in the file into *record. Returns OK on success,
@@ -147,6 +199,13 @@ class SequentialRecordReader {
     return underlying_.ReadRecord(&offset_, record);
   }
 
+  // Read the next record in the file into *record as a view into the memory
+  // region backing this reader, without copying the record bytes. Only valid
+  // for readers backed by a memory region; see RecordReader::ReadRecord.
+  Status ReadRecord(StringPiece* record) {
+    return underlying_.ReadRecord(&offset_, record);
+  }
+
   // Skip the next num_to_skip record in the file. Return OK on success,
   // OUT_OF_RANGE for end of file, or something else for an error.
   // "*num_skipped" records the number of records that are actually skipped.
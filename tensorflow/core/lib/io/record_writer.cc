@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/lib/io/record_writer.h"
 
+#include <string.h>
+
 #include "tensorflow/core/lib/core/coding.h"
 #include "tensorflow/core/lib/hash/crc32c.h"
 #include "tensorflow/core/lib/io/compression.h"
@@ -112,7 +114,60 @@ Status RecordWriter::WriteRecord(StringPiece data) {
   PopulateFooter(footer, data.data(), data.size());
   TF_RETURN_IF_ERROR(dest_->Append(StringPiece(header, sizeof(header))));
   TF_RETURN_IF_ERROR(dest_->Append(data));
-  return dest_->Append(StringPiece(footer, sizeof(footer)));
+  TF_RETURN_IF_ERROR(dest_->Append(StringPiece(footer, sizeof(footer))));
+  return MaybeAppendIndexEntry(data.size());
+}
+
+Status RecordWriter::WriteRecords(absl::Span<const StringPiece> records) {
+  if (dest_ == nullptr) {
+    return Status(::tensorflow::error::FAILED_PRECONDITION,
+                  "Writer not initialized or previously closed");
+  }
+  size_t buffer_size = 0;
+  for (const StringPiece& data : records) {
+    buffer_size += kHeaderSize + data.size() + kFooterSize;
+  }
+  // Assemble the framing and payloads for the whole batch into one buffer so
+  // that the destination sees a single Append instead of three per record.
+  // WritableFile has no scatter/gather interface, so batching costs one copy
+  // of the payload bytes in exchange for eliminating the per-Append virtual
+  // dispatch, locking and buffering overhead.
+  string buffer(buffer_size, '\0');
+  char* p = &buffer[0];
+  for (const StringPiece& data : records) {
+    PopulateHeader(p, data.data(), data.size());
+    if (!data.empty()) {
+      memcpy(p + kHeaderSize, data.data(), data.size());
+    }
+    PopulateFooter(p + kHeaderSize + data.size(), data.data(), data.size());
+    p += kHeaderSize + data.size() + kFooterSize;
+  }
+  TF_RETURN_IF_ERROR(dest_->Append(buffer));
+  for (const StringPiece& data : records) {
+    TF_RETURN_IF_ERROR(MaybeAppendIndexEntry(data.size()));
+  }
+  return OkStatus();
+}
+
+Status RecordWriter::EnableIndexing(WritableFile* index_file) {
+  if (options_.compression_type != RecordWriterOptions::NONE) {
+    return Status(::tensorflow::error::INVALID_ARGUMENT,
+                  "Indexing requires an uncompressed writer");
+  }
+  index_dest_ = index_file;
+  return OkStatus();
+}
+
+Status RecordWriter::MaybeAppendIndexEntry(size_t data_size) {
+  const uint64 record_offset = next_record_offset_;
+  next_record_offset_ += kHeaderSize + data_size + kFooterSize;
+  if (index_dest_ == nullptr) {
+    return OkStatus();
+  }
+  char entry[kIndexEntrySize];
+  core::EncodeFixed64(entry, record_offset);
+  core::EncodeFixed32(entry + sizeof(uint64), MaskedCrc(entry, sizeof(uint64)));
+  return index_dest_->Append(StringPiece(entry, sizeof(entry)));
 }
 
 #if defined(TF_CORD_SUPPORT)
@@ -132,7 +187,8 @@ Status RecordWriter::WriteRecord(const absl::Cord& data) {
   PopulateFooter(footer, data);
   TF_RETURN_IF_ERROR(dest_->Append(StringPiece(header, sizeof(header))));
   TF_RETURN_IF_ERROR(dest_->Append(data));
-  return dest_->Append(StringPiece(footer, sizeof(footer)));
+  TF_RETURN_IF_ERROR(dest_->Append(StringPiece(footer, sizeof(footer))));
+  return MaybeAppendIndexEntry(data.size());
 }
 #endif
 
@@ -0,0 +1,339 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_LIB_MONITORING_SHARDED_SAMPLER_H_
+#define TENSORFLOW_CORE_LIB_MONITORING_SHARDED_SAMPLER_H_
+
+// clang-format off
+// Required for IS_MOBILE_PLATFORM
+#include "tensorflow/core/platform/platform.h"
+// clang-format on
+
+// We replace this implementation with a null implementation for mobile
+// platforms.
+#ifdef IS_MOBILE_PLATFORM
+
+#include "tensorflow/core/framework/summary.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/monitoring/metric_def.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace monitoring {
+
+// ShardedSamplerCell which has a null implementation.
+class ShardedSamplerCell {
+ public:
+  ShardedSamplerCell() {}
+  ~ShardedSamplerCell() {}
+
+  void Add(double value) {}
+  HistogramProto value() const { return HistogramProto(); }
+
+ private:
+  TF_DISALLOW_COPY_AND_ASSIGN(ShardedSamplerCell);
+};
+
+// ShardedSampler which has a null implementation.
+template <int NumLabels>
+class ShardedSampler {
+ public:
+  ~ShardedSampler() {}
+
+  template <typename... MetricDefArgs>
+  static ShardedSampler* New(
+      const MetricDef<MetricKind::kCumulative, HistogramProto, NumLabels>&
+          metric_def) {
+    return new ShardedSampler<NumLabels>();
+  }
+
+  template <typename... Labels>
+  ShardedSamplerCell* GetCell(const Labels&... labels) {
+    return &default_cell_;
+  }
+
+  Status GetStatus() { return Status::OK(); }
+
+ private:
+  ShardedSampler() {}
+
+  ShardedSamplerCell default_cell_;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ShardedSampler);
+};
+
+}  // namespace monitoring
+}  // namespace tensorflow
+
+#else  // IS_MOBILE_PLATFORM
+
+#include <float.h>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+
+#include "absl/base/casts.h"
+#include "tensorflow/core/framework/summary.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/monitoring/collection_registry.h"
+#include "tensorflow/core/lib/monitoring/metric_def.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+namespace monitoring {
+
+// ShardedSamplerCell is a drop-in replacement for SamplerCell on paths where
+// the metric itself shows up in profiles. SamplerCell::Add locks a mutex per
+// sample; ShardedSamplerCell instead keeps several cache-line-aligned shards
+// of relaxed atomic bucket counters, picks a shard by thread, and computes
+// the bucket branch-free from the sample's floating-point exponent. A record
+// is a handful of instructions with no shared-cacheline writes; the shards
+// are summed at collection time.
+//
+// The trade-offs against SamplerCell:
+//  - Buckets are fixed powers of two covering [2^-16, 2^47); samples below
+//    (including zero, negatives and denormals) saturate into the first
+//    bucket and samples above into the last. No custom Buckets.
+//  - The proto's min/max are approximated by the bounds of the lowest and
+//    highest occupied buckets.
+//
+// This class is thread-safe.
+class ShardedSamplerCell {
+ public:
+  ShardedSamplerCell() : shards_(new Shard[kNumShards]) {}
+
+  ~ShardedSamplerCell() {}
+
+  // Adds a sample, lock-free.
+  void Add(double sample) {
+    Shard& shard = shards_[ShardIndex()];
+    shard.buckets[BucketIndex(sample)].fetch_add(1, std::memory_order_relaxed);
+    AtomicAddDouble(&shard.sum, sample);
+    AtomicAddDouble(&shard.sum_squares, sample * sample);
+  }
+
+  // Returns the current histogram value as a proto, summing the shards.
+  // Samples added concurrently with the sum may or may not be included.
+  HistogramProto value() const {
+    std::array<int64_t, kNumBuckets> counts{};
+    double sum = 0;
+    double sum_squares = 0;
+    for (int s = 0; s < kNumShards; ++s) {
+      const Shard& shard = shards_[s];
+      for (int i = 0; i < kNumBuckets; ++i) {
+        counts[i] += shard.buckets[i].load(std::memory_order_relaxed);
+      }
+      sum += absl::bit_cast<double>(
+          shard.sum.load(std::memory_order_relaxed));
+      sum_squares += absl::bit_cast<double>(
+          shard.sum_squares.load(std::memory_order_relaxed));
+    }
+    HistogramProto pb;
+    int64_t num = 0;
+    int lowest = -1;
+    int highest = -1;
+    for (int i = 0; i < kNumBuckets; ++i) {
+      num += counts[i];
+      if (counts[i] > 0) {
+        if (lowest < 0) lowest = i;
+        highest = i;
+      }
+      pb.add_bucket_limit(BucketUpperLimit(i));
+      pb.add_bucket(counts[i]);
+    }
+    pb.set_num(num);
+    pb.set_sum(sum);
+    pb.set_sum_squares(sum_squares);
+    pb.set_min(lowest < 0 ? 0 : BucketLowerLimit(lowest));
+    pb.set_max(highest < 0 ? 0 : BucketUpperLimit(highest));
+    return pb;
+  }
+
+ private:
+  static constexpr int kNumShards = 16;  // Power of two.
+  static constexpr int kNumBuckets = 64;
+  // Unbiased exponent of the first bucket's lower bound: bucket i covers
+  // [2^(i + kMinExponent), 2^(i + kMinExponent + 1)).
+  static constexpr int kMinExponent = -16;
+
+  struct alignas(64) Shard {
+    std::atomic<int64_t> buckets[kNumBuckets] = {};
+    // Accumulated as double; stored as bits so the atomics stay lock-free.
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> sum_squares{0};
+  };
+
+  // Distributes threads round-robin over the shards, so that threads never
+  // contend on a shard unless there are more than kNumShards of them.
+  static size_t ShardIndex() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) & (kNumShards - 1);
+    return shard;
+  }
+
+  // Maps a sample to its power-of-two bucket without branches by reading the
+  // biased exponent straight out of the double's bit pattern.
+  static int BucketIndex(double sample) {
+    const uint64_t bits = absl::bit_cast<uint64_t>(sample);
+    const int exponent = static_cast<int>((bits >> 52) & 0x7ff);
+    int index = exponent - (1023 + kMinExponent);
+    // Branch-free clamp to [0, kNumBuckets - 1].
+    index &= ~(index >> 31);
+    index -= (index - (kNumBuckets - 1)) & ~((index - (kNumBuckets - 1)) >> 31);
+    // Force negative samples (sign bit set) into the first bucket.
+    index &= ~static_cast<int>(static_cast<int64_t>(bits) >> 63);
+    return index;
+  }
+
+  static double BucketLowerLimit(int i) {
+    return i == 0 ? 0.0 : std::ldexp(1.0, i + kMinExponent);
+  }
+
+  static double BucketUpperLimit(int i) {
+    return i == kNumBuckets - 1 ? DBL_MAX
+                                : std::ldexp(1.0, i + kMinExponent + 1);
+  }
+
+  // Adds `value` to a double accumulated in `*cell`. The CAS loop only
+  // retries under contention within one shard.
+  static void AtomicAddDouble(std::atomic<uint64_t>* cell, double value) {
+    uint64_t old_bits = cell->load(std::memory_order_relaxed);
+    uint64_t new_bits;
+    do {
+      new_bits = absl::bit_cast<uint64_t>(absl::bit_cast<double>(old_bits) +
+                                          value);
+    } while (!cell->compare_exchange_weak(old_bits, new_bits,
+                                          std::memory_order_relaxed));
+  }
+
+  const std::unique_ptr<Shard[]> shards_;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ShardedSamplerCell);
+};
+
+// A stateful class for updating a cumulative histogram metric with sharded,
+// lock-free cells. Mirrors Sampler, except that the bucketing is fixed to
+// powers of two (see ShardedSamplerCell) so no Buckets argument is taken.
+//
+// This class is thread-safe.
+template <int NumLabels>
+class ShardedSampler {
+ public:
+  ~ShardedSampler() {
+    // Deleted here, before the metric_def is destroyed.
+    registration_handle_.reset();
+  }
+
+  // Creates the metric based on the metric-definition arguments.
+  static ShardedSampler* New(
+      const MetricDef<MetricKind::kCumulative, HistogramProto, NumLabels>&
+          metric_def);
+
+  // Retrieves the cell for the specified labels, creating it on demand if
+  // not already present.
+  template <typename... Labels>
+  ShardedSamplerCell* GetCell(const Labels&... labels) TF_LOCKS_EXCLUDED(mu_);
+
+  Status GetStatus() { return status_; }
+
+ private:
+  ShardedSampler(const MetricDef<MetricKind::kCumulative, HistogramProto,
+                                 NumLabels>& metric_def)
+      : metric_def_(metric_def),
+        registration_handle_(CollectionRegistry::Default()->Register(
+            &metric_def_, [&](MetricCollectorGetter getter) {
+              auto metric_collector = getter.Get(&metric_def_);
+
+              mutex_lock l(mu_);
+              for (const auto& cell : cells_) {
+                metric_collector.CollectValue(cell.first, cell.second.value());
+              }
+            })) {
+    if (registration_handle_) {
+      status_ = Status::OK();
+    } else {
+      status_ = Status(tensorflow::error::Code::ALREADY_EXISTS,
+                       "Another metric with the same name already exists.");
+    }
+  }
+
+  mutable mutex mu_;
+
+  Status status_;
+
+  // The metric definition. This will be used to identify the metric when we
+  // register it for collection.
+  const MetricDef<MetricKind::kCumulative, HistogramProto, NumLabels>
+      metric_def_;
+
+  // Registration handle with the CollectionRegistry.
+  std::unique_ptr<CollectionRegistry::RegistrationHandle> registration_handle_;
+
+  using LabelArray = std::array<string, NumLabels>;
+  // we need a container here that guarantees pointer stability of the value,
+  // namely, the pointer of the value should remain valid even after more cells
+  // are inserted.
+  std::map<LabelArray, ShardedSamplerCell> cells_ TF_GUARDED_BY(mu_);
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ShardedSampler);
+};
+
+////
+//  Implementation details follow. API readers may skip.
+////
+
+template <int NumLabels>
+ShardedSampler<NumLabels>* ShardedSampler<NumLabels>::New(
+    const MetricDef<MetricKind::kCumulative, HistogramProto, NumLabels>&
+        metric_def) {
+  return new ShardedSampler<NumLabels>(metric_def);
+}
+
+template <int NumLabels>
+template <typename... Labels>
+ShardedSamplerCell* ShardedSampler<NumLabels>::GetCell(const Labels&... labels)
+    TF_LOCKS_EXCLUDED(mu_) {
+  // Provides a more informative error message than the one during array
+  // construction below.
+  static_assert(
+      sizeof...(Labels) == NumLabels,
+      "Mismatch between ShardedSampler<NumLabels> and number of labels "
+      "provided in GetCell(...).");
+
+  const LabelArray& label_array = {{labels...}};
+  mutex_lock l(mu_);
+  const auto found_it = cells_.find(label_array);
+  if (found_it != cells_.end()) {
+    return &(found_it->second);
+  }
+  return &(cells_
+               .emplace(std::piecewise_construct,
+                        std::forward_as_tuple(label_array),
+                        std::forward_as_tuple())
+               .first->second);
+}
+
+}  // namespace monitoring
+}  // namespace tensorflow
+
+#endif  // IS_MOBILE_PLATFORM
+#endif  // TENSORFLOW_CORE_LIB_MONITORING_SHARDED_SAMPLER_H_
@@ -0,0 +1,92 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/lib/monitoring/sharded_sampler.h"
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace monitoring {
+namespace {
+
+// Returns the count recorded in the bucket with the given upper limit.
+int64_t BucketCount(const HistogramProto& proto, double bucket_limit) {
+  for (int i = 0; i < proto.bucket_size(); ++i) {
+    if (proto.bucket_limit(i) == bucket_limit) {
+      return proto.bucket(i);
+    }
+  }
+  return -1;
+}
+
+TEST(ShardedSamplerCellTest, BucketsByPowersOfTwo) {
+  ShardedSamplerCell cell;
+  cell.Add(3.0);
+  cell.Add(3.5);
+  cell.Add(4.0);
+
+  const HistogramProto proto = cell.value();
+  EXPECT_EQ(proto.num(), 3);
+  EXPECT_DOUBLE_EQ(proto.sum(), 10.5);
+  // 3.0 and 3.5 fall in [2, 4); 4.0 falls in [4, 8).
+  EXPECT_EQ(BucketCount(proto, 4.0), 2);
+  EXPECT_EQ(BucketCount(proto, 8.0), 1);
+  // min/max are approximated by the occupied bucket bounds.
+  EXPECT_DOUBLE_EQ(proto.min(), 2.0);
+  EXPECT_DOUBLE_EQ(proto.max(), 8.0);
+}
+
+TEST(ShardedSamplerCellTest, SaturatesOutOfRangeSamples) {
+  ShardedSamplerCell cell;
+  cell.Add(0.0);
+  cell.Add(-5.0);
+  cell.Add(1e300);
+
+  const HistogramProto proto = cell.value();
+  EXPECT_EQ(proto.num(), 3);
+  // Zero and negative samples land in the first bucket, huge ones in the
+  // last.
+  EXPECT_EQ(proto.bucket(0), 2);
+  EXPECT_EQ(proto.bucket(proto.bucket_size() - 1), 1);
+  EXPECT_DOUBLE_EQ(proto.bucket_limit(proto.bucket_size() - 1), DBL_MAX);
+}
+
+auto* sharded_sampler = ShardedSampler<1>::New(
+    {"/tensorflow/test/sharded_sampler", "Sharded sampler with one label.",
+     "MyLabel"});
+
+TEST(ShardedSamplerTest, InitializedEmpty) {
+  EXPECT_EQ(sharded_sampler->GetCell("Empty")->value().num(), 0);
+}
+
+TEST(ShardedSamplerTest, GetCellsReturnsStablePointers) {
+  auto* cell = sharded_sampler->GetCell("Stable");
+  cell->Add(1.0);
+  sharded_sampler->GetCell("AddedToCheckPreviousCellValidity");
+  EXPECT_EQ(sharded_sampler->GetCell("Stable"), cell);
+  EXPECT_EQ(cell->value().num(), 1);
+}
+
+TEST(ShardedSamplerTest, SameName) {
+  auto* same = ShardedSampler<1>::New(
+      {"/tensorflow/test/sharded_sampler", "Duplicate.", "MyLabel"});
+  EXPECT_TRUE(sharded_sampler->GetStatus().ok());
+  EXPECT_FALSE(same->GetStatus().ok());
+  delete same;
+}
+
+}  // namespace
+}  // namespace monitoring
+}  // namespace tensorflow
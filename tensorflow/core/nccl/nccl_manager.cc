@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/nccl/nccl_manager.h"
 
 #include <utility>
+#include <vector>
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
@@ -28,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/annotated_traceme.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/util/env_var.h"
 #if GOOGLE_CUDA
 #include "tensorflow/stream_executor/cuda/cuda_activation.h"
 #elif TENSORFLOW_USE_ROCM
@@ -705,9 +707,21 @@ void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
   const cudaStream_t* cu_stream = reinterpret_cast<const cudaStream_t*>(
       comm_stream->implementation()->GpuStreamMemberHack());
 
+  // Maximum number of pending collectives drained into a single
+  // ncclGroupStart/ncclGroupEnd block.  NCCL aggregates operations issued
+  // inside a group into fewer kernel launches, which matters when many small
+  // tensors are reduced back to back.  Set to 1 to disable grouping.
+  static const int64_t max_grouped_launches = []() {
+    int64_t v;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_NCCL_MAX_GROUPED_LAUNCHES",
+                                    /*default_val=*/8, &v));
+    return v < 1 ? 1 : v;
+  }();
+
   while (true) {
-    // Find collective to run.
-    std::pair<Collective*, int> next_launch;
+    // Find collectives to run, draining whatever is already pending up to
+    // max_grouped_launches.
+    std::vector<std::pair<Collective*, int>> launches;
     {
       VLOG(3) << "Locking mutex nccl_stream " << nccl_stream;
       mutex_lock l(nccl_stream->mu);
@@ -718,134 +732,169 @@ void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
         }
         nccl_stream->cv.wait(l);
       }
-      next_launch = nccl_stream->pending_launches_.back();
-      nccl_stream->pending_launches_.pop_back();
+      while (!nccl_stream->pending_launches_.empty() &&
+             static_cast<int64_t>(launches.size()) < max_grouped_launches) {
+        launches.push_back(nccl_stream->pending_launches_.back());
+        nccl_stream->pending_launches_.pop_back();
+      }
     }
 
-    // Launch the nccl kernel.
-    Collective* collective = next_launch.first;
-    tensorflow::profiler::TraceMeConsumer traceme("Run Collective",
-                                                  collective->trace_context);
-
-    ncclDataType_t data_type = ToNcclType(collective->data_type);
-    int p_idx = next_launch.second;
-    Participant* p = collective->participants[p_idx].get();
-    auto nccl_comm = collective->communicator->members[p_idx].nccl_comm;
-    ncclResult_t nccl_result = ncclSuccess;
-    switch (collective->type) {
-      case kAllReduce: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-
-        VLOG(2) << "call NcclAllReduce collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllReduce",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_reduce"}});
-        });
-        nccl_result = ncclAllReduce(sendbuff, recvbuff, p->input->NumElements(),
-                                    data_type, collective->reduction_op,
-                                    nccl_comm, *cu_stream);
-        break;
-      }
-      case kBroadcast: {
-        const void* sendbuff = nullptr;
-        void* recvbuff = nullptr;
-        int num_elements = -1;
-        if (p->input) {
-          sendbuff = p->input->tensor_data().data();
-          num_elements = p->input->NumElements();
+    const bool grouped = launches.size() > 1;
+    std::vector<ncclResult_t> results(launches.size(), ncclSuccess);
+    // Marks launches whose done_callback already ran on an error path that
+    // never issued a nccl operation.
+    std::vector<bool> completed_inline(launches.size(), false);
+    ncclResult_t group_result = ncclSuccess;
+    if (grouped) group_result = ncclGroupStart();
+
+    for (size_t launch_idx = 0; launch_idx < launches.size(); ++launch_idx) {
+      // Launch the nccl kernel.
+      Collective* collective = launches[launch_idx].first;
+      tensorflow::profiler::TraceMeConsumer traceme("Run Collective",
+                                                    collective->trace_context);
+
+      ncclDataType_t data_type = ToNcclType(collective->data_type);
+      int p_idx = launches[launch_idx].second;
+      Participant* p = collective->participants[p_idx].get();
+      auto nccl_comm = collective->communicator->members[p_idx].nccl_comm;
+      ncclResult_t nccl_result = ncclSuccess;
+      switch (collective->type) {
+        case kAllReduce: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclAllReduce collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream "
+                  << comm_stream << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllReduce",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_reduce"}});
+          });
+          nccl_result = ncclAllReduce(sendbuff, recvbuff,
+                                      p->input->NumElements(), data_type,
+                                      collective->reduction_op, nccl_comm,
+                                      *cu_stream);
+          break;
         }
-        if (p->output) {
-          recvbuff = const_cast<char*>(p->output->tensor_data().data());
-          num_elements = p->output->NumElements();
-        } else {
-          // Operate in-place if no output (for the src node).
-          recvbuff = const_cast<void*>(sendbuff);
+        case kBroadcast: {
+          const void* sendbuff = nullptr;
+          void* recvbuff = nullptr;
+          int num_elements = -1;
+          if (p->input) {
+            sendbuff = p->input->tensor_data().data();
+            num_elements = p->input->NumElements();
+          }
+          if (p->output) {
+            recvbuff = const_cast<char*>(p->output->tensor_data().data());
+            num_elements = p->output->NumElements();
+          } else {
+            // Operate in-place if no output (for the src node).
+            recvbuff = const_cast<void*>(sendbuff);
+          }
+          if (num_elements < 0) {
+            p->done_callback(errors::Internal(
+                "Both input and output are null in ncclBroadcast"));
+            collective->Unref();
+            completed_inline[launch_idx] = true;
+            break;
+          }
+          VLOG(2) << "call NcclBroadcast collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream "
+                  << comm_stream << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclBroadcast",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "broadcast"}});
+          });
+          nccl_result =
+              ncclBroadcast(sendbuff, recvbuff, num_elements, data_type,
+                            collective->root_rank, nccl_comm, *cu_stream);
+          break;
         }
-        if (num_elements < 0) {
-          p->done_callback(errors::Internal(
-              "Both input and output are null in ncclBroadcast"));
-          collective->Unref();
-          continue;
+        case kReduce: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff =
+              p->output ? const_cast<char*>(p->output->tensor_data().data())
+                        : nullptr;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "buffer_size",
+                {{"output_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "reduce"}});
+          });
+          nccl_result = ncclReduce(sendbuff, recvbuff, p->input->NumElements(),
+                                   data_type, collective->reduction_op,
+                                   collective->root_rank, nccl_comm,
+                                   *cu_stream);
+          break;
+        }
+        case kAllGather: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclAllGather collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " sendbuff " << sendbuff << " sendcount "
+                  << p->input->NumElements() << " recvbuff " << recvbuff
+                  << " recvcount " << p->output->NumElements() << " nccl_comm "
+                  << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllGather",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_gather"}});
+          });
+          nccl_result = ncclAllGather(sendbuff, recvbuff,
+                                      p->input->NumElements(), data_type,
+                                      nccl_comm, *cu_stream);
+          break;
         }
-        VLOG(2) << "call NcclBroadcast collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclBroadcast",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "broadcast"}});
-        });
-        nccl_result =
-            ncclBroadcast(sendbuff, recvbuff, num_elements, data_type,
-                          collective->root_rank, nccl_comm, *cu_stream);
-        break;
-      }
-      case kReduce: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff =
-            p->output ? const_cast<char*>(p->output->tensor_data().data())
-                      : nullptr;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "buffer_size",
-              {{"output_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "reduce"}});
-        });
-        nccl_result = ncclReduce(sendbuff, recvbuff, p->input->NumElements(),
-                                 data_type, collective->reduction_op,
-                                 collective->root_rank, nccl_comm, *cu_stream);
-        break;
       }
-      case kAllGather: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+      results[launch_idx] = nccl_result;
+    }
 
-        VLOG(2) << "call NcclAllGather collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " sendbuff " << sendbuff << " sendcount "
-                << p->input->NumElements() << " recvbuff " << recvbuff
-                << " recvcount " << p->output->NumElements() << " nccl_comm "
-                << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllGather",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_gather"}});
-        });
-        nccl_result = ncclAllGather(sendbuff, recvbuff, p->input->NumElements(),
-                                    data_type, nccl_comm, *cu_stream);
-        break;
-      }
+    if (grouped) {
+      // Kernels for grouped operations are not enqueued until the group
+      // closes, so completion callbacks must not be scheduled before this
+      // point.
+      ncclResult_t end_result = ncclGroupEnd();
+      if (group_result == ncclSuccess) group_result = end_result;
     }
 
-    // Run the done_callback when the nccl kernel finishes running.
-    auto done_callback = [collective, p_idx, nccl_result]() {
-      VLOG(2) << "done Nccl kernel collective_key "
-              << collective->collective_key << " participant " << p_idx
-              << " ncclResult " << nccl_result;
-      if (nccl_result == ncclSuccess) {
-        collective->participants[p_idx]->done_callback(Status::OK());
-      } else {
-        // Propagate the error, but note that if other members of the collective
-        // did launch their kernels, then they are hanging.
-        collective->participants[p_idx]->done_callback(errors::Unknown(
-            "Error invoking NCCL: ", ncclGetErrorString(nccl_result)));
-      }
-      collective->Unref();
-    };
-    p->event_mgr->ThenExecute(comm_stream, done_callback);
+    for (size_t launch_idx = 0; launch_idx < launches.size(); ++launch_idx) {
+      if (completed_inline[launch_idx]) continue;
+      Collective* collective = launches[launch_idx].first;
+      int p_idx = launches[launch_idx].second;
+      ncclResult_t nccl_result = results[launch_idx] != ncclSuccess
+                                     ? results[launch_idx]
+                                     : group_result;
+      // Run the done_callback when the nccl kernel finishes running.
+      auto done_callback = [collective, p_idx, nccl_result]() {
+        VLOG(2) << "done Nccl kernel collective_key "
+                << collective->collective_key << " participant " << p_idx
+                << " ncclResult " << nccl_result;
+        if (nccl_result == ncclSuccess) {
+          collective->participants[p_idx]->done_callback(Status::OK());
+        } else {
+          // Propagate the error, but note that if other members of the
+          // collective did launch their kernels, then they are hanging.
+          collective->participants[p_idx]->done_callback(errors::Unknown(
+              "Error invoking NCCL: ", ncclGetErrorString(nccl_result)));
+        }
+        collective->Unref();
+      };
+      collective->participants[p_idx]->event_mgr->ThenExecute(comm_stream,
+                                                              done_callback);
+    }
   }
 }
 
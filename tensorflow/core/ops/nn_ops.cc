@@ -1216,6 +1216,29 @@ REGISTER_OP("Softmax")
       return shape_inference::UnchangedShapeWithRankAtLeast(c, 1);
     });
 
+REGISTER_OP("_ScaledMaskedSoftmax")
+    .Input("logits: T")
+    .Input("scale: T")
+    .Input("mask: T")
+    .Output("softmax: T")
+    .Attr("T: {bfloat16, float}")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle logits;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 4, &logits));
+      c->set_output(0, logits);
+      return Status::OK();
+    })
+    .Doc(R"doc(
+Computes Softmax(logits * scale + mask) over the innermost dimension.
+
+`logits` is a 4D tensor of attention logits, `scale` is a scalar, and `mask`
+is a 4D tensor whose dimensions are each either 1 or equal to the matching
+`logits` dimension.
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is expected to
+create these operators.
+)doc");
+
 // --------------------------------------------------------------------------
 
 REGISTER_OP("LogSoftmax")
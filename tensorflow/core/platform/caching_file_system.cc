@@ -0,0 +1,140 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/platform/caching_file_system.h"
+
+#include <cstring>
+#include <utility>
+
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/stringpiece.h"
+
+namespace tensorflow {
+namespace {
+
+// A random access file whose reads are served from the block cache.
+class CachedRandomAccessFile : public RandomAccessFile {
+ public:
+  CachedRandomAccessFile(std::string filename, RamFileBlockCache* cache)
+      : filename_(std::move(filename)), cache_(cache) {}
+
+  Status Name(StringPiece* result) const override {
+    *result = filename_;
+    return OkStatus();
+  }
+
+  Status Read(uint64 offset, size_t n, StringPiece* result,
+              char* scratch) const override {
+    *result = StringPiece();
+    size_t bytes_transferred;
+    TF_RETURN_IF_ERROR(
+        cache_->Read(filename_, offset, n, scratch, &bytes_transferred));
+    *result = StringPiece(scratch, bytes_transferred);
+    if (bytes_transferred < n) {
+      return errors::OutOfRange("EOF reached, ", result->size(),
+                                " bytes were read out of ", n,
+                                " bytes requested.");
+    }
+    return OkStatus();
+  }
+
+ private:
+  const std::string filename_;
+  RamFileBlockCache* const cache_;  // Not owned.
+};
+
+}  // namespace
+
+CachingFileSystem::CachingFileSystem(FileSystem* fs, size_t block_size,
+                                     size_t max_bytes, uint64 max_staleness,
+                                     Env* env)
+    : WrappedFileSystem(fs, nullptr),
+      block_cache_(new RamFileBlockCache(
+          block_size, max_bytes, max_staleness,
+          [this](const string& filename, size_t offset, size_t buffer_size,
+                 char* buffer, size_t* bytes_transferred) {
+            // Fetch a block from the delegate, bypassing the cache.
+            std::unique_ptr<RandomAccessFile> file;
+            TF_RETURN_IF_ERROR(WrappedFileSystem::NewRandomAccessFile(
+                filename, nullptr, &file));
+            StringPiece data;
+            Status status = file->Read(offset, buffer_size, &data, buffer);
+            if (!status.ok() && !errors::IsOutOfRange(status)) {
+              return status;
+            }
+            if (!data.empty() && data.data() != buffer) {
+              memmove(buffer, data.data(), data.size());
+            }
+            *bytes_transferred = data.size();
+            return OkStatus();
+          },
+          env)) {}
+
+Status CachingFileSystem::NewRandomAccessFile(
+    const std::string& fname, TransactionToken* token,
+    std::unique_ptr<RandomAccessFile>* result) {
+  if (!block_cache_->IsCacheEnabled()) {
+    return WrappedFileSystem::NewRandomAccessFile(fname, token, result);
+  }
+  // Derive a signature from the delegate's stat so that a file replaced
+  // behind the wrapper's back sheds its stale blocks on the next open.
+  FileStatistics stat;
+  TF_RETURN_IF_ERROR(WrappedFileSystem::Stat(fname, token, &stat));
+  const int64_t signature =
+      static_cast<int64_t>(Hash64Combine(static_cast<uint64>(stat.mtime_nsec),
+                                         static_cast<uint64>(stat.length)));
+  if (!block_cache_->ValidateAndUpdateFileSignature(fname, signature)) {
+    VLOG(1) << "File signature has been changed. Refreshing the cache. Path: "
+            << fname;
+  }
+  result->reset(new CachedRandomAccessFile(fname, block_cache_.get()));
+  return OkStatus();
+}
+
+Status CachingFileSystem::NewWritableFile(
+    const std::string& fname, TransactionToken* token,
+    std::unique_ptr<WritableFile>* result) {
+  block_cache_->RemoveFile(fname);
+  return WrappedFileSystem::NewWritableFile(fname, token, result);
+}
+
+Status CachingFileSystem::NewAppendableFile(
+    const std::string& fname, TransactionToken* token,
+    std::unique_ptr<WritableFile>* result) {
+  block_cache_->RemoveFile(fname);
+  return WrappedFileSystem::NewAppendableFile(fname, token, result);
+}
+
+Status CachingFileSystem::DeleteFile(const std::string& fname,
+                                     TransactionToken* token) {
+  block_cache_->RemoveFile(fname);
+  return WrappedFileSystem::DeleteFile(fname, token);
+}
+
+Status CachingFileSystem::RenameFile(const std::string& src,
+                                     const std::string& target,
+                                     TransactionToken* token) {
+  block_cache_->RemoveFile(src);
+  block_cache_->RemoveFile(target);
+  return WrappedFileSystem::RenameFile(src, target, token);
+}
+
+void CachingFileSystem::FlushCaches(TransactionToken* token) {
+  block_cache_->Flush();
+  WrappedFileSystem::FlushCaches(token);
+}
+
+}  // namespace tensorflow
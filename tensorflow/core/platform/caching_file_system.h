@@ -0,0 +1,81 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_PLATFORM_CACHING_FILE_SYSTEM_H_
+#define TENSORFLOW_CORE_PLATFORM_CACHING_FILE_SYSTEM_H_
+
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/platform/cloud/ram_file_block_cache.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/file_system.h"
+
+namespace tensorflow {
+
+// A FileSystem decorator that serves random-access reads through an LRU
+// block cache, giving any filesystem (S3-compatible object stores, NFS
+// mounts, ...) the read caching that GcsFileSystem implements privately.
+// One cache then serves every reader of the wrapped scheme: TFRecord
+// datasets, SavedModel loads and checkpoint restores alike.
+//
+// Opening a file validates a signature derived from the delegate's mtime
+// and size, so a file replaced behind the wrapper's back is re-fetched on
+// the next open rather than served stale. Mutations through the wrapper
+// (writes, appends, renames, deletes) invalidate the affected file's
+// cached blocks immediately.
+//
+// To cache an already registered scheme, wrap its FileSystem and register
+// the wrapper for the same scheme. Per-scheme policies follow from giving
+// each scheme its own wrapper with its own block size and byte budget.
+class CachingFileSystem : public WrappedFileSystem {
+ public:
+  // Reads through `fs` are cached in blocks of `block_size` bytes under an
+  // LRU budget of `max_bytes`; blocks older than `max_staleness` seconds
+  // are dropped (0 keeps blocks until evicted). A zero `block_size` or
+  // `max_bytes` disables caching, and reads pass straight through.
+  // `fs` is not owned and must outlive this object.
+  CachingFileSystem(FileSystem* fs, size_t block_size, size_t max_bytes,
+                    uint64 max_staleness, Env* env = Env::Default());
+
+  TF_USE_FILESYSTEM_METHODS_WITH_NO_TRANSACTION_SUPPORT;
+
+  Status NewRandomAccessFile(
+      const std::string& fname, TransactionToken* token,
+      std::unique_ptr<RandomAccessFile>* result) override;
+
+  Status NewWritableFile(const std::string& fname, TransactionToken* token,
+                         std::unique_ptr<WritableFile>* result) override;
+
+  Status NewAppendableFile(const std::string& fname, TransactionToken* token,
+                           std::unique_ptr<WritableFile>* result) override;
+
+  Status DeleteFile(const std::string& fname, TransactionToken* token) override;
+
+  Status RenameFile(const std::string& src, const std::string& target,
+                    TransactionToken* token) override;
+
+  void FlushCaches(TransactionToken* token) override;
+
+  // The current size (in bytes) of the block cache.
+  size_t CacheSize() const { return block_cache_->CacheSize(); }
+
+ private:
+  std::unique_ptr<RamFileBlockCache> block_cache_;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PLATFORM_CACHING_FILE_SYSTEM_H_
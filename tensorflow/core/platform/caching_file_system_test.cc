@@ -0,0 +1,99 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/platform/caching_file_system.h"
+
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(CachingFileSystemTest, CachesReads) {
+  Env* env = Env::Default();
+  const std::string fname = io::JoinPath(testing::TmpDir(), "cached_file");
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+  FileSystem* base = nullptr;
+  TF_ASSERT_OK(env->GetFileSystemForFile(fname, &base));
+
+  CachingFileSystem fs(base, /*block_size=*/4, /*max_bytes=*/64,
+                       /*max_staleness=*/0);
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(fs.NewRandomAccessFile(fname, nullptr, &file));
+  char scratch[16];
+  StringPiece result;
+  TF_ASSERT_OK(file->Read(0, 4, &result, scratch));
+  EXPECT_EQ(result, "0123");
+  EXPECT_GT(fs.CacheSize(), 0);
+
+  // Reads past EOF return the available bytes with OUT_OF_RANGE.
+  Status s = file->Read(8, 4, &result, scratch);
+  EXPECT_TRUE(errors::IsOutOfRange(s));
+  EXPECT_EQ(result, "89");
+
+  // A replaced file fails signature validation (the length differs) and is
+  // re-read on the next open instead of served from stale blocks.
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "abcdefghijk"));
+  TF_ASSERT_OK(fs.NewRandomAccessFile(fname, nullptr, &file));
+  TF_ASSERT_OK(file->Read(0, 4, &result, scratch));
+  EXPECT_EQ(result, "abcd");
+}
+
+TEST(CachingFileSystemTest, MutationsInvalidateCachedBlocks) {
+  Env* env = Env::Default();
+  const std::string fname = io::JoinPath(testing::TmpDir(), "mutated_file");
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+  FileSystem* base = nullptr;
+  TF_ASSERT_OK(env->GetFileSystemForFile(fname, &base));
+
+  CachingFileSystem fs(base, /*block_size=*/4, /*max_bytes=*/64,
+                       /*max_staleness=*/0);
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(fs.NewRandomAccessFile(fname, nullptr, &file));
+  char scratch[16];
+  StringPiece result;
+  TF_ASSERT_OK(file->Read(0, 4, &result, scratch));
+  EXPECT_GT(fs.CacheSize(), 0);
+
+  TF_ASSERT_OK(fs.DeleteFile(fname, nullptr));
+  EXPECT_EQ(fs.CacheSize(), 0);
+}
+
+TEST(CachingFileSystemTest, DisabledCachePassesThrough) {
+  Env* env = Env::Default();
+  const std::string fname = io::JoinPath(testing::TmpDir(), "uncached_file");
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+  FileSystem* base = nullptr;
+  TF_ASSERT_OK(env->GetFileSystemForFile(fname, &base));
+
+  CachingFileSystem fs(base, /*block_size=*/0, /*max_bytes=*/0,
+                       /*max_staleness=*/0);
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(fs.NewRandomAccessFile(fname, nullptr, &file));
+  char scratch[16];
+  StringPiece result;
+  TF_ASSERT_OK(file->Read(0, 4, &result, scratch));
+  EXPECT_EQ(result, "0123");
+  EXPECT_EQ(fs.CacheSize(), 0);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -94,6 +94,12 @@ class FileBlockCache {
   virtual Status Read(const string& filename, size_t offset, size_t n,
                       char* buffer, size_t* bytes_transferred) = 0;
 
+  /// Hint that the block of `filename` containing `offset` is likely to be
+  /// read soon.  Implementations may fetch the block in the background; the
+  /// default does nothing.  Errors are not reported: the block is simply not
+  /// cached and a subsequent Read() fetches it (and surfaces the error).
+  virtual void Prefetch(const string& filename, size_t offset) {}
+
   // Validate the given file signature with the existing file signature in the
   // cache. Returns true if the signature doesn't change or the file did not
   // exist before. If the signature changes, update the existing signature with
@@ -41,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/platform/cloud/google_auth_provider.h"
 #include "tensorflow/core/platform/cloud/ram_file_block_cache.h"
 #include "tensorflow/core/platform/cloud/time_util.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/mutex.h"
@@ -271,10 +272,24 @@ class GcsRandomAccessFile : public RandomAccessFile {
   using ReadFn =
       std::function<Status(const string& filename, uint64 offset, size_t n,
                            StringPiece* result, char* scratch)>;
+  using PrefetchFn =
+      std::function<void(const string& filename, uint64 offset)>;
 
   GcsRandomAccessFile(const string& filename, ReadFn read_fn)
       : filename_(filename), read_fn_(std::move(read_fn)) {}
 
+  /// Like the above, but after a sequential read, hints the next
+  /// `prefetch_blocks` blocks of `block_size` bytes to `prefetch_fn` so they
+  /// can be fetched in the background ahead of the scan.
+  GcsRandomAccessFile(const string& filename, ReadFn read_fn,
+                      PrefetchFn prefetch_fn, uint64 block_size,
+                      uint64 prefetch_blocks)
+      : filename_(filename),
+        read_fn_(std::move(read_fn)),
+        prefetch_fn_(std::move(prefetch_fn)),
+        block_size_(block_size),
+        prefetch_blocks_(prefetch_blocks) {}
+
   Status Name(StringPiece* result) const override {
     *result = filename_;
     return OkStatus();
@@ -283,14 +298,79 @@ class GcsRandomAccessFile : public RandomAccessFile {
   /// The implementation of reads with an LRU block cache. Thread safe.
   Status Read(uint64 offset, size_t n, StringPiece* result,
               char* scratch) const override {
-    return read_fn_(filename_, offset, n, result, scratch);
+    Status status = read_fn_(filename_, offset, n, result, scratch);
+    if (status.ok() && prefetch_blocks_ > 0) {
+      MaybePrefetch(offset, result->size());
+    }
+    return status;
+  }
+
+  Status ReadMultiple(ReadRequest* requests,
+                      size_t num_requests) const override {
+    if (num_requests <= 1) {
+      return RandomAccessFile::ReadMultiple(requests, num_requests);
+    }
+    // Each cache miss turns into its own HTTP range request, so issuing the
+    // ranges concurrently overlaps the round trips.
+    BlockingCounter counter(num_requests);
+    for (size_t i = 0; i < num_requests; ++i) {
+      ReadRequest* request = &requests[i];
+      Env::Default()->SchedClosure([this, request, &counter] {
+        request->status = Read(request->offset, request->n, &request->result,
+                               request->scratch);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+    Status status;
+    for (size_t i = 0; i < num_requests; ++i) {
+      status.Update(requests[i].status);
+    }
+    return status;
+  }
+
+  void ReadAsync(uint64 offset, size_t n, char* scratch,
+                 std::function<void(const Status&, StringPiece)> done)
+      const override {
+    Env::Default()->SchedClosure(
+        [this, offset, n, scratch, done = std::move(done)] {
+          StringPiece result;
+          Status status = Read(offset, n, &result, scratch);
+          done(status, result);
+        });
   }
 
  private:
+  /// If this read continues where the previous one left off, the file is
+  /// being scanned sequentially: hint the next blocks to the prefetcher.
+  void MaybePrefetch(uint64 offset, size_t n) const {
+    const uint64 next_offset = offset + n;
+    bool sequential;
+    {
+      mutex_lock l(mu_);
+      sequential = (offset == next_sequential_offset_);
+      next_sequential_offset_ = next_offset;
+    }
+    if (!sequential) return;
+    for (uint64 i = 0; i < prefetch_blocks_; ++i) {
+      prefetch_fn_(filename_, next_offset + i * block_size_);
+    }
+  }
+
   /// The filename of this file.
   const string filename_;
   /// The implementation of the read operation (provided by the GCSFileSystem).
   const ReadFn read_fn_;
+  /// The implementation of block prefetch hints; may be empty if
+  /// prefetch_blocks_ is 0.
+  const PrefetchFn prefetch_fn_;
+  /// The block size used by the underlying cache, and the number of blocks to
+  /// prefetch ahead of a detected sequential read.
+  const uint64 block_size_ = 0;
+  const uint64 prefetch_blocks_ = 0;
+  /// The offset at which a read would continue the previous one.
+  mutable mutex mu_;
+  mutable uint64 next_sequential_offset_ TF_GUARDED_BY(mu_) = 0;
 };
 
 /// A GCS-based implementation of a random access file with a read buffer.
@@ -806,9 +886,26 @@ GcsFileSystem::GcsFileSystem(bool make_default_cache) {
   if (!make_default_cache) {
     max_bytes = 0;
   }
+
+  // Apply the overrides for sequential-read prefetching and parallel block
+  // fetches, if provided.
+  if (GetEnvVar(kPrefetchBlocks, strings::safe_strtou64, &value)) {
+    prefetch_blocks_ = value;
+  }
+  if (GetEnvVar(kFetchThreads, strings::safe_strtou64, &value)) {
+    fetch_threads_ = value;
+  }
+  if (prefetch_blocks_ > 0 && fetch_threads_ == 0) {
+    // Prefetching requires background threads; default to one per block of
+    // readahead.
+    fetch_threads_ = prefetch_blocks_;
+  }
+
   VLOG(1) << "GCS cache max size = " << max_bytes << " ; "
           << "block size = " << block_size_ << " ; "
-          << "max staleness = " << max_staleness;
+          << "max staleness = " << max_staleness << " ; "
+          << "prefetch blocks = " << prefetch_blocks_ << " ; "
+          << "fetch threads = " << fetch_threads_;
   file_block_cache_ = MakeFileBlockCache(block_size_, max_bytes, max_staleness);
   // Apply overrides for the stat cache max age and max entries, if provided.
   uint64 stat_cache_max_age = kStatCacheDefaultMaxAge;
@@ -965,36 +1062,45 @@ Status GcsFileSystem::NewRandomAccessFile(
   TF_RETURN_IF_ERROR(ParseGcsPath(fname, false, &bucket, &object));
   TF_RETURN_IF_ERROR(CheckBucketLocationConstraint(bucket));
   if (cache_enabled_) {
-    result->reset(new GcsRandomAccessFile(fname, [this, bucket, object](
-                                                     const string& fname,
-                                                     uint64 offset, size_t n,
-                                                     StringPiece* result,
-                                                     char* scratch) {
-      tf_shared_lock l(block_cache_lock_);
-      GcsFileStat stat;
-      TF_RETURN_IF_ERROR(stat_cache_->LookupOrCompute(
-          fname, &stat,
-          [this, bucket, object](const string& fname, GcsFileStat* stat) {
-            return UncachedStatForObject(fname, bucket, object, stat);
-          }));
-      if (!file_block_cache_->ValidateAndUpdateFileSignature(
-              fname, stat.generation_number)) {
-        VLOG(1)
-            << "File signature has been changed. Refreshing the cache. Path: "
-            << fname;
-      }
-      *result = StringPiece();
-      size_t bytes_transferred;
-      TF_RETURN_IF_ERROR(file_block_cache_->Read(fname, offset, n, scratch,
-                                                 &bytes_transferred));
-      *result = StringPiece(scratch, bytes_transferred);
-      if (bytes_transferred < n) {
-        return errors::OutOfRange("EOF reached, ", result->size(),
-                                  " bytes were read out of ", n,
-                                  " bytes requested.");
-      }
-      return OkStatus();
-    }));
+    GcsRandomAccessFile::ReadFn read_fn =
+        [this, bucket, object](const string& fname, uint64 offset, size_t n,
+                               StringPiece* result, char* scratch) {
+          tf_shared_lock l(block_cache_lock_);
+          GcsFileStat stat;
+          TF_RETURN_IF_ERROR(stat_cache_->LookupOrCompute(
+              fname, &stat,
+              [this, bucket, object](const string& fname, GcsFileStat* stat) {
+                return UncachedStatForObject(fname, bucket, object, stat);
+              }));
+          if (!file_block_cache_->ValidateAndUpdateFileSignature(
+                  fname, stat.generation_number)) {
+            VLOG(1) << "File signature has been changed. Refreshing the "
+                       "cache. Path: "
+                    << fname;
+          }
+          *result = StringPiece();
+          size_t bytes_transferred;
+          TF_RETURN_IF_ERROR(file_block_cache_->Read(fname, offset, n, scratch,
+                                                     &bytes_transferred));
+          *result = StringPiece(scratch, bytes_transferred);
+          if (bytes_transferred < n) {
+            return errors::OutOfRange("EOF reached, ", result->size(),
+                                      " bytes were read out of ", n,
+                                      " bytes requested.");
+          }
+          return OkStatus();
+        };
+    if (prefetch_blocks_ > 0) {
+      result->reset(new GcsRandomAccessFile(
+          fname, std::move(read_fn),
+          [this](const string& fname, uint64 offset) {
+            tf_shared_lock l(block_cache_lock_);
+            file_block_cache_->Prefetch(fname, offset);
+          },
+          block_size_, prefetch_blocks_));
+    } else {
+      result->reset(new GcsRandomAccessFile(fname, std::move(read_fn)));
+    }
   } else {
     result->reset(new BufferedGcsRandomAccessFile(
         fname, block_size_,
@@ -1036,7 +1142,8 @@ std::unique_ptr<FileBlockCache> GcsFileSystem::MakeFileBlockCache(
              size_t* bytes_transferred) {
         return LoadBufferFromGCS(filename, offset, n, buffer,
                                  bytes_transferred);
-      }));
+      },
+      Env::Default(), fetch_threads_));
 
   // Check if cache is enabled here to avoid unnecessary mutex contention.
   cache_enabled_ = file_block_cache->IsCacheEnabled();
@@ -62,6 +62,15 @@ constexpr size_t kDefaultMaxCacheSize = 0;
 // will be evicted on the next read.
 constexpr char kMaxStaleness[] = "GCS_READ_CACHE_MAX_STALENESS";
 constexpr uint64 kDefaultMaxStaleness = 0;
+// The environment variable that sets the number of blocks fetched in the
+// background after a sequential read (0, the default, disables prefetching).
+constexpr char kPrefetchBlocks[] = "GCS_READ_CACHE_PREFETCH_BLOCKS";
+constexpr uint64 kDefaultPrefetchBlocks = 0;
+// The environment variable that sets the number of threads fetching blocks in
+// parallel, serving both prefetches and multi-block reads (0, the default,
+// keeps all fetches on the reading thread).
+constexpr char kFetchThreads[] = "GCS_READ_CACHE_FETCH_THREADS";
+constexpr uint64 kDefaultFetchThreads = 0;
 
 // Helper function to extract an environment variable and convert it into a
 // value of type T.
@@ -415,6 +424,11 @@ class GcsFileSystem : public FileSystem {
   // Reads smaller than block_size_ will trigger a read of block_size_.
   uint64 block_size_;
 
+  // Number of blocks fetched in the background after a sequential read, and
+  // the number of threads the block cache uses to fetch blocks in parallel.
+  uint64 prefetch_blocks_ = kDefaultPrefetchBlocks;
+  uint64 fetch_threads_ = kDefaultFetchThreads;
+
   // block_cache_lock_ protects the file_block_cache_ pointer (Note that
   // FileBlockCache instances are themselves threadsafe).
   mutex block_cache_lock_;
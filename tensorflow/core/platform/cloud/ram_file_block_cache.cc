@@ -165,6 +165,27 @@ Status RamFileBlockCache::MaybeFetch(const Key& key,
       "Control flow should never reach the end of RamFileBlockCache::Fetch.");
 }
 
+void RamFileBlockCache::Prefetch(const string& filename, size_t offset) {
+  if (fetch_pool_ == nullptr) {
+    return;
+  }
+  Key key = std::make_pair(filename, block_size_ * (offset / block_size_));
+  {
+    mutex_lock lock(mu_);
+    auto entry = block_map_.find(key);
+    if (entry != block_map_.end() && BlockNotStale(entry->second)) {
+      // Already cached or being fetched.
+      return;
+    }
+  }
+  fetch_pool_->Schedule([this, key] {
+    std::shared_ptr<Block> block = Lookup(key);
+    if (MaybeFetch(key, block).ok()) {
+      UpdateLRU(key, block).IgnoreError();
+    }
+  });
+}
+
 Status RamFileBlockCache::Read(const string& filename, size_t offset, size_t n,
                                char* buffer, size_t* bytes_transferred) {
   *bytes_transferred = 0;
@@ -182,6 +203,13 @@ Status RamFileBlockCache::Read(const string& filename, size_t offset, size_t n,
   if (finish < offset + n) {
     finish += block_size_;
   }
+  if (fetch_pool_ != nullptr && finish - start > block_size_) {
+    // Kick off fetches of the later blocks so they download in parallel with
+    // the first; MaybeFetch below coalesces with the in-flight fetches.
+    for (size_t pos = start + block_size_; pos < finish; pos += block_size_) {
+      Prefetch(filename, pos);
+    }
+  }
   size_t total_bytes_transferred = 0;
   // Now iterate through the blocks, reading them one at a time.
   for (size_t pos = start; pos < finish; pos += block_size_) {
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/platform/cloud/ram_file_block_cache.h"
 
+#include <atomic>
 #include <cstring>
 
 #include "tensorflow/core/lib/core/status_test_util.h"
@@ -547,6 +548,39 @@ TEST(RamFileBlockCacheTest, CoalesceConcurrentReads) {
   EXPECT_EQ(1, num_requests);
 }
 
+TEST(RamFileBlockCacheTest, Prefetch) {
+  std::atomic<int> calls(0);
+  auto fetcher = [&calls](const string& filename, size_t offset, size_t n,
+                          char* buffer, size_t* bytes_transferred) {
+    calls++;
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  const size_t block_size = 16;
+  {
+    // Without fetch threads, Prefetch is a no-op.
+    RamFileBlockCache cache(block_size, 2 * block_size, 0, fetcher);
+    cache.Prefetch("file", 0);
+    Env::Default()->SleepForMicroseconds(100000);  // 0.1 secs
+    EXPECT_EQ(calls, 0);
+  }
+  {
+    RamFileBlockCache cache(block_size, 2 * block_size, 0, fetcher,
+                            Env::Default(), /*fetch_threads=*/2);
+    cache.Prefetch("file", 0);
+    // The read is served from the prefetched block, coalescing with the
+    // background fetch if it is still in flight.
+    std::vector<char> out;
+    TF_EXPECT_OK(ReadCache(&cache, "file", 0, block_size, &out));
+    EXPECT_EQ(calls, 1);
+    // A duplicate hint for a cached block does not refetch.
+    cache.Prefetch("file", 0);
+    TF_EXPECT_OK(ReadCache(&cache, "file", 0, block_size, &out));
+    EXPECT_EQ(calls, 1);
+  }
+}
+
 TEST(RamFileBlockCacheTest, Flush) {
   int calls = 0;
   auto fetcher = [&calls](const string& filename, size_t offset, size_t n,
@@ -29,6 +29,7 @@ limitations under the License.
 #include <time.h>
 #include <unistd.h>
 
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/default/posix_file_system.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
@@ -96,6 +97,41 @@ class PosixRandomAccessFile : public RandomAccessFile {
     return s;
   }
 
+  Status ReadMultiple(ReadRequest* requests,
+                      size_t num_requests) const override {
+    if (num_requests <= 1) {
+      return RandomAccessFile::ReadMultiple(requests, num_requests);
+    }
+    // pread() is safe on a shared descriptor, so issue the ranges in
+    // parallel and keep some queue depth on the device.
+    BlockingCounter counter(num_requests);
+    for (size_t i = 0; i < num_requests; ++i) {
+      ReadRequest* request = &requests[i];
+      Env::Default()->SchedClosure([this, request, &counter] {
+        request->status = Read(request->offset, request->n, &request->result,
+                               request->scratch);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+    Status status;
+    for (size_t i = 0; i < num_requests; ++i) {
+      status.Update(requests[i].status);
+    }
+    return status;
+  }
+
+  void ReadAsync(uint64 offset, size_t n, char* scratch,
+                 std::function<void(const Status&, StringPiece)> done)
+      const override {
+    Env::Default()->SchedClosure(
+        [this, offset, n, scratch, done = std::move(done)] {
+          StringPiece result;
+          Status status = Read(offset, n, &result, scratch);
+          done(status, result);
+        });
+  }
+
 #if defined(TF_CORD_SUPPORT)
   Status Read(uint64 offset, size_t n, absl::Cord* cord) const override {
     if (n == 0) {
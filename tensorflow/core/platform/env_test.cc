@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/platform/cord.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/null_file_system.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/protobuf.h"
@@ -90,6 +91,56 @@ TEST_F(DefaultEnvTest, IncompleteReadOutOfRange) {
   EXPECT_EQ(input, result);
 }
 
+TEST_F(DefaultEnvTest, ReadMultiple) {
+  const string filename = io::JoinPath(BaseDir(), "read_multiple");
+  const string input = CreateTestFile(env_, filename, 1000);
+  std::unique_ptr<RandomAccessFile> f;
+  TF_EXPECT_OK(env_->NewRandomAccessFile(filename, &f));
+
+  char scratch[3][100];
+  RandomAccessFile::ReadRequest requests[3];
+  for (int i = 0; i < 3; ++i) {
+    requests[i].offset = i * 300;
+    requests[i].n = 100;
+    requests[i].scratch = scratch[i];
+  }
+  TF_EXPECT_OK(f->ReadMultiple(requests, 3));
+  for (int i = 0; i < 3; ++i) {
+    TF_EXPECT_OK(requests[i].status);
+    EXPECT_EQ(input.substr(i * 300, 100), requests[i].result);
+  }
+
+  // A request past EOF fails with OUT_OF_RANGE; the others still succeed, and
+  // the aggregate status reflects the failure.
+  requests[2].offset = 950;
+  EXPECT_EQ(error::OUT_OF_RANGE, f->ReadMultiple(requests, 3).code());
+  TF_EXPECT_OK(requests[0].status);
+  TF_EXPECT_OK(requests[1].status);
+  EXPECT_EQ(error::OUT_OF_RANGE, requests[2].status.code());
+  EXPECT_EQ(input.substr(950), requests[2].result);
+}
+
+TEST_F(DefaultEnvTest, ReadAsync) {
+  const string filename = io::JoinPath(BaseDir(), "read_async");
+  const string input = CreateTestFile(env_, filename, 100);
+  std::unique_ptr<RandomAccessFile> f;
+  TF_EXPECT_OK(env_->NewRandomAccessFile(filename, &f));
+
+  char scratch[50];
+  Notification done;
+  Status read_status;
+  string read_result;
+  f->ReadAsync(25, 50, scratch,
+               [&](const Status& status, StringPiece result) {
+                 read_status = status;
+                 read_result = string(result);
+                 done.Notify();
+               });
+  done.WaitForNotification();
+  TF_EXPECT_OK(read_status);
+  EXPECT_EQ(input.substr(25, 50), read_result);
+}
+
 TEST_F(DefaultEnvTest, ReadFileToString) {
   for (const int length : {0, 1, 1212, 2553, 4928, 8196, 9000, (1 << 20) - 1,
                            1 << 20, (1 << 20) + 1, (256 << 20) + 100}) {
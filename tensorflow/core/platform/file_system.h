@@ -774,6 +774,56 @@ class RandomAccessFile {
   virtual tensorflow::Status Read(uint64 offset, size_t n, StringPiece* result,
                                   char* scratch) const = 0;
 
+  /// A single range of a vectored read: `n` bytes at `offset` read into
+  /// `scratch`, with `result` and `status` filled in with the semantics of
+  /// Read().
+  struct ReadRequest {
+    uint64 offset = 0;
+    size_t n = 0;
+    char* scratch = nullptr;
+    StringPiece result;
+    tensorflow::Status status;
+  };
+
+  /// \brief Reads several independent ranges of the file.
+  ///
+  /// Each request is processed with the semantics of Read(), including the
+  /// OUT_OF_RANGE convention at EOF, and its `result` and `status` fields are
+  /// filled in place.  Returns the first non-OK request status, if any.
+  ///
+  /// The default implementation issues the reads one at a time; filesystems
+  /// that can serve ranges concurrently (parallel range requests, device
+  /// queue depth) override this.
+  ///
+  /// Safe for concurrent use by multiple threads.
+  virtual tensorflow::Status ReadMultiple(ReadRequest* requests,
+                                          size_t num_requests) const {
+    tensorflow::Status status;
+    for (size_t i = 0; i < num_requests; ++i) {
+      ReadRequest& request = requests[i];
+      request.status =
+          Read(request.offset, request.n, &request.result, request.scratch);
+      status.Update(request.status);
+    }
+    return status;
+  }
+
+  /// \brief Starts reading `n` bytes at `offset` and invokes `done` with the
+  /// outcome, following the semantics of Read().
+  ///
+  /// `done` may be invoked on an internal I/O thread or, as in the default
+  /// implementation, synchronously from the calling thread.  Both `scratch`
+  /// and the file itself must stay live until `done` has run.  Filesystems
+  /// with a native notion of asynchronous I/O override this to return without
+  /// blocking.
+  virtual void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(const tensorflow::Status&, StringPiece)> done) const {
+    StringPiece result;
+    tensorflow::Status status = Read(offset, n, &result, scratch);
+    done(status, result);
+  }
+
 #if defined(TF_CORD_SUPPORT)
   /// \brief Read up to `n` bytes from the file starting at `offset`.
   virtual tensorflow::Status Read(uint64 offset, size_t n,
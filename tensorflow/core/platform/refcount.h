@@ -65,6 +65,17 @@ class RefCounted {
   // reference implementation.
   bool TryRef() const;
 
+  // Decrements the reference count like Unref(), but first tests for a
+  // count of one. In that case the caller owns the only reference and the
+  // object is destroyed without the atomic read-modify-write that Unref()
+  // performs, which contends on the cache line even when uncontended.
+  //
+  // This must never be used on objects that support weak references: a
+  // concurrent TryRef() from WeakPtr::GetNewRef() could resurrect the
+  // object after the sole-owner test. Subclasses that are never weakly
+  // referenced (e.g. tensor buffers) may expose it as their release path.
+  bool UnrefSingleOwner() const;
+
  private:
   mutable std::atomic_int_fast32_t ref_;
 
@@ -291,6 +302,18 @@ inline bool RefCounted::Unref() const {
   return false;
 }
 
+inline bool RefCounted::UnrefSingleOwner() const {
+  // RefCountIsOne() performs the acquire needed to act on the object with
+  // exclusive access; decrements by former owners happen-before it.
+  if (RefCountIsOne()) {
+    // Make the DCHECK in ~RefCounted happy.
+    DCHECK((ref_.store(0), true));
+    delete this;
+    return true;
+  }
+  return Unref();
+}
+
 inline int_fast32_t RefCounted::RefCount() const {
   return ref_.load(std::memory_order_acquire);
 }
@@ -63,6 +63,24 @@ TEST_F(RefTest, RefUnref) {
   ASSERT_EQ(1, destroyed_);
 }
 
+class MyRefSingleOwner : public RefCounted {
+ public:
+  MyRefSingleOwner() { RefTest::constructed_++; }
+  ~MyRefSingleOwner() override { RefTest::destroyed_++; }
+  bool UnrefFast() const { return UnrefSingleOwner(); }
+};
+
+TEST_F(RefTest, UnrefSingleOwner) {
+  MyRefSingleOwner* ref = new MyRefSingleOwner;
+  ref->Ref();
+  // Shared: falls back to the locked decrement.
+  ASSERT_FALSE(ref->UnrefFast());
+  ASSERT_EQ(0, destroyed_);
+  // Sole owner: fast-path destruction.
+  ASSERT_TRUE(ref->UnrefFast());
+  ASSERT_EQ(1, destroyed_);
+}
+
 TEST_F(RefTest, RefCountOne) {
   MyRef* ref = new MyRef;
   ASSERT_TRUE(ref->RefCountIsOne());
@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/setround.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/tracing.h"
 
 namespace tensorflow {
@@ -105,6 +106,33 @@ ThreadPool::ThreadPool(Env* env, const ThreadOptions& thread_options,
                                                        num_threads, allocator));
 }
 
+/* static */
+std::vector<std::unique_ptr<ThreadPool>> ThreadPool::CreatePerNumaNodePools(
+    Env* env, const ThreadOptions& thread_options, const std::string& name,
+    int num_threads, bool low_latency_hint) {
+  CHECK_GE(num_threads, 1);
+  std::vector<std::unique_ptr<ThreadPool>> pools;
+  const int num_nodes = port::NUMAEnabled() ? port::NUMANumNodes() : 1;
+  if (num_nodes <= 1) {
+    pools.emplace_back(new ThreadPool(env, thread_options, name, num_threads,
+                                      low_latency_hint, nullptr));
+    return pools;
+  }
+  pools.reserve(num_nodes);
+  for (int node = 0; node < num_nodes; ++node) {
+    // Split the threads evenly, giving one extra thread to the first
+    // (num_threads % num_nodes) nodes, and at least one to every node.
+    const int node_threads = std::max(
+        1, num_threads / num_nodes + (node < num_threads % num_nodes ? 1 : 0));
+    ThreadOptions node_options = thread_options;
+    node_options.numa_node = node;
+    pools.emplace_back(new ThreadPool(
+        env, node_options, strings::StrCat(name, "_numa", node), node_threads,
+        low_latency_hint, nullptr));
+  }
+  return pools;
+}
+
 ThreadPool::ThreadPool(thread::ThreadPoolInterface* user_threadpool) {
   underlying_threadpool_ = user_threadpool;
   threadpool_device_.reset(new Eigen::ThreadPoolDevice(
@@ -264,6 +292,66 @@ void ThreadPool::SetStealPartitions(
   eigen_threadpool_->SetStealPartitions(partitions);
 }
 
+void ThreadPool::SetStealDomains(
+    const std::vector<std::pair<unsigned, unsigned>>& domains) {
+  // Like SetStealPartitions, this relies on the pool owning its threads.
+  DCHECK(eigen_threadpool_ != nullptr);
+  const unsigned num_threads = static_cast<unsigned>(NumThreads());
+  if (domains.empty()) {
+    // Restore uniform stealing across the whole pool.
+    eigen_threadpool_->SetStealPartitions(
+        std::vector<std::pair<unsigned, unsigned>>(num_threads,
+                                                   {0, num_threads}));
+    steal_domains_.clear();
+    return;
+  }
+  // The domains must tile [0, num_threads) in order, with no gaps.
+  unsigned next_thread = 0;
+  for (const auto& domain : domains) {
+    CHECK_EQ(domain.first, next_thread);
+    CHECK_GT(domain.second, domain.first);
+    next_thread = domain.second;
+  }
+  CHECK_EQ(next_thread, num_threads);
+  // Every thread of a domain steals within the domain's range.
+  std::vector<std::pair<unsigned, unsigned>> partitions(num_threads);
+  for (const auto& domain : domains) {
+    for (unsigned t = domain.first; t < domain.second; ++t) {
+      partitions[t] = domain;
+    }
+  }
+  eigen_threadpool_->SetStealPartitions(partitions);
+  steal_domains_ = domains;
+}
+
+int ThreadPool::NumStealDomains() const {
+  return steal_domains_.empty() ? 1 : steal_domains_.size();
+}
+
+void ThreadPool::ScheduleInDomain(std::function<void()> fn, int domain) {
+  if (domain < 0 || domain >= static_cast<int>(steal_domains_.size())) {
+    Schedule(std::move(fn));
+    return;
+  }
+  const auto& range = steal_domains_[domain];
+  ScheduleWithHint(std::move(fn), range.first, range.second);
+}
+
+void ThreadPool::ScheduleForBuffer(std::function<void()> fn, const void* buf) {
+  int node = port::kNUMANoAffinity;
+  if (buf != nullptr && !steal_domains_.empty()) {
+    node = port::NUMAGetMemAffinity(buf);
+  }
+  if (node == port::kNUMANoAffinity) {
+    Schedule(std::move(fn));
+    return;
+  }
+  // With one domain per NUMA node in node order this is the identity
+  // mapping; with fewer domains the nodes wrap around them.
+  ScheduleInDomain(std::move(fn),
+                   node % static_cast<int>(steal_domains_.size()));
+}
+
 Eigen::ThreadPoolInterface* ThreadPool::AsEigenThreadPool() const {
   DCHECK(underlying_threadpool_ != nullptr);
   return underlying_threadpool_;
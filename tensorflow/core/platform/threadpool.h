@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "tensorflow/core/platform/env.h"
@@ -131,6 +132,21 @@ class ThreadPool {
   // ThreadPool instance.
   explicit ThreadPool(thread::ThreadPoolInterface* user_threadpool);
 
+  // Constructs one pool per NUMA node, with the threads of each pool pinned
+  // to its node. "num_threads" is split evenly across the nodes (each pool
+  // gets at least one thread). Work scheduled on a sub-pool, and first-touch
+  // page allocations made by it, stay on that node. If NUMA is not available
+  // (or the host has a single node) the result is one unpinned pool with
+  // "num_threads" threads.
+  //
+  // The numa_node field of "thread_options" is ignored; the remaining fields
+  // apply to every sub-pool.
+  //
+  // REQUIRES: num_threads > 0
+  static std::vector<std::unique_ptr<ThreadPool>> CreatePerNumaNodePools(
+      Env* env, const ThreadOptions& thread_options, const std::string& name,
+      int num_threads, bool low_latency_hint);
+
   // Waits until all scheduled work has finished and then destroy the
   // set of threads.
   ~ThreadPool();
@@ -143,6 +159,30 @@ class ThreadPool {
 
   void ScheduleWithHint(std::function<void()> fn, int start, int limit);
 
+  // Partitions the pool's threads into contiguous stealing domains. Each
+  // domain [start, limit) restricts its threads to steal work from within
+  // the domain, so a chain of tasks scheduled into one domain stays on its
+  // threads (and their shared caches) instead of bouncing across the whole
+  // pool. The domains must be disjoint, in increasing order, and cover every
+  // thread; an empty vector restores uniform stealing. Call during setup,
+  // not concurrently with Schedule. Only supported when the pool owns its
+  // threads (i.e. was not constructed from a user ThreadPoolInterface).
+  void SetStealDomains(
+      const std::vector<std::pair<unsigned, unsigned>>& domains);
+
+  // The number of stealing domains; 1 when SetStealDomains is not in effect.
+  int NumStealDomains() const;
+
+  // Schedules fn() on the threads of the given stealing domain. Falls back
+  // to Schedule when 'domain' is out of range or no domains are set.
+  void ScheduleInDomain(std::function<void()> fn, int domain);
+
+  // Schedules fn() in the stealing domain co-located with 'buf': the NUMA
+  // node holding buf's page selects the domain, so with one domain per node
+  // (in node order) the task runs next to its input buffer. Falls back to
+  // Schedule when the buffer's affinity is unknown or no domains are set.
+  void ScheduleForBuffer(std::function<void()> fn, const void* buf);
+
   // Returns the number of shards used by ParallelForFixedBlockSizeScheduling
   // with these parameters.
   int NumShardsUsedByFixedBlockSizeScheduling(const int64_t total,
@@ -228,6 +268,10 @@ class ThreadPool {
       const int64_t total, const int64_t block_size,
       const std::function<void(int64_t, int64_t)>& fn);
 
+  // The stealing domains set by SetStealDomains; empty when stealing is
+  // uniform across the pool.
+  std::vector<std::pair<unsigned, unsigned>> steal_domains_;
+
   // underlying_threadpool_ is the user_threadpool if user_threadpool is
   // provided in the constructor. Otherwise it is the eigen_threadpool_.
   Eigen::ThreadPoolInterface* underlying_threadpool_;
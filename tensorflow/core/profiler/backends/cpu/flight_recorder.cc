@@ -0,0 +1,133 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/backends/cpu/flight_recorder.h"
+
+#include <utility>
+
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/profiler/backends/cpu/host_tracer_utils.h"
+#include "tensorflow/core/profiler/utils/time_utils.h"
+#include "tensorflow/core/profiler/utils/xplane_schema.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+
+/*static*/ FlightRecorder* FlightRecorder::Get() {
+  static FlightRecorder* singleton = new FlightRecorder;
+  return singleton;
+}
+
+Status FlightRecorder::Start(const Options& options) {
+  if (options.trace_level < 1) {
+    return errors::InvalidArgument("trace_level must be >= 1");
+  }
+  if (options.max_events_per_thread == 0 || options.harvest_period_ms <= 0) {
+    return errors::InvalidArgument(
+        "max_events_per_thread and harvest_period_ms must be positive");
+  }
+  mutex_lock lock(mu_);
+  if (active_.load(std::memory_order_relaxed)) {
+    return errors::FailedPrecondition("FlightRecorder already started");
+  }
+  if (!TraceMeRecorder::Start(options.trace_level)) {
+    return errors::FailedPrecondition(
+        "Cannot start FlightRecorder while a profiler session is active");
+  }
+  options_ = options;
+  stop_requested_ = false;
+  history_.clear();
+  active_.store(true, std::memory_order_release);
+  harvester_.reset(Env::Default()->StartThread(
+      ThreadOptions(), "flight_recorder_harvester",
+      [this]() { HarvestLoop(); }));
+  return Status::OK();
+}
+
+Status FlightRecorder::Stop() {
+  std::unique_ptr<Thread> harvester;
+  {
+    mutex_lock lock(mu_);
+    if (!active_.load(std::memory_order_relaxed)) {
+      return errors::FailedPrecondition("FlightRecorder not started");
+    }
+    stop_requested_ = true;
+    stop_cv_.notify_all();
+    harvester = std::move(harvester_);
+  }
+  // Join outside the lock; the harvester takes mu_ to drain the queues.
+  harvester.reset();
+  TraceMeRecorder::Stop();
+  mutex_lock lock(mu_);
+  active_.store(false, std::memory_order_release);
+  history_.clear();
+  return Status::OK();
+}
+
+void FlightRecorder::Harvest() {
+  TraceMeRecorder::Events events = TraceMeRecorder::Harvest();
+  mutex_lock lock(mu_);
+  for (auto& thread_events : events) {
+    TraceMeRecorder::ThreadEvents& history =
+        history_[thread_events.thread.tid];
+    history.thread = thread_events.thread;
+    for (auto& event : thread_events.events) {
+      history.events.push_back(std::move(event));
+    }
+    // The history is a ring: beyond the budget the oldest events go first.
+    while (history.events.size() > options_.max_events_per_thread) {
+      history.events.pop_front();
+    }
+  }
+}
+
+void FlightRecorder::HarvestLoop() {
+  while (true) {
+    {
+      mutex_lock lock(mu_);
+      if (!stop_requested_) {
+        WaitForMilliseconds(&lock, &stop_cv_, options_.harvest_period_ms);
+      }
+      if (stop_requested_) return;
+    }
+    Harvest();
+  }
+}
+
+Status FlightRecorder::Snapshot(uint64 duration_ns, XSpace* space) {
+  if (!IsActive()) {
+    return errors::FailedPrecondition("FlightRecorder not started");
+  }
+  // Pick up the events recorded since the last periodic harvest.
+  Harvest();
+  const uint64 now_ns = GetCurrentTimeNanos();
+  const uint64 cutoff_ns = duration_ns < now_ns ? now_ns - duration_ns : 0;
+  TraceMeRecorder::Events events;
+  {
+    mutex_lock lock(mu_);
+    events.reserve(history_.size());
+    for (const auto& tid_and_history : history_) {
+      // Copy so the history survives the snapshot; the converter filters
+      // out events that started before the cutoff.
+      events.push_back(tid_and_history.second);
+    }
+  }
+  XPlane* plane = FindOrAddMutablePlaneWithName(space, kHostThreadsPlaneName);
+  ConvertCompleteEventsToXPlane(cutoff_ns, std::move(events), plane);
+  return Status::OK();
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
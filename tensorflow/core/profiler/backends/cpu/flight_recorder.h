@@ -0,0 +1,109 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_PROFILER_BACKENDS_CPU_FLIGHT_RECORDER_H_
+#define TENSORFLOW_CORE_PROFILER_BACKENDS_CPU_FLIGHT_RECORDER_H_
+
+#include <atomic>
+#include <memory>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/backends/cpu/traceme_recorder.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+
+namespace tensorflow {
+namespace profiler {
+
+// Keeps TraceMe recording on continuously within a fixed memory budget, so
+// that when a production incident happens the timeline leading up to it has
+// already been captured.
+//
+// While the flight recorder is active, threads keep writing TraceMe events
+// into their lock-free per-thread queues as usual; a background thread
+// periodically drains the queues into a bounded per-thread history where the
+// oldest events are overwritten. Snapshot() exports the most recent window
+// of that history into an XSpace on demand, without disturbing recording.
+//
+// The flight recorder and an ordinary profiler session both drive
+// TraceMeRecorder, so they are mutually exclusive: Start() fails while a
+// profiler session is active, and starting a session while the flight
+// recorder runs fails likewise. Stop the flight recorder before taking a
+// full trace.
+//
+// Activities recorded through TraceMe::ActivityStart/ActivityEnd lose their
+// pairing when a harvest falls between the start and the end; scoped TraceMe
+// events are always kept whole.
+class FlightRecorder {
+ public:
+  struct Options {
+    // Only TraceMes with level <= trace_level are recorded.
+    int trace_level = 2;
+    // Events retained per thread; the oldest are dropped beyond this.
+    size_t max_events_per_thread = 1 << 14;
+    // How often the per-thread queues are drained into the history. Also
+    // bounds how long the unbounded queues can grow between harvests.
+    int64_t harvest_period_ms = 500;
+  };
+
+  // Returns the process-wide flight recorder.
+  static FlightRecorder* Get();
+
+  // Starts recording with the given options.
+  Status Start(const Options& options);
+
+  // Stops recording and discards the retained history.
+  Status Stop();
+
+  // Returns whether the flight recorder is running. Racy, but cheap.
+  bool IsActive() const {
+    return active_.load(std::memory_order_acquire);
+  }
+
+  // Exports the events of the last `duration_ns` nanoseconds into the host
+  // plane of `space`. Recording continues undisturbed; events that started
+  // before the window are left out.
+  Status Snapshot(uint64 duration_ns, XSpace* space);
+
+ private:
+  FlightRecorder() = default;
+  TF_DISALLOW_COPY_AND_ASSIGN(FlightRecorder);
+
+  // Drains the per-thread queues into history_, trimming each thread's
+  // history to max_events_per_thread.
+  void Harvest();
+
+  // Body of the background harvester thread.
+  void HarvestLoop();
+
+  mutable mutex mu_;
+  condition_variable stop_cv_;
+  Options options_ TF_GUARDED_BY(mu_);
+  bool stop_requested_ TF_GUARDED_BY(mu_) = false;
+  std::atomic<bool> active_{false};
+  std::unique_ptr<Thread> harvester_ TF_GUARDED_BY(mu_);
+  // Retained events per thread id; each deque holds at most
+  // max_events_per_thread events, oldest first.
+  absl::flat_hash_map<uint32, TraceMeRecorder::ThreadEvents> history_
+      TF_GUARDED_BY(mu_);
+};
+
+}  // namespace profiler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PROFILER_BACKENDS_CPU_FLIGHT_RECORDER_H_
@@ -0,0 +1,120 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/backends/cpu/flight_recorder.h"
+
+#include <string>
+
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+#include "tensorflow/core/profiler/utils/xplane_schema.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+constexpr uint64 kOneMinuteNs = 60 * 1000 * 1000 * 1000ULL;
+
+TEST(FlightRecorderTest, SnapshotsRecentTraceMeEvents) {
+  FlightRecorder* recorder = FlightRecorder::Get();
+  EXPECT_FALSE(recorder->IsActive());
+
+  FlightRecorder::Options options;
+  TF_ASSERT_OK(recorder->Start(options));
+  EXPECT_TRUE(recorder->IsActive());
+  // A second Start is rejected while running.
+  EXPECT_FALSE(recorder->Start(options).ok());
+
+  { TraceMe traceme("hello"); }
+  { TraceMe traceme("world"); }
+
+  // The snapshot sees the events without stopping the recording.
+  XSpace space;
+  TF_ASSERT_OK(recorder->Snapshot(kOneMinuteNs, &space));
+  EXPECT_TRUE(recorder->IsActive());
+  ASSERT_EQ(space.planes_size(), 1);
+  const auto& plane = space.planes(0);
+  EXPECT_EQ(plane.name(), kHostThreadsPlaneName);
+  int num_events = 0;
+  for (const auto& line : plane.lines()) {
+    num_events += line.events_size();
+  }
+  EXPECT_EQ(num_events, 2);
+  bool found_hello = false;
+  bool found_world = false;
+  for (const auto& id_and_metadata : plane.event_metadata()) {
+    if (id_and_metadata.second.name() == "hello") found_hello = true;
+    if (id_and_metadata.second.name() == "world") found_world = true;
+  }
+  EXPECT_TRUE(found_hello);
+  EXPECT_TRUE(found_world);
+
+  // The history survives the snapshot: a later snapshot still holds the
+  // events plus anything recorded in between.
+  { TraceMe traceme("again"); }
+  XSpace space2;
+  TF_ASSERT_OK(recorder->Snapshot(kOneMinuteNs, &space2));
+  int num_events2 = 0;
+  for (const auto& line : space2.planes(0).lines()) {
+    num_events2 += line.events_size();
+  }
+  EXPECT_EQ(num_events2, 3);
+
+  TF_ASSERT_OK(recorder->Stop());
+  EXPECT_FALSE(recorder->IsActive());
+  EXPECT_FALSE(recorder->Stop().ok());
+  EXPECT_FALSE(recorder->Snapshot(kOneMinuteNs, &space).ok());
+}
+
+TEST(FlightRecorderTest, BoundsRetainedHistory) {
+  FlightRecorder* recorder = FlightRecorder::Get();
+  FlightRecorder::Options options;
+  options.max_events_per_thread = 8;
+  TF_ASSERT_OK(recorder->Start(options));
+
+  for (int i = 0; i < 100; i++) {
+    TraceMe traceme("event");
+  }
+
+  XSpace space;
+  TF_ASSERT_OK(recorder->Snapshot(kOneMinuteNs, &space));
+  TF_ASSERT_OK(recorder->Stop());
+  int num_events = 0;
+  for (const auto& line : space.planes(0).lines()) {
+    num_events += line.events_size();
+  }
+  // Only the newest max_events_per_thread events are retained.
+  EXPECT_EQ(num_events, 8);
+}
+
+TEST(FlightRecorderTest, RejectsInvalidOptions) {
+  FlightRecorder* recorder = FlightRecorder::Get();
+  FlightRecorder::Options options;
+  options.trace_level = 0;
+  EXPECT_FALSE(recorder->Start(options).ok());
+  options = FlightRecorder::Options();
+  options.max_events_per_thread = 0;
+  EXPECT_FALSE(recorder->Start(options).ok());
+  options = FlightRecorder::Options();
+  options.harvest_period_ms = 0;
+  EXPECT_FALSE(recorder->Start(options).ok());
+  EXPECT_FALSE(recorder->IsActive());
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tensorflow
@@ -0,0 +1,148 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/backends/cpu/streaming_host_tracer.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/profiler/backends/cpu/host_tracer_utils.h"
+#include "tensorflow/core/profiler/backends/cpu/traceme_recorder.h"
+#include "tensorflow/core/profiler/utils/time_utils.h"
+#include "tensorflow/core/profiler/utils/xplane_schema.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+// Converts a batch of events into an XSpace chunk holding the host-threads
+// plane. Returns an empty chunk when the batch has no complete events.
+XSpace MakeChunk(uint64 start_time_ns, TraceMeRecorder::Events&& events) {
+  XSpace chunk;
+  XPlane* plane = FindOrAddMutablePlaneWithName(&chunk, kHostThreadsPlaneName);
+  ConvertCompleteEventsToXPlane(start_time_ns, std::move(events), plane);
+  return chunk;
+}
+
+}  // namespace
+
+/*static*/ StatusOr<std::unique_ptr<StreamingHostTracer>>
+StreamingHostTracer::Start(const std::string& filepath,
+                           const Options& options) {
+  if (options.trace_level < 1) {
+    return errors::InvalidArgument("trace_level must be >= 1");
+  }
+  if (options.flush_period_ms <= 0) {
+    return errors::InvalidArgument("flush_period_ms must be positive");
+  }
+  std::unique_ptr<WritableFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewWritableFile(filepath, &file));
+  // All TraceMe captured should have a timestamp greater or equal to
+  // start_time_ns to prevent timestamp underflow in XPlane, so read the
+  // clock before TraceMeRecorder::Start.
+  const uint64 start_time_ns = GetCurrentTimeNanos();
+  if (!TraceMeRecorder::Start(options.trace_level)) {
+    return errors::FailedPrecondition(
+        "Cannot start streaming host tracer while a profiler session is "
+        "active");
+  }
+  auto tracer = absl::WrapUnique(
+      new StreamingHostTracer(std::move(file), options, start_time_ns));
+  tracer->flusher_.reset(Env::Default()->StartThread(
+      ThreadOptions(), "streaming_host_tracer_flusher",
+      [tracer_ptr = tracer.get()]() { tracer_ptr->FlushLoop(); }));
+  return tracer;
+}
+
+StreamingHostTracer::StreamingHostTracer(std::unique_ptr<WritableFile> file,
+                                         const Options& options,
+                                         uint64 start_time_ns)
+    : options_(options),
+      start_time_ns_(start_time_ns),
+      file_(std::move(file)),
+      writer_(absl::make_unique<io::RecordWriter>(file_.get())) {}
+
+StreamingHostTracer::~StreamingHostTracer() { Stop().IgnoreError(); }
+
+Status StreamingHostTracer::Flush() {
+  const XSpace chunk = MakeChunk(start_time_ns_, TraceMeRecorder::Harvest());
+  if (chunk.planes(0).lines().empty()) return Status::OK();
+  TF_RETURN_IF_ERROR(writer_->WriteRecord(chunk.SerializeAsString()));
+  return writer_->Flush();
+}
+
+void StreamingHostTracer::FlushLoop() {
+  mutex_lock lock(mu_);
+  while (!stop_requested_) {
+    WaitForMilliseconds(&lock, &stop_cv_, options_.flush_period_ms);
+    if (stop_requested_) return;
+    // Keep streaming after a write error; Stop reports the first one.
+    Status status = Flush();
+    if (write_status_.ok()) write_status_ = status;
+  }
+}
+
+Status StreamingHostTracer::Stop() {
+  {
+    mutex_lock lock(mu_);
+    if (stopped_) return write_status_;
+    stop_requested_ = true;
+    stop_cv_.notify_all();
+  }
+  // Join outside the lock; the flusher takes mu_.
+  flusher_.reset();
+  mutex_lock lock(mu_);
+  stopped_ = true;
+  // Stop recording and write the remaining events as the final chunk.
+  const XSpace chunk = MakeChunk(start_time_ns_, TraceMeRecorder::Stop());
+  if (!chunk.planes(0).lines().empty()) {
+    Status status = writer_->WriteRecord(chunk.SerializeAsString());
+    if (write_status_.ok()) write_status_ = status;
+  }
+  Status status = writer_->Close();
+  if (write_status_.ok()) write_status_ = status;
+  writer_.reset();
+  status = file_->Close();
+  if (write_status_.ok()) write_status_ = status;
+  file_.reset();
+  return write_status_;
+}
+
+/*static*/ Status StreamingHostTracer::MergeStreamedTrace(
+    Env* env, const std::string& filepath, XSpace* space) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filepath, &file));
+  io::SequentialRecordReader reader(file.get());
+  XPlane* plane = FindOrAddMutablePlaneWithName(space, kHostThreadsPlaneName);
+  tstring record;
+  while (true) {
+    Status status = reader.ReadRecord(&record);
+    if (errors::IsOutOfRange(status)) break;  // End of file.
+    TF_RETURN_IF_ERROR(status);
+    XSpace chunk;
+    if (!chunk.ParseFromArray(record.data(), record.size())) {
+      return errors::DataLoss("Failed to parse streamed XSpace chunk");
+    }
+    for (const XPlane& chunk_plane : chunk.planes()) {
+      MergePlanes(chunk_plane, plane);
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
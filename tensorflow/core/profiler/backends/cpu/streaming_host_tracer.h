@@ -0,0 +1,105 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_PROFILER_BACKENDS_CPU_STREAMING_HOST_TRACER_H_
+#define TENSORFLOW_CORE_PROFILER_BACKENDS_CPU_STREAMING_HOST_TRACER_H_
+
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/lib/io/record_writer.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+
+namespace tensorflow {
+namespace profiler {
+
+// Records TraceMe events and streams them to a file, bounding host memory
+// regardless of session length.
+//
+// An ordinary profiler session buffers every event until CollectData, so a
+// long session accumulates gigabytes of host events. A streaming tracer
+// instead drains the per-thread event queues periodically and appends each
+// batch to a TFRecord file as one serialized XSpace chunk. Memory usage is
+// bounded by the events recorded within one flush period.
+//
+// The chunks carry the host-threads plane with disjoint time ranges;
+// MergeStreamedTrace reads a streamed file back into a single XSpace.
+//
+// The streaming tracer drives TraceMeRecorder, so it is mutually exclusive
+// with a profiler session (and with the flight recorder): Start fails while
+// either is active, and vice versa. Device profilers have no incremental
+// collection; this covers the host trace, which is what grows with session
+// duration.
+class StreamingHostTracer {
+ public:
+  struct Options {
+    // Only TraceMes with level <= trace_level are recorded.
+    int trace_level = 2;
+    // How often the recorded events are appended to the file.
+    int64_t flush_period_ms = 1000;
+  };
+
+  // Starts recording and streaming to `filepath`, which is overwritten.
+  static StatusOr<std::unique_ptr<StreamingHostTracer>> Start(
+      const std::string& filepath, const Options& options);
+
+  // Stops recording if Stop was not called.
+  ~StreamingHostTracer();
+
+  // Stops recording, flushes the remaining events and closes the file.
+  // Returns the first error encountered while writing, if any.
+  Status Stop();
+
+  // Reads a streamed trace back into `space`, merging the chunks into one
+  // host-threads plane.
+  static Status MergeStreamedTrace(Env* env, const std::string& filepath,
+                                   XSpace* space);
+
+ private:
+  StreamingHostTracer(std::unique_ptr<WritableFile> file,
+                      const Options& options, uint64 start_time_ns);
+  TF_DISALLOW_COPY_AND_ASSIGN(StreamingHostTracer);
+
+  // Drains the recorded events and appends them to the file as one chunk.
+  // Does nothing when no events were recorded since the last flush.
+  Status Flush() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Body of the background flusher thread.
+  void FlushLoop();
+
+  mutex mu_;
+  condition_variable stop_cv_;
+  const Options options_;
+  // Timestamp at the start of tracing; shared by all chunks so their line
+  // timestamps agree.
+  const uint64 start_time_ns_;
+  bool stop_requested_ TF_GUARDED_BY(mu_) = false;
+  bool stopped_ TF_GUARDED_BY(mu_) = false;
+  // The first error encountered while writing; sticky.
+  Status write_status_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<WritableFile> file_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<io::RecordWriter> writer_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<Thread> flusher_;
+};
+
+}  // namespace profiler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PROFILER_BACKENDS_CPU_STREAMING_HOST_TRACER_H_
@@ -0,0 +1,109 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/backends/cpu/streaming_host_tracer.h"
+
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+#include "tensorflow/core/profiler/utils/xplane_schema.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+TEST(StreamingHostTracerTest, StreamsTraceMeEventsToFile) {
+  const std::string filepath =
+      io::JoinPath(testing::TmpDir(), "streamed_trace");
+
+  StreamingHostTracer::Options options;
+  auto tracer = StreamingHostTracer::Start(filepath, options);
+  TF_ASSERT_OK(tracer.status());
+
+  // Recording is exclusive: a second streaming tracer cannot start.
+  EXPECT_FALSE(StreamingHostTracer::Start(filepath + "_2", options).ok());
+
+  { TraceMe traceme("hello"); }
+  { TraceMe traceme("world"); }
+  TF_ASSERT_OK((*tracer)->Stop());
+
+  XSpace space;
+  TF_ASSERT_OK(StreamingHostTracer::MergeStreamedTrace(Env::Default(),
+                                                       filepath, &space));
+  ASSERT_EQ(space.planes_size(), 1);
+  const auto& plane = space.planes(0);
+  EXPECT_EQ(plane.name(), kHostThreadsPlaneName);
+  int num_events = 0;
+  for (const auto& line : plane.lines()) {
+    num_events += line.events_size();
+  }
+  EXPECT_EQ(num_events, 2);
+  bool found_hello = false;
+  bool found_world = false;
+  for (const auto& id_and_metadata : plane.event_metadata()) {
+    if (id_and_metadata.second.name() == "hello") found_hello = true;
+    if (id_and_metadata.second.name() == "world") found_world = true;
+  }
+  EXPECT_TRUE(found_hello);
+  EXPECT_TRUE(found_world);
+}
+
+TEST(StreamingHostTracerTest, MergesPeriodicallyFlushedChunks) {
+  const std::string filepath =
+      io::JoinPath(testing::TmpDir(), "streamed_trace_chunks");
+
+  StreamingHostTracer::Options options;
+  options.flush_period_ms = 10;
+  auto tracer = StreamingHostTracer::Start(filepath, options);
+  TF_ASSERT_OK(tracer.status());
+
+  // Spread events over several flush periods so the file holds multiple
+  // chunks; the merged trace must still contain every event.
+  constexpr int kNumEvents = 10;
+  for (int i = 0; i < kNumEvents; ++i) {
+    { TraceMe traceme("event"); }
+    Env::Default()->SleepForMicroseconds(5 * 1000);
+  }
+  TF_ASSERT_OK((*tracer)->Stop());
+
+  XSpace space;
+  TF_ASSERT_OK(StreamingHostTracer::MergeStreamedTrace(Env::Default(),
+                                                       filepath, &space));
+  int num_events = 0;
+  for (const auto& line : space.planes(0).lines()) {
+    num_events += line.events_size();
+  }
+  EXPECT_EQ(num_events, kNumEvents);
+}
+
+TEST(StreamingHostTracerTest, RejectsInvalidOptions) {
+  const std::string filepath =
+      io::JoinPath(testing::TmpDir(), "streamed_trace_invalid");
+  StreamingHostTracer::Options options;
+  options.trace_level = 0;
+  EXPECT_FALSE(StreamingHostTracer::Start(filepath, options).ok());
+  options = StreamingHostTracer::Options();
+  options.flush_period_ms = 0;
+  EXPECT_FALSE(StreamingHostTracer::Start(filepath, options).ok());
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tensorflow
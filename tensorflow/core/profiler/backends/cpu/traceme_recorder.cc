@@ -395,6 +395,18 @@ TraceMeRecorder::Events TraceMeRecorder::StopRecording() {
   return events;
 }
 
+TraceMeRecorder::Events TraceMeRecorder::HarvestRecording() {
+  TraceMeRecorder::Events events;
+  mutex_lock lock(mutex_);
+  // EventQueue::Consume is safe to race with Push: it only removes events
+  // that were in the queue when it was invoked, so recording can continue.
+  if (internal::g_trace_level.load(std::memory_order_acquire) !=
+      kTracingDisabled) {
+    events = Consume();
+  }
+  return events;
+}
+
 /*static*/ int64_t TraceMeRecorder::NewActivityId() {
   // Activity IDs: To avoid contention over a counter, the top 32 bits identify
   // the originating thread, the bottom 32 bits name the event within a thread.
@@ -89,6 +89,13 @@ class TraceMeRecorder {
   // Events passed to Record after Stop has started will be dropped.
   static Events Stop() { return Get()->StopRecording(); }
 
+  // Returns and removes the events recorded so far without stopping
+  // recording; returns no events when recording is inactive. A start event
+  // whose matching end has not been recorded yet is dropped, so activities
+  // spanning a harvest lose their pairing; complete events (scoped TraceMe)
+  // are unaffected.
+  static Events Harvest() { return Get()->HarvestRecording(); }
+
   // Returns whether we're currently recording. Racy, but cheap!
   static inline bool Active(int level = 1) {
     return internal::g_trace_level.load(std::memory_order_acquire) >= level;
@@ -119,6 +126,7 @@ class TraceMeRecorder {
 
   bool StartRecording(int level);
   Events StopRecording();
+  Events HarvestRecording();
 
   // Clears events from all active threads that were added due to Record
   // racing with StopRecording.
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "tensorflow/core/runtime_fallback/runtime/runtime_fallback_kernels.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_split.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
@@ -30,6 +31,7 @@ limitations under the License.
 #include "tensorflow/c/tf_tensor_internal.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/common_runtime/eager/attr_builder.h"
 #include "tensorflow/core/common_runtime/eager/context.h"
 #include "tensorflow/core/common_runtime/eager/eager_operation.h"
 #include "tensorflow/core/common_runtime/eager/tensor_handle.h"
@@ -549,7 +551,8 @@ Status CallEagerExecute(const tfrt::ExecutionContext& exec_ctx,
                         llvm::ArrayRef<TensorHandle*> input_tensor_handles,
                         const OpAttrsRef& attrs,
                         llvm::MutableArrayRef<tensorflow::AbstractTensorHandle*>
-                            result_tensor_handles) {
+                            result_tensor_handles,
+                        const AttrBuilder* cached_eager_attrs) {
   assert(eager_ctx != nullptr && "EagerContext is NULL");
 
   // Create TF EagerOperation.
@@ -561,9 +564,16 @@ Status CallEagerExecute(const tfrt::ExecutionContext& exec_ctx,
     TF_RETURN_IF_ERROR(eager_op->AddInput(input_tensor));
   }
 
-  // Handle attributes.
-  auto* host = exec_ctx.host();
-  TF_RETURN_IF_ERROR(PrepareAttributes(eager_op.get(), attrs, host, eager_ctx));
+  // Handle attributes. If the attributes for this call site were already
+  // converted by a previous invocation, transfer them instead of converting
+  // `attrs` again.
+  if (cached_eager_attrs != nullptr) {
+    eager_op->MutableAttrs()->CopyAttributes(*cached_eager_attrs);
+  } else {
+    auto* host = exec_ctx.host();
+    TF_RETURN_IF_ERROR(
+        PrepareAttributes(eager_op.get(), attrs, host, eager_ctx));
+  }
 
   int num_retvals = result_tensor_handles.size();
   TF_RETURN_IF_ERROR(eager_op->Execute(
@@ -584,7 +594,8 @@ AsyncValueRef<Chain> RuntimeFallbackExecute(
     const tfrt::ExecutionContext& exec_ctx, EagerContext* eager_ctx,
     const char* op_name, const char* device_name,
     llvm::ArrayRef<Tensor*> arguments, const OpAttrsRef& attrs,
-    llvm::MutableArrayRef<RCReference<AsyncValue>> results) {
+    llvm::MutableArrayRef<RCReference<AsyncValue>> results,
+    const AttrBuilder* cached_eager_attrs = nullptr) {
   auto emit_error = [&exec_ctx, results](const tensorflow::Status& status) {
     // Set the correct TFRT error code according to the error propagated from
     // runtime fallback execution.
@@ -608,15 +619,16 @@ AsyncValueRef<Chain> RuntimeFallbackExecute(
       num_retvals);
   Status status;
   if (!ShouldAddHostContextAttr(op_name)) {
-    status =
-        CallEagerExecute(exec_ctx, eager_ctx, op_name, device_name,
-                         input_tensor_handles, attrs, result_tensor_handles);
+    status = CallEagerExecute(exec_ctx, eager_ctx, op_name, device_name,
+                              input_tensor_handles, attrs,
+                              result_tensor_handles, cached_eager_attrs);
   } else {
     // Wrap the HostContext pointer in an attribute. This is necessary for
     // TF ops that require the TFRT HostContext to function. These kernels
     // should not create their own HostContexts.
     // TODO(rachelim): Support copying over non-host_ptr attrs, if there are
-    // any.
+    // any. Note that `cached_eager_attrs` does not apply here since the
+    // attributes are rewritten below.
     assert(attrs.GetNumEntries() == 1);
     OpAttrs updated;
 
@@ -1071,6 +1083,74 @@ tfrt::Chain PrintFallbackTensor(
   return tfrt::Chain();
 }
 
+namespace {
+
+constexpr char kOpAttrsCacheResourceName[] =
+    "RuntimeFallbackOpAttrsCacheResource";
+
+// Per-call-site cache of attribute conversion results used by
+// RuntimeFallbackExecuteOp. Both the tfrt::OpAttrs set up from the BEF
+// attributes and the EagerOperation attributes prepared from them only depend
+// on the call site, so they are converted at most once per call site. BEF
+// attributes are immutable and stay addressable for the lifetime of the loaded
+// program, and the cache lives in the ResourceContext, which does not outlive
+// the program either, so entries are keyed by the address of the BEF attribute
+// data without risk of dangling or aliasing.
+class RuntimeFallbackOpAttrsCache {
+ public:
+  struct Entry {
+    // The tfrt attributes set up from the call site's BEF attributes.
+    OpAttrsRef attrs;
+    // The corresponding EagerOperation attributes, pre-converted so that
+    // steady-state execution skips PrepareAttributes. Null if the conversion
+    // failed; the error is then reported by the regular per-invocation
+    // conversion. Read-only once published.
+    std::unique_ptr<AttrBuilder> eager_attrs;
+  };
+
+  // Returns the entry for the call site identified by the pair of BEF
+  // attribute arrays, converting the attributes on the first call.
+  const Entry& GetOrCreate(tfrt::string_view op_name,
+                           AggregateAttr op_attr_array,
+                           AggregateAttr op_func_attr_array,
+                           EagerContext* eager_ctx, HostContext* host) {
+    std::pair<const void*, const void*> key(op_attr_array.data(),
+                                            op_func_attr_array.data());
+    absl::MutexLock lock(&mu_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) return *it->second;
+
+    OpAttrs op_attrs;
+    tfrt::SetUpOpAttrs(op_attr_array, &op_attrs);
+    tfrt::SetUpOpFuncAttrs(op_func_attr_array, &op_attrs);
+    auto entry = std::make_unique<Entry>(Entry{op_attrs.freeze(), nullptr});
+
+    // Prepare the EagerOperation attributes once using a scratch operation,
+    // and keep a copy of the resulting AttrBuilder for later invocations.
+    std::string op_name_str = op_name.str();
+    OwnedEagerOperation scratch_op{new EagerOperation(eager_ctx)};
+    Status status =
+        scratch_op->Reset(op_name_str.c_str(), /*raw_device_name=*/nullptr);
+    if (status.ok()) {
+      status =
+          PrepareAttributes(scratch_op.get(), entry->attrs, host, eager_ctx);
+    }
+    if (status.ok()) {
+      entry->eager_attrs = std::make_unique<AttrBuilder>(op_name_str.c_str());
+      entry->eager_attrs->CopyAttributes(scratch_op->Attrs());
+    }
+    return *entries_.emplace(key, std::move(entry)).first->second;
+  }
+
+ private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<std::pair<const void*, const void*>,
+                      std::unique_ptr<Entry>>
+      entries_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace
+
 // The legacy kernel implementation that dispatches runtime fallback operations.
 // Since the arguments and results are tensorflow::Tensors, internally it
 // does conversions between RuntimeFallbackTensor and tensorflow::Tensor.
@@ -1098,13 +1178,6 @@ static void RuntimeFallbackExecuteOp(
 
   auto* host = exec_ctx.host();
 
-  // Set up OpAttrs.
-  tfrt::OpAttrs op_attrs;
-  tfrt::SetUpOpAttrs(op_attr_array, &op_attrs);
-
-  // Set up OpAttrs specifically for function attributes.
-  tfrt::SetUpOpFuncAttrs(op_func_attr_array, &op_attrs);
-
   // Get EagerContext.
   auto eager_ctx_expected = GetEagerContext(exec_ctx);
   if (!eager_ctx_expected) {
@@ -1113,6 +1186,17 @@ static void RuntimeFallbackExecuteOp(
   }
   EagerContext* eager_ctx = eager_ctx_expected.get();
 
+  // Set up OpAttrs, including OpAttrs specifically for function attributes.
+  // The conversion result only depends on the call site, so it is cached and
+  // reused by subsequent invocations.
+  auto* attrs_cache =
+      exec_ctx.resource_context()
+          ->GetOrCreateResource<RuntimeFallbackOpAttrsCache>(
+              kOpAttrsCacheResourceName);
+  const RuntimeFallbackOpAttrsCache::Entry& attrs_entry =
+      attrs_cache->GetOrCreate(op_name, op_attr_array, op_func_attr_array,
+                               eager_ctx, host);
+
   // Get device.
   Device* device = nullptr;
   Status s = eager_ctx->local_device_mgr()->LookupDevice(device_name, &device);
@@ -1144,8 +1228,9 @@ static void RuntimeFallbackExecuteOp(
   tfrt_tensor_results.resize(results.size());
 
   auto chain = RuntimeFallbackExecute(
-      exec_ctx, op_name.str().c_str(), device_name.c_str(),
-      tfrt_tensor_arg_ptrs, tfrt::OpAttrsRef(op_attrs), tfrt_tensor_results);
+      exec_ctx, eager_ctx, op_name.str().c_str(), device_name.c_str(),
+      tfrt_tensor_arg_ptrs, attrs_entry.attrs, tfrt_tensor_results,
+      attrs_entry.eager_attrs.get());
 
   if (op_chain) *op_chain = chain.CopyRef();
 
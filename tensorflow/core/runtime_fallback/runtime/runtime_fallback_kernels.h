@@ -39,14 +39,17 @@ namespace tfd {
 Status InjectTfGpuResources();
 
 // Create an EagerOperation to run the op, taking tensorflow::TensorHandle and
-// returning tensorflow::AbstractTensorHandle*.
+// returning tensorflow::AbstractTensorHandle*. If `cached_eager_attrs` is
+// non-null, it holds the pre-converted equivalent of `attrs` and is used
+// instead of converting `attrs` again.
 Status CallEagerExecute(const tfrt::ExecutionContext& exec_ctx,
                         EagerContext* eager_ctx, const char* op_name,
                         const char* device_name,
                         llvm::ArrayRef<TensorHandle*> input_tensor_handles,
                         const tfrt::OpAttrsRef& attrs,
                         llvm::MutableArrayRef<tensorflow::AbstractTensorHandle*>
-                            result_tensor_handles);
+                            result_tensor_handles,
+                        const AttrBuilder* cached_eager_attrs = nullptr);
 
 // Take and return RuntimeFallbackTensors.
 tfrt::AsyncValueRef<tfrt::Chain> RuntimeFallbackExecute(
@@ -14,6 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/summary/summary_file_writer.h"
 
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <utility>
+
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -22,6 +27,8 @@ limitations under the License.
 #include "tensorflow/core/framework/summary.pb.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/summary/summary_converter.h"
 #include "tensorflow/core/util/events_writer.h"
 #include "tensorflow/core/util/ptr_util.h"
@@ -29,6 +36,18 @@ limitations under the License.
 namespace tensorflow {
 namespace {
 
+// Upper bound on the bytes of serialized events the writer thread may have
+// queued before WriteEvent blocks. Keeps a training thread from racing
+// arbitrarily far ahead of the disk.
+constexpr int64_t kMaxQueuedBytes = 32 << 20;  // 32MiB
+
+// Events are written to the file by a background thread so serialization and
+// file appends never run on the caller's thread; WriteEvent only moves the
+// event into a queue. The thread batches whatever has accumulated since its
+// last pass and flushes the file when Flush() asks for it, when `max_queue`
+// events have been written since the last flush, or when `flush_millis` has
+// elapsed. Errors from the thread surface on the next WriteEvent or Flush
+// call.
 class SummaryFileWriter : public SummaryWriterInterface {
  public:
   SummaryFileWriter(int max_queue, int flush_millis, Env* env)
@@ -62,6 +81,9 @@ class SummaryFileWriter : public SummaryWriterInterface {
         "Could not initialize events writer.");
     last_flush_ = env_->NowMicros();
     is_initialized_ = true;
+    // From here on `events_writer_` is owned by the writer thread.
+    writer_thread_.reset(env_->StartThread(
+        ThreadOptions(), "summary_file_writer", [this] { WriterThread(); }));
     return Status::OK();
   }
 
@@ -70,11 +92,30 @@ class SummaryFileWriter : public SummaryWriterInterface {
     if (!is_initialized_) {
       return errors::FailedPrecondition("Class was not properly initialized.");
     }
-    return InternalFlush();
+    const int64_t target = enqueued_events_;
+    flush_requested_ = true;
+    work_cv_.notify_one();
+    // Wait until every event enqueued before this call is on disk.
+    while (flush_requested_ || flushed_events_ < target) {
+      drained_cv_.wait(ml);
+    }
+    Status status = writer_status_;
+    writer_status_ = Status::OK();
+    return status;
   }
 
   ~SummaryFileWriter() override {
-    (void)Flush();  // Ignore errors.
+    if (writer_thread_ != nullptr) {
+      {
+        mutex_lock ml(mu_);
+        exiting_ = true;
+        flush_requested_ = true;
+        work_cv_.notify_one();
+      }
+      // Joining drains the queue and flushes the file. Errors are ignored,
+      // like the old synchronous destructor's flush.
+      writer_thread_.reset();
+    }
   }
 
   Status WriteTensor(int64_t global_step, Tensor t, const string& tag,
@@ -150,13 +191,21 @@ class SummaryFileWriter : public SummaryWriterInterface {
   }
 
   Status WriteEvent(std::unique_ptr<Event> event) override {
+    const int64_t event_bytes = event->ByteSizeLong();
     mutex_lock ml(mu_);
-    queue_.emplace_back(std::move(event));
-    if (queue_.size() > max_queue_ ||
-        env_->NowMicros() - last_flush_ > 1000 * flush_millis_) {
-      return InternalFlush();
+    // Back-pressure: block while the queued events exceed the byte budget.
+    // At least one event is always admitted, so an event larger than the
+    // whole budget still goes through.
+    while (!queue_.empty() && queued_bytes_ + event_bytes > kMaxQueuedBytes) {
+      drained_cv_.wait(ml);
     }
-    return Status::OK();
+    queue_.emplace_back(std::move(event));
+    queued_bytes_ += event_bytes;
+    ++enqueued_events_;
+    work_cv_.notify_one();
+    Status status = writer_status_;
+    writer_status_ = Status::OK();
+    return status;
   }
 
   string DebugString() const override { return "SummaryFileWriter"; }
@@ -166,26 +215,93 @@ class SummaryFileWriter : public SummaryWriterInterface {
     return static_cast<double>(env_->NowMicros()) / 1.0e6;
   }
 
-  Status InternalFlush() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    for (const std::unique_ptr<Event>& e : queue_) {
-      events_writer_->WriteEvent(*e);
+  // Returns true if events written since the last file flush have been
+  // sitting longer than the flush interval.
+  bool FlushDeadlinePassed() const {
+    return unflushed_events_ > 0 &&
+           env_->NowMicros() - last_flush_ > 1000 * flush_millis_;
+  }
+
+  // Body of the writer thread: repeatedly moves the queued events out in one
+  // batch, appends them to the events file with the lock dropped, and flushes
+  // the file when requested, when `max_queue_` events have accumulated in it,
+  // or when the flush interval elapses.
+  void WriterThread() {
+    while (true) {
+      std::deque<std::unique_ptr<Event>> batch;
+      bool flush_now;
+      {
+        mutex_lock ml(mu_);
+        while (!exiting_ && !flush_requested_ && queue_.empty() &&
+               !FlushDeadlinePassed()) {
+          WaitForMilliseconds(&ml, &work_cv_, std::max(flush_millis_, 1));
+        }
+        if (exiting_ && queue_.empty() && !flush_requested_) break;
+        batch.swap(queue_);
+        queued_bytes_ = 0;
+        flush_now = flush_requested_;
+        // Unblock producers waiting on the byte budget before doing file
+        // I/O; they only need queue space, not the batch on disk.
+        drained_cv_.notify_all();
+      }
+
+      Status status;
+      for (const std::unique_ptr<Event>& e : batch) {
+        events_writer_->WriteEvent(*e);
+      }
+      written_events_ += batch.size();
+      unflushed_events_ += batch.size();
+      bool did_flush = false;
+      if (flush_now || unflushed_events_ > max_queue_ ||
+          FlushDeadlinePassed()) {
+        Status flush_status = events_writer_->Flush();
+        if (!flush_status.ok()) {
+          status.Update(errors::Internal("Could not flush events file: ",
+                                         flush_status.error_message()));
+        }
+        last_flush_ = env_->NowMicros();
+        unflushed_events_ = 0;
+        did_flush = true;
+      }
+
+      mutex_lock ml(mu_);
+      if (did_flush) {
+        flushed_events_ = written_events_;
+        // Keep the flush request alive until the queue has fully drained, so
+        // a Flush() that raced with this batch still gets its events out.
+        if (queue_.empty()) flush_requested_ = false;
+      }
+      writer_status_.Update(status);
+      drained_cv_.notify_all();
     }
-    queue_.clear();
-    TF_RETURN_WITH_CONTEXT_IF_ERROR(events_writer_->Flush(),
-                                    "Could not flush events file.");
-    last_flush_ = env_->NowMicros();
-    return Status::OK();
   }
 
-  bool is_initialized_;
+  bool is_initialized_ TF_GUARDED_BY(mu_);
   const int max_queue_;
   const int flush_millis_;
-  uint64 last_flush_;
   Env* env_;
   mutex mu_;
-  std::vector<std::unique_ptr<Event>> queue_ TF_GUARDED_BY(mu_);
+  condition_variable work_cv_;     // Signaled when events or requests arrive.
+  condition_variable drained_cv_;  // Signaled when the queue empties.
+  std::deque<std::unique_ptr<Event>> queue_ TF_GUARDED_BY(mu_);
+  int64_t queued_bytes_ TF_GUARDED_BY(mu_) = 0;
+  int64_t enqueued_events_ TF_GUARDED_BY(mu_) = 0;
+  // Count of events the writer thread has flushed to disk; used by Flush()
+  // to wait for the events that preceded it.
+  int64_t flushed_events_ TF_GUARDED_BY(mu_) = 0;
+  bool flush_requested_ TF_GUARDED_BY(mu_) = false;
+  bool exiting_ TF_GUARDED_BY(mu_) = false;
+  // First error from the writer thread; returned (and reset) by the next
+  // WriteEvent or Flush call.
+  Status writer_status_ TF_GUARDED_BY(mu_);
+  // The members below are only accessed by the writer thread (and by
+  // Initialize before it starts).
+  uint64 last_flush_;
+  int64_t written_events_ = 0;
+  int64_t unflushed_events_ = 0;
   // A pointer to allow deferred construction.
-  std::unique_ptr<EventsWriter> events_writer_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<EventsWriter> events_writer_;
+  std::unique_ptr<Thread> writer_thread_;
   std::vector<std::pair<string, SummaryMetadata>> registered_summaries_
       TF_GUARDED_BY(mu_);
 };
@@ -16,8 +16,13 @@ limitations under the License.
 #include "tensorflow/core/tpu/kernels/infeed_ops.h"
 
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/compiler/jit/xla_device.h"
 #include "tensorflow/compiler/tf2xla/literal_util.h"
 #include "tensorflow/compiler/tf2xla/shape_util.h"
@@ -35,10 +40,14 @@ limitations under the License.
 #include "tensorflow/core/framework/variant_encode_decode.h"
 #include "tensorflow/core/framework/variant_tensor_data.h"
 #include "tensorflow/core/kernels/transpose_functor.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/tpu/kernels/transfer_ops.h"
 #include "tensorflow/core/tpu/tpu_api.h"
 #include "tensorflow/core/tpu/tpu_defs.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/stream_executor/tpu/c_api_conversions.h"
 #include "tensorflow/stream_executor/multi_platform_manager.h"
 #include "tensorflow/stream_executor/tpu/tpu_transfer_manager.h"
@@ -53,8 +62,19 @@ typedef std::deque<LinearizerBuffer> LinearizerBufferList;
 
 // For the given shape, chooses a layout for infeed on TPU. The returned shape
 // has the same dimensions as the original shape, and only the layout is
-// changed.
+// changed. The layout query crosses the C API into the TPU driver, so the
+// result is cached per shape signature: input pipelines construct many enqueue
+// ops for the same handful of shapes.
 xla::Shape GetTPUInfeedLayout(const xla::Shape& shape) {
+  static mutex* mu = new mutex;
+  static auto* cache = new absl::flat_hash_map<std::string, xla::Shape>;
+  const std::string key = shape.ToString(/*print_layout=*/true);
+  {
+    mutex_lock l(*mu);
+    auto it = cache->find(key);
+    if (it != cache->end()) return it->second;
+  }
+
   XLA_Shape c_shape;
   XLA_Shape c_infeed_shape;
 
@@ -65,7 +85,9 @@ xla::Shape GetTPUInfeedLayout(const xla::Shape& shape) {
   xla::Shape infeed_shape = ApiConverter::FromC(&c_infeed_shape);
   ApiConverter::Destroy(&c_shape);
   ApiConverter::Destroy(&c_infeed_shape);
-  return infeed_shape;
+
+  mutex_lock l(*mu);
+  return cache->emplace(key, infeed_shape).first->second;
 }
 
 // Transposes the given tensor using the tensorflow C++ transpose implementation
@@ -235,6 +257,124 @@ Status AutoTransposeAndLinearize(OpKernelContext* ctx,
   return OkStatus();
 }
 
+// Double buffers the infeed enqueue path. Each TPU device gets a pipeline
+// with a single staging thread that transfers the most recently linearized
+// batch, so the op's thread can linearize batch t+1 while batch t is still
+// transferring. A transfer error surfaces on the next enqueue for the same
+// device.
+//
+// The pipeline is off by default; set TF_TPU_INFEED_STAGING=1 to enable it.
+// Note that with staging enabled the enqueue op completes before its batch
+// has reached the device. This is safe for the device (it blocks until infeed
+// data arrives) but defers transfer error reporting by one step.
+class InfeedStagingPipeline {
+ public:
+  explicit InfeedStagingPipeline(int device_ordinal)
+      : device_ordinal_(device_ordinal),
+        thread_pool_(Env::Default(),
+                     strings::StrCat("infeed_staging_", device_ordinal),
+                     /*num_threads=*/1) {}
+
+  static bool Enabled() {
+    static bool enabled = [] {
+      bool value = false;
+      TF_CHECK_OK(
+          ReadBoolFromEnvVar("TF_TPU_INFEED_STAGING", false, &value));
+      return value;
+    }();
+    return enabled;
+  }
+
+  static InfeedStagingPipeline* GetForOrdinal(int device_ordinal) {
+    mutex_lock l(*registry_mu_);
+    auto& pipeline = (*registry_)[device_ordinal];
+    if (pipeline == nullptr) {
+      pipeline = absl::make_unique<InfeedStagingPipeline>(device_ordinal);
+    }
+    return pipeline.get();
+  }
+
+  // Waits for every pipeline's in-flight transfer to finish. Called from
+  // enqueue op destructors so a staged transfer never outlives the
+  // TpuTransferOpInterface it was handed.
+  static void DrainAll() {
+    mutex_lock l(*registry_mu_);
+    for (auto& it : *registry_) {
+      Status status = it.second->WaitForPreviousTransfer();
+      if (!status.ok()) {
+        LOG(WARNING) << "Staged infeed transfer for device " << it.first
+                     << " failed: " << status;
+      }
+    }
+  }
+
+  // Blocks until the previously staged batch (if any) has transferred, and
+  // returns its status. An error is reported exactly once.
+  Status WaitForPreviousTransfer() {
+    mutex_lock l(mu_);
+    while (transfer_in_flight_) {
+      cv_.wait(l);
+    }
+    Status status = last_status_;
+    last_status_ = OkStatus();
+    return status;
+  }
+
+  // Hands a linearized batch to the staging thread, which transfers it to the
+  // device infeed queue. `tensors` holds references on input tensors whose
+  // storage the buffers share; they are released after the transfer.
+  // The caller must have observed WaitForPreviousTransfer() since the last
+  // staged batch.
+  void StageTransfer(TpuTransferOpInterface* transfer_op,
+                     LinearizerBufferList buffers,
+                     std::vector<Tensor> tensors) {
+    struct Batch {
+      LinearizerBufferList buffers;
+      std::vector<Tensor> tensors;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->buffers = std::move(buffers);
+    batch->tensors = std::move(tensors);
+    {
+      mutex_lock l(mu_);
+      DCHECK(!transfer_in_flight_);
+      transfer_in_flight_ = true;
+    }
+    thread_pool_.Schedule([this, transfer_op, batch]() {
+      profiler::TraceMe trace_me("InfeedStagingPipeline::Transfer",
+                                 /*level=*/2);
+      Status status =
+          transfer_op->TransferBuffersToInfeed(device_ordinal_, batch->buffers);
+      mutex_lock l(mu_);
+      last_status_ = status;
+      transfer_in_flight_ = false;
+      cv_.notify_all();
+    });
+  }
+
+ private:
+  static mutex* const registry_mu_;
+  static absl::flat_hash_map<int, std::unique_ptr<InfeedStagingPipeline>>* const
+      registry_;
+
+  const int device_ordinal_;
+  thread::ThreadPool thread_pool_;
+
+  mutex mu_;
+  condition_variable cv_;
+  bool transfer_in_flight_ TF_GUARDED_BY(mu_) = false;
+  Status last_status_ TF_GUARDED_BY(mu_);
+
+  // InfeedStagingPipeline is neither copyable nor movable.
+  InfeedStagingPipeline(const InfeedStagingPipeline&) = delete;
+  InfeedStagingPipeline& operator=(const InfeedStagingPipeline&) = delete;
+};
+
+mutex* const InfeedStagingPipeline::registry_mu_ = new mutex;
+absl::flat_hash_map<int, std::unique_ptr<InfeedStagingPipeline>>* const
+    InfeedStagingPipeline::registry_ =
+        new absl::flat_hash_map<int, std::unique_ptr<InfeedStagingPipeline>>;
+
 // PrelinearizeOp is used to linearize one tensor to the device format.
 class PrelinearizeOp : public OpKernel {
  public:
@@ -444,6 +584,22 @@ Status TpuInfeedEnqueueOp::DoWork(OpKernelContext* ctx, int device_ordinal) {
                                    input_tensor.shape().DebugString());
   }
 
+  if (InfeedStagingPipeline::Enabled()) {
+    InfeedStagingPipeline* pipeline =
+        InfeedStagingPipeline::GetForOrdinal(device_ordinal);
+    // Linearize this batch while the previous one is still transferring.
+    LinearizerBufferList linearized_buffers;
+    std::vector<Tensor> saved_input_tensors;
+    TF_RETURN_IF_ERROR(AutoTransposeAndLinearize(ctx, input_tensor, xla_shape_,
+                                                 &linearized_buffers,
+                                                 &saved_input_tensors));
+    // Surface the previous batch's transfer error, if any, before staging.
+    TF_RETURN_IF_ERROR(pipeline->WaitForPreviousTransfer());
+    pipeline->StageTransfer(transfer_op_.get(), std::move(linearized_buffers),
+                            std::move(saved_input_tensors));
+    return OkStatus();
+  }
+
   const Tensor* tensor = &input_tensor;
   Tensor transposed_tensor;
   if (!xla::LayoutUtil::IsMonotonicWithDim0Major(xla_shape_.layout())) {
@@ -464,6 +620,12 @@ Status TpuInfeedEnqueueOp::DoWork(OpKernelContext* ctx, int device_ordinal) {
   return OkStatus();
 }
 
+TpuInfeedEnqueueOp::~TpuInfeedEnqueueOp() {
+  // A staged transfer holds a pointer to this op's TpuTransferOpInterface;
+  // make sure none is in flight before it goes away.
+  if (InfeedStagingPipeline::Enabled()) InfeedStagingPipeline::DrainAll();
+}
+
 TpuInfeedEnqueueTupleOp::TpuInfeedEnqueueTupleOp(
     OpKernelConstruction* ctx,
     std::unique_ptr<TpuTransferOpInterface> transfer_op)
@@ -503,6 +665,42 @@ Status TpuInfeedEnqueueTupleOp::DoWork(OpKernelContext* ctx,
     VLOG(2) << "TransferLiteralToInfeed " << shapes.DebugString();
   }
 
+  if (InfeedStagingPipeline::Enabled()) {
+    InfeedStagingPipeline* pipeline =
+        InfeedStagingPipeline::GetForOrdinal(device_ordinal);
+    // Linearize this batch while the previous one is still transferring.
+    LinearizerBufferList all_linearized_buffers;
+    std::vector<Tensor> all_saved_input_tensors;
+    for (int i = 0; i < values.size(); i++) {
+      const Tensor& input_tensor = values[i];
+      if (input_tensor.shape() != shapes_[i]) {
+        return errors::InvalidArgument(
+            "Infeed shape mismatch for tuple element ", i, "; expected ",
+            shapes_[i].DebugString(), ", got ",
+            input_tensor.shape().DebugString());
+      }
+      LinearizerBufferList linearized_buffers;
+      std::vector<Tensor> saved_input_tensors;
+      TF_RETURN_IF_ERROR(AutoTransposeAndLinearize(
+          ctx, input_tensor, tuple_shape_.tuple_shapes(i), &linearized_buffers,
+          &saved_input_tensors));
+      all_linearized_buffers.insert(
+          all_linearized_buffers.end(),
+          std::make_move_iterator(linearized_buffers.begin()),
+          std::make_move_iterator(linearized_buffers.end()));
+      all_saved_input_tensors.insert(
+          all_saved_input_tensors.end(),
+          std::make_move_iterator(saved_input_tensors.begin()),
+          std::make_move_iterator(saved_input_tensors.end()));
+    }
+    // Surface the previous batch's transfer error, if any, before staging.
+    TF_RETURN_IF_ERROR(pipeline->WaitForPreviousTransfer());
+    pipeline->StageTransfer(transfer_op_.get(),
+                            std::move(all_linearized_buffers),
+                            std::move(all_saved_input_tensors));
+    return OkStatus();
+  }
+
   std::vector<Tensor> maybe_transposed_tensors;
   maybe_transposed_tensors.reserve(values.size());
   for (int i = 0; i < values.size(); i++) {
@@ -540,6 +738,12 @@ Status TpuInfeedEnqueueTupleOp::DoWork(OpKernelContext* ctx,
   return OkStatus();
 }
 
+TpuInfeedEnqueueTupleOp::~TpuInfeedEnqueueTupleOp() {
+  // A staged transfer holds a pointer to this op's TpuTransferOpInterface;
+  // make sure none is in flight before it goes away.
+  if (InfeedStagingPipeline::Enabled()) InfeedStagingPipeline::DrainAll();
+}
+
 InfeedEnqueuePrelinearizedBufferOp::InfeedEnqueuePrelinearizedBufferOp(
     OpKernelConstruction* ctx,
     std::unique_ptr<TpuTransferOpInterface> transfer_op)
@@ -33,6 +33,7 @@ class TpuInfeedEnqueueOp : public TpuTransferAsyncOpKernel {
   explicit TpuInfeedEnqueueOp(
       OpKernelConstruction* ctx,
       std::unique_ptr<TpuTransferOpInterface> transfer_op);
+  ~TpuInfeedEnqueueOp() override;
   Status DoWork(OpKernelContext* ctx, int device_ordinal) override;
 
  private:
@@ -52,6 +53,7 @@ class TpuInfeedEnqueueTupleOp : public TpuTransferAsyncOpKernel {
   explicit TpuInfeedEnqueueTupleOp(
       OpKernelConstruction* ctx,
       std::unique_ptr<TpuTransferOpInterface> transfer_op);
+  ~TpuInfeedEnqueueTupleOp() override;
   Status DoWork(OpKernelContext* ctx, int device_ordinal) override;
 
  private:
@@ -826,6 +826,9 @@ class AssignVariableXlaConcatNDOp : public XlaConcatNDBaseOp<Device, T, true> {
                                                       return OkStatus();
                                                     }));
     mutex_lock ml(*variable->mu());
+    // Drop any published read snapshot before the RefCountIsOne check below;
+    // the snapshot holds a reference to the buffer.
+    variable->InvalidateSnapshot();
 
     OP_REQUIRES(ctx, variable->tensor()->dtype() == dtype_,
                 CreateResourceInvalidDTypeError<false>(
@@ -113,6 +113,7 @@ Status TPUReshardVariablesOpKernel::DoWork(OpKernelContext* context) {
   }
 
   // Change the state.
+  format_state_var->InvalidateSnapshot();
   *format_state_var->tensor() = *new_format_key;
   format_state_var->is_initialized = true;
   return OkStatus();
@@ -0,0 +1,172 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/util/autotune_maps/autotune_persistence.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/autotune_maps/autotune_maps_utils.h"
+#include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
+#include "tensorflow/core/util/autotune_maps/conv_parameters.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+namespace {
+
+// Returns the cache file name for this process. The name is keyed by the set
+// of GPU models present and the autotune result version (the TF version
+// stands in for the cuDNN/cuBLAS versions it was built against), so that
+// machines with different hardware or incompatible software write to
+// separate files and never see each other's results.
+std::string AutotuneCacheFileName() {
+  std::vector<std::string> device_identifiers =
+      autotune_maps_utils::GetDeviceIdToIdentifierMap();
+  std::sort(device_identifiers.begin(), device_identifiers.end());
+  device_identifiers.erase(
+      std::unique(device_identifiers.begin(), device_identifiers.end()),
+      device_identifiers.end());
+  uint64 key = Hash64(TF_VERSION_STRING);
+  key = Hash64Combine(key, ConvParameters::kVersion);
+  for (const std::string& device_identifier : device_identifiers) {
+    key = Hash64Combine(key, Hash64(device_identifier));
+  }
+  return strings::StrCat("tf_autotune_cache_", key, ".pb");
+}
+
+// Loads the cache file into the runtime autotune maps once at startup and
+// periodically saves newly discovered entries back.
+class AutotunePersistenceManager {
+ public:
+  static AutotunePersistenceManager* GetInstance() {
+    static AutotunePersistenceManager* instance =
+        new AutotunePersistenceManager;
+    return instance;
+  }
+
+  Status Start(const std::string& path, int64_t save_interval_secs) {
+    mutex_lock lock(mu_);
+    if (thread_ != nullptr) {
+      return Status::OK();
+    }
+    path_ = path;
+    save_interval_secs_ = save_interval_secs;
+    Status load_status = LoadFromFile();
+    if (load_status.ok()) {
+      LOG(INFO) << "Loaded autotune results from " << path_;
+    } else if (!errors::IsNotFound(load_status)) {
+      // A stale or corrupt cache file is not fatal; autotuning proceeds as
+      // usual and the file is overwritten by the background thread.
+      LOG(WARNING) << "Failed to load autotune results from " << path_ << ": "
+                   << load_status;
+    }
+    TF_RETURN_IF_ERROR(SerializeAutotuneMaps(&last_saved_));
+    thread_.reset(Env::Default()->StartThread(
+        ThreadOptions(), "autotune_cache_saver", [this]() { SaveLoop(); }));
+    return Status::OK();
+  }
+
+ private:
+  Status LoadFromFile() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    std::string data;
+    TF_RETURN_IF_ERROR(ReadFileToString(Env::Default(), path_, &data));
+    return LoadSerializedAutotuneMaps(data);
+  }
+
+  Status SaveIfChanged() {
+    mutex_lock lock(mu_);
+    std::string serialized;
+    TF_RETURN_IF_ERROR(SerializeAutotuneMaps(&serialized));
+    if (serialized == last_saved_) {
+      return Status::OK();
+    }
+    // Merge in entries that other processes may have saved since we last read
+    // the file, so that concurrent processes converge on the union of their
+    // results instead of overwriting each other.
+    std::string on_disk;
+    if (ReadFileToString(Env::Default(), path_, &on_disk).ok() &&
+        on_disk != last_saved_) {
+      LoadSerializedAutotuneMaps(on_disk).IgnoreError();
+      TF_RETURN_IF_ERROR(SerializeAutotuneMaps(&serialized));
+    }
+    // Write to a temporary file and rename it so that readers never observe a
+    // partially written cache file.
+    std::string tmp_path =
+        strings::StrCat(path_, ".tmp.", random::New64());
+    TF_RETURN_IF_ERROR(WriteStringToFile(Env::Default(), tmp_path, serialized));
+    TF_RETURN_IF_ERROR(Env::Default()->RenameFile(tmp_path, path_));
+    VLOG(1) << "Saved autotune results to " << path_;
+    last_saved_ = std::move(serialized);
+    return Status::OK();
+  }
+
+  void SaveLoop() {
+    while (true) {
+      Env::Default()->SleepForMicroseconds(save_interval_secs_ * 1000 * 1000);
+      Status save_status = SaveIfChanged();
+      if (!save_status.ok()) {
+        LOG(WARNING) << "Failed to save autotune results to " << path_ << ": "
+                     << save_status;
+      }
+    }
+  }
+
+  mutex mu_;
+  std::string path_;
+  int64_t save_interval_secs_;
+  // Serialized autotune maps as of the last load or save, used to skip saves
+  // when no new entries have been discovered.
+  std::string last_saved_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<Thread> thread_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+
+Status MaybeEnableAutotunePersistence() {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  std::string cache_dir;
+  TF_RETURN_IF_ERROR(
+      ReadStringFromEnvVar("TF_AUTOTUNE_CACHE_DIR", "", &cache_dir));
+  if (cache_dir.empty()) {
+    return Status::OK();
+  }
+  int64_t save_interval_secs;
+  TF_RETURN_IF_ERROR(ReadInt64FromEnvVar("TF_AUTOTUNE_CACHE_SAVE_INTERVAL",
+                                         /*default_val=*/60,
+                                         &save_interval_secs));
+  TF_RETURN_IF_ERROR(Env::Default()->RecursivelyCreateDir(cache_dir));
+  std::string path = io::JoinPath(cache_dir, AutotuneCacheFileName());
+  return AutotunePersistenceManager::GetInstance()->Start(path,
+                                                          save_interval_secs);
+#else
+  return Status::OK();
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,42 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Supports persisting autotune maps across processes via a cache file.
+//
+// When the TF_AUTOTUNE_CACHE_DIR environment variable is set, previously
+// saved autotune results are loaded into the runtime autotune maps at GPU
+// device creation time, and newly discovered entries are periodically merged
+// back into the cache file. The file name is derived from the GPU models
+// present and the autotune result version, so machines with different
+// hardware or incompatible software use separate files.
+//
+// Aims to make autotuning a one-time cost for a fleet of identical machines.
+
+#ifndef TENSORFLOW_CORE_UTIL_AUTOTUNE_MAPS_AUTOTUNE_PERSISTENCE_H_
+#define TENSORFLOW_CORE_UTIL_AUTOTUNE_MAPS_AUTOTUNE_PERSISTENCE_H_
+
+#include "tensorflow/core/platform/status.h"
+
+namespace tensorflow {
+
+// If TF_AUTOTUNE_CACHE_DIR is set, loads previously saved autotune results
+// and starts a background thread that periodically saves newly discovered
+// entries. Otherwise does nothing. Safe to call more than once; only the
+// first call has an effect.
+Status MaybeEnableAutotunePersistence();
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_UTIL_AUTOTUNE_MAPS_AUTOTUNE_PERSISTENCE_H_
@@ -32,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/util/presized_cuckoo_map.h"
 #include "tensorflow/core/util/sparse/sparse_tensor.h"
@@ -113,6 +114,34 @@ constexpr uint8 kVarintTag(uint32 tag) { return (tag << 3) | 0; }
 constexpr uint8 kDelimitedTag(uint32 tag) { return (tag << 3) | 2; }
 constexpr uint8 kFixed32Tag(uint32 tag) { return (tag << 3) | 5; }
 
+// Decodes one varint64 from [*pp, limit), advancing *pp past it. The whole
+// input is in memory, so this scans raw bytes instead of going through
+// CodedInputStream, which keeps the per-element cost of a packed int64 list
+// to a couple of branches for the common 1- and 2-byte encodings.
+inline bool ParseVarint64Fast(const uint8** pp, const uint8* limit,
+                              protobuf_uint64* value) {
+  const uint8* p = *pp;
+  if (p >= limit) return false;
+  protobuf_uint64 b = *p++;
+  if (TF_PREDICT_TRUE(b < 0x80)) {
+    *value = b;
+    *pp = p;
+    return true;
+  }
+  protobuf_uint64 result = b & 0x7f;
+  int shift = 7;
+  do {
+    // Valid varints are at most 10 bytes (shifts 0..63).
+    if (p >= limit || shift > 63) return false;
+    b = *p++;
+    result |= (b & 0x7f) << shift;
+    shift += 7;
+  } while (b & 0x80);
+  *value = result;
+  *pp = p;
+  return true;
+}
+
 namespace parsed {
 
 // ParseDataType has to be called first, then appropriate ParseZzzzList.
@@ -295,26 +324,43 @@ class Feature {
       if (peek_tag != kDelimitedTag(1) && peek_tag != kVarintTag(1)) {
         return false;
       }
+      // The stream wraps a single flat buffer, so the rest of the list is
+      // contiguous and can be decoded with raw pointer arithmetic rather
+      // than per-element CodedInputStream calls.
       if (peek_tag == kDelimitedTag(1)) {                       // packed
         if (!stream.ExpectTag(kDelimitedTag(1))) return false;  // packed tag
         uint32 packed_length;
         if (!stream.ReadVarint32(&packed_length)) return false;
-        auto packed_limit = stream.PushLimit(packed_length);
 
-        while (!stream.ExpectAtEnd()) {
-          protobuf_uint64 n;  // There is no API for int64
-          if (!stream.ReadVarint64(&n)) return false;
-          int64_list->push_back(static_cast<int64_t>(n));
+        if (packed_length > 0) {
+          const void* buf;
+          int buf_size;
+          if (!stream.GetDirectBufferPointer(&buf, &buf_size)) return false;
+          if (static_cast<uint32>(buf_size) < packed_length) return false;
+          const uint8* p = static_cast<const uint8*>(buf);
+          const uint8* packed_limit = p + packed_length;
+          while (p < packed_limit) {
+            protobuf_uint64 n;  // There is no API for int64
+            if (!ParseVarint64Fast(&p, packed_limit, &n)) return false;
+            int64_list->push_back(static_cast<int64_t>(n));
+          }
+          if (!stream.Skip(packed_length)) return false;
         }
-
-        stream.PopLimit(packed_limit);
       } else {  // non-packed
-        while (!stream.ExpectAtEnd()) {
-          if (!stream.ExpectTag(kVarintTag(1))) return false;
+        const int64_t remaining = stream.BytesUntilLimit();
+        const void* buf;
+        int buf_size;
+        if (!stream.GetDirectBufferPointer(&buf, &buf_size)) return false;
+        if (buf_size < remaining) return false;
+        const uint8* p = static_cast<const uint8*>(buf);
+        const uint8* list_limit = p + remaining;
+        while (p < list_limit) {
+          if (*p++ != kVarintTag(1)) return false;
           protobuf_uint64 n;  // There is no API for int64
-          if (!stream.ReadVarint64(&n)) return false;
+          if (!ParseVarint64Fast(&p, list_limit, &n)) return false;
           int64_list->push_back(static_cast<int64_t>(n));
         }
+        if (!stream.Skip(remaining)) return false;
       }
     }
     stream.PopLimit(limit);
@@ -591,11 +637,16 @@ Status FastParseSerializedExample(
     std::vector<SparseBuffer>* output_varlen_dense,
     std::vector<SparseBuffer>* output_sparse,
     std::vector<SparseBuffer>* output_ragged,
-    PerExampleFeatureStats* output_stats) {
+    PerExampleFeatureStats* output_stats,
+    parsed::Example* scratch_example) {
   DCHECK(output_dense != nullptr);
   DCHECK(output_sparse != nullptr);
   DCHECK(output_ragged != nullptr);
-  parsed::Example parsed_example;
+  DCHECK(scratch_example != nullptr);
+  // The scratch vector is reused across the examples of a minibatch so its
+  // entry storage is allocated once rather than per example.
+  parsed::Example& parsed_example = *scratch_example;
+  parsed_example.clear();
   if (!ParseExample(serialized_example, &parsed_example)) {
     return errors::InvalidArgument("Could not parse example input, value: '",
                                    serialized_example, "'");
@@ -1231,6 +1282,7 @@ Status FastParseExample(const Config& config,
     ragged_buffers[minibatch].resize(config.ragged.size());
     size_t start = first_example_of_minibatch(minibatch);
     size_t end = first_example_of_minibatch(minibatch + 1);
+    parsed::Example scratch_example;
     for (size_t e = start; e < end; ++e) {
       PerExampleFeatureStats* stats = nullptr;
       if (config.collect_feature_stats) {
@@ -1241,7 +1293,7 @@ Status FastParseExample(const Config& config,
           (!example_names.empty() ? example_names[e] : "<unknown>"), e, config,
           config_index, hasher, &fixed_dense_values,
           &varlen_dense_buffers[minibatch], &sparse_buffers[minibatch],
-          &ragged_buffers[minibatch], stats);
+          &ragged_buffers[minibatch], stats, &scratch_example);
       if (!status_of_minibatch[minibatch].ok()) break;
     }
   };
@@ -217,6 +217,25 @@ TEST(FastParse, SingleInt64) {
   TestCorrectness(Serialize(example));
 }
 
+TEST(FastParse, Int64ExtremeValues) {
+  // Exercises every varint width from 1 to 10 bytes (negative values are
+  // encoded as 10-byte varints).
+  Example example;
+  Int64List* int64_list =
+      (*example.mutable_features()->mutable_feature())["extremes"]
+          .mutable_int64_list();
+  int64_list->add_value(0);
+  int64_list->add_value(127);
+  int64_list->add_value(128);
+  int64_list->add_value(16383);
+  int64_list->add_value(16384);
+  int64_list->add_value(1LL << 40);
+  int64_list->add_value(9223372036854775807LL);  // int64 max
+  int64_list->add_value(-1);
+  int64_list->add_value(-9223372036854775807LL - 1);  // int64 min
+  TestCorrectness(Serialize(example));
+}
+
 static string ExampleWithSomeFeatures() {
   Example example;
 
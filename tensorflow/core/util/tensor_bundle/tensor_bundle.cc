@@ -44,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/platform/cord.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 #include "tensorflow/core/util/tensor_bundle/byte_swap.h"
@@ -63,6 +64,25 @@ const int kTensorBundleVersion = 1;
 // Size of our input buffer for streaming reads
 static const int kBufferSize = 1024 * 1024;
 
+// Size of the readahead window used when restoring tensor data.  The default
+// suits local disks; raising it via TF_TENSOR_BUNDLE_BUFFER_SIZE gives each
+// restore stream a larger readahead, which helps saturate high-latency or
+// high-bandwidth storage.
+static int64_t ReadBufferSize() {
+  static const int64_t buffer_size = [] {
+    int64_t size = kBufferSize;
+    Status s =
+        ReadInt64FromEnvVar("TF_TENSOR_BUNDLE_BUFFER_SIZE", kBufferSize, &size);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to parse TF_TENSOR_BUNDLE_BUFFER_SIZE: "
+                   << s.error_message();
+      return int64_t{kBufferSize};
+    }
+    return std::max<int64_t>(size, kBufferSize);
+  }();
+  return buffer_size;
+}
+
 // Key to the special BundleHeaderProto entry.  Do not change this, as clients
 // can make the assumption that the header is always the first entry in the
 // bundle.
@@ -229,16 +249,30 @@ Status ParseEntryProto(StringPiece key, StringPiece value,
 
 // Serializes the data bytes of the non-string tensor "val".  Discards the
 // original content of "bytes_written", and on OK updates it with number of
-// bytes written.
+// bytes written.  If "compress" is set, the bytes are snappy-compressed
+// whenever that actually shrinks them, and "entry" is marked accordingly;
+// incompressible tensors fall back to the plain encoding.
 // REQUIRES: val.dtype() != DT_STRING
-Status WriteTensor(const Tensor& val, FileOutputBuffer* out,
-                   size_t* bytes_written) {
+Status WriteTensor(const Tensor& val, FileOutputBuffer* out, bool compress,
+                   size_t* bytes_written, BundleEntryProto* entry) {
   DCHECK_NE(val.dtype(), DT_STRING);
   DCHECK_NE(val.dtype(), DT_VARIANT);
-  *bytes_written = val.TotalBytes();
+  const size_t total_bytes = val.TotalBytes();
   char* buf = GetBackingBuffer(val);
+  if (compress && total_bytes > 0) {
+    string compressed;
+    if (port::Snappy_Compress(buf, total_bytes, &compressed) &&
+        compressed.size() < total_bytes) {
+      entry->set_compression(BundleEntryProto::SNAPPY);
+      *bytes_written = compressed.size();
+      VLOG(1) << "Appending " << *bytes_written << " bytes (snappy, from "
+              << total_bytes << ") to file";
+      return out->Append(compressed);
+    }
+  }
+  *bytes_written = total_bytes;
   VLOG(1) << "Appending " << *bytes_written << " bytes to file";
-  return out->Append(StringPiece(buf, *bytes_written));
+  return out->Append(StringPiece(buf, total_bytes));
 }
 
 // Serializes string tensor "val".  "bytes_written" is treated in the same
@@ -462,7 +496,8 @@ Status BundleWriter::Add(StringPiece key, const Tensor& val) {
   } else if (val.dtype() == DT_VARIANT) {
     status_ = WriteVariantTensor(val, out_.get(), &data_bytes_written, &crc32c);
   } else {
-    status_ = WriteTensor(val, out_.get(), &data_bytes_written);
+    status_ = WriteTensor(val, out_.get(), options_.compress,
+                          &data_bytes_written, entry);
     crc32c = out_->crc32c();
   }
 
@@ -849,8 +884,11 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     ret = new Tensor(entry.dtype(), stored_shape);
   }
 
-  // Validates the "size" field.
-  if (entry.dtype() != DT_STRING && entry.dtype() != DT_VARIANT) {
+  // Validates the "size" field.  For compressed entries "size" is the stored
+  // (compressed) size; the uncompressed size is validated below, against the
+  // length recorded in the snappy stream.
+  if (entry.dtype() != DT_STRING && entry.dtype() != DT_VARIANT &&
+      entry.compression() == BundleEntryProto::NONE) {
     if (entry.size() != ret->TotalBytes()) {
       return errors::DataLoss("Invalid size in bundle entry: key ", key(),
                               "; stored size ", entry.size(),
@@ -877,7 +915,7 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     std::unique_ptr<RandomAccessFile> file = nullptr;
     TF_RETURN_IF_ERROR(env_->NewRandomAccessFile(
         DataFilename(prefix_, entry.shard_id(), num_shards_), &file));
-    buffered_file = new io::InputBuffer(file.release(), kBufferSize);
+    buffered_file = new io::InputBuffer(file.release(), ReadBufferSize());
     // The InputBuffer and RandomAccessFile objects are both released in dtor.
     data_[entry.shard_id()] = buffered_file;
   }
@@ -889,20 +927,39 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
   if (DataTypeCanUseMemcpy(entry.dtype())) {
     char* backing_buffer = const_cast<char*>((ret->tensor_data().data()));
     size_t unused_bytes_read;
-    if (entry.size() > kBufferSize) {
+    if (entry.compression() == BundleEntryProto::SNAPPY) {
+      // The checksum covers the stored (compressed) bytes.
+      string compressed(entry.size(), '\0');
+      StringPiece sp;
+      TF_RETURN_IF_ERROR(buffered_file->file()->Read(
+          entry.offset(), entry.size(), &sp, &compressed[0]));
+      actual_crc32c = crc32c::Value(sp.data(), sp.size());
+      size_t uncompressed_length = 0;
+      if (!port::Snappy_GetUncompressedLength(sp.data(), sp.size(),
+                                              &uncompressed_length) ||
+          uncompressed_length != ret->TotalBytes()) {
+        return errors::DataLoss("Invalid size in bundle entry: key ", key(),
+                                "; uncompressed size ", uncompressed_length,
+                                "; expected size ", ret->TotalBytes());
+      }
+      if (!port::Snappy_Uncompress(sp.data(), sp.size(), backing_buffer)) {
+        return errors::DataLoss("Snappy decompression failed: key ", key());
+      }
+    } else if (entry.size() > ReadBufferSize()) {
       StringPiece sp;
       TF_RETURN_IF_ERROR(buffered_file->file()->Read(
           entry.offset(), entry.size(), &sp, backing_buffer));
       if (sp.data() != backing_buffer) {
         memmove(backing_buffer, sp.data(), entry.size());
       }
+      actual_crc32c = crc32c::Value(backing_buffer, entry.size());
     } else {
       TF_RETURN_IF_ERROR(buffered_file->ReadNBytes(entry.size(), backing_buffer,
                                                    &unused_bytes_read));
+      // Note that we compute the checksum *before* byte-swapping. The checksum
+      // should be on the bytes in the order they appear in the file.
+      actual_crc32c = crc32c::Value(backing_buffer, entry.size());
     }
-    // Note that we compute the checksum *before* byte-swapping. The checksum
-    // should be on the bytes in the order they appear in the file.
-    actual_crc32c = crc32c::Value(backing_buffer, entry.size());
     if (need_to_swap_bytes_) {
       TF_RETURN_IF_ERROR(ByteSwapTensor(ret));
     }
@@ -1149,12 +1206,16 @@ inline char* AlignedMalloc(size_t size) {
 }  // namespace
 
 FileOutputBuffer::FileOutputBuffer(WritableFile* file, size_t buffer_size)
-    : file_(file), position_(0), buffer_size_(buffer_size) {
+    : file_(file),
+      position_(0),
+      buffer_size_(buffer_size),
+      flush_thread_(Env::Default(), "checkpoint_write", 1) {
   DCHECK_GT(buffer_size, 0);
   buffer_ptr_ = AlignedMalloc(buffer_size);
 }
 
 FileOutputBuffer::~FileOutputBuffer() {
+  WaitForBackgroundFlush().IgnoreError();
   if (buffer_ptr_) port::AlignedFree(buffer_ptr_);
   delete file_;
 }
@@ -1194,15 +1255,44 @@ Status FileOutputBuffer::Close() {
   return file_->Close();
 }
 
+Status FileOutputBuffer::WaitForBackgroundFlush() {
+  mutex_lock l(flush_mu_);
+  while (flush_in_flight_) {
+    flush_done_.wait(l);
+  }
+  Status status = flush_status_;
+  flush_status_ = Status::OK();
+  return status;
+}
+
 Status FileOutputBuffer::FlushBuffer(bool closing) {
+  // At most one background write is outstanding: wait for it (collecting its
+  // status) before issuing the next, so appends stay ordered and buffered
+  // memory stays bounded.
+  TF_RETURN_IF_ERROR(WaitForBackgroundFlush());
   if (position_ > 0) {
     // Use Cord to avoid extra data copy for some WritableFile implementations.
     absl::Cord buffer = absl::MakeCordFromExternal(
         StringPiece(buffer_ptr_, position_),
         [ptr = buffer_ptr_](StringPiece) { port::AlignedFree(ptr); });
     buffer_ptr_ = closing ? nullptr : AlignedMalloc(buffer_size_);
-    TF_RETURN_IF_ERROR(file_->Append(buffer));
     position_ = 0;
+    if (closing) {
+      return file_->Append(buffer);
+    }
+    // Hand the write to the background thread so the caller can serialize and
+    // checksum the next tensor while this one is written out.
+    {
+      mutex_lock l(flush_mu_);
+      flush_in_flight_ = true;
+    }
+    flush_thread_.Schedule([this, buffer]() {
+      Status status = file_->Append(buffer);
+      mutex_lock l(flush_mu_);
+      flush_status_.Update(status);
+      flush_in_flight_ = false;
+      flush_done_.notify_all();
+    });
   }
   return Status::OK();
 }
@@ -72,6 +72,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/tensor_slice.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/io/cache.h"
 #include "tensorflow/core/lib/io/inputbuffer.h"
@@ -80,6 +81,7 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/protobuf/tensor_bundle.pb.h"
 #include "tensorflow/core/util/tensor_bundle/naming.h"
@@ -116,6 +118,11 @@ class BundleWriter {
     // Alignment, in bytes, for tensor data.
     // Must be >= 1. The default size of 1 densely packs tensors.
     int data_alignment{1};
+    // If true, tensor data of fixed-size dtypes is snappy-compressed whenever
+    // that actually shrinks it.  Compressed bundles are smaller and faster to
+    // write on bandwidth-bound file systems, but cannot be read by TensorFlow
+    // releases that predate BundleEntryProto.compression.
+    bool compress{false};
   };
   BundleWriter(Env* env, StringPiece prefix,
                const Options& options = Options());
@@ -329,6 +336,9 @@ class BundleReader {
 
 // A buffering wrapper for a WritableFile.  Useful if the caller wishes to issue
 // small writes to a file (e.g. writing out a list of small varints).
+// Full buffers are handed to an internal background thread, so the caller can
+// keep serializing and checksumming the next tensor while the previous one is
+// being written out; Close() joins the outstanding write.
 // External synchronization must be used in the presence of concurrent callers.
 class FileOutputBuffer {
  public:
@@ -348,8 +358,14 @@ class FileOutputBuffer {
 
  private:
   // Appends the buffered data to the underlying file. Does NOT flush the file.
+  // Unless "closing", the write happens on the background thread; its errors
+  // surface on the next FlushBuffer() or Close().
   Status FlushBuffer(bool closing);
 
+  // Waits for the outstanding background write, if any, and returns its
+  // status.
+  Status WaitForBackgroundFlush();
+
   WritableFile* file_;  // Owned.
 
   // buffer_ptr_[0, position_) holds the buffered data not yet appended to the
@@ -358,6 +374,14 @@ class FileOutputBuffer {
   const size_t buffer_size_;
   char* buffer_ptr_;
 
+  // Single background thread performing the file writes.  At most one write
+  // is outstanding at a time, so at most two buffers are live at once.
+  thread::ThreadPool flush_thread_;
+  mutex flush_mu_;
+  condition_variable flush_done_;
+  bool flush_in_flight_ TF_GUARDED_BY(flush_mu_) = false;
+  Status flush_status_ TF_GUARDED_BY(flush_mu_);
+
   // Checksum of all appended bytes since construction or last clear_crc32c().
   uint32 crc32c_ = 0;
 };
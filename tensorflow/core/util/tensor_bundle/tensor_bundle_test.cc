@@ -1153,6 +1153,34 @@ TEST_F(TensorBundleAlignmentTest, AlignmentTest) {
   }
 }
 
+TEST(TensorBundleTest, Compression) {
+  const Tensor big = Constant(7.f, TensorShape({1 << 16}));
+  {
+    BundleWriter::Options opts;
+    opts.compress = true;
+    BundleWriter writer(Env::Default(), Prefix("foo"), opts);
+    TF_EXPECT_OK(writer.Add("foo_big", big));
+    TF_EXPECT_OK(writer.Add("foo_small", Constant_2x3<float>(3)));
+    // Non-memcpy dtypes are never compressed but must still round-trip.
+    TF_EXPECT_OK(
+        writer.Add("foo_string", Constant<tstring>("abc", TensorShape({3}))));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleReader reader(Env::Default(), Prefix("foo"));
+    TF_ASSERT_OK(reader.status());
+    Expect<float>(&reader, "foo_big", big);
+    Expect<float>(&reader, "foo_small", Constant_2x3<float>(3));
+    Expect<tstring>(&reader, "foo_string",
+                    Constant<tstring>("abc", TensorShape({3})));
+  }
+  // The constant tensor must have actually been stored compressed.
+  uint64 file_size = 0;
+  TF_ASSERT_OK(Env::Default()->GetFileSize(DataFilename(Prefix("foo"), 0, 1),
+                                           &file_size));
+  EXPECT_LT(file_size, big.TotalBytes());
+}
+
 static void BM_BundleAlignment(::testing::benchmark::State& state) {
   {
     const int alignment = state.range(0);
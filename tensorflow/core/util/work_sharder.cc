@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/util/work_sharder.h"
 
 #include "tensorflow/core/lib/core/blocking_counter.h"
+#include "tensorflow/core/platform/env_time.h"
 #include "tensorflow/core/platform/logging.h"
 
 namespace tensorflow {
@@ -51,6 +52,47 @@ void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
       max_parallelism);
 }
 
+ShardingCost::ShardingCost(int64_t initial_cost_per_unit)
+    : cost_per_unit_(std::max(int64_t{1}, initial_cost_per_unit)) {}
+
+bool ShardingCost::ShouldSample() {
+  const uint64 n = num_calls_.fetch_add(1, std::memory_order_relaxed);
+  return n < 3 || n % kSamplingPeriod == 0;
+}
+
+void ShardingCost::Update(int64_t elapsed_ns, int64_t units) {
+  if (elapsed_ns <= 0 || units <= 0) return;
+  const int64_t measured = std::max(int64_t{1}, elapsed_ns / units);
+  // Exponential moving average: stale estimates decay within a few samples,
+  // but one outlier (e.g. a preempted worker) cannot swing the shard size
+  // much.
+  int64_t old_cost = cost_per_unit_.load(std::memory_order_relaxed);
+  int64_t new_cost;
+  do {
+    new_cost = (3 * old_cost + measured) / 4;
+  } while (!cost_per_unit_.compare_exchange_weak(old_cost, new_cost,
+                                                 std::memory_order_relaxed));
+}
+
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           ShardingCost* cost, std::function<void(int64_t, int64_t)> work) {
+  DCHECK(cost != nullptr);
+  if (!cost->ShouldSample()) {
+    Shard(max_parallelism, workers, total, cost->cost_per_unit(),
+          std::move(work));
+    return;
+  }
+  // Time each shard and fold the measurements back into the estimate.
+  // Shard() blocks until every shard is done, so borrowing "work" by
+  // reference is safe.
+  Shard(max_parallelism, workers, total, cost->cost_per_unit(),
+        [cost, &work](int64_t start, int64_t limit) {
+          const uint64 begin_ns = EnvTime::NowNanos();
+          work(start, limit);
+          cost->Update(EnvTime::NowNanos() - begin_ns, limit - start);
+        });
+}
+
 // DEPRECATED: Prefer threadpool->ParallelFor with SchedulingStrategy, which
 // allows you to specify the strategy for choosing shard sizes, including using
 // a fixed shard size.
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 #define TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 
+#include <atomic>
 #include <functional>
 
 #include "tensorflow/core/lib/core/threadpool.h"
@@ -59,6 +60,53 @@ namespace tensorflow {
 void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
            int64_t cost_per_unit, std::function<void(int64_t, int64_t)> work);
 
+// Measured per-unit cost of one Shard() callsite.
+//
+// Hard-coded cost_per_unit guesses are chronically wrong: overestimating
+// floods the thread pool with tiny shards, underestimating leaves cores
+// idle. A ShardingCost replaces the guess with a running estimate measured
+// from the callsite's own shards. One instance identifies one callsite, so
+// the usual pattern is a function-local static:
+//
+//   static ShardingCost* cost = new ShardingCost(1000 /* initial guess */);
+//   Shard(max_parallelism, workers, total, cost, work);
+//
+// Shards are only timed on a small sample of calls, so the steady-state
+// overhead over plain Shard() is one atomic increment per call. Updates from
+// concurrent calls and worker threads are safe.
+class ShardingCost {
+ public:
+  // The initial guess plays the role of the old cost_per_unit argument
+  // (nanoseconds per unit) until the first measurements replace it.
+  explicit ShardingCost(int64_t initial_cost_per_unit);
+
+  // Current estimate of the cost of one unit of work, in nanoseconds.
+  int64_t cost_per_unit() const {
+    return cost_per_unit_.load(std::memory_order_relaxed);
+  }
+
+  // Folds a measured shard duration into the estimate.
+  void Update(int64_t elapsed_ns, int64_t units);
+
+  // Returns true if the next call should time its shards. The first few
+  // calls are always timed so the initial guess is replaced quickly;
+  // afterwards roughly one call in kSamplingPeriod keeps the estimate fresh.
+  bool ShouldSample();
+
+ private:
+  static constexpr int kSamplingPeriod = 64;
+
+  std::atomic<int64_t> cost_per_unit_;
+  std::atomic<uint64> num_calls_{0};
+};
+
+// Like Shard() above, but the per-unit cost is read from (and, on sampled
+// calls, measured back into) "cost" instead of being supplied by the caller.
+//
+// REQUIRES: cost != nullptr, and outlives the call (typically static).
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           ShardingCost* cost, std::function<void(int64_t, int64_t)> work);
+
 // Each thread has an associated option to express the desired maximum
 // parallelism. Its default is a very large quantity.
 //
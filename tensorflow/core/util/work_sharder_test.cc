@@ -90,6 +90,39 @@ TEST(Shard, OverflowTest) {
   }
 }
 
+TEST(ShardingCost, UpdateMovesEstimateTowardsMeasurement) {
+  ShardingCost cost(1000);
+  for (int i = 0; i < 100; i++) {
+    cost.Update(8000, 1);
+  }
+  EXPECT_GT(cost.cost_per_unit(), 1000);
+  EXPECT_LE(cost.cost_per_unit(), 8000);
+  for (int i = 0; i < 100; i++) {
+    cost.Update(10, 1);
+  }
+  EXPECT_LT(cost.cost_per_unit(), 100);
+  // Degenerate measurements are ignored.
+  cost.Update(0, 1);
+  cost.Update(100, 0);
+  EXPECT_GT(cost.cost_per_unit(), 0);
+}
+
+TEST(Shard, AdaptiveCost) {
+  thread::ThreadPool threads(Env::Default(), "test", 16);
+  ShardingCost cost(1);
+  const int64_t total = 1000;
+  for (int call = 0; call < 8; call++) {
+    std::atomic<int64_t> num_elements(0);
+    Shard(4, &threads, total, &cost,
+          [&num_elements](int64_t start, int64_t limit) {
+            num_elements += limit - start;
+          });
+    EXPECT_EQ(num_elements.load(), total);
+  }
+  // The first calls are always timed, so the estimate is measured by now.
+  EXPECT_GT(cost.cost_per_unit(), 0);
+}
+
 void BM_Sharding(::testing::benchmark::State& state) {
   const int arg = state.range(0);
 
@@ -97,5 +97,20 @@ int ReduceInBfloat16MaxGroupSize() {
   return 8;
 }
 
+int64_t CollectiveCombineBucketBytes(const std::string& device_type) {
+  const std::string per_device_env_var =
+      "DTENSOR_COLLECTIVE_COMBINE_BUCKET_BYTES_" + device_type;
+  char* bucket_bytes_str = std::getenv(per_device_env_var.c_str());
+  if (bucket_bytes_str == nullptr) {
+    bucket_bytes_str = std::getenv("DTENSOR_COLLECTIVE_COMBINE_BUCKET_BYTES");
+  }
+  if (bucket_bytes_str == nullptr) return 0;
+  int64_t bucket_bytes;
+  if (absl::SimpleAtoi(bucket_bytes_str, &bucket_bytes)) return bucket_bytes;
+  LOG(WARNING) << "Invalid DTENSOR_COLLECTIVE_COMBINE_BUCKET_BYTES, using "
+                  "the default value 0 (unlimited).";
+  return 0;
+}
+
 }  // namespace dtensor
 }  // namespace tensorflow
@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_DTENSOR_CC_DTENSOR_UTILS_H_
 #define TENSORFLOW_DTENSOR_CC_DTENSOR_UTILS_H_
 
+#include <cstdint>
+#include <string>
+
 namespace tensorflow {
 namespace dtensor {
 
@@ -51,6 +54,12 @@ bool DoNotFuseReduceScatter();
 // reduce op.
 int ReduceInBfloat16MaxGroupSize();
 
+// Returns the maximum number of tensor bytes one combined collective may
+// carry on a mesh of the given device type ("TPU", "GPU", or "CPU"), or 0 for
+// no limit. A device-type-specific environment variable takes precedence over
+// the generic one.
+int64_t CollectiveCombineBucketBytes(const std::string& device_type);
+
 }  // namespace dtensor
 }  // namespace tensorflow
 
@@ -262,6 +262,100 @@ mlir::LogicalResult MergeAllReduceGroup(
   return mlir::success();
 }
 
+// Returns the payload size of `value` in bytes, or 0 if its shape or element
+// size is not known statically.
+int64_t TensorSizeBytes(mlir::Value value) {
+  auto ranked_type = value.getType().dyn_cast<mlir::RankedTensorType>();
+  if (!ranked_type || !ranked_type.hasStaticShape()) return 0;
+  mlir::Type elem_type = ranked_type.getElementType();
+  if (!elem_type.isIntOrFloat()) return 0;
+  return ranked_type.getNumElements() * elem_type.getIntOrFloatBitWidth() / 8;
+}
+
+// Partitions `ops` (given in program order) into groups that can each be
+// merged into one collective: ops in a group are mutually independent, and
+// when `bucket_size_bytes` is positive a group's total payload stays within
+// that budget so a fused collective never grows beyond the per-mesh knob.
+template <typename CollectiveOp>
+std::vector<std::vector<CollectiveOp>> GroupIndependentOps(
+    const std::vector<CollectiveOp>& ops, int64_t bucket_size_bytes) {
+  // Build a reverse adjacency matrix from dependents to requirements.
+  const int num_ops = ops.size();
+  std::vector<std::vector<int>> requirements(num_ops, std::vector<int>());
+  for (int i = 0; i < num_ops - 1; ++i) {
+    CollectiveOp requirement = ops[i];
+    for (int j = i + 1; j < num_ops; ++j) {
+      CollectiveOp dependent = ops[j];
+      DCHECK(
+          !DependsOn(requirement, dependent));  // guaranteed by program order
+      // In this example, all three DTensorAllReduce ops are independent from
+      // each other according to MLIR value use-def chains considered by
+      // DependsOn. However, moving all three to after the WhileRegion and
+      // combine them would break the program.
+      //
+      // %3 = tf.DTensorAllReduce(%1, %2)
+      // %4 = tf.WhileRegion(%1) ({
+      // ^bb0(%arg):
+      //   %5 = tf.TooBool(%arg)
+      //   tf.Yield(%5)
+      // }, {
+      //   %6 = tf.DTensorAllReduce(%1, %2)
+      //   tf.Yield(%5)
+      // })
+      // %7 = tf.DTensorAllReduce(%1, %2)
+      //
+      // Therefore, in addition to DependsOn, we also check if two collective
+      // ops belong to different blocks. If they do, since they exist in the
+      // same ClusterOp, one or both of them must be inside a control flow
+      // region block. We treat them as if there is a dependency between them.
+      //
+      // In the example above, the second DTensorAllReduceOp would "depend on"
+      // the first one, and the third on the second. This effectively prevents
+      // any two DTensorAllReduce from merging together.
+      if (requirement->getBlock() != dependent->getBlock() ||
+          DependsOn(dependent, requirement)) {
+        requirements[j].push_back(i);
+      }
+    }
+  }
+
+  // Traverse the adjacency matrix layer by layer to find combination groups,
+  // starting a new group whenever the current one reaches the bucket budget.
+  std::vector<std::vector<CollectiveOp>> groups;
+  std::set<int> fulfilled;
+  while (fulfilled.size() < ops.size()) {
+    std::vector<int> fulfilled_this_layer;
+    for (int j = 0; j < requirements.size(); ++j) {
+      if (fulfilled.count(j) > 0) continue;
+      bool requirements_met = true;
+      for (int i : requirements[j]) {
+        if (fulfilled.count(i) == 0) {
+          requirements_met = false;
+          break;
+        }
+      }
+      if (requirements_met) {
+        fulfilled_this_layer.push_back(j);
+      }
+    }
+    VLOG(4) << "Fulfilled: " << str_util::Join(fulfilled_this_layer, ", ");
+    groups.push_back({});
+    int64_t group_bytes = 0;
+    for (int i : fulfilled_this_layer) {
+      fulfilled.insert(i);
+      const int64_t op_bytes = TensorSizeBytes(ops[i]->getOperand(0));
+      if (bucket_size_bytes > 0 && !groups.back().empty() &&
+          group_bytes + op_bytes > bucket_size_bytes) {
+        groups.push_back({});
+        group_bytes = 0;
+      }
+      groups.back().push_back(ops[i]);
+      group_bytes += op_bytes;
+    }
+  }
+  return groups;
+}
+
 // Dump the dependencies between AllReduce ops as a DOT graph.
 std::string DrawAllReduceDependencies(
     std::vector<mlir::TF::DTensorAllReduceOp> all_reduces) {
@@ -352,7 +446,8 @@ std::string DrawAllReduceDependencies(
 // clang-format on
 mlir::LogicalResult CombineAllReduceOpsOfSameTypeAndGroupAssignment(
     mlir::tf_device::ClusterOp cluster,
-    const std::vector<mlir::TF::DTensorAllReduceOp>& all_reduces) {
+    const std::vector<mlir::TF::DTensorAllReduceOp>& all_reduces,
+    int64_t bucket_size_bytes) {
   // Drop within-slice all-reduces.
   std::vector<mlir::TF::DTensorAllReduceOp> cross_slice_all_reduces;
   for (mlir::TF::DTensorAllReduceOp all_reduce : all_reduces) {
@@ -393,72 +488,9 @@ mlir::LogicalResult CombineAllReduceOpsOfSameTypeAndGroupAssignment(
   VLOG(4) << "Visualizing AllReduce dependencies:\n"
           << DrawAllReduceDependencies(cross_slice_all_reduces);
 
-  // Build a reverse adjacency matrix from dependents to requirements.
-  std::vector<std::vector<int>> requirements(num_all_reduces,
-                                             std::vector<int>());
-  for (int i = 0; i < num_all_reduces - 1; ++i) {
-    mlir::TF::DTensorAllReduceOp requirement = cross_slice_all_reduces[i];
-    for (int j = i + 1; j < num_all_reduces; ++j) {
-      mlir::TF::DTensorAllReduceOp dependent = cross_slice_all_reduces[j];
-      DCHECK(
-          !DependsOn(requirement, dependent));  // guaranteed by program order
-      // In this example, all three DTensorAllReduce ops are independent from
-      // each other according to MLIR value use-def chains considered by
-      // DependsOn. However, moving all three to after the WhileRegion and
-      // combine them would break the program.
-      //
-      // %3 = tf.DTensorAllReduce(%1, %2)
-      // %4 = tf.WhileRegion(%1) ({
-      // ^bb0(%arg):
-      //   %5 = tf.TooBool(%arg)
-      //   tf.Yield(%5)
-      // }, {
-      //   %6 = tf.DTensorAllReduce(%1, %2)
-      //   tf.Yield(%5)
-      // })
-      // %7 = tf.DTensorAllReduce(%1, %2)
-      //
-      // Therefore, in addition to DependsOn, we also check if two
-      // DTensorAllReduceOps belong to different blocks. If they do, since they
-      // exist in the same ClusterOp, one or both of them must be inside a
-      // control flow region block. We treat them as if there is a dependency
-      // between them.
-      //
-      // In the example above, the second DTensorAllReduceOp would "depend on"
-      // the first one, and the third on the second. This effectively prevents
-      // any two DTensorAllReduce from merging together.
-      if (requirement->getBlock() != dependent->getBlock() ||
-          DependsOn(dependent, requirement)) {
-        requirements[j].push_back(i);
-      }
-    }
-  }
-
-  // Traverse the adjacency matrix layer by layer to find combination groups.
-  std::vector<std::vector<mlir::TF::DTensorAllReduceOp>> all_reduce_groups;
-  std::set<int> fulfilled;
-  while (fulfilled.size() < cross_slice_all_reduces.size()) {
-    std::vector<int> fulfilled_this_layer;
-    for (int j = 0; j < requirements.size(); ++j) {
-      if (fulfilled.count(j) > 0) continue;
-      bool requirements_met = true;
-      for (int i : requirements[j]) {
-        if (fulfilled.count(i) == 0) {
-          requirements_met = false;
-          break;
-        }
-      }
-      if (requirements_met) {
-        fulfilled_this_layer.push_back(j);
-      }
-    }
-    VLOG(4) << "Fulfilled: " << str_util::Join(fulfilled_this_layer, ", ");
-    all_reduce_groups.push_back({});
-    for (int i : fulfilled_this_layer) {
-      fulfilled.insert(i);
-      all_reduce_groups.back().push_back(cross_slice_all_reduces[i]);
-    }
-  }
+  // Group mutually independent all-reduces, bucketed by the per-mesh budget.
+  std::vector<std::vector<mlir::TF::DTensorAllReduceOp>> all_reduce_groups =
+      GroupIndependentOps(cross_slice_all_reduces, bucket_size_bytes);
   VLOG(2) << num_all_reduces << " all-reduce ops in "
           << all_reduce_groups.size() << " groups";
 
@@ -507,7 +539,8 @@ bool same_group_assignments(mlir::Value group_assignment_a,
 // possible. Only ops with the same group assignment can be combined together.
 mlir::LogicalResult CombineAllReduceOpsOfSameType(
     mlir::tf_device::ClusterOp cluster,
-    const std::vector<mlir::TF::DTensorAllReduceOp>& all_reduces) {
+    const std::vector<mlir::TF::DTensorAllReduceOp>& all_reduces,
+    int64_t bucket_size_bytes) {
   // Maintain a list of seen group assignments, sorted by first appearance.
   // Also find and store all-reduces by group assignment. Use the first
   // mlir::Value that contains a certain group assignment to represent all the
@@ -533,21 +566,292 @@ mlir::LogicalResult CombineAllReduceOpsOfSameType(
   for (mlir::Value group_assignment : group_assignments) {
     mlir::LogicalResult result =
         CombineAllReduceOpsOfSameTypeAndGroupAssignment(
-            cluster, all_reduces_by_group_assignment[group_assignment]);
+            cluster, all_reduces_by_group_assignment[group_assignment],
+            bucket_size_bytes);
     if (mlir::failed(result)) return result;
   }
 
   return mlir::success();
 }
 
+// Merge reduce-scatters in the group into one reduce-scatter.
+//
+// Requirements:
+//   - The group should have at least two reduce-scatters.
+//   - They should be located next to each other in the parent block.
+//   - They should all have the same element type, reduce op, and group
+//     assignment.
+//   - They should all scatter dimension 0 of a statically shaped tensor.
+//
+// The merged reduce-scatter operates on a [group_size, total / group_size]
+// tensor. Each to-be-merged reduce-scatter reshapes its input to
+// [group_size, n / group_size] and writes it at its column offset, so every
+// row of the merged tensor interleaves one group member's piece of every
+// original tensor. After the merged op scatters the rows, the pieces are
+// sliced back out and reshaped to the original output shapes.
+mlir::LogicalResult MergeReduceScatterGroup(
+    std::vector<mlir::TF::DTensorReduceScatterOp>& reduce_scatter_group) {
+  int num_reduce_scatters = reduce_scatter_group.size();
+  DCHECK(num_reduce_scatters > 1)
+      << "Reduce scatter group size expected to be greater than 1.";
+  mlir::DenseIntElementsAttr group_assignment_attr;
+  if (!matchPattern(reduce_scatter_group[0].group_assignment(),
+                    m_Constant(&group_assignment_attr))) {
+    return reduce_scatter_group[0].emitOpError(
+        "group_assignment should be a constant");
+  }
+  if (group_assignment_attr.getType().getRank() != 2) {
+    return reduce_scatter_group[0].emitOpError(
+        "group_assignment should have two dimensions");
+  }
+  const int64_t group_size = group_assignment_attr.getType().getShape()[1];
+
+  // The merged tensor's columns hold the sum of all individual inputs' sizes.
+  int64_t total_num_elements = 0;
+  std::vector<llvm::ArrayRef<int64_t>> output_shapes;
+  output_shapes.reserve(num_reduce_scatters);
+  for (mlir::TF::DTensorReduceScatterOp& reduce_scatter :
+       reduce_scatter_group) {
+    auto input_ranked_type =
+        reduce_scatter.input().getType().dyn_cast<mlir::RankedTensorType>();
+    auto output_ranked_type =
+        reduce_scatter.getType().dyn_cast<mlir::RankedTensorType>();
+    if (!input_ranked_type || !input_ranked_type.hasStaticShape() ||
+        !output_ranked_type || !output_ranked_type.hasStaticShape()) {
+      return reduce_scatter.emitOpError(
+          "requires static shape for DTensorReduceScatterOp");
+    }
+    total_num_elements += input_ranked_type.getNumElements();
+    output_shapes.push_back(output_ranked_type.getShape());
+  }
+  DCHECK_EQ(total_num_elements % group_size, 0);
+  const int64_t num_cols = total_num_elements / group_size;
+
+  // Fill the merged tensor with 0 initially.
+  mlir::OpBuilder builder(reduce_scatter_group[0]);
+  mlir::Location loc = reduce_scatter_group[0].getLoc();
+  mlir::Type elem_type = reduce_scatter_group[0].getType().getElementType();
+  auto zero_scalar = ops_util::CreateScalarConst(0, builder, loc);
+  auto zero_scalar_elem_type = builder.create<mlir::TF::CastOp>(
+      loc, mlir::RankedTensorType::get({}, elem_type), zero_scalar);
+  auto merged = builder.create<mlir::TF::FillOp>(
+      loc, ops_util::GetR1Const({group_size, num_cols}, builder, loc),
+      zero_scalar_elem_type);
+
+  // Store every reduce-scatter's input at its column offset in the merged
+  // tensor, split into one row per group member.
+  int64_t offset_cols = 0;
+  std::vector<int64_t> col_sizes;
+  col_sizes.reserve(num_reduce_scatters);
+  mlir::TF::XlaDynamicUpdateSliceOp updated;
+  for (int i = 0; i < reduce_scatter_group.size(); ++i) {
+    mlir::TF::DTensorReduceScatterOp& reduce_scatter = reduce_scatter_group[i];
+    mlir::Location loc = reduce_scatter.getLoc();
+    auto input_ranked_type =
+        reduce_scatter.input().getType().dyn_cast<mlir::RankedTensorType>();
+    const int64_t cols = input_ranked_type.getNumElements() / group_size;
+    auto packed = builder.create<mlir::TF::ReshapeOp>(
+        loc, reduce_scatter.input(),
+        ops_util::GetR1Const({group_size, cols}, builder, loc));
+    auto indices = ops_util::GetR1Const({0, offset_cols}, builder, loc);
+    updated = builder.create<mlir::TF::XlaDynamicUpdateSliceOp>(
+        loc, merged.getType(),
+        /*input=*/i == 0 ? merged.getResult() : updated.getResult(),
+        /*update=*/packed, indices);
+    col_sizes.push_back(cols);
+    offset_cols += cols;
+  }
+
+  // Reduce-scatter the updated merged tensor over its rows.
+  auto merged_reduce_scatter = builder.create<mlir::TF::DTensorReduceScatterOp>(
+      reduce_scatter_group[0].getLoc(),
+      mlir::RankedTensorType::get({1, num_cols}, elem_type), updated,
+      reduce_scatter_group[0].group_assignment(),
+      reduce_scatter_group[0].scatter_dimension(),
+      reduce_scatter_group[0].reduce_op(),
+      reduce_scatter_group[0].device_type());
+  const Layout output_layout =
+      ExtractSingleLayoutFromOp(reduce_scatter_group[0]).ValueOrDie().value();
+  // Dimension 0 of every original output carries the scattered mesh
+  // dimension; the merged output scatters its rows over the same one.
+  StatusOr<Layout> merged_layout = Layout::GetLayout(
+      {output_layout.sharding_spec(0), Layout::kUnshardedDim},
+      output_layout.mesh());
+  if (!merged_layout.ok()) {
+    return reduce_scatter_group[0].emitOpError(
+        llvm::formatv("Failed to create a merged layout due to {0}",
+                      merged_layout.status().error_message()));
+  }
+  SetSingleLayoutOnOp(merged_reduce_scatter, *merged_layout);
+
+  // Slice out the original reduce-scatters' pieces, and reshape them back to
+  // the original output shapes.
+  offset_cols = 0;
+  std::vector<mlir::TF::ReshapeOp> replacements;
+  replacements.reserve(num_reduce_scatters);
+  for (int i = 0; i < reduce_scatter_group.size(); ++i) {
+    mlir::TF::DTensorReduceScatterOp& reduce_scatter = reduce_scatter_group[i];
+    mlir::Location loc = reduce_scatter.getLoc();
+    auto slice = builder.create<mlir::TF::SliceOp>(
+        loc, mlir::RankedTensorType::get({1, col_sizes[i]}, elem_type),
+        /*input=*/merged_reduce_scatter,
+        /*begin=*/ops_util::GetR1Const({0, offset_cols}, builder, loc),
+        /*size=*/ops_util::GetR1Const({1, col_sizes[i]}, builder, loc));
+    auto replacement = builder.create<mlir::TF::ReshapeOp>(
+        loc, slice.getResult(),
+        ops_util::GetR1Const(output_shapes[i], builder, loc));
+    replacements.push_back(replacement);
+    offset_cols += col_sizes[i];
+  }
+
+  // Replace usages and clean up.
+  for (int i = 0; i < reduce_scatter_group.size(); ++i) {
+    mlir::TF::DTensorReduceScatterOp& reduce_scatter = reduce_scatter_group[i];
+    mlir::TF::ReshapeOp& replacement = replacements[i];
+    reduce_scatter.replaceAllUsesWith(replacement.getResult());
+    reduce_scatter.erase();
+  }
+  return mlir::success();
+}
+
+// Combine reduce-scatters with the same element type, reduce op, and group
+// assignment into as few groups as possible. Only independent ops can be
+// combined together.
+mlir::LogicalResult CombineReduceScatterOpsOfSameTypeAndGroupAssignment(
+    mlir::tf_device::ClusterOp cluster,
+    const std::vector<mlir::TF::DTensorReduceScatterOp>& reduce_scatters,
+    int64_t bucket_size_bytes) {
+  // A single op has nothing to combine with.
+  if (reduce_scatters.size() <= 1) return mlir::success();
+
+  // Group mutually independent reduce-scatters, bucketed by the per-mesh
+  // budget.
+  std::vector<std::vector<mlir::TF::DTensorReduceScatterOp>>
+      reduce_scatter_groups =
+          GroupIndependentOps(reduce_scatters, bucket_size_bytes);
+  VLOG(2) << reduce_scatters.size() << " reduce-scatter ops in "
+          << reduce_scatter_groups.size() << " groups";
+
+  // Move reduce-scatters in the same group together and combine them.
+  for (auto& reduce_scatter_group : reduce_scatter_groups) {
+    int num_reduce_scatters = reduce_scatter_group.size();
+    if (num_reduce_scatters <= 1) continue;
+    mlir::TF::DTensorReduceScatterOp final_reduce_scatter =
+        reduce_scatter_group[num_reduce_scatters - 1];
+    for (int i = num_reduce_scatters - 2; i >= 0; --i) {
+      MoveUsagesAfter(cluster, reduce_scatter_group[i], final_reduce_scatter);
+    }
+    for (int i = 0; i < num_reduce_scatters - 1; ++i) {
+      reduce_scatter_group[i]->moveBefore(final_reduce_scatter);
+    }
+    auto merge_result = MergeReduceScatterGroup(reduce_scatter_group);
+    if (merge_result.failed()) return merge_result;
+  }
+
+  return mlir::success();
+}
+
+// Combines DTensorReduceScatter ops of the same element type into as few
+// groups as possible. Only ops with the same reduce op and group assignment,
+// scattering dimension 0 of a statically shaped tensor, can be combined.
+mlir::LogicalResult CombineReduceScatterOpsOfSameType(
+    mlir::tf_device::ClusterOp cluster,
+    const std::vector<mlir::TF::DTensorReduceScatterOp>& reduce_scatters,
+    int64_t bucket_size_bytes) {
+  // Drop ops the merged form cannot express: the merged tensor interleaves
+  // per-member pieces of every input, which is only a contiguous reshape when
+  // the scattered dimension is the outermost one.
+  std::vector<mlir::TF::DTensorReduceScatterOp> combinable_reduce_scatters;
+  for (mlir::TF::DTensorReduceScatterOp reduce_scatter : reduce_scatters) {
+    mlir::DenseIntElementsAttr scatter_dimension_attr;
+    if (!matchPattern(reduce_scatter.scatter_dimension(),
+                      m_Constant(&scatter_dimension_attr))) {
+      continue;
+    }
+    if (scatter_dimension_attr.getNumElements() != 1 ||
+        *scatter_dimension_attr.getValues<int32_t>().begin() != 0) {
+      continue;
+    }
+    auto input_ranked_type =
+        reduce_scatter.input().getType().dyn_cast<mlir::RankedTensorType>();
+    auto output_ranked_type =
+        reduce_scatter.getType().dyn_cast<mlir::RankedTensorType>();
+    if (!input_ranked_type || !input_ranked_type.hasStaticShape() ||
+        !output_ranked_type || !output_ranked_type.hasStaticShape() ||
+        input_ranked_type.getRank() == 0) {
+      continue;
+    }
+    combinable_reduce_scatters.push_back(reduce_scatter);
+  }
+
+  // Maintain a list of seen group assignments, sorted by first appearance,
+  // like in CombineAllReduceOpsOfSameType above.
+  std::vector<mlir::Value> group_assignments;
+  llvm::DenseMap<mlir::Value, std::vector<mlir::TF::DTensorReduceScatterOp>>
+      reduce_scatters_by_group_assignment;
+  for (mlir::TF::DTensorReduceScatterOp reduce_scatter :
+       combinable_reduce_scatters) {
+    mlir::Value group_assignment = reduce_scatter.group_assignment();
+    bool seen = false;
+    for (mlir::Value seen_group_assignment : group_assignments) {
+      if (same_group_assignments(group_assignment, seen_group_assignment)) {
+        group_assignment = seen_group_assignment;
+        seen = true;
+        break;
+      }
+    }
+    if (!seen) group_assignments.push_back(group_assignment);
+    reduce_scatters_by_group_assignment[group_assignment].push_back(
+        reduce_scatter);
+  }
+
+  // Combine reduce-scatters of the same group assignment in first-appearance
+  // order, further split by reduce op: ops with different reduce kinds cannot
+  // share one collective.
+  for (mlir::Value group_assignment : group_assignments) {
+    std::vector<llvm::StringRef> reduce_ops;
+    llvm::DenseMap<llvm::StringRef,
+                   std::vector<mlir::TF::DTensorReduceScatterOp>>
+        reduce_scatters_by_reduce_op;
+    for (mlir::TF::DTensorReduceScatterOp reduce_scatter :
+         reduce_scatters_by_group_assignment[group_assignment]) {
+      llvm::StringRef reduce_op = reduce_scatter.reduce_op();
+      if (std::find(reduce_ops.begin(), reduce_ops.end(), reduce_op) ==
+          reduce_ops.end()) {
+        reduce_ops.push_back(reduce_op);
+      }
+      reduce_scatters_by_reduce_op[reduce_op].push_back(reduce_scatter);
+    }
+    for (llvm::StringRef reduce_op : reduce_ops) {
+      mlir::LogicalResult result =
+          CombineReduceScatterOpsOfSameTypeAndGroupAssignment(
+              cluster, reduce_scatters_by_reduce_op[reduce_op],
+              bucket_size_bytes);
+      if (mlir::failed(result)) return result;
+    }
+  }
+
+  return mlir::success();
+}
+
 struct DTensorAllReduceCombineOptimization
     : public DTensorAllReduceCombineOptimizationBase<
           DTensorAllReduceCombineOptimization> {
   void runOnOperation() override {
     mlir::func::FuncOp function = getOperation();
     function.walk([&](mlir::tf_device::ClusterOp cluster) {
+      // An optional per-mesh byte budget on how much tensor data one merged
+      // collective may carry. 0 means unlimited.
+      int64_t bucket_size_bytes = 0;
+      StatusOr<Mesh> mesh = ExtractDeviceMeshEnclosingCluster(cluster);
+      if (mesh.ok()) {
+        bucket_size_bytes = CollectiveCombineBucketBytes(mesh->device_type());
+      }
+
       // Maintain a list of seen element types, sorted by first appearance.
-      // Also find and store all-reduces by element type.
+      // Also find and store all-reduces by element type. All-gathers have
+      // already been lowered into DTensorAllReduce by this point, so they
+      // participate in this combining as well.
       std::vector<mlir::Type> elem_types;
       llvm::DenseMap<mlir::Type, std::vector<mlir::TF::DTensorAllReduceOp>>
           all_reduces_by_elem_type;
@@ -563,7 +867,32 @@ struct DTensorAllReduceCombineOptimization
       // Combine all-reduces of the same element type in first-appearance order.
       for (mlir::Type elem_type : elem_types) {
         if (mlir::failed(CombineAllReduceOpsOfSameType(
-                cluster, all_reduces_by_elem_type[elem_type]))) {
+                cluster, all_reduces_by_elem_type[elem_type],
+                bucket_size_bytes))) {
+          return signalPassFailure();
+        }
+      }
+
+      // Do the same for reduce-scatters, which are lowered to backend
+      // collectives after this pass runs.
+      std::vector<mlir::Type> reduce_scatter_elem_types;
+      llvm::DenseMap<mlir::Type, std::vector<mlir::TF::DTensorReduceScatterOp>>
+          reduce_scatters_by_elem_type;
+      cluster.GetBody().walk(
+          [&](mlir::TF::DTensorReduceScatterOp reduce_scatter) {
+            mlir::Type elem_type = reduce_scatter.getType().getElementType();
+            if (std::find(reduce_scatter_elem_types.begin(),
+                          reduce_scatter_elem_types.end(),
+                          elem_type) == reduce_scatter_elem_types.end()) {
+              reduce_scatter_elem_types.push_back(elem_type);
+            }
+            reduce_scatters_by_elem_type[elem_type].push_back(reduce_scatter);
+          });
+
+      for (mlir::Type elem_type : reduce_scatter_elem_types) {
+        if (mlir::failed(CombineReduceScatterOpsOfSameType(
+                cluster, reduce_scatters_by_elem_type[elem_type],
+                bucket_size_bytes))) {
           return signalPassFailure();
         }
       }
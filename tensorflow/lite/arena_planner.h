@@ -55,6 +55,13 @@ class ArenaPlanner : public MemoryPlanner {
   ArenaPlanner(const ArenaPlanner&) = delete;
   ArenaPlanner& operator=(const ArenaPlanner&) = delete;
 
+  // Attaches a pool from which the non-persistent arena draws its underlying
+  // buffer, allowing subgraphs that never execute at the same time to reuse
+  // one another's released buffers. The persistent arena is not pooled since
+  // its tensors outlive individual invocations. Must be called before the
+  // first ExecuteAllocations().
+  void SetBufferPool(ArenaBufferPool* pool) { arena_.SetBufferPool(pool); }
+
   TfLiteStatus ResetAllocations() override;
   TfLiteStatus ResetAllocationsAfter(int node) override;
   TfLiteStatus PlanAllocations() override;
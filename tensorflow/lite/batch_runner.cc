@@ -0,0 +1,79 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/batch_runner.h"
+
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/interpreter_builder.h"
+
+namespace tflite {
+
+std::unique_ptr<BatchRunner> BatchRunner::Create(ModelResources* resources,
+                                                 const OpResolver& op_resolver,
+                                                 int batch_size,
+                                                 int num_threads) {
+  if (resources == nullptr || resources->model() == nullptr ||
+      batch_size <= 0) {
+    return nullptr;
+  }
+  std::unique_ptr<BatchRunner> runner(new BatchRunner());
+  for (int i = 0; i < batch_size; ++i) {
+    auto delegate = resources->CreateXNNPackDelegate(num_threads);
+    std::unique_ptr<Interpreter> interpreter;
+    InterpreterBuilder builder(*resources->model(), op_resolver);
+    builder.SetNumThreads(num_threads);
+    if (delegate) {
+      builder.AddDelegate(delegate.get());
+    }
+    if (builder(&interpreter) != kTfLiteOk ||
+        interpreter->AllocateTensors() != kTfLiteOk) {
+      return nullptr;
+    }
+    if (i == 0) {
+      // The first instance packs the weights into the shared cache; the
+      // remaining instances look them up instead of packing again.
+      if (!resources->FinalizeWeightsCache()) return nullptr;
+    }
+    runner->delegates_.push_back(std::move(delegate));
+    runner->interpreters_.push_back(std::move(interpreter));
+  }
+  return runner;
+}
+
+BatchRunner::~BatchRunner() = default;
+
+TfLiteStatus BatchRunner::Invoke() {
+  const int num_samples = interpreters_.size();
+  std::vector<TfLiteStatus> statuses(num_samples, kTfLiteOk);
+  std::vector<std::thread> workers;
+  workers.reserve(num_samples - 1);
+  for (int i = 1; i < num_samples; ++i) {
+    workers.emplace_back(
+        [this, i, &statuses] { statuses[i] = interpreters_[i]->Invoke(); });
+  }
+  statuses[0] = interpreters_[0]->Invoke();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  for (TfLiteStatus status : statuses) {
+    if (status != kTfLiteOk) return status;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace tflite
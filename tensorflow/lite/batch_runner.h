@@ -0,0 +1,101 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+/// \file
+/// Runs a fixed-size batch of independent samples through one model in
+/// parallel, without resizing the model's input tensors.
+///
+#ifndef TENSORFLOW_LITE_BATCH_RUNNER_H_
+#define TENSORFLOW_LITE_BATCH_RUNNER_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_resources.h"
+
+namespace tflite {
+
+/// Executes a batch of independent samples through one model by running a
+/// fixed pool of interpreter instances, one per sample, in parallel.
+///
+/// Resizing an interpreter's inputs to batch size N re-plans its memory and
+/// discards shape-specialized delegate state, so servers that batch requests
+/// this way pay the planning cost on every batch-size change. A `BatchRunner`
+/// instead keeps the per-sample shapes fixed: tensors are allocated once at
+/// creation, the XNNPACK-repacked weights are shared across the instances
+/// through `ModelResources`, and `Invoke` dispatches the samples across
+/// threads, one instance per thread.
+///
+/// Expected usage:
+///
+///   auto runner = BatchRunner::Create(&resources, resolver, batch_size);
+///   for each sample i: fill runner->input_tensor(i, 0);
+///   runner->Invoke();
+///   for each sample i: read runner->output_tensor(i, 0);
+///
+/// `resources` must outlive the runner. The instances do not share a CPU
+/// backend context, as sharing one is only safe under serial invocation.
+/// The runner itself must not be used from multiple threads at once.
+/// WARNING: This is an experimental API and subject to change.
+class BatchRunner {
+ public:
+  /// Creates a runner holding `batch_size` interpreter instances built from
+  /// `resources` with `op_resolver`, each with its tensors allocated and,
+  /// when TFLite was built with XNNPACK, its own delegate drawing from the
+  /// weights cache of `resources`. `num_threads` is the intra-op thread
+  /// count of each instance and is normally left at 1, since `Invoke`
+  /// already uses one thread per sample. Returns nullptr on failure.
+  static std::unique_ptr<BatchRunner> Create(ModelResources* resources,
+                                             const OpResolver& op_resolver,
+                                             int batch_size,
+                                             int num_threads = 1);
+
+  ~BatchRunner();
+  BatchRunner(const BatchRunner&) = delete;
+  BatchRunner& operator=(const BatchRunner&) = delete;
+
+  /// The number of samples processed per `Invoke`.
+  int batch_size() const { return interpreters_.size(); }
+
+  /// The input tensor at `input_index` of the instance serving `sample`.
+  /// Mirrors `Interpreter::input_tensor`; fill it before calling `Invoke`.
+  TfLiteTensor* input_tensor(int sample, int input_index) {
+    return interpreters_[sample]->input_tensor(input_index);
+  }
+
+  /// The output tensor at `output_index` of the instance serving `sample`.
+  const TfLiteTensor* output_tensor(int sample, int output_index) const {
+    return interpreters_[sample]->output_tensor(output_index);
+  }
+
+  /// Invokes all instances, in parallel across one thread per sample (the
+  /// calling thread runs one of them). Returns kTfLiteOk only if every
+  /// instance succeeded.
+  TfLiteStatus Invoke();
+
+ private:
+  BatchRunner() = default;
+
+  // The delegates are declared before the interpreters so the interpreters
+  // built on them are destroyed first.
+  std::vector<ModelResources::TfLiteDelegatePtr> delegates_;
+  std::vector<std::unique_ptr<Interpreter>> interpreters_;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_BATCH_RUNNER_H_
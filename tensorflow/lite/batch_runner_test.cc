@@ -0,0 +1,80 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/batch_runner.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/model_resources.h"
+
+namespace tflite {
+namespace {
+
+TEST(BatchRunnerTest, InvokesAllSamplesInParallel) {
+  auto model =
+      FlatBufferModel::BuildFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_TRUE(model);
+  ModelResources resources(std::move(model));
+
+  constexpr int kBatchSize = 4;
+  auto runner = BatchRunner::Create(
+      &resources, ops::builtin::BuiltinOpResolverWithoutDefaultDelegates(),
+      kBatchSize);
+  ASSERT_NE(runner, nullptr);
+  ASSERT_EQ(runner->batch_size(), kBatchSize);
+
+  // testdata/add.bin adds its input to itself twice, so an input filled with
+  // x produces 3x.
+  for (int sample = 0; sample < kBatchSize; ++sample) {
+    TfLiteTensor* input = runner->input_tensor(sample, 0);
+    ASSERT_NE(input, nullptr);
+    ASSERT_EQ(input->type, kTfLiteFloat32);
+    float* data = static_cast<float*>(input->data.data);
+    std::fill(data, data + input->bytes / sizeof(float),
+              static_cast<float>(sample + 1));
+  }
+
+  ASSERT_EQ(runner->Invoke(), kTfLiteOk);
+
+  for (int sample = 0; sample < kBatchSize; ++sample) {
+    const TfLiteTensor* output = runner->output_tensor(sample, 0);
+    ASSERT_NE(output, nullptr);
+    const float* data = static_cast<const float*>(output->data.data);
+    int num_elements = output->bytes / sizeof(float);
+    for (int i = 0; i < num_elements; ++i) {
+      EXPECT_FLOAT_EQ(data[i], 3.0f * (sample + 1));
+    }
+  }
+}
+
+TEST(BatchRunnerTest, RejectsInvalidBatchSize) {
+  auto model =
+      FlatBufferModel::BuildFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_TRUE(model);
+  ModelResources resources(std::move(model));
+
+  EXPECT_EQ(BatchRunner::Create(
+                &resources,
+                ops::builtin::BuiltinOpResolverWithoutDefaultDelegates(),
+                /*batch_size=*/0),
+            nullptr);
+}
+
+}  // namespace
+}  // namespace tflite
@@ -238,7 +238,8 @@ Subgraph::Subgraph(ErrorReporter* error_reporter,
       resources_(resources),
       resource_ids_(resource_ids),
       initialization_status_map_(initialization_status_map),
-      options_(nullptr) {
+      options_(nullptr),
+      arena_buffer_pool_(nullptr) {
   context_.impl_ = static_cast<void*>(this);
   context_.ResizeTensor = ResizeTensor;
   context_.ReportError = ReportErrorC;
@@ -1049,9 +1050,15 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
     memory_planner_.reset(new SimplePlanner(&context_, CreateGraphInfo()));
 #else
-    memory_planner_.reset(new ArenaPlanner(&context_, CreateGraphInfo(),
+    auto* arena_planner = new ArenaPlanner(&context_, CreateGraphInfo(),
                                            ShouldPreserveAllTensors(),
-                                           kDefaultTensorAlignment));
+                                           kDefaultTensorAlignment);
+    // The Interpreter only sets a pool when one of the arena sharing options
+    // is enabled.
+    if (arena_buffer_pool_ != nullptr) {
+      arena_planner->SetBufferPool(arena_buffer_pool_);
+    }
+    memory_planner_.reset(arena_planner);
 #endif
     memory_planner_->PlanAllocations();
   }
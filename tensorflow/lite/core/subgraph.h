@@ -40,6 +40,8 @@ limitations under the License.
 
 namespace tflite {
 
+class ArenaBufferPool;
+
 class SingleOpModel;  // Class for friend declarations.
 
 namespace delegates {
@@ -373,6 +375,20 @@ class Subgraph {
   // Set the given `InterpreterOptions` object.
   void SetOptions(InterpreterOptions* options) { options_ = options; }
 
+  // WARNING: This is an experimental API and subject to change.
+  // Sets the pool from which this subgraph's memory planner draws its
+  // non-persistent arena buffer. The pool is either private to the owning
+  // Interpreter and shared by all of its subgraphs, or shared by the whole
+  // process, depending on which arena sharing option is enabled.
+  void SetArenaBufferPool(ArenaBufferPool* pool) { arena_buffer_pool_ = pool; }
+
+  // WARNING: This is an experimental API and subject to change.
+  // True if subgraphs that never execute at the same time should share their
+  // non-persistent arena buffers.
+  bool ShouldShareArenaBetweenSubgraphs() const {
+    return (options_ && options_->GetShareArenaBetweenSubgraphs());
+  }
+
   // WARNING: This is an experimental API and subject to change.
   // True if all intermediates tensors should be preserved for debugging.
   bool ShouldPreserveAllTensors() const {
@@ -898,6 +914,10 @@ class Subgraph {
 
   // `InterpreterOptions` object which is being used and owned by Interpreter.
   InterpreterOptions* options_;
+
+  // Pool of arena buffers shared between subgraphs that never execute at the
+  // same time. Used and owned by the Interpreter.
+  ArenaBufferPool* arena_buffer_pool_;
 };
 
 }  // namespace tflite
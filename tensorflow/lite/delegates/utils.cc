@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/context_util.h"
+#include "tensorflow/lite/delegates/serialization.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 
 namespace tflite {
@@ -50,9 +51,36 @@ TfLiteStatus CreateNewTensorWithDifferentType(TfLiteContext* context,
 }
 
 TfLiteStatus GraphPartitionHelper::Partition(
-    std::set<std::string>* unsupported_nodes_info) {
-  const auto prepare_status = PrepareSupportedNodes(unsupported_nodes_info);
-  if (prepare_status != kTfLiteOk) return prepare_status;
+    std::set<std::string>* unsupported_nodes_info, Serialization* serialization,
+    const std::string& delegate_id) {
+  // A helper constructed with an explicit supported-node list already holds
+  // its decision, so the cache only applies when node support is computed.
+  const bool use_cache = serialization != nullptr && !delegate_id.empty() &&
+                         is_node_supported_fn_ != nullptr;
+  bool restored_from_cache = false;
+  if (use_cache) {
+    TfLiteIntArray* cached_nodes = nullptr;
+    if (GetDelegatedNodes(context_, serialization, delegate_id,
+                          &cached_nodes) == kTfLiteOk &&
+        cached_nodes != nullptr) {
+      if (AdoptCachedSupportedNodes(cached_nodes)) {
+        restored_from_cache = true;
+      } else {
+        TfLiteIntArrayFree(cached_nodes);
+      }
+    }
+  }
+
+  if (!restored_from_cache) {
+    const auto prepare_status = PrepareSupportedNodes(unsupported_nodes_info);
+    if (prepare_status != kTfLiteOk) return prepare_status;
+    if (use_cache && supported_nodes_ != nullptr) {
+      // Best effort: a failed write only means the delegation decision is
+      // recomputed on the next cold start.
+      SaveDelegatedNodes(context_, serialization, delegate_id,
+                         supported_nodes_);
+    }
+  }
 
   TfLiteDelegateParams* partition_params_array_ = nullptr;
   int num_partitions_ = 0;
@@ -161,6 +189,31 @@ TfLiteStatus GraphPartitionHelper::PrepareSupportedNodes(
   return kTfLiteOk;
 }
 
+bool GraphPartitionHelper::AdoptCachedSupportedNodes(
+    TfLiteIntArray* cached_nodes) {
+  TfLiteIntArray* execution_plan = nullptr;
+  if (context_->GetExecutionPlan(context_, &execution_plan) != kTfLiteOk) {
+    return false;
+  }
+  // Only trust the cached decision if every node it lists is still in the
+  // current execution plan; anything else means the plan has changed since
+  // the decision was saved.
+  const std::set<int> plan_nodes(
+      execution_plan->data, execution_plan->data + execution_plan->size);
+  for (int node_id : TfLiteIntArrayView(cached_nodes)) {
+    if (plan_nodes.count(node_id) == 0) return false;
+  }
+
+  num_total_nodes_ = execution_plan->size;
+  original_execution_plan_ = TfLiteIntArrayCreate(execution_plan->size);
+  std::memcpy(original_execution_plan_->data, execution_plan->data,
+              num_total_nodes_ * sizeof(int32_t));
+
+  supported_nodes_ = cached_nodes;
+  num_supported_nodes_ = supported_nodes_->size;
+  return true;
+}
+
 std::vector<int>
 FP16GraphPartitionHelper::GetNodesOfFirstNLargestPartitionsImpl(
     int n, int min_nodes_per_partition) {
@@ -32,6 +32,8 @@ limitations under the License.
 namespace tflite {
 namespace delegates {
 
+class Serialization;
+
 // Creates a new Read/Write tensor having the same shape as the original, but
 // with a different type. Note that this might void existing references to
 // tensors.
@@ -69,7 +71,15 @@ class GraphPartitionHelper {
   // replaced with one delegate kernel (i.e. a kTfLiteBuiltinDelegate op).
   // If 'unsupported_nodes_info' is provided, it will be populated with
   // information about all different unsupported nodes.
-  virtual TfLiteStatus Partition(std::set<std::string>* unsupported_nodes_info);
+  // If 'serialization' and a non-empty 'delegate_id' are provided, the
+  // delegation decision (i.e. the list of supported nodes) is read from the
+  // serialization cache when available, skipping the per-node support checks,
+  // and saved to it after being computed otherwise. 'delegate_id' should be
+  // unique to the delegate, its version and its configuration, so a stale
+  // decision is never read back; see SaveDelegatedNodes in serialization.h.
+  virtual TfLiteStatus Partition(std::set<std::string>* unsupported_nodes_info,
+                                 Serialization* serialization = nullptr,
+                                 const std::string& delegate_id = "");
 
   // Returns the first n largest partitions or all if #partitions is less than
   // 'n' and each parition has at least (>=) 'min_nodes_per_partition' nodes.
@@ -125,6 +135,13 @@ class GraphPartitionHelper {
   TfLiteStatus PrepareSupportedNodes(
       std::set<std::string>* unsupported_nodes_info = nullptr);
 
+  // Adopts 'cached_nodes' (a delegation decision read from the serialization
+  // cache) as the supported nodes, taking ownership of it, and refreshes the
+  // execution plan copy and node counters. Returns false without taking
+  // ownership if any cached node is not in the current execution plan, which
+  // means the decision is stale.
+  bool AdoptCachedSupportedNodes(TfLiteIntArray* cached_nodes);
+
   // The number of total nodes passed in for partitioning (i.e. the
   // execution_plan size associated w/ 'context_')
   int num_total_nodes_ = 0;
@@ -153,6 +170,15 @@ class FP16GraphPartitionHelper : public GraphPartitionHelper {
                            IsNodeSupportedFn is_node_supported_fn)
       : GraphPartitionHelper(context, std::move(is_node_supported_fn)) {}
 
+  // The fp16 partitioner records DEQUANTIZE remapping state while checking
+  // node support, which restoring a cached delegation decision would skip, so
+  // it always recomputes instead of using 'serialization'.
+  TfLiteStatus Partition(std::set<std::string>* unsupported_nodes_info,
+                         Serialization* serialization = nullptr,
+                         const std::string& delegate_id = "") override {
+    return GraphPartitionHelper::Partition(unsupported_nodes_info);
+  }
+
  protected:
   // Specialized function to handle fp16 nodes.
   bool IsNodeSupported(TfLiteContext* context, TfLiteNode* node,
@@ -14,11 +14,13 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/delegates/utils.h"
 
+#include <string>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/serialization.h"
 
 namespace tflite {
 namespace delegates {
@@ -208,6 +210,43 @@ TEST(GraphPartitionHelper, CheckPartitions) {
   EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9}));
 }
 
+TEST(GraphPartitionHelper, ReusesSerializedDelegationDecision) {
+  const std::string serialization_dir = ::testing::TempDir();
+  ASSERT_FALSE(serialization_dir.empty());
+  SerializationParams params = {"partition_helper_test_model",
+                                serialization_dir.c_str()};
+  Serialization serialization(params);
+  const std::string delegate_id = "test_delegate_v1";
+
+  int num_support_checks = 0;
+  auto counting_is_node_supported =
+      [&num_support_checks](TfLiteContext* context, TfLiteNode* node,
+                            TfLiteRegistration* registration,
+                            std::string* unsupported_details) -> bool {
+    ++num_support_checks;
+    return true;
+  };
+
+  // The first partitioning computes the decision and saves it.
+  MockTfLiteContext mocked_context;
+  GraphPartitionHelper helper(&mocked_context, counting_is_node_supported);
+  EXPECT_EQ(kTfLiteOk, helper.Partition(nullptr, &serialization, delegate_id));
+  EXPECT_EQ(10, num_support_checks);
+  EXPECT_EQ(10, helper.num_supported_nodes());
+  EXPECT_EQ(4, helper.num_partitions());
+
+  // A second helper, as on the next process start, reads the saved decision
+  // and skips the per-node support checks.
+  MockTfLiteContext second_context;
+  GraphPartitionHelper cached_helper(&second_context,
+                                     counting_is_node_supported);
+  EXPECT_EQ(kTfLiteOk,
+            cached_helper.Partition(nullptr, &serialization, delegate_id));
+  EXPECT_EQ(10, num_support_checks);
+  EXPECT_EQ(10, cached_helper.num_supported_nodes());
+  EXPECT_EQ(4, cached_helper.num_partitions());
+}
+
 TfLiteStatus ErrorGetExecutionPlan(TfLiteContext* context,
                                    TfLiteIntArray** execution_plan) {
   return kTfLiteError;
@@ -92,10 +92,20 @@ class ExternalCpuBackendContext : public TfLiteExternalContext {
     return internal_backend_context_.get();
   }
 
+  // Requests that the internal backend context cache prepacked copies of
+  // constant weight matrices across invocations. The flag is picked up when
+  // the internal backend context is lazily created, so it should be set
+  // before the first invocation of an interpreter using this context.
+  void set_use_caching(bool use_caching) { use_caching_ = use_caching; }
+
+  bool use_caching() const { return use_caching_; }
+
  private:
   // Note the actual internal backend context object is lazily initialized.
   std::unique_ptr<TfLiteInternalBackendContext> internal_backend_context_;
 
+  bool use_caching_ = false;
+
   ExternalCpuBackendContext(const ExternalCpuBackendContext&) = delete;
   ExternalCpuBackendContext& operator=(const ExternalCpuBackendContext&) =
       delete;
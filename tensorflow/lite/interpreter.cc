@@ -386,10 +386,18 @@ TfLiteStatus Interpreter::ApplyLazyDelegateProviders() {
 TfLiteStatus Interpreter::ModifyGraphWithDelegateImpl(
     TfLiteDelegate* delegate) {
   TfLiteStatus status = kTfLiteOk;
-  for (auto& subgraph : subgraphs_) {
+  for (size_t subgraph_index = 0; subgraph_index < subgraphs_.size();
+       ++subgraph_index) {
+    Subgraph* subgraph = subgraphs_[subgraph_index].get();
     if (IsValidationSubgraph(subgraph->GetName().c_str())) {
       continue;
     }
+    // Subgraphs whose construction was deferred receive the delegate when
+    // they are built; see ApplyDelegatesToDeferredSubgraph.
+    if (subgraph_index < lazily_deferred_subgraphs_.size() &&
+        lazily_deferred_subgraphs_[subgraph_index]) {
+      continue;
+    }
     status = subgraph->ModifyGraphWithDelegate(delegate);
     if (status != kTfLiteOk) {
       break;
@@ -403,6 +411,17 @@ TfLiteStatus Interpreter::ModifyGraphWithDelegateImpl(
   return status;
 }
 
+TfLiteStatus Interpreter::ApplyDelegatesToDeferredSubgraph(
+    int subgraph_index) {
+  // The primary subgraph records every delegate applied so far, including the
+  // default ones from the lazy delegate providers.
+  for (TfLiteDelegate* delegate : primary_subgraph().delegates_applied_) {
+    TF_LITE_ENSURE_STATUS(
+        subgraph(subgraph_index)->ModifyGraphWithDelegate(delegate));
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus Interpreter::RemoveAllDelegates() {
   for (auto& subgraph : subgraphs_) {
     TF_LITE_ENSURE_STATUS(subgraph->RemoveAllDelegates());
@@ -449,6 +468,27 @@ TfLiteStatus Interpreter::ApplyOptionsImpl(InterpreterOptions* options) {
     subgraph->SetOptions(options_.get());
   }
 
+  // Handle `experimental_share_arena_between_subgraphs_` and
+  // `experimental_share_arena_across_interpreters_`.
+  if (options->GetShareArenaAcrossInterpreters()) {
+    for (auto& subgraph : subgraphs_) {
+      subgraph->SetArenaBufferPool(ArenaBufferPool::GetProcessPool());
+    }
+  } else if (options->GetShareArenaBetweenSubgraphs()) {
+    for (auto& subgraph : subgraphs_) {
+      subgraph->SetArenaBufferPool(&arena_buffer_pool_);
+    }
+  }
+
+  // Handle `experimental_cache_prepacked_weights_`. The flag is picked up
+  // when the cpu backend context is lazily created on first use, so it only
+  // needs to be recorded on the owned external context here. An external
+  // context installed by the user via SetExternalContext keeps its own
+  // caching setting.
+  if (options->GetCachePrepackedWeights()) {
+    own_external_cpu_backend_context_->set_use_caching(true);
+  }
+
   // Handle `experimental_dynamic_allocation_for_large_tensors_`.
   if (options->GetDynamicAllocationForLargeTensors() > 0) {
     for (auto& subgraph : subgraphs_) {
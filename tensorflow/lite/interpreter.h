@@ -44,6 +44,7 @@ limitations under the License.
 #include "tensorflow/lite/memory_planner.h"
 #include "tensorflow/lite/portable_type_to_tflitetype.h"
 #include "tensorflow/lite/signature_runner.h"
+#include "tensorflow/lite/simple_memory_arena.h"
 #include "tensorflow/lite/stderr_reporter.h"
 #include "tensorflow/lite/string_type.h"
 #include "tensorflow/lite/type_to_tflitetype.h"
@@ -755,6 +756,12 @@ class Interpreter {
   // Applies TFLite default delegates.
   TfLiteStatus ApplyLazyDelegateProviders();
 
+  // Applies the delegates already applied to the eagerly built subgraphs to a
+  // subgraph whose construction was deferred. Called by the
+  // InterpreterBuilder when it materializes the subgraph on first use; see
+  // InterpreterBuilder::LazilyBuildSubgraphsExperimental.
+  TfLiteStatus ApplyDelegatesToDeferredSubgraph(int subgraph_index);
+
   // Private non-experimental implementation of ModifyGraphWithDelegate.
   // Unlike ModifyGraphWithDelegate, ModifyGraphWithDelegateImpl is defined in
   // interpreter.cc rather than in interpreter_experimental.cc, so it can be
@@ -881,6 +888,16 @@ class Interpreter {
   using TfLiteDelegateCreators = std::vector<TfLiteDelegateCreator>;
   TfLiteDelegateCreators lazy_delegate_providers_;
 
+  // Set by the InterpreterBuilder when lazy subgraph construction is enabled;
+  // builds the given subgraph (and the subgraphs it calls into) on demand.
+  // See InterpreterBuilder::LazilyBuildSubgraphsExperimental.
+  std::function<TfLiteStatus(int /*subgraph_index*/)> subgraph_materializer_;
+
+  // `lazily_deferred_subgraphs_[i]` is true while the construction of
+  // subgraph i is deferred. Empty unless lazy subgraph construction is
+  // enabled.
+  std::vector<bool> lazily_deferred_subgraphs_;
+
   // List of SignatureDefs obtained from the model.
   std::vector<internal::SignatureDef> signature_defs_;
 
@@ -895,6 +912,11 @@ class Interpreter {
 
   // InterpreterOptions object which is being used.
   std::unique_ptr<InterpreterOptions> options_;
+
+  // Pool of arena buffers shared between subgraphs that never execute at the
+  // same time. Owned by interpreter and shared by multiple subgraphs. Only
+  // used when `experimental_share_arena_between_subgraphs_` is enabled.
+  ArenaBufferPool arena_buffer_pool_;
 };
 
 }  // namespace tflite
@@ -296,6 +296,40 @@ std::vector<int> FlatBufferIntArrayToVector(T* flat_array) {
   return ret;
 }
 
+// Returns the indices of the subgraphs that the builtin control flow ops of
+// `subgraph` call into, e.g. the condition and body of a WHILE.
+std::vector<int32_t> GetCalleeSubgraphs(const tflite::SubGraph* subgraph) {
+  std::vector<int32_t> callees;
+  auto* operators = subgraph->operators();
+  if (!operators) {
+    return callees;
+  }
+  for (int i = 0; i < operators->size(); ++i) {
+    const auto* op = operators->Get(i);
+    switch (op->builtin_options_type()) {
+      case BuiltinOptions_IfOptions:
+        callees.push_back(op->builtin_options_as_IfOptions()
+                              ->then_subgraph_index());
+        callees.push_back(op->builtin_options_as_IfOptions()
+                              ->else_subgraph_index());
+        break;
+      case BuiltinOptions_WhileOptions:
+        callees.push_back(op->builtin_options_as_WhileOptions()
+                              ->cond_subgraph_index());
+        callees.push_back(op->builtin_options_as_WhileOptions()
+                              ->body_subgraph_index());
+        break;
+      case BuiltinOptions_CallOnceOptions:
+        callees.push_back(op->builtin_options_as_CallOnceOptions()
+                              ->init_subgraph_index());
+        break;
+      default:
+        break;
+    }
+  }
+  return callees;
+}
+
 // Used to determine how the op data parsing function creates its working space.
 class MallocDataAllocator : public BuiltinDataAllocator {
  public:
@@ -697,6 +731,93 @@ TfLiteStatus InterpreterBuilder::SetNumThreads(int num_threads) {
   return kTfLiteOk;
 }
 
+InterpreterBuilder& InterpreterBuilder::LazilyBuildSubgraphsExperimental() {
+  lazily_build_subgraphs_ = true;
+  return *this;
+}
+
+TfLiteStatus InterpreterBuilder::BuildSubgraph(Interpreter* interpreter,
+                                               int subgraph_index) {
+  const tflite::SubGraph* subgraph = (*model_->subgraphs())[subgraph_index];
+  auto* buffers = model_->buffers();
+  tflite::Subgraph* modified_subgraph = interpreter->subgraph(subgraph_index);
+  auto operators = subgraph->operators();
+  auto tensors = subgraph->tensors();
+  if (!tensors) {
+    TF_LITE_REPORT_ERROR(error_reporter_,
+                         "Did not get tensors in subgraph %d.\n",
+                         subgraph_index);
+    return kTfLiteError;
+  }
+  if (modified_subgraph->AddTensors(tensors->size()) != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  // Parse inputs/outputs
+  modified_subgraph->SetInputs(FlatBufferIntArrayToVector(subgraph->inputs()));
+  modified_subgraph->SetOutputs(
+      FlatBufferIntArrayToVector(subgraph->outputs()));
+
+  // Finally setup nodes and tensors
+  // Parse tensors before nodes as ParseNodes checks input tensors for the
+  // nodes.
+  if (ParseTensors(buffers, tensors, modified_subgraph) != kTfLiteOk)
+    return kTfLiteError;
+  if (operators && ParseNodes(operators, modified_subgraph) != kTfLiteOk)
+    return kTfLiteError;
+
+  std::vector<int> variables;
+  for (int i = 0; i < modified_subgraph->tensors_size(); ++i) {
+    auto* tensor = modified_subgraph->tensor(i);
+    if (tensor->is_variable) {
+      variables.push_back(i);
+    }
+  }
+  modified_subgraph->SetVariables(std::move(variables));
+  if (subgraph->name()) {
+    modified_subgraph->SetName(subgraph->name()->c_str());
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus InterpreterBuilder::BuildDeferredSubgraphs(
+    Interpreter* interpreter, int subgraph_index) {
+  auto& deferred = interpreter->lazily_deferred_subgraphs_;
+  if (subgraph_index < 0 ||
+      subgraph_index >= static_cast<int>(deferred.size()) ||
+      !deferred[subgraph_index]) {
+    // Built eagerly or already materialized.
+    return kTfLiteOk;
+  }
+  auto* subgraphs = model_->subgraphs();
+  // Collect the requested subgraph and, transitively, the deferred subgraphs
+  // its control flow ops call into.
+  std::vector<int> to_build = {subgraph_index};
+  deferred[subgraph_index] = false;
+  for (size_t i = 0; i < to_build.size(); ++i) {
+    for (int32_t callee : GetCalleeSubgraphs((*subgraphs)[to_build[i]])) {
+      if (callee >= 0 && callee < static_cast<int32_t>(deferred.size()) &&
+          deferred[callee]) {
+        deferred[callee] = false;
+        to_build.push_back(callee);
+      }
+    }
+  }
+  for (int index : to_build) {
+    if (BuildSubgraph(interpreter, index) != kTfLiteOk) {
+      return kTfLiteError;
+    }
+  }
+  // The eagerly built subgraphs already received their delegates when the
+  // interpreter was constructed; bring the new ones up to date.
+  for (int index : to_build) {
+    TfLiteStatus status = interpreter->ApplyDelegatesToDeferredSubgraph(index);
+    if (status != kTfLiteOk) {
+      return status;
+    }
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus InterpreterBuilder::operator()(
     std::unique_ptr<Interpreter>* interpreter, int num_threads) {
   TfLiteStatus status = SetNumThreads(num_threads);
@@ -772,47 +893,41 @@ TfLiteStatus InterpreterBuilder::operator()(
   (*interpreter)
       ->SetProfilerImpl(tflite::profiling::MaybeCreatePlatformProfiler());
 
+  std::vector<bool> defer_subgraph(subgraphs->size(), false);
+  if (lazily_build_subgraphs_ && subgraphs->size() > 1) {
+    // Build only the primary subgraph and the subgraphs its control flow ops
+    // call into; the remaining ones are built on demand when a
+    // SignatureRunner for them is first requested.
+    std::fill(defer_subgraph.begin() + 1, defer_subgraph.end(), true);
+    std::vector<int32_t> worklist = {0};
+    while (!worklist.empty()) {
+      const int32_t caller = worklist.back();
+      worklist.pop_back();
+      for (int32_t callee : GetCalleeSubgraphs((*subgraphs)[caller])) {
+        if (callee > 0 && callee < static_cast<int32_t>(subgraphs->size()) &&
+            defer_subgraph[callee]) {
+          defer_subgraph[callee] = false;
+          worklist.push_back(callee);
+        }
+      }
+    }
+  }
+
   for (int subgraph_index = 0; subgraph_index < subgraphs->size();
        ++subgraph_index) {
-    const tflite::SubGraph* subgraph = (*subgraphs)[subgraph_index];
-    tflite::Subgraph* modified_subgraph =
-        (*interpreter)->subgraph(subgraph_index);
-    auto operators = subgraph->operators();
-    auto tensors = subgraph->tensors();
-    if (!tensors) {
-      TF_LITE_REPORT_ERROR(error_reporter_,
-                           "Did not get tensors in subgraph %d.\n",
-                           subgraph_index);
-      return cleanup_and_error();
-    }
-    if (modified_subgraph->AddTensors(tensors->size()) != kTfLiteOk) {
+    if (defer_subgraph[subgraph_index]) continue;
+    if (BuildSubgraph(interpreter->get(), subgraph_index) != kTfLiteOk) {
       return cleanup_and_error();
     }
-    // Parse inputs/outputs
-    modified_subgraph->SetInputs(
-        FlatBufferIntArrayToVector(subgraph->inputs()));
-    modified_subgraph->SetOutputs(
-        FlatBufferIntArrayToVector(subgraph->outputs()));
-
-    // Finally setup nodes and tensors
-    // Parse tensors before nodes as ParseNodes checks input tensors for the
-    // nodes.
-    if (ParseTensors(buffers, tensors, modified_subgraph) != kTfLiteOk)
-      return cleanup_and_error();
-    if (operators && ParseNodes(operators, modified_subgraph) != kTfLiteOk)
-      return cleanup_and_error();
+  }
 
-    std::vector<int> variables;
-    for (int i = 0; i < modified_subgraph->tensors_size(); ++i) {
-      auto* tensor = modified_subgraph->tensor(i);
-      if (tensor->is_variable) {
-        variables.push_back(i);
-      }
-    }
-    modified_subgraph->SetVariables(std::move(variables));
-    if (subgraph->name()) {
-      modified_subgraph->SetName(subgraph->name()->c_str());
-    }
+  if (lazily_build_subgraphs_) {
+    Interpreter* interpreter_ptr = interpreter->get();
+    interpreter_ptr->lazily_deferred_subgraphs_ = std::move(defer_subgraph);
+    interpreter_ptr->subgraph_materializer_ =
+        [this, interpreter_ptr](int subgraph_index) {
+          return BuildDeferredSubgraphs(interpreter_ptr, subgraph_index);
+        };
   }
 
   if (ParseSignatureDefs(model_->signature_defs(), interpreter->get()) !=
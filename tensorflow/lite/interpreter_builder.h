@@ -100,6 +100,19 @@ class InterpreterBuilder {
   /// intermediates are undefined due to memory planning and reuse.
   InterpreterBuilder& PreserveAllTensorsExperimental();
 
+  /// Defers the construction of every subgraph that the primary subgraph does
+  /// not call into until a `SignatureRunner` for it is first requested via
+  /// `Interpreter::GetSignatureRunner`. For models that bundle many entry
+  /// points of which a session uses only a few, this cuts interpreter
+  /// construction time and the memory touched for the unused entry points.
+  /// When enabled, this `InterpreterBuilder`, the `op_resolver` and any
+  /// delegates added with `AddDelegate` must outlive the interpreters built
+  /// from it, since they are needed to construct the deferred subgraphs.
+  /// Subgraphs called into by custom (non-builtin) control flow ops are not
+  /// discovered and must not be used with this option.
+  /// WARNING: This is an experimental API and subject to change.
+  InterpreterBuilder& LazilyBuildSubgraphsExperimental();
+
   /// Any delegates added with AddDelegate will be applied to the Interpreter
   /// generated by operator(), in the order that they were added.  (The delegate
   /// parameter passed to AddDelegate should be non-null, otherwise an error
@@ -127,6 +140,15 @@ class InterpreterBuilder {
       const flatbuffers::Vector<flatbuffers::Offset<SignatureDef>>*
           signature_def_list,
       Interpreter* interpreter);
+  // Builds the tensors and nodes of a single subgraph of `interpreter` from
+  // the corresponding subgraph of the model.
+  TfLiteStatus BuildSubgraph(Interpreter* interpreter, int subgraph_index);
+  // Builds `subgraph_index` and, transitively, the subgraphs its control flow
+  // ops call into, if their construction was deferred by
+  // `LazilyBuildSubgraphsExperimental`. Invoked through the materializer the
+  // builder installs on the interpreter.
+  TfLiteStatus BuildDeferredSubgraphs(Interpreter* interpreter,
+                                      int subgraph_index);
 
   const ::tflite::Model* model_;
   const OpResolver& op_resolver_;
@@ -144,6 +166,7 @@ class InterpreterBuilder {
   const Allocation* allocation_ = nullptr;
 
   bool has_flex_op_ = false;
+  bool lazily_build_subgraphs_ = false;
   int num_fp32_tensors_ = 0;
   int num_threads_ = -1;
   InterpreterOptions options_;
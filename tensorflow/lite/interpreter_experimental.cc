@@ -45,7 +45,17 @@ TfLiteStatus Interpreter::ReleaseNonPersistentMemory() {
   // TODO(b/138790287): We could do this for all subgraphs whose tensors have
   // been allocated. However, AllocateTensors() relies on Control Flow ops to
   // allocate tensors on 'children' subgraphs. Revisit this if required.
-  return primary_subgraph().ReleaseNonPersistentMemory();
+  TF_LITE_ENSURE_STATUS(primary_subgraph().ReleaseNonPersistentMemory());
+  // An interpreter releasing its non-persistent memory is going idle, so also
+  // decommit the pooled arena buffers it may have been drawing from. Pooled
+  // buffers are by definition not in use, so this is safe even for the
+  // process-wide pool.
+  if (options_ && options_->GetShareArenaAcrossInterpreters()) {
+    ArenaBufferPool::GetProcessPool()->DecommitBuffers();
+  } else if (options_ && options_->GetShareArenaBetweenSubgraphs()) {
+    arena_buffer_pool_.DecommitBuffers();
+  }
+  return kTfLiteOk;
 }
 
 TfLiteStatus Interpreter::ResetVariableTensors() {
@@ -135,6 +145,24 @@ SignatureRunner* Interpreter::GetSignatureRunner(const char* signature_key) {
     return &(iter->second);
   }
 
+  const internal::SignatureDef* signature_def = nullptr;
+  for (const auto& signature : signature_defs_) {
+    if (signature.signature_key == signature_key) {
+      signature_def = &signature;
+      break;
+    }
+  }
+  if (signature_def == nullptr) {
+    return nullptr;
+  }
+
+  // If the construction of the signature's subgraph was deferred, build it
+  // before applying the delegates below.
+  if (subgraph_materializer_ &&
+      subgraph_materializer_(signature_def->subgraph_index) != kTfLiteOk) {
+    return nullptr;
+  }
+
   // Default delegates are applied once for all subgraphs. Only returns error
   // when the status is kTfLiteError. For other statuses, it will fall back to
   // the default implementation.
@@ -142,15 +170,11 @@ SignatureRunner* Interpreter::GetSignatureRunner(const char* signature_key) {
     return nullptr;
   }
 
-  for (const auto& signature : signature_defs_) {
-    if (signature.signature_key == signature_key) {
-      auto status = signature_runner_map_.insert(
-          {signature_key,
-           SignatureRunner(&signature, subgraph(signature.subgraph_index))});
-      return &(status.first->second);
-    }
-  }
-  return nullptr;
+  auto status = signature_runner_map_.insert(
+      {signature_key,
+       SignatureRunner(signature_def,
+                       subgraph(signature_def->subgraph_index))});
+  return &(status.first->second);
 }
 
 }  // namespace tflite
@@ -27,7 +27,10 @@ class InterpreterOptions {
   InterpreterOptions()
       : experimental_preserve_all_tensors_(false),
         experimental_ensure_dynamic_tensors_are_released_(false),
-        experimental_optimize_memory_for_large_tensors_(0) {}
+        experimental_optimize_memory_for_large_tensors_(0),
+        experimental_share_arena_between_subgraphs_(false),
+        experimental_share_arena_across_interpreters_(false),
+        experimental_cache_prepacked_weights_(false) {}
 
   /// Preserving all intermediates tensors for debugging.
   /// WARNING: This is an experimental API and subject to change.
@@ -76,10 +79,71 @@ class InterpreterOptions {
     return experimental_optimize_memory_for_large_tensors_;
   }
 
+  /// Share the memory arena between subgraphs that never execute at the same
+  /// time, e.g. the branch subgraphs of control flow ops. A subgraph invoked
+  /// by a control flow op releases its non-persistent memory after each
+  /// invocation and the released buffer is reused by the next subgraph that
+  /// needs one, so the peak memory usage covers only the subgraphs that are
+  /// live together on one call path. Note that reading the intermediate
+  /// tensors of such a subgraph after it returns is not supported with this
+  /// option enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetShareArenaBetweenSubgraphs(bool value = true) {
+    experimental_share_arena_between_subgraphs_ = value;
+  }
+
+  /// Returns if the `experimental_share_arena_between_subgraphs_` feature is
+  /// enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetShareArenaBetweenSubgraphs() {
+    return experimental_share_arena_between_subgraphs_;
+  }
+
+  /// Draw this interpreter's arena buffers from a pool shared by the whole
+  /// process instead of a pool private to the interpreter. With many
+  /// interpreters running the same model in parallel, a starting interpreter
+  /// then reuses a buffer released by another one rather than allocating and
+  /// faulting in fresh memory. Buffers enter the shared pool when subgraphs
+  /// release their non-persistent memory, e.g. via
+  /// `Interpreter::ReleaseNonPersistentMemory`, which additionally decommits
+  /// the pooled buffers so idle interpreters don't hold physical memory.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetShareArenaAcrossInterpreters(bool value = true) {
+    experimental_share_arena_across_interpreters_ = value;
+  }
+
+  /// Returns if the `experimental_share_arena_across_interpreters_` feature
+  /// is enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetShareArenaAcrossInterpreters() {
+    return experimental_share_arena_across_interpreters_;
+  }
+
+  /// Cache prepacked copies of constant weight matrices across invocations
+  /// instead of repacking them on every GEMM call. This trades extra memory
+  /// for a large speedup in matrix*vector heavy models, e.g. stacks of fully
+  /// connected layers, and the packed copies survive as long as the cpu
+  /// backend context, so interpreters sharing one context (see
+  /// `ExternalCpuBackendContext`) also share one packed copy of the weights.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetCachePrepackedWeights(bool value = true) {
+    experimental_cache_prepacked_weights_ = value;
+  }
+
+  /// Returns if the `experimental_cache_prepacked_weights_` feature is
+  /// enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetCachePrepackedWeights() {
+    return experimental_cache_prepacked_weights_;
+  }
+
  private:
   bool experimental_preserve_all_tensors_;
   bool experimental_ensure_dynamic_tensors_are_released_;
   int experimental_optimize_memory_for_large_tensors_;
+  bool experimental_share_arena_between_subgraphs_;
+  bool experimental_share_arena_across_interpreters_;
+  bool experimental_cache_prepacked_weights_;
 };
 
 }  // namespace tflite
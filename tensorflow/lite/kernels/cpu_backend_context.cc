@@ -116,6 +116,11 @@ CpuBackendContext* CpuBackendContext::GetFromContext(TfLiteContext* context) {
     // that's wrapped inside ExternalCpuBackendContext.
     cpu_backend_context = new CpuBackendContext();
     cpu_backend_context->SetMaxNumThreads(context->recommended_num_threads);
+    // Enabling caching here must not override a TFLITE_WITH_RUY_GEMV build,
+    // where the constructor already turned it on.
+    if (external_context->use_caching()) {
+      cpu_backend_context->SetUseCaching(true);
+    }
     external_context->set_internal_backend_context(
         std::unique_ptr<TfLiteInternalBackendContext>(cpu_backend_context));
   }
@@ -154,6 +154,14 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       cond_value ? op_data->then_subgraph_index : op_data->else_subgraph_index;
   Subgraph& active_branch_subgraph =
       *(*subgraphs)[active_branch_subgraph_index];
+
+  // When arena sharing between subgraphs is enabled, the branch subgraphs
+  // release their non-persistent memory at the end of each invocation, so it
+  // has to be re-acquired before the branch's input tensors can be written.
+  if (this_subgraph->ShouldShareArenaBetweenSubgraphs()) {
+    TF_LITE_ENSURE_OK(context, active_branch_subgraph.AllocateTensors());
+  }
+
   for (int i = 0; i < active_branch_subgraph.inputs().size(); ++i) {
     const TfLiteTensor* input;
     TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, i + 1, &input));
@@ -211,6 +219,16 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE_EQ(context, output->bytes, subgraph_output->bytes);
     TfLiteTensorCopy(subgraph_output, output);
   }
+
+  // Release the branch subgraphs' non-persistent memory so that their arena
+  // buffers can be reused by subgraphs that don't execute at the same time.
+  if (this_subgraph->ShouldShareArenaBetweenSubgraphs()) {
+    Subgraph* then_subgraph = (*subgraphs)[op_data->then_subgraph_index].get();
+    Subgraph* else_subgraph = (*subgraphs)[op_data->else_subgraph_index].get();
+    TF_LITE_ENSURE_OK(context, then_subgraph->ReleaseNonPersistentMemory());
+    TF_LITE_ENSURE_OK(context, else_subgraph->ReleaseNonPersistentMemory());
+  }
+
   return kTfLiteOk;
 }
 
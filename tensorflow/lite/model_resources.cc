@@ -0,0 +1,60 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/model_resources.h"
+
+#include <memory>
+#include <utility>
+
+#include "tensorflow/lite/tflite_with_xnnpack_optional.h"
+
+namespace tflite {
+
+ModelResources::ModelResources(std::unique_ptr<FlatBufferModel> model)
+    : model_(std::move(model)), xnnpack_weights_cache_(nullptr) {}
+
+ModelResources::~ModelResources() {
+  DeleteXNNPACKWeightsCache(xnnpack_weights_cache_);
+}
+
+ModelResources::TfLiteDelegatePtr ModelResources::CreateXNNPackDelegate(
+    int num_threads) {
+  if (xnnpack_weights_cache_ == nullptr) {
+    // Returns null when TFLite was built without the XNNPACK delegate, in
+    // which case the delegate below will be null as well.
+    xnnpack_weights_cache_ = MaybeCreateXNNPACKWeightsCache();
+  }
+  return MaybeCreateXNNPACKDelegate(num_threads, xnnpack_weights_cache_);
+}
+
+bool ModelResources::FinalizeWeightsCache() {
+  return FinalizeXNNPACKWeightsCache(xnnpack_weights_cache_);
+}
+
+bool ModelResources::HardFinalizeWeightsCache() {
+  return HardFinalizeXNNPACKWeightsCache(xnnpack_weights_cache_);
+}
+
+ExternalCpuBackendContext* ModelResources::external_cpu_backend_context() {
+  if (external_cpu_backend_context_ == nullptr) {
+    external_cpu_backend_context_.reset(new ExternalCpuBackendContext());
+    // The packed weights are keyed by the address of the raw weights in the
+    // shared flatbuffer model, so all interpreters referencing `model_` hit
+    // the same cache entries.
+    external_cpu_backend_context_->set_use_caching(true);
+  }
+  return external_cpu_backend_context_.get();
+}
+
+}  // namespace tflite
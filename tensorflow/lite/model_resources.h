@@ -0,0 +1,104 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+/// \file
+/// Bundles the resources that several `Interpreter` instances running the
+/// same model can reference instead of duplicating.
+///
+#ifndef TENSORFLOW_LITE_MODEL_RESOURCES_H_
+#define TENSORFLOW_LITE_MODEL_RESOURCES_H_
+
+#include <memory>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/external_cpu_backend_context.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+
+/// Owns the resources that many interpreters of one model share: the
+/// flatbuffer model whose mapped weights all interpreters reference, and a
+/// weights cache holding a single copy of the weights the XNNPACK delegate
+/// repacks, which would otherwise be duplicated per interpreter.
+///
+/// Expected usage when running N interpreters of the same model:
+///
+///   ModelResources resources(FlatBufferModel::BuildFromFile(path));
+///   for each interpreter:
+///     auto delegate = resources.CreateXNNPackDelegate(num_threads);
+///     InterpreterBuilder builder(*resources.model(), resolver);
+///     if (delegate) builder.AddDelegate(delegate.get());
+///     builder(&interpreter);
+///     interpreter->AllocateTensors();
+///     after the first interpreter only: resources.FinalizeWeightsCache();
+///
+/// The `ModelResources` object and the delegates it created must outlive all
+/// interpreters built from them, and the delegates must be destroyed before
+/// the `ModelResources` object.
+/// WARNING: This is an experimental API and subject to change.
+class ModelResources {
+ public:
+  using TfLiteDelegatePtr =
+      std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>;
+
+  /// Takes ownership of `model`, which must not be null.
+  explicit ModelResources(std::unique_ptr<FlatBufferModel> model);
+  ~ModelResources();
+  ModelResources(const ModelResources&) = delete;
+  ModelResources& operator=(const ModelResources&) = delete;
+
+  /// The shared flatbuffer model. Pass it to every `InterpreterBuilder` so
+  /// the interpreters reference one mapped copy of the weights.
+  const FlatBufferModel* model() const { return model_.get(); }
+
+  /// Returns an XNNPACK delegate that repacks its weights into the cache
+  /// shared by all delegates created from this object. Every interpreter
+  /// needs its own delegate; pass it to `InterpreterBuilder::AddDelegate`.
+  /// Returns nullptr when TFLite was built without the XNNPACK delegate.
+  TfLiteDelegatePtr CreateXNNPackDelegate(int num_threads);
+
+  /// Finalizes the shared weights cache. Must be called after the first
+  /// interpreter using a delegate from `CreateXNNPackDelegate` has allocated
+  /// its tensors and before any interpreter is invoked; interpreters built
+  /// afterwards look up the already-packed weights. Returns false on failure.
+  bool FinalizeWeightsCache();
+
+  /// Like `FinalizeWeightsCache`, but freezes the cache and trims it to its
+  /// smallest possible size. Use this instead of `FinalizeWeightsCache` in
+  /// deployments where the number of interpreters is fixed and all of them
+  /// are created up front: `CreateXNNPackDelegate` must not be called after
+  /// this. Returns false on failure.
+  bool HardFinalizeWeightsCache();
+
+  /// A CPU backend context that the interpreters of this model can share by
+  /// attaching it via
+  /// `interpreter->SetExternalContext(kTfLiteCpuBackendContext, ...)`, so
+  /// they use one thread pool and one cache of prepacked constant weights
+  /// instead of packing the weights per interpreter. The context has weight
+  /// caching enabled. Sharing is only safe when the interpreters are invoked
+  /// serially; see the `ExternalCpuBackendContext` class comment.
+  ExternalCpuBackendContext* external_cpu_backend_context();
+
+ private:
+  std::unique_ptr<FlatBufferModel> model_;
+  // Opaque `TfLiteXNNPackDelegateWeightsCache*`; created lazily by
+  // `CreateXNNPackDelegate`. Null when TFLite was built without XNNPACK.
+  void* xnnpack_weights_cache_;
+  // Created lazily by `external_cpu_backend_context`.
+  std::unique_ptr<ExternalCpuBackendContext> external_cpu_backend_context_;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MODEL_RESOURCES_H_
@@ -0,0 +1,171 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/model_resources.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+namespace {
+
+// This is specific to the testdata/add.bin model used in the test.
+void InitInputTensorData(Interpreter* interpreter) {
+  ASSERT_EQ(interpreter->inputs().size(), 1);
+  TfLiteTensor* t = interpreter->input_tensor(0);
+  ASSERT_EQ(t->type, kTfLiteFloat32);
+  float* data = static_cast<float*>(t->data.data);
+  int num_elements = t->bytes / sizeof(float);
+  std::fill(data, data + num_elements, 1.0f);
+}
+
+TEST(ModelResourcesTest, ShareAcrossInterpreters) {
+  auto model =
+      FlatBufferModel::BuildFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_TRUE(model);
+  ModelResources resources(std::move(model));
+  ASSERT_NE(resources.model(), nullptr);
+
+  constexpr int kNumInterpreters = 3;
+  std::vector<ModelResources::TfLiteDelegatePtr> delegates;
+  std::vector<std::unique_ptr<Interpreter>> interpreters;
+  for (int i = 0; i < kNumInterpreters; ++i) {
+    // Each interpreter gets its own delegate; all delegates repack their
+    // weights into the cache owned by `resources`.
+    auto delegate = resources.CreateXNNPackDelegate(/*num_threads=*/1);
+    std::unique_ptr<Interpreter> interpreter;
+    InterpreterBuilder builder(
+        *resources.model(),
+        ops::builtin::BuiltinOpResolverWithoutDefaultDelegates());
+    if (delegate) {
+      builder.AddDelegate(delegate.get());
+    }
+    ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+    ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+    if (i == 0) {
+      // The first interpreter populates the weights cache; subsequent ones
+      // look up the already-packed weights.
+      ASSERT_TRUE(resources.FinalizeWeightsCache());
+    }
+    delegates.push_back(std::move(delegate));
+    interpreters.push_back(std::move(interpreter));
+  }
+
+  // All interpreters compute the same result from the shared weights.
+  for (auto& interpreter : interpreters) {
+    InitInputTensorData(interpreter.get());
+    ASSERT_EQ(interpreter->Invoke(), kTfLiteOk);
+    const TfLiteTensor* output = interpreter->output_tensor(0);
+    const float* data = static_cast<const float*>(output->data.data);
+    int num_elements = output->bytes / sizeof(float);
+    for (int i = 0; i < num_elements; ++i) {
+      EXPECT_FLOAT_EQ(data[i], 3.0f);
+    }
+  }
+
+  // Delegates must be destroyed before the resources they draw from.
+  interpreters.clear();
+  delegates.clear();
+}
+
+TEST(ModelResourcesTest, HardFinalizeWeightsCache) {
+  auto model =
+      FlatBufferModel::BuildFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_TRUE(model);
+  ModelResources resources(std::move(model));
+
+  // With hard finalization all interpreters must be created up front; the
+  // cache is then frozen and trimmed before the first invocation.
+  constexpr int kNumInterpreters = 2;
+  std::vector<ModelResources::TfLiteDelegatePtr> delegates;
+  std::vector<std::unique_ptr<Interpreter>> interpreters;
+  for (int i = 0; i < kNumInterpreters; ++i) {
+    auto delegate = resources.CreateXNNPackDelegate(/*num_threads=*/1);
+    std::unique_ptr<Interpreter> interpreter;
+    InterpreterBuilder builder(
+        *resources.model(),
+        ops::builtin::BuiltinOpResolverWithoutDefaultDelegates());
+    if (delegate) {
+      builder.AddDelegate(delegate.get());
+    }
+    ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+    ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+    delegates.push_back(std::move(delegate));
+    interpreters.push_back(std::move(interpreter));
+  }
+  ASSERT_TRUE(resources.HardFinalizeWeightsCache());
+
+  for (auto& interpreter : interpreters) {
+    InitInputTensorData(interpreter.get());
+    ASSERT_EQ(interpreter->Invoke(), kTfLiteOk);
+    const TfLiteTensor* output = interpreter->output_tensor(0);
+    const float* data = static_cast<const float*>(output->data.data);
+    int num_elements = output->bytes / sizeof(float);
+    for (int i = 0; i < num_elements; ++i) {
+      EXPECT_FLOAT_EQ(data[i], 3.0f);
+    }
+  }
+
+  interpreters.clear();
+  delegates.clear();
+}
+
+TEST(ModelResourcesTest, SharedCpuBackendContext) {
+  auto model =
+      FlatBufferModel::BuildFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_TRUE(model);
+  ModelResources resources(std::move(model));
+  ASSERT_NE(resources.external_cpu_backend_context(), nullptr);
+  EXPECT_TRUE(resources.external_cpu_backend_context()->use_caching());
+
+  // Interpreters sharing the context must be invoked serially.
+  constexpr int kNumInterpreters = 2;
+  std::vector<std::unique_ptr<Interpreter>> interpreters;
+  for (int i = 0; i < kNumInterpreters; ++i) {
+    std::unique_ptr<Interpreter> interpreter;
+    InterpreterBuilder builder(
+        *resources.model(),
+        ops::builtin::BuiltinOpResolverWithoutDefaultDelegates());
+    ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+    interpreter->SetExternalContext(kTfLiteCpuBackendContext,
+                                    resources.external_cpu_backend_context());
+    ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+    interpreters.push_back(std::move(interpreter));
+  }
+
+  for (auto& interpreter : interpreters) {
+    InitInputTensorData(interpreter.get());
+    ASSERT_EQ(interpreter->Invoke(), kTfLiteOk);
+    const TfLiteTensor* output = interpreter->output_tensor(0);
+    const float* data = static_cast<const float*>(output->data.data);
+    int num_elements = output->bytes / sizeof(float);
+    for (int i = 0; i < num_elements; ++i) {
+      EXPECT_FLOAT_EQ(data[i], 3.0f);
+    }
+  }
+
+  // Interpreters must be destroyed before the shared context.
+  interpreters.clear();
+}
+
+}  // namespace
+}  // namespace tflite
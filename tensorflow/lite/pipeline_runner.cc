@@ -0,0 +1,99 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/pipeline_runner.h"
+
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+namespace tflite {
+namespace {
+
+// Tells whether the outputs of `from` can feed the inputs of `to`.
+bool BoundaryMatches(const Interpreter* from, const Interpreter* to) {
+  if (from->outputs().size() != to->inputs().size()) return false;
+  for (size_t i = 0; i < from->outputs().size(); ++i) {
+    const TfLiteTensor* output = from->output_tensor(i);
+    const TfLiteTensor* input = to->input_tensor(i);
+    if (output == nullptr || input == nullptr) return false;
+    if (output->type != input->type || output->bytes != input->bytes) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+std::unique_ptr<PipelineRunner> PipelineRunner::Create(
+    std::vector<Interpreter*> stages) {
+  if (stages.empty()) return nullptr;
+  for (Interpreter* stage : stages) {
+    if (stage == nullptr) return nullptr;
+  }
+  for (size_t i = 0; i + 1 < stages.size(); ++i) {
+    if (!BoundaryMatches(stages[i], stages[i + 1])) return nullptr;
+  }
+  return std::unique_ptr<PipelineRunner>(new PipelineRunner(std::move(stages)));
+}
+
+PipelineRunner::PipelineRunner(std::vector<Interpreter*> stages)
+    : stages_(std::move(stages)), stage_has_frame_(stages_.size(), false) {}
+
+void PipelineRunner::HandOff(int stage_index) {
+  Interpreter* from = stages_[stage_index];
+  Interpreter* to = stages_[stage_index + 1];
+  for (size_t i = 0; i < from->outputs().size(); ++i) {
+    const TfLiteTensor* output = from->output_tensor(i);
+    TfLiteTensor* input = to->input_tensor(i);
+    std::memcpy(input->data.raw, output->data.raw, output->bytes);
+  }
+}
+
+TfLiteStatus PipelineRunner::Step(bool feed) {
+  const int num_stages = stages_.size();
+  if (feed) stage_has_frame_[0] = true;
+  // The frame completed on this tick is the one the last stage holds now.
+  output_ready_ = stage_has_frame_[num_stages - 1];
+
+  std::vector<TfLiteStatus> statuses(num_stages, kTfLiteOk);
+  std::vector<std::thread> workers;
+  for (int k = 1; k < num_stages; ++k) {
+    if (!stage_has_frame_[k]) continue;
+    workers.emplace_back(
+        [this, k, &statuses] { statuses[k] = stages_[k]->Invoke(); });
+  }
+  if (stage_has_frame_[0]) statuses[0] = stages_[0]->Invoke();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // Hand completed frames to the next stage and shift the occupancy; the
+  // copies run while no stage executes, so they double-buffer the boundary.
+  for (int k = num_stages - 2; k >= 0; --k) {
+    if (stage_has_frame_[k]) HandOff(k);
+    stage_has_frame_[k + 1] = stage_has_frame_[k];
+  }
+  stage_has_frame_[0] = false;
+
+  for (TfLiteStatus status : statuses) {
+    if (status != kTfLiteOk) return status;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace tflite
@@ -0,0 +1,113 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+/// \file
+/// Pipelines a stream of frames through a chain of interpreters so the
+/// stages run concurrently on different processors.
+///
+#ifndef TENSORFLOW_LITE_PIPELINE_RUNNER_H_
+#define TENSORFLOW_LITE_PIPELINE_RUNNER_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+
+namespace tflite {
+
+/// Runs a model split into a chain of stage interpreters as a pipeline:
+/// while stage k processes frame t, stage k+1 processes frame t-1, so a
+/// stream of frames approaches the combined throughput of the processors
+/// the stages are delegated to (e.g. a GPU-delegated front half and a CPU
+/// back half), instead of their serialized latency.
+///
+/// Each `Step` invokes every stage that holds a frame, in parallel on one
+/// thread per stage, and then hands each stage's outputs to the next
+/// stage's inputs. The hand-off copies run between ticks, while no stage
+/// executes, so a stage may freely overwrite its outputs on the next tick.
+///
+/// Expected usage for a stream of frames:
+///
+///   auto runner = PipelineRunner::Create({front.get(), back.get()});
+///   for each frame:
+///     fill runner->input_tensor(...);
+///     runner->Step();
+///     if (runner->output_ready()) read runner->output_tensor(...);
+///   // Drain the in-flight frames at end of stream.
+///   while (runner->Step(/*feed=*/false), runner->output_ready()) ...;
+///
+/// The stage boundary is the interpreter rather than the delegate
+/// partitions inside one subgraph: partitions share their subgraph's memory
+/// arena and context, so overlapping them would corrupt intermediate
+/// tensors. Splitting the model at the delegate boundary yields the same
+/// pipeline with each stage's tensors owned by its own interpreter.
+/// WARNING: This is an experimental API and subject to change.
+class PipelineRunner {
+ public:
+  /// Creates a runner over `stages`, ordered from first to last. The stages
+  /// are borrowed, must already have their tensors allocated, and each
+  /// stage's outputs must match the next stage's inputs in count, type and
+  /// byte size. Returns nullptr if the chain is empty or the boundaries do
+  /// not match.
+  static std::unique_ptr<PipelineRunner> Create(
+      std::vector<Interpreter*> stages);
+
+  PipelineRunner(const PipelineRunner&) = delete;
+  PipelineRunner& operator=(const PipelineRunner&) = delete;
+
+  int num_stages() const { return stages_.size(); }
+
+  /// The input tensor at `input_index` of the first stage. Fill it with the
+  /// next frame before calling `Step` with `feed` set.
+  TfLiteTensor* input_tensor(int input_index) {
+    return stages_.front()->input_tensor(input_index);
+  }
+
+  /// The output tensor at `output_index` of the last stage. Only holds a
+  /// completed frame when `output_ready` is true; frames come out in the
+  /// order they were fed, `num_stages()` steps later.
+  const TfLiteTensor* output_tensor(int output_index) const {
+    return stages_.back()->output_tensor(output_index);
+  }
+
+  /// Advances the pipeline one tick: every stage holding a frame is invoked
+  /// in parallel, then each stage's outputs are copied into the next
+  /// stage's inputs. When `feed` is true the current contents of the first
+  /// stage's input tensors enter the pipeline as a new frame; pass false to
+  /// drain the frames still in flight. Returns kTfLiteOk only if every
+  /// invoked stage succeeded.
+  TfLiteStatus Step(bool feed = true);
+
+  /// True if the last `Step` completed a frame, i.e. the last stage's
+  /// output tensors hold a result.
+  bool output_ready() const { return output_ready_; }
+
+ private:
+  explicit PipelineRunner(std::vector<Interpreter*> stages);
+
+  // Copies the outputs of stage `stage_index` into the inputs of the next
+  // stage.
+  void HandOff(int stage_index);
+
+  std::vector<Interpreter*> stages_;
+  // stage_has_frame_[k] tells whether stage k's inputs hold a frame that
+  // the next Step should process.
+  std::vector<bool> stage_has_frame_;
+  bool output_ready_ = false;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_PIPELINE_RUNNER_H_
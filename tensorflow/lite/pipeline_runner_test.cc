@@ -0,0 +1,95 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/pipeline_runner.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+namespace {
+
+std::unique_ptr<Interpreter> BuildStage(const FlatBufferModel& model) {
+  std::unique_ptr<Interpreter> interpreter;
+  InterpreterBuilder builder(
+      model, ops::builtin::BuiltinOpResolverWithoutDefaultDelegates());
+  if (builder(&interpreter) != kTfLiteOk) return nullptr;
+  if (interpreter->AllocateTensors() != kTfLiteOk) return nullptr;
+  return interpreter;
+}
+
+void FillInput(PipelineRunner* runner, float value) {
+  TfLiteTensor* input = runner->input_tensor(0);
+  float* data = static_cast<float*>(input->data.data);
+  std::fill(data, data + input->bytes / sizeof(float), value);
+}
+
+void ExpectOutput(PipelineRunner* runner, float expected) {
+  const TfLiteTensor* output = runner->output_tensor(0);
+  const float* data = static_cast<const float*>(output->data.data);
+  int num_elements = output->bytes / sizeof(float);
+  for (int i = 0; i < num_elements; ++i) {
+    ASSERT_FLOAT_EQ(data[i], expected);
+  }
+}
+
+TEST(PipelineRunnerTest, StreamsFramesThroughTwoStages) {
+  // testdata/add.bin maps x to 3x and its output shape matches its input
+  // shape, so two copies chain into a two-stage pipeline computing 9x.
+  auto model =
+      FlatBufferModel::BuildFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_TRUE(model);
+  auto front = BuildStage(*model);
+  auto back = BuildStage(*model);
+  ASSERT_NE(front, nullptr);
+  ASSERT_NE(back, nullptr);
+
+  auto runner = PipelineRunner::Create({front.get(), back.get()});
+  ASSERT_NE(runner, nullptr);
+  ASSERT_EQ(runner->num_stages(), 2);
+
+  // Frames come out in order, two steps after they were fed.
+  constexpr int kNumFrames = 4;
+  int frames_out = 0;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    FillInput(runner.get(), frame + 1.0f);
+    ASSERT_EQ(runner->Step(), kTfLiteOk);
+    if (runner->output_ready()) {
+      ExpectOutput(runner.get(), 9.0f * ++frames_out);
+    }
+  }
+  // Drain the frames still in flight.
+  while (frames_out < kNumFrames) {
+    ASSERT_EQ(runner->Step(/*feed=*/false), kTfLiteOk);
+    ASSERT_TRUE(runner->output_ready());
+    ExpectOutput(runner.get(), 9.0f * ++frames_out);
+  }
+  // The pipeline is empty now.
+  ASSERT_EQ(runner->Step(/*feed=*/false), kTfLiteOk);
+  EXPECT_FALSE(runner->output_ready());
+}
+
+TEST(PipelineRunnerTest, RejectsEmptyChain) {
+  EXPECT_EQ(PipelineRunner::Create({}), nullptr);
+}
+
+}  // namespace
+}  // namespace tflite
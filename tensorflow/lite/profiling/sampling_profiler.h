@@ -0,0 +1,154 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_SAMPLING_PROFILER_H_
+#define TENSORFLOW_LITE_PROFILING_SAMPLING_PROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/lite/core/api/profiler.h"
+#include "tensorflow/lite/profiling/profile_buffer.h"
+#include "tensorflow/lite/profiling/time.h"
+
+namespace tflite {
+namespace profiling {
+
+// A profiler cheap enough to stay attached in production. Unlike
+// BufferedProfiler, which records every event and allocates a std::string tag
+// per entry, this profiler records only every `sampling_period`-th operator
+// invocation (1 in 100 by default, ~1% of ops) into a fixed ring of
+// plain-old-data entries; a skipped event costs one counter increment.
+//
+// The ring keeps the most recent `max_num_entries` samples, so over time it
+// holds a latency sample of the ops the interpreter actually runs, which is
+// enough to track per-op latency distributions across a device fleet.
+// GENERAL_RUNTIME_INSTRUMENTATION_EVENTs, i.e. the reports delegates emit
+// through delegates/telemetry.h, are rare and always recorded, never sampled
+// out.
+//
+// Events must be produced from one thread (the invoking thread, as for the
+// other profilers here), but GetSamples() may be called concurrently from
+// another thread: the ring head is published with release/acquire ordering
+// and neither side ever blocks. Entries keep the tag as a pointer; the tags
+// the runtime passes are the operator names owned by the interpreter, so
+// samples must not outlive it.
+class SamplingProfiler : public tflite::Profiler {
+ public:
+  // A recorded event. POD so that recording a sample is a few stores.
+  struct SampledEvent {
+    // Borrowed label of the event; owned by the producer of the event.
+    const char* tag;
+    EventType event_type;
+    // Timestamp in microseconds when the event began.
+    uint64_t begin_timestamp_us;
+    // Event processing time in microseconds.
+    uint64_t elapsed_time_us;
+    // Meta data associated w/ the event; for an OPERATOR_INVOKE_EVENT the
+    // first is the op index and the second the subgraph index.
+    int64_t event_metadata;
+    int64_t extra_event_metadata;
+  };
+
+  explicit SamplingProfiler(uint32_t max_num_entries,
+                            uint32_t sampling_period = 100)
+      : ring_(max_num_entries > 0 ? max_num_entries : 1),
+        sampling_period_(sampling_period > 0 ? sampling_period : 1) {}
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override {
+    if (event_type != EventType::OPERATOR_INVOKE_EVENT) {
+      return kInvalidEventHandle;
+    }
+    if (++event_count_ % sampling_period_ != 0) return kInvalidEventHandle;
+    // At most one sampled event may be outstanding; a nested sampled op is
+    // dropped rather than tracked.
+    if (pending_) return kInvalidEventHandle;
+    pending_ = true;
+    SampledEvent& event = ring_[head_.load(std::memory_order_relaxed) %
+                                ring_.size()];
+    event.tag = tag;
+    event.event_type = event_type;
+    event.begin_timestamp_us = time::NowMicros();
+    event.elapsed_time_us = 0;
+    event.event_metadata = event_metadata1;
+    event.extra_event_metadata = event_metadata2;
+    return head_.load(std::memory_order_relaxed) % ring_.size();
+  }
+
+  void EndEvent(uint32_t event_handle) override {
+    if (!pending_ || event_handle == kInvalidEventHandle) return;
+    SampledEvent& event = ring_[event_handle];
+    event.elapsed_time_us = time::NowMicros() - event.begin_timestamp_us;
+    pending_ = false;
+    // Publishes the entry; GetSamples() never reads past the head.
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  void AddEvent(const char* tag, EventType event_type, uint64_t elapsed_time,
+                int64_t event_metadata1, int64_t event_metadata2) override {
+    // Delegate telemetry reports are always recorded; they are far too rare
+    // to be worth sampling and too valuable to lose.
+    if (event_type != EventType::GENERAL_RUNTIME_INSTRUMENTATION_EVENT) return;
+    // A sampled op still in flight holds the slot at the head; give the slot
+    // to the telemetry event and drop the op sample instead.
+    pending_ = false;
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    SampledEvent& event = ring_[head % ring_.size()];
+    event.tag = tag;
+    event.event_type = event_type;
+    event.begin_timestamp_us = 0;
+    event.elapsed_time_us = elapsed_time;
+    event.event_metadata = event_metadata1;
+    event.extra_event_metadata = event_metadata2;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Copies the recorded samples, oldest first. Safe to call from a thread
+  // other than the producing one; samples recorded concurrently with the
+  // call may or may not be included.
+  std::vector<SampledEvent> GetSamples() const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t size = ring_.size();
+    // Once the ring has wrapped, the oldest slot is the one the producer may
+    // be writing into; leave it out so no entry is ever read while written.
+    const uint64_t count = head < size ? head : size - 1;
+    std::vector<SampledEvent> samples;
+    samples.reserve(count);
+    for (uint64_t i = head - count; i < head; ++i) {
+      samples.push_back(ring_[i % size]);
+    }
+    return samples;
+  }
+
+  // The number of operator invocations seen, sampled or not.
+  uint64_t num_events_seen() const { return event_count_; }
+
+ private:
+  std::vector<SampledEvent> ring_;
+  const uint32_t sampling_period_;
+  uint64_t event_count_ = 0;
+  bool pending_ = false;
+  // Total number of published samples; the next write goes to
+  // ring_[head_ % ring_.size()].
+  std::atomic<uint64_t> head_{0};
+};
+
+}  // namespace profiling
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_PROFILING_SAMPLING_PROFILER_H_
@@ -0,0 +1,88 @@
+/* Copyright 2022 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/profiling/sampling_profiler.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace profiling {
+namespace {
+
+void InvokeOp(SamplingProfiler* profiler, const char* tag, int op_index) {
+  auto handle = profiler->BeginEvent(
+      tag, Profiler::EventType::OPERATOR_INVOKE_EVENT, op_index,
+      /*event_metadata2=*/0);
+  profiler->EndEvent(handle);
+}
+
+TEST(SamplingProfilerTest, SamplesAtConfiguredPeriod) {
+  SamplingProfiler profiler(/*max_num_entries=*/16, /*sampling_period=*/4);
+  const char* kTags[] = {"op1", "op2", "op3", "op4"};
+  for (int i = 0; i < 8; ++i) {
+    InvokeOp(&profiler, kTags[i % 4], i);
+  }
+  EXPECT_EQ(profiler.num_events_seen(), 8);
+  auto samples = profiler.GetSamples();
+  // Every 4th operator invocation is sampled.
+  ASSERT_EQ(samples.size(), 2);
+  EXPECT_EQ(std::string(samples[0].tag), "op4");
+  EXPECT_EQ(samples[0].event_metadata, 3);
+  EXPECT_EQ(std::string(samples[1].tag), "op4");
+  EXPECT_EQ(samples[1].event_metadata, 7);
+}
+
+TEST(SamplingProfilerTest, RingKeepsMostRecentSamples) {
+  SamplingProfiler profiler(/*max_num_entries=*/4, /*sampling_period=*/1);
+  for (int i = 0; i < 10; ++i) {
+    InvokeOp(&profiler, "op", i);
+  }
+  auto samples = profiler.GetSamples();
+  // Once wrapped, the ring serves all entries but the one under the write
+  // head, oldest first.
+  ASSERT_EQ(samples.size(), 3);
+  EXPECT_EQ(samples[0].event_metadata, 7);
+  EXPECT_EQ(samples[1].event_metadata, 8);
+  EXPECT_EQ(samples[2].event_metadata, 9);
+}
+
+TEST(SamplingProfilerTest, IgnoresNonOperatorEvents) {
+  SamplingProfiler profiler(/*max_num_entries=*/16, /*sampling_period=*/1);
+  auto handle = profiler.BeginEvent(
+      "graph", Profiler::EventType::DEFAULT, /*event_metadata1=*/0,
+      /*event_metadata2=*/0);
+  EXPECT_EQ(handle, kInvalidEventHandle);
+  profiler.EndEvent(handle);
+  EXPECT_EQ(profiler.num_events_seen(), 0);
+  EXPECT_TRUE(profiler.GetSamples().empty());
+}
+
+TEST(SamplingProfilerTest, AlwaysRecordsInstrumentationEvents) {
+  SamplingProfiler profiler(/*max_num_entries=*/16,
+                            /*sampling_period=*/1000);
+  profiler.AddEvent("delegate_status",
+                    Profiler::EventType::GENERAL_RUNTIME_INSTRUMENTATION_EVENT,
+                    /*elapsed_time=*/0, /*event_metadata1=*/42,
+                    /*event_metadata2=*/0);
+  auto samples = profiler.GetSamples();
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_EQ(std::string(samples[0].tag), "delegate_status");
+  EXPECT_EQ(samples[0].event_metadata, 42);
+}
+
+}  // namespace
+}  // namespace profiling
+}  // namespace tflite
@@ -93,5 +93,52 @@ TEST(SignatureRunnerTest, TestMultiSignatures) {
   ASSERT_EQ(sub_output->data.f[2], 3);
 }
 
+TEST(SignatureRunnerTest, TestMultiSignaturesLazyBuild) {
+  TestErrorReporter reporter;
+  auto model = FlatBufferModel::BuildFromFile(
+      "tensorflow/lite/testdata/multi_signatures.bin", &reporter);
+  ASSERT_TRUE(model);
+  ops::builtin::BuiltinOpResolver resolver;
+  InterpreterBuilder builder(*model, resolver);
+  builder.LazilyBuildSubgraphsExperimental();
+
+  std::unique_ptr<Interpreter> interpreter;
+  ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(interpreter->GetSignatureRunner("dummy"), nullptr);
+
+  // The subgraphs behind the signatures are built on first request; the
+  // runners must behave as if they had been built eagerly.
+  SignatureRunner* add_runner = interpreter->GetSignatureRunner("add");
+  ASSERT_NE(add_runner, nullptr);
+  ASSERT_EQ(add_runner->ResizeInputTensor("x", {2}), kTfLiteOk);
+  ASSERT_EQ(add_runner->AllocateTensors(), kTfLiteOk);
+  TfLiteTensor* add_input = add_runner->input_tensor("x");
+  const TfLiteTensor* add_output = add_runner->output_tensor("output_0");
+  ASSERT_NE(add_input, nullptr);
+  ASSERT_NE(add_output, nullptr);
+  add_input->data.f[0] = 2;
+  add_input->data.f[1] = 4;
+  ASSERT_EQ(add_runner->Invoke(), kTfLiteOk);
+  ASSERT_EQ(add_output->data.f[0], 4);
+  ASSERT_EQ(add_output->data.f[1], 6);
+
+  SignatureRunner* sub_runner = interpreter->GetSignatureRunner("sub");
+  ASSERT_NE(sub_runner, nullptr);
+  ASSERT_EQ(sub_runner->ResizeInputTensor("x", {3}), kTfLiteOk);
+  ASSERT_EQ(sub_runner->AllocateTensors(), kTfLiteOk);
+  TfLiteTensor* sub_input = sub_runner->input_tensor("x");
+  const TfLiteTensor* sub_output = sub_runner->output_tensor("output_0");
+  ASSERT_NE(sub_input, nullptr);
+  ASSERT_NE(sub_output, nullptr);
+  sub_input->data.f[0] = 2;
+  sub_input->data.f[1] = 4;
+  sub_input->data.f[2] = 6;
+  ASSERT_EQ(sub_runner->Invoke(), kTfLiteOk);
+  ASSERT_EQ(sub_output->data.f[0], -1);
+  ASSERT_EQ(sub_output->data.f[1], 1);
+  ASSERT_EQ(sub_output->data.f[2], 3);
+}
+
 }  // namespace
 }  // namespace tflite
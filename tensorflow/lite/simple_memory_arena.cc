@@ -17,13 +17,19 @@ limitations under the License.
 
 #include <stddef.h>
 #include <stdint.h>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include <algorithm>
 #include <cstring>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/lite/c/common.h"
@@ -40,6 +46,61 @@ T AlignTo(size_t alignment, T offset) {
 }  // namespace
 
 namespace tflite {
+
+ArenaBufferPool* ArenaBufferPool::GetProcessPool() {
+  static ArenaBufferPool* pool = new ArenaBufferPool();
+  return pool;
+}
+
+std::unique_ptr<char[]> ArenaBufferPool::TakeBuffer(size_t size,
+                                                    size_t* actual_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Return the smallest pooled buffer that is still large enough, so big
+  // buffers stay available for the arenas that need them.
+  auto best_it = buffers_.end();
+  for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+    if (it->first >= size &&
+        (best_it == buffers_.end() || it->first < best_it->first)) {
+      best_it = it;
+    }
+  }
+  if (best_it == buffers_.end()) {
+    return nullptr;
+  }
+  std::unique_ptr<char[]> buffer = std::move(best_it->second);
+  *actual_size = best_it->first;
+  buffers_.erase(best_it);
+  return buffer;
+}
+
+void ArenaBufferPool::ReturnBuffer(std::unique_ptr<char[]> buffer,
+                                   size_t size) {
+  if (buffer == nullptr || size == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.emplace_back(size, std::move(buffer));
+}
+
+void ArenaBufferPool::DecommitBuffers() {
+  std::lock_guard<std::mutex> lock(mutex_);
+#if !defined(_WIN32)
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  for (auto& buffer : buffers_) {
+    // Only whole pages strictly inside the buffer can be returned to the
+    // system; the first and last partial pages may share heap pages with
+    // neighboring allocations.
+    const uintptr_t start = reinterpret_cast<uintptr_t>(buffer.second.get());
+    const uintptr_t aligned_start = AlignTo(page_size, start);
+    const uintptr_t aligned_end = (start + buffer.first) & ~(page_size - 1);
+    if (aligned_start < aligned_end) {
+      madvise(reinterpret_cast<void*>(aligned_start),
+              aligned_end - aligned_start, MADV_DONTNEED);
+    }
+  }
+#endif
+}
+
 TfLiteStatus SimpleMemoryArena::Allocate(
     TfLiteContext* context, size_t alignment, size_t size, int32_t tensor,
     int32_t first_node, int32_t last_node,
@@ -114,7 +175,18 @@ TfLiteStatus SimpleMemoryArena::Deallocate(
 TfLiteStatus SimpleMemoryArena::Commit(TfLiteContext* context) {
   size_t required_size = RequiredBufferSize();
   if (required_size > underlying_buffer_size_) {
-    char* new_alloc = new char[required_size];
+    // Prefer recycling a buffer released by another arena over allocating a
+    // fresh one.
+    size_t new_size = 0;
+    std::unique_ptr<char[]> new_buffer;
+    if (buffer_pool_ != nullptr) {
+      new_buffer = buffer_pool_->TakeBuffer(required_size, &new_size);
+    }
+    if (new_buffer == nullptr) {
+      new_size = required_size;
+      new_buffer.reset(new char[required_size]);
+    }
+    char* new_alloc = new_buffer.get();
     char* new_underlying_buffer_aligned_ptr = reinterpret_cast<char*>(
         AlignTo(arena_alignment_, reinterpret_cast<intptr_t>(new_alloc)));
 
@@ -125,13 +197,17 @@ TfLiteStatus SimpleMemoryArena::Commit(TfLiteContext* context) {
       size_t copy_amount = std::min(
           underlying_buffer_.get() + underlying_buffer_size_ -
               underlying_buffer_aligned_ptr_,
-          new_alloc + required_size - new_underlying_buffer_aligned_ptr);
+          new_alloc + new_size - new_underlying_buffer_aligned_ptr);
       memcpy(new_underlying_buffer_aligned_ptr, underlying_buffer_aligned_ptr_,
              copy_amount);
     }
 
-    underlying_buffer_.reset(new_alloc);
-    underlying_buffer_size_ = required_size;
+    if (buffer_pool_ != nullptr) {
+      buffer_pool_->ReturnBuffer(std::move(underlying_buffer_),
+                                 underlying_buffer_size_);
+    }
+    underlying_buffer_ = std::move(new_buffer);
+    underlying_buffer_size_ = new_size;
     underlying_buffer_aligned_ptr_ = new_underlying_buffer_aligned_ptr;
   }
   committed_ = true;
@@ -162,6 +238,10 @@ TfLiteStatus SimpleMemoryArena::ClearPlan() {
 
 TfLiteStatus SimpleMemoryArena::ReleaseBuffer() {
   committed_ = false;
+  if (buffer_pool_ != nullptr) {
+    buffer_pool_->ReturnBuffer(std::move(underlying_buffer_),
+                               underlying_buffer_size_);
+  }
   underlying_buffer_size_ = 0;
   underlying_buffer_aligned_ptr_ = nullptr;
   underlying_buffer_.reset();
@@ -19,7 +19,9 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/lite/c/common.h"
@@ -55,6 +57,42 @@ struct ArenaAllocWithUsageInterval {
   }
 };
 
+// A pool of heap buffers that can be recycled between memory arenas whose
+// owners never execute at the same time, e.g. the subgraphs of a model with
+// control flow. When an arena with a pool attached releases its underlying
+// buffer, the buffer is returned to the pool instead of the system, and the
+// next arena that commits draws the best-fitting pooled buffer rather than
+// allocating a fresh one. This keeps the peak memory of such a model
+// proportional to the subgraphs that are live together on one call path,
+// rather than to all subgraphs. The pool is thread-safe so that it can also
+// be shared by interpreters running on different threads.
+class ArenaBufferPool {
+ public:
+  // Returns a pool shared by the whole process, allowing interpreters that
+  // run the same model in parallel to reuse one another's released arena
+  // buffers. The returned pool is never destroyed.
+  static ArenaBufferPool* GetProcessPool();
+
+  // Removes and returns the smallest pooled buffer of at least `size` bytes,
+  // storing the buffer's capacity in `actual_size`. Returns nullptr when no
+  // pooled buffer is large enough.
+  std::unique_ptr<char[]> TakeBuffer(size_t size, size_t* actual_size);
+
+  // Adds `buffer` of `size` bytes to the pool for later reuse.
+  void ReturnBuffer(std::unique_ptr<char[]> buffer, size_t size);
+
+  // Returns the physical pages backing the pooled buffers to the operating
+  // system where supported. The buffers stay in the pool and remain usable;
+  // their contents become undefined and the pages fault back in on next use.
+  // Intended to be called when the pool's owner goes idle. No-op on platforms
+  // without madvise().
+  void DecommitBuffers();
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::pair<size_t, std::unique_ptr<char[]>>> buffers_;
+};
+
 // This small class is responsible for allocating, deallocating and reusing
 // dynamic memory from a common underlying buffer. The arena can be used in
 // scenarios when the pattern of memory allocations and deallocations is
@@ -67,7 +105,15 @@ class SimpleMemoryArena {
         arena_alignment_(arena_alignment),
         high_water_mark_(0),
         underlying_buffer_size_(0),
-        ordered_allocs_() {}
+        ordered_allocs_(),
+        buffer_pool_(nullptr) {}
+
+  // Attaches a pool that the underlying buffer is drawn from on Commit() and
+  // returned to on ReleaseBuffer(). Should only be used when the owners of
+  // all arenas sharing `pool` never execute at the same time. Must be called
+  // before the first Commit(). `pool` is not owned and must outlive the
+  // arena's last Commit() or ReleaseBuffer() call.
+  void SetBufferPool(ArenaBufferPool* pool) { buffer_pool_ = pool; }
 
   // Schedule memory allocation for a tensor with a given size, assuming that it
   // needs to be allocated before the execution of first_node, and deallocated
@@ -133,6 +179,8 @@ class SimpleMemoryArena {
   size_t underlying_buffer_size_;
   char* underlying_buffer_aligned_ptr_;
   std::vector<ArenaAllocWithUsageInterval> ordered_allocs_;
+  // Optional pool shared with other arenas. Not owned.
+  ArenaBufferPool* buffer_pool_;
 };
 
 }  // namespace tflite
@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/simple_memory_arena.h"
 
+#include <cstdint>
+#include <cstring>
+
 #include <gtest/gtest.h>
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/testing/util.h"
@@ -156,6 +159,70 @@ TEST(SimpleMemoryArenaTest, TestClearBuffer) {
   EXPECT_NE(resolved_ptr, nullptr);
 }
 
+TEST(SimpleMemoryArenaTest, TestBufferPoolReuse) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+  ArenaBufferPool pool;
+  SimpleMemoryArena arena1(64);
+  SimpleMemoryArena arena2(64);
+  arena1.SetBufferPool(&pool);
+  arena2.SetBufferPool(&pool);
+
+  ArenaAllocWithUsageInterval allocs[3];
+  arena1.Allocate(&context, 32, 2047, 0, 0, 2, &allocs[0]);
+  arena1.Allocate(&context, 32, 2047, 1, 1, 2, &allocs[1]);
+  ASSERT_EQ(arena1.Commit(&context), kTfLiteOk);
+  const std::intptr_t base1 = arena1.BasePointer();
+  ASSERT_NE(base1, 0);
+
+  // Releasing returns the underlying buffer to the pool rather than the
+  // system, and the next arena whose plan fits the pooled buffer reuses it.
+  ASSERT_EQ(arena1.ReleaseBuffer(), kTfLiteOk);
+  arena2.Allocate(&context, 32, 1023, 0, 0, 2, &allocs[2]);
+  ASSERT_EQ(arena2.Commit(&context), kTfLiteOk);
+  EXPECT_EQ(arena2.BasePointer(), base1);
+
+  // A plan that doesn't fit the pooled buffer gets a fresh one.
+  ASSERT_EQ(arena2.ReleaseBuffer(), kTfLiteOk);
+  SimpleMemoryArena arena3(64);
+  arena3.SetBufferPool(&pool);
+  ArenaAllocWithUsageInterval large_alloc;
+  arena3.Allocate(&context, 32, 32767, 0, 0, 2, &large_alloc);
+  ASSERT_EQ(arena3.Commit(&context), kTfLiteOk);
+  EXPECT_NE(arena3.BasePointer(), 0);
+  EXPECT_NE(arena3.BasePointer(), base1);
+  char* resolved_ptr = nullptr;
+  ASSERT_EQ(arena3.ResolveAlloc(&context, large_alloc, &resolved_ptr),
+            kTfLiteOk);
+  EXPECT_NE(resolved_ptr, nullptr);
+}
+
+TEST(SimpleMemoryArenaTest, TestProcessPoolAndDecommit) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+
+  // The process pool is a singleton.
+  ArenaBufferPool* pool = ArenaBufferPool::GetProcessPool();
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(pool, ArenaBufferPool::GetProcessPool());
+
+  SimpleMemoryArena arena(64);
+  arena.SetBufferPool(pool);
+  ArenaAllocWithUsageInterval alloc;
+  arena.Allocate(&context, 32, 1 << 20, 0, 0, 2, &alloc);
+  ASSERT_EQ(arena.Commit(&context), kTfLiteOk);
+  ASSERT_EQ(arena.ReleaseBuffer(), kTfLiteOk);
+
+  // Decommitted buffers stay in the pool and remain usable once re-taken.
+  pool->DecommitBuffers();
+  ASSERT_EQ(arena.Commit(&context), kTfLiteOk);
+  char* resolved_ptr = nullptr;
+  ASSERT_EQ(arena.ResolveAlloc(&context, alloc, &resolved_ptr), kTfLiteOk);
+  ASSERT_NE(resolved_ptr, nullptr);
+  memset(resolved_ptr, 0xaa, alloc.size);
+  EXPECT_EQ(resolved_ptr[alloc.size - 1], static_cast<char>(0xaa));
+}
+
 // Test parameterized by whether ClearBuffer() is called before ClearPlan(), or
 // vice versa.
 class BufferAndPlanClearingTest : public ::testing::Test,
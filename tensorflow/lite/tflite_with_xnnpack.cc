@@ -18,8 +18,9 @@ limitations under the License.
 #include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
 
 namespace tflite {
-// Corresponding weak declaration found in lite/tflite_with_xnnpack_optional.cc
-// when TFLITE_BUILD_WITH_XNNPACK_DELEGATE macro isn't defined.
+// Corresponding weak declarations found in
+// lite/tflite_with_xnnpack_optional.cc when the
+// TFLITE_BUILD_WITH_XNNPACK_DELEGATE macro isn't defined.
 std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
 AcquireXNNPACKDelegate(int num_threads) {
   auto opts = TfLiteXNNPackDelegateOptionsDefault();
@@ -28,4 +29,34 @@ AcquireXNNPACKDelegate(int num_threads) {
   return std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>(
       TfLiteXNNPackDelegateCreate(&opts), TfLiteXNNPackDelegateDelete);
 }
+
+std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
+AcquireXNNPACKDelegateWithWeightsCache(int num_threads, void* weights_cache) {
+  auto opts = TfLiteXNNPackDelegateOptionsDefault();
+  // Note that we don't want to use the thread pool for num_threads == 1.
+  opts.num_threads = num_threads > 1 ? num_threads : 0;
+  opts.weights_cache =
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(weights_cache);
+  return std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>(
+      TfLiteXNNPackDelegateCreate(&opts), TfLiteXNNPackDelegateDelete);
+}
+
+void* AcquireXNNPACKWeightsCache() {
+  return TfLiteXNNPackDelegateWeightsCacheCreate();
+}
+
+bool FinalizeAcquiredXNNPACKWeightsCache(void* cache) {
+  return TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(cache));
+}
+
+bool HardFinalizeAcquiredXNNPACKWeightsCache(void* cache) {
+  return TfLiteXNNPackDelegateWeightsCacheFinalizeHard(
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(cache));
+}
+
+void DeleteAcquiredXNNPACKWeightsCache(void* cache) {
+  TfLiteXNNPackDelegateWeightsCacheDelete(
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(cache));
+}
 }  // namespace tflite
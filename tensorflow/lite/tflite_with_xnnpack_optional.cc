@@ -30,9 +30,38 @@ using TfLiteDelegatePtr =
 
 #ifdef TFLITE_BUILD_WITH_XNNPACK_DELEGATE
 TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(int num_threads) {
+  return MaybeCreateXNNPACKDelegate(num_threads, /*weights_cache=*/nullptr);
+}
+
+void* MaybeCreateXNNPACKWeightsCache() {
+  return TfLiteXNNPackDelegateWeightsCacheCreate();
+}
+
+bool FinalizeXNNPACKWeightsCache(void* cache) {
+  if (cache == nullptr) return true;
+  return TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(cache));
+}
+
+bool HardFinalizeXNNPACKWeightsCache(void* cache) {
+  if (cache == nullptr) return true;
+  return TfLiteXNNPackDelegateWeightsCacheFinalizeHard(
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(cache));
+}
+
+void DeleteXNNPACKWeightsCache(void* cache) {
+  if (cache == nullptr) return;
+  TfLiteXNNPackDelegateWeightsCacheDelete(
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(cache));
+}
+
+TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(int num_threads,
+                                             void* weights_cache) {
   auto opts = TfLiteXNNPackDelegateOptionsDefault();
   // Note that we don't want to use the thread pool for num_threads == 1.
   opts.num_threads = num_threads > 1 ? num_threads : 0;
+  opts.weights_cache =
+      reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(weights_cache);
   return TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&opts),
                            TfLiteXNNPackDelegateDelete);
 }
@@ -45,9 +74,49 @@ AcquireXNNPACKDelegate(int num_threads) {
   return TfLiteDelegatePtr(nullptr, [](TfLiteDelegate*) {});
 }
 
+TFLITE_ATTRIBUTE_WEAK TfLiteDelegatePtr AcquireXNNPACKDelegateWithWeightsCache(
+    int num_threads, void* weights_cache) {
+  return TfLiteDelegatePtr(nullptr, [](TfLiteDelegate*) {});
+}
+
+TFLITE_ATTRIBUTE_WEAK void* AcquireXNNPACKWeightsCache() { return nullptr; }
+
+TFLITE_ATTRIBUTE_WEAK bool FinalizeAcquiredXNNPACKWeightsCache(void* cache) {
+  return true;
+}
+
+TFLITE_ATTRIBUTE_WEAK bool HardFinalizeAcquiredXNNPACKWeightsCache(
+    void* cache) {
+  return true;
+}
+
+TFLITE_ATTRIBUTE_WEAK void DeleteAcquiredXNNPACKWeightsCache(void* cache) {}
+
 TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(int num_threads) {
   return AcquireXNNPACKDelegate(num_threads);
 }
+
+void* MaybeCreateXNNPACKWeightsCache() { return AcquireXNNPACKWeightsCache(); }
+
+bool FinalizeXNNPACKWeightsCache(void* cache) {
+  if (cache == nullptr) return true;
+  return FinalizeAcquiredXNNPACKWeightsCache(cache);
+}
+
+bool HardFinalizeXNNPACKWeightsCache(void* cache) {
+  if (cache == nullptr) return true;
+  return HardFinalizeAcquiredXNNPACKWeightsCache(cache);
+}
+
+void DeleteXNNPACKWeightsCache(void* cache) {
+  if (cache == nullptr) return;
+  DeleteAcquiredXNNPACKWeightsCache(cache);
+}
+
+TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(int num_threads,
+                                             void* weights_cache) {
+  return AcquireXNNPACKDelegateWithWeightsCache(num_threads, weights_cache);
+}
 #endif
 
 }  // namespace tflite
@@ -21,6 +21,36 @@ limitations under the License.
 namespace tflite {
 std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
 MaybeCreateXNNPACKDelegate(int num_threads);
+
+// Creates a weights cache that XNNPACK delegates created with
+// `MaybeCreateXNNPACKDelegate(num_threads, weights_cache)` repack their
+// weights into, so that several delegates running the same model share one
+// copy of the packed weights. The returned handle is an opaque
+// `TfLiteXNNPackDelegateWeightsCache*`; it must outlive every delegate using
+// it and be released with `DeleteXNNPACKWeightsCache`. Returns nullptr when
+// TFLite was built without the XNNPACK delegate.
+void* MaybeCreateXNNPACKWeightsCache();
+
+// Soft-finalizes `cache` so its packed weights become visible to delegates
+// prepared afterwards. Must be called after the first interpreter using the
+// cache has allocated its tensors and before any interpreter is invoked.
+// Returns false on failure. A null `cache` is a no-op that returns true.
+bool FinalizeXNNPACKWeightsCache(void* cache);
+
+// Like `FinalizeXNNPACKWeightsCache`, but freezes `cache` and trims it to the
+// smallest possible size. No delegate prepared after this call can use the
+// cache, so only hard-finalize when every delegate sharing the cache has
+// already been created. Returns false on failure. A null `cache` is a no-op
+// that returns true.
+bool HardFinalizeXNNPACKWeightsCache(void* cache);
+
+// Releases `cache`. All delegates using it must have been destroyed first.
+void DeleteXNNPACKWeightsCache(void* cache);
+
+// Same as `MaybeCreateXNNPACKDelegate(num_threads)`, but the returned
+// delegate packs its weights into `weights_cache` (which may be null).
+std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
+MaybeCreateXNNPACKDelegate(int num_threads, void* weights_cache);
 }  // namespace tflite
 
 #endif  // TENSORFLOW_LITE_TFLITE_WITH_XNNPACK_OPTIONAL_H_
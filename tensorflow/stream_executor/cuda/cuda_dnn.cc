@@ -175,26 +175,40 @@ class CudnnHandle {
 
 }  // namespace
 
-// Wraps a cuDNN handle and provides access to it through CudnnHandle
-// instances, which also locks a mutex, acquires the CUDA context, and sets
-// the stream that cuDNN should use to enqueue any work.
+// Wraps a pool of cuDNN handles and provides access to them through
+// CudnnHandle instances, which also lock a mutex, acquire the CUDA context,
+// and set the stream that cuDNN should use to enqueue any work.
+//
+// By default the pool holds a single handle, so all cuDNN calls on a device
+// serialize, as they always have. Setting TF_CUDNN_HANDLE_POOL_SIZE to N > 1
+// lets up to N threads issue cuDNN calls concurrently on additional lazily
+// created handles. The main use case is batch-building execution plans from
+// several threads when warming up a model before serving, where the CPU-bound
+// plan finalization otherwise runs strictly serially. Note that dropout
+// descriptors are bound to the handle they were set up with, so RNN workloads
+// using dropout should keep the default pool size.
 //
 // Note: CudnnSupport::cudnn_ should be the only instantiation of this class.
 class CudnnAccess {
  public:
   // Takes ownership of the handle.
-  explicit CudnnAccess(cudnnHandle_t handle) : handle_(handle) {}
+  explicit CudnnAccess(cudnnHandle_t handle) {
+    slots_.push_back(absl::make_unique<HandleSlot>(handle));
+  }
 
   ~CudnnAccess() {
-    absl::MutexLock lock(&mutex_);
-    cudnnDestroy(handle_);
+    absl::MutexLock slots_lock(&slots_mutex_);
+    for (const auto& slot : slots_) {
+      absl::MutexLock lock(&slot->mutex);
+      cudnnDestroy(slot->handle);
+    }
   }
 
   // Creates a CudnnHandle instance for stream.
   //
   // cuDNN API calls using the same handle instance need to be serialized
   // across threads. This is guaranteed by CudnnHandle instances locking the
-  // mutex owned by this class.
+  // mutex owned by their handle's slot.
   //
   // Most cuDNN APIs taking a handle perform work on a CUDA stream. The
   // CudnnHandle instance acquires the executor's CUDA context and sets cuDNN
@@ -207,37 +221,91 @@ class CudnnAccess {
   // therefore a bad idea (performance wise) to call any cuDNN APIs that
   // enqueue work in the stream.
   CudnnHandle GetHandle(GpuExecutor* executor, Stream* stream) {
-    auto lock = absl::make_unique<absl::MutexLock>(&mutex_);
-    mutex_.AssertHeld();
     gpu::ScopedActivateExecutorContext context(executor);
+    HandleSlot* slot = PickSlot();
+    auto lock = absl::make_unique<absl::MutexLock>(&slot->mutex);
+    slot->mutex.AssertHeld();
     CUstream cu_stream = stream ? AsGpuStreamValue(stream) : cudaStreamLegacy;
-    if (!current_stream_ || cu_stream != *current_stream_) {
-      current_stream_ = cu_stream;
-      const auto status = cudnnSetStream(handle_, cu_stream);
+    if (!slot->current_stream || cu_stream != *slot->current_stream) {
+      slot->current_stream = cu_stream;
+      const auto status = cudnnSetStream(slot->handle, cu_stream);
       CHECK_EQ(status, CUDNN_STATUS_SUCCESS) << "Failed to set cuDNN stream.";
     }
-    return CudnnHandle(std::move(context), std::move(lock), handle_);
+    return CudnnHandle(std::move(context), std::move(lock), slot->handle);
   }
 
   void NotifyStreamDestroyed(Stream* stream) {
     CUstream cu_stream = AsGpuStreamValue(stream);
-    absl::MutexLock lock(&mutex_);
-    if (current_stream_ && cu_stream == *current_stream_) {
-      current_stream_.reset();
+    absl::MutexLock slots_lock(&slots_mutex_);
+    for (const auto& slot : slots_) {
+      absl::MutexLock lock(&slot->mutex);
+      if (slot->current_stream && cu_stream == *slot->current_stream) {
+        slot->current_stream.reset();
+      }
     }
   }
 
  private:
-  // Guards current_stream_ and the enqueueing of cuDNN operations via the
-  // handle_ below.
-  absl::Mutex mutex_;
+  // A cuDNN handle together with the state guarding its use.
+  struct HandleSlot {
+    explicit HandleSlot(cudnnHandle_t handle) : handle(handle) {}
+
+    // Guards current_stream and the enqueueing of cuDNN operations via the
+    // handle below.
+    absl::Mutex mutex;
 
-  // If set, indicates the stream currently active on handle_, to avoid the
-  // overhead of re-setting the same stream unnecessarily.
-  absl::optional<CUstream> current_stream_ TF_GUARDED_BY(mutex_);
+    // If set, indicates the stream currently active on handle, to avoid the
+    // overhead of re-setting the same stream unnecessarily.
+    absl::optional<CUstream> current_stream TF_GUARDED_BY(mutex);
+
+    // cuDNN library handle.
+    cudnnHandle_t handle TF_GUARDED_BY(mutex);  // Owned.
+  };
+
+  // Maximum number of handles in the pool, from TF_CUDNN_HANDLE_POOL_SIZE.
+  static int64_t MaxHandles() {
+    static int64_t max_handles = [] {
+      int64_t value;
+      TF_CHECK_OK(tensorflow::ReadInt64FromEnvVar("TF_CUDNN_HANDLE_POOL_SIZE",
+                                                  1, &value));
+      return std::max(int64_t{1}, value);
+    }();
+    return max_handles;
+  }
+
+  // Returns a slot whose handle appears to be uncontended, creating a new one
+  // if all slots are busy and the pool is below its cap. The probe is best
+  // effort: the chosen slot may be taken again before the caller locks it, in
+  // which case the caller simply waits, as with a single handle.
+  HandleSlot* PickSlot() {
+    absl::MutexLock slots_lock(&slots_mutex_);
+    if (slots_.size() == 1 && MaxHandles() == 1) {
+      return slots_[0].get();
+    }
+    for (const auto& slot : slots_) {
+      if (slot->mutex.TryLock()) {
+        slot->mutex.Unlock();
+        return slot.get();
+      }
+    }
+    if (static_cast<int64_t>(slots_.size()) < MaxHandles()) {
+      cudnnHandle_t handle = nullptr;
+      // The caller holds an activated executor context.
+      const auto status = cudnnCreate(&handle);
+      if (status == CUDNN_STATUS_SUCCESS) {
+        slots_.push_back(absl::make_unique<HandleSlot>(handle));
+        return slots_.back().get();
+      }
+      LOG(ERROR) << "Failed to create additional cuDNN handle: "
+                 << CudnnStatusToString(status);
+    }
+    return slots_[0].get();
+  }
 
-  // cuDNN library handle.
-  cudnnHandle_t handle_ TF_GUARDED_BY(mutex_);  // Owned.
+  // Guards the creation of handle slots. Slots are never removed, and each
+  // carries its own lock, so holding this mutex is not required to use one.
+  absl::Mutex slots_mutex_;
+  std::vector<std::unique_ptr<HandleSlot>> slots_ TF_GUARDED_BY(slots_mutex_);
 };
 
 namespace {
@@ -484,6 +484,76 @@ GpuDriver::ContextGetSharedMemConfig(GpuContext* context) {
   return port::Status::OK();
 }
 
+/* static */ port::Status GpuDriver::StreamBeginCapture(CUstream stream) {
+  VLOG(2) << "beginning stream capture on stream " << stream;
+  RETURN_IF_CUDA_RES_ERROR(
+      cuStreamBeginCapture(stream, CU_STREAM_CAPTURE_MODE_THREAD_LOCAL),
+      "Failed to begin stream capture");
+  return port::Status::OK();
+}
+
+/* static */ port::Status GpuDriver::StreamEndCapture(CUstream stream,
+                                                      CUgraph* graph) {
+  VLOG(2) << "ending stream capture on stream " << stream;
+  RETURN_IF_CUDA_RES_ERROR(cuStreamEndCapture(stream, graph),
+                           "Failed to end stream capture");
+  return port::Status::OK();
+}
+
+/* static */ port::Status GpuDriver::GraphInstantiate(CUgraphExec* exec,
+                                                      CUgraph graph) {
+  VLOG(2) << "instantiating CUDA graph " << graph;
+  RETURN_IF_CUDA_RES_ERROR(
+      cuGraphInstantiate(exec, graph, /*phErrorNode=*/nullptr,
+                         /*logBuffer=*/nullptr, /*bufferSize=*/0),
+      "Failed to instantiate CUDA graph");
+  return port::Status::OK();
+}
+
+/* static */ port::Status GpuDriver::GraphLaunch(CUgraphExec exec,
+                                                 CUstream stream) {
+  VLOG(2) << "launching CUDA graph " << exec << " on stream " << stream;
+  RETURN_IF_CUDA_RES_ERROR(cuGraphLaunch(exec, stream),
+                           "Failed to launch CUDA graph");
+  return port::Status::OK();
+}
+
+/* static */ port::Status GpuDriver::GraphExecUpdate(CUgraphExec exec,
+                                                     CUgraph graph,
+                                                     bool* updated) {
+  VLOG(2) << "updating CUDA graph " << exec << " from graph " << graph;
+  CUgraphNode error_node = nullptr;
+  CUgraphExecUpdateResult update_result = CU_GRAPH_EXEC_UPDATE_ERROR;
+  CUresult res = cuGraphExecUpdate(exec, graph, &error_node, &update_result);
+  if (res == CUDA_SUCCESS) {
+    *updated = true;
+    return port::Status::OK();
+  }
+  if (res == CUDA_ERROR_GRAPH_EXEC_UPDATE_FAILURE) {
+    // The topology changed in a way the driver cannot patch in place; the
+    // caller should re-instantiate.
+    VLOG(2) << "CUDA graph update rejected by driver: " << update_result;
+    *updated = false;
+    return port::Status::OK();
+  }
+  return port::InternalError(
+      absl::StrCat("Failed to update CUDA graph: ", ToString(res)));
+}
+
+/* static */ void GpuDriver::DestroyGraph(CUgraph graph) {
+  CUresult res = cuGraphDestroy(graph);
+  if (res != CUDA_SUCCESS) {
+    LOG(ERROR) << "failed to destroy CUDA graph: " << ToString(res);
+  }
+}
+
+/* static */ void GpuDriver::DestroyGraphExec(CUgraphExec exec) {
+  CUresult res = cuGraphExecDestroy(exec);
+  if (res != CUDA_SUCCESS) {
+    LOG(ERROR) << "failed to destroy CUDA executable graph: " << ToString(res);
+  }
+}
+
 /* static */ port::Status GpuDriver::LoadCubin(GpuContext* context,
                                                const char* cubin_bytes,
                                                CUmodule* module) {
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_COMPILER_XLA_SERVICE_DEVICE_MEMORY_ALLOCATOR_H_
 #define TENSORFLOW_COMPILER_XLA_SERVICE_DEVICE_MEMORY_ALLOCATOR_H_
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -25,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/stream_executor/device_memory.h"
+#include "tensorflow/stream_executor/lib/status_macros.h"
 #include "tensorflow/stream_executor/lib/statusor.h"
 #include "tensorflow/stream_executor/platform.h"
 
@@ -271,6 +273,106 @@ class StreamExecutorMemoryAllocator : public DeviceMemoryAllocator {
   std::map<int, Stream> streams_ ABSL_GUARDED_BY(mutex_);
 };
 
+// Arena adaptor over a DeviceMemoryAllocator.
+//
+// Services allocations by bumping an offset within slabs obtained from an
+// underlying allocator and releases all slabs wholesale when the arena is
+// destroyed; Deallocate() is a no-op, so individual buffers stay live for the
+// arena's lifetime. This suits temporary buffers whose lifetimes are bounded
+// by one unit of work on a stream -- e.g. the scratch requested through
+// ScratchAllocator while autotuning convolutions -- where it removes
+// per-buffer round trips to the underlying allocator.
+//
+// Returned buffers are sub-slices of larger allocations, so the arena may
+// only be used on platforms where DeviceMemoryBase::opaque() is a device
+// virtual address that supports pointer arithmetic (e.g. CUDA and ROCm).
+//
+// Thread-safe.
+class ArenaDeviceMemoryAllocator : public DeviceMemoryAllocator {
+ public:
+  // Granularity at which slabs are requested from the underlying allocator.
+  // Requests larger than the slab size get a dedicated slab.
+  static constexpr uint64_t kDefaultSlabSize = 16 * 1024 * 1024;
+
+  // Alignment of returned buffers; matches the guarantee made by the device
+  // allocation APIs on the supported platforms.
+  static constexpr uint64_t kAlignment = 256;
+
+  // The arena services allocations for a single device. `underlying` must
+  // outlive this object.
+  ArenaDeviceMemoryAllocator(DeviceMemoryAllocator *underlying,
+                             int device_ordinal,
+                             uint64_t slab_size = kDefaultSlabSize)
+      : DeviceMemoryAllocator(underlying->platform()),
+        underlying_(underlying),
+        device_ordinal_(device_ordinal),
+        slab_size_(slab_size) {}
+
+  port::StatusOr<OwningDeviceMemory> Allocate(int device_ordinal,
+                                              uint64_t size,
+                                              bool retry_on_failure,
+                                              int64_t memory_space) override {
+    if (device_ordinal != device_ordinal_) {
+      return tensorflow::errors::InvalidArgument(
+          "Arena allocator for device ordinal ", device_ordinal_,
+          " cannot allocate on device ordinal ", device_ordinal);
+    }
+    if (size == 0) {
+      return OwningDeviceMemory();
+    }
+    // Slabs live in the default memory space; requests for other spaces pass
+    // through to the underlying allocator.
+    if (memory_space != 0) {
+      return underlying_->Allocate(device_ordinal, size, retry_on_failure,
+                                   memory_space);
+    }
+    absl::MutexLock lock(&mutex_);
+    uint64_t offset = (offset_ + kAlignment - 1) & ~(kAlignment - 1);
+    if (slabs_.empty() || offset + size > slabs_.back().cref().size()) {
+      SE_ASSIGN_OR_RETURN(
+          OwningDeviceMemory slab,
+          underlying_->Allocate(device_ordinal, std::max(slab_size_, size),
+                                retry_on_failure, memory_space));
+      slabs_.push_back(std::move(slab));
+      offset = 0;
+    }
+    DeviceMemoryBase mem(
+        static_cast<char *>(slabs_.back().ptr()->opaque()) + offset, size);
+    offset_ = offset + size;
+    return OwningDeviceMemory(mem, device_ordinal, this);
+  }
+
+  // Pull in two-arg overload that sets retry_on_failure to true.
+  using DeviceMemoryAllocator::Allocate;
+
+  // All memory goes back to the underlying allocator wholesale when the arena
+  // is destroyed, so deallocating an individual buffer is a no-op.
+  port::Status Deallocate(int device_ordinal, DeviceMemoryBase mem) override {
+    return ::tensorflow::OkStatus();
+  }
+
+  bool AllowsAsynchronousDeallocation() const override {
+    return underlying_->AllowsAsynchronousDeallocation();
+  }
+
+  port::StatusOr<Stream *> GetStream(int device_ordinal) override {
+    return underlying_->GetStream(device_ordinal);
+  }
+
+ private:
+  DeviceMemoryAllocator *underlying_;  // not owned
+  const int device_ordinal_;
+  const uint64_t slab_size_;
+
+  absl::Mutex mutex_;
+
+  // Slabs obtained from the underlying allocator. Allocations bump offset_
+  // within the most recent slab; earlier slabs are retained until the arena
+  // is destroyed.
+  std::vector<OwningDeviceMemory> slabs_ ABSL_GUARDED_BY(mutex_);
+  uint64_t offset_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
 template <typename ElemT>
 port::Status ScopedDeviceMemory<ElemT>::Free() {
   if (!wrapped_.is_null()) {
@@ -26,6 +26,10 @@ Event::Event(StreamExecutor* stream_exec)
       implementation_(
           stream_exec_->implementation()->CreateEventImplementation()) {}
 
+Event::Event(StreamExecutor* stream_exec,
+             std::unique_ptr<internal::EventInterface> implementation)
+    : stream_exec_(stream_exec), implementation_(std::move(implementation)) {}
+
 Event::~Event() {
   // Deal with nullptr implementation_, as this event may have been std::moved.
   if (stream_exec_ && implementation_) {
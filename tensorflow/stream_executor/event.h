@@ -66,6 +66,12 @@ class Event {
 
  private:
   friend class Stream;
+  friend class StreamExecutor;
+
+  // Instantiates an Event that adopts an already-created platform
+  // implementation. Used by StreamExecutor when recycling pooled events.
+  Event(StreamExecutor* stream_exec,
+        std::unique_ptr<internal::EventInterface> implementation);
 
   // Pointer to the StreamExecutor interface used to create this object.
   // Not owned.
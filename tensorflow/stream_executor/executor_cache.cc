@@ -15,95 +15,93 @@ limitations under the License.
 
 #include "tensorflow/stream_executor/executor_cache.h"
 
+#include <memory>
+#include <utility>
+
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
 
 namespace stream_executor {
 
+ExecutorCache::ExecutorCache() : snapshot_(std::make_shared<Snapshot>()) {}
+
+ExecutorCache::~ExecutorCache() {}
+
 port::StatusOr<StreamExecutor*> ExecutorCache::GetOrCreate(
     const StreamExecutorConfig& config,
     const std::function<ExecutorFactory>& factory) {
-  // In the fast path case, the cache already has an entry and we can just
-  // return after Get() which only takes a shared lock and not a unique lock.
-  // If we need to create, we take a unique lock on cache_.
+  // In the fast path case, the cache already has an entry and the lock-free
+  // lookup in Get() finds it.
   auto fast_result = Get(config);
   if (fast_result.ok()) {
     return fast_result;
   }
 
-  Entry* entry = nullptr;
+  // Acquire the per-ordinal creation mutex without holding 'mutex_'.
+  // Initializing an Executor may be expensive, so we want to allow concurrent
+  // initialization of executors for different ordinals.
+  absl::Mutex* creation_mutex = nullptr;
   {
     absl::MutexLock lock{&mutex_};
-    entry = &cache_[config.ordinal];
-    // Release the map lock; the address of 'entry' is stable because
-    // std::map guarantees reference stability.
+    creation_mutex = &creation_mutexes_[config.ordinal];
   }
+  absl::MutexLock creation_lock{creation_mutex};
 
-  // Acquire the per-Entry mutex without holding the map mutex. Initializing
-  // an Executor may be expensive, so we want to allow concurrent
-  // initialization of different entries.
-  absl::MutexLock lock{&entry->configurations_mutex};
-  for (const auto& iter : entry->configurations) {
-    if (iter.first.plugin_config == config.plugin_config &&
-        iter.first.device_options == config.device_options) {
-      VLOG(2) << "hit in cache";
-      return iter.second.get();
-    }
+  // Re-check after acquiring the creation mutex; another thread may have
+  // created the executor while we were waiting.
+  if (StreamExecutor* hit = Lookup(*std::atomic_load(&snapshot_), config)) {
+    VLOG(2) << "hit in cache";
+    return hit;
   }
 
   VLOG(2) << "building executor";
   port::StatusOr<std::unique_ptr<StreamExecutor>> result = factory();
   if (!result.ok()) {
     VLOG(2) << "failed to get build executor: " << result.status();
-    // If construction failed, leave the cache Entry around, but with a null
-    // executor.
     return result.status();
   }
-  entry->configurations.emplace_back(config, std::move(result.ValueOrDie()));
-  return entry->configurations.back().second.get();
+  std::shared_ptr<StreamExecutor> executor = std::move(result.ValueOrDie());
+  StreamExecutor* raw_executor = executor.get();
+
+  // Publish a new snapshot holding the executor (copy-on-insert).
+  {
+    absl::MutexLock lock{&mutex_};
+    auto new_snapshot =
+        std::make_shared<Snapshot>(*std::atomic_load(&snapshot_));
+    new_snapshot->entries[config.ordinal].emplace_back(config,
+                                                       std::move(executor));
+    std::atomic_store(&snapshot_,
+                      std::shared_ptr<const Snapshot>(std::move(new_snapshot)));
+  }
+  return raw_executor;
 }
 
 port::StatusOr<StreamExecutor*> ExecutorCache::Get(
     const StreamExecutorConfig& config) {
-  Entry* entry = nullptr;
-  {
-    absl::ReaderMutexLock lock{&mutex_};
-
-    {
-      if (config.gpu_stream) {
-        // Need to iterate through all stored executors.
-        for (auto& [ordinal, e] : cache_) {
-          absl::ReaderMutexLock l{&e.configurations_mutex};
-          for (auto& [c, executor] : e.configurations) {
-            if (executor->FindAllocatedStream(config.gpu_stream)) {
-              return executor.get();
-            }
-          }
+  std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+
+  if (config.gpu_stream) {
+    // Need to iterate through all stored executors.
+    for (const auto& [ordinal, configurations] : snapshot->entries) {
+      for (const auto& [c, executor] : configurations) {
+        if (executor->FindAllocatedStream(config.gpu_stream)) {
+          return executor.get();
         }
-        return port::Status(
-            port::error::NOT_FOUND,
-            absl::StrFormat("No executors own stream %p", config.gpu_stream));
       }
     }
-
-    auto it = cache_.find(config.ordinal);
-    if (it != cache_.end()) {
-      entry = &it->second;
-    } else {
-      return port::Status(
-          port::error::NOT_FOUND,
-          absl::StrFormat("No executors registered for ordinal %d",
-                          config.ordinal));
-    }
+    return port::Status(
+        port::error::NOT_FOUND,
+        absl::StrFormat("No executors own stream %p", config.gpu_stream));
   }
-  absl::ReaderMutexLock lock{&entry->configurations_mutex};
-  if (entry->configurations.empty()) {
+
+  auto it = snapshot->entries.find(config.ordinal);
+  if (it == snapshot->entries.end() || it->second.empty()) {
     return port::Status(
         port::error::NOT_FOUND,
         absl::StrFormat("No executors registered for ordinal %d",
                         config.ordinal));
   }
-  for (const auto& iter : entry->configurations) {
+  for (const auto& iter : it->second) {
     if (iter.first.plugin_config == config.plugin_config &&
         iter.first.device_options == config.device_options) {
       VLOG(2) << "hit in cache for device ordinal " << config.ordinal;
@@ -116,12 +114,24 @@ port::StatusOr<StreamExecutor*> ExecutorCache::Get(
 
 void ExecutorCache::DestroyAllExecutors() {
   absl::MutexLock lock{&mutex_};
-  cache_.clear();
+  std::atomic_store(
+      &snapshot_,
+      std::shared_ptr<const Snapshot>(std::make_shared<Snapshot>()));
 }
 
-ExecutorCache::Entry::~Entry() {
-  absl::MutexLock lock{&configurations_mutex};
-  configurations.clear();
+StreamExecutor* ExecutorCache::Lookup(const Snapshot& snapshot,
+                                      const StreamExecutorConfig& config) {
+  auto it = snapshot.entries.find(config.ordinal);
+  if (it == snapshot.entries.end()) {
+    return nullptr;
+  }
+  for (const auto& iter : it->second) {
+    if (iter.first.plugin_config == config.plugin_config &&
+        iter.first.device_options == config.device_options) {
+      return iter.second.get();
+    }
+  }
+  return nullptr;
 }
 
 }  // namespace stream_executor
@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "tensorflow/stream_executor/lib/status.h"
@@ -28,9 +30,16 @@ namespace stream_executor {
 
 // Utility class to allow Platform objects to manage cached StreamExecutors.
 // Thread-safe.
+//
+// The cache is read-optimized: lookups scan an immutable snapshot of the
+// contents obtained with an atomic load and take no lock, so the steady-state
+// path -- fetching an already-created executor -- does not contend with other
+// lookups. Inserts copy the current snapshot and atomically publish the new
+// one.
 class ExecutorCache {
  public:
-  ExecutorCache() {}
+  ExecutorCache();
+  ~ExecutorCache();
 
   // Looks up 'config' in the cache. Returns a pointer to the existing executor,
   // if already present, or creates it using 'factory', if it does not.
@@ -50,27 +59,38 @@ class ExecutorCache {
   void DestroyAllExecutors();
 
  private:
-  // Each Entry contains zero or more cached executors for a device ordinal.
-  struct Entry {
-    ~Entry();
-
-    // Mutex that guards the contents of each entry. The 'mutex_' of the
-    // ExecutorCache class protects both the 'cache_' and the existence of each
-    // Entry, but not the Entry's contents. 'configurations_mutex' protects the
-    // contents of the entry after 'mutex_' has been dropped.
-    absl::Mutex configurations_mutex;
-
-    // Vector of cached {config, executor} pairs.
-    std::vector<
-        std::pair<StreamExecutorConfig, std::unique_ptr<StreamExecutor>>>
-        configurations TF_GUARDED_BY(configurations_mutex);
+  // An immutable snapshot of the cache contents, mapping ordinal number to
+  // the list of cached {config, executor} pairs for that ordinal. We key off
+  // of ordinal (instead of just looking up all fields in the
+  // StreamExecutorConfig) for a slight improvement in lookup time.
+  //
+  // Executors are owned jointly by the snapshots that reference them, so a
+  // lookup that is concurrent with DestroyAllExecutors keeps the executors it
+  // sees alive until it drops its snapshot.
+  struct Snapshot {
+    std::map<int, std::vector<std::pair<StreamExecutorConfig,
+                                        std::shared_ptr<StreamExecutor>>>>
+        entries;
   };
 
-  // Maps ordinal number to a list of cached executors for that ordinal.
-  // We key off of ordinal (instead of just looking up all fields in the
-  // StreamExecutorConfig) for a slight improvement in lookup time.
+  // Returns the executor in 'snapshot' matching 'config's plugin config and
+  // device options, or nullptr if there is none.
+  static StreamExecutor* Lookup(const Snapshot& snapshot,
+                                const StreamExecutorConfig& config);
+
+  // Serializes mutation of the published snapshot. Never held during lookups
+  // or while a factory runs.
   absl::Mutex mutex_;
-  std::map<int, Entry> cache_ TF_GUARDED_BY(mutex_);
+
+  // The currently published snapshot. Read with std::atomic_load (no lock);
+  // replaced via std::atomic_store under 'mutex_'. Never null.
+  std::shared_ptr<const Snapshot> snapshot_;
+
+  // Per-ordinal mutexes serializing executor creation, so that factories for
+  // different device ordinals may run concurrently. Entries are never removed
+  // because a concurrent GetOrCreate may be blocked on one; std::map
+  // guarantees the reference stability that requires.
+  std::map<int, absl::Mutex> creation_mutexes_ TF_GUARDED_BY(mutex_);
 
   SE_DISALLOW_COPY_AND_ASSIGN(ExecutorCache);
 };
@@ -15,14 +15,17 @@ limitations under the License.
 
 #include "tensorflow/stream_executor/gpu/asm_compiler.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/platform/cuda_libdevice_path.h"
 #include "tensorflow/core/platform/env.h"
@@ -120,33 +123,65 @@ static void WarnIfBadPtxasVersion(const std::string& ptxas_path) {
 
 port::StatusOr<absl::Span<const uint8>> CompileGpuAsmOrGetCached(
     int device_ordinal, const char* ptx, GpuAsmOpts compilation_options) {
-  using PtxCacheKey = std::tuple<int, std::string, GpuAsmOpts::PtxOptionsTuple>;
+  // The compiled binary depends only on the compute capability, not on the
+  // device ordinal, so identically-capable devices in one machine share a
+  // single cache entry per module.
+  gpu::GpuDeviceHandle handle;
+  TF_RETURN_IF_ERROR(gpu::GpuDriver::GetDevice(device_ordinal, &handle));
+  int cc_major;
+  int cc_minor;
+  TF_RETURN_IF_ERROR(
+      gpu::GpuDriver::GetComputeCapability(&cc_major, &cc_minor, handle));
+
+  using PtxCacheKey =
+      std::tuple<int, int, std::string, GpuAsmOpts::PtxOptionsTuple>;
   using PtxCompilerResult = port::StatusOr<std::vector<uint8>>;
+  struct PtxCacheValue {
+    absl::Notification compiled;
+    PtxCompilerResult result;  // Valid once `compiled` has been notified.
+  };
   static tensorflow::mutex ptx_cache_mutex(tensorflow::LINKER_INITIALIZED);
   static auto& ptx_cache TF_GUARDED_BY(ptx_cache_mutex) =
-      *new absl::flat_hash_map<PtxCacheKey, PtxCompilerResult>();
+      *new absl::flat_hash_map<PtxCacheKey, std::unique_ptr<PtxCacheValue>>();
 
-  tensorflow::mutex_lock lock(ptx_cache_mutex);
-  PtxCacheKey cache_key{device_ordinal, std::string(ptx),
+  PtxCacheKey cache_key{cc_major, cc_minor, std::string(ptx),
                         compilation_options.ToTuple()};
-  auto it = ptx_cache.find(cache_key);
-  if (it == ptx_cache.end()) {
-    PtxCompilerResult compiled =
-        CompileGpuAsm(device_ordinal, ptx, compilation_options);
-    it = ptx_cache.emplace(cache_key, std::move(compiled)).first;
+  PtxCacheValue* value = nullptr;
+  bool do_compile = false;
+  {
+    tensorflow::mutex_lock lock(ptx_cache_mutex);
+    auto it = ptx_cache.find(cache_key);
+    if (it == ptx_cache.end()) {
+      it = ptx_cache
+               .emplace(std::move(cache_key),
+                        absl::make_unique<PtxCacheValue>())
+               .first;
+      do_compile = true;
+    }
+    // Entries are never erased and the pointee is stable across rehashes.
+    value = it->second.get();
   }
 
-  CHECK(it != ptx_cache.end());
+  // Compile outside the cache lock so that unrelated modules compile
+  // concurrently, e.g. when several kernels are loaded eagerly at startup.
+  // Other threads requesting the same module wait for this compilation
+  // instead of starting their own.
+  if (do_compile) {
+    value->result = CompileGpuAsm(cc_major, cc_minor, ptx, compilation_options);
+    value->compiled.Notify();
+  } else {
+    value->compiled.WaitForNotification();
+  }
 
   // Failed compilation attempts are cached.
-  // Use separate status check and ValueOrDie invocation on ptx_cache
-  // entry to avoid value moving introduced by TF_ASSIGN_OR_RETURN.
+  // Use separate status check and ValueOrDie invocation on the cache entry to
+  // avoid value moving introduced by TF_ASSIGN_OR_RETURN.
 
-  if (TF_PREDICT_FALSE(!it->second.ok())) {
-    return it->second.status();
+  if (TF_PREDICT_FALSE(!value->result.ok())) {
+    return value->result.status();
   }
 
-  const std::vector<uint8>& compiled = it->second.ValueOrDie();
+  const std::vector<uint8>& compiled = value->result.ValueOrDie();
   return absl::MakeSpan(compiled);
 }
 
@@ -58,6 +58,11 @@ port::StatusOr<std::vector<uint8>> CompileGpuAsm(int cc_major, int cc_minor,
 // Same as CompileGpuAsm, but caches the result, and returns unowned view of
 // the compiled binary.
 //
+// The cache is process-wide and keyed by the device's compute capability (not
+// its ordinal), so identically-capable devices share one compiled binary per
+// module. Distinct modules compile concurrently; concurrent requests for the
+// same module block until the first compilation finishes.
+//
 // A copy of the string provided in ptx will be made.
 port::StatusOr<absl::Span<const uint8>> CompileGpuAsmOrGetCached(
     int device_ordinal, const char* ptx, GpuAsmOpts compilation_options);
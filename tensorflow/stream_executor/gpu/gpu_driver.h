@@ -269,6 +269,56 @@ class GpuDriver {
       unsigned int block_dim_z, unsigned int shared_mem_bytes,
       GpuStreamHandle stream, void** kernel_params, void** extra);
 
+  // -- Graph capture and replay of work enqueued on a stream.
+
+  // Places "stream" in capture mode: subsequently enqueued work is recorded
+  // into a graph instead of being executed, until StreamEndCapture is called.
+  // Capture is thread-local; enqueues from other threads are unaffected.
+  // (supported on CUDA only)
+  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__STREAM.html#group__CUDA__STREAM_1gea22d4496b1c8d02d0607bb05743532f
+  static port::Status StreamBeginCapture(GpuStreamHandle stream);
+
+  // Ends a capture started with StreamBeginCapture and returns the captured
+  // graph in "graph". The caller owns the graph and must destroy it with
+  // DestroyGraph.
+  // (supported on CUDA only)
+  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__STREAM.html#group__CUDA__STREAM_1g03dab8b2ba76b00718955177a929970c
+  static port::Status StreamEndCapture(GpuStreamHandle stream,
+                                       GpuGraphHandle* graph);
+
+  // Instantiates an executable instance of "graph" that can be launched
+  // repeatedly with GraphLaunch. The caller owns the instance and must
+  // destroy it with DestroyGraphExec.
+  // (supported on CUDA only)
+  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__GRAPH.html#group__CUDA__GRAPH_1gb53b435e178cccfa37ac87285d2c3fa1
+  static port::Status GraphInstantiate(GpuGraphExecHandle* exec,
+                                       GpuGraphHandle graph);
+
+  // Launches an instantiated graph on "stream", replaying the captured work
+  // with a single driver call.
+  // (supported on CUDA only)
+  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__GRAPH.html#group__CUDA__GRAPH_1g6b2dceb3901e71a390d2bd8b0491e471
+  static port::Status GraphLaunch(GpuGraphExecHandle exec,
+                                  GpuStreamHandle stream);
+
+  // Attempts to update "exec" in place with the node parameters (e.g. new
+  // buffer addresses) of "graph", which must be topologically identical to
+  // the graph "exec" was instantiated from. Sets *updated to false, without
+  // returning an error, if the driver cannot apply the update; the caller
+  // should then re-instantiate.
+  // (supported on CUDA only)
+  // https://docs.nvidia.com/cuda/cuda-driver-api/group__CUDA__GRAPH.html#group__CUDA__GRAPH_1g96efefc56df46927da7297f122adfb9f
+  static port::Status GraphExecUpdate(GpuGraphExecHandle exec,
+                                      GpuGraphHandle graph, bool* updated);
+
+  // Destroys a graph returned by StreamEndCapture.
+  // (supported on CUDA only)
+  static void DestroyGraph(GpuGraphHandle graph);
+
+  // Destroys an instance returned by GraphInstantiate.
+  // (supported on CUDA only)
+  static void DestroyGraphExec(GpuGraphExecHandle exec);
+
   // Loads ptx_contents with the CUDA driver's PTX JIT and stores the resulting
   // handle in "module". Any error logs that are produced are logged internally.
   // (supported on CUDA only)
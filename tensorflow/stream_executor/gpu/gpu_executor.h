@@ -226,6 +226,10 @@ class GpuExecutor : public internal::StreamExecutorInterface {
 
   port::Status DeallocateEvent(Event* event) override;
 
+  // GPU events may be re-recorded after completing, so deallocated events can
+  // be recycled rather than destroyed and recreated through the driver.
+  bool CanRecycleEvents() const override { return true; }
+
   port::Status RecordEvent(Stream* stream, Event* event) override;
 
   port::Status WaitForEvent(Stream* stream, Event* event) override;
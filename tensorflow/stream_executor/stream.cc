@@ -4217,6 +4217,37 @@ Stream &Stream::ThenDoHostCallbackWithStatus(
   return *this;
 }
 
+Stream &Stream::ThenDoHostCallbacksWithStatus(
+    std::vector<std::function<port::Status()>> callbacks) {
+  VLOG_CALL(PARAM(callbacks.size()));
+
+  if (callbacks.empty()) {
+    return *this;
+  }
+  if (callbacks.size() == 1) {
+    return ThenDoHostCallbackWithStatus(std::move(callbacks[0]));
+  }
+  if (!ok()) {
+    LOG(INFO) << DebugStreamPointers()
+              << " was in error state before adding host callbacks";
+  }
+  // A single host-side dispatch runs the whole batch. All callbacks run even
+  // if an earlier one fails; the first failure is what the platform sees.
+  auto batch = [callbacks = std::move(callbacks)]() {
+    port::Status status;
+    for (const auto &callback : callbacks) {
+      port::Status callback_status = callback();
+      if (status.ok() && !callback_status.ok()) {
+        status = callback_status;
+      }
+    }
+    return status;
+  };
+  CheckError(parent_->HostCallback(
+      this, std::function<port::Status()>(std::move(batch))));
+  return *this;
+}
+
 Stream &Stream::ThenRunAfterNextBlockHostUntilDone(
     std::function<void()> callback) {
   VLOG_CALL(PARAM(callback));
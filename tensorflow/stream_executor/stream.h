@@ -25,6 +25,7 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
@@ -1996,6 +1997,17 @@ class Stream {
   // negative effects on performance.
   Stream &ThenDoHostCallbackWithStatus(std::function<port::Status()> callback);
 
+  // Entrains onto the stream a group of callbacks that are dispatched to the
+  // host as a single unit, amortizing the per-callback dispatch cost on
+  // platforms where host callbacks are expensive. The callbacks run in order;
+  // the first failure is reported and the remaining callbacks still run.
+  //
+  // Only callbacks that would otherwise be entrained back to back, with no
+  // intervening work, may be batched this way — batching them is equivalent
+  // to consecutive ThenDoHostCallbackWithStatus calls in that case.
+  Stream &ThenDoHostCallbacksWithStatus(
+      std::vector<std::function<port::Status()>> callbacks);
+
   // Runs the given callback after the next call to BlockHostUntilDone on this
   // stream (or after the Stream does BlockHostUntilDone in its destructor).
   // This can act as a faster alternative to ThenDoHostCallbackWithStatus for
@@ -246,6 +246,11 @@ class StreamExecutorInterface {
                             std::function<port::Status()> callback) = 0;
   virtual port::Status AllocateEvent(Event* event) = 0;
   virtual port::Status DeallocateEvent(Event* event) = 0;
+  // Returns true if an event that has gone through an
+  // AllocateEvent/DeallocateEvent cycle may be handed back out by a later
+  // AllocateEvent and recorded again. When true, StreamExecutor recycles
+  // event implementations instead of destroying and recreating them.
+  virtual bool CanRecycleEvents() const { return false; }
   virtual port::Status RecordEvent(Stream* stream, Event* event) = 0;
   virtual port::Status WaitForEvent(Stream* stream, Event* event) = 0;
   virtual Event::Status PollForEventStatus(Event* event) = 0;
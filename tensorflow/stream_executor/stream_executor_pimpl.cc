@@ -66,6 +66,10 @@ void BlockOnThreadExecutor(port::ThreadPool* executor) {
 
 std::atomic_int_fast64_t correlation_id_generator(0);
 
+// Maximum number of initialized platform events an executor keeps around for
+// reuse. Deallocations beyond this bound go back to the platform.
+constexpr int kMaxPooledEvents = 256;
+
 }  // namespace
 
 template <typename BeginCallT, typename CompleteCallT, typename ReturnT,
@@ -167,6 +171,18 @@ StreamExecutor::StreamExecutor(
 StreamExecutor::~StreamExecutor() {
   BlockOnThreadExecutor(background_threads_.get());
 
+  // Hand pooled event implementations back to the platform. The temporary
+  // Events are not in allocated_events_, so their destruction bypasses the
+  // pool and performs real platform deallocation.
+  std::vector<std::unique_ptr<internal::EventInterface>> pooled_events;
+  {
+    absl::MutexLock lock(&mu_);
+    pooled_events.swap(free_events_);
+  }
+  for (auto& implementation : pooled_events) {
+    Event event(this, std::move(implementation));
+  }
+
   if (live_stream_count_.load() != 0) {
     LOG(WARNING) << "Not all streams were deallocated at executor destruction "
                  << "time. This may lead to unexpected/bad behavior - "
@@ -770,10 +786,38 @@ bool StreamExecutor::HostCallback(Stream* stream,
 }
 
 port::Status StreamExecutor::AllocateEvent(Event* event) {
-  return implementation_->AllocateEvent(event);
+  if (implementation_->CanRecycleEvents()) {
+    absl::MutexLock lock(&mu_);
+    if (!free_events_.empty()) {
+      // Hand out an already-initialized implementation instead of paying for
+      // a platform create call; the unused implementation made by the Event
+      // constructor is discarded.
+      event->implementation_ = std::move(free_events_.back());
+      free_events_.pop_back();
+      allocated_events_.insert(event->implementation());
+      return port::Status::OK();
+    }
+  }
+  port::Status status = implementation_->AllocateEvent(event);
+  if (status.ok() && implementation_->CanRecycleEvents()) {
+    absl::MutexLock lock(&mu_);
+    allocated_events_.insert(event->implementation());
+  }
+  return status;
 }
 
 port::Status StreamExecutor::DeallocateEvent(Event* event) {
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = allocated_events_.find(event->implementation());
+    if (it != allocated_events_.end()) {
+      allocated_events_.erase(it);
+      if (free_events_.size() < kMaxPooledEvents) {
+        free_events_.push_back(std::move(event->implementation_));
+        return port::Status::OK();
+      }
+    }
+  }
   return implementation_->DeallocateEvent(event);
 }
 
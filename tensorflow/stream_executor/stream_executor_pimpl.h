@@ -630,10 +630,14 @@ class StreamExecutor {
   // This is the preferred form for a callback that may return an error.
   bool HostCallback(Stream* stream, std::function<port::Status()> callback);
 
-  // Performs platform-specific allocation and initialization of an event.
+  // Obtains an initialized platform event for `event`, either by recycling
+  // one from the executor's pool of previously deallocated events or by
+  // performing platform-specific allocation and initialization.
   port::Status AllocateEvent(Event* event);
 
-  // Performs platform-specific deallocation and cleanup of an event.
+  // Returns the platform event underlying `event` to the executor's pool for
+  // later reuse, or performs platform-specific deallocation and cleanup if
+  // the pool is full.
   port::Status DeallocateEvent(Event* event);
 
   // Inserts the specified event at the end of the specified stream.
@@ -716,6 +720,17 @@ class StreamExecutor {
   // allocated.
   std::map<void*, AllocRecord> mem_allocs_ ABSL_GUARDED_BY(mu_);
 
+  // Platform event implementations that were successfully initialized through
+  // AllocateEvent() and have not yet been handed back. Membership here is what
+  // makes an implementation eligible for recycling on deallocation.
+  std::set<internal::EventInterface*> allocated_events_ ABSL_GUARDED_BY(mu_);
+
+  // Initialized platform event implementations available for reuse by later
+  // AllocateEvent() calls, so that event churn does not translate into
+  // create/destroy calls into the platform. Bounded by kMaxPooledEvents.
+  std::vector<std::unique_ptr<internal::EventInterface>> free_events_
+      ABSL_GUARDED_BY(mu_);
+
   // Memoized BLAS support object -- we only want to create this once when asked
   // for a BLAS interface.
   std::unique_ptr<blas::BlasSupport> blas_ ABSL_GUARDED_BY(mu_);
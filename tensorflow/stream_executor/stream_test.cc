@@ -199,5 +199,24 @@ TEST_F(StreamTest, FailedSubStreamAfterReturnNotReused) {
   EXPECT_EQ(sub_stream2, sub_stream3);
 }
 
+TEST_F(StreamTest, BatchedHostCallbacksRunInOrder) {
+  std::unique_ptr<StreamExecutor> executor = NewStreamExecutor();
+  Stream stream(executor.get());
+  stream.Init();
+  EXPECT_TRUE(stream.ok());
+
+  std::vector<int> order;
+  std::vector<std::function<port::Status()>> callbacks;
+  for (int i = 0; i < 3; ++i) {
+    callbacks.push_back([&order, i]() {
+      order.push_back(i);
+      return port::Status::OK();
+    });
+  }
+  stream.ThenDoHostCallbacksWithStatus(std::move(callbacks));
+  EXPECT_TRUE(stream.BlockHostUntilDone().ok());
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), order);
+}
+
 }  // namespace
 }  // namespace stream_executor